@@ -0,0 +1,142 @@
+// Benchmarks/MicroBench/BenchLayers.cpp
+// Daro_Render prologue (layer snapshot under the engine mutex, mask map build) and the
+// per-layer matrix composed in UpdateConstantBuffer.
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include "LayerMasks.h"
+
+#if __has_include(<DirectXMath.h>)
+#include "LayerTransform.h"
+#define BENCH_HAS_DIRECTXMATH 1
+#else
+#define BENCH_HAS_DIRECTXMATH 0
+#endif
+
+// Scene like the Designer sends: every maskEvery-th layer is a mask over the two layers
+// below it, the rest are rotated quads
+static std::vector<DaroLayer> MakeLayers(int count, int maskEvery)
+{
+    std::vector<DaroLayer> layers(count);
+    for (int i = 0; i < count; i++)
+    {
+        DaroLayer& layer = layers[i];
+        memset(&layer, 0, sizeof(layer));
+        layer.id = 100 + i;
+        layer.active = 1;
+        layer.layerType = DARO_TYPE_RECTANGLE;
+        layer.posX = 100.0f + i * 20.0f;
+        layer.posY = 80.0f + i * 10.0f;
+        layer.sizeX = 400.0f;
+        layer.sizeY = 120.0f;
+        layer.rotZ = (float)(i * 7 % 360);
+        layer.rotY = (i % 3) ? 0.0f : 15.0f;
+        layer.anchorX = 0.5f;
+        layer.anchorY = 0.5f;
+        layer.opacity = 1.0f;
+
+        if (maskEvery > 0 && i >= 2 && i % maskEvery == 0)
+        {
+            layer.layerType = DARO_TYPE_MASK;
+            layer.maskedLayerCount = 2;
+            layer.maskedLayerIds[0] = 100 + i - 1;
+            layer.maskedLayerIds[1] = 100 + i - 2;
+        }
+    }
+    return layers;
+}
+
+// Arguments: layer count, mask every Nth layer (0 = no masks)
+static void LayerArgs(benchmark::internal::Benchmark* b)
+{
+    for (int count : { 8, 32, DARO_MAX_LAYERS })
+    {
+        b->Args({ count, 0 });
+        b->Args({ count, 4 });
+    }
+}
+
+// memcpy of g_Layers into the thread-local copy under g_Mutex
+static void BM_LayerSnapshot(benchmark::State& state)
+{
+    int count = (int)state.range(0);
+    std::vector<DaroLayer> shared = MakeLayers(count, (int)state.range(1));
+    std::vector<DaroLayer> local(DARO_MAX_LAYERS);
+    std::mutex mutex;
+
+    for (auto _ : state)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        memcpy(local.data(), shared.data(), sizeof(DaroLayer) * count);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)sizeof(DaroLayer) * count);
+}
+BENCHMARK(BM_LayerSnapshot)->Apply(LayerArgs);
+
+// Steady state: the map has seen every id, so only the lists are cleared and refilled
+static void BM_MaskMapBuild(benchmark::State& state)
+{
+    int count = (int)state.range(0);
+    std::vector<DaroLayer> layers = MakeLayers(count, (int)state.range(1));
+    DaroMaskMap layerToMasks;
+    DaroBuildMaskMap(layers.data(), count, layerToMasks);
+
+    for (auto _ : state)
+    {
+        DaroBuildMaskMap(layers.data(), count, layerToMasks);
+        benchmark::DoNotOptimize(layerToMasks);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_MaskMapBuild)->Apply(LayerArgs);
+
+// Mask lookup as RenderWithMasks does it, once per layer
+static void BM_MaskMapLookup(benchmark::State& state)
+{
+    int count = (int)state.range(0);
+    std::vector<DaroLayer> layers = MakeLayers(count, (int)state.range(1));
+    DaroMaskMap layerToMasks;
+    DaroBuildMaskMap(layers.data(), count, layerToMasks);
+
+    for (auto _ : state)
+    {
+        size_t masked = 0;
+        for (const DaroLayer& layer : layers)
+        {
+            auto it = layerToMasks.find(layer.id);
+            if (it != layerToMasks.end() && !it->second.empty())
+                masked += it->second.size();
+        }
+        benchmark::DoNotOptimize(masked);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_MaskMapLookup)->Apply(LayerArgs);
+
+#if BENCH_HAS_DIRECTXMATH
+
+// Matrix composition plus the transpose/store into the constant buffer, for every layer
+static void BM_LayerTransform(benchmark::State& state)
+{
+    using namespace DirectX;
+
+    int count = (int)state.range(0);
+    std::vector<DaroLayer> layers = MakeLayers(count, 0);
+    std::vector<XMFLOAT4X4> transforms(count);
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            XMMATRIX wvp = DaroLayerTransform(&layers[i], 1920.0f, 1080.0f);
+            XMStoreFloat4x4(&transforms[i], XMMatrixTranspose(wvp));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_LayerTransform)->Arg(1)->Arg(DARO_MAX_LAYERS);
+
+#endif
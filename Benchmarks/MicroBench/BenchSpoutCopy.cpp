@@ -0,0 +1,93 @@
+// Benchmarks/MicroBench/BenchSpoutCopy.cpp
+// Every spoutCopy kernel at 1920x1080. The vendored Spout sources need the Windows SDK
+// and OpenGL headers, so these only build on Windows; BM_ConvertPixels in BenchPixels.cpp
+// covers the same conversions on the engine's own shared-memory paths on every platform.
+#ifdef _WIN32
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "Spout/SpoutCopy.h"
+
+static const unsigned int kWidth = 1920;
+static const unsigned int kHeight = 1080;
+static const unsigned int kPitch = kWidth * 4 + 256;   // Padded staging RowPitch
+
+struct SpoutBuffers
+{
+    std::vector<uint8_t> src;
+    std::vector<uint8_t> dst;
+
+    SpoutBuffers()
+        : src((size_t)kPitch * kHeight), dst((size_t)kPitch * kHeight)
+    {
+        for (size_t i = 0; i < src.size(); i++)
+            src[i] = (uint8_t)(i * 31 + (i >> 12));
+    }
+};
+
+// Runs kernel(copier, src, dst) per iteration; bytes are counted on the 4-byte side
+template <typename Kernel>
+static void RunKernel(benchmark::State& state, Kernel kernel)
+{
+    static spoutCopy copier;    // Constructor runs the CPUID checks once
+    static SpoutBuffers buffers;
+
+    for (auto _ : state)
+    {
+        kernel(copier, buffers.src.data(), buffers.dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)kWidth * kHeight * 4);
+}
+
+// One benchmark per kernel call; c is the spoutCopy, s and d the source and destination
+#define SPOUT_BENCHMARK(name, call)                                                     \
+    static void BM_Spout_##name(benchmark::State& state)                                \
+    {                                                                                   \
+        RunKernel(state, [](spoutCopy& c, uint8_t* s, uint8_t* d) { (void)s; (void)d; call; }); \
+    }                                                                                   \
+    BENCHMARK(BM_Spout_##name)
+
+static const bool kInvert = true;
+
+SPOUT_BENCHMARK(CopyPixels, c.CopyPixels(s, d, kWidth, kHeight, GL_RGBA, false));
+SPOUT_BENCHMARK(CopyPixelsInvert, c.CopyPixels(s, d, kWidth, kHeight, GL_RGBA, kInvert));
+SPOUT_BENCHMARK(FlipBuffer, c.FlipBuffer(s, d, kWidth, kHeight, GL_RGBA));
+SPOUT_BENCHMARK(FlipBufferInPlace, c.FlipBuffer(d, kWidth, kHeight, GL_RGBA));
+SPOUT_BENCHMARK(RemovePadding, c.RemovePadding(s, d, kWidth, kHeight, kPitch, GL_RGBA));
+SPOUT_BENCHMARK(ClearAlpha, c.ClearAlpha(d, kWidth, kHeight, 0xFF));
+SPOUT_BENCHMARK(memcpy_sse2, c.memcpy_sse2(d, s, (size_t)kWidth * kHeight * 4));
+
+SPOUT_BENCHMARK(rgba2rgba, c.rgba2rgba(s, d, kWidth, kHeight, kPitch, false));
+SPOUT_BENCHMARK(rgba2rgbaInvert, c.rgba2rgba(s, d, kWidth, kHeight, kPitch, kInvert));
+SPOUT_BENCHMARK(rgba2rgbaPitch, c.rgba2rgba(s, d, kWidth, kHeight, kPitch, kPitch, false));
+SPOUT_BENCHMARK(rgba2rgbaResample, c.rgba2rgbaResample(s, d, kWidth, kHeight, kPitch, 1280, 720, false));
+
+SPOUT_BENCHMARK(rgba2bgra, c.rgba2bgra(s, d, kWidth, kHeight, false));
+SPOUT_BENCHMARK(rgba2bgraInvert, c.rgba2bgra(s, d, kWidth, kHeight, kInvert));
+SPOUT_BENCHMARK(rgba2bgraSrcPitch, c.rgba2bgra(s, d, kWidth, kHeight, kPitch, false));
+SPOUT_BENCHMARK(rgba2bgraPitch, c.rgba2bgra(s, d, kWidth, kHeight, kPitch, kPitch, false));
+SPOUT_BENCHMARK(bgra2rgba, c.bgra2rgba(s, d, kWidth, kHeight, false));
+
+SPOUT_BENCHMARK(rgba2rgb, c.rgba2rgb(s, d, kWidth, kHeight, kPitch, false, false, false));
+SPOUT_BENCHMARK(rgba2rgbSwapRB, c.rgba2rgb(s, d, kWidth, kHeight, kPitch, false, false, true));
+SPOUT_BENCHMARK(rgba2bgrPitch, c.rgba2bgr(s, d, kWidth, kHeight, kPitch, false));
+SPOUT_BENCHMARK(rgba2rgbResample, c.rgba2rgbResample(s, d, kWidth, kHeight, kPitch, 1280, 720));
+SPOUT_BENCHMARK(rgba2bgrResample, c.rgba2bgrResample(s, d, kWidth, kHeight, kPitch, 1280, 720));
+SPOUT_BENCHMARK(rgba_to_rgb_sse3, c.rgba_to_rgb_sse3(s, d, kWidth, kHeight, kPitch, false, false));
+SPOUT_BENCHMARK(rgba2bgr, c.rgba2bgr(s, d, kWidth, kHeight, false));
+SPOUT_BENCHMARK(bgra2rgb, c.bgra2rgb(s, d, kWidth, kHeight, false));
+SPOUT_BENCHMARK(bgra2bgr, c.bgra2bgr(s, d, kWidth, kHeight, false));
+
+SPOUT_BENCHMARK(rgb2rgba, c.rgb2rgba(s, d, kWidth, kHeight, false));
+SPOUT_BENCHMARK(rgb2rgbaPitch, c.rgb2rgba(s, d, kWidth, kHeight, kPitch, false));
+SPOUT_BENCHMARK(bgr2rgba, c.bgr2rgba(s, d, kWidth, kHeight, false));
+SPOUT_BENCHMARK(bgr2rgbaPitch, c.bgr2rgba(s, d, kWidth, kHeight, kPitch, false));
+SPOUT_BENCHMARK(rgb2bgra, c.rgb2bgra(s, d, kWidth, kHeight, false));
+SPOUT_BENCHMARK(rgb2bgraPitch, c.rgb2bgra(s, d, kWidth, kHeight, kPitch, false));
+SPOUT_BENCHMARK(rgb_to_bgrx_sse, for (unsigned int y = 0; y < kHeight; y++) c.rgb_to_bgrx_sse(kWidth, s + (size_t)y * kWidth * 3, d + (size_t)y * kWidth * 4));
+SPOUT_BENCHMARK(rgb_to_bgra_sse3, c.rgb_to_bgra_sse3(s, d, kWidth, kHeight));
+SPOUT_BENCHMARK(bgr2bgra, c.bgr2bgra(s, d, kWidth, kHeight, false));
+
+#endif // _WIN32
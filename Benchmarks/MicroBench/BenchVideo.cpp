@@ -0,0 +1,139 @@
+// Benchmarks/MicroBench/BenchVideo.cpp
+// FFmpegDecoder::DecodeNextFrame (demux, decode and the sws_scale conversion to BGRA) on
+// clips generated with the ffmpeg command line tool on first use.
+//
+// The tool is taken from DARO_BENCH_FFMPEG, otherwise "ffmpeg" on PATH. Set DARO_BENCH_CLIP
+// to decode an existing file instead. Without FFmpeg headers the decoder is a stub and these
+// benchmarks are not registered.
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "FFmpegDecoder.h"
+
+#if HAS_FFMPEG
+
+struct ClipSpec
+{
+    const char* name;
+    const char* encodeArgs;     // Codec options for the ffmpeg tool
+};
+
+// Codecs the FFmpeg fallback exists for (Media Foundation can't decode them)
+static const ClipSpec s_Clips[] = {
+    { "prores422",  "-c:v prores_ks -profile:v 2 -pix_fmt yuv422p10le" },
+    { "prores4444", "-c:v prores_ks -profile:v 4 -pix_fmt yuva444p10le" },
+    { "qtrle",      "-c:v qtrle -pix_fmt argb" },
+    { "mpeg4",      "-c:v mpeg4 -q:v 3 -pix_fmt yuv420p" },
+};
+
+static std::string TempDir()
+{
+#ifdef _WIN32
+    const char* dir = getenv("TEMP");
+    return std::string(dir ? dir : ".") + "\\";
+#else
+    const char* dir = getenv("TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/";
+#endif
+}
+
+static bool FileExists(const std::string& path)
+{
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    fclose(f);
+    return true;
+}
+
+// Two seconds of testsrc2 at 25 fps; reused across runs
+static std::string GenerateClip(const ClipSpec& clip, int width, int height)
+{
+    std::string path = TempDir() + "daro_microbench_" + clip.name + "_" +
+        std::to_string(width) + "x" + std::to_string(height) + ".mov";
+    if (FileExists(path)) return path;
+
+    const char* tool = getenv("DARO_BENCH_FFMPEG");
+    std::string command = std::string("\"") + (tool ? tool : "ffmpeg") + "\"" +
+        " -v error -y -f lavfi -i testsrc2=size=" + std::to_string(width) + "x" + std::to_string(height) +
+        ":rate=25 -t 2 " + clip.encodeArgs + " \"" + path + "\"";
+#ifdef _WIN32
+    command = "\"" + command + "\"";    // cmd.exe strips the outer quotes
+#endif
+    if (system(command.c_str()) != 0 || !FileExists(path)) return std::string();
+    return path;
+}
+
+static void DecodeClip(benchmark::State& state, const std::string& path)
+{
+    if (path.empty())
+    {
+        state.SkipWithError("Could not generate clip (is the ffmpeg tool on PATH?)");
+        return;
+    }
+
+    FFmpegDecoder decoder;
+    if (!decoder.Open(path.c_str()))
+    {
+        state.SkipWithError("FFmpegDecoder::Open failed");
+        return;
+    }
+
+    int64_t frames = 0;
+    for (auto _ : state)
+    {
+        if (!decoder.DecodeNextFrame())
+        {
+            // End of clip: rewind outside the timed region and decode again
+            state.PauseTiming();
+            bool rewound = decoder.IsEndOfStream() && decoder.SeekToFrame(0);
+            state.ResumeTiming();
+            if (!rewound || !decoder.DecodeNextFrame())
+            {
+                state.SkipWithError("DecodeNextFrame failed");
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(decoder.GetFrameData());
+        frames++;
+    }
+
+    state.SetItemsProcessed(frames);
+    state.SetBytesProcessed(frames * (int64_t)decoder.GetWidth() * decoder.GetHeight() * 4);
+}
+
+static void BM_FFmpegDecode(benchmark::State& state, const ClipSpec& clip, int width, int height)
+{
+    DecodeClip(state, GenerateClip(clip, width, height));
+}
+
+static void BM_FFmpegDecodeFile(benchmark::State& state, const char* path)
+{
+    DecodeClip(state, path);
+}
+
+static int RegisterVideoBenchmarks()
+{
+    if (const char* clip = getenv("DARO_BENCH_CLIP"))
+    {
+        benchmark::RegisterBenchmark("BM_FFmpegDecode/file", BM_FFmpegDecodeFile, clip)
+            ->Unit(benchmark::kMillisecond);
+        return 0;
+    }
+
+    for (const ClipSpec& clip : s_Clips)
+    {
+        for (int height : { 1080, 2160 })
+        {
+            int width = height * 16 / 9;
+            std::string name = std::string("BM_FFmpegDecode/") + clip.name + "/" + std::to_string(height) + "p";
+            benchmark::RegisterBenchmark(name.c_str(), BM_FFmpegDecode, clip, width, height)
+                ->Unit(benchmark::kMillisecond);
+        }
+    }
+    return 0;
+}
+
+static int s_VideoBenchmarks = RegisterVideoBenchmarks();
+
+#endif // HAS_FFMPEG
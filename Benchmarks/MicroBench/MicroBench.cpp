@@ -0,0 +1,23 @@
+// Benchmarks/MicroBench/MicroBench.cpp
+// Google Benchmark microbenchmarks for the engine's CPU hot paths. The engine sources under
+// test are compiled into this executable directly (no D3D device, no DaroEngine.dll), so
+// the portable benchmarks also build and run on Linux - see CMakeLists.txt.
+//
+// Compare a run against the checked-in baseline for the platform with Google Benchmark's
+// tools/compare.py:
+//   compare.py benchmarks baselines/linux-x64.json new.json
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include "Trace.h"
+
+// Defined in VideoPlayer.cpp and Trace.cpp, which are not compiled in (Media Foundation,
+// QueryPerformanceCounter). Tracing is never enabled here, so DARO_TRACE_SCOPE only checks the flag.
+void VideoLog(const char* msg)
+{
+    fputs(msg, stderr);
+}
+
+long long DaroTrace::Now() { return 0; }
+void DaroTrace::Record(const char*, long long, long long) {}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,1313 @@
+// Benchmarks/Replay/Replay.cpp
+// Replays an API capture (Daro_StartCapture, Engine/Capture.h) against the engine, so
+// a stutter seen in production can be reproduced and profiled on a developer machine.
+//
+// By default every captured thread gets a replay thread that issues its calls at the
+// recorded times; --fast issues all calls back to back on one thread in file order.
+// Ids handed out by the engine (textures, videos, Spout receivers) are mapped from the
+// recorded ids to the ones the replaying engine returns, including inside layers.
+// Frames of the native render loop are replayed from their per-frame records at the
+// recorded times instead of starting a loop of our own.
+// Frame times, engine timing percentiles, dropped/late frames and per-call durations
+// are written as JSON.
+//
+// Off Windows only --dump and --summary are available: the engine has no backend that
+// runs there, but capture files can still be inspected.
+//
+//   Replay CAPTURE [--fast] [--speed X] [--path-map FROM=TO]... [--no-outputs]
+//                  [--trace FILE] [--label TEXT] [--out FILE]
+//   Replay CAPTURE --dump | --summary
+#define NOMINMAX
+#define _CRT_SECURE_NO_WARNINGS
+#include "Capture.h"
+#include "CommandBuffer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include "DaroEngine.h"
+#include <Windows.h>
+#include <timeapi.h>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+#define REPLAY_SCHEMA 1
+#define REPLAY_MAX_QUEUED 16384     // Decoded events waiting for their replay thread
+
+struct ReplayOptions
+{
+    std::string capture;
+    bool fast = false;
+    double speed = 1.0;
+    std::vector<std::pair<std::string, std::string>> pathMap;
+    bool outputs = true;
+    std::string trace;
+    std::string label;
+    std::string out;
+    bool dump = false;
+    bool summary = false;
+};
+
+// ============== Inspection ==============
+
+static double ToMs(uint64_t ns) { return (double)ns / 1e6; }
+
+// Arguments of an event as text, following DaroCaptureCallArgs
+static std::string FormatArgs(const DaroCaptureEvent& event)
+{
+    const char* signature = DaroCaptureCallArgs(event.call);
+    if (!signature) return "?";
+
+    DaroCaptureArgs args(event.args, event.argsSize);
+    std::string text;
+    std::string value;
+    std::vector<uint8_t> blob;
+    char number[64];
+    for (const char* c = signature; *c; c++)
+    {
+        if (*c == 'L')
+        {
+            snprintf(number, sizeof(number), ", layer +%u bytes", event.layerChangedBytes);
+            text += number;
+            continue;
+        }
+        if (*c == 'R') text += ") -> ";
+        else if (c != signature) text += ", ";
+
+        switch (*c)
+        {
+        case 'i': case 'R': snprintf(number, sizeof(number), "%lld", args.Int()); text += number; break;
+        case 'b': text += args.Bool() ? "true" : "false"; break;
+        case 'f': snprintf(number, sizeof(number), "%g", args.Float()); text += number; break;
+        case 'd': snprintf(number, sizeof(number), "%g", args.Double()); text += number; break;
+        case 's': text += args.Str(&value) ? "\"" + value + "\"" : "null"; break;
+        case 'x':
+        {
+            if (!args.Blob(&blob))
+            {
+                text += "null";
+                break;
+            }
+            DaroSubmitHeader header;
+            std::vector<DaroSubmitCommand> commands;
+            if (event.call == DARO_CALL_SUBMIT && c == signature &&
+                DaroParseCommandBuffer(blob.data(), blob.size(), &header, &commands))
+                snprintf(number, sizeof(number), "%zu commands%s, %zu bytes", commands.size(),
+                    (header.flags & DARO_SUBMIT_QUEUED) ? " queued" : "", blob.size());
+            else
+                snprintf(number, sizeof(number), "%zu bytes", blob.size());
+            text += number;
+            break;
+        }
+        }
+    }
+    if (!strchr(signature, 'R')) text += ")";
+    if (!args.IsValid()) text += " <truncated>";
+    return text;
+}
+
+static int Dump(const ReplayOptions& options)
+{
+    DaroCaptureReader reader;
+    if (!reader.Open(options.capture.c_str()))
+    {
+        fprintf(stderr, "Replay: %s is not a capture file\n", options.capture.c_str());
+        return 1;
+    }
+
+    DaroCaptureEvent event;
+    while (reader.Next(&event))
+    {
+        const char* name = DaroCaptureCallName(event.call);
+        char thread[8];
+        if (event.thread == DARO_CAPTURE_THREAD_PREAMBLE) snprintf(thread, sizeof(thread), "pre");
+        else snprintf(thread, sizeof(thread), "t%d", event.thread);
+        printf("%12.3f ms  %-4s %s(%s\n", ToMs(event.timestampNs), thread,
+            name ? name : "<unknown>", FormatArgs(event).c_str());
+    }
+    if (reader.IsTruncated())
+        fprintf(stderr, "Replay: capture is truncated\n");
+    return 0;
+}
+
+static int Summary(const ReplayOptions& options)
+{
+    DaroCaptureReader reader;
+    if (!reader.Open(options.capture.c_str()))
+    {
+        fprintf(stderr, "Replay: %s is not a capture file\n", options.capture.c_str());
+        return 1;
+    }
+
+    std::vector<uint64_t> counts(256, 0);
+    std::vector<bool> threads(256, false);
+    uint64_t events = 0, endNs = 0, layerBytes = 0;
+    DaroCaptureEvent event;
+    while (reader.Next(&event))
+    {
+        events++;
+        counts[event.call & 0xFF]++;
+        threads[event.thread & 0xFF] = true;
+        endNs = std::max(endNs, event.timestampNs);
+        layerBytes += event.layerChangedBytes;
+    }
+
+    const DaroCaptureHeader& header = reader.GetHeader();
+    int threadCount = 0;
+    for (int i = 0; i < DARO_CAPTURE_THREAD_PREAMBLE; i++) threadCount += threads[i] ? 1 : 0;
+    printf("Capture      %s%s\n", options.capture.c_str(), reader.IsTruncated() ? " (truncated)" : "");
+    printf("Started      %lld ms since epoch, layer size %u\n", (long long)header.startUnixMs, header.layerSize);
+    printf("Duration     %.3f s, %llu calls on %d threads%s\n", ToMs(endNs) / 1000.0,
+        (unsigned long long)events, threadCount, threads[DARO_CAPTURE_THREAD_PREAMBLE] ? " plus preamble" : "");
+    uint64_t updates = counts[DARO_CALL_UPDATE_LAYER];
+    if (updates > 0)
+        printf("Layers       %llu updates, %.1f changed bytes each\n", (unsigned long long)updates, (double)layerBytes / updates);
+    for (int call = 0; call < 256; call++)
+    {
+        if (counts[call] == 0) continue;
+        const char* name = DaroCaptureCallName(call);
+        printf("  %-32s %10llu\n", name ? name : "<unknown>", (unsigned long long)counts[call]);
+    }
+    return 0;
+}
+
+// ============== Replay ==============
+
+#ifdef _WIN32
+
+struct Percentiles
+{
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+static Percentiles Summarize(std::vector<double> values)
+{
+    Percentiles result;
+    if (values.empty()) return result;
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    auto rank = [&](double p) { return values[(size_t)(p * (values.size() - 1) + 0.5)]; };
+    result.mean = sum / values.size();
+    result.p50 = rank(0.50);
+    result.p95 = rank(0.95);
+    result.p99 = rank(0.99);
+    result.max = values.back();
+    return result;
+}
+
+static double NowMs()
+{
+    static LARGE_INTEGER freq = [] { LARGE_INTEGER f; QueryPerformanceFrequency(&f); return f; }();
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart * 1000.0 / (double)freq.QuadPart;
+}
+
+struct ReplayEvent
+{
+    int call = 0;
+    int thread = 0;
+    double dueMs = 0.0;             // Capture timeline, before --speed
+    std::vector<uint8_t> args;
+    std::vector<uint8_t> layer;     // Full layer for Daro_UpdateLayer
+};
+
+struct CallStats
+{
+    uint64_t count = 0;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+};
+
+// Engine counters read before each Daro_Shutdown and at the end of the replay
+struct SessionStats
+{
+    int droppedFrames = 0;
+    int lateFrames = 0;
+    DaroTimingSummary timing[DARO_TIMING_METRIC_COUNT] = {};
+};
+
+// Owned by one replay thread, merged at the end
+struct ThreadStats
+{
+    CallStats calls[256];
+    std::vector<double> frameMs;    // Daro_BeginFrame to the end of Daro_EndFrame
+    std::vector<double> intervalMs; // Daro_EndFrame to Daro_EndFrame
+    std::vector<double> driftMs;    // How late each call was issued against its recorded time
+    double beginMs = -1.0;
+    double lastEndMs = -1.0;
+};
+
+class Replayer
+{
+public:
+    explicit Replayer(const ReplayOptions& options) : m_Options(options) {}
+
+    void Execute(const ReplayEvent& event, ThreadStats& stats);
+    void CollectSession();
+    bool IsInitialized() const { return m_Initialized; }
+    const std::vector<SessionStats>& GetSessions() const { return m_Sessions; }
+
+private:
+    int MapId(std::map<int, int>& ids, int recorded);
+    void SetId(std::map<int, int>& ids, int recorded, int id);
+    void EraseId(std::map<int, int>& ids, int recorded);
+    void MapLayerIds(DaroLayer* layer);
+    void MapTransitionIds(DaroTransition* transition);
+    bool ReadTransition(DaroCaptureArgs& args, DaroTransition* transition);
+    std::string MapPath(const std::string& path) const;
+
+    const ReplayOptions& m_Options;
+    std::mutex m_Mutex;                 // Guards the id maps and sessions
+    std::map<int, int> m_Textures;
+    std::map<int, int> m_Videos;
+    std::map<int, int> m_Receivers;
+    std::vector<SessionStats> m_Sessions;
+    std::atomic<bool> m_Initialized{ false };
+};
+
+int Replayer::MapId(std::map<int, int>& ids, int recorded)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = ids.find(recorded);
+    return it != ids.end() ? it->second : -1;
+}
+
+void Replayer::SetId(std::map<int, int>& ids, int recorded, int id)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (recorded >= 0) ids[recorded] = id;
+}
+
+void Replayer::EraseId(std::map<int, int>& ids, int recorded)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ids.erase(recorded);
+}
+
+void Replayer::MapLayerIds(DaroLayer* layer)
+{
+    if (layer->sourceType == DARO_SOURCE_IMAGE) layer->textureId = MapId(m_Textures, layer->textureId);
+    else if (layer->sourceType == DARO_SOURCE_VIDEO) layer->textureId = MapId(m_Videos, layer->textureId);
+    else if (layer->sourceType == DARO_SOURCE_SPOUT) layer->spoutReceiverId = MapId(m_Receivers, layer->spoutReceiverId);
+}
+
+void Replayer::MapTransitionIds(DaroTransition* transition)
+{
+    if (transition->maskTextureId > 0) transition->maskTextureId = MapId(m_Textures, transition->maskTextureId);
+}
+
+// False for a null or short recorded struct
+bool Replayer::ReadTransition(DaroCaptureArgs& args, DaroTransition* transition)
+{
+    std::vector<uint8_t> bytes;
+    if (!args.Blob(&bytes) || bytes.size() != sizeof(DaroTransition)) return false;
+    memcpy(transition, bytes.data(), sizeof(DaroTransition));
+    MapTransitionIds(transition);
+    return true;
+}
+
+std::string Replayer::MapPath(const std::string& path) const
+{
+    for (const auto& mapping : m_Options.pathMap)
+    {
+        if (path.compare(0, mapping.first.size(), mapping.first) == 0)
+            return mapping.second + path.substr(mapping.first.size());
+    }
+    return path;
+}
+
+void Replayer::CollectSession()
+{
+    if (!m_Initialized) return;
+    SessionStats session;
+    session.droppedFrames = Daro_GetDroppedFrames();
+    session.lateFrames = Daro_GetLateFrames();
+    for (int metric = 0; metric < DARO_TIMING_METRIC_COUNT; metric++)
+        Daro_GetTimingSummary(metric, DARO_TIMING_SINCE_RESET, &session.timing[metric]);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Sessions.push_back(session);
+}
+
+void Replayer::Execute(const ReplayEvent& event, ThreadStats& stats)
+{
+    DaroCaptureArgs args(event.args.data(), event.args.size());
+    std::string text, text2;
+    double start = NowMs();
+
+    switch (event.call)
+    {
+    case DARO_CALL_INITIALIZE:
+    {
+        int width = (int)args.Int(), height = (int)args.Int();
+        double fps = args.Double();
+        if (Daro_Initialize(width, height, fps) == DARO_OK)
+        {
+            m_Initialized = true;
+            if (!m_Options.trace.empty()) Daro_StartTrace();
+        }
+        break;
+    }
+    case DARO_CALL_SHUTDOWN:
+        CollectSession();
+        if (!m_Options.trace.empty() && m_Initialized)
+            Daro_WriteTrace(m_Options.trace.c_str(), DARO_TRACE_FORMAT_PERFETTO);
+        Daro_Shutdown();
+        m_Initialized = false;
+        break;
+    case DARO_CALL_IS_INITIALIZED: Daro_IsInitialized(); break;
+    case DARO_CALL_GET_LAST_ERROR: Daro_GetLastError(); break;
+    case DARO_CALL_BEGIN_FRAME:
+        stats.beginMs = start;
+        Daro_BeginFrame();
+        break;
+    case DARO_CALL_END_FRAME:
+    {
+        Daro_EndFrame();
+        double end = NowMs();
+        if (stats.beginMs >= 0.0) stats.frameMs.push_back(end - stats.beginMs);
+        if (stats.lastEndMs >= 0.0) stats.intervalMs.push_back(end - stats.lastEndMs);
+        stats.beginMs = -1.0;
+        stats.lastEndMs = end;
+        break;
+    }
+    case DARO_CALL_RENDER: Daro_Render(); break;
+    case DARO_CALL_PRESENT: Daro_Present(); break;
+    case DARO_CALL_WAIT_FOR_FRAME: break;       // Frame numbers differ from the original run
+    case DARO_CALL_START_RENDER_LOOP: break;    // Loop frames are replayed from their records below
+    case DARO_CALL_STOP_RENDER_LOOP: break;
+    case DARO_CALL_IS_RENDER_LOOP_RUNNING: Daro_IsRenderLoopRunning(); break;
+    case DARO_CALL_GET_RENDER_LOOP_STATS:
+    {
+        DaroRenderLoopStats loopStats;
+        Daro_GetRenderLoopStats(&loopStats);
+        break;
+    }
+    case DARO_CALL_SET_EXTERNAL_CLOCK: break;   // Genlock only paces the loop, which is not replayed
+    case DARO_CALL_GET_GENLOCK_STATS:
+    {
+        DaroGenlockStats genlock;
+        Daro_GetGenlockStats(&genlock);
+        break;
+    }
+    case DARO_CALL_START_TICK_GENERATOR: break;
+    case DARO_CALL_STOP_TICK_GENERATOR: break;
+    case DARO_CALL_LOCK_RENDER_LOOP: Daro_LockRenderLoop(); break;
+    case DARO_CALL_UNLOCK_RENDER_LOOP: Daro_UnlockRenderLoop(); break;
+    case DARO_CALL_RENDER_LOOP_FRAME:
+    {
+        Daro_LockRenderLoop();
+        Daro_BeginFrame();
+        Daro_Render();
+        Daro_Present();
+        Daro_EndFrame();
+        Daro_UnlockRenderLoop();
+        double end = NowMs();
+        stats.frameMs.push_back(end - start);
+        if (stats.lastEndMs >= 0.0) stats.intervalMs.push_back(end - stats.lastEndMs);
+        stats.lastEndMs = end;
+        break;
+    }
+    case DARO_CALL_LOCK_FRAME_BUFFER:
+    {
+        void* data = nullptr;
+        int width = 0, height = 0, stride = 0;
+        Daro_LockFrameBuffer(&data, &width, &height, &stride);
+        break;
+    }
+    case DARO_CALL_UNLOCK_FRAME_BUFFER: Daro_UnlockFrameBuffer(); break;
+    case DARO_CALL_GET_FRAME_NUMBER: Daro_GetFrameNumber(); break;
+    case DARO_CALL_SET_LAYER_COUNT: Daro_SetLayerCount((int)args.Int()); break;
+    case DARO_CALL_UPDATE_LAYER:
+    {
+        int index = (int)args.Int();
+        if (event.layer.size() != sizeof(DaroLayer)) break;
+        DaroLayer layer;
+        memcpy(&layer, event.layer.data(), sizeof(layer));
+        MapLayerIds(&layer);
+        Daro_UpdateLayer(index, &layer);
+        break;
+    }
+    case DARO_CALL_QUEUE_LAYER_UPDATE:
+    {
+        int when = (int)args.Int();
+        long long at = args.Int();
+        int index = (int)args.Int();
+        if (event.layer.size() != sizeof(DaroLayer)) break;
+        DaroLayer layer;
+        memcpy(&layer, event.layer.data(), sizeof(layer));
+        MapLayerIds(&layer);
+        Daro_QueueLayerUpdate(when, at, index, &layer);
+        break;
+    }
+    case DARO_CALL_QUEUE_COMMAND:
+    {
+        int when = (int)args.Int();
+        long long at = args.Int();
+        int type = (int)args.Int();
+        int target = (int)args.Int();
+        long long value = args.Int();
+        if (type >= DARO_CMD_PLAY_VIDEO && type <= DARO_CMD_SET_VIDEO_ALPHA) target = MapId(m_Videos, target);
+        Daro_QueueCommand(when, at, type, target, value);
+        break;
+    }
+    case DARO_CALL_BEGIN_COMMAND_BATCH: Daro_BeginCommandBatch(); break;
+    case DARO_CALL_END_COMMAND_BATCH:
+    {
+        int when = (int)args.Int();
+        long long at = args.Int();
+        Daro_EndCommandBatch(when, at);
+        break;
+    }
+    case DARO_CALL_GET_COMMAND_QUEUE_STATS:
+    {
+        DaroCommandQueueStats queueStats;
+        Daro_GetCommandQueueStats(&queueStats);
+        break;
+    }
+    case DARO_CALL_SUBMIT:
+    {
+        std::vector<uint8_t> buffer, recorded;
+        bool hasBuffer = args.Blob(&buffer);
+        args.Blob(&recorded);
+        DaroSubmitHeader header;
+        std::vector<DaroSubmitCommand> commands;
+        if (!hasBuffer || !DaroParseCommandBuffer(buffer.data(), buffer.size(), &header, &commands))
+        {
+            Daro_Submit(hasBuffer ? buffer.data() : nullptr, buffer.size(), nullptr, 0);
+            break;
+        }
+
+        // Rebuild the buffer with this replay's paths and asset ids; references to loads
+        // in the same buffer stay as they are
+        DaroCommandBufferWriter writer;
+        writer.Reset(header.flags, header.when, header.at);
+        std::vector<std::string> paths(commands.size());
+        for (size_t i = 0; i < commands.size(); i++)
+        {
+            DaroSubmitCommand command = commands[i];
+            DaroLayer layer;
+            DaroTransition transition;
+            if (command.status == DARO_SUBMIT_OK)
+            {
+                if (!DaroIsSubmitRef(command.id))
+                {
+                    if (DaroSubmitOpTakesTexture(command.op)) command.id = MapId(m_Textures, command.id);
+                    else if (DaroSubmitOpTakesVideo(command.op)) command.id = MapId(m_Videos, command.id);
+                }
+
+                if (command.op == DARO_OP_LOAD_TEXTURE || command.op == DARO_OP_LOAD_VIDEO)
+                {
+                    paths[i] = MapPath(command.text);
+                    command.text = paths[i].c_str();
+                }
+                else if (command.op == DARO_OP_UPDATE_LAYER)
+                {
+                    memcpy(&layer, command.layer, sizeof(layer));
+                    int textureId = layer.textureId;
+                    MapLayerIds(&layer);
+                    if (DaroIsSubmitRef(textureId)) layer.textureId = textureId;
+                    command.layer = &layer;
+                }
+                else if (command.op == DARO_OP_TRANSITION_SCENE)
+                {
+                    memcpy(&transition, command.transition, sizeof(transition));
+                    MapTransitionIds(&transition);
+                    command.transition = &transition;
+                }
+            }
+            writer.Add(command);
+        }
+        std::vector<int> results(commands.size());
+        Daro_Submit(writer.Data(), writer.Size(), results.data(), (int)results.size());
+
+        // The ids the recorded loads returned now map to the ones returned here
+        for (size_t i = 0; i < commands.size() && (i + 1) * sizeof(int) <= recorded.size(); i++)
+        {
+            int result;
+            memcpy(&result, recorded.data() + i * sizeof(int), sizeof(result));
+            const DaroSubmitCommand& command = commands[i];
+            if (command.op == DARO_OP_LOAD_TEXTURE) SetId(m_Textures, result, results[i]);
+            else if (command.op == DARO_OP_LOAD_VIDEO) SetId(m_Videos, result, results[i]);
+            else if (result >= 0 && !DaroIsSubmitRef(command.id))
+            {
+                if (command.op == DARO_OP_UNLOAD_TEXTURE) EraseId(m_Textures, command.id);
+                else if (command.op == DARO_OP_UNLOAD_VIDEO) EraseId(m_Videos, command.id);
+            }
+        }
+        break;
+    }
+    case DARO_CALL_GET_LAYER:
+    {
+        DaroLayer layer;
+        Daro_GetLayer((int)args.Int(), &layer);
+        break;
+    }
+    case DARO_CALL_CLEAR_LAYERS: Daro_ClearLayers(); break;
+    case DARO_CALL_SET_SCENE_LAYER_COUNT:
+    {
+        int slot = (int)args.Int();
+        Daro_SetSceneLayerCount(slot, (int)args.Int());
+        break;
+    }
+    case DARO_CALL_UPDATE_SCENE_LAYER:
+    {
+        int slot = (int)args.Int();
+        int index = (int)args.Int();
+        if (event.layer.size() != sizeof(DaroLayer)) break;
+        DaroLayer layer;
+        memcpy(&layer, event.layer.data(), sizeof(layer));
+        MapLayerIds(&layer);
+        Daro_UpdateSceneLayer(slot, index, &layer);
+        break;
+    }
+    case DARO_CALL_GET_SCENE_LAYER:
+    {
+        int slot = (int)args.Int();
+        DaroLayer layer;
+        Daro_GetSceneLayer(slot, (int)args.Int(), &layer);
+        break;
+    }
+    case DARO_CALL_GET_SCENE_LAYER_COUNT: Daro_GetSceneLayerCount((int)args.Int()); break;
+    case DARO_CALL_CLEAR_SCENE: Daro_ClearScene((int)args.Int()); break;
+    case DARO_CALL_COPY_SCENE:
+    {
+        int fromSlot = (int)args.Int();
+        Daro_CopyScene(fromSlot, (int)args.Int());
+        break;
+    }
+    case DARO_CALL_TAKE_SCENE: Daro_TakeScene((int)args.Int()); break;
+    case DARO_CALL_GET_PROGRAM_SLOT: Daro_GetProgramSlot(); break;
+    case DARO_CALL_SET_PREVIEW_SLOT: Daro_SetPreviewSlot((int)args.Int()); break;
+    case DARO_CALL_GET_PREVIEW_SLOT: Daro_GetPreviewSlot(); break;
+    case DARO_CALL_TRANSITION_SCENE:
+    {
+        int slot = (int)args.Int();
+        DaroTransition transition;
+        Daro_TransitionScene(slot, ReadTransition(args, &transition) ? &transition : nullptr);
+        break;
+    }
+    case DARO_CALL_QUEUE_TRANSITION:
+    {
+        int when = (int)args.Int();
+        long long at = args.Int();
+        int slot = (int)args.Int();
+        DaroTransition transition;
+        Daro_QueueTransition(when, at, slot, ReadTransition(args, &transition) ? &transition : nullptr);
+        break;
+    }
+    case DARO_CALL_GET_TRANSITION_STATE:
+    {
+        DaroTransitionState state;
+        Daro_GetTransitionState(&state);
+        break;
+    }
+    case DARO_CALL_SET_TIMELINE_TRACK:
+    {
+        int slot = (int)args.Int();
+        int layerIndex = (int)args.Int();
+        int field = (int)args.Int();
+        std::vector<uint8_t> bytes;
+        bool hasKeys = args.Blob(&bytes);
+        std::vector<DaroKeyframe> keys(bytes.size() / sizeof(DaroKeyframe));
+        if (!keys.empty()) memcpy(keys.data(), bytes.data(), keys.size() * sizeof(DaroKeyframe));
+        int count = (int)args.Int();
+        Daro_SetTimelineTrack(slot, layerIndex, field, hasKeys ? keys.data() : nullptr,
+            hasKeys && count > (int)keys.size() ? (int)keys.size() : count);
+        break;
+    }
+    case DARO_CALL_SET_TIMELINE_MARKERS:
+    {
+        int slot = (int)args.Int();
+        std::vector<uint8_t> bytes;
+        bool hasMarkers = args.Blob(&bytes);
+        std::vector<DaroTimelineMarker> markers(bytes.size() / sizeof(DaroTimelineMarker));
+        if (!markers.empty()) memcpy(markers.data(), bytes.data(), markers.size() * sizeof(DaroTimelineMarker));
+        int count = (int)args.Int();
+        Daro_SetTimelineMarkers(slot, hasMarkers ? markers.data() : nullptr,
+            hasMarkers && count > (int)markers.size() ? (int)markers.size() : count);
+        break;
+    }
+    case DARO_CALL_SET_TIMELINE_LENGTH:
+    {
+        int slot = (int)args.Int();
+        Daro_SetTimelineLength(slot, (int)args.Int());
+        break;
+    }
+    case DARO_CALL_CLEAR_TIMELINE: Daro_ClearTimeline((int)args.Int()); break;
+    case DARO_CALL_PLAY_TIMELINE: Daro_PlayTimeline((int)args.Int()); break;
+    case DARO_CALL_STOP_TIMELINE: Daro_StopTimeline((int)args.Int()); break;
+    case DARO_CALL_SEEK_TIMELINE:
+    {
+        int slot = (int)args.Int();
+        Daro_SeekTimeline(slot, (int)args.Int());
+        break;
+    }
+    case DARO_CALL_CONTINUE_TIMELINE: Daro_ContinueTimeline((int)args.Int()); break;
+    case DARO_CALL_GET_TIMELINE_STATE:
+    {
+        DaroTimelineState state;
+        Daro_GetTimelineState((int)args.Int(), &state);
+        break;
+    }
+    case DARO_CALL_GET_DATA_KEY:
+    {
+        // Keys are handed out in order, so a replay from the preamble gets the recorded ids
+        Daro_GetDataKey(args.Str(&text) ? text.c_str() : nullptr);
+        break;
+    }
+    case DARO_CALL_SET_DATA_NUMBERS:
+    {
+        std::vector<uint8_t> keyBytes, valueBytes;
+        bool hasKeys = args.Blob(&keyBytes);
+        bool hasValues = args.Blob(&valueBytes);
+        int count = (int)args.Int();
+        std::vector<int> keys(keyBytes.size() / sizeof(int));
+        std::vector<double> values(valueBytes.size() / sizeof(double));
+        if (!keys.empty()) memcpy(keys.data(), keyBytes.data(), keys.size() * sizeof(int));
+        if (!values.empty()) memcpy(values.data(), valueBytes.data(), values.size() * sizeof(double));
+        if (hasKeys && hasValues) count = std::min(count, (int)std::min(keys.size(), values.size()));
+        Daro_SetDataNumbers(hasKeys ? keys.data() : nullptr, hasValues ? values.data() : nullptr, count);
+        break;
+    }
+    case DARO_CALL_SET_DATA_TEXTS:
+    {
+        std::vector<uint8_t> keyBytes, textBytes;
+        bool hasKeys = args.Blob(&keyBytes);
+        bool hasTexts = args.Blob(&textBytes);
+        int count = (int)args.Int();
+        std::vector<int> keys(keyBytes.size() / sizeof(int));
+        if (!keys.empty()) memcpy(keys.data(), keyBytes.data(), keys.size() * sizeof(int));
+        // Each text is a uint32 length and that many UTF-16 units (see PackDataTexts)
+        std::vector<std::vector<wchar_t>> texts;
+        size_t offset = 0;
+        while (offset + sizeof(uint32_t) <= textBytes.size())
+        {
+            uint32_t length;
+            memcpy(&length, &textBytes[offset], sizeof(length));
+            offset += sizeof(length);
+            if (length > (textBytes.size() - offset) / sizeof(uint16_t)) break;
+            std::vector<wchar_t> value(length + 1, 0);
+            for (uint32_t c = 0; c < length; c++)
+            {
+                uint16_t unit;
+                memcpy(&unit, &textBytes[offset + c * sizeof(uint16_t)], sizeof(unit));
+                value[c] = (wchar_t)unit;
+            }
+            offset += length * sizeof(uint16_t);
+            texts.push_back(std::move(value));
+        }
+        std::vector<const wchar_t*> pointers;
+        for (const std::vector<wchar_t>& value : texts) pointers.push_back(value.data());
+        if (hasKeys && hasTexts) count = std::min(count, (int)std::min(keys.size(), pointers.size()));
+        Daro_SetDataTexts(hasKeys ? keys.data() : nullptr, hasTexts ? pointers.data() : nullptr, count);
+        break;
+    }
+    case DARO_CALL_BIND_LAYER_FIELD:
+    {
+        int slot = (int)args.Int();
+        int layerIndex = (int)args.Int();
+        int field = (int)args.Int();
+        Daro_BindLayerField(slot, layerIndex, field, (int)args.Int());
+        break;
+    }
+    case DARO_CALL_CLEAR_DATA_BINDINGS: Daro_ClearDataBindings((int)args.Int()); break;
+    case DARO_CALL_ENABLE_DATA_INGEST:
+    {
+        bool hasName = args.Str(&text);
+        int entryCount = (int)args.Int();
+        if (m_Options.outputs) Daro_EnableDataIngest(hasName ? text.c_str() : nullptr, entryCount);
+        break;
+    }
+    case DARO_CALL_DISABLE_DATA_INGEST: Daro_DisableDataIngest(); break;
+    case DARO_CALL_GET_DATA_STORE_STATS:
+    {
+        DaroDataStoreStats stats;
+        Daro_GetDataStoreStats(&stats);
+        break;
+    }
+    case DARO_CALL_PLAY: Daro_Play(); break;
+    case DARO_CALL_STOP: Daro_Stop(); break;
+    case DARO_CALL_SEEK_TO_FRAME: Daro_SeekToFrame((int)args.Int()); break;
+    case DARO_CALL_SEEK_TO_TIME: Daro_SeekToTime(args.Float()); break;
+    case DARO_CALL_IS_PLAYING: Daro_IsPlaying(); break;
+    case DARO_CALL_GET_CURRENT_FRAME: Daro_GetCurrentFrame(); break;
+    case DARO_CALL_GET_FPS: Daro_GetFPS(); break;
+    case DARO_CALL_GET_FRAME_TIME: Daro_GetFrameTime(); break;
+    case DARO_CALL_GET_DROPPED_FRAMES: Daro_GetDroppedFrames(); break;
+    case DARO_CALL_GET_LATE_FRAMES: Daro_GetLateFrames(); break;
+    case DARO_CALL_GET_FRAME_STATS:
+    {
+        static thread_local std::vector<DaroFrameStats> frames;
+        int count = (int)args.Int();
+        frames.resize(count > 0 ? (size_t)count : 0);
+        Daro_GetFrameStats(frames.data(), count);
+        break;
+    }
+    case DARO_CALL_GET_TIMING_SUMMARY:
+    {
+        int metric = (int)args.Int(), window = (int)args.Int();
+        DaroTimingSummary summary;
+        Daro_GetTimingSummary(metric, window, &summary);
+        break;
+    }
+    case DARO_CALL_SET_TIMING_WINDOW: Daro_SetTimingWindow((int)args.Int()); break;
+    case DARO_CALL_RESET_TIMING_STATS: break;   // Stats cover the whole session
+    case DARO_CALL_START_TRACE: if (m_Options.trace.empty()) Daro_StartTrace(); break;
+    case DARO_CALL_STOP_TRACE: if (m_Options.trace.empty()) Daro_StopTrace(); break;
+    case DARO_CALL_IS_TRACE_ENABLED: Daro_IsTraceEnabled(); break;
+    case DARO_CALL_WRITE_TRACE: break;          // Never overwrite the original's files
+    case DARO_CALL_ENABLE_SPOUT_OUTPUT:
+        if (m_Options.outputs) Daro_EnableSpoutOutput(args.Str(&text) ? text.c_str() : nullptr);
+        break;
+    case DARO_CALL_DISABLE_SPOUT_OUTPUT: Daro_DisableSpoutOutput(); break;
+    case DARO_CALL_IS_SPOUT_ENABLED: Daro_IsSpoutEnabled(); break;
+    case DARO_CALL_SET_SPOUT_SEND_TIMEOUT: Daro_SetSpoutSendTimeout((int)args.Int()); break;
+    case DARO_CALL_GET_SPOUT_OUTPUT_STATS:
+    {
+        DaroSpoutOutputStats output;
+        Daro_GetSpoutOutputStats(&output);
+        break;
+    }
+    case DARO_CALL_SET_OUTPUT_METADATA:
+    {
+        bool hasTemplate = args.Str(&text);
+        bool hasItem = args.Str(&text2);
+        Daro_SetOutputMetadata(hasTemplate ? text.c_str() : nullptr, hasItem ? text2.c_str() : nullptr);
+        break;
+    }
+    case DARO_CALL_ENABLE_FRAME_TRANSPORT:
+        if (m_Options.outputs) Daro_EnableFrameTransport(args.Str(&text) ? text.c_str() : nullptr);
+        break;
+    case DARO_CALL_DISABLE_FRAME_TRANSPORT: Daro_DisableFrameTransport(); break;
+    case DARO_CALL_IS_FRAME_TRANSPORT_ENABLED: Daro_IsFrameTransportEnabled(); break;
+    case DARO_CALL_ENABLE_PREVIEW_OUTPUT:
+    {
+        bool hasName = args.Str(&text);
+        int divisor = (int)args.Int();
+        if (m_Options.outputs) Daro_EnablePreviewOutput(hasName ? text.c_str() : nullptr, divisor);
+        break;
+    }
+    case DARO_CALL_DISABLE_PREVIEW_OUTPUT: Daro_DisablePreviewOutput(); break;
+    case DARO_CALL_IS_PREVIEW_OUTPUT_ENABLED: Daro_IsPreviewOutputEnabled(); break;
+    case DARO_CALL_ENABLE_STATS_BLOCK:
+    {
+        bool hasName = args.Str(&text);
+        int intervalMs = (int)args.Int();
+        if (m_Options.outputs) Daro_EnableStatsBlock(hasName ? text.c_str() : nullptr, intervalMs);
+        break;
+    }
+    case DARO_CALL_DISABLE_STATS_BLOCK: Daro_DisableStatsBlock(); break;
+    case DARO_CALL_IS_STATS_BLOCK_ENABLED: Daro_IsStatsBlockEnabled(); break;
+    case DARO_CALL_LOAD_TEXTURE:
+    {
+        bool hasPath = args.Str(&text);
+        int recorded = (int)args.Int();
+        int id = Daro_LoadTexture(hasPath ? MapPath(text).c_str() : nullptr);
+        SetId(m_Textures, recorded, id);
+        break;
+    }
+    case DARO_CALL_UNLOAD_TEXTURE:
+    {
+        int recorded = (int)args.Int();
+        Daro_UnloadTexture(MapId(m_Textures, recorded));
+        EraseId(m_Textures, recorded);
+        break;
+    }
+    case DARO_CALL_GET_SPOUT_SENDER_COUNT: Daro_GetSpoutSenderCount(); break;
+    case DARO_CALL_GET_SPOUT_SENDER_NAME:
+    {
+        int index = (int)args.Int(), size = (int)args.Int();
+        std::vector<char> name(size > 0 ? (size_t)size : 1);
+        Daro_GetSpoutSenderName(index, name.data(), size);
+        break;
+    }
+    case DARO_CALL_CONNECT_SPOUT_RECEIVER:
+    {
+        bool hasName = args.Str(&text);
+        int recorded = (int)args.Int();
+        SetId(m_Receivers, recorded, Daro_ConnectSpoutReceiver(hasName ? text.c_str() : nullptr));
+        break;
+    }
+    case DARO_CALL_DISCONNECT_SPOUT_RECEIVER:
+    {
+        int recorded = (int)args.Int();
+        Daro_DisconnectSpoutReceiver(MapId(m_Receivers, recorded));
+        EraseId(m_Receivers, recorded);
+        break;
+    }
+    case DARO_CALL_GET_SPOUT_RECEIVER_STATS:
+    {
+        DaroSpoutReceiverStats receiver;
+        Daro_GetSpoutReceiverStats(MapId(m_Receivers, (int)args.Int()), &receiver);
+        break;
+    }
+    case DARO_CALL_GET_SPOUT_RECEIVER_METADATA:
+    {
+        DaroFrameMetadata metadata;
+        Daro_GetSpoutReceiverMetadata(MapId(m_Receivers, (int)args.Int()), &metadata);
+        break;
+    }
+    case DARO_CALL_GET_STRUCT_SIZE: Daro_GetStructSize(); break;
+    case DARO_CALL_GET_OFFSET_POS_X: Daro_GetOffsetPosX(); break;
+    case DARO_CALL_GET_OFFSET_SIZE_X: Daro_GetOffsetSizeX(); break;
+    case DARO_CALL_GET_OFFSET_OPACITY: Daro_GetOffsetOpacity(); break;
+    case DARO_CALL_GET_OFFSET_TEXT_CONTENT: Daro_GetOffsetTextContent(); break;
+    case DARO_CALL_SET_SHOW_BOUNDS: Daro_SetShowBounds(args.Bool()); break;
+    case DARO_CALL_SET_LAYER_COST_ENABLED: Daro_SetLayerCostEnabled(args.Bool()); break;
+    case DARO_CALL_GET_LAYER_COSTS:
+    {
+        static thread_local std::vector<DaroLayerCost> costs;
+        int count = (int)args.Int();
+        costs.resize(count > 0 ? (size_t)count : 0);
+        Daro_GetLayerCosts(costs.data(), count);
+        break;
+    }
+    case DARO_CALL_GET_LAYER_COST:
+    {
+        DaroLayerCost cost;
+        Daro_GetLayerCost((int)args.Int(), &cost);
+        break;
+    }
+    case DARO_CALL_GET_MEMORY_STATS:
+    {
+        DaroMemoryStats memory;
+        Daro_GetMemoryStats((int)args.Int(), &memory);
+        break;
+    }
+    case DARO_CALL_GET_MEMORY_ASSETS:
+    {
+        static thread_local std::vector<DaroMemoryAsset> assets;
+        int category = (int)args.Int(), count = (int)args.Int();
+        assets.resize(count > 0 ? (size_t)count : 0);
+        Daro_GetMemoryAssets(category, assets.data(), count);
+        break;
+    }
+    case DARO_CALL_SET_MEMORY_BUDGET:
+    {
+        int category = (int)args.Int();
+        Daro_SetMemoryBudget(category, args.Int());
+        break;
+    }
+    case DARO_CALL_IS_MEMORY_OVER_BUDGET: Daro_IsMemoryOverBudget((int)args.Int()); break;
+    case DARO_CALL_RESET_MEMORY_PEAKS: Daro_ResetMemoryPeaks(); break;
+    case DARO_CALL_IS_DEVICE_LOST: Daro_IsDeviceLost(); break;
+    case DARO_CALL_SET_VIRTUAL_CLOCK: Daro_SetVirtualClock(args.Bool()); break;
+    case DARO_CALL_IS_VIRTUAL_CLOCK: Daro_IsVirtualClock(); break;
+    case DARO_CALL_ADVANCE_CLOCK: Daro_AdvanceClock(args.Double()); break;
+    case DARO_CALL_ADVANCE_CLOCK_FRAMES: Daro_AdvanceClockFrames((int)args.Int()); break;
+    case DARO_CALL_GET_CLOCK_TIME: Daro_GetClockTime(); break;
+    case DARO_CALL_SET_FRAME_RATE:
+    {
+        int num = (int)args.Int();
+        int den = (int)args.Int();
+        Daro_SetFrameRate(num, den);
+        break;
+    }
+    case DARO_CALL_GET_FRAME_RATE:
+    {
+        int num = 0, den = 0;
+        Daro_GetFrameRate(&num, &den);
+        break;
+    }
+    case DARO_CALL_SET_DROP_FRAME_TIMECODE: Daro_SetDropFrameTimecode(args.Bool()); break;
+    case DARO_CALL_IS_DROP_FRAME_TIMECODE: Daro_IsDropFrameTimecode(); break;
+    case DARO_CALL_SET_EDGE_SMOOTHING: Daro_SetEdgeSmoothing(args.Float()); break;
+    case DARO_CALL_GET_EDGE_SMOOTHING: Daro_GetEdgeSmoothing(); break;
+    case DARO_CALL_LOAD_VIDEO:
+    {
+        bool hasPath = args.Str(&text);
+        int recorded = (int)args.Int();
+        int id = Daro_LoadVideo(hasPath ? MapPath(text).c_str() : nullptr);
+        SetId(m_Videos, recorded, id);
+        break;
+    }
+    case DARO_CALL_UNLOAD_VIDEO:
+    {
+        int recorded = (int)args.Int();
+        Daro_UnloadVideo(MapId(m_Videos, recorded));
+        EraseId(m_Videos, recorded);
+        break;
+    }
+    case DARO_CALL_PLAY_VIDEO: Daro_PlayVideo(MapId(m_Videos, (int)args.Int())); break;
+    case DARO_CALL_PAUSE_VIDEO: Daro_PauseVideo(MapId(m_Videos, (int)args.Int())); break;
+    case DARO_CALL_STOP_VIDEO: Daro_StopVideo(MapId(m_Videos, (int)args.Int())); break;
+    case DARO_CALL_SEEK_VIDEO:
+    {
+        int videoId = MapId(m_Videos, (int)args.Int());
+        Daro_SeekVideo(videoId, (int)args.Int());
+        break;
+    }
+    case DARO_CALL_SEEK_VIDEO_TIME:
+    {
+        int videoId = MapId(m_Videos, (int)args.Int());
+        Daro_SeekVideoTime(videoId, args.Double());
+        break;
+    }
+    case DARO_CALL_IS_VIDEO_PLAYING: Daro_IsVideoPlaying(MapId(m_Videos, (int)args.Int())); break;
+    case DARO_CALL_GET_VIDEO_FRAME: Daro_GetVideoFrame(MapId(m_Videos, (int)args.Int())); break;
+    case DARO_CALL_GET_VIDEO_TOTAL_FRAMES: Daro_GetVideoTotalFrames(MapId(m_Videos, (int)args.Int())); break;
+    case DARO_CALL_SET_VIDEO_LOOP:
+    {
+        int videoId = MapId(m_Videos, (int)args.Int());
+        Daro_SetVideoLoop(videoId, args.Bool());
+        break;
+    }
+    case DARO_CALL_SET_VIDEO_ALPHA:
+    {
+        int videoId = MapId(m_Videos, (int)args.Int());
+        Daro_SetVideoAlpha(videoId, args.Bool());
+        break;
+    }
+    default:
+        return;     // Call from a newer engine
+    }
+
+    double elapsed = NowMs() - start;
+    CallStats& call = stats.calls[event.call & 0xFF];
+    call.count++;
+    call.totalMs += elapsed;
+    call.maxMs = std::max(call.maxMs, elapsed);
+}
+
+// One replay thread per captured thread, fed in file order by the main thread
+class ReplayWorker
+{
+public:
+    ReplayWorker(Replayer& replayer, double startMs, double baseMs, double speed)
+        : m_Replayer(replayer), m_StartMs(startMs), m_BaseMs(baseMs), m_Speed(speed)
+    {
+        m_Thread = std::thread(&ReplayWorker::ThreadProc, this);
+    }
+
+    void Push(ReplayEvent&& event)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Queue.push_back(std::move(event));
+        }
+        m_Wake.notify_one();
+    }
+
+    void Finish()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Done = true;
+        }
+        m_Wake.notify_one();
+        m_Thread.join();
+    }
+
+    const ThreadStats& GetStats() const { return m_Stats; }
+
+    // Events queued on all workers; the feeder waits while this is at REPLAY_MAX_QUEUED
+    static inline std::atomic<int> s_Queued{ 0 };
+
+private:
+    void ThreadProc()
+    {
+        for (;;)
+        {
+            ReplayEvent event;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Wake.wait(lock, [this] { return m_Done || !m_Queue.empty(); });
+                if (m_Queue.empty()) return;
+                event = std::move(m_Queue.front());
+                m_Queue.pop_front();
+            }
+            s_Queued--;
+
+            // Sleep to within 2 ms of the recorded time, then spin
+            double due = m_StartMs + (event.dueMs - m_BaseMs) / m_Speed;
+            for (double now = NowMs(); now < due; now = NowMs())
+            {
+                if (due - now > 2.0) Sleep(1);
+                else YieldProcessor();
+            }
+            m_Stats.driftMs.push_back(std::max(0.0, NowMs() - due));
+            m_Replayer.Execute(event, m_Stats);
+        }
+    }
+
+    Replayer& m_Replayer;
+    double m_StartMs;
+    double m_BaseMs;
+    double m_Speed;
+    ThreadStats m_Stats;
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_Wake;
+    std::deque<ReplayEvent> m_Queue;
+    bool m_Done = false;
+};
+
+static const char* TimingKey(int metric)
+{
+    // Indexed by DARO_TIMING_*
+    static const char* const keys[] = { "frame_interval", "render", "output_latency" };
+    return keys[metric];
+}
+
+static void WriteEscaped(FILE* f, const std::string& text)
+{
+    fputc('"', f);
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\') { fputc('\\', f); fputc(c, f); }
+        else if ((unsigned char)c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+static void WritePercentiles(FILE* f, const Percentiles& p)
+{
+    fprintf(f, "{\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+        p.mean, p.p50, p.p95, p.p99, p.max);
+}
+
+struct ReplayResult
+{
+    uint64_t events = 0;
+    int threads = 0;
+    bool truncated = false;
+    double captureSeconds = 0.0;
+    double replaySeconds = 0.0;
+    ThreadStats merged;
+    std::vector<SessionStats> sessions;
+};
+
+static void WriteJson(FILE* f, const ReplayOptions& options, const ReplayResult& r)
+{
+    fprintf(f, "{\n  \"schema\": %d,\n  \"label\": ", REPLAY_SCHEMA);
+    WriteEscaped(f, options.label);
+    fprintf(f, ",\n  \"capture\": ");
+    WriteEscaped(f, options.capture);
+    fprintf(f, ",\n  \"mode\": \"%s\",\n  \"speed\": %.3f,\n  \"outputs\": %s,\n",
+        options.fast ? "fast" : "timed", options.fast ? 0.0 : options.speed, options.outputs ? "true" : "false");
+    fprintf(f, "  \"events\": %llu,\n  \"threads\": %d,\n  \"truncated\": %s,\n",
+        (unsigned long long)r.events, r.threads, r.truncated ? "true" : "false");
+    fprintf(f, "  \"captureSeconds\": %.3f,\n  \"replaySeconds\": %.3f,\n", r.captureSeconds, r.replaySeconds);
+    fprintf(f, "  \"frames\": %zu,\n  \"frameMs\": ", r.merged.frameMs.size());
+    WritePercentiles(f, Summarize(r.merged.frameMs));
+    fprintf(f, ",\n  \"intervalMs\": ");
+    WritePercentiles(f, Summarize(r.merged.intervalMs));
+    fprintf(f, ",\n  \"issueDriftMs\": ");
+    WritePercentiles(f, Summarize(r.merged.driftMs));
+
+    fprintf(f, ",\n  \"sessions\": [");
+    for (size_t i = 0; i < r.sessions.size(); i++)
+    {
+        const SessionStats& s = r.sessions[i];
+        fprintf(f, "%s\n    {\"droppedFrames\": %d, \"lateFrames\": %d", i > 0 ? "," : "", s.droppedFrames, s.lateFrames);
+        for (int metric = 0; metric < DARO_TIMING_METRIC_COUNT; metric++)
+        {
+            const DaroTimingSummary& t = s.timing[metric];
+            fprintf(f, ",\n     \"%s\": {\"count\": %lld, \"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"p999\": %.4f, \"max\": %.4f}",
+                TimingKey(metric), t.count, t.meanMs, t.p50Ms, t.p95Ms, t.p99Ms, t.p999Ms, t.maxMs);
+        }
+        fprintf(f, "}");
+    }
+
+    fprintf(f, "\n  ],\n  \"calls\": {");
+    bool first = true;
+    for (int call = 0; call < 256; call++)
+    {
+        const CallStats& c = r.merged.calls[call];
+        if (c.count == 0) continue;
+        fprintf(f, "%s\n    \"%s\": {\"count\": %llu, \"meanMs\": %.4f, \"maxMs\": %.4f}", first ? "" : ",",
+            DaroCaptureCallName(call), (unsigned long long)c.count, c.totalMs / c.count, c.maxMs);
+        first = false;
+    }
+    fprintf(f, "\n  }\n}\n");
+}
+
+static void Merge(ThreadStats& into, const ThreadStats& from)
+{
+    for (int call = 0; call < 256; call++)
+    {
+        into.calls[call].count += from.calls[call].count;
+        into.calls[call].totalMs += from.calls[call].totalMs;
+        into.calls[call].maxMs = std::max(into.calls[call].maxMs, from.calls[call].maxMs);
+    }
+    into.frameMs.insert(into.frameMs.end(), from.frameMs.begin(), from.frameMs.end());
+    into.intervalMs.insert(into.intervalMs.end(), from.intervalMs.begin(), from.intervalMs.end());
+    into.driftMs.insert(into.driftMs.end(), from.driftMs.begin(), from.driftMs.end());
+}
+
+static int Replay(const ReplayOptions& options)
+{
+    DaroCaptureReader reader;
+    if (!reader.Open(options.capture.c_str()))
+    {
+        fprintf(stderr, "Replay: %s is not a capture file\n", options.capture.c_str());
+        return 1;
+    }
+    if (reader.GetHeader().layerSize != sizeof(DaroLayer))
+    {
+        fprintf(stderr, "Replay: capture layer size %u does not match this engine (%zu)\n",
+            reader.GetHeader().layerSize, sizeof(DaroLayer));
+        return 1;
+    }
+
+    timeBeginPeriod(1);
+    Replayer replayer(options);
+    ReplayResult result;
+    ThreadStats mainStats;          // Preamble, and every call with --fast
+    std::map<int, std::unique_ptr<ReplayWorker>> workers;
+    double startMs = NowMs();
+    double baseMs = -1.0;
+
+    DaroCaptureEvent captured;
+    while (reader.Next(&captured))
+    {
+        ReplayEvent event;
+        event.call = captured.call;
+        event.thread = captured.thread;
+        event.dueMs = ToMs(captured.timestampNs);
+        event.args.assign(captured.args, captured.args + captured.argsSize);
+        if (captured.layer)
+            event.layer.assign(captured.layer, captured.layer + reader.GetHeader().layerSize);
+        result.events++;
+        result.captureSeconds = std::max(result.captureSeconds, event.dueMs / 1000.0);
+
+        // The preamble restores the captured engine state before the timeline starts
+        if (options.fast || event.thread == DARO_CAPTURE_THREAD_PREAMBLE)
+        {
+            replayer.Execute(event, mainStats);
+            continue;
+        }
+
+        if (baseMs < 0.0)
+        {
+            baseMs = event.dueMs;
+            startMs = NowMs();
+        }
+        auto& worker = workers[event.thread];
+        if (!worker)
+            worker = std::make_unique<ReplayWorker>(replayer, startMs, baseMs, options.speed);
+        while (ReplayWorker::s_Queued >= REPLAY_MAX_QUEUED)
+            Sleep(1);
+        ReplayWorker::s_Queued++;
+        worker->Push(std::move(event));
+    }
+    result.truncated = reader.IsTruncated();
+
+    for (auto& worker : workers)
+    {
+        worker.second->Finish();
+        Merge(result.merged, worker.second->GetStats());
+    }
+    Merge(result.merged, mainStats);
+    result.threads = options.fast ? 1 : (int)workers.size();
+    result.replaySeconds = (NowMs() - startMs) / 1000.0;
+
+    if (replayer.IsInitialized())
+    {
+        replayer.CollectSession();
+        if (!options.trace.empty() && !Daro_WriteTrace(options.trace.c_str(), DARO_TRACE_FORMAT_PERFETTO))
+            fprintf(stderr, "Replay: cannot write trace %s\n", options.trace.c_str());
+        Daro_Shutdown();
+    }
+    result.sessions = replayer.GetSessions();
+    timeEndPeriod(1);
+
+    if (result.truncated)
+        fprintf(stderr, "Replay: capture is truncated, replayed %llu calls\n", (unsigned long long)result.events);
+
+    FILE* f = stdout;
+    if (!options.out.empty() && (fopen_s(&f, options.out.c_str(), "w") != 0 || !f))
+    {
+        fprintf(stderr, "Replay: cannot write %s\n", options.out.c_str());
+        return 1;
+    }
+    WriteJson(f, options, result);
+    if (f != stdout) fclose(f);
+    return 0;
+}
+
+#endif // _WIN32
+
+// ============== Main ==============
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+        "Usage: Replay CAPTURE [options]\n"
+        "  --fast             Issue calls back to back on one thread instead of at the recorded times\n"
+        "  --speed X          Play the recorded timeline X times faster (default 1)\n"
+        "  --path-map A=B     Load files under prefix A from prefix B instead (repeatable)\n"
+        "  --no-outputs       Do not enable Spout output, frame transport or the stats block\n"
+        "  --trace FILE       Write a Perfetto timeline of the replay\n"
+        "  --label TEXT       Stored in the JSON, e.g. a release tag\n"
+        "  --out FILE         Write JSON to FILE instead of stdout\n"
+        "  --dump             Print every call instead of replaying\n"
+        "  --summary          Print call counts instead of replaying\n");
+}
+
+int main(int argc, char** argv)
+{
+    ReplayOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--fast") options.fast = true;
+        else if (arg == "--speed" && hasValue) options.speed = atof(argv[++i]);
+        else if (arg == "--path-map" && hasValue)
+        {
+            std::string mapping = argv[++i];
+            size_t split = mapping.find('=');
+            if (split == std::string::npos || split == 0)
+            {
+                PrintUsage();
+                return 2;
+            }
+            options.pathMap.emplace_back(mapping.substr(0, split), mapping.substr(split + 1));
+        }
+        else if (arg == "--no-outputs") options.outputs = false;
+        else if (arg == "--trace" && hasValue) options.trace = argv[++i];
+        else if (arg == "--label" && hasValue) options.label = argv[++i];
+        else if (arg == "--out" && hasValue) options.out = argv[++i];
+        else if (arg == "--dump") options.dump = true;
+        else if (arg == "--summary") options.summary = true;
+        else if (options.capture.empty() && arg[0] != '-') options.capture = arg;
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+    if (options.capture.empty() || options.speed <= 0.0)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    if (options.dump) return Dump(options);
+    if (options.summary) return Summary(options);
+#ifdef _WIN32
+    return Replay(options);
+#else
+    fprintf(stderr, "Replay: replaying needs the Windows engine; use --dump or --summary here\n");
+    return 2;
+#endif
+}
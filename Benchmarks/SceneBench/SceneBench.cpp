@@ -0,0 +1,618 @@
+// Benchmarks/SceneBench/SceneBench.cpp
+// Headless scene benchmark: renders synthetic, parameterized scenes through the public
+// engine API for a fixed number of frames and writes frame-time percentiles and
+// per-stage timings as JSON, so results can be compared release over release.
+//
+// The engine renders offscreen (no window or swap chain), so the runner needs no desktop
+// session. D3D11 picks the hardware adapter and falls back to WARP when there is none.
+//
+//   SceneBench.exe [--frames N] [--warmup N] [--count N] [--scene NAME] [--video FILE]
+//                  [--width W] [--height H] [--fps F] [--unpaced] [--label TEXT] [--out FILE]
+#define NOMINMAX
+#include "DaroEngine.h"
+#include <Windows.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define SCENEBENCH_SCHEMA 1
+
+struct BenchOptions
+{
+    int width = 1920;
+    int height = 1080;
+    double fps = 50.0;
+    int frames = 500;
+    int warmup = 50;
+    int count = 0;                  // 0 = each scene's default
+    bool paced = true;              // Wait for each frame slot like live output
+    std::string scene;              // Empty = whole suite
+    std::string video;
+    std::string label;
+    std::string out;
+};
+
+struct BenchAssets
+{
+    int textureId = 0;
+    int videoId = 0;
+    int width = 1920;
+    int height = 1080;
+};
+
+struct SceneDesc
+{
+    const char* name;
+    int defaultCount;
+    int maxCount;
+    bool needsVideo;
+    std::function<void(std::vector<DaroLayer>&, int count, const BenchAssets&)> build;
+};
+
+// ============== Layer helpers ==============
+
+static DaroLayer MakeLayer(int layerType, float x, float y, float w, float h, float r, float g, float b, float a = 1.0f)
+{
+    DaroLayer layer = {};
+    layer.active = 1;
+    layer.layerType = layerType;
+    layer.posX = x;
+    layer.posY = y;
+    layer.sizeX = w;
+    layer.sizeY = h;
+    layer.anchorX = 0.5f;
+    layer.anchorY = 0.5f;
+    layer.opacity = 1.0f;
+    layer.colorR = r;
+    layer.colorG = g;
+    layer.colorB = b;
+    layer.colorA = a;
+    layer.texW = 1.0f;
+    layer.texH = 1.0f;
+    layer.lineHeight = 1.0f;
+    wcsncpy_s(layer.fontFamily, L"Arial", _TRUNCATE);
+    layer.fontSize = 36.0f;
+    return layer;
+}
+
+static DaroLayer MakeText(float x, float y, float w, float h, const wchar_t* text, float fontSize, int alignment = DARO_ALIGN_LEFT)
+{
+    DaroLayer layer = MakeLayer(DARO_TYPE_TEXT, x, y, w, h, 1.0f, 1.0f, 1.0f);
+    wcsncpy_s(layer.textContent, text, _TRUNCATE);
+    layer.fontSize = fontSize;
+    layer.textAlignment = alignment;
+    return layer;
+}
+
+static DaroLayer MakeImage(float x, float y, float w, float h, int textureId)
+{
+    DaroLayer layer = MakeLayer(DARO_TYPE_IMAGE, x, y, w, h, 1.0f, 1.0f, 1.0f);
+    layer.sourceType = DARO_SOURCE_IMAGE;
+    layer.textureId = textureId;
+    return layer;
+}
+
+static DaroLayer MakeVideo(float x, float y, float w, float h, int videoId)
+{
+    DaroLayer layer = MakeLayer(DARO_TYPE_VIDEO, x, y, w, h, 1.0f, 1.0f, 1.0f);
+    layer.sourceType = DARO_SOURCE_VIDEO;
+    layer.textureId = videoId;
+    return layer;
+}
+
+static DaroLayer MakeMask(float x, float y, float w, float h, int maskedId)
+{
+    DaroLayer layer = MakeLayer(DARO_TYPE_MASK, x, y, w, h, 1.0f, 1.0f, 1.0f);
+    layer.maskMode = 0;
+    layer.maskedLayerCount = 1;
+    layer.maskedLayerIds[0] = maskedId;
+    return layer;
+}
+
+// Cell i of a grid of count cells covering the frame
+static void GridCell(int i, int count, const BenchAssets& assets, float* x, float* y, float* w, float* h)
+{
+    int columns = 1;
+    while (columns * columns < count) columns++;
+    int rows = (count + columns - 1) / columns;
+    float cellW = (float)assets.width / columns;
+    float cellH = (float)assets.height / (rows > 0 ? rows : 1);
+    *x = cellW * (i % columns + 0.5f);
+    *y = cellH * (i / columns + 0.5f);
+    *w = cellW * 0.9f;
+    *h = cellH * 0.9f;
+}
+
+static const wchar_t* const SHORT_TEXT = L"Breaking News";
+static const wchar_t* const MEDIUM_TEXT = L"Parliament approves the budget after a late-night session";
+static const wchar_t* const LONG_TEXT =
+    L"The committee met for the third time this week to review the proposal. Members raised concerns about "
+    L"the timeline, the cost estimates and the impact on regional services, and asked for an independent "
+    L"review before the final vote, which is now expected early next month after further consultation.";
+
+// ============== Scenes ==============
+
+static void BuildQuads(std::vector<DaroLayer>& layers, int count, const BenchAssets& assets)
+{
+    for (int i = 0; i < count; i++)
+    {
+        float x, y, w, h;
+        GridCell(i, count, assets, &x, &y, &w, &h);
+        layers.push_back(MakeLayer(DARO_TYPE_RECTANGLE, x, y, w, h, (i % 3) / 2.0f, (i % 5) / 4.0f, (i % 7) / 6.0f, 0.8f));
+    }
+}
+
+static void BuildImages(std::vector<DaroLayer>& layers, int count, const BenchAssets& assets)
+{
+    for (int i = 0; i < count; i++)
+    {
+        float x, y, w, h;
+        GridCell(i, count, assets, &x, &y, &w, &h);
+        layers.push_back(MakeImage(x, y, w, h, assets.textureId));
+    }
+}
+
+static void BuildText(std::vector<DaroLayer>& layers, int count, const BenchAssets& assets, const wchar_t* text, float fontSize)
+{
+    for (int i = 0; i < count; i++)
+    {
+        float x, y, w, h;
+        GridCell(i, count, assets, &x, &y, &w, &h);
+        layers.push_back(MakeText(x, y, w, h, text, fontSize));
+    }
+}
+
+static void BuildMasked(std::vector<DaroLayer>& layers, int count, const BenchAssets& assets)
+{
+    // One mask per content layer, alternating rectangles and text
+    for (int i = 0; i < count; i++)
+    {
+        float x, y, w, h;
+        GridCell(i, count, assets, &x, &y, &w, &h);
+        int contentId = (int)layers.size() + 2;     // Ids are assigned as index + 1
+        layers.push_back(MakeMask(x - w * 0.25f, y, w * 0.5f, h, contentId));
+        if (i % 2 == 0)
+            layers.push_back(MakeLayer(DARO_TYPE_RECTANGLE, x, y, w, h, 0.1f, 0.4f, 0.9f));
+        else
+            layers.push_back(MakeText(x, y, w, h, MEDIUM_TEXT, 28.0f));
+    }
+}
+
+static void BuildVideos(std::vector<DaroLayer>& layers, int count, const BenchAssets& assets)
+{
+    for (int i = 0; i < count; i++)
+    {
+        float x, y, w, h;
+        GridCell(i, count, assets, &x, &y, &w, &h);
+        layers.push_back(MakeVideo(x, y, w, h, assets.videoId));
+    }
+}
+
+static void AddLowerThird(std::vector<DaroLayer>& layers, const BenchAssets& assets, float baseY)
+{
+    float width = assets.width * 0.7f;
+    float left = assets.width * 0.1f;
+    layers.push_back(MakeLayer(DARO_TYPE_RECTANGLE, left + width * 0.5f, baseY, width, 110.0f, 0.05f, 0.1f, 0.3f, 0.9f));
+    layers.push_back(MakeLayer(DARO_TYPE_RECTANGLE, left + 4.0f, baseY, 8.0f, 110.0f, 0.9f, 0.6f, 0.0f));
+    layers.push_back(MakeImage(left + width - 60.0f, baseY, 90.0f, 90.0f, assets.textureId));
+    layers.push_back(MakeText(left + width * 0.45f, baseY - 22.0f, width * 0.8f, 50.0f, L"Jane Example", 40.0f));
+    layers.push_back(MakeText(left + width * 0.45f, baseY + 28.0f, width * 0.8f, 40.0f, L"Correspondent, Regional Affairs", 28.0f));
+
+    // Wipe mask over the text block, as the lower-third templates animate in
+    int firstText = (int)layers.size() - 1;    // Ids of the two text layers are firstText and firstText + 1
+    DaroLayer mask = MakeMask(left + width * 0.45f, baseY, width * 0.85f, 110.0f, firstText);
+    mask.maskedLayerCount = 2;
+    mask.maskedLayerIds[1] = firstText + 1;
+    layers.push_back(mask);
+}
+
+static void BuildLowerThirds(std::vector<DaroLayer>& layers, int count, const BenchAssets& assets)
+{
+    for (int i = 0; i < count; i++)
+        AddLowerThird(layers, assets, assets.height - 90.0f - i * 130.0f);
+}
+
+static void BuildFullScreen(std::vector<DaroLayer>& layers, int count, const BenchAssets& assets)
+{
+    float w = (float)assets.width;
+    float h = (float)assets.height;
+    if (assets.videoId > 0)
+        layers.push_back(MakeVideo(w * 0.5f, h * 0.5f, w, h, assets.videoId));
+    else
+        layers.push_back(MakeImage(w * 0.5f, h * 0.5f, w, h, assets.textureId));
+    layers.push_back(MakeLayer(DARO_TYPE_RECTANGLE, w * 0.5f, h * 0.5f, w * 0.8f, h * 0.7f, 0.0f, 0.0f, 0.0f, 0.6f));
+    layers.push_back(MakeText(w * 0.5f, h * 0.22f, w * 0.7f, 90.0f, L"Election Results", 72.0f, DARO_ALIGN_CENTER));
+
+    // count table rows: label, value bar, value text
+    for (int i = 0; i < count; i++)
+    {
+        float y = h * 0.32f + i * (h * 0.5f / (count > 0 ? count : 1));
+        layers.push_back(MakeText(w * 0.25f, y, w * 0.2f, 48.0f, L"Party Name", 34.0f));
+        layers.push_back(MakeLayer(DARO_TYPE_RECTANGLE, w * 0.5f, y, w * 0.25f * (1.0f + (i % 3) * 0.3f), 36.0f, 0.2f, 0.5f + (i % 2) * 0.3f, 0.9f));
+        layers.push_back(MakeText(w * 0.78f, y, w * 0.1f, 48.0f, L"42.7%", 34.0f, DARO_ALIGN_RIGHT));
+    }
+    layers.push_back(MakeLayer(DARO_TYPE_CIRCLE, w * 0.9f, h * 0.12f, 80.0f, 80.0f, 0.9f, 0.1f, 0.1f));
+}
+
+static void BuildMixed(std::vector<DaroLayer>& layers, int count, const BenchAssets& assets)
+{
+    BuildFullScreen(layers, count, assets);
+    AddLowerThird(layers, assets, assets.height - 90.0f);
+}
+
+static std::vector<SceneDesc> MakeSuite()
+{
+    using namespace std::placeholders;
+    return
+    {
+        { "quads",        64, 64, false, BuildQuads },
+        { "images",       64, 64, false, BuildImages },
+        { "text_short",   32, 64, false, std::bind(BuildText, _1, _2, _3, SHORT_TEXT, 48.0f) },
+        { "text_medium",  32, 64, false, std::bind(BuildText, _1, _2, _3, MEDIUM_TEXT, 32.0f) },
+        { "text_long",    16, 64, false, std::bind(BuildText, _1, _2, _3, LONG_TEXT, 20.0f) },
+        { "masked",       16, 32, false, BuildMasked },
+        { "video",         4, 64, true,  BuildVideos },
+        { "lower_third",   1, 10, false, BuildLowerThirds },
+        { "full_screen",   8, 20, false, BuildFullScreen },
+        { "mixed",         8, 18, false, BuildMixed },
+    };
+}
+
+// ============== Runner ==============
+
+struct Percentiles
+{
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+static Percentiles Summarize(std::vector<double> values)
+{
+    Percentiles result;
+    if (values.empty()) return result;
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    auto rank = [&](double p) { return values[(size_t)(p * (values.size() - 1) + 0.5)]; };
+    result.mean = sum / values.size();
+    result.p50 = rank(0.50);
+    result.p95 = rank(0.95);
+    result.p99 = rank(0.99);
+    result.max = values.back();
+    return result;
+}
+
+static const char* StageKey(int stage)
+{
+    // Indexed by DARO_STAGE_*
+    static const char* const keys[] =
+    {
+        "begin_lock_wait", "spout_receive", "video_decode", "render_lock_wait",
+        "layer_copy", "draw", "text", "gpu_wait", "readback",
+        "framebuffer_wait", "framebuffer_write", "transport",
+        "present_lock_wait", "present", "preview",
+    };
+    return stage < (int)(sizeof(keys) / sizeof(keys[0])) ? keys[stage] : nullptr;
+}
+
+struct SceneResult
+{
+    std::string name;
+    int count = 0;
+    int layers = 0;
+    int frames = 0;
+    bool skipped = false;
+    const char* skipReason = "";
+    Percentiles busy;
+    Percentiles interval;
+    Percentiles stages[DARO_STAGE_COUNT];
+};
+
+static double NowMs()
+{
+    static LARGE_INTEGER freq = [] { LARGE_INTEGER f; QueryPerformanceFrequency(&f); return f; }();
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart * 1000.0 / (double)freq.QuadPart;
+}
+
+static void RenderFrame()
+{
+    Daro_BeginFrame();
+    Daro_Render();
+    Daro_Present();
+    Daro_EndFrame();
+}
+
+static SceneResult RunScene(const SceneDesc& scene, const BenchOptions& options, const BenchAssets& assets)
+{
+    SceneResult result;
+    result.name = scene.name;
+    result.count = options.count > 0 ? std::min(options.count, scene.maxCount) : scene.defaultCount;
+
+    if (scene.needsVideo && assets.videoId <= 0)
+    {
+        result.skipped = true;
+        result.skipReason = "no --video file";
+        return result;
+    }
+
+    std::vector<DaroLayer> layers;
+    scene.build(layers, result.count, assets);
+    if ((int)layers.size() > DARO_MAX_LAYERS) layers.resize(DARO_MAX_LAYERS);
+    result.layers = (int)layers.size();
+
+    Daro_ClearLayers();
+    for (int i = 0; i < (int)layers.size(); i++)
+    {
+        layers[i].id = i + 1;
+        Daro_UpdateLayer(i, &layers[i]);
+    }
+    Daro_SetLayerCount((int)layers.size());
+
+    double period = 1000.0 / options.fps;
+    double next = NowMs();
+    auto pace = [&]()
+    {
+        if (!options.paced) return;
+        next += period;
+        double wait = next - NowMs();
+        if (wait > 1.0) Sleep((DWORD)(wait - 1.0));
+        while (NowMs() < next) {}
+    };
+
+    for (int i = 0; i < options.warmup; i++)
+    {
+        RenderFrame();
+        pace();
+    }
+
+    std::vector<double> busy, interval, stages[DARO_STAGE_COUNT];
+    busy.reserve(options.frames);
+    interval.reserve(options.frames);
+    for (int i = 0; i < options.frames; i++)
+    {
+        RenderFrame();
+
+        DaroFrameStats record = {};
+        if (Daro_GetFrameStats(&record, 1) == 1)
+        {
+            busy.push_back(record.busyMs);
+            interval.push_back(record.frameIntervalMs);
+            for (int s = 0; s < DARO_STAGE_COUNT; s++)
+                stages[s].push_back(record.stageMs[s]);
+        }
+        pace();
+    }
+
+    result.frames = (int)busy.size();
+    result.busy = Summarize(busy);
+    result.interval = Summarize(interval);
+    for (int s = 0; s < DARO_STAGE_COUNT; s++)
+        result.stages[s] = Summarize(stages[s]);
+    return result;
+}
+
+// ============== Assets ==============
+
+// Synthetic 256x256 gradient written as a 24-bit BMP, loaded through the normal WIC path
+static std::string WriteTestImage()
+{
+    char dir[MAX_PATH] = {};
+    GetTempPathA(MAX_PATH, dir);
+    std::string path = std::string(dir) + "DaroSceneBench.bmp";
+
+    const int size = 256;
+    const int rowBytes = size * 3;          // Already a multiple of 4
+    BITMAPFILEHEADER file = {};
+    BITMAPINFOHEADER info = {};
+    file.bfType = 0x4D42;
+    file.bfOffBits = sizeof(file) + sizeof(info);
+    file.bfSize = file.bfOffBits + rowBytes * size;
+    info.biSize = sizeof(info);
+    info.biWidth = size;
+    info.biHeight = size;
+    info.biPlanes = 1;
+    info.biBitCount = 24;
+    info.biCompression = BI_RGB;
+
+    std::vector<unsigned char> pixels((size_t)rowBytes * size);
+    for (int y = 0; y < size; y++)
+        for (int x = 0; x < size; x++)
+        {
+            unsigned char* p = &pixels[(size_t)y * rowBytes + x * 3];
+            p[0] = (unsigned char)x;
+            p[1] = (unsigned char)y;
+            p[2] = (unsigned char)((x ^ y) & 0xFF);
+        }
+
+    FILE* f = nullptr;
+    if (fopen_s(&f, path.c_str(), "wb") != 0 || !f) return std::string();
+    fwrite(&file, sizeof(file), 1, f);
+    fwrite(&info, sizeof(info), 1, f);
+    fwrite(pixels.data(), 1, pixels.size(), f);
+    fclose(f);
+    return path;
+}
+
+// ============== JSON ==============
+
+static void WriteEscaped(FILE* f, const std::string& text)
+{
+    fputc('"', f);
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\') { fputc('\\', f); fputc(c, f); }
+        else if ((unsigned char)c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+static void WritePercentiles(FILE* f, const Percentiles& p)
+{
+    fprintf(f, "{\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+        p.mean, p.p50, p.p95, p.p99, p.max);
+}
+
+static void WriteJson(FILE* f, const BenchOptions& options, const std::vector<SceneResult>& results)
+{
+    fprintf(f, "{\n  \"schema\": %d,\n  \"label\": ", SCENEBENCH_SCHEMA);
+    WriteEscaped(f, options.label);
+    fprintf(f, ",\n  \"backend\": \"d3d11\",\n  \"width\": %d,\n  \"height\": %d,\n  \"fps\": %.3f,\n",
+        options.width, options.height, options.fps);
+    fprintf(f, "  \"paced\": %s,\n  \"warmupFrames\": %d,\n  \"frames\": %d,\n  \"scenes\": [",
+        options.paced ? "true" : "false", options.warmup, options.frames);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const SceneResult& r = results[i];
+        fprintf(f, "%s\n    {\"name\": ", i > 0 ? "," : "");
+        WriteEscaped(f, r.name);
+        if (r.skipped)
+        {
+            fprintf(f, ", \"skipped\": ");
+            WriteEscaped(f, r.skipReason);
+            fprintf(f, "}");
+            continue;
+        }
+        fprintf(f, ", \"count\": %d, \"layers\": %d, \"frames\": %d,\n     \"frameMs\": ", r.count, r.layers, r.frames);
+        WritePercentiles(f, r.busy);
+        fprintf(f, ",\n     \"intervalMs\": ");
+        WritePercentiles(f, r.interval);
+        fprintf(f, ",\n     \"stagesMs\": {");
+        bool first = true;
+        for (int s = 0; s < DARO_STAGE_COUNT; s++)
+        {
+            if (!StageKey(s)) continue;
+            fprintf(f, "%s\n       \"%s\": ", first ? "" : ",", StageKey(s));
+            WritePercentiles(f, r.stages[s]);
+            first = false;
+        }
+        fprintf(f, "}}");
+    }
+    fprintf(f, "\n  ]\n}\n");
+}
+
+// ============== Main ==============
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+        "Usage: SceneBench [options]\n"
+        "  --frames N     Measured frames per scene (default 500)\n"
+        "  --warmup N     Unmeasured frames before each scene (default 50)\n"
+        "  --count N      Elements per scene, clamped to the scene maximum (default per scene)\n"
+        "  --scene NAME   Run one scene instead of the suite\n"
+        "  --video FILE   Video for the video and full-screen scenes (video scene is skipped without it)\n"
+        "  --width W --height H --fps F   Output format (default 1920x1080 @ 50)\n"
+        "  --unpaced      Render back to back instead of waiting for each frame slot\n"
+        "  --label TEXT   Stored in the JSON, e.g. a release tag\n"
+        "  --out FILE     Write JSON to FILE instead of stdout\n"
+        "  --list         List scenes\n");
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    std::vector<SceneDesc> suite = MakeSuite();
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) options.frames = atoi(argv[++i]);
+        else if (arg == "--warmup" && hasValue) options.warmup = atoi(argv[++i]);
+        else if (arg == "--count" && hasValue) options.count = atoi(argv[++i]);
+        else if (arg == "--scene" && hasValue) options.scene = argv[++i];
+        else if (arg == "--video" && hasValue) options.video = argv[++i];
+        else if (arg == "--width" && hasValue) options.width = atoi(argv[++i]);
+        else if (arg == "--height" && hasValue) options.height = atoi(argv[++i]);
+        else if (arg == "--fps" && hasValue) options.fps = atof(argv[++i]);
+        else if (arg == "--label" && hasValue) options.label = argv[++i];
+        else if (arg == "--out" && hasValue) options.out = argv[++i];
+        else if (arg == "--unpaced") options.paced = false;
+        else if (arg == "--list")
+        {
+            for (const SceneDesc& scene : suite)
+                printf("%-12s count %d (max %d)%s\n", scene.name, scene.defaultCount, scene.maxCount, scene.needsVideo ? ", needs --video" : "");
+            return 0;
+        }
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+    if (options.frames <= 0 || options.warmup < 0 || options.width <= 0 || options.height <= 0 || options.fps <= 0.0)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    int result = Daro_Initialize(options.width, options.height, options.fps);
+    if (result != DARO_OK)
+    {
+        fprintf(stderr, "SceneBench: Daro_Initialize failed (%d)\n", result);
+        return 1;
+    }
+
+    BenchAssets assets;
+    assets.width = options.width;
+    assets.height = options.height;
+    std::string imagePath = WriteTestImage();
+    if (!imagePath.empty())
+        assets.textureId = Daro_LoadTexture(imagePath.c_str());
+    if (assets.textureId <= 0)
+        fprintf(stderr, "SceneBench: test image could not be loaded, image layers render untextured\n");
+    if (!options.video.empty())
+    {
+        assets.videoId = Daro_LoadVideo(options.video.c_str());
+        if (assets.videoId > 0)
+        {
+            Daro_SetVideoLoop(assets.videoId, true);
+            Daro_PlayVideo(assets.videoId);
+        }
+        else
+        {
+            fprintf(stderr, "SceneBench: could not load video %s\n", options.video.c_str());
+        }
+    }
+
+    std::vector<SceneResult> results;
+    for (const SceneDesc& scene : suite)
+    {
+        if (!options.scene.empty() && options.scene != scene.name) continue;
+        fprintf(stderr, "SceneBench: %s...\n", scene.name);
+        results.push_back(RunScene(scene, options, assets));
+    }
+    if (results.empty())
+    {
+        fprintf(stderr, "SceneBench: unknown scene '%s' (see --list)\n", options.scene.c_str());
+        Daro_Shutdown();
+        return 2;
+    }
+
+    Daro_ClearLayers();
+    if (assets.videoId > 0) Daro_UnloadVideo(assets.videoId);
+    if (assets.textureId > 0) Daro_UnloadTexture(assets.textureId);
+    Daro_Shutdown();
+    if (!imagePath.empty()) DeleteFileA(imagePath.c_str());
+
+    FILE* f = stdout;
+    if (!options.out.empty() && (fopen_s(&f, options.out.c_str(), "w") != 0 || !f))
+    {
+        fprintf(stderr, "SceneBench: cannot write %s\n", options.out.c_str());
+        return 1;
+    }
+    WriteJson(f, options, results);
+    if (f != stdout) fclose(f);
+    return 0;
+}
@@ -0,0 +1,43 @@
+// Benchmarks/Tests/DaroTest.h
+// Minimal check macros shared by the portable tests. A failed check prints its
+// location and marks the test failed; the test keeps running so one run reports
+// every broken expectation.
+#pragma once
+
+#include <cstdio>
+
+inline int& DaroTestFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(expr) \
+    do { \
+        if (!(expr)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            DaroTestFailures()++; \
+        } \
+    } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { \
+        long long _a = (long long)(a), _b = (long long)(b); \
+        if (_a != _b) { \
+            std::fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", \
+                         __FILE__, __LINE__, #a, #b, _a, _b); \
+            DaroTestFailures()++; \
+        } \
+    } while (0)
+
+// Return value for main()
+inline int DaroTestResult(const char* name)
+{
+    if (DaroTestFailures() == 0)
+    {
+        std::printf("%s: passed\n", name);
+        return 0;
+    }
+    std::printf("%s: %d check(s) failed\n", name, DaroTestFailures());
+    return 1;
+}
@@ -0,0 +1,377 @@
+// Benchmarks/Tests/FuzzCommandBuffer.cpp
+// Fuzz target for DaroParseCommandBuffer, the parser Daro_Submit runs on host buffers.
+// Whatever the input, parsing must stay inside the buffer, a rejected buffer must yield
+// no commands, every record must decode the same parsed on its own from an exact-size
+// buffer (so reading past a short payload is a sanitizer error, not a read into the next
+// record), and an accepted buffer must re-encode through DaroCommandBufferWriter::Add
+// into a buffer that parses to the same commands.
+//
+// Built with -fsanitize=fuzzer (clang) this is a libFuzzer target. Otherwise the
+// standalone driver below runs it on writer-built seeds and deterministic mutations of
+// them, plus any files named on the command line (e.g. crashes from a libFuzzer run):
+//   FuzzCommandBuffer [iterations] [file...]
+#include "DaroTest.h"
+#include "CommandBuffer.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Read every byte a decoded command points at, so a sanitizer sees any overrun
+static uint32_t Touch(const DaroSubmitCommand& command)
+{
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < command.payloadSize; i++) sum += command.payload[i];
+    if (command.text) sum += (uint32_t)strlen(command.text);
+    if (command.text2) sum += (uint32_t)strlen(command.text2);
+    if (command.layer)
+    {
+        DaroLayer layer;
+        memcpy(&layer, command.layer, sizeof(layer));
+        sum += (uint32_t)layer.textureId;
+    }
+    if (command.transition)
+    {
+        DaroTransition transition;
+        memcpy(&transition, command.transition, sizeof(transition));
+        sum += (uint32_t)transition.type;
+    }
+    return sum;
+}
+
+static bool SameCommand(const DaroSubmitCommand& a, const DaroSubmitCommand& b)
+{
+    if (a.op != b.op || a.status != b.status) return false;
+    if (a.status != DARO_SUBMIT_OK)
+        return a.payloadSize == b.payloadSize && memcmp(a.payload, b.payload, a.payloadSize) == 0;
+    if (a.id != b.id || a.value != b.value || memcmp(&a.seconds, &b.seconds, sizeof(double)) != 0) return false;
+    if (!a.text != !b.text || (a.text && strcmp(a.text, b.text) != 0)) return false;
+    if (!a.text2 != !b.text2 || (a.text2 && strcmp(a.text2, b.text2) != 0)) return false;
+    if (!a.layer != !b.layer || (a.layer && memcmp(a.layer, b.layer, sizeof(DaroLayer)) != 0)) return false;
+    if (!a.transition != !b.transition ||
+        (a.transition && memcmp(a.transition, b.transition, sizeof(DaroTransition)) != 0)) return false;
+    return true;
+}
+
+// The record alone, in a buffer that ends where its payload does
+static void CheckAlone(const DaroSubmitHeader& header, const DaroSubmitCommand& command)
+{
+    DaroSubmitHeader single = header;
+    single.headerSize = (unsigned short)sizeof(single);
+    single.commandCount = 1;
+    DaroSubmitRecord record = {};
+    record.op = (unsigned short)command.op;
+    record.size = (unsigned int)(sizeof(record) + command.payloadSize);
+    std::vector<uint8_t> bytes(sizeof(single) + record.size);
+    memcpy(bytes.data(), &single, sizeof(single));
+    memcpy(bytes.data() + sizeof(single), &record, sizeof(record));
+    if (command.payloadSize)
+        memcpy(bytes.data() + sizeof(single) + sizeof(record), command.payload, command.payloadSize);
+
+    DaroSubmitHeader parsedHeader = {};
+    std::vector<DaroSubmitCommand> alone;
+    CHECK(DaroParseCommandBuffer(bytes.data(), bytes.size(), &parsedHeader, &alone));
+    CHECK_EQ(alone.size(), 1);
+    if (alone.size() == 1) CHECK(SameCommand(command, alone[0]));
+}
+
+static void Check(const uint8_t* data, size_t size)
+{
+    DaroSubmitHeader header = {};
+    std::vector<DaroSubmitCommand> commands;
+    if (!DaroParseCommandBuffer(data, size, &header, &commands))
+    {
+        CHECK(commands.empty());
+        return;
+    }
+
+    CHECK_EQ(commands.size(), header.commandCount);
+    CHECK(header.headerSize >= sizeof(DaroSubmitHeader) && header.headerSize <= size);
+    volatile uint32_t sink = 0;
+    for (const DaroSubmitCommand& command : commands)
+    {
+        CHECK(command.payload >= data + header.headerSize);
+        CHECK(command.payload + command.payloadSize <= data + size);
+        CHECK(command.status == DARO_SUBMIT_OK || command.status == DARO_SUBMIT_ERROR_UNKNOWN_OP ||
+              command.status == DARO_SUBMIT_ERROR_MALFORMED);
+        sink = sink + Touch(command);
+        CheckAlone(header, command);
+    }
+
+    DaroCommandBufferWriter writer;
+    writer.Reset(header.flags, header.when, header.at);
+    for (const DaroSubmitCommand& command : commands) writer.Add(command);
+
+    DaroSubmitHeader again = {};
+    std::vector<DaroSubmitCommand> reparsed;
+    CHECK(DaroParseCommandBuffer(writer.Data(), writer.Size(), &again, &reparsed));
+    CHECK_EQ(reparsed.size(), commands.size());
+    CHECK_EQ(again.flags, header.flags);
+    CHECK_EQ(again.when, header.when);
+    CHECK_EQ(again.at, header.at);
+    if (reparsed.size() != commands.size()) return;
+    for (size_t i = 0; i < commands.size(); i++)
+        CHECK(SameCommand(commands[i], reparsed[i]));
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    Check(data, size);
+    // Failed checks are printed by CHECK; stop so libFuzzer keeps the input
+    if (DaroTestFailures() > 0) abort();
+    return 0;
+}
+
+#ifndef DARO_LIBFUZZER
+
+#include <cstdio>
+#include <string>
+
+static std::vector<std::vector<uint8_t>> Seeds()
+{
+    std::vector<std::vector<uint8_t>> seeds;
+    auto keep = [&seeds](const DaroCommandBufferWriter& w) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(w.Data());
+        seeds.emplace_back(bytes, bytes + w.Size());
+    };
+
+    DaroCommandBufferWriter w;
+    keep(w);                        // Header only
+
+    DaroLayer layer = {};
+    layer.id = 7;
+    layer.opacity = 0.5f;
+    layer.textureId = DARO_SUBMIT_REF(0);
+    DaroTransition transition = {};
+    transition.durationFrames = 25;
+
+    // Every op once
+    w.Reset();
+    int texture = w.LoadTexture("C:\\graphics\\logo.png");
+    int video = w.LoadVideo("clip.mp4");
+    w.SetLayerCount(3);
+    w.UpdateLayer(0, &layer);
+    w.ClearLayers();
+    w.UnloadTexture(DARO_SUBMIT_REF(texture));
+    w.PlayVideo(DARO_SUBMIT_REF(video));
+    w.PauseVideo(2);
+    w.StopVideo(2);
+    w.SeekVideo(2, 120);
+    w.SeekVideoTime(2, 1.5);
+    w.SetVideoLoop(2, true);
+    w.SetVideoAlpha(2, false);
+    w.UnloadVideo(2);
+    w.SetOutputMetadata("Lower third", "Speaker");
+    w.EditScene(1);
+    w.Play();
+    w.Stop();
+    w.SeekToFrame(50);
+    w.TakeScene(1);
+    w.TransitionScene(0, &transition);
+    w.ContinueTimeline();
+    keep(w);
+
+    // Queued for a timecode
+    w.Reset(DARO_SUBMIT_QUEUED, DARO_WHEN_TIMECODE, 0x01020304);
+    w.SetLayerCount(1);
+    w.UpdateLayer(0, &layer);
+    keep(w);
+
+    // A batch of layer updates, as a take sends them
+    w.Reset(DARO_SUBMIT_QUEUED, DARO_WHEN_NEXT_FRAME, 0);
+    for (int i = 0; i < 16; i++)
+    {
+        layer.id = i;
+        w.UpdateLayer(i, &layer);
+    }
+    keep(w);
+
+    // Unknown op and an empty path kept through Add
+    w.Reset();
+    DaroSubmitCommand unknown = {};
+    uint8_t payload[6] = { 1, 2, 3, 4, 5, 6 };
+    unknown.op = 999;
+    unknown.status = DARO_SUBMIT_ERROR_UNKNOWN_OP;
+    unknown.payload = payload;
+    unknown.payloadSize = sizeof(payload);
+    w.Add(unknown);
+    w.LoadTexture("");
+    keep(w);
+    return seeds;
+}
+
+// Deterministic mutations, so a failure reproduces from the iteration number
+struct Mutator
+{
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    uint64_t Next()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    size_t Below(size_t n) { return n ? (size_t)(Next() % n) : 0; }
+
+    // Grow or shrink one record's payload and fix its size, so the buffer still frames
+    // and the short payload reaches the op decoders
+    void ResizeRecord(std::vector<uint8_t>& data)
+    {
+        DaroSubmitHeader header;
+        if (data.size() < sizeof(header)) return;
+        memcpy(&header, data.data(), sizeof(header));
+        std::vector<size_t> records;
+        size_t offset = header.headerSize;
+        while (offset + sizeof(DaroSubmitRecord) <= data.size() && records.size() < 1024)
+        {
+            DaroSubmitRecord record;
+            memcpy(&record, &data[offset], sizeof(record));
+            if (record.size < sizeof(record) || record.size > data.size() - offset) break;
+            records.push_back(offset);
+            offset += record.size;
+        }
+        if (records.empty()) return;
+
+        size_t at = records[Below(records.size())];
+        DaroSubmitRecord record;
+        memcpy(&record, &data[at], sizeof(record));
+        size_t payload = record.size - sizeof(record);
+        size_t end = at + record.size;
+        if (Below(2) == 0 && payload > 0)
+        {
+            size_t count = 1 + Below((std::min)((size_t)16, payload));
+            data.erase(data.begin() + (ptrdiff_t)(end - count), data.begin() + (ptrdiff_t)end);
+            record.size -= (unsigned int)count;
+        }
+        else
+        {
+            size_t count = 1 + Below(16);
+            data.insert(data.begin() + (ptrdiff_t)end, count, (uint8_t)Next());
+            record.size += (unsigned int)count;
+        }
+        memcpy(&data[at], &record, sizeof(record));
+    }
+
+    void Mutate(std::vector<uint8_t>& data, const std::vector<std::vector<uint8_t>>& seeds)
+    {
+        static const int32_t interesting[] = { 0, 1, -1, 4, 16, 24, 255, 256, 65535, 65536,
+                                               0x7FFFFFFF, (int32_t)0x80000000, DARO_SUBMIT_MAX_COMMANDS + 1 };
+        int steps = 1 + (int)Below(8);
+        for (int s = 0; s < steps; s++)
+        {
+            switch (Below(10))
+            {
+            case 8:
+            case 9:
+                ResizeRecord(data);
+                break;
+            case 0:     // Flip a bit
+                if (!data.empty()) data[Below(data.size())] ^= (uint8_t)(1u << Below(8));
+                break;
+            case 1:     // Random byte
+                if (!data.empty()) data[Below(data.size())] = (uint8_t)Next();
+                break;
+            case 2:     // Interesting 32-bit value, often a count or size field
+            {
+                if (data.size() < 4) break;
+                int32_t value = interesting[Below(sizeof(interesting) / sizeof(interesting[0]))];
+                if (Below(4) == 0) value = (int32_t)data.size() + (int32_t)Below(9) - 4;
+                memcpy(&data[Below(data.size() - 3)], &value, sizeof(value));
+                break;
+            }
+            case 3:     // Truncate
+                data.resize(Below(data.size() + 1));
+                break;
+            case 4:     // Insert bytes
+            {
+                size_t at = Below(data.size() + 1);
+                size_t count = 1 + Below(16);
+                std::vector<uint8_t> bytes(count);
+                for (uint8_t& b : bytes) b = (uint8_t)Next();
+                data.insert(data.begin() + (ptrdiff_t)at, bytes.begin(), bytes.end());
+                break;
+            }
+            case 5:     // Erase a range
+            {
+                if (data.empty()) break;
+                size_t at = Below(data.size());
+                size_t count = 1 + Below((std::min)((size_t)64, data.size() - at));
+                data.erase(data.begin() + (ptrdiff_t)at, data.begin() + (ptrdiff_t)(at + count));
+                break;
+            }
+            case 6:     // Duplicate a chunk in place
+            {
+                if (data.empty()) break;
+                size_t at = Below(data.size());
+                size_t count = 1 + Below((std::min)((size_t)256, data.size() - at));
+                std::vector<uint8_t> chunk(data.begin() + (ptrdiff_t)at, data.begin() + (ptrdiff_t)(at + count));
+                data.insert(data.begin() + (ptrdiff_t)Below(data.size() + 1), chunk.begin(), chunk.end());
+                break;
+            }
+            default:    // Splice the tail of another seed
+            {
+                const std::vector<uint8_t>& other = seeds[Below(seeds.size())];
+                size_t cut = Below(data.size() + 1), from = Below(other.size() + 1);
+                data.resize(cut);
+                data.insert(data.end(), other.begin() + (ptrdiff_t)from, other.end());
+                break;
+            }
+            }
+        }
+    }
+};
+
+static bool ReadFile(const char* path, std::vector<uint8_t>* data)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) data->insert(data->end(), buffer, buffer + n);
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    long long iterations = argc > 1 ? atoll(argv[1]) : 50000;
+    for (int i = 2; i < argc; i++)
+    {
+        std::vector<uint8_t> data;
+        CHECK(ReadFile(argv[i], &data));
+        Check(data.data(), data.size());
+    }
+
+    std::vector<std::vector<uint8_t>> seeds = Seeds();
+    long long accepted = 0;
+    for (const std::vector<uint8_t>& seed : seeds)
+    {
+        DaroSubmitHeader header;
+        std::vector<DaroSubmitCommand> commands;
+        CHECK(DaroParseCommandBuffer(seed.data(), seed.size(), &header, &commands));
+        Check(seed.data(), seed.size());
+    }
+
+    Mutator mutator;
+    for (long long i = 0; i < iterations && DaroTestFailures() == 0; i++)
+    {
+        std::vector<uint8_t> data = seeds[mutator.Below(seeds.size())];
+        mutator.Mutate(data, seeds);
+        // Exact-size copy, so reading one byte past the end is a sanitizer error
+        std::vector<uint8_t> exact(data);
+        DaroSubmitHeader header;
+        std::vector<DaroSubmitCommand> commands;
+        if (DaroParseCommandBuffer(exact.data(), exact.size(), &header, &commands)) accepted++;
+        Check(exact.data(), exact.size());
+        if (DaroTestFailures() > 0)
+            std::fprintf(stderr, "Failed at iteration %lld (%zu bytes)\n", i, exact.size());
+    }
+    std::printf("%lld iterations, %lld accepted\n", iterations, accepted);
+    // Mutations that never get past the framing checks would test nothing
+    CHECK(iterations < 1000 || accepted > iterations / 100);
+    return DaroTestResult("FuzzCommandBuffer");
+}
+
+#endif
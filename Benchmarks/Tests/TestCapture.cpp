@@ -0,0 +1,154 @@
+// Benchmarks/Tests/TestCapture.cpp
+// API capture: nothing is recorded between Start and Enable except the preamble
+// written on the starting thread, so the preamble always comes first in the file;
+// concurrent Stop calls join the writer once and only one of them reports the stop.
+// A layer call's result is recorded ahead of its layer runs and both decode.
+#include "DaroTest.h"
+#include "Capture.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A call from another thread, as a host polling the engine would make
+static void Poll()
+{
+    DaroCaptureCall capture(DARO_CALL_GET_FRAME_NUMBER);
+}
+
+static void TestPreambleFirst(const std::string& path)
+{
+    CHECK(DaroCapture::Start(path.c_str()));
+    CHECK(!DaroCapture::Start(path.c_str()));
+    CHECK(!DaroCapture::IsEnabled());
+
+    // A thread polling before the capture is enabled is not recorded
+    std::thread early(Poll);
+    early.join();
+
+    DaroCapture::SetPreamble(true);
+    {
+        DaroCaptureCall capture(DARO_CALL_INITIALIZE);
+        capture.Int(1920).Int(1080).Double(50.0);
+    }
+    {
+        DaroCaptureCall capture(DARO_CALL_SET_LAYER_COUNT);
+        capture.Int(3);
+    }
+    DaroCapture::SetPreamble(false);
+    DaroCapture::Enable();
+    CHECK(DaroCapture::IsEnabled());
+
+    std::vector<std::thread> pollers;
+    for (int t = 0; t < 4; t++)
+        pollers.emplace_back([] { for (int i = 0; i < 100; i++) Poll(); });
+    for (std::thread& t : pollers) t.join();
+
+    // Every thread stops at once; exactly one of them owns the stop
+    std::atomic<int> stopped{ 0 };
+    std::vector<std::thread> stoppers;
+    for (int t = 0; t < 4; t++)
+        stoppers.emplace_back([&] { if (DaroCapture::Stop()) stopped++; });
+    for (std::thread& t : stoppers) t.join();
+    CHECK_EQ(stopped.load(), 1);
+    CHECK(!DaroCapture::IsEnabled());
+    CHECK(!DaroCapture::Stop());
+
+    // Enabling after the stop must not resurrect a capture without a file
+    DaroCapture::Enable();
+    CHECK(!DaroCapture::IsEnabled());
+
+    uint64_t records = 0, bytes = 0;
+    DaroCapture::GetCounts(&records, &bytes);
+    CHECK_EQ(records, 2 + 4 * 100);
+
+    DaroCaptureReader reader;
+    CHECK(reader.Open(path.c_str()));
+    DaroCaptureEvent event;
+    std::vector<DaroCaptureEvent> events;
+    while (reader.Next(&event)) events.push_back(event);
+    CHECK(!reader.IsTruncated());
+    CHECK_EQ(events.size(), 2 + 4 * 100);
+    if (events.size() == 2 + 4 * 100)
+    {
+        CHECK_EQ(events[0].call, DARO_CALL_INITIALIZE);
+        CHECK_EQ(events[0].thread, DARO_CAPTURE_THREAD_PREAMBLE);
+        CHECK_EQ(events[1].call, DARO_CALL_SET_LAYER_COUNT);
+        CHECK_EQ(events[1].thread, DARO_CAPTURE_THREAD_PREAMBLE);
+        for (size_t i = 2; i < events.size(); i++)
+        {
+            CHECK_EQ(events[i].call, DARO_CALL_GET_FRAME_NUMBER);
+            CHECK(events[i].thread != DARO_CAPTURE_THREAD_PREAMBLE);
+        }
+    }
+    reader.Close();
+}
+
+static void TestRestart(const std::string& path)
+{
+    // A stopped capture can be started again
+    CHECK(DaroCapture::Start(path.c_str()));
+    DaroCapture::Enable();
+    Poll();
+    CHECK(DaroCapture::Stop());
+
+    DaroCaptureReader reader;
+    CHECK(reader.Open(path.c_str()));
+    DaroCaptureEvent event;
+    int count = 0;
+    while (reader.Next(&event)) count++;
+    CHECK_EQ(count, 1);
+    reader.Close();
+}
+
+static void TestLayerResult(const std::string& path)
+{
+    CHECK(DaroCapture::Start(path.c_str()));
+    DaroCapture::Enable();
+    DaroLayer layer = {};
+    layer.posX = 12.0f;
+    for (long long id = 7; id <= 8; id++)
+    {
+        // As Daro_QueueLayerUpdate records it; the second update is a diff on the first
+        if (id == 8) layer.posY = 4.0f;
+        DaroCaptureCall capture(DARO_CALL_QUEUE_LAYER_UPDATE);
+        capture.Int(1).Int(-5).Int(3).Layer(3, &layer);
+        capture.Result(id);
+    }
+    CHECK(DaroCapture::Stop());
+
+    DaroCaptureReader reader;
+    CHECK(reader.Open(path.c_str()));
+    DaroCaptureEvent event;
+    for (long long id = 7; id <= 8; id++)
+    {
+        CHECK(reader.Next(&event));
+        CHECK_EQ(event.call, DARO_CALL_QUEUE_LAYER_UPDATE);
+        CHECK_EQ(event.layerIndex, 3);
+        DaroCaptureArgs args(event.args, event.argsSize);
+        CHECK_EQ(args.Int(), 1);
+        CHECK_EQ(args.Int(), -5);
+        CHECK_EQ(args.Int(), 3);
+        CHECK_EQ(args.Int(), id);
+        CHECK(args.IsValid());
+        DaroLayer read = {};
+        if (event.layer) memcpy(&read, event.layer, sizeof(read));
+        CHECK(read.posX == 12.0f);
+        CHECK(read.posY == (id == 7 ? 0.0f : 4.0f));
+    }
+    CHECK(!reader.Next(&event));
+    CHECK(!reader.IsTruncated());
+    reader.Close();
+}
+
+int main()
+{
+    std::string path = "TestCapture.dcap";
+    TestPreambleFirst(path);
+    TestRestart(path);
+    TestLayerResult(path);
+    std::remove(path.c_str());
+    return DaroTestResult("TestCapture");
+}
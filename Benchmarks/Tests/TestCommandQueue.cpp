@@ -0,0 +1,139 @@
+// Benchmarks/Tests/TestCommandQueue.cpp
+// Command queue: commands apply at their target frame in (frame, id) order, late ones
+// are counted, and DARO_WHEN_NEXT_FRAME resolves to the frame the next BeginFrame starts
+// whether it is queued during a frame or between EndFrame and the next BeginFrame.
+#include "DaroTest.h"
+#include "CommandQueue.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static uint64_t PushValue(DaroCommandQueue& queue, int64_t frame, int64_t value)
+{
+    DaroCommand* command = DaroCommandQueue::Allocate();
+    command->type = DARO_CMD_SET_LAYER_COUNT;
+    command->value = value;
+    DaroCommandChain chain;
+    chain.Append(command);
+    return queue.Push(chain, frame);
+}
+
+// One engine frame as Daro_BeginFrame/Daro_EndFrame drive the queue
+struct Frames
+{
+    DaroCommandQueue queue;
+    int64_t frameNumber = 0;
+    std::vector<std::pair<int64_t, int64_t>> applied;   // (frame, value)
+
+    void Begin()
+    {
+        queue.Run(frameNumber, [this](const DaroCommand& c) { applied.push_back({ frameNumber, c.value }); });
+    }
+    void End() { frameNumber++; }
+};
+
+static void TestNextFrame()
+{
+    Frames f;
+    // Before any frame the next one is frame 0
+    CHECK_EQ(f.queue.NextFrame(f.frameNumber), 0);
+    PushValue(f.queue, f.queue.NextFrame(f.frameNumber), 1);
+    f.Begin();
+
+    // Queued while frame 0 renders: frame 1
+    CHECK_EQ(f.queue.NextFrame(f.frameNumber), 1);
+    PushValue(f.queue, f.queue.NextFrame(f.frameNumber), 2);
+    f.End();
+
+    // Queued after frame 0 ended, before frame 1 begins: still frame 1, not 2
+    CHECK_EQ(f.queue.NextFrame(f.frameNumber), 1);
+    PushValue(f.queue, f.queue.NextFrame(f.frameNumber), 3);
+    f.Begin();
+    f.End();
+    f.Begin();
+    f.End();
+
+    CHECK_EQ(f.applied.size(), 3);
+    if (f.applied.size() == 3)
+    {
+        CHECK_EQ(f.applied[0].first, 0);
+        CHECK_EQ(f.applied[1].first, 1);
+        CHECK_EQ(f.applied[1].second, 2);
+        CHECK_EQ(f.applied[2].first, 1);
+        CHECK_EQ(f.applied[2].second, 3);
+    }
+    DaroCommandQueueStats stats = {};
+    f.queue.GetStats(&stats);
+    CHECK_EQ(stats.late, 0);
+}
+
+static void TestOrderAndLate()
+{
+    Frames f;
+    PushValue(f.queue, 5, 50);
+    PushValue(f.queue, 3, 30);
+    PushValue(f.queue, 3, 31);
+    PushValue(f.queue, -1, 0);      // Immediate: takes frame 3, after the earlier ids
+    f.frameNumber = 3;
+    f.Begin();
+    CHECK_EQ(f.applied.size(), 3);
+    if (f.applied.size() == 3)
+    {
+        CHECK_EQ(f.applied[0].second, 30);
+        CHECK_EQ(f.applied[1].second, 31);
+        CHECK_EQ(f.applied[2].second, 0);
+    }
+
+    // Frame 5 skipped: the command applies at 7, two frames late
+    f.frameNumber = 7;
+    f.Begin();
+    CHECK_EQ(f.applied.size(), 4);
+    DaroCommandQueueStats stats = {};
+    f.queue.GetStats(&stats);
+    CHECK_EQ(stats.late, 1);
+    CHECK_EQ(stats.maxLateFrames, 2);
+    CHECK_EQ(stats.pending, 0);
+}
+
+static void TestProducers()
+{
+    // Four producers racing one consumer: every command applied once, ids unique
+    Frames f;
+    std::atomic<bool> done{ false };
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; t++)
+    {
+        producers.emplace_back([&f, t] {
+            for (int i = 0; i < 5000; i++)
+                PushValue(f.queue, -1, t * 100000 + i);
+        });
+    }
+    std::thread consumer([&] {
+        while (!done.load()) { f.Begin(); f.End(); }
+        f.Begin();
+    });
+    for (std::thread& p : producers) p.join();
+    done = true;
+    consumer.join();
+
+    CHECK_EQ(f.applied.size(), 4 * 5000);
+    // Each producer's commands keep their order
+    std::vector<int64_t> last(4, -1);
+    int64_t outOfOrder = 0;
+    for (auto& entry : f.applied)
+    {
+        int t = (int)(entry.second / 100000);
+        int64_t i = entry.second % 100000;
+        if (i <= last[t]) outOfOrder++;
+        last[t] = i;
+    }
+    CHECK_EQ(outOfOrder, 0);
+}
+
+int main()
+{
+    TestNextFrame();
+    TestOrderAndLate();
+    TestProducers();
+    return DaroTestResult("TestCommandQueue");
+}
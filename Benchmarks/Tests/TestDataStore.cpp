@@ -0,0 +1,391 @@
+// Benchmarks/Tests/TestDataStore.cpp
+// Data store: writes between two frames coalesce into one field write per binding,
+// unchanged values are dropped, a replaced layer gets its bound fields back, numbers and
+// text convert to the bound field, a bound field wins over a timeline track, concurrent
+// producers lose nothing, and the shared-memory ingest region feeds the store, reading an
+// entry caught mid-write again on the next poll.
+#include "DaroTest.h"
+#include "DataStore.h"
+#include "Timeline.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+// One scene slot's layers, as the engine hands them to Apply
+struct Scene
+{
+    std::vector<DaroLayer> layers = std::vector<DaroLayer>(DARO_MAX_LAYERS);
+    DaroLayer* slots[DARO_SCENE_SLOTS] = {};
+
+    Scene() { slots[0] = layers.data(); }
+    int Apply(DaroDataStore& store) { return store.Apply(slots); }
+};
+
+static DaroDataStoreStats Stats(const DaroDataStore& store)
+{
+    DaroDataStoreStats stats;
+    store.GetStats(&stats);
+    return stats;
+}
+
+static void SetNumber(DaroDataStore& store, int key, double value) { store.SetNumbers(&key, &value, 1); }
+static void SetText(DaroDataStore& store, int key, const wchar_t* text) { store.SetTexts(&key, &text, 1); }
+
+static void TestCoalescing()
+{
+    DaroDataStore store;
+    Scene scene;
+    int score = store.Key("score");
+    int title = store.Key("title");
+    CHECK(score >= 0 && title >= 0);
+    CHECK_EQ(store.Key("score"), score);
+    CHECK_EQ(store.Key(""), -1);
+    CHECK(store.Bind(0, 0, DARO_FIELD_POS_X, score));
+    CHECK(store.Bind(0, 1, DARO_FIELD_POS_X, score));
+    CHECK(store.Bind(0, 1, DARO_FIELD_TEXT, title));
+    CHECK(!store.Bind(0, DARO_MAX_LAYERS, DARO_FIELD_POS_X, score));
+    CHECK(!store.Bind(0, 0, DARO_FIELD_COUNT, score));
+
+    // Bound keys without a value write nothing
+    CHECK_EQ(scene.Apply(store), 0);
+    DaroDataStoreStats stats = Stats(store);
+    CHECK_EQ(stats.applies, 0);
+    CHECK_EQ(stats.bindingCount, 3);
+    CHECK_EQ(stats.keyCount, 2);
+    long long coalescedByBinds = stats.coalesced;
+
+    // 100 score writes between two frames, one a repeat, plus one title
+    for (int i = 1; i <= 100; i++) SetNumber(store, score, i == 51 ? 50.0 : (double)i);
+    SetText(store, title, L"Home");
+
+    stats = Stats(store);
+    CHECK_EQ(stats.writes, 101);
+    CHECK_EQ(stats.unchanged, 1);
+    CHECK_EQ(stats.coalesced - coalescedByBinds, 98);
+    CHECK_EQ(stats.applies, 0);
+    CHECK(scene.layers[0].posX == 0.0f);
+
+    CHECK_EQ(scene.Apply(store), 2);
+    stats = Stats(store);
+    CHECK_EQ(stats.applies, 1);
+    CHECK_EQ(stats.fieldsApplied, 3);
+    CHECK_EQ(stats.layersDirtied, 2);
+    CHECK_EQ(stats.lastLayersDirtied, 2);
+    CHECK(scene.layers[0].posX == 100.0f);
+    CHECK(scene.layers[1].posX == 100.0f);
+    CHECK(wcscmp(scene.layers[1].textContent, L"Home") == 0);
+
+    // Nothing written since: nothing applied
+    CHECK_EQ(scene.Apply(store), 0);
+    CHECK_EQ(Stats(store).applies, 1);
+}
+
+static void TestUnchanged()
+{
+    DaroDataStore store;
+    Scene scene;
+    int key = store.Key("value");
+    store.Bind(0, 0, DARO_FIELD_POS_Y, key);
+    SetNumber(store, key, 7.0);
+    SetText(store, store.Key("name"), L"Same");
+    CHECK_EQ(scene.Apply(store), 1);
+
+    DaroDataStoreStats before = Stats(store);
+    SetNumber(store, key, 7.0);
+    SetText(store, store.Key("name"), L"Same");
+    DaroDataStoreStats after = Stats(store);
+    CHECK_EQ(after.writes - before.writes, 2);
+    CHECK_EQ(after.unchanged - before.unchanged, 2);
+    CHECK_EQ(after.coalesced, before.coalesced);
+    CHECK_EQ(scene.Apply(store), 0);
+    CHECK_EQ(Stats(store).applies, before.applies);
+
+    // Not finite or an unknown key: not accepted, not counted
+    double nan = std::nan("");
+    CHECK_EQ(store.SetNumbers(&key, &nan, 1), 0);
+    int unknown = 99;
+    double one = 1.0;
+    CHECK_EQ(store.SetNumbers(&unknown, &one, 1), 0);
+    CHECK_EQ(Stats(store).writes, after.writes);
+
+    // Changing the value to what the layer already shows counts a field, not a layer
+    SetNumber(store, key, 8.0);
+    scene.layers[0].posY = 8.0f;
+    CHECK_EQ(scene.Apply(store), 0);
+    CHECK_EQ(Stats(store).fieldsApplied, before.fieldsApplied + 1);
+}
+
+static void TestLayerReplaced()
+{
+    DaroDataStore store;
+    Scene scene;
+    int x = store.Key("x");
+    int label = store.Key("label");
+    store.Bind(0, 1, DARO_FIELD_POS_X, x);
+    store.Bind(0, 1, DARO_FIELD_TEXT, label);
+    store.Bind(0, 2, DARO_FIELD_OPACITY, x);
+    SetNumber(store, x, 0.25);
+    SetText(store, label, L"Live");
+    CHECK_EQ(scene.Apply(store), 2);
+    long long fields = Stats(store).fieldsApplied;
+
+    // The host replaced layer 1 with its own stale copy
+    scene.layers[1] = DaroLayer{};
+    scene.layers[1].posY = 3.0f;
+    CHECK_EQ(scene.Apply(store), 0);
+    CHECK(scene.layers[1].posX == 0.0f);
+
+    store.TouchLayer(0, 1);
+    CHECK_EQ(scene.Apply(store), 1);
+    CHECK(scene.layers[1].posX == 0.25f);
+    CHECK(scene.layers[1].posY == 3.0f);
+    CHECK(wcscmp(scene.layers[1].textContent, L"Live") == 0);
+    // Only the touched layer's bindings
+    CHECK_EQ(Stats(store).fieldsApplied, fields + 2);
+
+    // A touched layer whose bound fields still hold: written, not changed
+    store.TouchLayers(0, 1ull << 2);
+    CHECK_EQ(scene.Apply(store), 0);
+    CHECK_EQ(Stats(store).fieldsApplied, fields + 3);
+
+    // Unbound, a replaced layer keeps what the host wrote
+    CHECK(store.Bind(0, 1, DARO_FIELD_POS_X, -1));
+    scene.layers[1].posX = 9.0f;
+    store.TouchLayer(0, 1);
+    scene.Apply(store);
+    CHECK(scene.layers[1].posX == 9.0f);
+}
+
+static void TestConversion()
+{
+    DaroDataStore store;
+    Scene scene;
+    int key = store.Key("mixed");
+    store.Bind(0, 0, DARO_FIELD_POS_X, key);
+    store.Bind(0, 0, DARO_FIELD_TEXT, key);
+    store.Bind(0, 1, DARO_FIELD_OPACITY, key);
+    store.Bind(0, 1, DARO_FIELD_FONT_SIZE, key);
+
+    // A number shows as text; fields are clamped like the Designer's animation
+    SetNumber(store, key, 12.5);
+    scene.Apply(store);
+    CHECK(wcscmp(scene.layers[0].textContent, L"12.5") == 0);
+    CHECK(scene.layers[0].posX == 12.5f);
+    CHECK(scene.layers[1].opacity == 1.0f);
+    CHECK(scene.layers[1].fontSize == 12.5f);
+
+    SetNumber(store, key, -0.1);
+    scene.Apply(store);
+    CHECK(wcscmp(scene.layers[0].textContent, L"-0.1") == 0);
+    CHECK(scene.layers[1].opacity == 0.0f);
+    CHECK(scene.layers[1].fontSize == 1.0f);
+
+    // Numeric text drives the number fields
+    SetText(store, key, L"42");
+    CHECK_EQ(scene.Apply(store), 2);
+    CHECK(wcscmp(scene.layers[0].textContent, L"42") == 0);
+    CHECK(scene.layers[0].posX == 42.0f);
+    CHECK(scene.layers[1].fontSize == 42.0f);
+
+    // Anything else only reaches the text
+    SetText(store, key, L"42 points");
+    CHECK_EQ(scene.Apply(store), 1);
+    CHECK(wcscmp(scene.layers[0].textContent, L"42 points") == 0);
+    CHECK(scene.layers[0].posX == 42.0f);
+    CHECK(scene.layers[1].fontSize == 42.0f);
+
+    double number = 0.0;
+    std::vector<wchar_t> text;
+    CHECK_EQ(store.GetValue(key, &number, &text), DARO_DATA_TEXT);
+    CHECK(wcscmp(text.data(), L"42 points") == 0);
+
+    // Text longer than a layer holds is cut to fit
+    std::wstring longText(DARO_MAX_TEXT + 100, L'a');
+    SetText(store, key, longText.c_str());
+    scene.Apply(store);
+    CHECK_EQ(wcslen(scene.layers[0].textContent), DARO_MAX_TEXT - 1);
+}
+
+static void TestTimelineTrack()
+{
+    DaroDataStore store;
+    Scene scene;
+    DaroTimeline timeline;
+    timeline.SetLength(100);
+    DaroKeyframe keys[2] = { { 0, 10.0f, 0.0f, 0.0f }, { 10, 20.0f, 0.0f, 0.0f } };
+    CHECK(timeline.SetTrack(0, DARO_FIELD_POS_X, keys, 2));
+    CHECK(timeline.SetTrack(0, DARO_FIELD_POS_Y, keys, 2));
+    CHECK_EQ(timeline.TrackedLayers(), 1);
+    timeline.Play();
+
+    int key = store.Key("x");
+    store.Bind(0, 0, DARO_FIELD_POS_X, key);
+    SetNumber(store, key, 5.0);
+
+    // Each frame as Daro_BeginFrame runs it: tick, touch what the timeline wrote, apply
+    for (int frame = 0; frame < 5; frame++)
+    {
+        timeline.Tick(scene.layers.data(), DARO_MAX_LAYERS);
+        CHECK(scene.layers[0].posX != 5.0f);
+        store.TouchLayers(0, timeline.TrackedLayers());
+        scene.Apply(store);
+        // The bound field wins; the track still drives the field nothing is bound to
+        CHECK(scene.layers[0].posX == 5.0f);
+        CHECK(scene.layers[0].posY == 10.0f + frame);
+    }
+}
+
+static void TestProducers()
+{
+    const int producers = 4;
+    const int writes = 20000;
+    DaroDataStore store;
+    Scene scene;
+    int keys[producers];
+    for (int p = 0; p < producers; p++)
+    {
+        keys[p] = store.Key(("feed" + std::to_string(p)).c_str());
+        store.Bind(0, p, DARO_FIELD_POS_X, keys[p]);
+    }
+    int shared = store.Key("shared");
+    store.Bind(0, producers, DARO_FIELD_POS_X, shared);
+
+    std::atomic<bool> done{ false };
+    std::thread render([&]
+    {
+        while (!done.load()) scene.Apply(store);
+    });
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&, p]
+        {
+            for (int i = 1; i <= writes; i++)
+            {
+                int batch[2] = { keys[p], shared };
+                double values[2] = { (double)i, (double)(p * writes + i) };
+                store.SetNumbers(batch, values, 2);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    done.store(true);
+    render.join();
+    scene.Apply(store);
+
+    DaroDataStoreStats stats = Stats(store);
+    CHECK_EQ(stats.writes, producers * writes * 2);
+    CHECK(stats.unchanged + stats.coalesced < stats.writes);
+    CHECK(stats.applies > 0);
+    for (int p = 0; p < producers; p++) CHECK(scene.layers[p].posX == (float)writes);
+
+    // The shared key shows the last write whichever producer made it
+    double last = 0.0;
+    CHECK_EQ(store.GetValue(shared, &last, nullptr), DARO_DATA_NUMBER);
+    CHECK(scene.layers[producers].posX == (float)last);
+    CHECK_EQ((long long)last % writes, 0);
+}
+
+static void TestIngest(const std::string& name)
+{
+    DaroDataStore store;
+    Scene scene;
+    store.Bind(0, 0, DARO_FIELD_POS_X, store.Key("clock"));
+    store.Bind(0, 0, DARO_FIELD_TEXT, store.Key("team"));
+
+    DaroDataIngest ingest;
+    CHECK(ingest.Start(name.c_str(), 8));
+    CHECK_EQ(ingest.GetEntryCount(), 8);
+    DaroDataIngestWriter writer;
+    CHECK(writer.Open(name.c_str()));
+    CHECK_EQ(writer.GetEntryCount(), 8);
+
+    // Nothing written: no scan
+    ingest.Poll(&store);
+    CHECK_EQ(Stats(store).ingestScans, 0);
+
+    const uint16_t team[] = { 'R', 'e', 'd', 0 };
+    CHECK(writer.SetNumber(0, "clock", 90.0));
+    CHECK(writer.SetText(1, "team", team));
+    CHECK(!writer.SetNumber(8, "clock", 1.0));
+    CHECK(!writer.SetNumber(0, "", 1.0));
+    ingest.Poll(&store);
+    CHECK_EQ(scene.Apply(store), 1);
+    CHECK(scene.layers[0].posX == 90.0f);
+    CHECK(wcscmp(scene.layers[0].textContent, L"Red") == 0);
+    DaroDataStoreStats stats = Stats(store);
+    CHECK_EQ(stats.ingestScans, 1);
+    CHECK_EQ(stats.writes, 2);
+
+    // Written twice between polls: the store sees the last value only
+    writer.SetNumber(0, "clock", 91.0);
+    writer.SetNumber(0, "clock", 92.0);
+    ingest.Poll(&store);
+    CHECK_EQ(Stats(store).writes, 3);
+    scene.Apply(store);
+    CHECK(scene.layers[0].posX == 92.0f);
+
+    // Catch entry 0 mid-write from a second mapping, as a producer would leave it
+    DaroSharedMemory memory;
+    CHECK(memory.Open(name.c_str()));
+    auto* header = static_cast<DaroDataIngestHeader*>(memory.Data());
+    auto* entries = reinterpret_cast<DaroDataIngestEntry*>(static_cast<uint8_t*>(memory.Data()) + header->headerSize);
+    DaroDataIngestEntry& entry = entries[0];
+    uint32_t seq = entry.sequence.load();
+    entry.sequence.store(seq + 1);
+    entry.number = 93.0;
+    header->changeCount.fetch_add(1);
+    ingest.Poll(&store);
+    stats = Stats(store);
+    CHECK_EQ(stats.ingestScans, 3);
+    CHECK_EQ(stats.ingestTornReads, 1);
+    CHECK_EQ(stats.writes, 3);
+
+    // The write completes without another change count bump: the retry still reads it
+    entry.sequence.store(seq + 2);
+    ingest.Poll(&store);
+    stats = Stats(store);
+    CHECK_EQ(stats.ingestScans, 4);
+    CHECK_EQ(stats.ingestTornReads, 1);
+    CHECK_EQ(stats.writes, 4);
+    scene.Apply(store);
+    CHECK(scene.layers[0].posX == 93.0f);
+
+    // Nothing new: the retry is not repeated
+    ingest.Poll(&store);
+    CHECK_EQ(Stats(store).ingestScans, 4);
+
+    // A producer that died mid-write leaves the entry odd; the next write recovers it
+    entry.sequence.store(entry.sequence.load() + 1);
+    CHECK(writer.SetNumber(0, "clock", 94.0));
+    CHECK_EQ(entry.sequence.load() & 1, 0);
+    ingest.Poll(&store);
+    scene.Apply(store);
+    CHECK(scene.layers[0].posX == 94.0f);
+    memory.Close();
+
+    // Stopped: producers see the region gone and the name is unlinked
+    ingest.Stop();
+    CHECK(!writer.SetNumber(0, "clock", 95.0));
+    writer.Close();
+    DaroDataIngestWriter late;
+    CHECK(!late.Open(name.c_str()));
+}
+
+int main()
+{
+    TestCoalescing();
+    TestUnchanged();
+    TestLayerReplaced();
+    TestConversion();
+    TestTimelineTrack();
+    TestProducers();
+    std::string pid = std::to_string((long long)getpid());
+    TestIngest("DaroTestData_" + pid);
+    return DaroTestResult("TestDataStore");
+}
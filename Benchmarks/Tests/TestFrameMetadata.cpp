@@ -0,0 +1,104 @@
+// Benchmarks/Tests/TestFrameMetadata.cpp
+// Metadata ring: exact-frame lookup, overwrite and not-yet-written misses, sender
+// loss/recreation, and a concurrent writer/reader that must never see a torn record.
+#include "DaroTest.h"
+#include "FrameMetadata.h"
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+static DaroFrameMetadata MakeRecord(long long frame)
+{
+    DaroFrameMetadata m = {};
+    m.spoutFrame = frame;
+    m.engineFrame = frame * 2;
+    m.timestampNs = frame * 1000;
+    m.timecode = (int)(frame & 0xFF);
+    snprintf(m.templateName, sizeof(m.templateName), "template-%lld", frame);
+    snprintf(m.itemName, sizeof(m.itemName), "item-%lld", frame);
+    return m;
+}
+
+static void TestLookup(const char* name)
+{
+    DaroMetadataWriter writer;
+    CHECK(writer.Create(name));
+
+    DaroMetadataReader reader;
+    CHECK(reader.Open(name));
+
+    DaroFrameMetadata m = {};
+    CHECK(!reader.ReadLatest(&m));      // Nothing written yet
+
+    for (long long frame = 0; frame < 100; frame++)
+        writer.Write(MakeRecord(frame));
+
+    CHECK(reader.Read(99, &m));
+    CHECK_EQ(m.engineFrame, 198);
+    CHECK(strcmp(m.itemName, "item-99") == 0);
+
+    CHECK(reader.Read(99 - DARO_METADATA_RECORDS + 1, &m));     // Oldest still in the ring
+    CHECK(!reader.Read(99 - DARO_METADATA_RECORDS, &m));        // Overwritten
+    CHECK(!reader.Read(100, &m));                               // Not written yet
+
+    CHECK(reader.ReadLatest(&m));
+    CHECK_EQ(m.spoutFrame, 99);
+
+    // Unterminated names are clipped by the writer
+    DaroFrameMetadata longName = MakeRecord(100);
+    memset(longName.templateName, 'x', sizeof(longName.templateName));
+    writer.Write(longName);
+    CHECK(reader.Read(100, &m));
+    CHECK_EQ(strlen(m.templateName), DARO_METADATA_NAME - 1);
+
+    // Recreating the sender invalidates the reader's session
+    CHECK(!reader.IsSenderLost());
+    writer.Release();
+    CHECK(reader.IsSenderLost());
+    CHECK(!reader.Read(100, &m));
+}
+
+static void TestConcurrent(const char* name)
+{
+    DaroMetadataWriter writer;
+    CHECK(writer.Create(name));
+    DaroMetadataReader reader;
+    CHECK(reader.Open(name));
+
+    const long long frames = 200000;
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        for (long long frame = 0; frame < frames; frame++)
+            writer.Write(MakeRecord(frame));
+        done.store(true);
+    });
+
+    long long reads = 0, torn = 0;
+    while (!done.load())
+    {
+        DaroFrameMetadata m;
+        if (!reader.ReadLatest(&m)) continue;
+        reads++;
+        // Every field must come from the same Write
+        std::string item = "item-" + std::to_string(m.spoutFrame);
+        if (m.engineFrame != m.spoutFrame * 2 || m.timestampNs != m.spoutFrame * 1000 || item != m.itemName)
+            torn++;
+    }
+    producer.join();
+
+    CHECK_EQ(torn, 0);
+    DaroFrameMetadata m;
+    CHECK(reader.ReadLatest(&m));
+    CHECK_EQ(m.spoutFrame, frames - 1);
+    printf("concurrent: %lld consistent reads\n", reads);
+}
+
+int main()
+{
+    std::string name = "DaroTestMeta_" + std::to_string((long long)getpid());
+    TestLookup(name.c_str());
+    TestConcurrent(name.c_str());
+    return DaroTestResult("TestFrameMetadata");
+}
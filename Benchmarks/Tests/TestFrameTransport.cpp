@@ -0,0 +1,102 @@
+// Benchmarks/Tests/TestFrameTransport.cpp
+// Frame transport sender lifetime: an idle sender keeps its name, a crashed one is
+// reclaimed, a stale smaller segment is grown, and frames round-trip intact.
+#include "DaroTest.h"
+#include "FrameTransport.h"
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Registry entry for a sender name, through a second view of the registry segment
+static DaroTransportRegistryEntry* FindEntry(DaroSharedMemory& memory, const char* name)
+{
+    if (!memory.IsOpen() && !memory.Open(DARO_TRANSPORT_REGISTRY_NAME)) return nullptr;
+    auto* registry = static_cast<DaroTransportRegistry*>(memory.Data());
+    for (auto& entry : registry->entries)
+    {
+        if (entry.state.load() == 2 && strncmp(entry.name, name, DARO_TRANSPORT_MAX_NAME) == 0)
+            return &entry;
+    }
+    return nullptr;
+}
+
+// A process id that is certainly not running: a child that has already been reaped
+static uint32_t ExitedProcessId()
+{
+    pid_t child = fork();
+    if (child == 0) _exit(0);
+    waitpid(child, nullptr, 0);
+    return (uint32_t)child;
+}
+
+static void TestIdleSender(const std::string& name)
+{
+    DaroFrameSender sender;
+    CHECK(sender.Create(name.c_str(), 64, 32));
+
+    DaroSharedMemory registry;
+    DaroTransportRegistryEntry* entry = FindEntry(registry, name.c_str());
+    CHECK(entry != nullptr);
+    if (!entry) return;
+
+    // No publish for longer than the stale timeout: the owner is still running
+    entry->heartbeatNs.store(0);
+    DaroTransportRegistryView view;
+    CHECK(view.FindSender(name.c_str()));
+    DaroFrameSender second;
+    CHECK(!second.Create(name.c_str(), 64, 32));
+
+    // Owner gone as well: the name is reclaimed
+    entry->processId = ExitedProcessId();
+    CHECK(!view.FindSender(name.c_str()));
+    CHECK(second.Create(name.c_str(), 64, 32));
+}
+
+static void TestGrowStaleSegment(const std::string& name)
+{
+    // A crashed sender left a small segment behind under the same name
+    std::string memName = std::string(DARO_TRANSPORT_SENDER_PREFIX) + name;
+    {
+        DaroSharedMemory stale;
+        CHECK(stale.Create(memName.c_str(), 4096) == DARO_SHM_CREATED);
+    }
+
+    DaroFrameSender sender;
+    CHECK(sender.Create(name.c_str(), 256, 128));
+    CHECK(sender.GetMemorySize() > 4096);
+
+    DaroFrameReceiver receiver;
+    CHECK(receiver.Connect(name.c_str()));
+    CHECK_EQ(receiver.GetFrameBytes(), 256 * 128 * 4);
+
+    std::vector<uint8_t> frame(256 * 128 * 4), received(frame.size());
+    for (size_t i = 0; i < frame.size(); i++) frame[i] = (uint8_t)(i * 13);
+    CHECK(sender.Publish(frame.data(), 256 * 4, 7, 0));
+
+    DaroTransportFrameInfo info = {};
+    CHECK(receiver.ReceiveFrame(received.data(), received.size(), &info));
+    CHECK_EQ(info.frameNumber, 7);
+    CHECK(received == frame);
+    CHECK(!receiver.ReceiveFrame(received.data(), received.size(), &info));    // Nothing new
+
+    // Recreated sender: the receiver must reconnect instead of reading the new layout
+    CHECK(sender.Create(name.c_str(), 512, 256));
+    CHECK(sender.Publish(std::vector<uint8_t>(512 * 256 * 4).data(), 512 * 4, 8, 0));
+    CHECK(!receiver.ReceiveFrame(received.data(), received.size(), &info));
+    CHECK(receiver.IsSenderLost());
+
+    // The sender attached to the stale segment rather than creating it, so it leaves it in place
+    sender.Release();
+    shm_unlink(("/" + memName).c_str());
+}
+
+int main()
+{
+    std::string pid = std::to_string((long long)getpid());
+    TestIdleSender("TestIdle_" + pid);
+    TestGrowStaleSegment("TestGrow_" + pid);
+    return DaroTestResult("TestFrameTransport");
+}
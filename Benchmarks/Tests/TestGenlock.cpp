@@ -0,0 +1,244 @@
+// Benchmarks/Tests/TestGenlock.cpp
+// Render loop genlock: locked to a tick generator running 100 ppm fast or slow, at the
+// loop rate or half of it, the loop locks within a few frames and its correction
+// converges to the reference's offset; when the reference stops the loss is counted and
+// the last rate is held. A reference phase step under a quarter period is slewed out at
+// the slew limit without winding up the integral; a larger one re-anchors at once.
+#include "DaroTest.h"
+#include "RenderLoop.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+static const DaroRational kRate = { 200, 1 };
+static const double kPeriodNs = 1e9 / 200.0;
+static const double kMaxSlewNs = kPeriodNs * DARO_GENLOCK_MAX_SLEW;
+
+// Genlock stats after each frame's genlock step, taken from the frame function
+class Sampler
+{
+public:
+    explicit Sampler(DaroRenderLoop& loop) : m_Loop(loop) { m_Samples.reserve(4096); }
+
+    DaroRenderLoop::FrameFunc Frame()
+    {
+        return [this] {
+            DaroGenlockStats stats;
+            m_Loop.GetGenlockStats(&stats);
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Samples.push_back(stats);
+            return true;
+        };
+    }
+
+    // Wait until count samples exist in all (false on timeout)
+    bool WaitFor(size_t count)
+    {
+        auto end = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (std::chrono::steady_clock::now() < end)
+        {
+            if (Size() >= count) return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return false;
+    }
+
+    size_t Size()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Samples.size();
+    }
+
+    std::vector<DaroGenlockStats> Samples()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Samples;
+    }
+
+private:
+    DaroRenderLoop& m_Loop;
+    std::mutex m_Mutex;
+    std::vector<DaroGenlockStats> m_Samples;
+};
+
+static int FirstLocked(const std::vector<DaroGenlockStats>& samples)
+{
+    for (size_t i = 0; i < samples.size(); i++)
+        if (samples[i].state == DARO_GENLOCK_LOCKED) return (int)i;
+    return -1;
+}
+
+static void TestOffset(const std::string& name, DaroRational referenceRate, double offsetPpm)
+{
+    DaroTickGenerator generator;
+    CHECK(generator.Start(name.c_str(), referenceRate, offsetPpm));
+
+    DaroRenderLoop loop;
+    Sampler sampler(loop);
+    CHECK(loop.SetExternalClock(name.c_str()));
+    CHECK(loop.Start(kRate, sampler.Frame()));
+    CHECK(sampler.WaitFor(300));
+
+    std::vector<DaroGenlockStats> samples = sampler.Samples();
+    int locked = FirstLocked(samples);
+    CHECK(locked >= 0 && locked <= 10);
+    const DaroGenlockStats& last = samples.back();
+    CHECK_EQ(last.state, DARO_GENLOCK_LOCKED);
+    CHECK_EQ(last.relocks, 1);
+    CHECK_EQ(last.referenceLost, 0);
+    CHECK(last.ticks > 0);
+    CHECK(std::fabs(last.correctionPpm - offsetPpm) < 2.0);
+    CHECK(std::fabs(last.phaseErrorMs) * 1e6 < DARO_GENLOCK_LOCKED_NS);
+    double referenceFps = DaroRationalToDouble(referenceRate) * (1.0 + offsetPpm * 1e-6);
+    CHECK(std::fabs(last.referenceFps - referenceFps) < referenceFps * 1e-6);
+    // Locked from then on: the drift never pulls it out
+    for (size_t i = (size_t)std::max(locked, 0); i < samples.size(); i++)
+        CHECK_EQ(samples[i].state, DARO_GENLOCK_LOCKED);
+
+    // Reference gone: counted once, and the loop holds the rate it had
+    generator.Stop();
+    size_t stopped = sampler.Size();
+    CHECK(sampler.WaitFor(stopped + 20));
+    samples = sampler.Samples();
+    const DaroGenlockStats& lost = samples.back();
+    CHECK_EQ(lost.state, DARO_GENLOCK_NO_REFERENCE);
+    CHECK_EQ(lost.referenceLost, 1);
+    CHECK(std::fabs(lost.correctionPpm - offsetPpm) < 2.0);
+    loop.Stop();
+}
+
+// A reference whose phase the test can step, writing the tick block as a reference would
+class SteppedReference
+{
+public:
+    ~SteppedReference() { Stop(); }
+
+    bool Start(const std::string& name)
+    {
+        m_Memory.SetUnlinkOnClose(true);
+        if (m_Memory.Create(name.c_str(), sizeof(DaroTickBlock)) == DARO_SHM_FAILED) return false;
+        m_Block = static_cast<DaroTickBlock*>(m_Memory.Data());
+        m_Block->magic.store(0);
+        m_Block->version = DARO_TICK_VERSION;
+        m_Block->rateNum = kRate.num;
+        m_Block->rateDen = kRate.den;
+        m_Block->sequence.store(0);
+        m_Block->tickCount.store(0);
+        m_Block->tickNs.store(0);
+        m_Block->magic.store(DARO_TICK_MAGIC, std::memory_order_release);
+        m_Thread = std::thread([this] { Run(); });
+        return true;
+    }
+
+    void Stop()
+    {
+        m_Stop = true;
+        if (m_Thread.joinable()) m_Thread.join();
+        m_Memory.Close();
+    }
+
+    void Step(int64_t ns) { m_PhaseNs += ns; }
+
+private:
+    void Run()
+    {
+        int64_t originNs = (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        for (uint64_t tick = 0; !m_Stop; tick++)
+        {
+            int64_t tickNs = originNs + DaroFrameToNs((int64_t)tick, kRate) + m_PhaseNs.load();
+            std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(tickNs))));
+            uint32_t seq = m_Block->sequence.load(std::memory_order_relaxed);
+            m_Block->sequence.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_Block->tickCount.store(tick + 1, std::memory_order_relaxed);
+            m_Block->tickNs.store(tickNs, std::memory_order_relaxed);
+            m_Block->sequence.store(seq + 2, std::memory_order_release);
+        }
+    }
+
+    DaroSharedMemory m_Memory;
+    DaroTickBlock* m_Block = nullptr;
+    std::thread m_Thread;
+    std::atomic<bool> m_Stop{ false };
+    std::atomic<int64_t> m_PhaseNs{ 0 };
+};
+
+static void TestPhaseStep(const std::string& name)
+{
+    SteppedReference reference;
+    CHECK(reference.Start(name));
+    DaroRenderLoop loop;
+    Sampler sampler(loop);
+    CHECK(loop.SetExternalClock(name.c_str()));
+    CHECK(loop.Start(kRate, sampler.Frame()));
+    CHECK(sampler.WaitFor(60));
+    CHECK_EQ(sampler.Samples().back().state, DARO_GENLOCK_LOCKED);
+
+    // An eighth of a period: pulled in, not re-anchored
+    size_t before = sampler.Size();
+    reference.Step((int64_t)(kPeriodNs / 8));
+    CHECK(sampler.WaitFor(before + 250));
+    std::vector<DaroGenlockStats> samples = sampler.Samples();
+    size_t step = before;
+    while (step < samples.size() && std::fabs(samples[step].phaseErrorMs) * 1e6 < kPeriodNs / 16) step++;
+    CHECK(step < samples.size());
+    if (step < samples.size())
+    {
+        double worstSlewNs = 0.0, overshootNs = 0.0, worstPpm = 0.0;
+        for (size_t i = step; i < samples.size(); i++)
+        {
+            CHECK_EQ(samples[i].relocks, 1);
+            double errorNs = samples[i].phaseErrorMs * 1e6;
+            if (i > step) worstSlewNs = std::max(worstSlewNs, std::fabs(errorNs - samples[i - 1].phaseErrorMs * 1e6));
+            // The step puts the deadline early: the error is negative and must not swing far past 0
+            overshootNs = std::max(overshootNs, errorNs);
+            worstPpm = std::max(worstPpm, std::fabs(samples[i].correctionPpm));
+        }
+        CHECK_EQ(samples[step].state, DARO_GENLOCK_ACQUIRING);
+        CHECK(samples[step].phaseErrorMs < 0.0);
+        CHECK(worstSlewNs <= kMaxSlewNs + 1.0);
+        // Slewing at the limit takes about 125 frames for an eighth of a period
+        CHECK(samples.size() - step > 100);
+        CHECK_EQ(samples.back().state, DARO_GENLOCK_LOCKED);
+        // Anti-windup: the integral stays near the offset (0 here) instead of the
+        // ~10% it would reach integrating the whole pull-in, so there is no ringing
+        CHECK(worstPpm < 2000.0);
+        CHECK(overshootNs < 50000.0);
+        CHECK(std::fabs(samples.back().correctionPpm) < 20.0);
+    }
+
+    // A third of a period: re-anchored at once
+    before = sampler.Size();
+    reference.Step((int64_t)(kPeriodNs / 3));
+    CHECK(sampler.WaitFor(before + 20));
+    samples = sampler.Samples();
+    DaroGenlockStats last = samples.back();
+    CHECK_EQ(last.relocks, 2);
+    CHECK_EQ(last.state, DARO_GENLOCK_LOCKED);
+    size_t relock = before;
+    while (relock < samples.size() && samples[relock].relocks < 2) relock++;
+    CHECK(relock + 2 < samples.size());
+    if (relock + 2 < samples.size())
+        CHECK_EQ(samples[relock + 1].state, DARO_GENLOCK_LOCKED);
+
+    loop.Stop();
+    reference.Stop();
+}
+
+int main()
+{
+    std::string pid = std::to_string((long long)getpid());
+    TestOffset("DaroTestTicksFast_" + pid, kRate, 100.0);
+    TestOffset("DaroTestTicksSlow_" + pid, kRate, -100.0);
+    TestOffset("DaroTestTicksHalf_" + pid, DaroRational{ 100, 1 }, 100.0);
+    TestPhaseStep("DaroTestTicksStep_" + pid);
+    return DaroTestResult("TestGenlock");
+}
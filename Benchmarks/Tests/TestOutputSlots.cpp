@@ -0,0 +1,75 @@
+// Benchmarks/Tests/TestOutputSlots.cpp
+// Dropped-frame grid: completions jittered around the period count no drops, whichever
+// side of the period the first one lands on; real gaps count every missed slot.
+#include "DaroTest.h"
+#include "OutputSlots.h"
+#include <cstdint>
+
+// Deterministic jitter in [-range, range]
+static int64_t Jitter(uint32_t& state, int64_t range)
+{
+    state = state * 1664525u + 1013904223u;
+    return (int64_t)(state >> 8) % (2 * range + 1) - range;
+}
+
+static int64_t RunJittered(DaroRational rate, int64_t frames, double jitterOfPeriod, uint32_t seed)
+{
+    DaroOutputSlots slots;
+    int64_t range = (int64_t)(DaroFrameToNs(1, rate) * jitterOfPeriod);
+    int64_t dropped = 0;
+    const int64_t startNs = 1000000000;
+    for (int64_t frame = 0; frame < frames; frame++)
+        dropped += slots.Complete(startNs + DaroFrameToNs(frame, rate) + Jitter(seed, range), rate);
+    return dropped;
+}
+
+static void TestJitter()
+{
+    const DaroRational rates[] = { { 50, 1 }, { 60000, 1001 }, { 30000, 1001 }, { 24, 1 } };
+    for (DaroRational rate : rates)
+    {
+        // Up to a quarter period either way (every completion within half a period of
+        // the first one's phase), an hour of frames at each rate
+        int64_t frames = 3600 * rate.num / rate.den;
+        for (uint32_t seed = 1; seed <= 4; seed++)
+            CHECK_EQ(RunJittered(rate, frames, 0.24, seed), 0);
+    }
+
+    // The completion right after the first one is early: the old grid, anchored on the
+    // first completion, put it in slot 0 and counted slot 1 as dropped
+    DaroRational rate = { 50, 1 };
+    DaroOutputSlots slots;
+    CHECK_EQ(slots.Complete(0, rate), 0);
+    CHECK_EQ(slots.Complete(DaroFrameToNs(1, rate) - 3000000, rate), 0);
+    CHECK_EQ(slots.Complete(DaroFrameToNs(2, rate) + 3000000, rate), 0);
+}
+
+static void TestGaps()
+{
+    DaroRational rate = { 50, 1 };
+    int64_t period = DaroFrameToNs(1, rate);
+    DaroOutputSlots slots;
+    CHECK_EQ(slots.Complete(0, rate), 0);
+    CHECK_EQ(slots.Complete(period, rate), 0);
+    CHECK_EQ(slots.Complete(3 * period, rate), 1);              // Slot 2 missed
+    CHECK_EQ(slots.Complete(3 * period + period / 4, rate), 0); // Second frame in slot 3
+    // Late frame followed by a quick one: the late one's slot is still the one missed
+    CHECK_EQ(slots.Complete(5 * period + period / 5, rate), 1);
+    CHECK_EQ(slots.Complete(6 * period - period / 5, rate), 0);
+    CHECK_EQ(slots.Complete(16 * period, rate), 9);
+
+    // A rate change lays a new grid instead of counting the old one's slots
+    DaroRational ntsc = { 60000, 1001 };
+    CHECK_EQ(slots.Complete(100 * period, ntsc), 0);
+    CHECK_EQ(slots.Complete(100 * period + DaroFrameToNs(1, ntsc), ntsc), 0);
+
+    slots.Reset();
+    CHECK_EQ(slots.Complete(500 * period, ntsc), 0);
+}
+
+int main()
+{
+    TestJitter();
+    TestGaps();
+    return DaroTestResult("TestOutputSlots");
+}
@@ -0,0 +1,155 @@
+// Benchmarks/Tests/TestPixelConvert.cpp
+// DaroConvertPixels and DaroCopyRows against a per-pixel reference: every format pair,
+// flipped and unflipped, padded and packed strides, widths that do not fill a word.
+// Destination padding must be left untouched.
+#include "DaroTest.h"
+#include "PixelConvert.h"
+#include <cstring>
+#include <vector>
+
+static const uint8_t GUARD = 0xCD;
+
+// Channel c (0 = R, 1 = G, 2 = B, 3 = A) of a pixel in a layout
+static uint8_t Channel(const uint8_t* pixel, uint32_t format, int c)
+{
+    bool blueFirst = (format == DARO_PIXEL_BGRA8 || format == DARO_PIXEL_BGR8);
+    if (c == 3) return pixel[3];
+    if (c == 1) return pixel[1];
+    return pixel[(c == 0) == blueFirst ? 2 : 0];
+}
+
+static void CheckConversion(uint32_t srcFormat, uint32_t dstFormat, uint32_t width, uint32_t height,
+                            uint32_t srcPad, uint32_t dstPad, bool flip)
+{
+    uint32_t srcStride = width * 4 + srcPad;
+    std::vector<uint8_t> src((size_t)srcStride * height);
+    for (size_t i = 0; i < src.size(); i++) src[i] = (uint8_t)(i * 31 + 7);
+
+    DaroConvertDesc desc = {};
+    desc.width = width;
+    desc.height = height;
+    desc.srcFormat = srcFormat;
+    desc.srcStride = srcStride;
+    desc.dstFormat = dstFormat;
+    desc.dstStride = dstPad ? width * DaroPixelBytes(dstFormat) + dstPad : 0;
+    desc.flipVertical = flip;
+
+    uint32_t dstBpp = DaroPixelBytes(dstFormat);
+    uint32_t dstStride = desc.dstStride ? desc.dstStride : width * dstBpp;
+    std::vector<uint8_t> dst(DaroConvertDstSize(desc) + 16, GUARD);
+    CHECK(DaroConvertPixels(src.data(), dst.data(), desc));
+
+    int mismatches = 0;
+    for (uint32_t y = 0; y < height; y++)
+    {
+        const uint8_t* srcRow = src.data() + (size_t)(flip ? height - 1 - y : y) * srcStride;
+        const uint8_t* dstRow = dst.data() + (size_t)y * dstStride;
+        for (uint32_t x = 0; x < width; x++)
+        {
+            for (int c = 0; c < (int)dstBpp; c++)
+            {
+                if (Channel(dstRow + x * dstBpp, dstFormat, c) != Channel(srcRow + x * 4, srcFormat, c))
+                    mismatches++;
+            }
+        }
+        for (uint32_t b = width * dstBpp; y + 1 < height && b < dstStride; b++)
+        {
+            if (dstRow[b] != GUARD) mismatches++;      // Row padding
+        }
+    }
+    for (size_t b = dst.size() - 16; b < dst.size(); b++)
+    {
+        if (dst[b] != GUARD) mismatches++;               // Past the last row
+    }
+    if (mismatches)
+        fprintf(stderr, "  src %u -> dst %u, %ux%u, pads %u/%u, flip %d\n", srcFormat, dstFormat, width, height, srcPad, dstPad, flip);
+    CHECK_EQ(mismatches, 0);
+}
+
+static void TestConvert()
+{
+    const uint32_t srcFormats[] = { DARO_PIXEL_BGRA8, DARO_PIXEL_RGBA8 };
+    const uint32_t dstFormats[] = { DARO_PIXEL_BGRA8, DARO_PIXEL_RGBA8, DARO_PIXEL_BGR8, DARO_PIXEL_RGB8 };
+    const uint32_t widths[] = { 1, 3, 7, 16, 33 };
+    for (uint32_t srcFormat : srcFormats)
+        for (uint32_t dstFormat : dstFormats)
+            for (uint32_t width : widths)
+                for (int flip = 0; flip < 2; flip++)
+                {
+                    CheckConversion(srcFormat, dstFormat, width, 5, 0, 0, flip != 0);
+                    CheckConversion(srcFormat, dstFormat, width, 5, 12, 0, flip != 0);
+                    CheckConversion(srcFormat, dstFormat, width, 5, 0, 8, flip != 0);
+                    CheckConversion(srcFormat, dstFormat, width, 1, 4, 4, flip != 0);
+                }
+}
+
+static void TestRejects()
+{
+    uint8_t buffer[256] = {};
+    DaroConvertDesc desc = {};
+    desc.width = 8;
+    desc.height = 2;
+    desc.srcFormat = DARO_PIXEL_BGRA8;
+    desc.srcStride = 32;
+    desc.dstFormat = DARO_PIXEL_RGB8;
+    CHECK(DaroConvertPixels(buffer, buffer + 128, desc));
+
+    DaroConvertDesc bad = desc;
+    bad.srcStride = 31;                         // Shorter than a row
+    CHECK(!DaroConvertPixels(buffer, buffer + 128, bad));
+    bad = desc;
+    bad.dstStride = 23;
+    CHECK(!DaroConvertPixels(buffer, buffer + 128, bad));
+    bad = desc;
+    bad.srcFormat = DARO_PIXEL_RGB8;            // 3-byte sources are not supported
+    CHECK(!DaroConvertPixels(buffer, buffer + 128, bad));
+    bad = desc;
+    bad.dstFormat = 99;
+    CHECK(!DaroConvertPixels(buffer, buffer + 128, bad));
+    CHECK_EQ(DaroPixelBytes(99), 0);
+    bad = desc;
+    bad.height = 0;
+    CHECK(!DaroConvertPixels(buffer, buffer + 128, bad));
+    CHECK_EQ(DaroConvertDstSize(bad), 0);
+    CHECK(!DaroConvertPixels(nullptr, buffer, desc));
+}
+
+static void TestCopyRows()
+{
+    // 5 pixels plus a 2-byte tail per row, copied between padded strides
+    const size_t rowBytes = 22, srcStride = 32, dstStride = 28;
+    const uint32_t rows = 4;
+    std::vector<uint8_t> src(srcStride * rows);
+    for (size_t i = 0; i < src.size(); i++) src[i] = (uint8_t)(i * 5 + 1);
+
+    for (int opaque = 0; opaque < 2; opaque++)
+    {
+        std::vector<uint8_t> dst(dstStride * rows, GUARD);
+        DaroCopyRows(src.data(), srcStride, dst.data(), dstStride, rowBytes, rows, opaque != 0);
+        int mismatches = 0;
+        for (uint32_t y = 0; y < rows; y++)
+        {
+            for (size_t b = 0; b < dstStride; b++)
+            {
+                uint8_t expected = src[y * srcStride + b];
+                if (b >= rowBytes) expected = GUARD;
+                else if (opaque && b < 20 && b % 4 == 3) expected = 0xFF;
+                if (dst[y * dstStride + b] != expected) mismatches++;
+            }
+        }
+        CHECK_EQ(mismatches, 0);
+    }
+
+    // Contiguous buffers take the single memcpy path
+    std::vector<uint8_t> packed(rowBytes * rows);
+    DaroCopyRows(src.data(), rowBytes, packed.data(), rowBytes, rowBytes, rows);
+    CHECK(memcmp(packed.data(), src.data(), packed.size()) == 0);
+}
+
+int main()
+{
+    TestConvert();
+    TestRejects();
+    TestCopyRows();
+    return DaroTestResult("TestPixelConvert");
+}
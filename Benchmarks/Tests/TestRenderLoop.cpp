@@ -0,0 +1,174 @@
+// Benchmarks/Tests/TestRenderLoop.cpp
+// Render loop holds: no frame starts while a hold is outstanding, a hold taken on one
+// thread can be released on another, holds are counted, and Stop ends a held loop
+// without waiting for the release. A rate change retimes a running loop. The preview
+// render, which runs inside the loop's frame after the program render, never overlaps
+// a host's work done under a hold.
+#include "DaroTest.h"
+#include "RenderLoop.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+static const DaroRational kRate = { 200, 1 };
+
+static void SleepMs(int ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static void TestHoldAcrossThreads()
+{
+    std::atomic<long long> frames{ 0 };
+    std::atomic<bool> held{ false };
+    std::atomic<int> framesWhileHeld{ 0 };
+    DaroRenderLoop loop;
+    CHECK(loop.Start(kRate, [&] {
+        if (held.load()) framesWhileHeld++;
+        frames++;
+        return true;
+    }));
+    SleepMs(50);
+    CHECK(frames.load() > 0);
+
+    // Two holds from one thread, released from two others
+    loop.Hold();
+    loop.Hold();
+    held = true;
+    long long before = frames.load();
+    SleepMs(50);
+    CHECK_EQ(frames.load(), before);
+
+    std::thread first([&] { loop.Release(); });
+    first.join();
+    SleepMs(50);
+    CHECK_EQ(frames.load(), before);
+
+    held = false;
+    std::thread second([&] { loop.Release(); });
+    second.join();
+    SleepMs(50);
+    CHECK(frames.load() > before);
+    CHECK_EQ(framesWhileHeld.load(), 0);
+
+    // An extra release does not leave credit for a later hold
+    loop.Release();
+    loop.Hold();
+    before = frames.load();
+    SleepMs(50);
+    CHECK_EQ(frames.load(), before);
+    loop.Release();
+
+    loop.Stop();
+    CHECK(!loop.IsRunning());
+}
+
+static void TestHoldWaitsForFrame()
+{
+    // A hold taken mid-frame returns only once that frame has ended
+    std::atomic<bool> inFrame{ false };
+    std::atomic<bool> entered{ false };
+    DaroRenderLoop loop;
+    CHECK(loop.Start(kRate, [&] {
+        inFrame = true;
+        entered = true;
+        SleepMs(20);
+        inFrame = false;
+        return true;
+    }));
+    while (!entered.load()) SleepMs(1);
+    loop.Hold();
+    CHECK(!inFrame.load());
+    loop.Release();
+    loop.Stop();
+}
+
+static void TestStopOverridesHold()
+{
+    std::atomic<long long> frames{ 0 };
+    DaroRenderLoop loop;
+    CHECK(loop.Start(kRate, [&] { frames++; return true; }));
+    SleepMs(20);
+    loop.Hold();
+
+    auto start = std::chrono::steady_clock::now();
+    loop.Stop();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    CHECK(!loop.IsRunning());
+    CHECK(elapsed < std::chrono::seconds(1));
+
+    // The hold is still outstanding when the loop starts again
+    long long before = frames.load();
+    CHECK(loop.Start(kRate, [&] { frames++; return true; }));
+    SleepMs(50);
+    CHECK_EQ(frames.load(), before);
+    loop.Release();
+    SleepMs(50);
+    CHECK(frames.load() > before);
+    loop.Stop();
+}
+
+static void TestSetRate()
+{
+    std::atomic<long long> frames{ 0 };
+    DaroRenderLoop loop;
+    CHECK(!loop.SetRate({ 0, 1 }));
+    CHECK(loop.Start({ 10, 1 }, [&] { frames++; return true; }));
+    SleepMs(150);
+
+    // At 10 fps 300 ms hold at most four frames; at 200 fps about sixty
+    CHECK(loop.SetRate(kRate));
+    SleepMs(120);      // Past the deadline already scheduled on the 10 fps grid
+    long long before = frames.load();
+    SleepMs(300);
+    CHECK(frames.load() - before > 20);
+
+    DaroRenderLoopStats stats = {};
+    loop.GetStats(&stats);
+    CHECK(stats.fps == 200.0);
+    loop.Stop();
+}
+
+static void TestPreviewCannotInterleave()
+{
+    // RenderLoopFrame (DaroEngine.cpp) renders the program, presents, then renders the
+    // preview slot into the same render target. A host touching the device under
+    // Daro_LockRenderLoop (its own Daro_Render, Daro_EnablePreviewOutput replacing the
+    // preview target) must never land between those steps.
+    std::atomic<int> users{ 0 };
+    std::atomic<int> overlaps{ 0 };
+    std::atomic<long long> previews{ 0 };
+    auto use = [&](int ms) {
+        if (users.fetch_add(1) != 0) overlaps++;
+        SleepMs(ms);
+        users--;
+    };
+    DaroRenderLoop loop;
+    CHECK(loop.Start(kRate, [&] {
+        use(1);         // Daro_Render
+        use(0);         // Daro_Present
+        use(1);         // RenderPreview
+        previews++;
+        return true;
+    }));
+    for (int i = 0; i < 50; i++)
+    {
+        loop.Hold();
+        use(1);
+        loop.Release();
+        SleepMs(1);
+    }
+    loop.Stop();
+    CHECK(previews.load() > 0);
+    CHECK_EQ(overlaps.load(), 0);
+}
+
+int main()
+{
+    TestHoldAcrossThreads();
+    TestHoldWaitsForFrame();
+    TestStopOverridesHold();
+    TestSetRate();
+    TestPreviewCannotInterleave();
+    return DaroTestResult("TestRenderLoop");
+}
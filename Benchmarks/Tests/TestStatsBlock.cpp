@@ -0,0 +1,106 @@
+// Benchmarks/Tests/TestStatsBlock.cpp
+// Stats block: snapshots published on the interval reach a reader intact, a second
+// publisher cannot take over a live name, an older publisher's shorter snapshot is
+// zero-extended, and a stopped publisher is reported lost.
+#include "DaroTest.h"
+#include "StatsBlock.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+// Every field derived from one counter, so a snapshot mixing two publishes shows up
+static void Gather(DaroStatsSnapshot* snapshot, std::atomic<int64_t>& counter)
+{
+    int64_t n = ++counter;
+    snapshot->frameNumber = n;
+    snapshot->droppedFrames = n * 3;
+    snapshot->fps = (double)n;
+    snapshot->spoutOutput.sentFrames = n * 5;
+    snapshot->videoCount = 1;
+    snapshot->videos[0].videoId = (int32_t)n;
+    snapshot->videos[DARO_STATS_MAX_VIDEOS - 1].currentFrame = (int32_t)(n * 7);
+}
+
+static bool IsConsistent(const DaroStatsSnapshot& s)
+{
+    int64_t n = s.frameNumber;
+    return s.droppedFrames == n * 3 && s.fps == (double)n && s.spoutOutput.sentFrames == n * 5 &&
+           s.videos[0].videoId == (int32_t)n && s.videos[DARO_STATS_MAX_VIDEOS - 1].currentFrame == (int32_t)(n * 7);
+}
+
+static void TestPublishAndRead(const std::string& name)
+{
+    std::atomic<int64_t> counter{ 0 };
+    DaroStatsPublisher publisher;
+    CHECK(publisher.Start(name.c_str(), 1, [&](DaroStatsSnapshot* s) { Gather(s, counter); }));
+
+    DaroStatsPublisher second;
+    CHECK(!second.Start(name.c_str(), 1, [&](DaroStatsSnapshot* s) { Gather(s, counter); }));
+
+    DaroStatsReader reader;
+    CHECK(reader.Open(name.c_str()));
+    CHECK_EQ(reader.GetIntervalMs(), 1);
+    CHECK_EQ(reader.GetProcessId(), getpid());
+
+    // Read continuously while the publisher runs every millisecond
+    int64_t reads = 0, torn = 0, lastCount = 0, backwards = 0;
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+    while (std::chrono::steady_clock::now() < until)
+    {
+        DaroStatsSnapshot s;
+        if (!reader.Read(&s)) continue;
+        reads++;
+        if (!IsConsistent(s)) torn++;
+        if ((int64_t)s.publishCount < lastCount) backwards++;
+        lastCount = (int64_t)s.publishCount;
+    }
+    CHECK(reads > 0);
+    CHECK(lastCount > 10);
+    CHECK_EQ(torn, 0);
+    CHECK_EQ(backwards, 0);
+    CHECK(!reader.IsPublisherLost());
+
+    publisher.Stop();
+    CHECK(reader.IsPublisherLost());
+    DaroStatsSnapshot s;
+    CHECK(!reader.Read(&s));
+}
+
+static void TestOlderPublisher(const std::string& name)
+{
+    std::atomic<int64_t> counter{ 0 };
+    DaroStatsPublisher publisher;
+    CHECK(publisher.Start(name.c_str(), 1, [&](DaroStatsSnapshot* s) { Gather(s, counter); }));
+
+    // Pretend the publisher predates the video table
+    DaroSharedMemory raw;
+    CHECK(raw.Open(name.c_str()));
+    auto* header = static_cast<DaroStatsHeader*>(raw.Data());
+    header->snapshotSize = (uint32_t)offsetof(DaroStatsSnapshot, videoCount);
+
+    DaroStatsReader reader;
+    CHECK(reader.Open(name.c_str()));
+    DaroStatsSnapshot s;
+    bool read = false;
+    for (int i = 0; i < 200 && !read; i++)
+    {
+        read = reader.Read(&s);
+        if (!read) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(read);
+    CHECK(s.frameNumber > 0);
+    CHECK_EQ(s.spoutOutput.sentFrames, s.frameNumber * 5);
+    CHECK_EQ(s.videoCount, 0);
+    CHECK_EQ(s.videos[0].videoId, 0);
+}
+
+int main()
+{
+    std::string pid = std::to_string((long long)getpid());
+    TestPublishAndRead("DaroTestStats_" + pid);
+    TestOlderPublisher("DaroTestStatsOld_" + pid);
+    return DaroTestResult("TestStatsBlock");
+}
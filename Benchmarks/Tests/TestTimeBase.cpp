@@ -0,0 +1,134 @@
+// Benchmarks/Tests/TestTimeBase.cpp
+// Rational time base: frame and time conversions do not drift over many hours at NTSC
+// rates, and timecode round-trips through every frame of a day, with and without
+// drop-frame numbering.
+#include "DaroTest.h"
+#include "TimeBase.h"
+#include <cstdint>
+#include <initializer_list>
+
+static const DaroRational k2997 = { 30000, 1001 };
+static const DaroRational k5994 = { 60000, 1001 };
+static const DaroRational k25 = { 25, 1 };
+
+static uint32_t Timecode(int hh, int mm, int ss, int ff)
+{
+    return ((uint32_t)hh << 24) | ((uint32_t)mm << 16) | ((uint32_t)ss << 8) | (uint32_t)ff;
+}
+
+static void TestRates()
+{
+    DaroRational r = DaroRationalFromFps(59.94);
+    CHECK_EQ(r.num, 60000);
+    CHECK_EQ(r.den, 1001);
+    r = DaroRationalFromFps(23.976);
+    CHECK_EQ(r.num, 24000);
+    CHECK_EQ(r.den, 1001);
+    r = DaroRationalFromFps(50.0);
+    CHECK_EQ(r.num, 50);
+    CHECK_EQ(r.den, 1);
+    r = DaroMakeRational(120000, 2002);
+    CHECK_EQ(r.num, 60000);
+    CHECK_EQ(r.den, 1001);
+    CHECK(!DaroRationalIsValid(DaroRationalFromFps(0.0)));
+}
+
+static void TestNoDrift()
+{
+    // Every rate.num frames end exactly rate.den seconds later, 30 hours in
+    for (DaroRational rate : { k2997, k5994, k25, DaroRational{ 24000, 1001 } })
+    {
+        int64_t blocks = 30 * 3600 / rate.den;
+        int64_t frame = blocks * rate.num;
+        CHECK_EQ(DaroFrameToNs(frame, rate), blocks * rate.den * DARO_NS_PER_SECOND);
+        CHECK_EQ(DaroNsToFrame(blocks * rate.den * DARO_NS_PER_SECOND, rate), frame);
+    }
+
+    // Around ten hours at 59.94 every frame start maps back to its frame, the nanosecond
+    // before it to the previous one, and no period is off by more than the rounding
+    int64_t first = DaroNsToFrame(10 * 3600 * DARO_NS_PER_SECOND, k5994);
+    for (int64_t frame = first; frame < first + 100000; frame++)
+    {
+        int64_t ns = DaroFrameToNs(frame, k5994);
+        if (DaroNsToFrame(ns, k5994) != frame || DaroNsToFrame(ns - 1, k5994) != frame - 1)
+        {
+            CHECK_EQ(DaroNsToFrame(ns, k5994), frame);
+            break;
+        }
+        int64_t period = DaroFrameToNs(frame + 1, k5994) - ns;
+        if (period != 16683333 && period != 16683334)
+        {
+            CHECK_EQ(period, 16683333);
+            break;
+        }
+    }
+
+    // The nearest frame to a rounded 100 ns timestamp
+    int64_t frame = 12 * 3600 * 60;
+    int64_t rounded = DaroFrameToNs(frame, k5994) / 100 * 100;
+    CHECK_EQ(DaroNsToNearestFrame(rounded, k5994), frame);
+
+    // Float seconds an hour in land on the frame with the seek tolerance
+    int64_t hourFrame = DaroNsToFrame(3600 * DARO_NS_PER_SECOND, k2997) + 7;
+    float seconds = (float)((double)DaroFrameToNs(hourFrame, k2997) / 1e9);
+    CHECK_EQ(DaroSecondsToFrame(seconds, k2997, 1000000), hourFrame);
+}
+
+static void TestTimecodeRoundTrip(DaroRational rate, bool dropFrame)
+{
+    int64_t day = DaroTimecodeDayFrames(rate, dropFrame);
+    int64_t failures = 0;
+    uint32_t previous = 0;
+    for (int64_t frame = 0; frame < day; frame++)
+    {
+        uint32_t timecode = DaroFrameToTimecode((uint64_t)frame, rate, dropFrame);
+        if (DaroTimecodeToFrame(timecode, rate, dropFrame) != frame) failures++;
+        // Labels only move forward within a day
+        if (frame > 0 && (timecode & ~DARO_TIMECODE_DROP_FRAME) <= (previous & ~DARO_TIMECODE_DROP_FRAME)) failures++;
+        previous = timecode;
+    }
+    CHECK_EQ(failures, 0);
+    // The day wraps to zero
+    CHECK_EQ(DaroFrameToTimecode((uint64_t)day, rate, dropFrame) & ~DARO_TIMECODE_DROP_FRAME, 0);
+}
+
+static void TestDropFrame()
+{
+    CHECK_EQ(DaroTimecodeDayFrames(k2997, true), 2589408);
+    CHECK_EQ(DaroTimecodeDayFrames(k2997, false), 2592000);
+
+    // 29.97 drops ;00 and ;01 at each minute but every tenth
+    uint32_t flag = DARO_TIMECODE_DROP_FRAME;
+    CHECK_EQ(DaroFrameToTimecode(1799, k2997, true), flag | Timecode(0, 0, 59, 29));
+    CHECK_EQ(DaroFrameToTimecode(1800, k2997, true), flag | Timecode(0, 1, 0, 2));
+    CHECK_EQ(DaroFrameToTimecode(17982, k2997, true), flag | Timecode(0, 10, 0, 0));
+    CHECK_EQ(DaroFrameToTimecode(107892, k2997, true), flag | Timecode(1, 0, 0, 0));
+    CHECK_EQ(DaroTimecodeToFrame(Timecode(0, 1, 0, 0), k2997, true), -1);
+    CHECK_EQ(DaroTimecodeToFrame(Timecode(0, 1, 0, 1), k2997, true), -1);
+    CHECK_EQ(DaroTimecodeToFrame(Timecode(0, 10, 0, 0), k2997, true), 17982);
+
+    // 59.94 drops four
+    CHECK_EQ(DaroFrameToTimecode(3600, k5994, true), flag | Timecode(0, 1, 0, 4));
+    CHECK_EQ(DaroTimecodeToFrame(Timecode(0, 1, 0, 3), k5994, true), -1);
+
+    // Drop-frame timecode an hour in is within a frame of real time; without it, 3.6 s behind
+    int64_t hour = DaroNsToFrame(3600 * DARO_NS_PER_SECOND, k2997);
+    CHECK_EQ(DaroFrameToTimecode((uint64_t)hour, k2997, true), flag | Timecode(1, 0, 0, 0));
+    CHECK_EQ(DaroFrameToTimecode((uint64_t)hour, k2997, false), Timecode(0, 59, 56, 12));
+
+    // Not a drop-frame rate: the flag is ignored
+    CHECK_EQ(DaroFrameToTimecode(1800, k25, true), Timecode(0, 1, 12, 0));
+
+    TestTimecodeRoundTrip(k2997, true);
+    TestTimecodeRoundTrip(k2997, false);
+    TestTimecodeRoundTrip(k5994, true);
+    TestTimecodeRoundTrip(k25, false);
+}
+
+int main()
+{
+    TestRates();
+    TestNoDrift();
+    TestDropFrame();
+    return DaroTestResult("TestTimeBase");
+}
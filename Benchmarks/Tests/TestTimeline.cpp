@@ -0,0 +1,205 @@
+// Benchmarks/Tests/TestTimeline.cpp
+// Timeline markers: playback holds exactly on a stop marker and Continue resumes from the
+// frame after it, a loop marker wraps to its target on every pass until continued, a
+// jump lands on its target, and markers on frame 0 and on the last frame behave the same
+// way (a continued marker on the last frame ends playback there).
+#include "DaroTest.h"
+#include "Timeline.h"
+#include <initializer_list>
+#include <vector>
+
+// Frames shown by the next count output frames
+static std::vector<int> Run(DaroTimeline& timeline, int count)
+{
+    std::vector<int> frames;
+    for (int i = 0; i < count; i++) frames.push_back(timeline.Tick(nullptr, 0));
+    return frames;
+}
+
+static bool Shows(const std::vector<int>& frames, std::initializer_list<int> expected)
+{
+    return frames == std::vector<int>(expected);
+}
+
+static DaroTimelineState State(const DaroTimeline& timeline)
+{
+    DaroTimelineState state;
+    timeline.GetState(&state);
+    return state;
+}
+
+static void TestStop()
+{
+    DaroTimeline timeline;
+    CHECK(timeline.SetLength(20));
+    DaroTimelineMarker stop = { 3, DARO_MARKER_STOP, 0 };
+    CHECK(timeline.SetMarkers(&stop, 1));
+    timeline.Play();
+
+    // Holds on the stop frame, not before or after it
+    CHECK(Shows(Run(timeline, 6), { 0, 1, 2, 3, 3, 3 }));
+    CHECK_EQ(State(timeline).held, 1);
+    CHECK(timeline.IsPlaying());
+
+    timeline.Continue();
+    CHECK_EQ(State(timeline).held, 0);
+    CHECK(Shows(Run(timeline, 3), { 4, 5, 6 }));
+
+    // A continue given before the stop is reached passes it once
+    timeline.Seek(1);
+    timeline.Continue();
+    CHECK_EQ(State(timeline).continuePending, 1);
+    CHECK(Shows(Run(timeline, 4), { 1, 2, 3, 4 }));
+    CHECK_EQ(State(timeline).continuePending, 0);
+    timeline.Seek(2);
+    CHECK(Shows(Run(timeline, 3), { 2, 3, 3 }));
+
+    // Stopped on the marker, Continue still moves the playhead for the next Play
+    timeline.Stop();
+    timeline.Continue();
+    CHECK_EQ(timeline.Frame(), 4);
+    CHECK(Shows(Run(timeline, 2), { 4, 4 }));
+}
+
+static void TestLoop()
+{
+    DaroTimeline timeline;
+    CHECK(timeline.SetLength(20));
+    DaroTimelineMarker loop = { 5, DARO_MARKER_LOOP, 2 };
+    CHECK(timeline.SetMarkers(&loop, 1));
+    timeline.Play();
+
+    // Every pass wraps to the loop start after the loop frame
+    CHECK(Shows(Run(timeline, 12), { 0, 1, 2, 3, 4, 5, 2, 3, 4, 5, 2, 3 }));
+    DaroTimelineState state = State(timeline);
+    CHECK_EQ(state.loops, 2);
+    CHECK_EQ(state.looping, 1);
+
+    // Continue inside the region goes to the frame after the loop marker
+    timeline.Continue();
+    CHECK(Shows(Run(timeline, 3), { 6, 7, 8 }));
+    CHECK_EQ(State(timeline).looping, 0);
+    CHECK_EQ(State(timeline).loops, 2);
+
+    // Continued before the region: one pass straight through, then it loops again
+    timeline.Seek(0);
+    timeline.Continue();
+    CHECK(Shows(Run(timeline, 7), { 0, 1, 2, 3, 4, 5, 6 }));
+    timeline.Seek(4);
+    CHECK(Shows(Run(timeline, 3), { 4, 5, 2 }));
+}
+
+static void TestJump()
+{
+    DaroTimeline timeline;
+    CHECK(timeline.SetLength(30));
+    DaroTimelineMarker markers[2] = { { 4, DARO_MARKER_JUMP, 20 }, { 22, DARO_MARKER_JUMP, 1 } };
+    CHECK(timeline.SetMarkers(markers, 2));
+    timeline.Play();
+    CHECK(Shows(Run(timeline, 10), { 0, 1, 2, 3, 4, 20, 21, 22, 1, 2 }));
+    // A jump is not held by Continue state and not counted as a loop
+    CHECK_EQ(State(timeline).loops, 0);
+    CHECK_EQ(State(timeline).continuePending, 0);
+}
+
+static void TestFirstFrame()
+{
+    DaroTimeline timeline;
+    CHECK(timeline.SetLength(10));
+
+    // A stop on frame 0 holds playback on its first frame
+    DaroTimelineMarker stop = { 0, DARO_MARKER_STOP, 0 };
+    CHECK(timeline.SetMarkers(&stop, 1));
+    timeline.Play();
+    CHECK(Shows(Run(timeline, 3), { 0, 0, 0 }));
+    timeline.Continue();
+    CHECK(Shows(Run(timeline, 2), { 1, 2 }));
+
+    // A loop on frame 0 onto itself repeats the frame until continued
+    DaroTimelineMarker loop = { 0, DARO_MARKER_LOOP, 0 };
+    CHECK(timeline.SetMarkers(&loop, 1));
+    timeline.Seek(0);
+    CHECK(Shows(Run(timeline, 3), { 0, 0, 0 }));
+    CHECK_EQ(State(timeline).loops, 3);
+    timeline.Continue();
+    CHECK(Shows(Run(timeline, 2), { 1, 2 }));
+
+    // A jump on frame 0
+    DaroTimelineMarker jump = { 0, DARO_MARKER_JUMP, 7 };
+    CHECK(timeline.SetMarkers(&jump, 1));
+    timeline.Seek(0);
+    CHECK(Shows(Run(timeline, 3), { 0, 7, 8 }));
+}
+
+static void TestLastFrame()
+{
+    DaroTimeline timeline;
+    CHECK(timeline.SetLength(10));
+
+    // Without a marker the timeline stops on its last frame
+    timeline.Play();
+    CHECK(Shows(Run(timeline, 12), { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 9, 9 }));
+    CHECK(!timeline.IsPlaying());
+
+    // A stop on the last frame holds; continuing ends playback there
+    DaroTimelineMarker stop = { 9, DARO_MARKER_STOP, 0 };
+    CHECK(timeline.SetMarkers(&stop, 1));
+    timeline.Seek(8);
+    timeline.Play();
+    CHECK(Shows(Run(timeline, 3), { 8, 9, 9 }));
+    CHECK(timeline.IsPlaying());
+    CHECK_EQ(State(timeline).held, 1);
+    timeline.Continue();
+    CHECK(!timeline.IsPlaying());
+    CHECK(Shows(Run(timeline, 2), { 9, 9 }));
+
+    // A loop ending on the last frame wraps; continuing ends playback on the last frame
+    DaroTimelineMarker loop = { 9, DARO_MARKER_LOOP, 7 };
+    CHECK(timeline.SetMarkers(&loop, 1));
+    timeline.Seek(7);
+    timeline.Play();
+    CHECK(Shows(Run(timeline, 5), { 7, 8, 9, 7, 8 }));
+    timeline.Continue();
+    CHECK(!timeline.IsPlaying());
+    CHECK(Shows(Run(timeline, 2), { 9, 9 }));
+
+    // A jump on the last frame goes back
+    DaroTimelineMarker jump = { 9, DARO_MARKER_JUMP, 0 };
+    CHECK(timeline.SetMarkers(&jump, 1));
+    timeline.Seek(8);
+    timeline.Play();
+    CHECK(Shows(Run(timeline, 4), { 8, 9, 0, 1 }));
+    CHECK(timeline.IsPlaying());
+}
+
+static void TestMarkerValidation()
+{
+    DaroTimeline timeline;
+    CHECK(timeline.SetLength(10));
+    DaroTimelineMarker outside = { 10, DARO_MARKER_STOP, 0 };
+    CHECK(!timeline.SetMarkers(&outside, 1));
+    DaroTimelineMarker twice[2] = { { 3, DARO_MARKER_STOP, 0 }, { 3, DARO_MARKER_JUMP, 0 } };
+    CHECK(!timeline.SetMarkers(twice, 2));
+    DaroTimelineMarker forward = { 3, DARO_MARKER_LOOP, 5 };
+    CHECK(!timeline.SetMarkers(&forward, 1));
+    DaroTimelineMarker target = { 3, DARO_MARKER_JUMP, 10 };
+    CHECK(!timeline.SetMarkers(&target, 1));
+
+    // Given out of order, looked up by frame
+    DaroTimelineMarker unsorted[2] = { { 6, DARO_MARKER_STOP, 0 }, { 2, DARO_MARKER_JUMP, 5 } };
+    CHECK(timeline.SetMarkers(unsorted, 2));
+    CHECK_EQ(State(timeline).markerCount, 2);
+    timeline.Play();
+    CHECK(Shows(Run(timeline, 6), { 0, 1, 2, 5, 6, 6 }));
+}
+
+int main()
+{
+    TestStop();
+    TestLoop();
+    TestJump();
+    TestFirstFrame();
+    TestLastFrame();
+    TestMarkerValidation();
+    return DaroTestResult("TestTimeline");
+}
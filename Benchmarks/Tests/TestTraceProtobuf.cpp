@@ -0,0 +1,112 @@
+// Benchmarks/Tests/TestTraceProtobuf.cpp
+// Perfetto trace encoding: the process and thread track descriptors and a slice
+// begin/end pair encode to the exact TracePacket bytes of perfetto.protos.Trace, with
+// multi-byte varints for 64-bit track uuids, timestamps and long names.
+#include "DaroTest.h"
+#include "TraceProtobuf.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static void CheckBytes(const char* what, const std::string& actual, const std::vector<unsigned char>& expected)
+{
+    bool same = actual.size() == expected.size();
+    for (size_t i = 0; same && i < expected.size(); i++) same = (unsigned char)actual[i] == expected[i];
+    if (!same)
+    {
+        std::fprintf(stderr, "%s:", what);
+        for (char c : actual) std::fprintf(stderr, " %02X", (unsigned char)c);
+        std::fprintf(stderr, "\n");
+    }
+    CHECK(same);
+}
+
+static const unsigned long long PROCESS = 7ull << 32;
+static const unsigned long long THREAD = PROCESS | 42;
+
+static void TestProcessTrack()
+{
+    std::string out;
+    DaroPerfettoProcessTrack(out, PROCESS, 7, "Daro");
+    CheckBytes("process track", out, {
+        0x0A, 0x17,                                 // Trace.packet, 23 bytes
+        0x50, 0x01,                                 //   trusted_packet_sequence_id 1
+        0x68, 0x01,                                 //   sequence_flags INCREMENTAL_STATE_CLEARED
+        0xE2, 0x03, 0x10,                           //   track_descriptor (60), 16 bytes
+        0x08, 0x80, 0x80, 0x80, 0x80, 0x70,         //     uuid 7 << 32
+        0x1A, 0x08,                                 //     process, 8 bytes
+        0x08, 0x07,                                 //       pid 7
+        0x32, 0x04, 'D', 'a', 'r', 'o',             //       process_name
+    });
+}
+
+static void TestThreadTrack()
+{
+    std::string out;
+    DaroPerfettoThreadTrack(out, THREAD, PROCESS, 7, 42, "Render");
+    CheckBytes("thread track", out, {
+        0x0A, 0x1F,                                 // Trace.packet, 31 bytes
+        0x50, 0x01,                                 //   trusted_packet_sequence_id 1
+        0xE2, 0x03, 0x1A,                           //   track_descriptor, 26 bytes
+        0x08, 0xAA, 0x80, 0x80, 0x80, 0x70,         //     uuid (7 << 32) | 42
+        0x28, 0x80, 0x80, 0x80, 0x80, 0x70,         //     parent_uuid 7 << 32
+        0x22, 0x0C,                                 //     thread, 12 bytes
+        0x08, 0x07,                                 //       pid 7
+        0x10, 0x2A,                                 //       tid 42
+        0x2A, 0x06, 'R', 'e', 'n', 'd', 'e', 'r',   //       thread_name
+    });
+
+    // An unnamed thread has no thread_name field
+    out.clear();
+    DaroPerfettoThreadTrack(out, THREAD, PROCESS, 7, 42, nullptr);
+    CHECK_EQ(out.size(), 33 - 8);
+    CHECK_EQ((unsigned char)out[1], 0x1F - 8);
+}
+
+static void TestSlice()
+{
+    std::string out;
+    DaroPerfettoSlice(out, 1000000, THREAD, DARO_PERFETTO_SLICE_BEGIN, "Frame");
+    CheckBytes("slice begin", out, {
+        0x0A, 0x18,                                 // Trace.packet, 24 bytes
+        0x40, 0xC0, 0x84, 0x3D,                     //   timestamp 1000000
+        0x50, 0x01,                                 //   trusted_packet_sequence_id 1
+        0x5A, 0x10,                                 //   track_event, 16 bytes
+        0x48, 0x01,                                 //     type SLICE_BEGIN
+        0x58, 0xAA, 0x80, 0x80, 0x80, 0x70,         //     track_uuid
+        0xBA, 0x01, 0x05, 'F', 'r', 'a', 'm', 'e',  //     name (23)
+    });
+
+    out.clear();
+    DaroPerfettoSlice(out, 2000000, THREAD, DARO_PERFETTO_SLICE_END, nullptr);
+    CheckBytes("slice end", out, {
+        0x0A, 0x10,                                 // Trace.packet, 16 bytes
+        0x40, 0x80, 0x89, 0x7A,                     //   timestamp 2000000
+        0x50, 0x01,                                 //   trusted_packet_sequence_id 1
+        0x5A, 0x08,                                 //   track_event, 8 bytes
+        0x48, 0x02,                                 //     type SLICE_END
+        0x58, 0xAA, 0x80, 0x80, 0x80, 0x70,         //     track_uuid
+    });
+
+    // Packets append; a 200 byte name takes a two-byte length, as does the packet
+    std::string name(200, 'n');
+    size_t before = out.size();
+    DaroPerfettoSlice(out, 0, 1, DARO_PERFETTO_SLICE_BEGIN, name.c_str());
+    std::string packet = out.substr(before);
+    // 0x40 0x00, 0x50 0x01, 0x5A len(2) { 0x48 0x01, 0x58 0x01, 0xBA 0x01 len(2) name }
+    size_t event = 2 + 2 + 2 + 2 + name.size();
+    size_t body = 2 + 2 + 1 + 2 + event;
+    CHECK_EQ(packet.size(), 1 + 2 + body);
+    CHECK_EQ((unsigned char)packet[0], 0x0A);
+    CHECK_EQ((unsigned char)packet[1], (body & 0x7F) | 0x80);
+    CHECK_EQ((unsigned char)packet[2], body >> 7);
+    CHECK(packet.compare(packet.size() - name.size(), name.size(), name) == 0);
+}
+
+int main()
+{
+    TestProcessTrack();
+    TestThreadTrack();
+    TestSlice();
+    return DaroTestResult("TestTraceProtobuf");
+}
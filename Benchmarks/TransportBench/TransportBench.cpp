@@ -0,0 +1,465 @@
+// Benchmarks/TransportBench/TransportBench.cpp
+// Two-process throughput of the portable frame transport (FrameTransport.h). The benchmark
+// publishes frames at the output cadence from this process and starts a copy of itself as
+// the receiver, which polls ReceiveFrame the way an ingest or QC tool would. The run
+// sustains the format when the sender never misses a frame slot and the receiver gets
+// every frame intact: no drops, no corrupt frames.
+//
+// The receiver reports back through a small shared control block, so nothing but the
+// transport itself crosses the process boundary while frames are flowing.
+//
+//   TransportBench [--width W] [--height H] [--fps F] [--seconds S] [--format bgra|rgba]
+//                  [--label TEXT] [--out FILE]
+#define NOMINMAX
+#include "FrameTransport.h"
+#include "SharedMemory.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+#define TRANSPORTBENCH_SCHEMA 1
+#define TRANSPORTBENCH_CONTROL_SUFFIX "_Control"
+
+struct BenchOptions
+{
+    int width = 3840;
+    int height = 2160;
+    int fps = 60;
+    double seconds = 10.0;
+    uint32_t format = DARO_PIXEL_BGRA8;
+    std::string label;
+    std::string out;
+};
+
+// Shared between the two processes; the sender creates it, the receiver fills in the results
+struct BenchControl
+{
+    std::atomic<uint32_t> ready;            // Receiver connected
+    std::atomic<uint32_t> stop;             // Sender finished publishing
+    std::atomic<uint32_t> done;             // Results below are valid
+    uint32_t reserved;
+    uint64_t received;
+    uint64_t dropped;
+    uint64_t torn;
+    uint64_t corrupt;
+    double latencyMs[5];                    // mean, p50, p95, p99, max
+    double receiveMs[5];
+};
+
+// ============== Statistics ==============
+
+struct Percentiles
+{
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+static Percentiles Summarize(std::vector<double> values)
+{
+    Percentiles result;
+    if (values.empty()) return result;
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    auto rank = [&](double p) { return values[(size_t)(p * (values.size() - 1) + 0.5)]; };
+    result.mean = sum / values.size();
+    result.p50 = rank(0.50);
+    result.p95 = rank(0.95);
+    result.p99 = rank(0.99);
+    result.max = values.back();
+    return result;
+}
+
+static void StorePercentiles(double* dst, const Percentiles& p)
+{
+    dst[0] = p.mean; dst[1] = p.p50; dst[2] = p.p95; dst[3] = p.p99; dst[4] = p.max;
+}
+
+static Percentiles LoadPercentiles(const double* src)
+{
+    Percentiles p;
+    p.mean = src[0]; p.p50 = src[1]; p.p95 = src[2]; p.p99 = src[3]; p.max = src[4];
+    return p;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+static double ElapsedMs(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// Each frame carries its number in the first and last 8 bytes, so the receiver can tell
+// a frame assembled from two publishes from an intact one
+static void StampFrame(uint8_t* pixels, size_t bytes, uint64_t frameNumber)
+{
+    memcpy(pixels, &frameNumber, sizeof(frameNumber));
+    memcpy(pixels + bytes - sizeof(frameNumber), &frameNumber, sizeof(frameNumber));
+}
+
+static bool CheckFrame(const uint8_t* pixels, size_t bytes, uint64_t frameNumber)
+{
+    uint64_t first, last;
+    memcpy(&first, pixels, sizeof(first));
+    memcpy(&last, pixels + bytes - sizeof(last), sizeof(last));
+    return first == frameNumber && last == frameNumber;
+}
+
+// ============== Receiver process ==============
+
+static int RunReceiver(const std::string& name)
+{
+    DaroSharedMemory controlMemory;
+    if (!controlMemory.Open((name + TRANSPORTBENCH_CONTROL_SUFFIX).c_str()) || controlMemory.Size() < sizeof(BenchControl))
+    {
+        fprintf(stderr, "TransportBench: receiver cannot open the control block\n");
+        return 1;
+    }
+    auto* control = static_cast<BenchControl*>(controlMemory.Data());
+
+    DaroFrameReceiver receiver;
+    auto connectDeadline = Clock::now() + std::chrono::seconds(5);
+    while (!receiver.Connect(name.c_str()))
+    {
+        if (Clock::now() > connectDeadline)
+        {
+            fprintf(stderr, "TransportBench: receiver cannot connect to %s\n", name.c_str());
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::vector<uint8_t> frame(receiver.GetFrameBytes());
+    std::vector<double> latencyMs, receiveMs;
+    uint64_t received = 0, corrupt = 0;
+    control->ready.store(1, std::memory_order_release);
+
+    // Drain until the sender is done and the last frame has been picked up
+    bool stopping = false;
+    while (true)
+    {
+        Clock::time_point start = Clock::now();
+        DaroTransportFrameInfo info;
+        if (receiver.ReceiveFrame(frame.data(), frame.size(), &info))
+        {
+            receiveMs.push_back(ElapsedMs(start, Clock::now()));
+            latencyMs.push_back((DaroTransportNowNs() - info.timestampNs) / 1e6);
+            if (!CheckFrame(frame.data(), (size_t)info.stride * info.height, info.frameNumber)) corrupt++;
+            received++;
+            continue;
+        }
+        if (stopping) break;
+        stopping = control->stop.load(std::memory_order_acquire) != 0;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+
+    control->received = received;
+    control->dropped = receiver.GetDroppedFrames();
+    control->torn = receiver.GetTornReads();
+    control->corrupt = corrupt;
+    StorePercentiles(control->latencyMs, Summarize(latencyMs));
+    StorePercentiles(control->receiveMs, Summarize(receiveMs));
+    control->done.store(1, std::memory_order_release);
+    return 0;
+}
+
+// ============== Sender process ==============
+
+struct BenchResult
+{
+    uint64_t published = 0;
+    uint64_t lateTicks = 0;        // Publish finished after its frame slot ended
+    uint64_t received = 0;
+    uint64_t dropped = 0;
+    uint64_t torn = 0;
+    uint64_t corrupt = 0;
+    Percentiles publishMs;
+    Percentiles latencyMs;
+    Percentiles receiveMs;
+    bool sustained = false;
+    std::string error;
+};
+
+#ifdef _WIN32
+typedef HANDLE ChildProcess;
+
+static bool StartReceiver(const char* self, const std::string& name, ChildProcess* child)
+{
+    char path[MAX_PATH];
+    if (!GetModuleFileNameA(nullptr, path, MAX_PATH)) return false;
+    std::string commandLine = std::string("\"") + path + "\" --receive " + name;
+    STARTUPINFOA si = {};
+    si.cb = sizeof(si);
+    PROCESS_INFORMATION pi = {};
+    if (!CreateProcessA(path, &commandLine[0], nullptr, nullptr, FALSE, 0, nullptr, nullptr, &si, &pi))
+        return false;
+    CloseHandle(pi.hThread);
+    *child = pi.hProcess;
+    (void)self;
+    return true;
+}
+
+static bool WaitReceiver(ChildProcess child)
+{
+    WaitForSingleObject(child, INFINITE);
+    DWORD exitCode = 1;
+    GetExitCodeProcess(child, &exitCode);
+    CloseHandle(child);
+    return exitCode == 0;
+}
+
+static uint32_t CurrentProcessId() { return (uint32_t)GetCurrentProcessId(); }
+#else
+typedef pid_t ChildProcess;
+
+static bool StartReceiver(const char* self, const std::string& name, ChildProcess* child)
+{
+    std::string receiveArg = "--receive";
+    char* argv[] = { const_cast<char*>(self), &receiveArg[0], const_cast<char*>(name.c_str()), nullptr };
+    return posix_spawnp(child, self, nullptr, nullptr, argv, environ) == 0;
+}
+
+static bool WaitReceiver(ChildProcess child)
+{
+    int status = 0;
+    if (waitpid(child, &status, 0) != child) return false;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static uint32_t CurrentProcessId() { return (uint32_t)getpid(); }
+#endif
+
+static BenchResult RunSender(const char* self, const BenchOptions& options)
+{
+    BenchResult result;
+    std::string name = "TransportBench_" + std::to_string(CurrentProcessId());
+
+    DaroSharedMemory controlMemory;
+    controlMemory.SetUnlinkOnClose(true);
+    if (controlMemory.Create((name + TRANSPORTBENCH_CONTROL_SUFFIX).c_str(), sizeof(BenchControl)) != DARO_SHM_CREATED)
+    {
+        result.error = "cannot create the control block";
+        return result;
+    }
+    auto* control = static_cast<BenchControl*>(controlMemory.Data());
+
+    DaroFrameSender sender;
+    if (!sender.Create(name.c_str(), (uint32_t)options.width, (uint32_t)options.height, options.format))
+    {
+        result.error = "cannot create the sender";
+        return result;
+    }
+
+    // Two source frames, alternated so every publish reads memory not just written
+    size_t frameBytes = (size_t)options.width * options.height * 4;
+    std::vector<uint8_t> sources[2];
+    for (int i = 0; i < 2; i++)
+    {
+        sources[i].resize(frameBytes);
+        for (size_t b = 0; b < frameBytes; b++) sources[i][b] = (uint8_t)(b * 7 + i);
+    }
+
+    ChildProcess child;
+    if (!StartReceiver(self, name, &child))
+    {
+        result.error = "cannot start the receiver process";
+        return result;
+    }
+    auto readyDeadline = Clock::now() + std::chrono::seconds(10);
+    while (!control->ready.load(std::memory_order_acquire) && Clock::now() < readyDeadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (!control->ready.load(std::memory_order_acquire))
+    {
+        control->stop.store(1, std::memory_order_release);
+        WaitReceiver(child);
+        result.error = "receiver did not connect";
+        return result;
+    }
+
+    uint64_t frames = (uint64_t)(options.seconds * options.fps + 0.5);
+    Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / options.fps));
+    std::vector<double> publishMs;
+    publishMs.reserve((size_t)frames);
+
+    Clock::time_point start = Clock::now() + period;
+    for (uint64_t frame = 0; frame < frames; frame++)
+    {
+        Clock::time_point slot = start + period * (long long)frame;
+        std::this_thread::sleep_until(slot);
+
+        std::vector<uint8_t>& source = sources[frame & 1];
+        StampFrame(source.data(), frameBytes, frame);
+        Clock::time_point before = Clock::now();
+        sender.Publish(source.data(), (uint32_t)options.width * 4, frame, 0, options.format);
+        Clock::time_point after = Clock::now();
+
+        publishMs.push_back(ElapsedMs(before, after));
+        if (after > slot + period) result.lateTicks++;
+        result.published++;
+    }
+
+    // Give the receiver one more period for the last frame, then collect its results
+    std::this_thread::sleep_for(period);
+    control->stop.store(1, std::memory_order_release);
+    bool receiverOk = WaitReceiver(child);
+    if (!receiverOk || !control->done.load(std::memory_order_acquire))
+    {
+        result.error = "receiver failed";
+        return result;
+    }
+
+    result.received = control->received;
+    result.dropped = control->dropped;
+    result.torn = control->torn;
+    result.corrupt = control->corrupt;
+    result.publishMs = Summarize(publishMs);
+    result.latencyMs = LoadPercentiles(control->latencyMs);
+    result.receiveMs = LoadPercentiles(control->receiveMs);
+    result.sustained = result.lateTicks == 0 && result.dropped == 0 && result.corrupt == 0 &&
+                       result.received == result.published;
+    return result;
+}
+
+// ============== JSON ==============
+
+static void WriteEscaped(FILE* f, const std::string& text)
+{
+    fputc('"', f);
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\') { fputc('\\', f); fputc(c, f); }
+        else if ((unsigned char)c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+static void WritePercentiles(FILE* f, const Percentiles& p)
+{
+    fprintf(f, "{\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+        p.mean, p.p50, p.p95, p.p99, p.max);
+}
+
+static void WriteJson(FILE* f, const BenchOptions& options, const BenchResult& r)
+{
+    fprintf(f, "{\n  \"schema\": %d,\n  \"label\": ", TRANSPORTBENCH_SCHEMA);
+    WriteEscaped(f, options.label);
+    fprintf(f, ",\n  \"width\": %d,\n  \"height\": %d,\n  \"fps\": %d,\n  \"format\": \"%s\",\n  \"seconds\": %.3f,",
+        options.width, options.height, options.fps, options.format == DARO_PIXEL_RGBA8 ? "rgba" : "bgra", options.seconds);
+    if (!r.error.empty())
+    {
+        fprintf(f, "\n  \"error\": ");
+        WriteEscaped(f, r.error);
+        fprintf(f, ",");
+    }
+    fprintf(f, "\n  \"sustained\": %s,\n  \"published\": %llu,\n  \"lateTicks\": %llu,\n  \"received\": %llu,"
+               "\n  \"dropped\": %llu,\n  \"tornReads\": %llu,\n  \"corrupt\": %llu,",
+        r.sustained ? "true" : "false", (unsigned long long)r.published, (unsigned long long)r.lateTicks,
+        (unsigned long long)r.received, (unsigned long long)r.dropped, (unsigned long long)r.torn,
+        (unsigned long long)r.corrupt);
+    fprintf(f, "\n  \"publishMs\": ");
+    WritePercentiles(f, r.publishMs);
+    fprintf(f, ",\n  \"receiveMs\": ");
+    WritePercentiles(f, r.receiveMs);
+    fprintf(f, ",\n  \"latencyMs\": ");
+    WritePercentiles(f, r.latencyMs);
+    fprintf(f, "\n}\n");
+}
+
+// ============== Main ==============
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+        "Usage: TransportBench [options]\n"
+        "  --width W            Frame width (default 3840)\n"
+        "  --height H           Frame height (default 2160)\n"
+        "  --fps F              Publish cadence (default 60)\n"
+        "  --seconds S          Measured time (default 10)\n"
+        "  --format bgra|rgba   Sender format (default bgra)\n"
+        "  --label TEXT         Stored in the JSON, e.g. a machine name\n"
+        "  --out FILE           Write JSON to FILE instead of stdout\n"
+        "Exit code 0 when the format is sustained, 1 otherwise.\n");
+}
+
+int main(int argc, char** argv)
+{
+    // Internal: the receiver half, started by the sender
+    if (argc == 3 && strcmp(argv[1], "--receive") == 0)
+        return RunReceiver(argv[2]);
+
+    BenchOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--width" && hasValue) options.width = atoi(argv[++i]);
+        else if (arg == "--height" && hasValue) options.height = atoi(argv[++i]);
+        else if (arg == "--fps" && hasValue) options.fps = atoi(argv[++i]);
+        else if (arg == "--seconds" && hasValue) options.seconds = atof(argv[++i]);
+        else if (arg == "--format" && hasValue)
+        {
+            std::string format = argv[++i];
+            if (format == "bgra") options.format = DARO_PIXEL_BGRA8;
+            else if (format == "rgba") options.format = DARO_PIXEL_RGBA8;
+            else { PrintUsage(); return 2; }
+        }
+        else if (arg == "--label" && hasValue) options.label = argv[++i];
+        else if (arg == "--out" && hasValue) options.out = argv[++i];
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+    if (options.width <= 0 || options.height <= 0 || options.width > 16384 || options.height > 16384 ||
+        options.fps <= 0 || options.seconds <= 0.0)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+#ifdef _WIN32
+    timeBeginPeriod(1);     // 1 ms sleep granularity for frame pacing
+#endif
+    BenchResult result = RunSender(argv[0], options);
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+
+    fprintf(stderr, "TransportBench: %dx%d@%d %s  published %llu  received %llu  dropped %llu  late %llu  publish p99 %.2f ms  latency p99 %.2f ms\n",
+        options.width, options.height, options.fps, result.sustained ? "sustained" : "NOT sustained",
+        (unsigned long long)result.published, (unsigned long long)result.received, (unsigned long long)result.dropped,
+        (unsigned long long)result.lateTicks, result.publishMs.p99, result.latencyMs.p99);
+    if (!result.error.empty()) fprintf(stderr, "TransportBench: %s\n", result.error.c_str());
+
+    FILE* f = stdout;
+    if (!options.out.empty() && !(f = fopen(options.out.c_str(), "w")))
+    {
+        fprintf(stderr, "TransportBench: cannot write %s\n", options.out.c_str());
+        return 1;
+    }
+    WriteJson(f, options, result);
+    if (f != stdout) fclose(f);
+    return result.sustained ? 0 : 1;
+}
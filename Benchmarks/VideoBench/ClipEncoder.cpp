@@ -0,0 +1,230 @@
+// Benchmarks/VideoBench/ClipEncoder.cpp
+#include "ClipEncoder.h"
+#include "FFmpegDecoder.h"     // HAS_FFMPEG
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+static const ClipCodec s_Codecs[] = {
+    // H.264: libx264 in GPL builds, OpenH264 or Media Foundation in LGPL builds
+    { "h264",       "libx264,libopenh264,h264_mf", "yuv420p",      "preset=veryfast", false, false },
+    { "prores4444", "prores_ks",                   "yuva444p10le", "profile=4444",    false, true },
+    { "qtrle",      "qtrle",                       "argb",         "",                false, true },
+    { "hap",        "hap",                         "rgba",         "format=hap_alpha", false, true },
+    { "png",        "png",                         "rgba",         "",                true,  true },
+};
+
+const ClipCodec* GetClipCodecs(int* count)
+{
+    *count = (int)(sizeof(s_Codecs) / sizeof(s_Codecs[0]));
+    return s_Codecs;
+}
+
+#if HAS_FFMPEG
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/dict.h>
+#include <libavutil/error.h>
+#include <libavutil/frame.h>
+#include <libavutil/pixdesc.h>
+#include <libswscale/swscale.h>
+}
+
+const char* FindClipEncoder(const ClipCodec& codec)
+{
+    // Iterate the comma separated list without allocating
+    static thread_local char name[64];
+    const char* p = codec.encoders;
+    while (*p)
+    {
+        const char* end = strchr(p, ',');
+        size_t length = end ? (size_t)(end - p) : strlen(p);
+        if (length < sizeof(name))
+        {
+            memcpy(name, p, length);
+            name[length] = '\0';
+            if (avcodec_find_encoder_by_name(name)) return name;
+        }
+        if (!end) break;
+        p = end + 1;
+    }
+    return nullptr;
+}
+
+// Test pattern in BGRA: scrolling gradients, a bar sweeping across, alpha ramp top to bottom
+static void FillPattern(uint8_t* pixels, int stride, int width, int height, int frame, bool alpha)
+{
+    int barX = (frame * 24) % (width + width / 4) - width / 8;
+    for (int y = 0; y < height; y++)
+    {
+        uint8_t* row = pixels + (size_t)y * stride;
+        uint8_t a = alpha ? (uint8_t)(64 + y * 191 / height) : 0xFF;
+        for (int x = 0; x < width; x++)
+        {
+            bool bar = x >= barX && x < barX + width / 8;
+            row[x * 4 + 0] = bar ? 0xF0 : (uint8_t)(x * 255 / width + frame * 3);
+            row[x * 4 + 1] = bar ? 0xF0 : (uint8_t)(y * 255 / height + frame);
+            row[x * 4 + 2] = bar ? 0x20 : (uint8_t)((x + y) / 8 + frame * 5);
+            row[x * 4 + 3] = a;
+        }
+    }
+}
+
+static std::string AvError(const char* what, int err)
+{
+    char text[AV_ERROR_MAX_STRING_SIZE] = {};
+    av_strerror(err, text, sizeof(text));
+    return std::string(what) + ": " + text;
+}
+
+// Send one frame (nullptr flushes) and write every packet the encoder returns
+static int EncodeAndWrite(AVCodecContext* enc, AVFormatContext* oc, AVStream* stream, AVFrame* frame, AVPacket* packet)
+{
+    int ret = avcodec_send_frame(enc, frame);
+    if (ret < 0) return ret;
+
+    while (true)
+    {
+        ret = avcodec_receive_packet(enc, packet);
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) return 0;
+        if (ret < 0) return ret;
+
+        av_packet_rescale_ts(packet, enc->time_base, stream->time_base);
+        packet->stream_index = stream->index;
+        ret = av_interleaved_write_frame(oc, packet);   // Takes ownership of the packet data
+        if (ret < 0) return ret;
+    }
+}
+
+std::string EncodeClip(const ClipCodec& codec, const std::string& dir, int width, int height,
+                       int fps, double seconds, std::string* error)
+{
+    const char* encoderName = FindClipEncoder(codec);
+    const AVCodec* encoder = encoderName ? avcodec_find_encoder_by_name(encoderName) : nullptr;
+    AVPixelFormat pixelFormat = av_get_pix_fmt(codec.pixelFormat);
+    if (!encoder || pixelFormat == AV_PIX_FMT_NONE)
+    {
+        *error = std::string("no encoder for ") + codec.name;
+        return std::string();
+    }
+
+    std::string base = dir + "/videobench_" + codec.name + "_" + std::to_string(width) + "x" +
+        std::to_string(height) + "_" + std::to_string(fps);
+    std::string path = codec.sequence ? base + "_%05d.png" : base + ".mov";
+    int frameCount = (int)(seconds * fps + 0.5);
+    if (frameCount < 1) frameCount = 1;
+
+    AVFormatContext* oc = nullptr;
+    AVCodecContext* enc = nullptr;
+    AVFrame* source = nullptr;
+    AVFrame* frame = nullptr;
+    AVPacket* packet = nullptr;
+    SwsContext* sws = nullptr;
+    AVDictionary* options = nullptr;
+    bool headerWritten = false;
+    int ret = 0;
+
+    auto fail = [&](const std::string& message) {
+        *error = message;
+        path.clear();
+    };
+
+    do
+    {
+        ret = avformat_alloc_output_context2(&oc, nullptr, codec.sequence ? "image2" : "mov", path.c_str());
+        if (ret < 0 || !oc) { fail(AvError("avformat_alloc_output_context2", ret)); break; }
+
+        AVStream* stream = avformat_new_stream(oc, nullptr);
+        enc = avcodec_alloc_context3(encoder);
+        if (!stream || !enc) { fail("out of memory"); break; }
+
+        enc->width = width;
+        enc->height = height;
+        enc->pix_fmt = pixelFormat;
+        enc->time_base = AVRational{ 1, fps };
+        enc->framerate = AVRational{ fps, 1 };
+        enc->gop_size = fps;
+        enc->bit_rate = (int64_t)width * height * fps / 10;    // ~0.1 bit per pixel, used by H.264 only
+        if (oc->oformat->flags & AVFMT_GLOBALHEADER)
+            enc->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+        // Options an encoder doesn't know are left in the dictionary and ignored
+        if (codec.options[0]) av_dict_parse_string(&options, codec.options, "=", ":", 0);
+        ret = avcodec_open2(enc, encoder, &options);
+        if (ret < 0) { fail(AvError("avcodec_open2", ret)); break; }
+
+        ret = avcodec_parameters_from_context(stream->codecpar, enc);
+        if (ret < 0) { fail(AvError("avcodec_parameters_from_context", ret)); break; }
+        stream->time_base = enc->time_base;
+
+        if (!(oc->oformat->flags & AVFMT_NOFILE))
+        {
+            ret = avio_open(&oc->pb, path.c_str(), AVIO_FLAG_WRITE);
+            if (ret < 0) { fail(AvError("avio_open", ret)); break; }
+        }
+        ret = avformat_write_header(oc, nullptr);
+        if (ret < 0) { fail(AvError("avformat_write_header", ret)); break; }
+        headerWritten = true;
+
+        source = av_frame_alloc();
+        frame = av_frame_alloc();
+        packet = av_packet_alloc();
+        if (!source || !frame || !packet) { fail("out of memory"); break; }
+        source->format = AV_PIX_FMT_BGRA;
+        source->width = width;
+        source->height = height;
+        frame->format = pixelFormat;
+        frame->width = width;
+        frame->height = height;
+        if (av_frame_get_buffer(source, 0) < 0 || av_frame_get_buffer(frame, 0) < 0) { fail("out of memory"); break; }
+
+        sws = sws_getContext(width, height, AV_PIX_FMT_BGRA, width, height, pixelFormat,
+                             SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (!sws) { fail("sws_getContext failed"); break; }
+
+        for (int i = 0; i < frameCount && path.size(); i++)
+        {
+            // The encoder may still hold a reference to the previous frame
+            if (av_frame_make_writable(frame) < 0) { fail("av_frame_make_writable failed"); break; }
+            FillPattern(source->data[0], source->linesize[0], width, height, i, codec.alpha);
+            sws_scale(sws, source->data, source->linesize, 0, height, frame->data, frame->linesize);
+            frame->pts = i;
+
+            ret = EncodeAndWrite(enc, oc, stream, frame, packet);
+            if (ret < 0) fail(AvError("encode", ret));
+        }
+        if (path.empty()) break;
+
+        ret = EncodeAndWrite(enc, oc, stream, nullptr, packet);
+        if (ret < 0) { fail(AvError("encoder flush", ret)); break; }
+    } while (false);
+
+    if (headerWritten)
+    {
+        ret = av_write_trailer(oc);
+        if (ret < 0 && !path.empty()) fail(AvError("av_write_trailer", ret));
+    }
+    if (oc && !(oc->oformat->flags & AVFMT_NOFILE)) avio_closep(&oc->pb);
+    avformat_free_context(oc);
+    sws_freeContext(sws);
+    av_packet_free(&packet);
+    av_frame_free(&frame);
+    av_frame_free(&source);
+    avcodec_free_context(&enc);
+    av_dict_free(&options);
+    return path;
+}
+
+#else // !HAS_FFMPEG
+
+const char* FindClipEncoder(const ClipCodec&) { return nullptr; }
+
+std::string EncodeClip(const ClipCodec&, const std::string&, int, int, int, double, std::string* error)
+{
+    *error = "built without FFmpeg";
+    return std::string();
+}
+
+#endif // HAS_FFMPEG
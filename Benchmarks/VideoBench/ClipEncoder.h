@@ -0,0 +1,29 @@
+// Benchmarks/VideoBench/ClipEncoder.h
+// Test clip generation with the libavcodec encoders the build links against, so the video
+// benchmark needs no media files and no ffmpeg tool. Clips are a moving synthetic pattern
+// (gradients, bars, an alpha ramp for codecs with alpha) - enough to keep the encoders from
+// collapsing to near-empty frames, but not a substitute for real programme material.
+#pragma once
+
+#include <string>
+
+struct ClipCodec
+{
+    const char* name;           // Key used on the command line and in the JSON
+    const char* encoders;       // libavcodec encoder names, comma separated, first available wins
+    const char* pixelFormat;    // Encoder input format (av_get_pix_fmt name)
+    const char* options;        // Encoder private options, "key=value:key=value"
+    bool sequence;              // Image sequence instead of a MOV file
+    bool alpha;                 // Clip carries alpha
+};
+
+// Known codecs in report order
+const ClipCodec* GetClipCodecs(int* count);
+
+// Name of the first encoder in codec.encoders compiled into libavcodec, or nullptr
+const char* FindClipEncoder(const ClipCodec& codec);
+
+// Encode seconds of the test pattern. Returns the path to hand to FFmpegDecoder::Open
+// (a %05d pattern for sequences), or an empty string with *error set.
+std::string EncodeClip(const ClipCodec& codec, const std::string& dir, int width, int height,
+                       int fps, double seconds, std::string* error);
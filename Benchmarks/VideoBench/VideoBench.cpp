@@ -0,0 +1,518 @@
+// Benchmarks/VideoBench/VideoBench.cpp
+// Video pipeline throughput: how many clips of each codec can play at once before frames
+// are late. Generates its own test clips with libavcodec, then for 1..N players runs the
+// engine's FFmpeg path - FFmpegDecoder::DecodeNextFrame (demux, decode, sws_scale to BGRA)
+// followed by the upload copy with the alpha fix (DaroCopyRows into a padded buffer standing
+// in for the mapped texture) - at the output cadence, and reports the sustained stream
+// count, decode and upload times and late frames per codec and resolution.
+//
+// Players are updated one after another on a single thread, as VideoManager::UpdateAll does
+// on the render thread. A frame is late when its player finishes after the frame slot ends;
+// slots that pass entirely while a tick overruns are dropped, like the render loop does.
+// A stream count is sustained when no tick is dropped and at most --max-late percent of
+// frames are late.
+//
+//   VideoBench [--codecs LIST] [--resolutions LIST] [--fps F] [--max-streams N]
+//              [--seconds S] [--max-late PCT] [--clip-seconds S] [--clips DIR]
+//              [--label TEXT] [--out FILE]
+#define NOMINMAX
+#include "ClipEncoder.h"
+#include "FFmpegDecoder.h"
+#include "PixelConvert.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+#define VIDEOBENCH_SCHEMA 1
+
+// Defined in VideoPlayer.cpp and Trace.cpp, which are not compiled in. Tracing is never
+// enabled here, so DARO_TRACE_SCOPE only checks the flag.
+void VideoLog(const char* msg)
+{
+    fputs(msg, stderr);
+}
+
+long long DaroTrace::Now() { return 0; }
+void DaroTrace::Record(const char*, long long, long long) {}
+
+struct BenchOptions
+{
+    std::vector<std::string> codecs;        // Empty = every codec with an encoder
+    std::vector<int> resolutions = { 1080 };  // Heights, 16:9
+    int fps = 50;
+    int maxStreams = 16;
+    double seconds = 5.0;                   // Measured per stream count
+    double warmupSeconds = 0.5;
+    double maxLatePercent = 0.1;            // Step passes at or below this, with no dropped ticks
+    double clipSeconds = 2.0;
+    std::string clips;                      // Empty = temp directory, removed afterwards
+    std::string label;
+    std::string out;
+};
+
+// ============== Statistics ==============
+
+struct Percentiles
+{
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+static Percentiles Summarize(std::vector<double> values)
+{
+    Percentiles result;
+    if (values.empty()) return result;
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    auto rank = [&](double p) { return values[(size_t)(p * (values.size() - 1) + 0.5)]; };
+    result.mean = sum / values.size();
+    result.p50 = rank(0.50);
+    result.p95 = rank(0.95);
+    result.p99 = rank(0.99);
+    result.max = values.back();
+    return result;
+}
+
+typedef std::chrono::steady_clock Clock;
+
+static double ElapsedMs(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// ============== Players ==============
+
+// One clip instance: decoder plus the buffer the frame is uploaded into
+struct BenchPlayer
+{
+    FFmpegDecoder decoder;
+    std::vector<uint8_t> upload;
+    size_t uploadPitch = 0;
+};
+
+// VideoPlayer::UpdateFrame for one frame: decode (looping at the end like a looped clip),
+// then CopyBufferToTexture
+static bool AdvancePlayer(BenchPlayer& player, double* decodeMs, double* uploadMs)
+{
+    Clock::time_point start = Clock::now();
+    bool decoded = player.decoder.DecodeNextFrame();
+    if (!decoded && player.decoder.IsEndOfStream() && player.decoder.SeekToFrame(0))
+        decoded = player.decoder.DecodeNextFrame();
+    Clock::time_point decodedAt = Clock::now();
+    if (!decoded) return false;
+
+    int width = player.decoder.GetWidth();
+    int height = player.decoder.GetHeight();
+    DaroCopyRows(player.decoder.GetFrameData(), player.decoder.GetFrameStride(),
+                 player.upload.data(), player.uploadPitch, (size_t)width * 4, (uint32_t)height,
+                 !player.decoder.HasAlpha());
+
+    *decodeMs = ElapsedMs(start, decodedAt);
+    *uploadMs = ElapsedMs(decodedAt, Clock::now());
+    return true;
+}
+
+struct StepResult
+{
+    int streams = 0;
+    int ticks = 0;
+    long long frames = 0;
+    long long lateFrames = 0;
+    long long droppedTicks = 0;
+    double latePercent = 0.0;
+    Percentiles decodeMs;
+    Percentiles uploadMs;
+    Percentiles tickMs;                     // All players, i.e. the UpdateAll cost
+    std::string error;
+};
+
+static StepResult RunStep(const std::string& clip, int streams, const BenchOptions& options)
+{
+    StepResult result;
+    result.streams = streams;
+
+    std::vector<std::unique_ptr<BenchPlayer>> players;
+    for (int i = 0; i < streams; i++)
+    {
+        auto player = std::make_unique<BenchPlayer>();
+        if (!player->decoder.Open(clip.c_str()))
+        {
+            result.error = "FFmpegDecoder::Open failed";
+            return result;
+        }
+        // Texture RowPitch is typically aligned to 256 bytes
+        player->uploadPitch = ((size_t)player->decoder.GetWidth() * 4 + 255) & ~(size_t)255;
+        player->upload.resize(player->uploadPitch * player->decoder.GetHeight());
+
+        // Stagger start positions so keyframes don't line up across players
+        for (int skip = (i * 7) % 25; skip > 0; skip--)
+            player->decoder.DecodeNextFrame();
+        players.push_back(std::move(player));
+    }
+
+    const Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / options.fps));
+    const int warmupTicks = (int)(options.warmupSeconds * options.fps);
+    const int measuredTicks = (int)(options.seconds * options.fps);
+
+    std::vector<double> decodeMs, uploadMs, tickMs;
+    decodeMs.reserve((size_t)measuredTicks * streams);
+    uploadMs.reserve((size_t)measuredTicks * streams);
+    tickMs.reserve(measuredTicks);
+
+    Clock::time_point slotStart = Clock::now();
+    for (int tick = 0; tick < warmupTicks + measuredTicks; tick++)
+    {
+        bool measured = tick >= warmupTicks;
+        Clock::time_point deadline = slotStart + period;
+
+        for (auto& player : players)
+        {
+            double decode = 0.0, upload = 0.0;
+            if (!AdvancePlayer(*player, &decode, &upload))
+            {
+                result.error = "DecodeNextFrame failed";
+                return result;
+            }
+            if (!measured) continue;
+            decodeMs.push_back(decode);
+            uploadMs.push_back(upload);
+            result.frames++;
+            if (Clock::now() > deadline) result.lateFrames++;
+        }
+
+        Clock::time_point now = Clock::now();
+        if (measured)
+        {
+            tickMs.push_back(ElapsedMs(slotStart, now));
+            result.ticks++;
+        }
+
+        if (now < deadline)
+        {
+            std::this_thread::sleep_until(deadline);
+            slotStart = deadline;
+        }
+        else
+        {
+            // Overran: drop the slots that already passed and start in the current one
+            long long missed = (long long)((now - deadline) / period);
+            if (measured) result.droppedTicks += missed;
+            slotStart = deadline + missed * period;
+        }
+    }
+
+    result.latePercent = result.frames > 0 ? 100.0 * result.lateFrames / result.frames : 0.0;
+    result.decodeMs = Summarize(decodeMs);
+    result.uploadMs = Summarize(uploadMs);
+    result.tickMs = Summarize(tickMs);
+    return result;
+}
+
+struct ClipResult
+{
+    std::string codec;
+    std::string encoder;
+    int width = 0;
+    int height = 0;
+    bool alpha = false;
+    int sustainedStreams = 0;
+    std::string skipped;
+    std::vector<StepResult> steps;
+};
+
+static ClipResult RunClip(const ClipCodec& codec, int height, const std::string& dir, const BenchOptions& options)
+{
+    ClipResult result;
+    result.codec = codec.name;
+    result.height = height;
+    result.width = (height * 16 / 9 + 1) & ~1;
+    result.alpha = codec.alpha;
+
+    const char* encoder = FindClipEncoder(codec);
+    if (!encoder)
+    {
+        result.skipped = "no encoder in this FFmpeg build";
+        return result;
+    }
+    result.encoder = encoder;
+
+    fprintf(stderr, "VideoBench: encoding %s %dx%d with %s...\n", codec.name, result.width, height, encoder);
+    std::string error;
+    std::string clip = EncodeClip(codec, dir, result.width, height, options.fps, options.clipSeconds, &error);
+    if (clip.empty())
+    {
+        result.skipped = error;
+        return result;
+    }
+
+    for (int streams = 1; streams <= options.maxStreams; streams++)
+    {
+        StepResult step = RunStep(clip, streams, options);
+        if (!step.error.empty())
+        {
+            result.skipped = step.error;
+            break;
+        }
+        fprintf(stderr, "VideoBench: %-10s %4dp x%-2d  decode p99 %6.2f ms  upload p99 %5.2f ms  tick p99 %6.2f ms  late %.2f%%\n",
+            codec.name, height, streams, step.decodeMs.p99, step.uploadMs.p99, step.tickMs.p99, step.latePercent);
+
+        // A dropped tick is an output frame that never happened - no tolerance for those
+        bool passed = step.droppedTicks == 0 && step.latePercent <= options.maxLatePercent;
+        result.steps.push_back(step);
+        if (!passed) break;
+        result.sustainedStreams = streams;
+    }
+    return result;
+}
+
+// ============== JSON ==============
+
+static void WriteEscaped(FILE* f, const std::string& text)
+{
+    fputc('"', f);
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\') { fputc('\\', f); fputc(c, f); }
+        else if ((unsigned char)c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+static void WritePercentiles(FILE* f, const Percentiles& p)
+{
+    fprintf(f, "{\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+        p.mean, p.p50, p.p95, p.p99, p.max);
+}
+
+static void WriteJson(FILE* f, const BenchOptions& options, const std::vector<ClipResult>& results)
+{
+    fprintf(f, "{\n  \"schema\": %d,\n  \"label\": ", VIDEOBENCH_SCHEMA);
+    WriteEscaped(f, options.label);
+    fprintf(f, ",\n  \"fps\": %d,\n  \"seconds\": %.3f,\n  \"maxLatePercent\": %.3f,\n  \"clips\": [",
+        options.fps, options.seconds, options.maxLatePercent);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const ClipResult& r = results[i];
+        fprintf(f, "%s\n    {\"codec\": ", i > 0 ? "," : "");
+        WriteEscaped(f, r.codec);
+        fprintf(f, ", \"width\": %d, \"height\": %d, \"alpha\": %s", r.width, r.height, r.alpha ? "true" : "false");
+        if (!r.encoder.empty())
+        {
+            fprintf(f, ", \"encoder\": ");
+            WriteEscaped(f, r.encoder);
+        }
+        if (!r.skipped.empty())
+        {
+            fprintf(f, ", \"skipped\": ");
+            WriteEscaped(f, r.skipped);
+        }
+        fprintf(f, ", \"sustainedStreams\": %d,\n     \"steps\": [", r.sustainedStreams);
+        for (size_t s = 0; s < r.steps.size(); s++)
+        {
+            const StepResult& step = r.steps[s];
+            fprintf(f, "%s\n       {\"streams\": %d, \"ticks\": %d, \"frames\": %lld, \"lateFrames\": %lld, \"droppedTicks\": %lld, \"latePercent\": %.4f,",
+                s > 0 ? "," : "", step.streams, step.ticks, step.frames, step.lateFrames, step.droppedTicks, step.latePercent);
+            fprintf(f, "\n        \"decodeMs\": ");
+            WritePercentiles(f, step.decodeMs);
+            fprintf(f, ",\n        \"uploadMs\": ");
+            WritePercentiles(f, step.uploadMs);
+            fprintf(f, ",\n        \"tickMs\": ");
+            WritePercentiles(f, step.tickMs);
+            fprintf(f, "}");
+        }
+        fprintf(f, "]}");
+    }
+    fprintf(f, "\n  ]\n}\n");
+}
+
+// ============== Main ==============
+
+static void PrintUsage()
+{
+    fprintf(stderr,
+        "Usage: VideoBench [options]\n"
+        "  --codecs LIST        Comma separated (default all with an encoder; see --list)\n"
+        "  --resolutions LIST   Comma separated heights, 16:9 (default 1080)\n"
+        "  --fps F              Output cadence and clip frame rate (default 50)\n"
+        "  --max-streams N      Highest player count tried (default 16)\n"
+        "  --seconds S          Measured time per player count (default 5)\n"
+        "  --max-late PCT       Late frames allowed for a player count to pass (default 0.1);\n"
+        "                       any dropped tick fails the count\n"
+        "  --clip-seconds S     Length of the generated clips, played looped (default 2)\n"
+        "  --clips DIR          Keep generated clips in DIR (default: temp, removed afterwards)\n"
+        "  --label TEXT         Stored in the JSON, e.g. a machine name\n"
+        "  --out FILE           Write JSON to FILE instead of stdout\n"
+        "  --list               List codecs and the encoder each would use\n");
+}
+
+static std::vector<std::string> SplitList(const char* text)
+{
+    std::vector<std::string> items;
+    std::string current;
+    for (const char* p = text; ; p++)
+    {
+        if (*p == ',' || *p == '\0')
+        {
+            if (!current.empty()) items.push_back(current);
+            current.clear();
+            if (*p == '\0') break;
+        }
+        else
+        {
+            current += *p;
+        }
+    }
+    return items;
+}
+
+static std::string TempDir()
+{
+#ifdef _WIN32
+    char path[MAX_PATH];
+    DWORD length = GetTempPathA(MAX_PATH, path);
+    std::string dir = (length > 0 && length < MAX_PATH) ? std::string(path, length - 1) : std::string(".");
+    dir += "\\daro_videobench_" + std::to_string(GetCurrentProcessId());
+    CreateDirectoryA(dir.c_str(), nullptr);
+#else
+    const char* tmp = getenv("TMPDIR");
+    std::string dir = std::string(tmp ? tmp : "/tmp") + "/daro_videobench_XXXXXX";
+    if (!mkdtemp(&dir[0])) dir = ".";
+#endif
+    return dir;
+}
+
+// Generated clips: one file per codec, or a numbered sequence
+static void RemoveClips(const std::string& dir, const BenchOptions& options, const std::vector<ClipResult>& results)
+{
+    for (const ClipResult& r : results)
+    {
+        std::string base = dir + "/videobench_" + r.codec + "_" + std::to_string(r.width) + "x" +
+            std::to_string(r.height) + "_" + std::to_string(options.fps);
+        remove((base + ".mov").c_str());
+        for (int i = 0; ; i++)      // image2 numbers from 1; 0 is tried for other numbering
+        {
+            char name[32];
+            snprintf(name, sizeof(name), "_%05d.png", i);
+            if (remove((base + name).c_str()) != 0 && i > 0) break;
+        }
+    }
+#ifdef _WIN32
+    RemoveDirectoryA(dir.c_str());
+#else
+    remove(dir.c_str());
+#endif
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    int codecCount = 0;
+    const ClipCodec* codecs = GetClipCodecs(&codecCount);
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--codecs" && hasValue) options.codecs = SplitList(argv[++i]);
+        else if (arg == "--resolutions" && hasValue)
+        {
+            options.resolutions.clear();
+            for (const std::string& item : SplitList(argv[++i])) options.resolutions.push_back(atoi(item.c_str()));
+        }
+        else if (arg == "--fps" && hasValue) options.fps = atoi(argv[++i]);
+        else if (arg == "--max-streams" && hasValue) options.maxStreams = atoi(argv[++i]);
+        else if (arg == "--seconds" && hasValue) options.seconds = atof(argv[++i]);
+        else if (arg == "--max-late" && hasValue) options.maxLatePercent = atof(argv[++i]);
+        else if (arg == "--clip-seconds" && hasValue) options.clipSeconds = atof(argv[++i]);
+        else if (arg == "--clips" && hasValue) options.clips = argv[++i];
+        else if (arg == "--label" && hasValue) options.label = argv[++i];
+        else if (arg == "--out" && hasValue) options.out = argv[++i];
+        else if (arg == "--list")
+        {
+            for (int c = 0; c < codecCount; c++)
+            {
+                const char* encoder = FindClipEncoder(codecs[c]);
+                printf("%-12s %s\n", codecs[c].name, encoder ? encoder : "(no encoder in this FFmpeg build)");
+            }
+            return 0;
+        }
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+    bool validResolutions = !options.resolutions.empty();
+    for (int height : options.resolutions) validResolutions = validResolutions && height >= 16;
+    if (options.fps <= 0 || options.maxStreams <= 0 || options.seconds <= 0.0 || options.clipSeconds <= 0.0 || !validResolutions)
+    {
+        PrintUsage();
+        return 2;
+    }
+    if (!FFmpegDecoder::IsAvailable())
+    {
+        fprintf(stderr, "VideoBench: built without FFmpeg headers (run setup-ffmpeg.ps1 and rebuild)\n");
+        return 1;
+    }
+    for (const std::string& name : options.codecs)
+    {
+        bool known = false;
+        for (int c = 0; c < codecCount; c++) known = known || name == codecs[c].name;
+        if (!known)
+        {
+            fprintf(stderr, "VideoBench: unknown codec '%s' (see --list)\n", name.c_str());
+            return 2;
+        }
+    }
+
+#ifdef _WIN32
+    timeBeginPeriod(1);     // 1 ms sleep granularity for frame pacing
+#endif
+
+    std::string dir = options.clips.empty() ? TempDir() : options.clips;
+    std::vector<ClipResult> results;
+    for (int c = 0; c < codecCount; c++)
+    {
+        const ClipCodec& codec = codecs[c];
+        if (!options.codecs.empty() &&
+            std::find(options.codecs.begin(), options.codecs.end(), codec.name) == options.codecs.end())
+            continue;
+        for (int height : options.resolutions)
+            results.push_back(RunClip(codec, height, dir, options));
+    }
+    if (options.clips.empty()) RemoveClips(dir, options, results);
+
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+
+    FILE* f = stdout;
+    if (!options.out.empty() && !(f = fopen(options.out.c_str(), "w")))
+    {
+        fprintf(stderr, "VideoBench: cannot write %s\n", options.out.c_str());
+        return 1;
+    }
+    WriteJson(f, options, results);
+    if (f != stdout) fclose(f);
+    return 0;
+}
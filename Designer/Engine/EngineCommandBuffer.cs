@@ -0,0 +1,189 @@
+// Designer/Engine/EngineCommandBuffer.cs
+using System;
+using System.Buffers.Binary;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace DaroDesigner.Engine
+{
+    /// <summary>
+    /// Builds a binary command buffer for Daro_Submit (layout in SharedTypes.h), so a whole
+    /// playout action reaches the engine in one interop call instead of one per operation.
+    /// Reuse an instance: Reset keeps the allocated buffer.
+    /// </summary>
+    public sealed class DaroCommandBuffer
+    {
+        private const uint MAGIC = 0x444D4344;          // "DCMD"
+        private const ushort VERSION = 1;
+        private const int HEADER_SIZE = 32;
+        private const int RECORD_SIZE = 8;
+
+        // Ops (DARO_OP_* in SharedTypes.h)
+        private const ushort OP_SET_LAYER_COUNT = 1;
+        private const ushort OP_UPDATE_LAYER = 2;
+        private const ushort OP_CLEAR_LAYERS = 3;
+        private const ushort OP_LOAD_TEXTURE = 4;
+        private const ushort OP_UNLOAD_TEXTURE = 5;
+        private const ushort OP_LOAD_VIDEO = 6;
+        private const ushort OP_UNLOAD_VIDEO = 7;
+        private const ushort OP_PLAY_VIDEO = 8;
+        private const ushort OP_PAUSE_VIDEO = 9;
+        private const ushort OP_STOP_VIDEO = 10;
+        private const ushort OP_SEEK_VIDEO = 11;
+        private const ushort OP_SEEK_VIDEO_TIME = 12;
+        private const ushort OP_SET_VIDEO_LOOP = 13;
+        private const ushort OP_SET_VIDEO_ALPHA = 14;
+        private const ushort OP_SET_OUTPUT_METADATA = 15;
+        private const ushort OP_PLAY = 16;
+        private const ushort OP_STOP = 17;
+        private const ushort OP_SEEK_TO_FRAME = 18;
+        private const ushort OP_EDIT_SCENE = 19;
+        private const ushort OP_TAKE_SCENE = 20;
+        private const ushort OP_TRANSITION_SCENE = 21;
+        private const ushort OP_CONTINUE_TIMELINE = 22;
+
+        // Header flag: queue for when/at instead of running at once
+        public const uint QUEUED = 1;
+
+        private static readonly int LayerSize = Marshal.SizeOf<DaroLayerNative>();
+        private static readonly int TransitionSize = Marshal.SizeOf<DaroTransition>();
+
+        private byte[] _data = new byte[4096];
+        private int _size;
+        private int _count;
+        private int[] _results = new int[16];
+
+        public DaroCommandBuffer()
+        {
+            Reset();
+        }
+
+        public int Count => _count;
+
+        /// <summary>Per-command results of the last Submit (DARO_SUBMIT_* code or loaded id).</summary>
+        public ReadOnlySpan<int> Results => new ReadOnlySpan<int>(_results, 0, Math.Min(_count, _results.Length));
+
+        /// <summary>Id operand naming the id returned by an earlier load in this buffer.</summary>
+        public static int Ref(int commandIndex) => int.MinValue + commandIndex;
+
+        public void Reset(uint flags = 0, int when = DaroConstants.WHEN_IMMEDIATE, long at = 0)
+        {
+            Array.Clear(_data, 0, HEADER_SIZE);
+            var header = new Span<byte>(_data, 0, HEADER_SIZE);
+            BinaryPrimitives.WriteUInt32LittleEndian(header, MAGIC);
+            BinaryPrimitives.WriteUInt16LittleEndian(header.Slice(4), VERSION);
+            BinaryPrimitives.WriteUInt16LittleEndian(header.Slice(6), HEADER_SIZE);
+            BinaryPrimitives.WriteUInt32LittleEndian(header.Slice(12), flags);
+            BinaryPrimitives.WriteInt32LittleEndian(header.Slice(16), when);
+            BinaryPrimitives.WriteInt64LittleEndian(header.Slice(24), at);
+            _size = HEADER_SIZE;
+            _count = 0;
+        }
+
+        // Each returns the index of its command, for Ref
+        public int SetLayerCount(int count) => AddInts(OP_SET_LAYER_COUNT, 1, count, 0);
+        public int ClearLayers() => AddInts(OP_CLEAR_LAYERS, 0, 0, 0);
+        public int LoadTexture(string path) => AddStrings(OP_LOAD_TEXTURE, path, null);
+        public int UnloadTexture(int textureId) => AddInts(OP_UNLOAD_TEXTURE, 1, textureId, 0);
+        public int LoadVideo(string path) => AddStrings(OP_LOAD_VIDEO, path, null);
+        public int UnloadVideo(int videoId) => AddInts(OP_UNLOAD_VIDEO, 1, videoId, 0);
+        public int PlayVideo(int videoId) => AddInts(OP_PLAY_VIDEO, 1, videoId, 0);
+        public int PauseVideo(int videoId) => AddInts(OP_PAUSE_VIDEO, 1, videoId, 0);
+        public int StopVideo(int videoId) => AddInts(OP_STOP_VIDEO, 1, videoId, 0);
+        public int SeekVideo(int videoId, int frame) => AddInts(OP_SEEK_VIDEO, 2, videoId, frame);
+        public int SetVideoLoop(int videoId, bool loop) => AddInts(OP_SET_VIDEO_LOOP, 2, videoId, loop ? 1 : 0);
+        public int SetVideoAlpha(int videoId, bool alpha) => AddInts(OP_SET_VIDEO_ALPHA, 2, videoId, alpha ? 1 : 0);
+        public int SetOutputMetadata(string templateName, string itemName) =>
+            AddStrings(OP_SET_OUTPUT_METADATA, templateName ?? "", itemName ?? "");
+        // Timeline commands act on the edited slot's timeline
+        public int Play() => AddInts(OP_PLAY, 0, 0, 0);
+        public int Stop() => AddInts(OP_STOP, 0, 0, 0);
+        public int SeekToFrame(int frame) => AddInts(OP_SEEK_TO_FRAME, 1, frame, 0);
+        public int ContinueTimeline() => AddInts(OP_CONTINUE_TIMELINE, 0, 0, 0);
+        // Layer and timeline commands after this edit the slot (DaroConstants.SCENE_PROGRAM for the one on air)
+        public int EditScene(int slot) => AddInts(OP_EDIT_SCENE, 1, slot, 0);
+        public int TakeScene(int slot) => AddInts(OP_TAKE_SCENE, 1, slot, 0);
+
+        public int SeekVideoTime(int videoId, double seconds)
+        {
+            int offset = AppendRecord(OP_SEEK_VIDEO_TIME, 12);
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(_data, offset, 4), videoId);
+            BinaryPrimitives.WriteDoubleLittleEndian(new Span<byte>(_data, offset + 4, 8), seconds);
+            return _count - 1;
+        }
+
+        // maskTextureId may be a Ref to a LoadTexture in this buffer
+        public unsafe int TransitionScene(int slot, ref DaroTransition transition)
+        {
+            int offset = AppendRecord(OP_TRANSITION_SCENE, 4 + TransitionSize);
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(_data, offset, 4), slot);
+            fixed (byte* p = &_data[offset + 4])
+            {
+                Marshal.StructureToPtr(transition, (IntPtr)p, false);
+            }
+            return _count - 1;
+        }
+
+        public unsafe int UpdateLayer(int index, ref DaroLayerNative layer)
+        {
+            int offset = AppendRecord(OP_UPDATE_LAYER, 4 + LayerSize);
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(_data, offset, 4), index);
+            fixed (byte* p = &_data[offset + 4])
+            {
+                Marshal.StructureToPtr(layer, (IntPtr)p, false);
+            }
+            return _count - 1;
+        }
+
+        /// <summary>
+        /// Runs the buffer in one call. Returns how many commands succeeded, -1 if the
+        /// engine rejected the buffer and nothing ran.
+        /// </summary>
+        public int Submit()
+        {
+            if (_results.Length < _count) _results = new int[Math.Max(_count, _results.Length * 2)];
+            return DaroEngine.Daro_Submit(_data, (UIntPtr)_size, _results, _results.Length);
+        }
+
+        private int AddInts(ushort op, int count, int a, int b)
+        {
+            int offset = AppendRecord(op, count * 4);
+            if (count > 0) BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(_data, offset, 4), a);
+            if (count > 1) BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(_data, offset + 4, 4), b);
+            return _count - 1;
+        }
+
+        private int AddStrings(ushort op, string a, string b)
+        {
+            int first = Encoding.UTF8.GetByteCount(a ?? "") + 1;
+            int second = b != null ? Encoding.UTF8.GetByteCount(b) + 1 : 0;
+            int offset = AppendRecord(op, first + second);
+            Encoding.UTF8.GetBytes(a ?? "", 0, (a ?? "").Length, _data, offset);
+            _data[offset + first - 1] = 0;
+            if (b != null)
+            {
+                Encoding.UTF8.GetBytes(b, 0, b.Length, _data, offset + first);
+                _data[offset + first + second - 1] = 0;
+            }
+            return _count - 1;
+        }
+
+        // Record header plus room for the payload; returns the payload offset
+        private int AppendRecord(ushort op, int payloadSize)
+        {
+            int recordSize = RECORD_SIZE + payloadSize;
+            if (_size + recordSize > _data.Length)
+                Array.Resize(ref _data, Math.Max(_size + recordSize, _data.Length * 2));
+
+            var record = new Span<byte>(_data, _size, RECORD_SIZE);
+            BinaryPrimitives.WriteUInt16LittleEndian(record, op);
+            BinaryPrimitives.WriteUInt16LittleEndian(record.Slice(2), 0);
+            BinaryPrimitives.WriteUInt32LittleEndian(record.Slice(4), (uint)recordSize);
+            int payload = _size + RECORD_SIZE;
+            _size += recordSize;
+            _count++;
+            BinaryPrimitives.WriteUInt32LittleEndian(new Span<byte>(_data, 8, 4), (uint)_count);
+            return payload;
+        }
+    }
+}
@@ -31,6 +31,98 @@ namespace DaroDesigner.Engine
         public const int ALIGN_LEFT = 0;
         public const int ALIGN_CENTER = 1;
         public const int ALIGN_RIGHT = 2;
+
+        // Command queue timing (Daro_QueueCommand when)
+        public const int WHEN_IMMEDIATE = 0;
+        public const int WHEN_NEXT_FRAME = 1;
+        public const int WHEN_FRAME = 2;
+        public const int WHEN_TIMECODE = 3;
+
+        // Command queue types
+        public const int CMD_UPDATE_LAYER = 0;
+        public const int CMD_SET_LAYER_COUNT = 1;
+        public const int CMD_CLEAR_LAYERS = 2;
+        public const int CMD_PLAY_VIDEO = 3;
+        public const int CMD_PAUSE_VIDEO = 4;
+        public const int CMD_STOP_VIDEO = 5;
+        public const int CMD_SEEK_VIDEO = 6;
+        public const int CMD_SEEK_VIDEO_TIME = 7;
+        public const int CMD_SET_VIDEO_LOOP = 8;
+        public const int CMD_SET_VIDEO_ALPHA = 9;
+        public const int CMD_TAKE_SCENE = 10;
+        public const int CMD_TRANSITION_SCENE = 11;     // Daro_QueueTransition only
+        public const int CMD_PLAY_TIMELINE = 12;        // target = scene slot
+        public const int CMD_STOP_TIMELINE = 13;
+        public const int CMD_SEEK_TIMELINE = 14;        // value = frame
+        public const int CMD_CONTINUE_TIMELINE = 15;
+
+        // Scene slots (Daro_*Scene*)
+        public const int SCENE_SLOTS = 4;
+        public const int SCENE_PROGRAM = -1;
+        public const int PREVIEW_MAX_DIVISOR = 8;
+
+        // Scene transitions (DaroTransition)
+        public const int TRANSITION_CUT = 0;
+        public const int TRANSITION_MIX = 1;
+        public const int TRANSITION_PUSH = 2;
+        public const int TRANSITION_WIPE = 3;
+        public const int EASE_LINEAR = 0;
+        public const int EASE_IN = 1;
+        public const int EASE_OUT = 2;
+        public const int EASE_IN_OUT = 3;
+        public const int DIRECTION_LEFT = 0;
+        public const int DIRECTION_RIGHT = 1;
+        public const int DIRECTION_UP = 2;
+        public const int DIRECTION_DOWN = 3;
+
+        // Scene timelines (Daro_*Timeline)
+        public const int TIMELINE_MAX_MARKERS = 64;
+        public const int TIMELINE_MAX_TRACKS = 1024;
+        public const int TIMELINE_MAX_KEYFRAMES = 65536;
+        public const int TIMELINE_DEFAULT_LENGTH = 250;
+        public const int MARKER_STOP = 0;
+        public const int MARKER_LOOP = 1;
+        public const int MARKER_JUMP = 2;
+
+        // Animatable layer fields (timeline tracks)
+        public const int FIELD_POS_X = 0;
+        public const int FIELD_POS_Y = 1;
+        public const int FIELD_SIZE_X = 2;
+        public const int FIELD_SIZE_Y = 3;
+        public const int FIELD_ROT_X = 4;
+        public const int FIELD_ROT_Y = 5;
+        public const int FIELD_ROT_Z = 6;
+        public const int FIELD_OPACITY = 7;
+        public const int FIELD_COLOR_R = 8;
+        public const int FIELD_COLOR_G = 9;
+        public const int FIELD_COLOR_B = 10;
+        public const int FIELD_VISIBLE = 11;
+        public const int FIELD_FONT_SIZE = 12;
+        public const int FIELD_LINE_HEIGHT = 13;
+        public const int FIELD_LETTER_SPACING = 14;
+        public const int FIELD_TEX_X = 15;
+        public const int FIELD_TEX_Y = 16;
+        public const int FIELD_TEX_W = 17;
+        public const int FIELD_TEX_H = 18;
+        public const int FIELD_TEX_ROT = 19;
+        public const int FIELD_TEXT = 32;           // Data bindings only
+
+        // Data binding store (Daro_*Data*)
+        public const int DATA_MAX_KEYS = 4096;
+        public const int DATA_KEY_SIZE = 64;
+        public const int DATA_MAX_BINDINGS = 4096;
+        public const int DATA_NONE = 0;
+        public const int DATA_NUMBER = 1;
+        public const int DATA_TEXT = 2;
+
+        // Daro_Submit per-command results (loads return the id instead)
+        public const int SUBMIT_OK = 0;
+        public const int SUBMIT_ERROR_NOT_RUN = -1;
+        public const int SUBMIT_ERROR_UNKNOWN_OP = -2;
+        public const int SUBMIT_ERROR_MALFORMED = -3;
+        public const int SUBMIT_ERROR_INVALID = -4;
+        public const int SUBMIT_ERROR_FAILED = -5;
+        public const int SUBMIT_ERROR_NOT_QUEUEABLE = -6;
     }
 
     // Structure must match C++ DaroLayer EXACTLY
@@ -90,6 +182,242 @@ namespace DaroDesigner.Engine
         public int[] maskedLayerIds;    // Layer IDs (64 * 4 = 256 bytes)
     }
 
+    // Structure must match C++ DaroSpoutReceiverStats EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroSpoutReceiverStats
+    {
+        public int connected;
+        public int width;
+        public int height;
+        public int senderFrame;
+        public double senderFps;
+        public long newFrames;          // Sender frames copied into the layer texture
+        public long repeatedFrames;     // Sender frame unchanged, copy skipped
+        public long skippedFrames;      // Not referenced by any active layer
+    }
+
+    // Structure must match C++ DaroFrameStats EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroFrameStats
+    {
+        public long frameNumber;
+        public double frameIntervalMs;  // EndFrame to EndFrame
+        public double busyMs;           // BeginFrame to EndFrame
+
+        [MarshalAs(UnmanagedType.ByValArray, ArraySubType = UnmanagedType.R8, SizeConst = 16)]
+        public double[] stageMs;        // Indexed by DaroEngine.DARO_STAGE_*
+    }
+
+    // Structure must match C++ DaroMemoryStats EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroMemoryStats
+    {
+        public int category;
+        public int assetCount;
+        public long cpuBytes;
+        public long gpuBytes;
+        public long peakCpuBytes;
+        public long peakGpuBytes;
+        public long peakBytes;
+        public long budgetBytes;
+        public int overBudget;
+        public int budgetWarnings;
+    }
+
+    // Structure must match C++ DaroMemoryAsset EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroMemoryAsset
+    {
+        public int category;
+        public int assetId;
+        public long cpuBytes;
+        public long gpuBytes;
+    }
+
+    // Structure must match C++ DaroLayerCost EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroLayerCost
+    {
+        public int layerId;
+        public int layerType;
+        public int paths;
+        public int stateChanges;
+        public int flushes;
+        public int drawCalls;
+        public double cpuMs;
+        public double gpuMs;
+    }
+
+    // Structure must match C++ DaroTimingSummary EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroTimingSummary
+    {
+        public long count;
+        public double meanMs;
+        public double p50Ms;
+        public double p95Ms;
+        public double p99Ms;
+        public double p999Ms;
+        public double maxMs;
+    }
+
+    // Structure must match C++ DaroSpoutOutputStats EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroSpoutOutputStats
+    {
+        public int running;
+        public int timeoutMs;
+        public long sentFrames;
+        public long overwrittenFrames;  // Replaced by a newer frame before sending
+        public long staleFrames;        // Older than timeoutMs when picked up
+        public long accessTimeouts;     // A receiver held the shared texture
+        public double lastSendMs;
+        public double maxSendMs;
+    }
+
+    // Structure must match C++ DaroRenderLoopStats EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroRenderLoopStats
+    {
+        public int running;
+        public int virtualClock;
+        public double fps;
+        public long frames;
+        public long missedDeadlines;    // Skipped after a frame ran a full period late
+        public double wakeLateMeanMs;   // Wake-up after the frame deadline
+        public double wakeLateP99Ms;
+        public double wakeLateMaxMs;
+        public double lastFrameMs;
+        public double maxFrameMs;
+    }
+
+    // Structure must match C++ DaroGenlockStats EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroGenlockStats
+    {
+        public int state;               // 0 free run, 1 no reference, 2 acquiring, 3 locked
+        public long ticks;
+        public long relocks;
+        public long referenceLost;
+        public double referenceFps;
+        public double correctionPpm;    // Positive: loop runs faster than nominal
+        public double phaseErrorMs;     // Frame deadline minus nearest reference tick
+        public double phaseErrorMeanMs;
+        public double phaseErrorP99Ms;
+        public double phaseErrorMaxMs;
+    }
+
+    // Structure must match C++ DaroCommandQueueStats EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroCommandQueueStats
+    {
+        public long queued;
+        public long applied;
+        public long pending;            // Waiting for their frame
+        public long late;               // Applied after their target frame
+        public long maxLateFrames;
+        public long lastLateId;
+        public long lastLateFrame;
+        public long lastAppliedId;
+    }
+
+    // Structure must match C++ DaroTransition EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroTransition
+    {
+        public int type;                // DaroConstants.TRANSITION_*
+        public int durationFrames;      // Output frames; 0 or 1 cuts
+        public int easing;              // DaroConstants.EASE_*
+        public int direction;           // DaroConstants.DIRECTION_* (push, edge wipe)
+        public int maskTextureId;       // Wipe: dark pixels switch first; 0 = edge wipe
+        public float softness;          // Wipe edge width, 0..1
+    }
+
+    // Structure must match C++ DaroTransitionState EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroTransitionState
+    {
+        public int active;
+        public int fromSlot;
+        public int toSlot;              // Already the program slot
+        public int type;
+        public int frame;               // 1..durationFrames
+        public int durationFrames;
+        public float progress;          // Eased
+        public long startFrame;
+        public long completed;
+        public long interrupted;        // Ended early by a take or another transition
+    }
+
+    // Structure must match C++ DaroKeyframe EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroKeyframe
+    {
+        public int frame;
+        public float value;
+        public float easeIn;            // 0..1, as KeyframeModel
+        public float easeOut;
+    }
+
+    // Structure must match C++ DaroTimelineMarker EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroTimelineMarker
+    {
+        public int frame;
+        public int type;                // DaroConstants.MARKER_*
+        public int target;              // Loop start or jump destination
+    }
+
+    // Structure must match C++ DaroTimelineState EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroTimelineState
+    {
+        public int playing;
+        public int frame;               // Shown by the next output frame
+        public int lastFrame;           // -1 if none yet
+        public int length;
+        public int held;                // Held by a stop marker
+        public int looping;             // Inside a loop region
+        public int continuePending;
+        public int trackCount;
+        public int markerCount;
+        public long loops;
+    }
+
+    // Structure must match C++ DaroDataStoreStats EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroDataStoreStats
+    {
+        public long writes;
+        public long unchanged;          // Same value again, dropped
+        public long coalesced;          // Overwritten before a frame applied them
+        public long applies;
+        public long fieldsApplied;
+        public long layersDirtied;
+        public long ingestScans;
+        public long ingestTornReads;
+        public int keyCount;
+        public int bindingCount;
+        public int ingestEntries;       // 0 while no ingest region is open
+        public int lastLayersDirtied;
+    }
+
+    // Structure must match C++ DaroFrameMetadata EXACTLY
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct DaroFrameMetadata
+    {
+        public long spoutFrame;
+        public long engineFrame;
+        public long timestampNs;
+        public int timecode;            // 0xHHMMSSFF, bit 31 set for drop-frame
+
+        [MarshalAs(UnmanagedType.ByValArray, ArraySubType = UnmanagedType.U1, SizeConst = 64)]
+        public byte[] templateName;     // UTF-8, null terminated
+
+        [MarshalAs(UnmanagedType.ByValArray, ArraySubType = UnmanagedType.U1, SizeConst = 64)]
+        public byte[] itemName;         // UTF-8, null terminated
+    }
+
     public static class DaroEngine
     {
         private const string DLL = "DaroEngine.dll";
@@ -142,6 +470,48 @@ namespace DaroDesigner.Engine
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         public static extern long Daro_GetFrameNumber();
 
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern long Daro_WaitForFrame(long lastFrame, int timeoutMs);
+
+        // Native render loop
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_StartRenderLoop(double fps);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_StopRenderLoop();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_IsRenderLoopRunning();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetRenderLoopStats(out DaroRenderLoopStats stats);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_LockRenderLoop();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_UnlockRenderLoop();
+
+        // Genlock to an external reference (named tick block); null free-runs
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_SetExternalClock([MarshalAs(UnmanagedType.LPUTF8Str)] string name);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetGenlockStats(out DaroGenlockStats stats);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_StartTickGenerator(
+            [MarshalAs(UnmanagedType.LPUTF8Str)] string name, int numerator, int denominator, double offsetPpm);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_StopTickGenerator();
+
         // Layers
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         public static extern void Daro_SetLayerCount(int count);
@@ -155,6 +525,77 @@ namespace DaroDesigner.Engine
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         public static extern void Daro_ClearLayers();
 
+        // Scene slots (slot = DaroConstants.SCENE_PROGRAM for the one on air)
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_SetSceneLayerCount(int slot, int count);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_UpdateSceneLayer(int slot, int index, ref DaroLayerNative layer);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetSceneLayer(int slot, int index, ref DaroLayerNative layer);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern int Daro_GetSceneLayerCount(int slot);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_ClearScene(int slot);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_CopyScene(int fromSlot, int toSlot);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_TakeScene(int slot);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern int Daro_GetProgramSlot();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_SetPreviewSlot(int slot);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern int Daro_GetPreviewSlot();
+
+        // Scene transitions, run by the engine frame counter (Daro_TakeScene(SCENE_PROGRAM) finishes one)
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_TransitionScene(int slot, ref DaroTransition transition);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern long Daro_QueueTransition(int when, long at, int slot, ref DaroTransition transition);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetTransitionState(out DaroTransitionState state);
+
+        // Command queue
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern long Daro_QueueLayerUpdate(int when, long at, int index, ref DaroLayerNative layer);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern long Daro_QueueCommand(int when, long at, int type, int target, long value);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_BeginCommandBatch();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern long Daro_EndCommandBatch(int when, long at);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetCommandQueueStats(out DaroCommandQueueStats stats);
+
+        // Binary command buffer (see DaroCommandBuffer)
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern int Daro_Submit(byte[] buffer, UIntPtr bytes, [Out] int[] results, int resultCount);
+
         // Playback
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         public static extern void Daro_Play();
@@ -175,6 +616,76 @@ namespace DaroDesigner.Engine
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         public static extern int Daro_GetCurrentFrame();
 
+        // Scene timelines, stepped by the engine every output frame (Daro_Play and the calls
+        // above drive the program slot's)
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_SetTimelineTrack(int slot, int layerIndex, int field, DaroKeyframe[] keys, int count);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_SetTimelineMarkers(int slot, DaroTimelineMarker[] markers, int count);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_SetTimelineLength(int slot, int frames);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_ClearTimeline(int slot);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_PlayTimeline(int slot);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_StopTimeline(int slot);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_SeekTimeline(int slot, int frame);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_ContinueTimeline(int slot);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetTimelineState(int slot, out DaroTimelineState state);
+
+        // Live data binding: resolve keys once, then write values in batches
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern int Daro_GetDataKey([MarshalAs(UnmanagedType.LPUTF8Str)] string name);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern int Daro_SetDataNumbers(int[] keys, double[] values, int count);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern int Daro_SetDataTexts(int[] keys,
+            [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPWStr)] string[] texts, int count);
+
+        // field is a FIELD_* constant; key -1 unbinds
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_BindLayerField(int slot, int layerIndex, int field, int key);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_ClearDataBindings(int slot);
+
+        // Shared-memory region for feed processes (null name = "DaroEngineData", 0 entries = default)
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_EnableDataIngest([MarshalAs(UnmanagedType.LPUTF8Str)] string name, int entryCount);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_DisableDataIngest();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetDataStoreStats(out DaroDataStoreStats stats);
+
         // Stats
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         public static extern double Daro_GetFPS();
@@ -185,6 +696,109 @@ namespace DaroDesigner.Engine
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         public static extern int Daro_GetDroppedFrames();
 
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern int Daro_GetLateFrames();
+
+        // Frame stage indices (DaroFrameStats.stageMs)
+        public const int DARO_STAGE_BEGIN_LOCK_WAIT = 0;
+        public const int DARO_STAGE_SPOUT_RECEIVE = 1;
+        public const int DARO_STAGE_VIDEO_DECODE = 2;
+        public const int DARO_STAGE_RENDER_LOCK_WAIT = 3;
+        public const int DARO_STAGE_LAYER_COPY = 4;
+        public const int DARO_STAGE_DRAW = 5;
+        public const int DARO_STAGE_TEXT = 6;
+        public const int DARO_STAGE_GPU_WAIT = 7;
+        public const int DARO_STAGE_READBACK = 8;
+        public const int DARO_STAGE_FRAMEBUFFER_WAIT = 9;
+        public const int DARO_STAGE_FRAMEBUFFER_WRITE = 10;
+        public const int DARO_STAGE_TRANSPORT = 11;
+        public const int DARO_STAGE_PRESENT_LOCK_WAIT = 12;
+        public const int DARO_STAGE_PRESENT = 13;
+        public const int DARO_STAGE_PREVIEW = 14;
+        public const int DARO_STAGE_COUNT = 16;
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern int Daro_GetFrameStats([Out] DaroFrameStats[] buffer, int count);
+
+        // Frame-time distributions
+        public const int DARO_TIMING_FRAME_INTERVAL = 0;
+        public const int DARO_TIMING_RENDER = 1;
+        public const int DARO_TIMING_OUTPUT_LATENCY = 2;
+        public const int DARO_TIMING_SINCE_RESET = 0;
+        public const int DARO_TIMING_LAST_WINDOW = 1;
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetTimingSummary(int metric, int window, out DaroTimingSummary summary);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_SetTimingWindow(int milliseconds);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_ResetTimingStats();
+
+        // Timeline tracing
+        public const int DARO_TRACE_FORMAT_JSON = 0;
+        public const int DARO_TRACE_FORMAT_PERFETTO = 1;
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_StartTrace();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_StopTrace();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_IsTraceEnabled();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_WriteTrace([MarshalAs(UnmanagedType.LPUTF8Str)] string filePath, int format);
+
+        // API capture for Benchmarks/Replay
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_StartCapture([MarshalAs(UnmanagedType.LPUTF8Str)] string filePath);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_StopCapture();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_IsCapturing();
+
+        // Engine clock - virtual time only moves on Daro_AdvanceClock*
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_SetVirtualClock(bool enabled);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_IsVirtualClock();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_AdvanceClock(double milliseconds);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_AdvanceClockFrames(int frames);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern double Daro_GetClockTime();
+
+        // Output frame rate as an exact ratio (60000/1001 for 59.94)
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_SetFrameRate(int numerator, int denominator);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_GetFrameRate(out int numerator, out int denominator);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_SetDropFrameTimecode(bool enabled);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_IsDropFrameTimecode();
+
         // Spout Output
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         [return: MarshalAs(UnmanagedType.I1)]
@@ -197,6 +811,54 @@ namespace DaroDesigner.Engine
         [return: MarshalAs(UnmanagedType.I1)]
         public static extern bool Daro_IsSpoutEnabled();
 
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_SetSpoutSendTimeout(int milliseconds);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetSpoutOutputStats(out DaroSpoutOutputStats stats);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_SetOutputMetadata(
+            [MarshalAs(UnmanagedType.LPUTF8Str)] string templateName,
+            [MarshalAs(UnmanagedType.LPUTF8Str)] string itemName);
+
+        // CPU frame transport
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_EnableFrameTransport([MarshalAs(UnmanagedType.LPUTF8Str)] string senderName);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_DisableFrameTransport();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_IsFrameTransportEnabled();
+
+        // Preview output: the preview slot through a second frame transport sender at 1/divisor size
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_EnablePreviewOutput([MarshalAs(UnmanagedType.LPUTF8Str)] string senderName, int divisor);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_DisablePreviewOutput();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_IsPreviewOutputEnabled();
+
+        // Live stats block for external monitors (null name = "DaroEngineStats", 0 ms = default interval)
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_EnableStatsBlock([MarshalAs(UnmanagedType.LPUTF8Str)] string name, int intervalMs);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_DisableStatsBlock();
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_IsStatsBlockEnabled();
+
         // Texture management
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         public static extern int Daro_LoadTexture([MarshalAs(UnmanagedType.LPUTF8Str)] string filePath);
@@ -218,6 +880,14 @@ namespace DaroDesigner.Engine
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         public static extern void Daro_DisconnectSpoutReceiver(int receiverId);
 
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetSpoutReceiverStats(int receiverId, out DaroSpoutReceiverStats stats);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetSpoutReceiverMetadata(int receiverId, out DaroFrameMetadata metadata);
+
         // Debug - structure info
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         public static extern int Daro_GetStructSize();
@@ -238,6 +908,51 @@ namespace DaroDesigner.Engine
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         public static extern void Daro_SetShowBounds(bool show);
 
+        // Per-layer render cost
+        public const int DARO_COST_PATH_QUAD = 0x01;
+        public const int DARO_COST_PATH_D2D_TEXT = 0x02;
+        public const int DARO_COST_PATH_D2D_CIRCLE = 0x04;
+        public const int DARO_COST_PATH_STENCIL_MASK = 0x08;
+        public const int DARO_COST_PATH_GEOMETRY_MASK = 0x10;
+        public const int DARO_COST_PATH_BOUNDS = 0x20;
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_SetLayerCostEnabled(bool enabled);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern int Daro_GetLayerCosts([Out] DaroLayerCost[] buffer, int maxCount);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetLayerCost(int layerId, out DaroLayerCost cost);
+
+        // Memory accounting
+        public const int DARO_MEM_ALL = -1;
+        public const int DARO_MEM_TEXTURES = 0;
+        public const int DARO_MEM_VIDEO = 1;
+        public const int DARO_MEM_SPOUT_INPUT = 2;
+        public const int DARO_MEM_SPOUT_OUTPUT = 3;
+        public const int DARO_MEM_RENDER_TARGETS = 4;
+        public const int DARO_MEM_FRAME_BUFFER = 5;
+        public const int DARO_MEM_FRAME_TRANSPORT = 6;
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_GetMemoryStats(int category, out DaroMemoryStats stats);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern int Daro_GetMemoryAssets(int category, [Out] DaroMemoryAsset[] buffer, int maxCount);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_SetMemoryBudget(int category, long bytes);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        public static extern bool Daro_IsMemoryOverBudget(int category);
+
+        [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
+        public static extern void Daro_ResetMemoryPeaks();
+
         // Device status
         [DllImport(DLL, CallingConvention = CallingConvention.StdCall)]
         [return: MarshalAs(UnmanagedType.I1)]
@@ -31,9 +31,12 @@ namespace DaroDesigner.Engine
         private long _lastFrameNumber;
         private Dispatcher _uiDispatcher;
 
-        // Thread synchronization for engine calls
+        // Thread synchronization for engine calls (see LockEngine)
         private readonly object _engineLock = new object();
+        private int _engineLockDepth;               // Nesting on the thread holding _engineLock
+        private bool _nativeLoopActive;             // Engine render loop running (Start); under _engineLock
         private readonly object _bitmapLock = new object();
+        private readonly DaroCommandBuffer _layerBatch = new DaroCommandBuffer();   // Used under the engine lock
 
         // FPS calculation
         private Stopwatch _fpsStopwatch;
@@ -45,6 +48,7 @@ namespace DaroDesigner.Engine
         private readonly LinkedList<TextureCacheEntry> _textureLruList = new LinkedList<TextureCacheEntry>();
         private readonly object _textureCacheLock = new object();
         private static int MaxTextureCacheSize => AppConstants.MaxTextureCacheSize;  // Use centralized constant
+        private bool _textureEvictionWarned;    // Logged once per crossing of the cache limits
 
         // Thread-safe Spout receiver cache: senderName -> (receiverId, refCount)
         private readonly ConcurrentDictionary<string, (int Id, int RefCount)> _spoutReceiverCache = new ConcurrentDictionary<string, (int, int)>();
@@ -144,6 +148,10 @@ namespace DaroDesigner.Engine
                     return false;
                 }
 
+                // Publish live stats for external monitors. Not fatal: another engine
+                // instance may already own the segment.
+                DaroEngine.Daro_EnableStatsBlock(null, 0);
+
                 _bitmap = new WriteableBitmap(
                     FrameWidth, FrameHeight,
                     96, 96,
@@ -216,10 +224,22 @@ namespace DaroDesigner.Engine
             _frameCount = 0;
             _lastFpsUpdate = _fpsStopwatch.Elapsed.TotalSeconds;
 
-            _renderThread = new Thread(RenderThreadProc)
+            // Frames are paced by the engine's own render loop thread. Started under the engine
+            // lock, so no LockEngine scope sees the flag change between its hold and release.
+            lock (_engineLock)
+            {
+                if (!DaroEngine.Daro_StartRenderLoop(TargetFps))
+                {
+                    Logger.Error("Engine render loop failed to start");
+                    _isRunning = false;
+                    return;
+                }
+                _nativeLoopActive = true;
+            }
+
+            _renderThread = new Thread(FrameWaitThreadProc)
             {
-                Name = "DaroRenderThread",
-                Priority = ThreadPriority.Highest,
+                Name = "DaroFrameWaitThread",
                 IsBackground = true
             };
             _renderThread.Start();
@@ -230,72 +250,101 @@ namespace DaroDesigner.Engine
             _shouldStop = true;
             _isRunning = false;
 
-            // Wait for render thread to finish - must complete before Shutdown releases engine
+            // Must complete before Shutdown releases the engine. Stopping does not wait for
+            // render loop holds, so it is safe under the engine lock.
+            lock (_engineLock)
+            {
+                if (_nativeLoopActive)
+                {
+                    DaroEngine.Daro_StopRenderLoop();
+                    _nativeLoopActive = false;
+                }
+            }
+
             if (_renderThread != null && _renderThread.IsAlive)
             {
-                if (!_renderThread.Join(5000)) // Wait up to 5s for render thread
+                if (!_renderThread.Join(5000)) // Wait up to 5s for the frame wait thread
                 {
-                    Logger.Warn("Render thread did not stop within 5s timeout");
+                    Logger.Warn("Frame wait thread did not stop within 5s timeout");
                 }
             }
             _renderThread = null;
         }
 
-        [DllImport("ole32.dll")]
-        private static extern int CoInitializeEx(IntPtr reserved, uint dwCoInit);
+        /// <summary>
+        /// Serializes engine calls. While the engine render loop runs, the outermost scope
+        /// also holds the loop off (Daro_LockRenderLoop), so a batch of calls such as
+        /// SetLayerCount + UpdateLayer lands in a single frame.
+        /// </summary>
+        private EngineLockScope LockEngine()
+        {
+            Monitor.Enter(_engineLock);
+            bool gate = _engineLockDepth++ == 0 && _nativeLoopActive;
+            if (gate)
+                DaroEngine.Daro_LockRenderLoop();
+            return new EngineLockScope(this, gate);
+        }
+
+        private readonly struct EngineLockScope : IDisposable
+        {
+            private readonly EngineRenderer _owner;
+            private readonly bool _gate;
 
-        [DllImport("ole32.dll")]
-        private static extern void CoUninitialize();
+            public EngineLockScope(EngineRenderer owner, bool gate)
+            {
+                _owner = owner;
+                _gate = gate;
+            }
 
-        private const uint COINIT_MULTITHREADED = 0x0;
+            public void Dispose()
+            {
+                if (_gate)
+                    DaroEngine.Daro_UnlockRenderLoop();
+                _owner._engineLockDepth--;
+                Monitor.Exit(_owner._engineLock);
+            }
+        }
 
-        private void RenderThreadProc()
+        private void FrameWaitThreadProc()
         {
-            // Ensure COM is initialized on render thread for Media Foundation video operations
-            int comHr = CoInitializeEx(IntPtr.Zero, COINIT_MULTITHREADED);
-            bool comInitialized = (comHr == 0); // S_OK means we initialized it
-            // S_FALSE (1) = already initialized, RPC_E_CHANGED_MODE = different model - both OK
-
-            double targetFrameTime = 1000.0 / TargetFps; // 20ms for 50 FPS
-            var stopwatch = Stopwatch.StartNew();
-            double nextFrameTime = 0;
+            long lastFrame = DaroEngine.Daro_GetFrameNumber();
 
             try
             {
                 while (!_shouldStop && IsInitialized)
                 {
-                    double currentTime = stopwatch.Elapsed.TotalMilliseconds;
+                    // Woken by Daro_EndFrame on the engine's loop thread
+                    long frame = DaroEngine.Daro_WaitForFrame(lastFrame, 100);
+                    if (_shouldStop) break;
 
-                    // Wait until it's time for next frame
-                    if (currentTime < nextFrameTime)
+                    if (frame != lastFrame)
                     {
-                        double waitTime = nextFrameTime - currentTime;
+                        lastFrame = frame;
 
-                        // Sleep for most of the wait time (leave 2ms for spin-wait)
-                        if (waitTime > 2.0)
+                        // Copy frame to bitmap on UI thread (use Render priority to avoid blocking the engine)
+                        var dispatcher = _uiDispatcher;
+                        if (dispatcher != null && !dispatcher.HasShutdownStarted)
                         {
-                            Thread.Sleep((int)(waitTime - 2.0));
-                        }
-
-                        // Spin-wait for precise timing
-                        while (stopwatch.Elapsed.TotalMilliseconds < nextFrameTime)
-                        {
-                            Thread.SpinWait(10);
+                            dispatcher.BeginInvoke(new Action(CopyFrameToBitmap), DispatcherPriority.Render);
                         }
                     }
-
-                    // Schedule next frame
-                    nextFrameTime = stopwatch.Elapsed.TotalMilliseconds + targetFrameTime;
-
-                    // Perform render (engine calls are thread-safe)
-                    PerformRenderOnThread();
+                    else if (!DaroEngine.Daro_IsRenderLoopRunning())
+                    {
+                        // The loop only ends on its own when the GPU device is lost
+                        _isRunning = false;
+                        if (DaroEngine.Daro_IsDeviceLost())
+                            ReportDeviceLost();
+                        else
+                            Logger.Error("Engine render loop stopped unexpectedly");
+                        break;
+                    }
                 }
             }
             catch (Exception ex)
             {
                 // Log error and signal thread termination
-                // Avoid crash - just stop rendering gracefully
-                Logger.Error($"Render thread fatal error: {ex.GetType().Name}: {ex.Message}");
+                // Avoid crash - just stop updating the preview gracefully
+                Logger.Error($"Frame wait thread fatal error: {ex.GetType().Name}: {ex.Message}");
                 _isRunning = false;
 
                 // Notify UI thread about render failure (check if dispatcher is still available)
@@ -308,53 +357,24 @@ namespace DaroDesigner.Engine
                     }), DispatcherPriority.Normal);
                 }
             }
-            finally
-            {
-                // Clean up COM on render thread
-                if (comInitialized)
-                    CoUninitialize();
-            }
         }
 
-        private void PerformRenderOnThread()
+        private void ReportDeviceLost()
         {
-            lock (_engineLock)
+            if (_deviceLostReported) return;
+            _deviceLostReported = true;
+            Logger.Error("GPU device lost detected - rendering stopped");
+            var uiDispatcher = _uiDispatcher;
+            if (uiDispatcher != null && !uiDispatcher.HasShutdownStarted)
             {
-                // Check for GPU device lost before rendering
-                if (DaroEngine.Daro_IsDeviceLost())
+                uiDispatcher.BeginInvoke(new Action(() =>
                 {
-                    if (!_deviceLostReported)
-                    {
-                        _deviceLostReported = true;
-                        Logger.Error("GPU device lost detected - rendering stopped");
-                        var uiDispatcher = _uiDispatcher;
-                        if (uiDispatcher != null && !uiDispatcher.HasShutdownStarted)
-                        {
-                            uiDispatcher.BeginInvoke(new Action(() =>
-                            {
-                                MessageBox.Show(
-                                    "GPU device lost. Rendering has stopped.\n\n" +
-                                    "This can happen after a GPU driver crash or update.\n" +
-                                    "Please restart the application.",
-                                    "GPU Error", MessageBoxButton.OK, MessageBoxImage.Error);
-                            }), System.Windows.Threading.DispatcherPriority.Normal);
-                        }
-                    }
-                    _shouldStop = true;
-                    return;
-                }
-
-                DaroEngine.Daro_BeginFrame();
-                DaroEngine.Daro_Render();
-                DaroEngine.Daro_Present();
-                DaroEngine.Daro_EndFrame();
-            }
-
-            // Copy frame to bitmap on UI thread (use Render priority to avoid blocking render thread)
-            var dispatcher = _uiDispatcher;
-            if (dispatcher != null && !dispatcher.HasShutdownStarted)
-            {
-                dispatcher.BeginInvoke(new Action(CopyFrameToBitmap), DispatcherPriority.Render);
+                    MessageBox.Show(
+                        "GPU device lost. Rendering has stopped.\n\n" +
+                        "This can happen after a GPU driver crash or update.\n" +
+                        "Please restart the application.",
+                        "GPU Error", MessageBoxButton.OK, MessageBoxImage.Error);
+                }), System.Windows.Threading.DispatcherPriority.Normal);
             }
         }
 
@@ -447,7 +467,7 @@ namespace DaroDesigner.Engine
             if (_isRunning) return;
 
             // Render on current thread (only when render thread is stopped)
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_BeginFrame();
                 DaroEngine.Daro_Render();
@@ -462,7 +482,7 @@ namespace DaroDesigner.Engine
         public void SetLayerCount(int count)
         {
             if (!IsInitialized) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_SetLayerCount(count);
             }
@@ -471,14 +491,14 @@ namespace DaroDesigner.Engine
         public void UpdateLayer(int index, DaroLayerNative layer)
         {
             if (!IsInitialized) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_UpdateLayer(index, ref layer);
             }
         }
 
         /// <summary>
-        /// Updates multiple layers in a single lock acquisition.
+        /// Updates multiple layers in a single lock acquisition and a single engine call.
         /// This is more efficient than calling UpdateLayer in a loop.
         /// </summary>
         /// <param name="layers">Array of layers to update</param>
@@ -487,13 +507,9 @@ namespace DaroDesigner.Engine
         {
             if (!IsInitialized || layers == null || count <= 0) return;
 
-            lock (_engineLock)
+            using (LockEngine())
             {
-                DaroEngine.Daro_SetLayerCount(count);
-                for (int i = 0; i < count && i < layers.Length; i++)
-                {
-                    DaroEngine.Daro_UpdateLayer(i, ref layers[i]);
-                }
+                SubmitLayers(layers, count);
             }
         }
 
@@ -506,13 +522,9 @@ namespace DaroDesigner.Engine
             if (!IsInitialized || layers == null || count <= 0) return;
             if (_isRunning) return; // Don't interfere with render thread
 
-            lock (_engineLock)
+            using (LockEngine())
             {
-                DaroEngine.Daro_SetLayerCount(count);
-                for (int i = 0; i < count && i < layers.Length; i++)
-                {
-                    DaroEngine.Daro_UpdateLayer(i, ref layers[i]);
-                }
+                SubmitLayers(layers, count);
                 DaroEngine.Daro_BeginFrame();
                 DaroEngine.Daro_Render();
                 DaroEngine.Daro_Present();
@@ -527,10 +539,22 @@ namespace DaroDesigner.Engine
             }
         }
 
+        // Layer count and layers as one Daro_Submit; engine lock held
+        private void SubmitLayers(DaroLayerNative[] layers, int count)
+        {
+            _layerBatch.Reset();
+            _layerBatch.SetLayerCount(count);
+            for (int i = 0; i < count && i < layers.Length; i++)
+            {
+                _layerBatch.UpdateLayer(i, ref layers[i]);
+            }
+            _layerBatch.Submit();
+        }
+
         public void ClearLayers()
         {
             if (!IsInitialized) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_ClearLayers();
             }
@@ -541,7 +565,7 @@ namespace DaroDesigner.Engine
         public bool EnableSpout(string name = "DaroEngine")
         {
             if (!IsInitialized) return false;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 return DaroEngine.Daro_EnableSpoutOutput(name);
             }
@@ -550,7 +574,7 @@ namespace DaroDesigner.Engine
         public void DisableSpout()
         {
             if (!IsInitialized) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_DisableSpoutOutput();
             }
@@ -559,7 +583,7 @@ namespace DaroDesigner.Engine
         public bool IsSpoutEnabled()
         {
             if (!IsInitialized) return false;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 return DaroEngine.Daro_IsSpoutEnabled();
             }
@@ -583,18 +607,12 @@ namespace DaroDesigner.Engine
                     return existingNode.Value.TextureId;
                 }
 
-                // Evict oldest entries if cache is full - O(1)
-                while (_textureCache.Count >= MaxTextureCacheSize)
-                {
-                    int countBefore = _textureCache.Count;
-                    EvictOldestTexture();
-                    if (_textureCache.Count >= countBefore)
-                        break; // All entries in use, cannot evict - allow cache to grow
-                }
+                // Make room for the new texture
+                TrimTextureCache(MaxTextureCacheSize - 1);
 
                 // Load new texture
                 int textureId;
-                lock (_engineLock)
+                using (LockEngine())
                 {
                     textureId = DaroEngine.Daro_LoadTexture(filePath);
                 }
@@ -611,10 +629,55 @@ namespace DaroDesigner.Engine
             }
         }
 
-        private void EvictOldestTexture()
+        // The engine's memory accountant keeps its own lock, so the two budget queries below
+        // read a consistent snapshot without the engine lock or a render loop hold.
+        private bool IsTextureMemoryOverBudget()
+        {
+            if (_textureCache.Count == 0) return false;
+            return DaroEngine.Daro_IsMemoryOverBudget(DaroEngine.DARO_MEM_TEXTURES);
+        }
+
+        private static bool HasTextureBudget()
+        {
+            return DaroEngine.Daro_GetMemoryStats(DaroEngine.DARO_MEM_TEXTURES, out var stats) && stats.budgetBytes > 0;
+        }
+
+        // Evict least recently used unreferenced textures while the cache holds more than
+        // maxEntries or the engine's texture budget (Daro_SetMemoryBudget) is exceeded.
+        // Must be called within _textureCacheLock.
+        private void TrimTextureCache(int maxEntries)
+        {
+            // One engine lock scope (one render loop hold) for all evictions of this trim,
+            // taken only once there is something to evict
+            EngineLockScope? hold = null;
+            try
+            {
+                while (_textureCache.Count > maxEntries || IsTextureMemoryOverBudget())
+                {
+                    hold ??= LockEngine();
+                    if (!EvictOldestTexture())
+                    {
+                        // Everything resident is in use - the cache grows beyond its limits
+                        if (!_textureEvictionWarned)
+                        {
+                            Logger.Warn($"Texture cache over its limits but all {_textureCache.Count} entries are in use, cannot evict");
+                            _textureEvictionWarned = true;
+                        }
+                        return;
+                    }
+                }
+                _textureEvictionWarned = false;     // Back within limits: warn again on the next crossing
+            }
+            finally
+            {
+                hold?.Dispose();
+            }
+        }
+
+        private bool EvictOldestTexture()
         {
             // Must be called within _textureCacheLock
-            // Walk from tail to find first entry with refcount 0 (safe to evict)
+            // Walk from tail to find the least recently used texture nobody references
             var node = _textureLruList.Last;
             while (node != null)
             {
@@ -624,17 +687,16 @@ namespace DaroDesigner.Engine
                     _textureLruList.Remove(node);
                     _textureCache.Remove(entry.FilePath);
 
-                    lock (_engineLock)
+                    using (LockEngine())
                     {
                         DaroEngine.Daro_UnloadTexture(entry.TextureId);
                     }
                     Logger.Debug($"Evicted texture from cache: {entry.FilePath}");
-                    return;
+                    return true;
                 }
                 node = node.Previous;
             }
-            // All entries are in use - can't evict, cache will grow beyond limit
-            Logger.Warn("Texture cache full but all entries in use, cannot evict");
+            return false;
         }
 
         public void UnloadTexture(string filePath)
@@ -643,17 +705,27 @@ namespace DaroDesigner.Engine
 
             lock (_textureCacheLock)
             {
-                if (_textureCache.TryGetValue(filePath, out var node))
+                if (_textureCache.TryGetValue(filePath, out var node) && node.Value.RefCount > 0)
                 {
                     node.Value.RefCount--;
-                    if (node.Value.RefCount <= 0)
+                    if (node.Value.RefCount == 0)
                     {
-                        _textureLruList.Remove(node);
-                        _textureCache.Remove(filePath);
-
-                        lock (_engineLock)
+                        if (HasTextureBudget())
                         {
-                            DaroEngine.Daro_UnloadTexture(node.Value.TextureId);
+                            // Unreferenced textures stay resident for reuse until the cache
+                            // limits or the texture budget evict them
+                            TrimTextureCache(MaxTextureCacheSize);
+                        }
+                        else
+                        {
+                            // No budget set: unload at once, as before budgets existed
+                            _textureLruList.Remove(node);
+                            _textureCache.Remove(filePath);
+
+                            using (LockEngine())
+                            {
+                                DaroEngine.Daro_UnloadTexture(node.Value.TextureId);
+                            }
                         }
                     }
                 }
@@ -684,7 +756,7 @@ namespace DaroDesigner.Engine
                 Debug.WriteLine($"[DaroVideo] C# LoadVideo: skip - initialized={IsInitialized}, path='{filePath}'");
                 return -1;
             }
-            lock (_engineLock)
+            using (LockEngine())
             {
                 int id = DaroEngine.Daro_LoadVideo(filePath);
                 Debug.WriteLine($"[DaroVideo] C# LoadVideo: path='{filePath}' -> id={id}");
@@ -695,7 +767,7 @@ namespace DaroDesigner.Engine
         public void UnloadVideo(int videoId)
         {
             if (!IsInitialized || videoId <= 0) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_UnloadVideo(videoId);
             }
@@ -704,7 +776,7 @@ namespace DaroDesigner.Engine
         public void PlayVideo(int videoId)
         {
             if (!IsInitialized || videoId <= 0) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_PlayVideo(videoId);
             }
@@ -713,7 +785,7 @@ namespace DaroDesigner.Engine
         public void PauseVideo(int videoId)
         {
             if (!IsInitialized || videoId <= 0) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_PauseVideo(videoId);
             }
@@ -722,7 +794,7 @@ namespace DaroDesigner.Engine
         public void StopVideo(int videoId)
         {
             if (!IsInitialized || videoId <= 0) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_StopVideo(videoId);
             }
@@ -731,7 +803,7 @@ namespace DaroDesigner.Engine
         public void SeekVideo(int videoId, int frame)
         {
             if (!IsInitialized || videoId <= 0 || frame < 0) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_SeekVideo(videoId, frame);
             }
@@ -740,7 +812,7 @@ namespace DaroDesigner.Engine
         public void SeekVideoTime(int videoId, double seconds)
         {
             if (!IsInitialized || videoId <= 0 || seconds < 0) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_SeekVideoTime(videoId, seconds);
             }
@@ -749,7 +821,7 @@ namespace DaroDesigner.Engine
         public void SetVideoLoop(int videoId, bool loop)
         {
             if (!IsInitialized || videoId <= 0) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_SetVideoLoop(videoId, loop);
             }
@@ -758,7 +830,7 @@ namespace DaroDesigner.Engine
         public void SetVideoAlpha(int videoId, bool alpha)
         {
             if (!IsInitialized || videoId <= 0) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_SetVideoAlpha(videoId, alpha);
             }
@@ -769,7 +841,7 @@ namespace DaroDesigner.Engine
         public void SetEdgeSmoothing(float width)
         {
             if (!IsInitialized) return;
-            lock (_engineLock)
+            using (LockEngine())
             {
                 DaroEngine.Daro_SetEdgeSmoothing(width);
             }
@@ -802,7 +874,7 @@ namespace DaroDesigner.Engine
             var senders = new List<string>();
             if (!IsInitialized) return senders;
 
-            lock (_engineLock)
+            using (LockEngine())
             {
                 int count = DaroEngine.Daro_GetSpoutSenderCount();
                 for (int i = 0; i < count; i++)
@@ -855,7 +927,7 @@ namespace DaroDesigner.Engine
 
                 // Connect new receiver
                 int receiverId;
-                lock (_engineLock)
+                using (LockEngine())
                 {
                     receiverId = DaroEngine.Daro_ConnectSpoutReceiver(senderName);
                 }
@@ -880,7 +952,7 @@ namespace DaroDesigner.Engine
                     if (entry.RefCount <= 1)
                     {
                         _spoutReceiverCache.TryRemove(senderName, out _);
-                        lock (_engineLock)
+                        using (LockEngine())
                         {
                             try
                             {
@@ -0,0 +1,543 @@
+// Engine/Capture.cpp
+#include "Capture.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+static FILE* OpenFile(const char* path, bool write)
+{
+    FILE* file = nullptr;
+#ifdef _WIN32
+    // Paths are UTF-8 like every other string crossing the API
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+    if (wlen <= 0) return nullptr;
+    std::wstring wpath(wlen, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, &wpath[0], wlen);
+    if (_wfopen_s(&file, wpath.c_str(), write ? L"wb" : L"rb") != 0) return nullptr;
+#else
+    file = fopen(path, write ? "wb" : "rb");
+#endif
+    return file;
+}
+
+static void PutVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+static uint64_t ZigZag(int64_t value) { return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63); }
+static int64_t UnZigZag(uint64_t value) { return (int64_t)(value >> 1) ^ -(int64_t)(value & 1); }
+
+static bool GetVarint(const uint8_t*& data, const uint8_t* end, uint64_t* value)
+{
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64 && data < end; shift += 7)
+    {
+        uint8_t byte = *data++;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Changed runs of 'layer' against 'previous', which is updated to 'layer'.
+// Gaps shorter than a run header are folded into the run.
+static void PutLayerRuns(std::vector<uint8_t>& out, uint8_t* previous, const uint8_t* layer, size_t size)
+{
+    size_t pos = 0;
+    size_t runEnd = 0;          // End of the last run written
+    while (pos < size)
+    {
+        if (previous[pos] == layer[pos]) { pos++; continue; }
+
+        size_t start = pos;
+        size_t end = pos + 1;
+        size_t same = 0;
+        for (size_t i = end; i < size && same < 4; i++)
+        {
+            if (previous[i] == layer[i]) same++;
+            else { same = 0; end = i + 1; }
+        }
+        PutVarint(out, start - runEnd);
+        PutVarint(out, end - start);
+        out.insert(out.end(), layer + start, layer + end);
+        memcpy(previous + start, layer + start, end - start);
+        runEnd = end;
+        pos = end;
+    }
+}
+
+// ============== Writer ==============
+
+namespace
+{
+    struct CaptureState
+    {
+        std::mutex mutex;               // Guards everything below
+        std::condition_variable wake;
+        std::thread writer;
+        bool stopRequested = false;
+        FILE* file = nullptr;
+        std::vector<uint8_t> pending;   // Swapped out by the writer
+        std::vector<uint8_t> scratch;   // Layer runs of the record being committed
+        std::vector<uint8_t> layers;    // Last recorded layer per index
+        uint64_t lastNs = 0;
+        uint64_t records = 0;
+        uint64_t bytes = 0;
+        bool writeFailed = false;
+    };
+
+    CaptureState& State()
+    {
+        static CaptureState state;
+        return state;
+    }
+
+    std::atomic<int> s_NextThread{ 0 };
+    thread_local int t_Thread = -1;
+    thread_local int t_Depth = 0;
+    thread_local bool t_Preamble = false;
+    thread_local std::vector<uint8_t> t_Args;
+}
+
+static void WriterProc()
+{
+    CaptureState& state = State();
+    std::vector<uint8_t> writing;
+    std::unique_lock<std::mutex> lock(state.mutex);
+    for (;;)
+    {
+        state.wake.wait_for(lock, std::chrono::milliseconds(DARO_CAPTURE_FLUSH_MS), [&state] {
+            return state.stopRequested || state.pending.size() >= DARO_CAPTURE_FLUSH_BYTES;
+        });
+        writing.swap(state.pending);
+        bool stop = state.stopRequested;
+        FILE* file = state.file;
+        lock.unlock();
+
+        bool ok = writing.empty() || fwrite(writing.data(), 1, writing.size(), file) == writing.size();
+        writing.clear();
+
+        lock.lock();
+        if (!ok) state.writeFailed = true;
+        if (stop && state.pending.empty()) break;
+    }
+}
+
+uint64_t DaroCapture::Now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool DaroCapture::Start(const char* path)
+{
+    if (!path || !path[0]) return false;
+    CaptureState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.file) return false;
+
+    FILE* file = OpenFile(path, true);
+    if (!file) return false;
+
+    DaroCaptureHeader header = {};
+    header.magic = DARO_CAPTURE_MAGIC;
+    header.version = DARO_CAPTURE_VERSION;
+    header.headerSize = (uint32_t)sizeof(DaroCaptureHeader);
+    header.layerSize = (uint32_t)sizeof(DaroLayer);
+    header.startUnixMs = (int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header.startNs = Now();
+    if (fwrite(&header, sizeof(header), 1, file) != 1)
+    {
+        fclose(file);
+        return false;
+    }
+
+    state.file = file;
+    state.stopRequested = false;
+    state.pending.clear();
+    state.pending.reserve(DARO_CAPTURE_FLUSH_BYTES * 2);
+    state.layers.assign(sizeof(DaroLayer) * DARO_MAX_LAYERS, 0);
+    state.lastNs = header.startNs;
+    state.records = 0;
+    state.bytes = sizeof(header);
+    state.writeFailed = false;
+    state.writer = std::thread(WriterProc);
+    s_Running.store(true, std::memory_order_release);
+    return true;
+}
+
+void DaroCapture::Enable()
+{
+    CaptureState& state = State();
+    // Under the state lock so a concurrent Stop cannot be undone
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.file && !state.stopRequested)
+        s_Enabled.store(true, std::memory_order_release);
+}
+
+bool DaroCapture::Stop()
+{
+    if (!s_Running.exchange(false, std::memory_order_acq_rel)) return false;
+    CaptureState& state = State();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        s_Enabled.store(false, std::memory_order_release);
+        state.stopRequested = true;
+    }
+    state.wake.notify_one();
+    state.writer.join();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    fclose(state.file);
+    state.file = nullptr;
+    state.pending = std::vector<uint8_t>();
+    state.layers = std::vector<uint8_t>();
+#ifdef _WIN32
+    if (state.writeFailed)
+        OutputDebugStringA("[DaroEngine] Capture: write failed, the file is truncated\n");
+#endif
+    return true;
+}
+
+void DaroCapture::GetCounts(uint64_t* records, uint64_t* bytes)
+{
+    CaptureState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (records) *records = state.records;
+    if (bytes) *bytes = state.bytes;
+}
+
+void DaroCapture::SetPreamble(bool preamble)
+{
+    t_Preamble = preamble;
+}
+
+void DaroCapture::Commit(int call, uint64_t timestampNs, const uint8_t* args, size_t argsSize,
+                         int layerIndex, const DaroLayer* layer)
+{
+    if (t_Thread < 0)
+        t_Thread = s_NextThread.fetch_add(1) % DARO_CAPTURE_THREAD_PREAMBLE;
+    int thread = t_Preamble ? DARO_CAPTURE_THREAD_PREAMBLE : t_Thread;
+
+    CaptureState& state = State();
+    std::unique_lock<std::mutex> lock(state.mutex);
+    if (!state.file || state.stopRequested) return;
+
+    // Runs are taken under the lock so they apply in file order
+    state.scratch.clear();
+    if (layer && layerIndex >= 0 && layerIndex < DARO_MAX_LAYERS)
+        PutLayerRuns(state.scratch, &state.layers[sizeof(DaroLayer) * layerIndex],
+                     reinterpret_cast<const uint8_t*>(layer), sizeof(DaroLayer));
+
+    std::vector<uint8_t>& out = state.pending;
+    size_t before = out.size();
+    out.push_back((uint8_t)call);
+    out.push_back((uint8_t)thread);
+    PutVarint(out, ZigZag((int64_t)(timestampNs - state.lastNs)));
+    PutVarint(out, argsSize + state.scratch.size());
+    out.insert(out.end(), args, args + argsSize);
+    out.insert(out.end(), state.scratch.begin(), state.scratch.end());
+    state.lastNs = timestampNs;
+    state.records++;
+    state.bytes += out.size() - before;
+
+    bool flush = out.size() >= DARO_CAPTURE_FLUSH_BYTES;
+    lock.unlock();
+    if (flush) state.wake.notify_one();
+}
+
+// ============== Call scope ==============
+
+DaroCaptureCall::DaroCaptureCall(int call)
+{
+    if (!DaroCapture::IsEnabled() && !t_Preamble) return;
+    m_Nested = true;
+    if (t_Depth++ > 0) return;
+    m_Active = true;
+    m_Call = call;
+    m_Timestamp = DaroCapture::Now();
+    t_Args.clear();
+}
+
+DaroCaptureCall::~DaroCaptureCall()
+{
+    if (m_Nested) t_Depth--;
+    if (m_Active)
+        DaroCapture::Commit(m_Call, m_Timestamp, t_Args.data(), t_Args.size(), m_LayerIndex, m_Layer);
+}
+
+void DaroCaptureCall::WriteInt(long long value)
+{
+    PutVarint(t_Args, ZigZag(value));
+}
+
+void DaroCaptureCall::WriteRaw(const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    t_Args.insert(t_Args.end(), bytes, bytes + size);
+}
+
+void DaroCaptureCall::WriteStr(const char* value)
+{
+    if (!value)
+    {
+        PutVarint(t_Args, 0);
+        return;
+    }
+    size_t length = strlen(value);
+    PutVarint(t_Args, length + 1);
+    WriteRaw(value, length);
+}
+
+void DaroCaptureCall::WriteBlob(const void* data, size_t size)
+{
+    if (!data)
+    {
+        PutVarint(t_Args, 0);
+        return;
+    }
+    PutVarint(t_Args, size + 1);
+    WriteRaw(data, size);
+}
+
+const char* DaroCaptureCallName(int call)
+{
+    switch (call)
+    {
+#define DARO_CAPTURE_NAME(id, name, text, args) case id: return text;
+    DARO_CAPTURE_CALLS(DARO_CAPTURE_NAME)
+#undef DARO_CAPTURE_NAME
+    default: return nullptr;
+    }
+}
+
+const char* DaroCaptureCallArgs(int call)
+{
+    switch (call)
+    {
+#define DARO_CAPTURE_ARGS(id, name, text, args) case id: return args;
+    DARO_CAPTURE_CALLS(DARO_CAPTURE_ARGS)
+#undef DARO_CAPTURE_ARGS
+    default: return nullptr;
+    }
+}
+
+// ============== Reading ==============
+
+long long DaroCaptureArgs::Int()
+{
+    uint64_t value = 0;
+    if (!m_Valid || !GetVarint(m_Data, m_End, &value))
+    {
+        m_Valid = false;
+        return 0;
+    }
+    return (long long)UnZigZag(value);
+}
+
+bool DaroCaptureArgs::ReadRaw(void* data, size_t size)
+{
+    if (!m_Valid || (size_t)(m_End - m_Data) < size)
+    {
+        m_Valid = false;
+        memset(data, 0, size);
+        return false;
+    }
+    memcpy(data, m_Data, size);
+    m_Data += size;
+    return true;
+}
+
+float DaroCaptureArgs::Float()
+{
+    float value;
+    ReadRaw(&value, sizeof(value));
+    return value;
+}
+
+double DaroCaptureArgs::Double()
+{
+    double value;
+    ReadRaw(&value, sizeof(value));
+    return value;
+}
+
+bool DaroCaptureArgs::Str(std::string* value)
+{
+    value->clear();
+    uint64_t length = 0;
+    if (!m_Valid || !GetVarint(m_Data, m_End, &length))
+    {
+        m_Valid = false;
+        return false;
+    }
+    if (length == 0) return false;
+    if ((uint64_t)(m_End - m_Data) < length - 1)
+    {
+        m_Valid = false;
+        return false;
+    }
+    value->assign(reinterpret_cast<const char*>(m_Data), (size_t)(length - 1));
+    m_Data += length - 1;
+    return true;
+}
+
+bool DaroCaptureArgs::Blob(std::vector<uint8_t>* value)
+{
+    value->clear();
+    uint64_t length = 0;
+    if (!m_Valid || !GetVarint(m_Data, m_End, &length))
+    {
+        m_Valid = false;
+        return false;
+    }
+    if (length == 0) return false;
+    if ((uint64_t)(m_End - m_Data) < length - 1)
+    {
+        m_Valid = false;
+        return false;
+    }
+    value->assign(m_Data, m_Data + (size_t)(length - 1));
+    m_Data += length - 1;
+    return true;
+}
+
+DaroCaptureReader::DaroCaptureReader() {}
+
+DaroCaptureReader::~DaroCaptureReader()
+{
+    Close();
+}
+
+bool DaroCaptureReader::Open(const char* path)
+{
+    Close();
+    if (!path) return false;
+    m_File = OpenFile(path, false);
+    if (!m_File) return false;
+
+    // Accept larger headers from newer writers; fields are only appended
+    if (fread(&m_Header, sizeof(m_Header), 1, m_File) != 1 ||
+        m_Header.magic != DARO_CAPTURE_MAGIC || m_Header.version != DARO_CAPTURE_VERSION ||
+        m_Header.headerSize < sizeof(m_Header) || m_Header.layerSize == 0 ||
+        fseek(m_File, (long)m_Header.headerSize, SEEK_SET) != 0)
+    {
+        Close();
+        return false;
+    }
+    m_Layers.assign(DARO_MAX_LAYERS, std::vector<uint8_t>(m_Header.layerSize, 0));
+    return true;
+}
+
+void DaroCaptureReader::Close()
+{
+    if (m_File) fclose(m_File);
+    m_File = nullptr;
+    m_Header = {};
+    m_Layers.clear();
+    m_Timestamp = 0;
+    m_Truncated = false;
+}
+
+bool DaroCaptureReader::ReadVarint(uint64_t* value)
+{
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        int c = fgetc(m_File);
+        if (c == EOF) return false;
+        result |= (uint64_t)(c & 0x7F) << shift;
+        if (!(c & 0x80))
+        {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DaroCaptureReader::Next(DaroCaptureEvent* event)
+{
+    if (!m_File || m_Truncated) return false;
+
+    int call = fgetc(m_File);
+    if (call == EOF) return false;
+    int thread = fgetc(m_File);
+    uint64_t delta = 0, size = 0;
+    if (thread == EOF || !ReadVarint(&delta) || !ReadVarint(&size) || size > (64u << 20))
+    {
+        m_Truncated = true;
+        return false;
+    }
+    m_Record.resize((size_t)size);
+    if (size > 0 && fread(m_Record.data(), 1, (size_t)size, m_File) != size)
+    {
+        m_Truncated = true;
+        return false;
+    }
+    m_Timestamp += UnZigZag(delta);
+
+    event->call = call;
+    event->thread = thread;
+    event->timestampNs = m_Timestamp > 0 ? (uint64_t)m_Timestamp : 0;
+    event->args = m_Record.data();
+    event->argsSize = m_Record.size();
+    event->layerIndex = -1;
+    event->layer = nullptr;
+    event->layerChangedBytes = 0;
+    const char* signature = DaroCaptureCallArgs(call);
+    const char* runs = signature ? strchr(signature, 'L') : nullptr;
+    if (!runs) return true;
+
+    // Integer arguments ending with the layer index (and the result, which is written
+    // before the runs), then layer runs to the end of the record
+    const uint8_t* data = m_Record.data();
+    const uint8_t* end = data + m_Record.size();
+    uint64_t index = 0;
+    for (const char* c = signature; c < runs; c++)
+    {
+        uint64_t value = 0;
+        if (!GetVarint(data, end, &value)) return true;
+        if (*c != 'R') index = value;
+    }
+    event->argsSize = (size_t)(data - m_Record.data());
+    if ((int64_t)UnZigZag(index) < 0 || UnZigZag(index) >= DARO_MAX_LAYERS) return true;
+
+    std::vector<uint8_t>& layer = m_Layers[(size_t)UnZigZag(index)];
+    size_t pos = 0;
+    while (data < end)
+    {
+        uint64_t skip = 0, length = 0;
+        if (!GetVarint(data, end, &skip) || !GetVarint(data, end, &length) ||
+            (uint64_t)(end - data) < length || pos + skip + length > layer.size())
+        {
+            m_Truncated = true;
+            return false;
+        }
+        pos += (size_t)skip;
+        memcpy(&layer[pos], data, (size_t)length);
+        data += length;
+        pos += (size_t)length;
+        event->layerChangedBytes += (uint32_t)length;
+    }
+    event->layerIndex = (int)UnZigZag(index);
+    event->layer = layer.data();
+    return true;
+}
@@ -0,0 +1,354 @@
+// Engine/Capture.h
+// Opt-in capture of the exported API for reproducing stutter offline.
+// Every Daro_* call is recorded with its arguments, payloads (layer structs, paths)
+// and a steady-clock timestamp into a compact binary file; Benchmarks/Replay drives
+// an engine from the file with the recorded timing or as fast as possible.
+//
+// A call appends its record to an in-memory buffer under a short lock and a writer
+// thread flushes the buffer to disk, so no call waits on file I/O. When capture is
+// off a call costs one relaxed load and a branch. Only the outermost export on a
+// thread is recorded (Daro_SeekToTime calling Daro_SeekToFrame is one call).
+//
+// Like StatsBlock.h, this file and Capture.cpp have no Windows or D3D dependencies;
+// DaroCaptureReader can be compiled directly into external tools.
+//
+// File layout (little endian): DaroCaptureHeader, then one record per call:
+//   u8 call, u8 thread, varint zigzag(timestamp - previous timestamp in ns),
+//   varint size, arguments
+// Arguments are written in declaration order: integers and bools as zigzag varints,
+// floats and doubles as raw IEEE bytes, strings and byte blobs as varint (length + 1)
+// and the bytes (0 = null). Out-pointer arguments are not recorded. Calls that hand out ids append
+// the returned id, so a replay can map recorded ids to its own. Daro_UpdateLayer
+// stores the layer as runs of (varint skip, varint length, bytes) changed against the
+// layer last recorded at that index, so animating a few fields costs a few bytes.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "SharedTypes.h"
+
+#define DARO_CAPTURE_MAGIC 0x50414344u      // "DCAP"
+#define DARO_CAPTURE_VERSION 1
+
+// Records written while the capture starts, describing the engine state at that
+// moment (see Daro_StartCapture), carry this thread index
+#define DARO_CAPTURE_THREAD_PREAMBLE 0xFF
+
+#define DARO_CAPTURE_FLUSH_BYTES    (1u << 20)  // Wake the writer early past this
+#define DARO_CAPTURE_FLUSH_MS       100
+
+// Call ids are stored in capture files: never renumber, only append. RenderLoopFrame is
+// not an export: it stands for one frame of the native render loop.
+// The last column lists the recorded arguments in order: i integer, b bool, f float,
+// d double, s string, x byte blob, L layer runs (Daro_UpdateLayer; the integer before it is the
+// layer index, only integers and R may precede it and it comes last), R returned value.
+#define DARO_CAPTURE_CALLS(X) \
+    X(1, INITIALIZE, "Daro_Initialize", "iid") \
+    X(2, SHUTDOWN, "Daro_Shutdown", "") \
+    X(3, IS_INITIALIZED, "Daro_IsInitialized", "") \
+    X(4, GET_LAST_ERROR, "Daro_GetLastError", "") \
+    X(5, BEGIN_FRAME, "Daro_BeginFrame", "") \
+    X(6, END_FRAME, "Daro_EndFrame", "") \
+    X(7, RENDER, "Daro_Render", "") \
+    X(8, PRESENT, "Daro_Present", "") \
+    X(9, LOCK_FRAME_BUFFER, "Daro_LockFrameBuffer", "R") \
+    X(10, UNLOCK_FRAME_BUFFER, "Daro_UnlockFrameBuffer", "") \
+    X(11, GET_FRAME_NUMBER, "Daro_GetFrameNumber", "") \
+    X(12, SET_LAYER_COUNT, "Daro_SetLayerCount", "i") \
+    X(13, UPDATE_LAYER, "Daro_UpdateLayer", "iL") \
+    X(14, GET_LAYER, "Daro_GetLayer", "i") \
+    X(15, CLEAR_LAYERS, "Daro_ClearLayers", "") \
+    X(16, PLAY, "Daro_Play", "") \
+    X(17, STOP, "Daro_Stop", "") \
+    X(18, SEEK_TO_FRAME, "Daro_SeekToFrame", "i") \
+    X(19, SEEK_TO_TIME, "Daro_SeekToTime", "f") \
+    X(20, IS_PLAYING, "Daro_IsPlaying", "") \
+    X(21, GET_CURRENT_FRAME, "Daro_GetCurrentFrame", "") \
+    X(22, GET_FPS, "Daro_GetFPS", "") \
+    X(23, GET_FRAME_TIME, "Daro_GetFrameTime", "") \
+    X(24, GET_DROPPED_FRAMES, "Daro_GetDroppedFrames", "") \
+    X(25, GET_LATE_FRAMES, "Daro_GetLateFrames", "") \
+    X(26, GET_FRAME_STATS, "Daro_GetFrameStats", "i") \
+    X(27, GET_TIMING_SUMMARY, "Daro_GetTimingSummary", "ii") \
+    X(28, SET_TIMING_WINDOW, "Daro_SetTimingWindow", "i") \
+    X(29, RESET_TIMING_STATS, "Daro_ResetTimingStats", "") \
+    X(30, START_TRACE, "Daro_StartTrace", "") \
+    X(31, STOP_TRACE, "Daro_StopTrace", "") \
+    X(32, IS_TRACE_ENABLED, "Daro_IsTraceEnabled", "") \
+    X(33, WRITE_TRACE, "Daro_WriteTrace", "si") \
+    X(34, ENABLE_SPOUT_OUTPUT, "Daro_EnableSpoutOutput", "s") \
+    X(35, DISABLE_SPOUT_OUTPUT, "Daro_DisableSpoutOutput", "") \
+    X(36, IS_SPOUT_ENABLED, "Daro_IsSpoutEnabled", "") \
+    X(37, SET_SPOUT_SEND_TIMEOUT, "Daro_SetSpoutSendTimeout", "i") \
+    X(38, GET_SPOUT_OUTPUT_STATS, "Daro_GetSpoutOutputStats", "") \
+    X(39, SET_OUTPUT_METADATA, "Daro_SetOutputMetadata", "ss") \
+    X(40, ENABLE_FRAME_TRANSPORT, "Daro_EnableFrameTransport", "s") \
+    X(41, DISABLE_FRAME_TRANSPORT, "Daro_DisableFrameTransport", "") \
+    X(42, IS_FRAME_TRANSPORT_ENABLED, "Daro_IsFrameTransportEnabled", "") \
+    X(43, ENABLE_STATS_BLOCK, "Daro_EnableStatsBlock", "si") \
+    X(44, DISABLE_STATS_BLOCK, "Daro_DisableStatsBlock", "") \
+    X(45, IS_STATS_BLOCK_ENABLED, "Daro_IsStatsBlockEnabled", "") \
+    X(46, LOAD_TEXTURE, "Daro_LoadTexture", "sR") \
+    X(47, UNLOAD_TEXTURE, "Daro_UnloadTexture", "i") \
+    X(48, GET_SPOUT_SENDER_COUNT, "Daro_GetSpoutSenderCount", "") \
+    X(49, GET_SPOUT_SENDER_NAME, "Daro_GetSpoutSenderName", "ii") \
+    X(50, CONNECT_SPOUT_RECEIVER, "Daro_ConnectSpoutReceiver", "sR") \
+    X(51, DISCONNECT_SPOUT_RECEIVER, "Daro_DisconnectSpoutReceiver", "i") \
+    X(52, GET_SPOUT_RECEIVER_STATS, "Daro_GetSpoutReceiverStats", "i") \
+    X(53, GET_SPOUT_RECEIVER_METADATA, "Daro_GetSpoutReceiverMetadata", "i") \
+    X(54, GET_STRUCT_SIZE, "Daro_GetStructSize", "") \
+    X(55, GET_OFFSET_POS_X, "Daro_GetOffsetPosX", "") \
+    X(56, GET_OFFSET_SIZE_X, "Daro_GetOffsetSizeX", "") \
+    X(57, GET_OFFSET_OPACITY, "Daro_GetOffsetOpacity", "") \
+    X(58, GET_OFFSET_TEXT_CONTENT, "Daro_GetOffsetTextContent", "") \
+    X(59, SET_SHOW_BOUNDS, "Daro_SetShowBounds", "b") \
+    X(60, SET_LAYER_COST_ENABLED, "Daro_SetLayerCostEnabled", "b") \
+    X(61, GET_LAYER_COSTS, "Daro_GetLayerCosts", "i") \
+    X(62, GET_LAYER_COST, "Daro_GetLayerCost", "i") \
+    X(63, GET_MEMORY_STATS, "Daro_GetMemoryStats", "i") \
+    X(64, GET_MEMORY_ASSETS, "Daro_GetMemoryAssets", "ii") \
+    X(65, SET_MEMORY_BUDGET, "Daro_SetMemoryBudget", "ii") \
+    X(66, IS_MEMORY_OVER_BUDGET, "Daro_IsMemoryOverBudget", "i") \
+    X(67, RESET_MEMORY_PEAKS, "Daro_ResetMemoryPeaks", "") \
+    X(68, IS_DEVICE_LOST, "Daro_IsDeviceLost", "") \
+    X(69, SET_EDGE_SMOOTHING, "Daro_SetEdgeSmoothing", "f") \
+    X(70, GET_EDGE_SMOOTHING, "Daro_GetEdgeSmoothing", "") \
+    X(71, LOAD_VIDEO, "Daro_LoadVideo", "sR") \
+    X(72, UNLOAD_VIDEO, "Daro_UnloadVideo", "i") \
+    X(73, PLAY_VIDEO, "Daro_PlayVideo", "i") \
+    X(74, PAUSE_VIDEO, "Daro_PauseVideo", "i") \
+    X(75, STOP_VIDEO, "Daro_StopVideo", "i") \
+    X(76, SEEK_VIDEO, "Daro_SeekVideo", "ii") \
+    X(77, SEEK_VIDEO_TIME, "Daro_SeekVideoTime", "id") \
+    X(78, IS_VIDEO_PLAYING, "Daro_IsVideoPlaying", "i") \
+    X(79, GET_VIDEO_FRAME, "Daro_GetVideoFrame", "i") \
+    X(80, GET_VIDEO_TOTAL_FRAMES, "Daro_GetVideoTotalFrames", "i") \
+    X(81, SET_VIDEO_LOOP, "Daro_SetVideoLoop", "ib") \
+    X(82, SET_VIDEO_ALPHA, "Daro_SetVideoAlpha", "ib") \
+    X(83, SET_VIRTUAL_CLOCK, "Daro_SetVirtualClock", "b") \
+    X(84, IS_VIRTUAL_CLOCK, "Daro_IsVirtualClock", "") \
+    X(85, ADVANCE_CLOCK, "Daro_AdvanceClock", "d") \
+    X(86, ADVANCE_CLOCK_FRAMES, "Daro_AdvanceClockFrames", "i") \
+    X(87, GET_CLOCK_TIME, "Daro_GetClockTime", "") \
+    X(88, WAIT_FOR_FRAME, "Daro_WaitForFrame", "ii") \
+    X(89, START_RENDER_LOOP, "Daro_StartRenderLoop", "dR") \
+    X(90, STOP_RENDER_LOOP, "Daro_StopRenderLoop", "") \
+    X(91, IS_RENDER_LOOP_RUNNING, "Daro_IsRenderLoopRunning", "") \
+    X(92, GET_RENDER_LOOP_STATS, "Daro_GetRenderLoopStats", "") \
+    X(93, LOCK_RENDER_LOOP, "Daro_LockRenderLoop", "") \
+    X(94, UNLOCK_RENDER_LOOP, "Daro_UnlockRenderLoop", "") \
+    X(95, RENDER_LOOP_FRAME, "RenderLoopFrame", "") \
+    X(96, SET_FRAME_RATE, "Daro_SetFrameRate", "iiR") \
+    X(97, GET_FRAME_RATE, "Daro_GetFrameRate", "") \
+    X(98, SET_DROP_FRAME_TIMECODE, "Daro_SetDropFrameTimecode", "b") \
+    X(99, IS_DROP_FRAME_TIMECODE, "Daro_IsDropFrameTimecode", "") \
+    X(100, SET_EXTERNAL_CLOCK, "Daro_SetExternalClock", "sR") \
+    X(101, GET_GENLOCK_STATS, "Daro_GetGenlockStats", "") \
+    X(102, START_TICK_GENERATOR, "Daro_StartTickGenerator", "siidR") \
+    X(103, STOP_TICK_GENERATOR, "Daro_StopTickGenerator", "") \
+    X(104, QUEUE_LAYER_UPDATE, "Daro_QueueLayerUpdate", "iiiRL") \
+    X(105, QUEUE_COMMAND, "Daro_QueueCommand", "iiiiiR") \
+    X(106, BEGIN_COMMAND_BATCH, "Daro_BeginCommandBatch", "") \
+    X(107, END_COMMAND_BATCH, "Daro_EndCommandBatch", "iiR") \
+    X(108, GET_COMMAND_QUEUE_STATS, "Daro_GetCommandQueueStats", "") \
+    X(109, SUBMIT, "Daro_Submit", "xx") \
+    X(110, SET_SCENE_LAYER_COUNT, "Daro_SetSceneLayerCount", "ii") \
+    X(111, UPDATE_SCENE_LAYER, "Daro_UpdateSceneLayer", "iiL") \
+    X(112, GET_SCENE_LAYER, "Daro_GetSceneLayer", "ii") \
+    X(113, GET_SCENE_LAYER_COUNT, "Daro_GetSceneLayerCount", "i") \
+    X(114, CLEAR_SCENE, "Daro_ClearScene", "i") \
+    X(115, COPY_SCENE, "Daro_CopyScene", "ii") \
+    X(116, TAKE_SCENE, "Daro_TakeScene", "i") \
+    X(117, GET_PROGRAM_SLOT, "Daro_GetProgramSlot", "") \
+    X(118, SET_PREVIEW_SLOT, "Daro_SetPreviewSlot", "i") \
+    X(119, GET_PREVIEW_SLOT, "Daro_GetPreviewSlot", "") \
+    X(120, ENABLE_PREVIEW_OUTPUT, "Daro_EnablePreviewOutput", "si") \
+    X(121, DISABLE_PREVIEW_OUTPUT, "Daro_DisablePreviewOutput", "") \
+    X(122, IS_PREVIEW_OUTPUT_ENABLED, "Daro_IsPreviewOutputEnabled", "") \
+    X(123, TRANSITION_SCENE, "Daro_TransitionScene", "ix") \
+    X(124, QUEUE_TRANSITION, "Daro_QueueTransition", "iiixR") \
+    X(125, GET_TRANSITION_STATE, "Daro_GetTransitionState", "") \
+    X(126, SET_TIMELINE_TRACK, "Daro_SetTimelineTrack", "iiixi") \
+    X(127, SET_TIMELINE_MARKERS, "Daro_SetTimelineMarkers", "ixi") \
+    X(128, SET_TIMELINE_LENGTH, "Daro_SetTimelineLength", "ii") \
+    X(129, CLEAR_TIMELINE, "Daro_ClearTimeline", "i") \
+    X(130, PLAY_TIMELINE, "Daro_PlayTimeline", "i") \
+    X(131, STOP_TIMELINE, "Daro_StopTimeline", "i") \
+    X(132, SEEK_TIMELINE, "Daro_SeekTimeline", "ii") \
+    X(133, CONTINUE_TIMELINE, "Daro_ContinueTimeline", "i") \
+    X(134, GET_TIMELINE_STATE, "Daro_GetTimelineState", "i") \
+    X(135, GET_DATA_KEY, "Daro_GetDataKey", "sR") \
+    X(136, SET_DATA_NUMBERS, "Daro_SetDataNumbers", "xxiR") \
+    X(137, SET_DATA_TEXTS, "Daro_SetDataTexts", "xxiR") \
+    X(138, BIND_LAYER_FIELD, "Daro_BindLayerField", "iiii") \
+    X(139, CLEAR_DATA_BINDINGS, "Daro_ClearDataBindings", "i") \
+    X(140, ENABLE_DATA_INGEST, "Daro_EnableDataIngest", "si") \
+    X(141, DISABLE_DATA_INGEST, "Daro_DisableDataIngest", "") \
+    X(142, GET_DATA_STORE_STATS, "Daro_GetDataStoreStats", "")
+
+#define DARO_CAPTURE_ENUM(id, name, text, args) DARO_CALL_##name = id,
+enum DaroCaptureCallId { DARO_CAPTURE_CALLS(DARO_CAPTURE_ENUM) };
+#undef DARO_CAPTURE_ENUM
+
+// Export name and argument signature of a call id, or nullptr if unknown
+const char* DaroCaptureCallName(int call);
+const char* DaroCaptureCallArgs(int call);
+
+#pragma pack(push, 1)
+struct DaroCaptureHeader
+{
+    uint32_t magic;                 // DARO_CAPTURE_MAGIC
+    uint32_t version;               // DARO_CAPTURE_VERSION
+    uint32_t headerSize;            // Records start here
+    uint32_t layerSize;             // sizeof(DaroLayer) of the capturing engine
+    int64_t startUnixMs;            // Wall clock when the capture started
+    uint64_t startNs;               // Steady clock the first timestamp delta is taken from
+};
+#pragma pack(pop)
+
+class DaroCapture
+{
+public:
+    static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+
+    // Create the file and start the writer. Nothing is recorded until Enable, so the
+    // caller can write a preamble (see SetPreamble) before other threads' calls land.
+    // Fails if a capture is already running.
+    static bool Start(const char* path);
+    // Record calls from every thread. No-op unless a capture is running.
+    static void Enable();
+    // Flush and close the file. Returns false if no capture was running; concurrent
+    // callers are safe, only one of them joins the writer.
+    static bool Stop();
+    // Records committed and bytes written (including pending) by the running or last capture
+    static void GetCounts(uint64_t* records, uint64_t* bytes);
+
+    // While set, calls on the calling thread are recorded even before Enable, and are
+    // marked DARO_CAPTURE_THREAD_PREAMBLE
+    static void SetPreamble(bool preamble);
+
+    // Steady clock in nanoseconds
+    static uint64_t Now();
+
+    // Called by DaroCaptureCall
+    static void Commit(int call, uint64_t timestampNs, const uint8_t* args, size_t argsSize,
+                       int layerIndex, const DaroLayer* layer);
+
+private:
+    static inline std::atomic<bool> s_Enabled{ false };
+    static inline std::atomic<bool> s_Running{ false };
+};
+
+// Records one call when capture is on. Declare it first in an export so it is
+// committed after every lock the export takes has been released.
+class DaroCaptureCall
+{
+public:
+    explicit DaroCaptureCall(int call);
+    ~DaroCaptureCall();
+
+    DaroCaptureCall(const DaroCaptureCall&) = delete;
+    DaroCaptureCall& operator=(const DaroCaptureCall&) = delete;
+
+    DaroCaptureCall& Int(long long value) { if (m_Active) WriteInt(value); return *this; }
+    DaroCaptureCall& Bool(bool value) { if (m_Active) WriteInt(value ? 1 : 0); return *this; }
+    DaroCaptureCall& Float(float value) { if (m_Active) WriteRaw(&value, sizeof(value)); return *this; }
+    DaroCaptureCall& Double(double value) { if (m_Active) WriteRaw(&value, sizeof(value)); return *this; }
+    DaroCaptureCall& Str(const char* value) { if (m_Active) WriteStr(value); return *this; }
+    DaroCaptureCall& Blob(const void* data, size_t size) { if (m_Active) WriteBlob(data, size); return *this; }
+    // Written after all other arguments, diffed against the last layer at this index
+    DaroCaptureCall& Layer(int index, const DaroLayer* layer)
+    {
+        if (m_Active) { m_LayerIndex = index; m_Layer = layer; }
+        return *this;
+    }
+
+    // Append the returned value (ids handed out, lock results) and pass it through
+    int Result(int value) { if (m_Active) WriteInt(value); return value; }
+    bool Result(bool value) { if (m_Active) WriteInt(value ? 1 : 0); return value; }
+    long long Result(long long value) { if (m_Active) WriteInt(value); return value; }
+
+private:
+    void WriteInt(long long value);
+    void WriteRaw(const void* data, size_t size);
+    void WriteStr(const char* value);
+    void WriteBlob(const void* data, size_t size);
+
+    bool m_Active = false;
+    bool m_Nested = false;          // Counted in the thread's export depth
+    int m_Call = 0;
+    uint64_t m_Timestamp = 0;
+    int m_LayerIndex = -1;
+    const DaroLayer* m_Layer = nullptr;
+};
+
+// ---- Reading ----
+
+struct DaroCaptureEvent
+{
+    int call;
+    int thread;                     // Capturing thread index or DARO_CAPTURE_THREAD_PREAMBLE
+    uint64_t timestampNs;           // Since DaroCaptureHeader::startNs; records from different
+                                    // threads are in commit order, so this is not monotonic
+    const uint8_t* args;            // Valid until the next Next()
+    size_t argsSize;                // Excludes the layer runs of calls with an L argument
+    int layerIndex;                 // Calls with an L argument only, else -1
+    const uint8_t* layer;           // Full layer after the update (header.layerSize bytes)
+    uint32_t layerChangedBytes;     // Bytes that differed from the previous layer at this index
+};
+
+// Sequential decoder for the arguments of one event
+class DaroCaptureArgs
+{
+public:
+    DaroCaptureArgs(const uint8_t* data, size_t size) : m_Data(data), m_End(data + size) {}
+
+    long long Int();
+    bool Bool() { return Int() != 0; }
+    float Float();
+    double Double();
+    // Returns false for a null string
+    bool Str(std::string* value);
+    // Returns false for a null blob
+    bool Blob(std::vector<uint8_t>* value);
+    // False once a read ran past the end of the arguments
+    bool IsValid() const { return m_Valid; }
+
+private:
+    bool ReadRaw(void* data, size_t size);
+
+    const uint8_t* m_Data;
+    const uint8_t* m_End;
+    bool m_Valid = true;
+};
+
+class DaroCaptureReader
+{
+public:
+    DaroCaptureReader();
+    ~DaroCaptureReader();
+
+    DaroCaptureReader(const DaroCaptureReader&) = delete;
+    DaroCaptureReader& operator=(const DaroCaptureReader&) = delete;
+
+    bool Open(const char* path);
+    void Close();
+    const DaroCaptureHeader& GetHeader() const { return m_Header; }
+
+    // False at the end of the file or on a truncated record (see IsTruncated)
+    bool Next(DaroCaptureEvent* event);
+    bool IsTruncated() const { return m_Truncated; }
+
+private:
+    bool ReadVarint(uint64_t* value);
+
+    FILE* m_File = nullptr;
+    DaroCaptureHeader m_Header = {};
+    std::vector<uint8_t> m_Record;
+    std::vector<std::vector<uint8_t>> m_Layers;     // Last layer per index
+    int64_t m_Timestamp = 0;
+    bool m_Truncated = false;
+};
@@ -0,0 +1,75 @@
+// Engine/Clock.cpp
+#include "Clock.h"
+#include <chrono>
+
+DaroClock& DaroClock::Instance()
+{
+    static DaroClock instance;
+    return instance;
+}
+
+int64_t DaroClock::RealNow()
+{
+    return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t DaroClock::Now() const
+{
+    if (m_Virtual.load(std::memory_order_acquire))
+        return m_VirtualNs.load(std::memory_order_acquire);
+    return RealNow() + m_RealOffsetNs.load(std::memory_order_relaxed);
+}
+
+void DaroClock::SetVirtual(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (enabled == m_Virtual.load(std::memory_order_relaxed)) return;
+
+    if (enabled)
+    {
+        m_VirtualNs.store(Now(), std::memory_order_relaxed);
+        m_CarryNs = 0.0;
+        m_RemainderNum = 0;
+        m_RemainderDen = 1;
+        m_Virtual.store(true, std::memory_order_release);
+    }
+    else
+    {
+        // Real time may be ahead of or behind the virtual time; continue from it either way
+        m_RealOffsetNs.store(m_VirtualNs.load(std::memory_order_relaxed) - RealNow(), std::memory_order_relaxed);
+        m_Virtual.store(false, std::memory_order_release);
+    }
+}
+
+void DaroClock::Advance(double nanoseconds)
+{
+    if (!(nanoseconds > 0.0)) return;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_Virtual.load(std::memory_order_relaxed)) return;
+
+    double total = nanoseconds + m_CarryNs;
+    int64_t whole = (int64_t)total;
+    m_CarryNs = total - (double)whole;
+    m_VirtualNs.fetch_add(whole, std::memory_order_release);
+}
+
+void DaroClock::AdvanceFraction(int64_t numeratorNs, int64_t denominator)
+{
+    if (numeratorNs <= 0 || denominator <= 0) return;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (!m_Virtual.load(std::memory_order_relaxed)) return;
+
+    // A different denominator (the frame rate changed) starts a new remainder; the old one
+    // is under a nanosecond
+    if (denominator != m_RemainderDen)
+    {
+        m_RemainderNum = 0;
+        m_RemainderDen = denominator;
+    }
+    int64_t whole = numeratorNs / denominator;
+    m_RemainderNum += numeratorNs % denominator;
+    whole += m_RemainderNum / denominator;
+    m_RemainderNum %= denominator;
+    m_VirtualNs.fetch_add(whole, std::memory_order_release);
+}
@@ -0,0 +1,50 @@
+// Engine/Clock.h
+// Engine timeline. Everything that decides what is shown at a point in time - video
+// frame selection, the output slot grid behind dropped-frame accounting, FPS and the
+// frame interval stats - reads time from here instead of the OS clock. A host or test
+// can switch to a virtual clock that only moves when told to (Daro_SetVirtualClock,
+// Daro_AdvanceClock), so frames render faster or slower than real time and the same
+// sequence of calls always selects the same video frames.
+//
+// Measurements of work stay on the real clock: stage timers and late frames (busy time
+// against the frame period), traces, Spout send timeouts and transport timestamps.
+//
+// No Windows or D3D dependencies.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+class DaroClock
+{
+public:
+    static DaroClock& Instance();
+
+    // Nanoseconds on the engine timeline. Never goes backwards, also across mode switches.
+    int64_t Now() const;
+
+    // Virtual time starts where the timeline is when it is enabled; real time
+    // continues from the virtual time when it is disabled
+    void SetVirtual(bool enabled);
+    bool IsVirtual() const { return m_Virtual.load(std::memory_order_acquire); }
+
+    // Move virtual time forward (ignored on the real clock). Fractions of a nanosecond
+    // carry over, so stepping by 1/59.94 s does not drift.
+    void Advance(double nanoseconds);
+    // Move virtual time forward by numeratorNs / denominator nanoseconds, exactly: the
+    // remainder is kept as an integer, so frame periods such as 1001/60000 s never drift
+    void AdvanceFraction(int64_t numeratorNs, int64_t denominator);
+
+private:
+    DaroClock() = default;
+    static int64_t RealNow();
+
+    std::atomic<bool> m_Virtual{ false };
+    std::atomic<int64_t> m_VirtualNs{ 0 };
+    std::atomic<int64_t> m_RealOffsetNs{ 0 };   // Added to the steady clock after leaving virtual time
+    std::mutex m_Mutex;                         // Serializes SetVirtual and Advance
+    double m_CarryNs = 0.0;
+    int64_t m_RemainderNum = 0;                 // Pending fraction of a nanosecond for AdvanceFraction
+    int64_t m_RemainderDen = 1;
+};
@@ -0,0 +1,269 @@
+// Engine/CommandBuffer.cpp
+#include "CommandBuffer.h"
+#include <cstring>
+
+static int ReadInt(const uint8_t* p)
+{
+    int32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Length of the string at p including its NUL, 0 if it is not terminated within size
+static size_t StringSize(const uint8_t* p, size_t size)
+{
+    const void* end = size ? memchr(p, 0, size) : nullptr;
+    return end ? (size_t)(static_cast<const uint8_t*>(end) - p) + 1 : 0;
+}
+
+bool DaroSubmitOpTakesTexture(int op)
+{
+    return op == DARO_OP_UNLOAD_TEXTURE;
+}
+
+bool DaroSubmitOpTakesVideo(int op)
+{
+    switch (op)
+    {
+    case DARO_OP_UNLOAD_VIDEO:
+    case DARO_OP_PLAY_VIDEO:
+    case DARO_OP_PAUSE_VIDEO:
+    case DARO_OP_STOP_VIDEO:
+    case DARO_OP_SEEK_VIDEO:
+    case DARO_OP_SEEK_VIDEO_TIME:
+    case DARO_OP_SET_VIDEO_LOOP:
+    case DARO_OP_SET_VIDEO_ALPHA:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Fill the operand fields from the payload; returns the command's status
+static int Decode(DaroSubmitCommand* command)
+{
+    const uint8_t* p = command->payload;
+    const size_t size = command->payloadSize;
+    switch (command->op)
+    {
+    case DARO_OP_CLEAR_LAYERS:
+    case DARO_OP_PLAY:
+    case DARO_OP_STOP:
+    case DARO_OP_CONTINUE_TIMELINE:
+        return DARO_SUBMIT_OK;
+
+    case DARO_OP_SET_LAYER_COUNT:
+    case DARO_OP_UNLOAD_TEXTURE:
+    case DARO_OP_UNLOAD_VIDEO:
+    case DARO_OP_PLAY_VIDEO:
+    case DARO_OP_PAUSE_VIDEO:
+    case DARO_OP_STOP_VIDEO:
+    case DARO_OP_SEEK_TO_FRAME:
+    case DARO_OP_EDIT_SCENE:
+    case DARO_OP_TAKE_SCENE:
+        if (size < 4) return DARO_SUBMIT_ERROR_MALFORMED;
+        command->id = ReadInt(p);
+        return DARO_SUBMIT_OK;
+
+    case DARO_OP_SEEK_VIDEO:
+    case DARO_OP_SET_VIDEO_LOOP:
+    case DARO_OP_SET_VIDEO_ALPHA:
+        if (size < 8) return DARO_SUBMIT_ERROR_MALFORMED;
+        command->id = ReadInt(p);
+        command->value = ReadInt(p + 4);
+        return DARO_SUBMIT_OK;
+
+    case DARO_OP_SEEK_VIDEO_TIME:
+        if (size < 4 + sizeof(double)) return DARO_SUBMIT_ERROR_MALFORMED;
+        command->id = ReadInt(p);
+        memcpy(&command->seconds, p + 4, sizeof(double));
+        return DARO_SUBMIT_OK;
+
+    case DARO_OP_UPDATE_LAYER:
+        if (size < 4 + sizeof(DaroLayer)) return DARO_SUBMIT_ERROR_MALFORMED;
+        command->id = ReadInt(p);
+        command->layer = reinterpret_cast<const DaroLayer*>(p + 4);
+        return DARO_SUBMIT_OK;
+
+    case DARO_OP_TRANSITION_SCENE:
+        if (size < 4 + sizeof(DaroTransition)) return DARO_SUBMIT_ERROR_MALFORMED;
+        command->id = ReadInt(p);
+        command->transition = reinterpret_cast<const DaroTransition*>(p + 4);
+        return DARO_SUBMIT_OK;
+
+    case DARO_OP_LOAD_TEXTURE:
+    case DARO_OP_LOAD_VIDEO:
+        if (!StringSize(p, size)) return DARO_SUBMIT_ERROR_MALFORMED;
+        command->text = reinterpret_cast<const char*>(p);
+        return DARO_SUBMIT_OK;
+
+    case DARO_OP_SET_OUTPUT_METADATA:
+    {
+        size_t first = StringSize(p, size);
+        if (!first || !StringSize(p + first, size - first)) return DARO_SUBMIT_ERROR_MALFORMED;
+        command->text = reinterpret_cast<const char*>(p);
+        command->text2 = reinterpret_cast<const char*>(p + first);
+        return DARO_SUBMIT_OK;
+    }
+
+    default:
+        return DARO_SUBMIT_ERROR_UNKNOWN_OP;
+    }
+}
+
+bool DaroParseCommandBuffer(const void* data, size_t size, DaroSubmitHeader* header,
+                            std::vector<DaroSubmitCommand>* commands)
+{
+    commands->clear();
+    if (!data || size < sizeof(DaroSubmitHeader)) return false;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    DaroSubmitHeader h;
+    memcpy(&h, bytes, sizeof(h));
+    if (h.magic != DARO_SUBMIT_MAGIC || h.version == 0 || h.version > DARO_SUBMIT_VERSION) return false;
+    if (h.headerSize < sizeof(h) || h.headerSize > size) return false;
+    // Every record is at least a record header - refuse counts the buffer cannot hold
+    // before reserving for them
+    if (h.commandCount > DARO_SUBMIT_MAX_COMMANDS ||
+        h.commandCount > (size - h.headerSize) / sizeof(DaroSubmitRecord)) return false;
+
+    commands->reserve(h.commandCount);
+    size_t offset = h.headerSize;
+    for (uint32_t i = 0; i < h.commandCount; i++)
+    {
+        DaroSubmitRecord record;
+        if (size - offset < sizeof(record)) break;
+        memcpy(&record, bytes + offset, sizeof(record));
+        if (record.size < sizeof(record) || record.size > size - offset) break;
+
+        DaroSubmitCommand command = {};
+        command.op = record.op;
+        command.payload = bytes + offset + sizeof(record);
+        command.payloadSize = record.size - (uint32_t)sizeof(record);
+        command.status = Decode(&command);
+        commands->push_back(command);
+        offset += record.size;
+    }
+    // A short count or trailing bytes mean the host and engine disagree on the layout
+    if (commands->size() != h.commandCount || offset != size)
+    {
+        commands->clear();
+        return false;
+    }
+    *header = h;
+    return true;
+}
+
+// ============== Writer ==============
+
+void DaroCommandBufferWriter::Reset(unsigned int flags, int when, long long at)
+{
+    DaroSubmitHeader header = {};
+    header.magic = DARO_SUBMIT_MAGIC;
+    header.version = DARO_SUBMIT_VERSION;
+    header.headerSize = (unsigned short)sizeof(header);
+    header.flags = flags;
+    header.when = when;
+    header.at = at;
+    m_Data.resize(sizeof(header));
+    memcpy(m_Data.data(), &header, sizeof(header));
+    m_Count = 0;
+}
+
+uint8_t* DaroCommandBufferWriter::AppendRecord(int op, size_t payloadSize)
+{
+    DaroSubmitRecord record = {};
+    record.op = (unsigned short)op;
+    record.size = (unsigned int)(sizeof(record) + payloadSize);
+    size_t offset = m_Data.size();
+    m_Data.resize(offset + record.size);
+    memcpy(m_Data.data() + offset, &record, sizeof(record));
+
+    m_Count++;
+    unsigned int count = m_Count;
+    memcpy(m_Data.data() + offsetof(DaroSubmitHeader, commandCount), &count, sizeof(count));
+    return m_Data.data() + offset + sizeof(record);
+}
+
+int DaroCommandBufferWriter::AddInts(int op, int count, int a, int b)
+{
+    int32_t values[2] = { a, b };
+    uint8_t* payload = AppendRecord(op, count * sizeof(int32_t));
+    if (count > 0) memcpy(payload, values, count * sizeof(int32_t));
+    return (int)m_Count - 1;
+}
+
+int DaroCommandBufferWriter::AddStrings(int op, const char* a, const char* b)
+{
+    size_t first = strlen(a ? a : "") + 1;
+    size_t second = b ? strlen(b) + 1 : 0;
+    uint8_t* payload = AppendRecord(op, first + second);
+    memcpy(payload, a ? a : "", first);
+    if (b) memcpy(payload + first, b, second);
+    return (int)m_Count - 1;
+}
+
+int DaroCommandBufferWriter::UpdateLayer(int index, const DaroLayer* layer)
+{
+    int32_t value = index;
+    uint8_t* payload = AppendRecord(DARO_OP_UPDATE_LAYER, sizeof(value) + sizeof(DaroLayer));
+    memcpy(payload, &value, sizeof(value));
+    if (layer) memcpy(payload + sizeof(value), layer, sizeof(DaroLayer));
+    else memset(payload + sizeof(value), 0, sizeof(DaroLayer));
+    return (int)m_Count - 1;
+}
+
+int DaroCommandBufferWriter::TransitionScene(int slot, const DaroTransition* transition)
+{
+    int32_t value = slot;
+    uint8_t* payload = AppendRecord(DARO_OP_TRANSITION_SCENE, sizeof(value) + sizeof(DaroTransition));
+    memcpy(payload, &value, sizeof(value));
+    if (transition) memcpy(payload + sizeof(value), transition, sizeof(DaroTransition));
+    else memset(payload + sizeof(value), 0, sizeof(DaroTransition));
+    return (int)m_Count - 1;
+}
+
+int DaroCommandBufferWriter::SeekVideoTime(int videoId, double seconds)
+{
+    int32_t value = videoId;
+    uint8_t* payload = AppendRecord(DARO_OP_SEEK_VIDEO_TIME, sizeof(value) + sizeof(seconds));
+    memcpy(payload, &value, sizeof(value));
+    memcpy(payload + sizeof(value), &seconds, sizeof(seconds));
+    return (int)m_Count - 1;
+}
+
+int DaroCommandBufferWriter::Add(const DaroSubmitCommand& command)
+{
+    if (command.status == DARO_SUBMIT_OK)
+    {
+        switch (command.op)
+        {
+        case DARO_OP_SET_LAYER_COUNT: return SetLayerCount(command.id);
+        case DARO_OP_UPDATE_LAYER: return UpdateLayer(command.id, command.layer);
+        case DARO_OP_CLEAR_LAYERS: return ClearLayers();
+        case DARO_OP_LOAD_TEXTURE: return LoadTexture(command.text);
+        case DARO_OP_UNLOAD_TEXTURE: return UnloadTexture(command.id);
+        case DARO_OP_LOAD_VIDEO: return LoadVideo(command.text);
+        case DARO_OP_UNLOAD_VIDEO: return UnloadVideo(command.id);
+        case DARO_OP_PLAY_VIDEO: return PlayVideo(command.id);
+        case DARO_OP_PAUSE_VIDEO: return PauseVideo(command.id);
+        case DARO_OP_STOP_VIDEO: return StopVideo(command.id);
+        case DARO_OP_SEEK_VIDEO: return SeekVideo(command.id, command.value);
+        case DARO_OP_SEEK_VIDEO_TIME: return SeekVideoTime(command.id, command.seconds);
+        case DARO_OP_SET_VIDEO_LOOP: return AddInts(command.op, 2, command.id, command.value);
+        case DARO_OP_SET_VIDEO_ALPHA: return AddInts(command.op, 2, command.id, command.value);
+        case DARO_OP_SET_OUTPUT_METADATA: return SetOutputMetadata(command.text, command.text2);
+        case DARO_OP_PLAY: return Play();
+        case DARO_OP_STOP: return Stop();
+        case DARO_OP_SEEK_TO_FRAME: return SeekToFrame(command.id);
+        case DARO_OP_EDIT_SCENE: return EditScene(command.id);
+        case DARO_OP_TAKE_SCENE: return TakeScene(command.id);
+        case DARO_OP_TRANSITION_SCENE: return TransitionScene(command.id, command.transition);
+        case DARO_OP_CONTINUE_TIMELINE: return ContinueTimeline();
+        }
+    }
+    // Unknown or malformed: keep the record as it was
+    uint8_t* payload = AppendRecord(command.op, command.payloadSize);
+    if (command.payloadSize) memcpy(payload, command.payload, command.payloadSize);
+    return (int)m_Count - 1;
+}
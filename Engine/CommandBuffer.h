@@ -0,0 +1,103 @@
+// Engine/CommandBuffer.h
+// Binary command buffers for Daro_Submit. A host packs a whole playout action - layer
+// updates, asset loads, video transport - into one buffer (layout in SharedTypes.h) and
+// hands it over in a single call, instead of one interop transition and one lock per
+// operation.
+//
+// DaroParseCommandBuffer checks the framing of the whole buffer before anything runs
+// and decodes every record in place; a record that is malformed or of an unknown op is
+// marked and skipped, the others still run. DaroCommandBufferWriter builds buffers.
+//
+// Like Capture.h, this file and CommandBuffer.cpp have no Windows or D3D dependencies:
+// Benchmarks/Replay parses submitted buffers with them on any platform.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SharedTypes.h"
+
+// One decoded record. Pointers point into the parsed buffer.
+struct DaroSubmitCommand
+{
+    int op;                         // DARO_OP_*
+    int status;                     // DARO_SUBMIT_OK, or why the record cannot run
+    int id;                         // Layer index or count, texture or video id, frame, scene slot
+    int value;                      // Frame (DARO_OP_SEEK_VIDEO) or flag
+    double seconds;                 // DARO_OP_SEEK_VIDEO_TIME
+    const char* text;               // Path or template name
+    const char* text2;              // Item name
+    const DaroLayer* layer;         // Packed, so any address is aligned
+    const DaroTransition* transition; // DARO_OP_TRANSITION_SCENE, packed like layer
+    const uint8_t* payload;         // Raw payload after the record header
+    uint32_t payloadSize;
+};
+
+inline bool DaroIsSubmitRef(int id)
+{
+    return id >= DARO_SUBMIT_REF_BASE && id < DARO_SUBMIT_REF_BASE + DARO_SUBMIT_MAX_COMMANDS;
+}
+
+inline int DaroSubmitRefIndex(int id) { return id - DARO_SUBMIT_REF_BASE; }
+
+// Ops whose id operand is a texture or video id (and may be a reference)
+bool DaroSubmitOpTakesTexture(int op);
+bool DaroSubmitOpTakesVideo(int op);
+
+// False if the buffer is rejected as a whole: bad magic, newer version, short header,
+// too many commands, or a record that overruns the buffer or does not end where the
+// next begins. Nothing of a rejected buffer may run.
+bool DaroParseCommandBuffer(const void* data, size_t size, DaroSubmitHeader* header,
+                            std::vector<DaroSubmitCommand>* commands);
+
+class DaroCommandBufferWriter
+{
+public:
+    DaroCommandBufferWriter() { Reset(); }
+
+    // Start an empty buffer; when/at are used with DARO_SUBMIT_QUEUED
+    void Reset(unsigned int flags = 0, int when = DARO_WHEN_IMMEDIATE, long long at = 0);
+
+    // Returns the index of the command, for DARO_SUBMIT_REF
+    int SetLayerCount(int count) { return AddInts(DARO_OP_SET_LAYER_COUNT, 1, count, 0); }
+    int UpdateLayer(int index, const DaroLayer* layer);
+    int ClearLayers() { return AddInts(DARO_OP_CLEAR_LAYERS, 0, 0, 0); }
+    int LoadTexture(const char* path) { return AddStrings(DARO_OP_LOAD_TEXTURE, path, nullptr); }
+    int UnloadTexture(int textureId) { return AddInts(DARO_OP_UNLOAD_TEXTURE, 1, textureId, 0); }
+    int LoadVideo(const char* path) { return AddStrings(DARO_OP_LOAD_VIDEO, path, nullptr); }
+    int UnloadVideo(int videoId) { return AddInts(DARO_OP_UNLOAD_VIDEO, 1, videoId, 0); }
+    int PlayVideo(int videoId) { return AddInts(DARO_OP_PLAY_VIDEO, 1, videoId, 0); }
+    int PauseVideo(int videoId) { return AddInts(DARO_OP_PAUSE_VIDEO, 1, videoId, 0); }
+    int StopVideo(int videoId) { return AddInts(DARO_OP_STOP_VIDEO, 1, videoId, 0); }
+    int SeekVideo(int videoId, int frame) { return AddInts(DARO_OP_SEEK_VIDEO, 2, videoId, frame); }
+    int SeekVideoTime(int videoId, double seconds);
+    int SetVideoLoop(int videoId, bool loop) { return AddInts(DARO_OP_SET_VIDEO_LOOP, 2, videoId, loop ? 1 : 0); }
+    int SetVideoAlpha(int videoId, bool alpha) { return AddInts(DARO_OP_SET_VIDEO_ALPHA, 2, videoId, alpha ? 1 : 0); }
+    int SetOutputMetadata(const char* templateName, const char* itemName)
+    {
+        return AddStrings(DARO_OP_SET_OUTPUT_METADATA, templateName ? templateName : "", itemName ? itemName : "");
+    }
+    int Play() { return AddInts(DARO_OP_PLAY, 0, 0, 0); }
+    int Stop() { return AddInts(DARO_OP_STOP, 0, 0, 0); }
+    int SeekToFrame(int frame) { return AddInts(DARO_OP_SEEK_TO_FRAME, 1, frame, 0); }
+    int EditScene(int slot) { return AddInts(DARO_OP_EDIT_SCENE, 1, slot, 0); }
+    int TakeScene(int slot) { return AddInts(DARO_OP_TAKE_SCENE, 1, slot, 0); }
+    int TransitionScene(int slot, const DaroTransition* transition);
+    int ContinueTimeline() { return AddInts(DARO_OP_CONTINUE_TIMELINE, 0, 0, 0); }
+
+    // Re-encode a parsed command (its fields, not its payload, for known ops)
+    int Add(const DaroSubmitCommand& command);
+
+    const void* Data() const { return m_Data.data(); }
+    size_t Size() const { return m_Data.size(); }
+    int Count() const { return (int)m_Count; }
+
+private:
+    int AddInts(int op, int count, int a, int b);
+    int AddStrings(int op, const char* a, const char* b);
+    // Append a record header and room for its payload; returns the payload
+    uint8_t* AppendRecord(int op, size_t payloadSize);
+
+    std::vector<uint8_t> m_Data;
+    uint32_t m_Count = 0;
+};
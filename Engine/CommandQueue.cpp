@@ -0,0 +1,190 @@
+// Engine/CommandQueue.cpp
+#include "CommandQueue.h"
+#include <algorithm>
+#include <new>
+
+// Applied entries are dropped from the front of the pending list in blocks of this size
+#define DARO_COMMAND_COMPACT 64
+
+void DaroCommandChain::Append(DaroCommand* command)
+{
+    if (!command) return;
+    command->next = nullptr;
+    if (last) last->next = command;
+    else first = command;
+    last = command;
+    count++;
+}
+
+void DaroCommandChain::Splice(DaroCommandChain& other)
+{
+    if (!other.first) return;
+    if (last) last->next = other.first;
+    else first = other.first;
+    last = other.last;
+    count += other.count;
+    other.first = other.last = nullptr;
+    other.count = 0;
+}
+
+void DaroCommandChain::Free()
+{
+    while (first)
+    {
+        DaroCommand* next = first->next;
+        delete first;
+        first = next;
+    }
+    last = nullptr;
+    count = 0;
+}
+
+DaroCommandQueue::DaroCommandQueue()
+{
+    m_Stub = new DaroCommand();
+    m_Front = m_Stub;
+    m_Tail.store(m_Stub, std::memory_order_relaxed);
+}
+
+DaroCommandQueue::~DaroCommandQueue()
+{
+    Clear();
+    delete m_Stub;
+}
+
+DaroCommand* DaroCommandQueue::Allocate()
+{
+    return new (std::nothrow) DaroCommand();
+}
+
+uint64_t DaroCommandQueue::Push(DaroCommandChain& chain, int64_t frame)
+{
+    if (!chain.first) return 0;
+
+    uint64_t id = m_NextId.fetch_add((uint64_t)chain.count, std::memory_order_relaxed);
+    for (DaroCommand* command = chain.first; command; command = command->next)
+    {
+        command->id = id++;
+        command->frame = frame;
+        command->link.store(command->next, std::memory_order_relaxed);
+    }
+    DaroCommand* first = chain.first;
+    DaroCommand* last = chain.last;
+    int count = chain.count;
+    chain.first = chain.last = nullptr;
+    chain.count = 0;
+
+    // Publish: the release store makes the whole pre-linked chain visible at once
+    m_Queued.fetch_add(count, std::memory_order_relaxed);
+    m_PendingCount.fetch_add(count, std::memory_order_relaxed);
+    DaroCommand* prev = m_Tail.exchange(last, std::memory_order_acq_rel);
+    prev->link.store(first, std::memory_order_release);
+    return id - 1;
+}
+
+void DaroCommandQueue::Collect(int64_t frame)
+{
+    size_t before = m_Pending.size();
+    for (;;)
+    {
+        DaroCommand* front = m_Front;
+        DaroCommand* next = front->link.load(std::memory_order_acquire);
+        if (front == m_Stub)
+        {
+            if (!next) break;
+            m_Front = next;
+            front = next;
+            next = next->link.load(std::memory_order_acquire);
+        }
+        if (!next)
+        {
+            // front is the last node: put the stub behind it so it can be taken. If a
+            // producer has exchanged the tail but not linked yet, wait for the next frame.
+            if (front != m_Tail.load(std::memory_order_acquire)) break;
+            m_Stub->link.store(nullptr, std::memory_order_relaxed);
+            DaroCommand* prev = m_Tail.exchange(m_Stub, std::memory_order_acq_rel);
+            prev->link.store(m_Stub, std::memory_order_release);
+            next = front->link.load(std::memory_order_acquire);
+            if (!next) break;
+        }
+        m_Front = next;
+        if (front->frame < 0) front->frame = frame;     // DARO_WHEN_IMMEDIATE
+        m_Pending.push_back(front);
+    }
+
+    if (m_Pending.size() != before)
+    {
+        std::sort(m_Pending.begin() + (ptrdiff_t)m_Head, m_Pending.end(),
+            [](const DaroCommand* a, const DaroCommand* b)
+            {
+                return a->frame != b->frame ? a->frame < b->frame : a->id < b->id;
+            });
+    }
+}
+
+void DaroCommandQueue::Complete(DaroCommand* command, int64_t frame)
+{
+    if (command->frame < frame)
+    {
+        long long lateFrames = (long long)(frame - command->frame);
+        m_Late.fetch_add(1, std::memory_order_relaxed);
+        if (lateFrames > m_MaxLateFrames.load(std::memory_order_relaxed))
+            m_MaxLateFrames.store(lateFrames, std::memory_order_relaxed);
+        m_LastLateId.store((long long)command->id, std::memory_order_relaxed);
+        m_LastLateFrame.store((long long)frame, std::memory_order_relaxed);
+    }
+    m_Applied.fetch_add(1, std::memory_order_relaxed);
+    m_PendingCount.fetch_sub(1, std::memory_order_relaxed);
+    m_LastAppliedId.store((long long)command->id, std::memory_order_relaxed);
+    delete command;
+}
+
+void DaroCommandQueue::Compact()
+{
+    if (m_Head == m_Pending.size())
+    {
+        m_Pending.clear();
+        m_Head = 0;
+    }
+    else if (m_Head >= DARO_COMMAND_COMPACT)
+    {
+        m_Pending.erase(m_Pending.begin(), m_Pending.begin() + (ptrdiff_t)m_Head);
+        m_Head = 0;
+    }
+}
+
+void DaroCommandQueue::Clear()
+{
+    Collect(0);
+    for (size_t i = m_Head; i < m_Pending.size(); i++)
+    {
+        delete m_Pending[i];
+        m_PendingCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    m_Pending.clear();
+    m_Head = 0;
+}
+
+void DaroCommandQueue::GetStats(DaroCommandQueueStats* stats) const
+{
+    if (!stats) return;
+    stats->queued = m_Queued.load(std::memory_order_relaxed);
+    stats->applied = m_Applied.load(std::memory_order_relaxed);
+    stats->pending = m_PendingCount.load(std::memory_order_relaxed);
+    stats->late = m_Late.load(std::memory_order_relaxed);
+    stats->maxLateFrames = m_MaxLateFrames.load(std::memory_order_relaxed);
+    stats->lastLateId = m_LastLateId.load(std::memory_order_relaxed);
+    stats->lastLateFrame = m_LastLateFrame.load(std::memory_order_relaxed);
+    stats->lastAppliedId = m_LastAppliedId.load(std::memory_order_relaxed);
+}
+
+void DaroCommandQueue::ResetStats()
+{
+    m_Queued.store(m_PendingCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_Applied.store(0, std::memory_order_relaxed);
+    m_Late.store(0, std::memory_order_relaxed);
+    m_MaxLateFrames.store(0, std::memory_order_relaxed);
+    m_LastLateId.store(0, std::memory_order_relaxed);
+    m_LastLateFrame.store(0, std::memory_order_relaxed);
+    m_LastAppliedId.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,127 @@
+// Engine/CommandQueue.h
+// Frame-accurate command queue into the render thread (Daro_Queue*). Producers on any
+// thread push commands stamped with a target frame; Daro_BeginFrame collects them and
+// applies every command due in that frame at its start, under the same lock as the
+// frame's layer snapshot, so a take made of many commands lands in one frame or not at all.
+// Frame numbers are Daro_GetFrameNumber's: Daro_BeginFrame starts that frame and
+// Daro_EndFrame moves past it. DARO_WHEN_NEXT_FRAME resolves to the frame the next
+// Daro_BeginFrame starts, so it is the same frame whether the command is queued while a
+// frame renders or between Daro_EndFrame and the next Daro_BeginFrame.
+//
+// The queue is an intrusive multi-producer single-consumer list (Vyukov): a push is one
+// atomic exchange and never blocks, whatever the render thread is doing. A batch is
+// linked up on the producer side and pushed with a single exchange, so the consumer sees
+// all of it or none. Commands applied after their target frame are counted as late.
+//
+// No Windows or D3D dependencies; the engine supplies what a command does.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SharedTypes.h"
+
+struct DaroCommand
+{
+    DaroCommand* next;              // Producer-side chain (DaroCommandChain)
+    std::atomic<DaroCommand*> link; // Queue link
+    uint64_t id;
+    int type;                       // DARO_CMD_*
+    int target;                     // Layer index, video id or scene slot
+    int scene = DARO_SCENE_PROGRAM; // Slot the layer commands edit
+    int64_t value;
+    int64_t frame;                  // Target frame; -1 applies at the next frame
+    DaroLayer layer;                // DARO_CMD_UPDATE_LAYER only
+    DaroTransition transition;      // DARO_CMD_TRANSITION_SCENE only
+};
+
+// Commands linked on the producing thread, pushed together
+struct DaroCommandChain
+{
+    DaroCommand* first = nullptr;
+    DaroCommand* last = nullptr;
+    int count = 0;
+
+    ~DaroCommandChain() { Free(); }
+    void Append(DaroCommand* command);
+    void Splice(DaroCommandChain& other);  // Move other's commands to the end
+    void Free();                    // Discard without pushing
+};
+
+class DaroCommandQueue
+{
+public:
+    DaroCommandQueue();
+    ~DaroCommandQueue();
+
+    DaroCommandQueue(const DaroCommandQueue&) = delete;
+    DaroCommandQueue& operator=(const DaroCommandQueue&) = delete;
+
+    // Any thread. A zeroed command; null if out of memory.
+    static DaroCommand* Allocate();
+
+    // Any thread. Assigns consecutive ids, sets every command's target frame and queues
+    // the chain as a unit; the chain is empty afterwards. Returns the last id.
+    uint64_t Push(DaroCommandChain& chain, int64_t frame);
+
+    // Consumer thread: move pushed commands to the pending list, then hand every command
+    // due at frame to apply, in target frame then id order. Returns how many were applied.
+    template <typename Apply>
+    int Run(int64_t frame, Apply apply)
+    {
+        m_RunFrame.store(frame, std::memory_order_release);
+        Collect(frame);
+        int count = 0;
+        while (m_Head < m_Pending.size() && m_Pending[m_Head]->frame <= frame)
+        {
+            DaroCommand* command = m_Pending[m_Head++];
+            apply(*command);
+            Complete(command, frame);
+            count++;
+        }
+        Compact();
+        return count;
+    }
+
+    // Any thread. The frame the next Run starts (DARO_WHEN_NEXT_FRAME), given the current
+    // frame number: the one after the last Run's while that frame is being rendered,
+    // currentFrame once it has been counted.
+    int64_t NextFrame(int64_t currentFrame) const
+    {
+        int64_t next = m_RunFrame.load(std::memory_order_acquire) + 1;
+        return next > currentFrame ? next : currentFrame;
+    }
+
+    // Consumer thread, or any thread once producers and the consumer have stopped
+    void Clear();
+
+    // Any thread
+    void GetStats(DaroCommandQueueStats* stats) const;
+    void ResetStats();
+
+private:
+    void Collect(int64_t frame);
+    void Complete(DaroCommand* command, int64_t frame);
+    void Compact();
+
+    // Queue: producers exchange m_Tail, the consumer follows links from m_Stub/m_Front
+    std::atomic<DaroCommand*> m_Tail;
+    DaroCommand* m_Front;
+    DaroCommand* m_Stub;
+    std::atomic<uint64_t> m_NextId{ 1 };
+    std::atomic<int64_t> m_RunFrame{ -1 };  // Frame of the last Run
+
+    // Consumer-owned, sorted by (frame, id); m_Head is the first not yet applied
+    std::vector<DaroCommand*> m_Pending;
+    size_t m_Head = 0;
+
+    std::atomic<long long> m_Queued{ 0 };
+    std::atomic<long long> m_Applied{ 0 };
+    std::atomic<long long> m_PendingCount{ 0 };
+    std::atomic<long long> m_Late{ 0 };
+    std::atomic<long long> m_MaxLateFrames{ 0 };
+    std::atomic<long long> m_LastLateId{ 0 };
+    std::atomic<long long> m_LastLateFrame{ 0 };
+    std::atomic<long long> m_LastAppliedId{ 0 };
+};
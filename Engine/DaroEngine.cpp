@@ -1,12 +1,33 @@
 // Engine/DaroEngine.cpp
 #include "DaroEngine.h"
 #include "Renderer.h"
+#include "Capture.h"
+#include "Clock.h"
+#include "CommandBuffer.h"
+#include "CommandQueue.h"
+#include "DataStore.h"
+#include "ExternalClock.h"
 #include "FrameBuffer.h"
+#include "FrameTransport.h"
+#include "FrameStats.h"
+#include "LayerMasks.h"
+#include "MemoryStats.h"
+#include "OutputSlots.h"
+#include "RenderLoop.h"
+#include "StatsBlock.h"
+#include "TimeBase.h"
+#include "Timeline.h"
+#include "Trace.h"
 #include "VideoPlayer.h"  // For VideoLog
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <condition_variable>
+#include <climits>
+#include <cmath>
 #include <cstddef>
+#include <map>
+#include <string>
 #include <unordered_map>
 #include <vector>
 #include <Windows.h>
@@ -14,7 +35,14 @@
 
 static std::unique_ptr<DaroRenderer> g_Renderer;
 static std::unique_ptr<DaroFrameBuffer> g_FrameBuffer;
+static std::unique_ptr<DaroFrameSender> g_FrameSender;
+static std::unique_ptr<DaroFrameSender> g_PreviewSender;   // Daro_EnablePreviewOutput
+static std::unique_ptr<DaroStatsPublisher> g_StatsPublisher;
+static std::unique_ptr<DaroDataIngest> g_DataIngest;     // Daro_EnableDataIngest
 static std::mutex g_Mutex;
+// Held by RenderPreview from its layer copy through the publish, and by whatever replaces
+// or drops g_PreviewSender and the renderer's preview target. Taken after g_Mutex, or alone.
+static std::mutex g_PreviewMutex;
 static std::atomic<bool> g_Initialized{ false };
 static std::atomic<int> g_LastError{ DARO_OK };
 static bool g_ComInitializedByUs = false; // Track if we initialized COM
@@ -22,24 +50,109 @@ static bool g_ComInitializedByUs = false; // Track if we initialized COM
 // g_TempMaskList used by Daro_UpdateLayer
 static std::vector<int> g_TempMaskList;
 
-static DaroLayer g_Layers[DARO_MAX_LAYERS];
-static int g_LayerCount = 0;
+// Scene slots (see Daro_TakeScene). Daro_UpdateLayer and the other layer calls edit the
+// program slot; a take only changes g_ProgramSlot, so the next frame snapshots another slot.
+// Each slot's timeline animates its layers in place (Daro_BeginFrame).
+struct DaroScene
+{
+    DaroLayer layers[DARO_MAX_LAYERS];
+    int layerCount;
+    DaroTimeline timeline;
+};
+static DaroScene g_Scenes[DARO_SCENE_SLOTS];
+static int g_ProgramSlot = 0;
+static int g_PreviewSlot = 1;               // Rendered by the preview output
+
+// Live data feeds (see DataStore.h); applied to the slots' layers in Daro_BeginFrame
+static DaroDataStore g_DataStore;
+
+// Scene transition in progress (Daro_TransitionScene). The program slot is already the
+// incoming scene; Daro_Render also renders fromSlot and blends the two while active.
+struct DaroTransitionRun
+{
+    bool active = false;
+    DaroTransition params = {};
+    int fromSlot = 0;
+    long long startFrame = 0;       // Engine frame showing transition frame 1
+};
+static DaroTransitionRun g_Transition;
+static long long g_TransitionsCompleted = 0;
+static long long g_TransitionsInterrupted = 0;
 
-static std::atomic<bool> g_IsPlaying{ false };
-static std::atomic<int> g_CurrentFrame{ 0 };
-static std::atomic<int> g_TotalFrames{ 250 };
+// Memory accounting ids within DARO_MEM_FRAME_TRANSPORT
+enum { MEM_ASSET_TRANSPORT = 0, MEM_ASSET_PREVIEW_TRANSPORT = 1 };
 
 static std::atomic<double> g_FPS{ 0.0 };
 static std::atomic<double> g_FrameTime{ 0.0 };
 static std::atomic<int> g_DroppedFrames{ 0 };
+static std::atomic<int> g_LateFrames{ 0 };         // Busy time (BeginFrame to EndFrame) over one frame period
 static std::atomic<long long> g_FrameNumber{ 0 };
 
-static double g_TargetFps = 50.0;
-static LARGE_INTEGER g_PerfFreq;
-static LARGE_INTEGER g_LastFrameTime;
+// What is on air, attached to every Spout frame (see FrameMetadata.h)
+static DaroFrameMetadata g_OutputMetadata = {};
+
+// Copy of the on-air names for the stats publisher, so it never takes g_Mutex
+static DaroFrameMetadata g_OnAirMetadata = {};
+static std::mutex g_OnAirMutex;
+
+// Output frame rate. g_TargetFps is the same rate as a double for stats and millisecond
+// thresholds; frame and time arithmetic uses the exact g_FrameRate (TimeBase.h).
+static std::atomic<DaroRational> g_FrameRate{ DaroRational{ 50, 1 } };
+static std::atomic<double> g_TargetFps{ 50.0 };
+static std::atomic<bool> g_DropFrameTimecode{ false };
+
+// Daro_SeekToTime takes float seconds, which are only accurate to ~0.25 ms after an hour:
+// times this close before a frame start seek to that frame
+#define DARO_SEEK_TIME_TOLERANCE_NS 1000000
+
+static int64_t g_LastFrameNs = 0;           // Engine clock (see Clock.h)
+static DaroOutputSlots g_OutputSlots;       // Dropped-frame grid (Daro_EndFrame)
+
+// Native render loop (Daro_StartRenderLoop). Hosts hold it off between frames with
+// Daro_LockRenderLoop and Daro_UnlockRenderLoop.
+static DaroRenderLoop g_RenderLoop;
+static DaroCommandQueue g_Commands;         // Consumed under g_Mutex (Daro_BeginFrame)
+static long long g_ReportedLateCommands = 0;
+static thread_local DaroCommandChain t_CommandBatch;    // Daro_BeginCommandBatch
+static thread_local int t_CommandBatchDepth = 0;
+static DaroTickGenerator g_TickGenerator;   // Stand-in reference (Daro_StartTickGenerator)
+static std::mutex g_TickGeneratorMutex;
+
+// Signalled by Daro_EndFrame for Daro_WaitForFrame
+static std::mutex g_FrameReadyMutex;
+static std::condition_variable g_FrameReady;
+
+// Loaded assets by id, so a capture started mid-session can reload them (see Daro_StartCapture)
+struct CaptureVideoState
+{
+    std::string path;
+    bool loop = false;
+    bool alpha = false;
+};
+static std::map<int, std::string> g_CaptureTextures;
+static std::map<int, CaptureVideoState> g_CaptureVideos;
+static std::map<int, std::string> g_CaptureReceivers;
+static std::mutex g_CaptureAssetsMutex;
+
+// Invalid rates keep fallbackFps as the double rate, with frame and slot arithmetic off
+static void SetFrameRate(DaroRational rate, double fallbackFps)
+{
+    bool valid = DaroRationalIsValid(rate);
+    g_FrameRate.store(valid ? rate : DaroRational{ 0, 1 });
+    g_TargetFps.store(valid ? DaroRationalToDouble(rate) : fallbackFps);
+    g_DropFrameTimecode.store(valid && DaroIsDropFrameRate(rate));
+}
+
+// Packed SMPTE timecode of an output frame (0xHHMMSSFF plus DARO_TIMECODE_DROP_FRAME)
+static uint32_t OutputTimecode(long long frameNumber)
+{
+    return DaroFrameToTimecode((uint64_t)frameNumber, g_FrameRate.load(), g_DropFrameTimecode.load());
+}
 
 DARO_API int __stdcall Daro_Initialize(int width, int height, double targetFps)
 {
+    DaroCaptureCall capture(DARO_CALL_INITIALIZE);
+    capture.Int(width).Int(height).Double(targetFps);
     std::lock_guard<std::mutex> lock(g_Mutex);
     
     if (g_Initialized)
@@ -60,9 +173,11 @@ DARO_API int __stdcall Daro_Initialize(int width, int height, double targetFps)
     }
     g_ComInitializedByUs = (hrCom == S_OK);
 
-    g_TargetFps = targetFps;
-    QueryPerformanceFrequency(&g_PerfFreq);
-    QueryPerformanceCounter(&g_LastFrameTime);
+    SetFrameRate(DaroRationalFromFps(targetFps), targetFps);
+    g_LastFrameNs = DaroClock::Instance().Now();
+    g_OutputSlots.Reset();
+    g_Commands.ResetStats();
+    g_ReportedLateCommands = 0;
 
     // Initialize renderer
     g_Renderer = std::make_unique<DaroRenderer>();
@@ -84,279 +199,1936 @@ DARO_API int __stdcall Daro_Initialize(int width, int height, double targetFps)
         return DARO_ERROR_CREATE_FRAMEBUFFER;
     }
     
-    memset(g_Layers, 0, sizeof(g_Layers));
-    g_LayerCount = 0;
+    for (DaroScene& scene : g_Scenes)
+    {
+        memset(scene.layers, 0, sizeof(scene.layers));
+        scene.layerCount = 0;
+        scene.timeline.Clear();
+    }
+    g_DataStore.Clear();
+    g_ProgramSlot = 0;
+    g_PreviewSlot = 1;
+    g_Transition = DaroTransitionRun();
+    g_TransitionsCompleted = 0;
+    g_TransitionsInterrupted = 0;
     
     g_Initialized = true;
     g_LastError = DARO_OK;
     return DARO_OK;
 }
 
-DARO_API void __stdcall Daro_Shutdown()
+static void ReleaseEngine()
+{
+    // The loop thread takes g_Mutex every frame - stop it before taking it here
+    g_RenderLoop.Stop();
+    {
+        std::lock_guard<std::mutex> tickLock(g_TickGeneratorMutex);
+        g_TickGenerator.Stop();
+    }
+
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    if (!g_Initialized) return;
+    // The publisher reads g_Renderer - stop it first
+    g_StatsPublisher.reset();
+    g_DataIngest.reset();
+    g_DataStore.SetIngestEntries(0);
+    g_FrameSender.reset();
+    DaroMemoryAccountant::Instance().Remove(DARO_MEM_FRAME_TRANSPORT, MEM_ASSET_TRANSPORT);
+    DaroMemoryAccountant::Instance().Remove(DARO_MEM_FRAME_TRANSPORT, MEM_ASSET_PREVIEW_TRANSPORT);
+    g_FrameBuffer.reset();
+    {
+        // A preview still rendering holds the renderer and the sender
+        std::lock_guard<std::mutex> previewLock(g_PreviewMutex);
+        g_PreviewSender.reset();
+        g_Renderer.reset();
+    }
+    g_Commands.Clear();
+    {
+        // Cleared under the wait mutex, so a Daro_WaitForFrame checking it cannot miss the wake
+        std::lock_guard<std::mutex> frameLock(g_FrameReadyMutex);
+        g_Initialized = false;
+    }
+    g_FrameReady.notify_all();
+    {
+        std::lock_guard<std::mutex> assetsLock(g_CaptureAssetsMutex);
+        g_CaptureTextures.clear();
+        g_CaptureVideos.clear();
+        g_CaptureReceivers.clear();
+    }
+    if (g_ComInitializedByUs)
+    {
+        CoUninitialize();
+        g_ComInitializedByUs = false;
+    }
+}
+
+DARO_API void __stdcall Daro_Shutdown()
+{
+    {
+        DaroCaptureCall capture(DARO_CALL_SHUTDOWN);
+        ReleaseEngine();
+    }
+    // Capture ends with the engine, so the file is complete before the host unloads us
+    DaroCapture::Stop();
+}
+
+DARO_API bool __stdcall Daro_IsInitialized()
+{
+    DaroCaptureCall capture(DARO_CALL_IS_INITIALIZED);
+    return g_Initialized;
+}
+
+DARO_API int __stdcall Daro_GetLastError()
+{
+    DaroCaptureCall capture(DARO_CALL_GET_LAST_ERROR);
+    return g_LastError;
+}
+
+static bool IsSceneSlot(int slot) { return slot == DARO_SCENE_PROGRAM || (slot >= 0 && slot < DARO_SCENE_SLOTS); }
+
+// Scene slot by index or DARO_SCENE_PROGRAM, null if out of range; g_Mutex held
+static DaroScene* SceneAt(int slot)
+{
+    if (slot == DARO_SCENE_PROGRAM) return &g_Scenes[g_ProgramSlot];
+    return (slot >= 0 && slot < DARO_SCENE_SLOTS) ? &g_Scenes[slot] : nullptr;
+}
+
+static int SlotOf(const DaroScene* scene) { return (int)(scene - g_Scenes); }
+
+static void EndTransition(bool completed)
+{
+    if (!g_Transition.active) return;
+    g_Transition.active = false;
+    if (completed) g_TransitionsCompleted++;
+    else g_TransitionsInterrupted++;
+}
+
+// Put a slot on air. Taking the preview slot flips the two, so the old program becomes
+// the preview. Any take ends a running transition. g_Mutex held.
+static bool TakeScene(int slot)
+{
+    if (slot != DARO_SCENE_PROGRAM && (slot < 0 || slot >= DARO_SCENE_SLOTS)) return false;
+    EndTransition(false);
+    if (slot == DARO_SCENE_PROGRAM || slot == g_ProgramSlot) return true;
+    if (slot == g_PreviewSlot) g_PreviewSlot = g_ProgramSlot;
+    g_ProgramSlot = slot;
+    return true;
+}
+
+static bool IsValidTransition(const DaroTransition& transition)
+{
+    return transition.type >= 0 && transition.type < DARO_TRANSITION_COUNT &&
+           transition.durationFrames >= 0 &&
+           transition.easing >= 0 && transition.easing < DARO_EASE_COUNT &&
+           transition.direction >= 0 && transition.direction < DARO_DIRECTION_COUNT &&
+           transition.softness >= 0.0f && transition.softness <= 1.0f;
+}
+
+// Take slot and blend into it from the current program, starting with the frame about to
+// be rendered. g_Mutex held.
+static bool StartTransition(int slot, const DaroTransition& transition)
+{
+    if (!IsValidTransition(transition)) return false;
+    int from = g_ProgramSlot;
+    if (!TakeScene(slot)) return false;
+    if (transition.type == DARO_TRANSITION_CUT || transition.durationFrames <= 1 || g_ProgramSlot == from)
+        return true;
+    g_Transition.active = true;
+    g_Transition.params = transition;
+    g_Transition.fromSlot = from;
+    g_Transition.startFrame = g_FrameNumber.load();
+    return true;
+}
+
+// Transition frame (1 = first blended frame) of an engine frame; g_Mutex held
+static long long TransitionFrame(long long frameNumber)
+{
+    return frameNumber - g_Transition.startFrame + 1;
+}
+
+static float Ease(int easing, float t)
+{
+    switch (easing)
+    {
+    case DARO_EASE_IN: return t * t * t;
+    case DARO_EASE_OUT: { float u = 1.0f - t; return 1.0f - u * u * u; }
+    case DARO_EASE_IN_OUT:
+    {
+        if (t < 0.5f) return 4.0f * t * t * t;
+        float u = 2.0f - 2.0f * t;
+        return 1.0f - u * u * u * 0.5f;
+    }
+    default: return t;
+    }
+}
+
+// Eased progress of a transition frame, 1..durationFrames
+static float TransitionProgress(const DaroTransition& transition, long long frame)
+{
+    float t = (float)((double)frame / (double)transition.durationFrames);
+    return Ease(transition.easing, t < 0.0f ? 0.0f : t > 1.0f ? 1.0f : t);
+}
+
+// One queued command; g_Mutex held
+static void ApplyCommand(const DaroCommand& command)
+{
+    DaroScene* scene = SceneAt(command.scene);
+    switch (command.type)
+    {
+    case DARO_CMD_UPDATE_LAYER:
+        if (scene && command.target >= 0 && command.target < DARO_MAX_LAYERS)
+        {
+            memcpy(&scene->layers[command.target], &command.layer, sizeof(DaroLayer));
+            g_DataStore.TouchLayer(SlotOf(scene), command.target);
+        }
+        break;
+    case DARO_CMD_SET_LAYER_COUNT:
+        // Same clamp as Daro_SetLayerCount
+        if (scene)
+            scene->layerCount = command.value < 0 ? 0 : command.value > DARO_MAX_LAYERS ? DARO_MAX_LAYERS : (int)command.value;
+        break;
+    case DARO_CMD_CLEAR_LAYERS:
+        if (scene)
+        {
+            memset(scene->layers, 0, sizeof(scene->layers));
+            scene->layerCount = 0;
+            g_DataStore.TouchSlot(SlotOf(scene));
+        }
+        break;
+    case DARO_CMD_TAKE_SCENE:
+        TakeScene(command.target);
+        break;
+    case DARO_CMD_TRANSITION_SCENE:
+        StartTransition(command.target, command.transition);
+        break;
+    case DARO_CMD_PLAY_TIMELINE:
+        if (DaroScene* slot = SceneAt(command.target)) slot->timeline.Play();
+        break;
+    case DARO_CMD_STOP_TIMELINE:
+        if (DaroScene* slot = SceneAt(command.target)) slot->timeline.Stop();
+        break;
+    case DARO_CMD_SEEK_TIMELINE:
+        if (DaroScene* slot = SceneAt(command.target))
+            slot->timeline.Seek(command.value < 0 ? 0 : command.value > INT_MAX ? INT_MAX : (int)command.value);
+        break;
+    case DARO_CMD_CONTINUE_TIMELINE:
+        if (DaroScene* slot = SceneAt(command.target)) slot->timeline.Continue();
+        break;
+    case DARO_CMD_PLAY_VIDEO:
+        if (g_Renderer) g_Renderer->PlayVideo(command.target);
+        break;
+    case DARO_CMD_PAUSE_VIDEO:
+        if (g_Renderer) g_Renderer->PauseVideo(command.target);
+        break;
+    case DARO_CMD_STOP_VIDEO:
+        if (g_Renderer) g_Renderer->StopVideo(command.target);
+        break;
+    case DARO_CMD_SEEK_VIDEO:
+        if (g_Renderer) g_Renderer->SeekVideo(command.target, (int)command.value);
+        break;
+    case DARO_CMD_SEEK_VIDEO_TIME:
+        if (g_Renderer) g_Renderer->SeekVideoTime(command.target, (double)command.value / 1e9);
+        break;
+    case DARO_CMD_SET_VIDEO_LOOP:
+        Daro_SetVideoLoop(command.target, command.value != 0);
+        break;
+    case DARO_CMD_SET_VIDEO_ALPHA:
+        Daro_SetVideoAlpha(command.target, command.value != 0);
+        break;
+    }
+}
+
+// Apply the commands due in the frame about to begin, before its layers are snapshotted;
+// g_Mutex held
+static void RunQueuedCommands()
+{
+    long long frame = g_FrameNumber.load();
+    if (g_Commands.Run(frame, ApplyCommand) == 0) return;
+
+    DaroCommandQueueStats stats;
+    g_Commands.GetStats(&stats);
+    if (stats.late != g_ReportedLateCommands)
+    {
+        char msg[192];
+        sprintf_s(msg, "[DaroEngine] %lld late command(s) applied at frame %lld, up to %lld frame(s) late\n",
+            stats.late - g_ReportedLateCommands, frame, stats.maxLateFrames);
+        OutputDebugStringA(msg);
+        g_ReportedLateCommands = stats.late;
+    }
+}
+
+DARO_API void __stdcall Daro_BeginFrame()
+{
+    DaroCaptureCall capture(DARO_CALL_BEGIN_FRAME);
+    if (!g_Initialized) return;
+    DaroFrameProfiler::Instance().BeginFrame();
+    DARO_TRACE_THREAD_NAME("Render");
+    DARO_TRACE_SCOPE("Daro_BeginFrame");
+
+    DaroScopedStage lockWait(DARO_STAGE_BEGIN_LOCK_WAIT);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    lockWait.Stop();
+    RunQueuedCommands();
+
+    // After the commands, so a continue or seek applied in this frame shows in it
+    for (DaroScene& scene : g_Scenes)
+        scene.timeline.Tick(scene.layers, DARO_MAX_LAYERS);
+
+    // After the timelines, and with their layers written again, so a bound field wins over a
+    // track animating it
+    for (int slot = 0; slot < DARO_SCENE_SLOTS; slot++)
+    {
+        if (!g_Scenes[slot].timeline.Tracks().empty())
+            g_DataStore.TouchLayers(slot, g_Scenes[slot].timeline.TrackedLayers());
+    }
+    if (g_DataIngest) g_DataIngest->Poll(&g_DataStore);
+    DaroLayer* slotLayers[DARO_SCENE_SLOTS];
+    for (int slot = 0; slot < DARO_SCENE_SLOTS; slot++) slotLayers[slot] = g_Scenes[slot].layers;
+    g_DataStore.Apply(slotLayers);
+
+    // The frame that shows the last transition frame shows only the incoming scene
+    if (g_Transition.active && TransitionFrame(g_FrameNumber.load()) >= g_Transition.params.durationFrames)
+        EndTransition(true);
+
+    const DaroScene& program = g_Scenes[g_ProgramSlot];
+    const DaroScene* outgoing = g_Transition.active ? &g_Scenes[g_Transition.fromSlot] : nullptr;
+    if (g_Renderer)
+        g_Renderer->BeginFrame(program.layers, program.layerCount,
+            outgoing ? outgoing->layers : nullptr, outgoing ? outgoing->layerCount : 0);
+}
+
+DARO_API void __stdcall Daro_EndFrame()
+{
+    DaroCaptureCall capture(DARO_CALL_END_FRAME);
+    if (!g_Initialized) return;
+    DARO_TRACE_SCOPE("Daro_EndFrame");
+
+    int64_t now = DaroClock::Instance().Now();
+    double elapsed = (double)(now - g_LastFrameNs) / 1e9;
+    g_FrameTime.store(elapsed * 1000.0);
+    g_FPS.store((elapsed > 0.000001) ? 1.0 / elapsed : 0.0);
+
+    // Dropped frames are missed output slots (OutputSlots.h)
+    int64_t missed = g_OutputSlots.Complete(now, g_FrameRate.load());
+    if (missed > 0)
+        g_DroppedFrames.fetch_add(missed > 1000000 ? 1000000 : (int)missed);
+
+    double busyMs = DaroFrameProfiler::Instance().EndFrame(g_FrameNumber.load(), elapsed * 1000.0);
+    double targetFps = g_TargetFps.load();
+    if (targetFps > 0.0 && busyMs > 1000.0 / targetFps)
+        g_LateFrames++;
+
+    g_LastFrameNs = now;
+    {
+        std::lock_guard<std::mutex> frameLock(g_FrameReadyMutex);
+        g_FrameNumber++;
+    }
+    g_FrameReady.notify_all();
+}
+
+DARO_API void __stdcall Daro_Render()
+{
+    DaroCaptureCall capture(DARO_CALL_RENDER);
+    if (!g_Initialized) return;
+    DARO_TRACE_SCOPE("Daro_Render");
+
+    // Copy layers under lock, then render outside lock to minimize contention
+    // But validate g_Renderer under lock to prevent use-after-free on Shutdown
+    int localLayerCount;
+    static thread_local DaroLayer localLayers[DARO_MAX_LAYERS];
+    // Outgoing scene of a transition
+    bool transitioning = false;
+    DaroTransition transition;
+    float progress = 0.0f;
+    int fromLayerCount = 0;
+    static thread_local DaroLayer fromLayers[DARO_MAX_LAYERS];
+
+    DaroScopedStage layerCopy(DARO_STAGE_LAYER_COPY);
+    {
+        DaroScopedStage lockWait(DARO_STAGE_RENDER_LOCK_WAIT);
+        std::lock_guard<std::mutex> lock(g_Mutex);
+        lockWait.Stop();
+        if (!g_Renderer) return;
+        const DaroScene& program = g_Scenes[g_ProgramSlot];
+        localLayerCount = program.layerCount;
+        memcpy(localLayers, program.layers, sizeof(DaroLayer) * localLayerCount);
+
+        long long frame = g_Transition.active ? TransitionFrame(g_FrameNumber.load()) : 0;
+        if (frame >= 1 && frame < g_Transition.params.durationFrames)
+        {
+            transitioning = true;
+            transition = g_Transition.params;
+            progress = TransitionProgress(transition, frame);
+            const DaroScene& from = g_Scenes[g_Transition.fromSlot];
+            fromLayerCount = from.layerCount;
+            memcpy(fromLayers, from.layers, sizeof(DaroLayer) * fromLayerCount);
+        }
+    }
+
+    // Build mask lookup from local copy (function-local static to avoid per-frame allocation)
+    static thread_local DaroMaskMap layerToMasks;
+    static thread_local DaroMaskMap fromLayerToMasks;
+    DaroBuildMaskMap(localLayers, localLayerCount, layerToMasks);
+    if (transitioning) DaroBuildMaskMap(fromLayers, fromLayerCount, fromLayerToMasks);
+
+    // Render - safe because C# side serializes all engine calls through _engineLock
+    // and Stop() waits for render thread before Shutdown() is called
+    layerCopy.Stop();
+    {
+        DaroScopedStage draw(DARO_STAGE_DRAW);   // Text and GPU wait are timed separately
+        if (transitioning)
+        {
+            g_Renderer->Clear(0.0f, 0.0f, 0.0f, 0.0f);
+            g_Renderer->RenderTransitionSource(fromLayers, fromLayerCount, fromLayerToMasks);
+        }
+        g_Renderer->Clear(0.0f, 0.0f, 0.0f, 0.0f);
+        g_Renderer->RenderWithMasks(localLayers, localLayerCount, layerToMasks);
+        if (transitioning) g_Renderer->CompositeTransition(transition, progress);
+    }
+
+    DaroScopedStage readback(DARO_STAGE_READBACK);
+    g_Renderer->CopyToStaging();
+
+    void* pData = nullptr;
+    int rowPitch = 0;
+    bool mapped = g_Renderer->MapStaging(&pData, &rowPitch);
+    readback.Stop();
+    if (mapped)
+    {
+        long long frameNumber = g_FrameNumber.load();
+        if (g_FrameBuffer)
+            g_FrameBuffer->Write(pData, rowPitch, frameNumber);
+        if (g_FrameSender)
+        {
+            DaroScopedStage transport(DARO_STAGE_TRANSPORT);
+            g_FrameSender->Publish(pData, (uint32_t)rowPitch, (uint64_t)frameNumber,
+                OutputTimecode(frameNumber));
+        }
+        g_Renderer->UnmapStaging();
+    }
+}
+
+// Render the preview slot into the render target once the program frame has been handed
+// to Spout, and publish it at preview size. It only runs inside Daro_Present, on the thread
+// that just rendered the program, so it shares the render target and immediate context
+// with nothing: the render loop's frame runs Render, Present and this back to back, and
+// hosts touch the device only under Daro_LockRenderLoop (which waits for that frame to
+// end) or the C# _engineLock (TestRenderLoop, TestPreviewCannotInterleave). g_PreviewMutex
+// guards the sender and preview target against Enable/Disable/Shutdown, not the device.
+static void RenderPreview()
+{
+    int layerCount;
+    static thread_local DaroLayer layers[DARO_MAX_LAYERS];
+    DaroFrameSender* sender;
+
+    DaroScopedStage preview(DARO_STAGE_PREVIEW);
+    // Kept after g_Mutex is released, so the sender cannot be destroyed under us
+    std::unique_lock<std::mutex> previewLock;
+    {
+        std::lock_guard<std::mutex> lock(g_Mutex);
+        if (!g_Renderer || !g_PreviewSender) return;
+        previewLock = std::unique_lock<std::mutex>(g_PreviewMutex);
+        sender = g_PreviewSender.get();
+        const DaroScene& scene = g_Scenes[g_PreviewSlot];
+        layerCount = scene.layerCount;
+        memcpy(layers, scene.layers, sizeof(DaroLayer) * layerCount);
+    }
+    DARO_TRACE_SCOPE("RenderPreview");
+
+    static thread_local DaroMaskMap layerToMasks;
+    DaroBuildMaskMap(layers, layerCount, layerToMasks);
+    g_Renderer->Clear(0.0f, 0.0f, 0.0f, 0.0f);
+    g_Renderer->RenderPreview(layers, layerCount, layerToMasks);
+
+    void* pData = nullptr;
+    int rowPitch = 0;
+    if (g_Renderer->MapPreview(&pData, &rowPitch))
+    {
+        long long frameNumber = g_FrameNumber.load();
+        sender->Publish(pData, (uint32_t)rowPitch, (uint64_t)frameNumber, OutputTimecode(frameNumber));
+        g_Renderer->UnmapPreview();
+    }
+}
+
+DARO_API void __stdcall Daro_Present()
+{
+    DaroCaptureCall capture(DARO_CALL_PRESENT);
+    if (!g_Initialized || !g_Renderer) return;
+    DARO_TRACE_SCOPE("Daro_Present");
+
+    DaroFrameMetadata metadata;
+    bool preview;
+    {
+        DaroScopedStage lockWait(DARO_STAGE_PRESENT_LOCK_WAIT);
+        std::lock_guard<std::mutex> lock(g_Mutex);
+        lockWait.Stop();
+        metadata = g_OutputMetadata;
+        preview = g_PreviewSender != nullptr;
+    }
+    long long frameNumber = g_FrameNumber.load();
+    metadata.engineFrame = frameNumber;
+    metadata.timecode = (int)OutputTimecode(frameNumber);
+    {
+        DaroScopedStage present(DARO_STAGE_PRESENT);
+        g_Renderer->SendSpout(&metadata);
+    }
+    if (preview) RenderPreview();
+}
+
+DARO_API bool __stdcall Daro_LockFrameBuffer(void** ppData, int* pWidth, int* pHeight, int* pStride)
+{
+    DaroCaptureCall capture(DARO_CALL_LOCK_FRAME_BUFFER);
+    if (!g_Initialized || !g_FrameBuffer || !ppData || !pWidth || !pHeight || !pStride) return capture.Result(false);
+    return capture.Result(g_FrameBuffer->Lock(ppData, pWidth, pHeight, pStride));
+}
+
+DARO_API void __stdcall Daro_UnlockFrameBuffer()
+{
+    DaroCaptureCall capture(DARO_CALL_UNLOCK_FRAME_BUFFER);
+    if (g_FrameBuffer) g_FrameBuffer->Unlock();
+}
+
+DARO_API long long __stdcall Daro_GetFrameNumber()
+{
+    DaroCaptureCall capture(DARO_CALL_GET_FRAME_NUMBER);
+    return g_FrameNumber;
+}
+
+DARO_API long long __stdcall Daro_WaitForFrame(long long lastFrame, int timeoutMs)
+{
+    DaroCaptureCall capture(DARO_CALL_WAIT_FOR_FRAME);
+    capture.Int(lastFrame).Int(timeoutMs);
+    std::unique_lock<std::mutex> lock(g_FrameReadyMutex);
+    g_FrameReady.wait_for(lock, std::chrono::milliseconds(timeoutMs > 0 ? timeoutMs : 0),
+        [lastFrame]() { return g_FrameNumber.load() > lastFrame || !g_Initialized; });
+    return g_FrameNumber;
+}
+
+// One frame of the native render loop. Captured as a single record; the calls inside
+// are nested and not recorded on their own.
+static bool RenderLoopFrame()
+{
+    DaroCaptureCall capture(DARO_CALL_RENDER_LOOP_FRAME);
+    if (!g_Initialized) return false;
+    if (Daro_IsDeviceLost())
+    {
+        OutputDebugStringA("[DaroEngine] Render loop: GPU device lost, stopping\n");
+        return false;
+    }
+
+    Daro_BeginFrame();
+    Daro_Render();
+    Daro_Present();
+    Daro_EndFrame();
+    return true;
+}
+
+DARO_API bool __stdcall Daro_StartRenderLoop(double fps)
+{
+    DaroCaptureCall capture(DARO_CALL_START_RENDER_LOOP);
+    capture.Double(fps);
+    if (!g_Initialized) return capture.Result(false);
+    DaroRational rate = fps > 0.0 ? DaroRationalFromFps(fps) : g_FrameRate.load();
+    if (!g_RenderLoop.Start(rate, RenderLoopFrame))
+    {
+        OutputDebugStringA("[DaroEngine] Render loop: already running or invalid fps\n");
+        return capture.Result(false);
+    }
+    return capture.Result(true);
+}
+
+DARO_API void __stdcall Daro_StopRenderLoop()
+{
+    DaroCaptureCall capture(DARO_CALL_STOP_RENDER_LOOP);
+    g_RenderLoop.Stop();
+}
+
+DARO_API bool __stdcall Daro_IsRenderLoopRunning()
+{
+    DaroCaptureCall capture(DARO_CALL_IS_RENDER_LOOP_RUNNING);
+    return g_RenderLoop.IsRunning();
+}
+
+DARO_API bool __stdcall Daro_GetRenderLoopStats(DaroRenderLoopStats* stats)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_RENDER_LOOP_STATS);
+    if (!stats) return false;
+    g_RenderLoop.GetStats(stats);
+    return true;
+}
+
+DARO_API void __stdcall Daro_LockRenderLoop()
+{
+    DaroCaptureCall capture(DARO_CALL_LOCK_RENDER_LOOP);
+    g_RenderLoop.Hold();
+}
+
+DARO_API void __stdcall Daro_UnlockRenderLoop()
+{
+    DaroCaptureCall capture(DARO_CALL_UNLOCK_RENDER_LOOP);
+    g_RenderLoop.Release();
+}
+
+DARO_API bool __stdcall Daro_SetExternalClock(const char* name)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_EXTERNAL_CLOCK);
+    capture.Str(name);
+    bool opened = g_RenderLoop.SetExternalClock(name);
+    if (!opened)
+    {
+        char msg[256];
+        sprintf_s(msg, "[DaroEngine] External clock '%s' not found yet, retrying\n", name);
+        OutputDebugStringA(msg);
+    }
+    return capture.Result(opened);
+}
+
+DARO_API bool __stdcall Daro_GetGenlockStats(DaroGenlockStats* stats)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_GENLOCK_STATS);
+    if (!stats) return false;
+    g_RenderLoop.GetGenlockStats(stats);
+    return true;
+}
+
+DARO_API bool __stdcall Daro_StartTickGenerator(const char* name, int numerator, int denominator, double offsetPpm)
+{
+    DaroCaptureCall capture(DARO_CALL_START_TICK_GENERATOR);
+    capture.Str(name).Int(numerator).Int(denominator).Double(offsetPpm);
+    std::lock_guard<std::mutex> lock(g_TickGeneratorMutex);
+    bool started = g_TickGenerator.Start(name, DaroMakeRational(numerator, denominator), offsetPpm);
+    if (!started)
+        OutputDebugStringA("[DaroEngine] Tick generator: invalid rate or the name is in use\n");
+    return capture.Result(started);
+}
+
+DARO_API void __stdcall Daro_StopTickGenerator()
+{
+    DaroCaptureCall capture(DARO_CALL_STOP_TICK_GENERATOR);
+    std::lock_guard<std::mutex> lock(g_TickGeneratorMutex);
+    g_TickGenerator.Stop();
+}
+
+DARO_API int __stdcall Daro_GetFrameStats(DaroFrameStats* buffer, int count)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_FRAME_STATS);
+    capture.Int(count);
+    return DaroFrameProfiler::Instance().GetFrameStats(buffer, count);
+}
+
+DARO_API bool __stdcall Daro_GetTimingSummary(int metric, int window, DaroTimingSummary* summary)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_TIMING_SUMMARY);
+    capture.Int(metric).Int(window);
+    DaroWindowedHistogram* histogram = DaroFrameProfiler::Instance().GetTiming(metric);
+    return histogram && histogram->Summarize(window, summary);
+}
+
+DARO_API void __stdcall Daro_SetTimingWindow(int milliseconds)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_TIMING_WINDOW);
+    capture.Int(milliseconds);
+    for (int i = 0; i < DARO_TIMING_METRIC_COUNT; i++)
+        DaroFrameProfiler::Instance().GetTiming(i)->SetWindow(milliseconds > 0 ? (uint32_t)milliseconds : 0);
+}
+
+DARO_API void __stdcall Daro_ResetTimingStats()
+{
+    DaroCaptureCall capture(DARO_CALL_RESET_TIMING_STATS);
+    for (int i = 0; i < DARO_TIMING_METRIC_COUNT; i++)
+        DaroFrameProfiler::Instance().GetTiming(i)->RequestReset();
+    g_DroppedFrames = 0;
+    g_LateFrames = 0;
+}
+
+DARO_API void __stdcall Daro_StartTrace()
+{
+    DaroCaptureCall capture(DARO_CALL_START_TRACE);
+    DaroTrace::Start();
+}
+
+DARO_API void __stdcall Daro_StopTrace()
+{
+    DaroCaptureCall capture(DARO_CALL_STOP_TRACE);
+    DaroTrace::Stop();
+}
+
+DARO_API bool __stdcall Daro_IsTraceEnabled()
+{
+    DaroCaptureCall capture(DARO_CALL_IS_TRACE_ENABLED);
+    return DaroTrace::IsEnabled();
+}
+
+DARO_API bool __stdcall Daro_WriteTrace(const char* filePath, int format)
+{
+    DaroCaptureCall capture(DARO_CALL_WRITE_TRACE);
+    capture.Str(filePath).Int(format);
+    return DaroTrace::Write(filePath, format);
+}
+
+// Texts are captured as a length (uint32) and UTF-16 code units each; null as length 0
+static std::vector<uint8_t> PackDataTexts(const wchar_t* const* texts, int count)
+{
+    std::vector<uint8_t> packed;
+    for (int i = 0; i < count; i++)
+    {
+        const wchar_t* text = texts[i] ? texts[i] : L"";
+        uint32_t length = 0;
+        while (length < DARO_MAX_TEXT - 1 && text[length]) length++;
+        size_t offset = packed.size();
+        packed.resize(offset + sizeof(length) + length * sizeof(uint16_t));
+        memcpy(&packed[offset], &length, sizeof(length));
+        for (uint32_t c = 0; c < length; c++)
+        {
+            uint16_t unit = (uint16_t)text[c];
+            memcpy(&packed[offset + sizeof(length) + c * sizeof(uint16_t)], &unit, sizeof(unit));
+        }
+    }
+    return packed;
+}
+
+// API capture (see Capture.h). Started on a running engine, the file first describes
+// the engine as it is - initialization, loaded assets with their ids, layers and
+// playback - so a replay starts from the same state. Called with g_Mutex held.
+static void WriteCapturePreamble()
+{
+    DaroCapture::SetPreamble(true);
+    {
+        DaroCaptureCall capture(DARO_CALL_INITIALIZE);
+        capture.Int(g_FrameBuffer->GetWidth()).Int(g_FrameBuffer->GetHeight()).Double(g_TargetFps);
+    }
+    {
+        DaroRational rate = g_FrameRate.load();
+        DaroCaptureCall capture(DARO_CALL_SET_FRAME_RATE);
+        capture.Int(rate.num).Int(rate.den).Result(DaroRationalIsValid(rate));
+    }
+    {
+        DaroCaptureCall capture(DARO_CALL_SET_DROP_FRAME_TIMECODE);
+        capture.Bool(g_DropFrameTimecode.load());
+    }
+    {
+        std::lock_guard<std::mutex> assetsLock(g_CaptureAssetsMutex);
+        for (const auto& texture : g_CaptureTextures)
+        {
+            DaroCaptureCall capture(DARO_CALL_LOAD_TEXTURE);
+            capture.Str(texture.second.c_str()).Result(texture.first);
+        }
+        for (const auto& video : g_CaptureVideos)
+        {
+            int videoId = video.first;
+            {
+                DaroCaptureCall capture(DARO_CALL_LOAD_VIDEO);
+                capture.Str(video.second.path.c_str()).Result(videoId);
+            }
+            {
+                DaroCaptureCall capture(DARO_CALL_SET_VIDEO_LOOP);
+                capture.Int(videoId).Bool(video.second.loop);
+            }
+            {
+                DaroCaptureCall capture(DARO_CALL_SET_VIDEO_ALPHA);
+                capture.Int(videoId).Bool(video.second.alpha);
+            }
+            {
+                DaroCaptureCall capture(DARO_CALL_SEEK_VIDEO);
+                capture.Int(videoId).Int(g_Renderer->GetVideoFrame(videoId));
+            }
+            if (g_Renderer->IsVideoPlaying(videoId))
+            {
+                DaroCaptureCall capture(DARO_CALL_PLAY_VIDEO);
+                capture.Int(videoId);
+            }
+        }
+        for (const auto& receiver : g_CaptureReceivers)
+        {
+            DaroCaptureCall capture(DARO_CALL_CONNECT_SPOUT_RECEIVER);
+            capture.Str(receiver.second.c_str()).Result(receiver.first);
+        }
+    }
+    {
+        DaroCaptureCall capture(DARO_CALL_SET_EDGE_SMOOTHING);
+        capture.Float(g_Renderer->GetEdgeSmoothing());
+    }
+    if (DaroClock::Instance().IsVirtual())
+    {
+        DaroCaptureCall capture(DARO_CALL_SET_VIRTUAL_CLOCK);
+        capture.Bool(true);
+    }
+    {
+        DaroCaptureCall capture(DARO_CALL_SET_OUTPUT_METADATA);
+        capture.Str(g_OutputMetadata.templateName).Str(g_OutputMetadata.itemName);
+    }
+    for (int slot = 0; slot < DARO_SCENE_SLOTS; slot++)
+    {
+        const DaroScene& scene = g_Scenes[slot];
+        {
+            DaroCaptureCall capture(DARO_CALL_SET_SCENE_LAYER_COUNT);
+            capture.Int(slot).Int(scene.layerCount);
+        }
+        for (int i = 0; i < scene.layerCount; i++)
+        {
+            DaroCaptureCall capture(DARO_CALL_UPDATE_SCENE_LAYER);
+            capture.Int(slot).Int(i).Layer(i, &scene.layers[i]);
+        }
+
+        const DaroTimeline& timeline = scene.timeline;
+        {
+            DaroCaptureCall capture(DARO_CALL_CLEAR_TIMELINE);
+            capture.Int(slot);
+        }
+        if (timeline.Length() != DARO_TIMELINE_DEFAULT_LENGTH)
+        {
+            DaroCaptureCall capture(DARO_CALL_SET_TIMELINE_LENGTH);
+            capture.Int(slot).Int(timeline.Length());
+        }
+        for (const DaroTimeline::Track& track : timeline.Tracks())
+        {
+            DaroCaptureCall capture(DARO_CALL_SET_TIMELINE_TRACK);
+            capture.Int(slot).Int(track.layer).Int(track.field)
+                .Blob(track.keys.data(), track.keys.size() * sizeof(DaroKeyframe)).Int((long long)track.keys.size());
+        }
+        if (!timeline.Markers().empty())
+        {
+            const std::vector<DaroTimelineMarker>& markers = timeline.Markers();
+            DaroCaptureCall capture(DARO_CALL_SET_TIMELINE_MARKERS);
+            capture.Int(slot).Blob(markers.data(), markers.size() * sizeof(DaroTimelineMarker)).Int((long long)markers.size());
+        }
+        if (timeline.Frame() != 0)
+        {
+            DaroCaptureCall capture(DARO_CALL_SEEK_TIMELINE);
+            capture.Int(slot).Int(timeline.Frame());
+        }
+        if (timeline.IsContinuePending())
+        {
+            DaroCaptureCall capture(DARO_CALL_CONTINUE_TIMELINE);
+            capture.Int(slot);
+        }
+        if (timeline.IsPlaying())
+        {
+            DaroCaptureCall capture(DARO_CALL_PLAY_TIMELINE);
+            capture.Int(slot);
+        }
+    }
+    {
+        // Keys in id order, so a replay hands out the same ids
+        std::vector<std::string> names = g_DataStore.KeyNames();
+        std::vector<int> numberKeys, textKeys;
+        std::vector<double> numbers;
+        std::vector<std::vector<wchar_t>> texts;
+        for (int key = 0; key < (int)names.size(); key++)
+        {
+            {
+                DaroCaptureCall capture(DARO_CALL_GET_DATA_KEY);
+                capture.Str(names[key].c_str()).Result(key);
+            }
+            double number = 0.0;
+            std::vector<wchar_t> text;
+            int type = g_DataStore.GetValue(key, &number, &text);
+            if (type == DARO_DATA_NUMBER)
+            {
+                numberKeys.push_back(key);
+                numbers.push_back(number);
+            }
+            else if (type == DARO_DATA_TEXT)
+            {
+                textKeys.push_back(key);
+                texts.push_back(std::move(text));
+            }
+        }
+        if (!numberKeys.empty())
+        {
+            DaroCaptureCall capture(DARO_CALL_SET_DATA_NUMBERS);
+            capture.Blob(numberKeys.data(), numberKeys.size() * sizeof(int))
+                .Blob(numbers.data(), numbers.size() * sizeof(double)).Int((long long)numberKeys.size());
+        }
+        if (!textKeys.empty())
+        {
+            std::vector<const wchar_t*> pointers;
+            for (const std::vector<wchar_t>& text : texts) pointers.push_back(text.data());
+            std::vector<uint8_t> packed = PackDataTexts(pointers.data(), (int)pointers.size());
+            DaroCaptureCall capture(DARO_CALL_SET_DATA_TEXTS);
+            capture.Blob(textKeys.data(), textKeys.size() * sizeof(int))
+                .Blob(packed.data(), packed.size()).Int((long long)textKeys.size());
+        }
+        for (const DaroDataStore::Binding& binding : g_DataStore.Bindings())
+        {
+            DaroCaptureCall capture(DARO_CALL_BIND_LAYER_FIELD);
+            capture.Int(binding.slot).Int(binding.layer).Int(binding.field).Int(binding.key);
+        }
+    }
+    {
+        DaroCaptureCall capture(DARO_CALL_TAKE_SCENE);
+        capture.Int(g_ProgramSlot);
+    }
+    {
+        DaroCaptureCall capture(DARO_CALL_SET_PREVIEW_SLOT);
+        capture.Int(g_PreviewSlot);
+    }
+    DaroCapture::SetPreamble(false);
+}
+
+DARO_API bool __stdcall Daro_StartCapture(const char* filePath)
+{
+    // The preamble is written and recording enabled under g_Mutex, so no other
+    // thread's call can be recorded ahead of the state it depends on
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    if (!DaroCapture::Start(filePath))
+    {
+        OutputDebugStringA("[DaroEngine] Capture: could not create the file, or a capture is already running\n");
+        return false;
+    }
+    if (g_Initialized && g_Renderer && g_FrameBuffer)
+        WriteCapturePreamble();
+    DaroCapture::Enable();
+    return true;
+}
+
+DARO_API void __stdcall Daro_StopCapture()
+{
+    if (!DaroCapture::Stop()) return;
+
+    uint64_t records = 0, bytes = 0;
+    DaroCapture::GetCounts(&records, &bytes);
+    char dbg[128];
+    sprintf_s(dbg, "[DaroEngine] Capture: %llu calls, %llu bytes\n", (unsigned long long)records, (unsigned long long)bytes);
+    OutputDebugStringA(dbg);
+}
+
+DARO_API bool __stdcall Daro_IsCapturing()
+{
+    return DaroCapture::IsEnabled();
+}
+
+DARO_API void __stdcall Daro_SetVirtualClock(bool enabled)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_VIRTUAL_CLOCK);
+    capture.Bool(enabled);
+    DaroClock::Instance().SetVirtual(enabled);
+}
+
+DARO_API bool __stdcall Daro_IsVirtualClock()
+{
+    DaroCaptureCall capture(DARO_CALL_IS_VIRTUAL_CLOCK);
+    return DaroClock::Instance().IsVirtual();
+}
+
+DARO_API void __stdcall Daro_AdvanceClock(double milliseconds)
+{
+    DaroCaptureCall capture(DARO_CALL_ADVANCE_CLOCK);
+    capture.Double(milliseconds);
+    DaroClock::Instance().Advance(milliseconds * 1e6);
+}
+
+DARO_API void __stdcall Daro_AdvanceClockFrames(int frames)
+{
+    DaroCaptureCall capture(DARO_CALL_ADVANCE_CLOCK_FRAMES);
+    capture.Int(frames);
+    DaroRational rate = g_FrameRate.load();
+    if (frames <= 0 || !DaroRationalIsValid(rate)) return;
+    DaroClock::Instance().AdvanceFraction((int64_t)frames * DARO_NS_PER_SECOND * rate.den, rate.num);
+}
+
+DARO_API double __stdcall Daro_GetClockTime()
+{
+    DaroCaptureCall capture(DARO_CALL_GET_CLOCK_TIME);
+    return (double)DaroClock::Instance().Now() / 1e6;
+}
+
+DARO_API bool __stdcall Daro_SetFrameRate(int numerator, int denominator)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_FRAME_RATE);
+    capture.Int(numerator).Int(denominator);
+    DaroRational rate = DaroMakeRational(numerator, denominator);
+    if (!DaroRationalIsValid(rate))
+        return capture.Result(false);
+    SetFrameRate(rate, 0.0);
+    // A running render loop follows from its next frame
+    g_RenderLoop.SetRate(rate);
+    return capture.Result(true);
+}
+
+DARO_API void __stdcall Daro_GetFrameRate(int* numerator, int* denominator)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_FRAME_RATE);
+    DaroRational rate = g_FrameRate.load();
+    if (numerator) *numerator = (int)rate.num;
+    if (denominator) *denominator = (int)rate.den;
+}
+
+DARO_API void __stdcall Daro_SetDropFrameTimecode(bool enabled)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_DROP_FRAME_TIMECODE);
+    capture.Bool(enabled);
+    g_DropFrameTimecode.store(enabled);
+}
+
+DARO_API bool __stdcall Daro_IsDropFrameTimecode()
+{
+    DaroCaptureCall capture(DARO_CALL_IS_DROP_FRAME_TIMECODE);
+    return g_DropFrameTimecode.load() && DaroIsDropFrameRate(g_FrameRate.load());
+}
+
+DARO_API void __stdcall Daro_SetLayerCount(int count)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_LAYER_COUNT);
+    capture.Int(count);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    // Clamp to valid range [0, DARO_MAX_LAYERS] to prevent negative or excessive values
+    if (count < 0) count = 0;
+    g_Scenes[g_ProgramSlot].layerCount = min(count, DARO_MAX_LAYERS);
+}
+
+DARO_API void __stdcall Daro_UpdateLayer(int index, const DaroLayer* layer)
+{
+    DaroCaptureCall capture(DARO_CALL_UPDATE_LAYER);
+    capture.Int(index).Layer(index, layer);
+    if (index < 0 || index >= DARO_MAX_LAYERS || !layer) return;
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    memcpy(&g_Scenes[g_ProgramSlot].layers[index], layer, sizeof(DaroLayer));
+    g_DataStore.TouchLayer(g_ProgramSlot, index);
+}
+
+DARO_API void __stdcall Daro_GetLayer(int index, DaroLayer* layer)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_LAYER);
+    capture.Int(index);
+    if (index < 0 || index >= DARO_MAX_LAYERS || !layer) return;
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    memcpy(layer, &g_Scenes[g_ProgramSlot].layers[index], sizeof(DaroLayer));
+}
+
+DARO_API void __stdcall Daro_ClearLayers()
+{
+    DaroCaptureCall capture(DARO_CALL_CLEAR_LAYERS);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene& program = g_Scenes[g_ProgramSlot];
+    memset(program.layers, 0, sizeof(program.layers));
+    program.layerCount = 0;
+    g_DataStore.TouchSlot(g_ProgramSlot);
+}
+
+// Scene slots: the same calls for any slot (DARO_SCENE_PROGRAM for the one on air)
+DARO_API bool __stdcall Daro_SetSceneLayerCount(int slot, int count)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_SCENE_LAYER_COUNT);
+    capture.Int(slot).Int(count);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    if (!scene) return false;
+    if (count < 0) count = 0;
+    scene->layerCount = min(count, DARO_MAX_LAYERS);
+    return true;
+}
+
+DARO_API bool __stdcall Daro_UpdateSceneLayer(int slot, int index, const DaroLayer* layer)
+{
+    DaroCaptureCall capture(DARO_CALL_UPDATE_SCENE_LAYER);
+    capture.Int(slot).Int(index).Layer(index, layer);
+    if (index < 0 || index >= DARO_MAX_LAYERS || !layer) return false;
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    if (!scene) return false;
+    memcpy(&scene->layers[index], layer, sizeof(DaroLayer));
+    g_DataStore.TouchLayer(SlotOf(scene), index);
+    return true;
+}
+
+DARO_API bool __stdcall Daro_GetSceneLayer(int slot, int index, DaroLayer* layer)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_SCENE_LAYER);
+    capture.Int(slot).Int(index);
+    if (index < 0 || index >= DARO_MAX_LAYERS || !layer) return false;
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    if (!scene) return false;
+    memcpy(layer, &scene->layers[index], sizeof(DaroLayer));
+    return true;
+}
+
+DARO_API int __stdcall Daro_GetSceneLayerCount(int slot)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_SCENE_LAYER_COUNT);
+    capture.Int(slot);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    return scene ? scene->layerCount : -1;
+}
+
+DARO_API bool __stdcall Daro_ClearScene(int slot)
+{
+    DaroCaptureCall capture(DARO_CALL_CLEAR_SCENE);
+    capture.Int(slot);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    if (!scene) return false;
+    memset(scene->layers, 0, sizeof(scene->layers));
+    scene->layerCount = 0;
+    scene->timeline.Clear();
+    g_DataStore.ClearBindings(SlotOf(scene));
+    return true;
+}
+
+DARO_API bool __stdcall Daro_CopyScene(int fromSlot, int toSlot)
+{
+    DaroCaptureCall capture(DARO_CALL_COPY_SCENE);
+    capture.Int(fromSlot).Int(toSlot);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* from = SceneAt(fromSlot);
+    DaroScene* to = SceneAt(toSlot);
+    if (!from || !to) return false;
+    if (from != to)
+    {
+        *to = *from;
+        // The copy carries the source's values; the destination's bindings apply over them
+        g_DataStore.TouchSlot(SlotOf(to));
+    }
+    return true;
+}
+
+DARO_API bool __stdcall Daro_TakeScene(int slot)
+{
+    DaroCaptureCall capture(DARO_CALL_TAKE_SCENE);
+    capture.Int(slot);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    return TakeScene(slot);
+}
+
+DARO_API bool __stdcall Daro_TransitionScene(int slot, const DaroTransition* transition)
+{
+    DaroCaptureCall capture(DARO_CALL_TRANSITION_SCENE);
+    capture.Int(slot).Blob(transition, transition ? sizeof(DaroTransition) : 0);
+    if (!transition) return false;
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    return StartTransition(slot, *transition);
+}
+
+DARO_API bool __stdcall Daro_GetTransitionState(DaroTransitionState* state)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_TRANSITION_STATE);
+    if (!state) return false;
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    memset(state, 0, sizeof(*state));
+    state->completed = g_TransitionsCompleted;
+    state->interrupted = g_TransitionsInterrupted;
+    if (!g_Transition.active) return true;
+
+    long long frame = TransitionFrame(g_FrameNumber.load());
+    const DaroTransition& params = g_Transition.params;
+    if (frame < 1) frame = 1;
+    if (frame > params.durationFrames) frame = params.durationFrames;
+    state->active = 1;
+    state->fromSlot = g_Transition.fromSlot;
+    state->toSlot = g_ProgramSlot;
+    state->type = params.type;
+    state->frame = (int)frame;
+    state->durationFrames = params.durationFrames;
+    state->progress = TransitionProgress(params, frame);
+    state->startFrame = g_Transition.startFrame;
+    return true;
+}
+
+DARO_API int __stdcall Daro_GetProgramSlot()
+{
+    DaroCaptureCall capture(DARO_CALL_GET_PROGRAM_SLOT);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    return g_ProgramSlot;
+}
+
+DARO_API bool __stdcall Daro_SetPreviewSlot(int slot)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_PREVIEW_SLOT);
+    capture.Int(slot);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    if (slot < 0 || slot >= DARO_SCENE_SLOTS || slot == g_ProgramSlot) return false;
+    g_PreviewSlot = slot;
+    return true;
+}
+
+DARO_API int __stdcall Daro_GetPreviewSlot()
+{
+    DaroCaptureCall capture(DARO_CALL_GET_PREVIEW_SLOT);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    return g_PreviewSlot;
+}
+
+// Target frame of a queued command (-1: the next frame to begin); false if invalid
+static bool ResolveCommandFrame(int when, long long at, int64_t* frame)
+{
+    long long current = g_FrameNumber.load();
+    switch (when)
+    {
+    case DARO_WHEN_IMMEDIATE:
+        *frame = -1;
+        return true;
+    case DARO_WHEN_NEXT_FRAME:
+        *frame = g_Commands.NextFrame(current);
+        return true;
+    case DARO_WHEN_FRAME:
+        if (at < 0) return false;
+        *frame = at;
+        return true;
+    case DARO_WHEN_TIMECODE:
+    {
+        DaroRational rate = g_FrameRate.load();
+        bool dropFrame = g_DropFrameTimecode.load();
+        int64_t ofDay = DaroTimecodeToFrame((uint32_t)at, rate, dropFrame);
+        int64_t day = DaroTimecodeDayFrames(rate, dropFrame);
+        if (ofDay < 0 || day <= 0) return false;
+        // The occurrence nearest to now: a timecode that just passed is late, not tomorrow
+        int64_t days = current - ofDay + day / 2;
+        days = days >= 0 ? days / day : -((-days + day - 1) / day);
+        *frame = ofDay + days * day;
+        if (*frame < 0) *frame = ofDay;
+        return true;
+    }
+    }
+    return false;
+}
+
+// Queue one command, or hold it in the thread's open batch. Returns the command id,
+// 0 if held in a batch, -1 if rejected.
+static long long QueueCommand(int when, long long at, DaroCommand* command)
+{
+    if (!command) return -1;
+    if (t_CommandBatchDepth > 0)
+    {
+        t_CommandBatch.Append(command);
+        return 0;
+    }
+    int64_t frame = 0;
+    if (!ResolveCommandFrame(when, at, &frame))
+    {
+        delete command;
+        return -1;
+    }
+    DaroCommandChain chain;
+    chain.Append(command);
+    return (long long)g_Commands.Push(chain, frame);
+}
+
+DARO_API long long __stdcall Daro_QueueLayerUpdate(int when, long long at, int index, const DaroLayer* layer)
+{
+    DaroCaptureCall capture(DARO_CALL_QUEUE_LAYER_UPDATE);
+    capture.Int(when).Int(at).Int(index).Layer(index, layer);
+    if (index < 0 || index >= DARO_MAX_LAYERS || !layer) return capture.Result(-1LL);
+    DaroCommand* command = DaroCommandQueue::Allocate();
+    if (!command) return capture.Result(-1LL);
+    command->type = DARO_CMD_UPDATE_LAYER;
+    command->target = index;
+    memcpy(&command->layer, layer, sizeof(DaroLayer));
+    return capture.Result(QueueCommand(when, at, command));
+}
+
+DARO_API long long __stdcall Daro_QueueTransition(int when, long long at, int slot, const DaroTransition* transition)
+{
+    DaroCaptureCall capture(DARO_CALL_QUEUE_TRANSITION);
+    capture.Int(when).Int(at).Int(slot).Blob(transition, transition ? sizeof(DaroTransition) : 0);
+    if (!transition || !IsSceneSlot(slot) || !IsValidTransition(*transition)) return capture.Result(-1LL);
+    DaroCommand* command = DaroCommandQueue::Allocate();
+    if (!command) return capture.Result(-1LL);
+    command->type = DARO_CMD_TRANSITION_SCENE;
+    command->target = slot;
+    command->transition = *transition;
+    return capture.Result(QueueCommand(when, at, command));
+}
+
+DARO_API long long __stdcall Daro_QueueCommand(int when, long long at, int type, int target, long long value)
+{
+    DaroCaptureCall capture(DARO_CALL_QUEUE_COMMAND);
+    capture.Int(when).Int(at).Int(type).Int(target).Int(value);
+    // Layer updates and transitions carry a payload: Daro_QueueLayerUpdate, Daro_QueueTransition
+    if (type <= DARO_CMD_UPDATE_LAYER || type >= DARO_CMD_COUNT || type == DARO_CMD_TRANSITION_SCENE)
+        return capture.Result(-1LL);
+    DaroCommand* command = DaroCommandQueue::Allocate();
+    if (!command) return capture.Result(-1LL);
+    command->type = type;
+    command->target = target;
+    command->value = value;
+    return capture.Result(QueueCommand(when, at, command));
+}
+
+DARO_API void __stdcall Daro_BeginCommandBatch()
+{
+    DaroCaptureCall capture(DARO_CALL_BEGIN_COMMAND_BATCH);
+    t_CommandBatchDepth++;
+}
+
+DARO_API long long __stdcall Daro_EndCommandBatch(int when, long long at)
+{
+    DaroCaptureCall capture(DARO_CALL_END_COMMAND_BATCH);
+    capture.Int(when).Int(at);
+    if (t_CommandBatchDepth <= 0) return capture.Result(-1LL);
+    if (--t_CommandBatchDepth > 0) return capture.Result(0LL);     // The outermost End queues
+    if (!t_CommandBatch.first) return capture.Result(0LL);
+
+    int64_t frame = 0;
+    if (!ResolveCommandFrame(when, at, &frame))
+    {
+        t_CommandBatch.Free();
+        return capture.Result(-1LL);
+    }
+    return capture.Result((long long)g_Commands.Push(t_CommandBatch, frame));
+}
+
+DARO_API bool __stdcall Daro_GetCommandQueueStats(DaroCommandQueueStats* stats)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_COMMAND_QUEUE_STATS);
+    if (!stats) return false;
+    g_Commands.GetStats(stats);
+    return true;
+}
+
+// Legacy transport: the program slot's timeline
+DARO_API void __stdcall Daro_Play()
+{
+    DaroCaptureCall capture(DARO_CALL_PLAY);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    g_Scenes[g_ProgramSlot].timeline.Play();
+}
+
+DARO_API void __stdcall Daro_Stop()
+{
+    DaroCaptureCall capture(DARO_CALL_STOP);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    g_Scenes[g_ProgramSlot].timeline.Stop();
+}
+
+DARO_API void __stdcall Daro_SeekToFrame(int frame)
+{
+    DaroCaptureCall capture(DARO_CALL_SEEK_TO_FRAME);
+    capture.Int(frame);
+    if (!g_Initialized) return;
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    g_Scenes[g_ProgramSlot].timeline.Seek(frame);
+}
+DARO_API void __stdcall Daro_SeekToTime(float time)
+{
+    DaroCaptureCall capture(DARO_CALL_SEEK_TO_TIME);
+    capture.Float(time);
+    if (!g_Initialized) return;
+    int64_t frame = DaroSecondsToFrame(time, g_FrameRate.load(), DARO_SEEK_TIME_TOLERANCE_NS);
+    Daro_SeekToFrame(frame > INT_MAX ? INT_MAX : (int)frame);
+}
+DARO_API bool __stdcall Daro_IsPlaying()
+{
+    DaroCaptureCall capture(DARO_CALL_IS_PLAYING);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    return g_Scenes[g_ProgramSlot].timeline.IsPlaying();
+}
+
+DARO_API int __stdcall Daro_GetCurrentFrame()
+{
+    DaroCaptureCall capture(DARO_CALL_GET_CURRENT_FRAME);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    return g_Scenes[g_ProgramSlot].timeline.Frame();
+}
+
+// Scene timelines (see Timeline.h)
+DARO_API bool __stdcall Daro_SetTimelineTrack(int slot, int layerIndex, int field, const DaroKeyframe* keys, int count)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_TIMELINE_TRACK);
+    capture.Int(slot).Int(layerIndex).Int(field)
+        .Blob(keys, keys && count > 0 ? (size_t)count * sizeof(DaroKeyframe) : 0).Int(count);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    return scene && scene->timeline.SetTrack(layerIndex, field, keys, count);
+}
+
+DARO_API bool __stdcall Daro_SetTimelineMarkers(int slot, const DaroTimelineMarker* markers, int count)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_TIMELINE_MARKERS);
+    capture.Int(slot).Blob(markers, markers && count > 0 ? (size_t)count * sizeof(DaroTimelineMarker) : 0).Int(count);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    return scene && scene->timeline.SetMarkers(markers, count);
+}
+
+DARO_API bool __stdcall Daro_SetTimelineLength(int slot, int frames)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_TIMELINE_LENGTH);
+    capture.Int(slot).Int(frames);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    return scene && scene->timeline.SetLength(frames);
+}
+
+DARO_API bool __stdcall Daro_ClearTimeline(int slot)
+{
+    DaroCaptureCall capture(DARO_CALL_CLEAR_TIMELINE);
+    capture.Int(slot);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    if (!scene) return false;
+    scene->timeline.Clear();
+    return true;
+}
+
+DARO_API bool __stdcall Daro_PlayTimeline(int slot)
+{
+    DaroCaptureCall capture(DARO_CALL_PLAY_TIMELINE);
+    capture.Int(slot);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    if (!scene) return false;
+    scene->timeline.Play();
+    return true;
+}
+
+DARO_API bool __stdcall Daro_StopTimeline(int slot)
+{
+    DaroCaptureCall capture(DARO_CALL_STOP_TIMELINE);
+    capture.Int(slot);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    if (!scene) return false;
+    scene->timeline.Stop();
+    return true;
+}
+
+DARO_API bool __stdcall Daro_SeekTimeline(int slot, int frame)
 {
+    DaroCaptureCall capture(DARO_CALL_SEEK_TIMELINE);
+    capture.Int(slot).Int(frame);
     std::lock_guard<std::mutex> lock(g_Mutex);
-    if (!g_Initialized) return;
-    g_FrameBuffer.reset();
-    g_Renderer.reset();
-    g_Initialized = false;
-    if (g_ComInitializedByUs)
-    {
-        CoUninitialize();
-        g_ComInitializedByUs = false;
-    }
+    DaroScene* scene = SceneAt(slot);
+    if (!scene) return false;
+    scene->timeline.Seek(frame);
+    return true;
 }
 
-DARO_API bool __stdcall Daro_IsInitialized() { return g_Initialized; }
-DARO_API int __stdcall Daro_GetLastError() { return g_LastError; }
+DARO_API bool __stdcall Daro_ContinueTimeline(int slot)
+{
+    DaroCaptureCall capture(DARO_CALL_CONTINUE_TIMELINE);
+    capture.Int(slot);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    if (!scene) return false;
+    scene->timeline.Continue();
+    return true;
+}
 
-DARO_API void __stdcall Daro_BeginFrame()
+DARO_API bool __stdcall Daro_GetTimelineState(int slot, DaroTimelineState* state)
 {
-    if (!g_Initialized) return;
+    DaroCaptureCall capture(DARO_CALL_GET_TIMELINE_STATE);
+    capture.Int(slot);
+    if (!state) return false;
     std::lock_guard<std::mutex> lock(g_Mutex);
-    if (g_Renderer) g_Renderer->BeginFrame();
+    DaroScene* scene = SceneAt(slot);
+    if (!scene) return false;
+    scene->timeline.GetState(state);
+    return true;
 }
 
-DARO_API void __stdcall Daro_EndFrame()
+// Live data binding (see DataStore.h). The store has its own lock; only the binding calls
+// take g_Mutex, to resolve DARO_SCENE_PROGRAM.
+DARO_API int __stdcall Daro_GetDataKey(const char* name)
 {
-    if (!g_Initialized) return;
+    DaroCaptureCall capture(DARO_CALL_GET_DATA_KEY);
+    capture.Str(name);
+    return capture.Result(g_DataStore.Key(name));
+}
 
-    LARGE_INTEGER now;
-    QueryPerformanceCounter(&now);
-    double elapsed = (double)(now.QuadPart - g_LastFrameTime.QuadPart) / g_PerfFreq.QuadPart;
-    g_FrameTime.store(elapsed * 1000.0);
-    g_FPS.store((elapsed > 0.000001) ? 1.0 / elapsed : 0.0);
+DARO_API int __stdcall Daro_SetDataNumbers(const int* keys, const double* values, int count)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_DATA_NUMBERS);
+    bool valid = keys && values && count > 0;
+    capture.Blob(keys, valid ? (size_t)count * sizeof(int) : 0)
+        .Blob(values, valid ? (size_t)count * sizeof(double) : 0).Int(count);
+    return capture.Result(g_DataStore.SetNumbers(keys, values, count));
+}
 
-    // Detect dropped frames: if we took longer than target frame time
-    double targetFrameTime = 1.0 / g_TargetFps;
-    if (elapsed > targetFrameTime * 1.5)  // 50% tolerance before counting as dropped
-    {
-        // Count how many frames we missed
-        int droppedCount = (int)(elapsed / targetFrameTime) - 1;
-        if (droppedCount > 0)
-        {
-            g_DroppedFrames.fetch_add(droppedCount);
-        }
-    }
+DARO_API int __stdcall Daro_SetDataTexts(const int* keys, const wchar_t* const* texts, int count)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_DATA_TEXTS);
+    bool valid = keys && texts && count > 0;
+    std::vector<uint8_t> packed;
+    if (valid && DaroCapture::IsEnabled()) packed = PackDataTexts(texts, count);
+    capture.Blob(keys, valid ? (size_t)count * sizeof(int) : 0)
+        .Blob(packed.data(), packed.size()).Int(count);
+    return capture.Result(g_DataStore.SetTexts(keys, texts, count));
+}
 
-    g_LastFrameTime = now;
-    g_FrameNumber++;
+DARO_API bool __stdcall Daro_BindLayerField(int slot, int layerIndex, int field, int key)
+{
+    DaroCaptureCall capture(DARO_CALL_BIND_LAYER_FIELD);
+    capture.Int(slot).Int(layerIndex).Int(field).Int(key);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    return scene && g_DataStore.Bind(SlotOf(scene), layerIndex, field, key);
 }
 
-DARO_API void __stdcall Daro_Render()
+DARO_API bool __stdcall Daro_ClearDataBindings(int slot)
 {
-    if (!g_Initialized) return;
+    DaroCaptureCall capture(DARO_CALL_CLEAR_DATA_BINDINGS);
+    capture.Int(slot);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    DaroScene* scene = SceneAt(slot);
+    if (!scene) return false;
+    g_DataStore.ClearBindings(SlotOf(scene));
+    return true;
+}
 
-    // Copy layers under lock, then render outside lock to minimize contention
-    // But validate g_Renderer under lock to prevent use-after-free on Shutdown
-    int localLayerCount;
-    static thread_local DaroLayer localLayers[DARO_MAX_LAYERS];
+// Shared-memory ingest region for feed processes (DaroDataIngestWriter)
+DARO_API bool __stdcall Daro_EnableDataIngest(const char* name, int entryCount)
+{
+    DaroCaptureCall capture(DARO_CALL_ENABLE_DATA_INGEST);
+    capture.Str(name).Int(entryCount);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    if (!g_Initialized) return false;
 
+    g_DataIngest.reset();
+    g_DataStore.SetIngestEntries(0);
+    auto ingest = std::make_unique<DaroDataIngest>();
+    if (!ingest->Start((name && name[0]) ? name : DARO_DATA_INGEST_NAME, entryCount))
     {
-        std::lock_guard<std::mutex> lock(g_Mutex);
-        if (!g_Renderer) return;
-        localLayerCount = g_LayerCount;
-        memcpy(localLayers, g_Layers, sizeof(DaroLayer) * localLayerCount);
+        OutputDebugStringA("[DaroEngine] Data ingest: could not create the shared-memory region\n");
+        return false;
     }
+    g_DataStore.SetIngestEntries(ingest->GetEntryCount());
+    g_DataIngest = std::move(ingest);
+    return true;
+}
 
-    // Build mask lookup from local copy (function-local static to avoid per-frame allocation)
-    static thread_local std::unordered_map<int, std::vector<int>> layerToMasks;
-    for (auto& pair : layerToMasks)
-    {
-        pair.second.clear();
-    }
+DARO_API void __stdcall Daro_DisableDataIngest()
+{
+    DaroCaptureCall capture(DARO_CALL_DISABLE_DATA_INGEST);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    g_DataIngest.reset();
+    g_DataStore.SetIngestEntries(0);
+}
 
-    for (int i = 0; i < localLayerCount; i++)
-    {
-        if (localLayers[i].layerType == DARO_TYPE_MASK && localLayers[i].maskedLayerCount > 0)
-        {
-            int safeCount = min(localLayers[i].maskedLayerCount, DARO_MAX_LAYERS);
-            for (int j = 0; j < safeCount; j++)
-            {
-                int maskedId = localLayers[i].maskedLayerIds[j];
-                if (maskedId >= 0)
-                    layerToMasks[maskedId].push_back(i);
-            }
-        }
-    }
+DARO_API bool __stdcall Daro_GetDataStoreStats(DaroDataStoreStats* stats)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_DATA_STORE_STATS);
+    if (!stats) return false;
+    g_DataStore.GetStats(stats);
+    return true;
+}
 
-    // Render - safe because C# side serializes all engine calls through _engineLock
-    // and Stop() waits for render thread before Shutdown() is called
-    g_Renderer->Clear(0.0f, 0.0f, 0.0f, 0.0f);
-    g_Renderer->RenderWithMasks(localLayers, localLayerCount, layerToMasks);
-    g_Renderer->CopyToStaging();
+DARO_API double __stdcall Daro_GetFPS()
+{
+    DaroCaptureCall capture(DARO_CALL_GET_FPS);
+    return g_FPS;
+}
 
-    void* pData = nullptr;
-    int rowPitch = 0;
-    if (g_Renderer->MapStaging(&pData, &rowPitch))
-    {
-        if (g_FrameBuffer)
-            g_FrameBuffer->Write(pData, rowPitch, g_FrameNumber.load());
-        g_Renderer->UnmapStaging();
-    }
+DARO_API double __stdcall Daro_GetFrameTime()
+{
+    DaroCaptureCall capture(DARO_CALL_GET_FRAME_TIME);
+    return g_FrameTime;
 }
 
-DARO_API void __stdcall Daro_Present()
+DARO_API int __stdcall Daro_GetDroppedFrames()
 {
-    if (!g_Initialized || !g_Renderer) return;
-    g_Renderer->SendSpout();
+    DaroCaptureCall capture(DARO_CALL_GET_DROPPED_FRAMES);
+    return g_DroppedFrames;
 }
 
-DARO_API bool __stdcall Daro_LockFrameBuffer(void** ppData, int* pWidth, int* pHeight, int* pStride)
+DARO_API int __stdcall Daro_GetLateFrames()
 {
-    if (!g_Initialized || !g_FrameBuffer || !ppData || !pWidth || !pHeight || !pStride) return false;
-    return g_FrameBuffer->Lock(ppData, pWidth, pHeight, pStride);
+    DaroCaptureCall capture(DARO_CALL_GET_LATE_FRAMES);
+    return g_LateFrames;
 }
 
-DARO_API void __stdcall Daro_UnlockFrameBuffer()
+// Spout Output - NOW IMPLEMENTED!
+DARO_API bool __stdcall Daro_EnableSpoutOutput(const char* senderName)
 {
-    if (g_FrameBuffer) g_FrameBuffer->Unlock();
+    DaroCaptureCall capture(DARO_CALL_ENABLE_SPOUT_OUTPUT);
+    capture.Str(senderName);
+    if (!g_Initialized || !g_Renderer) return false;
+    return g_Renderer->EnableSpout(senderName);
 }
 
-DARO_API long long __stdcall Daro_GetFrameNumber() { return g_FrameNumber; }
+DARO_API void __stdcall Daro_DisableSpoutOutput()
+{
+    DaroCaptureCall capture(DARO_CALL_DISABLE_SPOUT_OUTPUT);
+    if (g_Initialized && g_Renderer)
+        g_Renderer->DisableSpout();
+}
 
-DARO_API void __stdcall Daro_SetLayerCount(int count)
+DARO_API bool __stdcall Daro_IsSpoutEnabled()
+{
+    DaroCaptureCall capture(DARO_CALL_IS_SPOUT_ENABLED);
+    if (!g_Initialized || !g_Renderer) return false;
+    return g_Renderer->IsSpoutEnabled();
+}
+
+DARO_API void __stdcall Daro_SetSpoutSendTimeout(int milliseconds)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_SPOUT_SEND_TIMEOUT);
+    capture.Int(milliseconds);
+    if (g_Initialized && g_Renderer)
+        g_Renderer->SetSpoutSendTimeout(milliseconds);
+}
+
+DARO_API bool __stdcall Daro_GetSpoutOutputStats(DaroSpoutOutputStats* stats)
 {
+    DaroCaptureCall capture(DARO_CALL_GET_SPOUT_OUTPUT_STATS);
+    if (!g_Initialized || !g_Renderer || !stats) return false;
+    g_Renderer->GetSpoutOutputStats(stats);
+    return true;
+}
+
+// g_Mutex held
+static void SetOutputMetadata(const char* templateName, const char* itemName)
+{
+    memset(g_OutputMetadata.templateName, 0, sizeof(g_OutputMetadata.templateName));
+    memset(g_OutputMetadata.itemName, 0, sizeof(g_OutputMetadata.itemName));
+    if (templateName)
+        strncpy_s(g_OutputMetadata.templateName, sizeof(g_OutputMetadata.templateName), templateName, _TRUNCATE);
+    if (itemName)
+        strncpy_s(g_OutputMetadata.itemName, sizeof(g_OutputMetadata.itemName), itemName, _TRUNCATE);
+
+    std::lock_guard<std::mutex> onAirLock(g_OnAirMutex);
+    g_OnAirMetadata = g_OutputMetadata;
+}
+
+DARO_API void __stdcall Daro_SetOutputMetadata(const char* templateName, const char* itemName)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_OUTPUT_METADATA);
+    capture.Str(templateName).Str(itemName);
     std::lock_guard<std::mutex> lock(g_Mutex);
-    // Clamp to valid range [0, DARO_MAX_LAYERS] to prevent negative or excessive values
-    if (count < 0) count = 0;
-    g_LayerCount = min(count, DARO_MAX_LAYERS);
+    SetOutputMetadata(templateName, itemName);
 }
 
-DARO_API void __stdcall Daro_UpdateLayer(int index, const DaroLayer* layer)
+// CPU frame transport (portable shared memory, see FrameTransport.h)
+DARO_API bool __stdcall Daro_EnableFrameTransport(const char* senderName)
 {
-    if (index < 0 || index >= DARO_MAX_LAYERS || !layer) return;
+    DaroCaptureCall capture(DARO_CALL_ENABLE_FRAME_TRANSPORT);
+    capture.Str(senderName);
     std::lock_guard<std::mutex> lock(g_Mutex);
-    memcpy(&g_Layers[index], layer, sizeof(DaroLayer));
+    if (!g_Initialized || !g_FrameBuffer || !senderName) return false;
+
+    auto sender = std::make_unique<DaroFrameSender>();
+    if (!sender->Create(senderName, (uint32_t)g_FrameBuffer->GetWidth(), (uint32_t)g_FrameBuffer->GetHeight(), DARO_PIXEL_BGRA8))
+        return false;
+    DaroMemoryAccountant::Instance().Set(DARO_MEM_FRAME_TRANSPORT, MEM_ASSET_TRANSPORT, (long long)sender->GetMemorySize(), 0);
+    g_FrameSender = std::move(sender);
+    return true;
 }
 
-DARO_API void __stdcall Daro_GetLayer(int index, DaroLayer* layer)
+DARO_API void __stdcall Daro_DisableFrameTransport()
 {
-    if (index < 0 || index >= DARO_MAX_LAYERS || !layer) return;
+    DaroCaptureCall capture(DARO_CALL_DISABLE_FRAME_TRANSPORT);
     std::lock_guard<std::mutex> lock(g_Mutex);
-    memcpy(layer, &g_Layers[index], sizeof(DaroLayer));
+    g_FrameSender.reset();
+    DaroMemoryAccountant::Instance().Remove(DARO_MEM_FRAME_TRANSPORT, MEM_ASSET_TRANSPORT);
 }
 
-DARO_API void __stdcall Daro_ClearLayers()
+DARO_API bool __stdcall Daro_IsFrameTransportEnabled()
+{
+    DaroCaptureCall capture(DARO_CALL_IS_FRAME_TRANSPORT_ENABLED);
+    return g_FrameSender != nullptr;
+}
+
+// Preview output: the preview slot rendered after each program frame and published through
+// a frame transport sender at 1/divisor size
+DARO_API bool __stdcall Daro_EnablePreviewOutput(const char* senderName, int divisor)
 {
+    DaroCaptureCall capture(DARO_CALL_ENABLE_PREVIEW_OUTPUT);
+    capture.Str(senderName).Int(divisor);
     std::lock_guard<std::mutex> lock(g_Mutex);
-    memset(g_Layers, 0, sizeof(g_Layers));
-    g_LayerCount = 0;
+    if (!g_Initialized || !g_Renderer || !senderName) return false;
+    std::lock_guard<std::mutex> previewLock(g_PreviewMutex);
+
+    g_PreviewSender.reset();
+    DaroMemoryAccountant::Instance().Remove(DARO_MEM_FRAME_TRANSPORT, MEM_ASSET_PREVIEW_TRANSPORT);
+    if (!g_Renderer->EnablePreview(divisor)) return false;
+
+    auto sender = std::make_unique<DaroFrameSender>();
+    if (!sender->Create(senderName, (uint32_t)g_Renderer->GetPreviewWidth(), (uint32_t)g_Renderer->GetPreviewHeight(), DARO_PIXEL_BGRA8))
+    {
+        g_Renderer->DisablePreview();
+        return false;
+    }
+    DaroMemoryAccountant::Instance().Set(DARO_MEM_FRAME_TRANSPORT, MEM_ASSET_PREVIEW_TRANSPORT, (long long)sender->GetMemorySize(), 0);
+    g_PreviewSender = std::move(sender);
+    return true;
 }
 
-DARO_API void __stdcall Daro_Play() { g_IsPlaying = true; }
-DARO_API void __stdcall Daro_Stop() { g_IsPlaying = false; }
-DARO_API void __stdcall Daro_SeekToFrame(int frame)
+DARO_API void __stdcall Daro_DisablePreviewOutput()
 {
-    if (!g_Initialized) return;
-    int totalFrames = g_TotalFrames.load();
-    if (totalFrames <= 0) return;
-    g_CurrentFrame = max(0, min(frame, totalFrames - 1));
+    DaroCaptureCall capture(DARO_CALL_DISABLE_PREVIEW_OUTPUT);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    std::lock_guard<std::mutex> previewLock(g_PreviewMutex);
+    g_PreviewSender.reset();
+    DaroMemoryAccountant::Instance().Remove(DARO_MEM_FRAME_TRANSPORT, MEM_ASSET_PREVIEW_TRANSPORT);
+    if (g_Renderer) g_Renderer->DisablePreview();
 }
-DARO_API void __stdcall Daro_SeekToTime(float time)
+
+DARO_API bool __stdcall Daro_IsPreviewOutputEnabled()
 {
-    if (!g_Initialized) return;
-    Daro_SeekToFrame((int)(time * g_TargetFps));
+    DaroCaptureCall capture(DARO_CALL_IS_PREVIEW_OUTPUT_ENABLED);
+    std::lock_guard<std::mutex> previewLock(g_PreviewMutex);
+    return g_PreviewSender != nullptr;
 }
-DARO_API bool __stdcall Daro_IsPlaying() { return g_IsPlaying; }
-DARO_API int __stdcall Daro_GetCurrentFrame() { return g_CurrentFrame; }
 
-DARO_API double __stdcall Daro_GetFPS() { return g_FPS; }
-DARO_API double __stdcall Daro_GetFrameTime() { return g_FrameTime; }
-DARO_API int __stdcall Daro_GetDroppedFrames() { return g_DroppedFrames; }
+// Runs on the stats publisher thread: only atomics, seqlocked rings and short-held locks
+// the render thread rarely takes. g_Renderer stays valid because Daro_Shutdown stops the
+// publisher before releasing it.
+static void GatherStats(DaroStatsSnapshot* snapshot)
+{
+    long long frameNumber = g_FrameNumber.load();
+    snapshot->frameNumber = frameNumber;
+    snapshot->droppedFrames = g_DroppedFrames.load();
+    snapshot->lateFrames = g_LateFrames.load();
+    snapshot->targetFps = g_TargetFps;
+    snapshot->fps = g_FPS.load();
+    snapshot->frameTimeMs = g_FrameTime.load();
+    {
+        std::lock_guard<std::mutex> lock(g_OnAirMutex);
+        snapshot->onAir = g_OnAirMetadata;
+    }
+    snapshot->onAir.engineFrame = frameNumber;
+    snapshot->onAir.timecode = (int)OutputTimecode(frameNumber);
 
-// Spout Output - NOW IMPLEMENTED!
-DARO_API bool __stdcall Daro_EnableSpoutOutput(const char* senderName)
+    DaroFrameProfiler& profiler = DaroFrameProfiler::Instance();
+    profiler.GetFrameStats(&snapshot->lastFrame, 1);
+    for (int metric = 0; metric < DARO_TIMING_METRIC_COUNT; metric++)
+    {
+        profiler.GetTiming(metric)->Summarize(DARO_TIMING_SINCE_RESET, &snapshot->timing[metric][0]);
+        profiler.GetTiming(metric)->Summarize(DARO_TIMING_LAST_WINDOW, &snapshot->timing[metric][1]);
+    }
+
+    DaroMemoryAccountant& memory = DaroMemoryAccountant::Instance();
+    memory.GetStats(DARO_MEM_ALL, &snapshot->memoryTotal);
+    for (int category = 0; category < DARO_MEM_CATEGORY_COUNT; category++)
+        memory.GetStats(category, &snapshot->memory[category]);
+
+    if (g_Renderer) g_Renderer->GetSpoutOutputStats(&snapshot->spoutOutput);
+    snapshot->videoCount = VideoManager::Instance().GetVideoStates(snapshot->videos, DARO_STATS_MAX_VIDEOS);
+}
+
+// Live stats block in named shared memory for external monitors (see StatsBlock.h)
+DARO_API bool __stdcall Daro_EnableStatsBlock(const char* name, int intervalMs)
 {
+    DaroCaptureCall capture(DARO_CALL_ENABLE_STATS_BLOCK);
+    capture.Str(name).Int(intervalMs);
+    std::lock_guard<std::mutex> lock(g_Mutex);
     if (!g_Initialized || !g_Renderer) return false;
-    return g_Renderer->EnableSpout(senderName);
+
+    g_StatsPublisher.reset();
+    auto publisher = std::make_unique<DaroStatsPublisher>();
+    if (!publisher->Start((name && name[0]) ? name : DARO_STATS_BLOCK_NAME,
+                          intervalMs > 0 ? (uint32_t)intervalMs : DARO_STATS_DEFAULT_INTERVAL_MS, GatherStats))
+    {
+        OutputDebugStringA("[DaroEngine] Stats block: segment unavailable or already published by another engine\n");
+        return false;
+    }
+    g_StatsPublisher = std::move(publisher);
+    return true;
 }
 
-DARO_API void __stdcall Daro_DisableSpoutOutput()
+DARO_API void __stdcall Daro_DisableStatsBlock()
 {
-    if (g_Initialized && g_Renderer)
-        g_Renderer->DisableSpout();
+    DaroCaptureCall capture(DARO_CALL_DISABLE_STATS_BLOCK);
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    g_StatsPublisher.reset();
 }
 
-DARO_API bool __stdcall Daro_IsSpoutEnabled()
+DARO_API bool __stdcall Daro_IsStatsBlockEnabled()
 {
-    if (!g_Initialized || !g_Renderer) return false;
-    return g_Renderer->IsSpoutEnabled();
+    DaroCaptureCall capture(DARO_CALL_IS_STATS_BLOCK_ENABLED);
+    return g_StatsPublisher != nullptr;
 }
 
 // Texture management
 DARO_API int __stdcall Daro_LoadTexture(const char* filePath)
 {
-    if (!g_Initialized || !g_Renderer) return -1;
-    return g_Renderer->LoadTexture(filePath);
+    DaroCaptureCall capture(DARO_CALL_LOAD_TEXTURE);
+    capture.Str(filePath);
+    if (!g_Initialized || !g_Renderer) return capture.Result(-1);
+    int id = g_Renderer->LoadTexture(filePath);
+    if (id >= 0 && filePath)
+    {
+        std::lock_guard<std::mutex> lock(g_CaptureAssetsMutex);
+        g_CaptureTextures[id] = filePath;
+    }
+    return capture.Result(id);
 }
 
 DARO_API void __stdcall Daro_UnloadTexture(int textureId)
 {
+    DaroCaptureCall capture(DARO_CALL_UNLOAD_TEXTURE);
+    capture.Int(textureId);
     if (g_Initialized && g_Renderer)
         g_Renderer->UnloadTexture(textureId);
+    std::lock_guard<std::mutex> lock(g_CaptureAssetsMutex);
+    g_CaptureTextures.erase(textureId);
 }
 
 // Spout Input
 DARO_API int __stdcall Daro_GetSpoutSenderCount()
 {
+    DaroCaptureCall capture(DARO_CALL_GET_SPOUT_SENDER_COUNT);
     if (!g_Initialized || !g_Renderer) return 0;
     return g_Renderer->GetSpoutSenderCount();
 }
 
 DARO_API bool __stdcall Daro_GetSpoutSenderName(int index, char* buffer, int bufferSize)
 {
+    DaroCaptureCall capture(DARO_CALL_GET_SPOUT_SENDER_NAME);
+    capture.Int(index).Int(bufferSize);
     if (!g_Initialized || !g_Renderer) return false;
     return g_Renderer->GetSpoutSenderName(index, buffer, bufferSize);
 }
 
 DARO_API int __stdcall Daro_ConnectSpoutReceiver(const char* senderName)
 {
-    if (!g_Initialized || !g_Renderer) return -1;
-    return g_Renderer->ConnectSpoutReceiver(senderName);
+    DaroCaptureCall capture(DARO_CALL_CONNECT_SPOUT_RECEIVER);
+    capture.Str(senderName);
+    int id;
+    {
+        // The receiver map is walked by Daro_BeginFrame under g_Mutex
+        std::lock_guard<std::mutex> lock(g_Mutex);
+        if (!g_Initialized || !g_Renderer) return capture.Result(-1);
+        id = g_Renderer->ConnectSpoutReceiver(senderName);
+    }
+    if (id >= 0 && senderName)
+    {
+        std::lock_guard<std::mutex> lock(g_CaptureAssetsMutex);
+        g_CaptureReceivers[id] = senderName;
+    }
+    return capture.Result(id);
 }
 
 DARO_API void __stdcall Daro_DisconnectSpoutReceiver(int receiverId)
 {
-    if (g_Initialized && g_Renderer)
-        g_Renderer->DisconnectSpoutReceiver(receiverId);
+    DaroCaptureCall capture(DARO_CALL_DISCONNECT_SPOUT_RECEIVER);
+    capture.Int(receiverId);
+    {
+        std::lock_guard<std::mutex> lock(g_Mutex);
+        if (g_Initialized && g_Renderer)
+            g_Renderer->DisconnectSpoutReceiver(receiverId);
+    }
+    std::lock_guard<std::mutex> lock(g_CaptureAssetsMutex);
+    g_CaptureReceivers.erase(receiverId);
+}
+
+DARO_API bool __stdcall Daro_GetSpoutReceiverStats(int receiverId, DaroSpoutReceiverStats* stats)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_SPOUT_RECEIVER_STATS);
+    capture.Int(receiverId);
+    if (!stats) return false;
+    // Counters and size are written by Daro_BeginFrame under g_Mutex
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    if (!g_Initialized || !g_Renderer) return false;
+    return g_Renderer->GetSpoutReceiverStats(receiverId, stats);
+}
+
+DARO_API bool __stdcall Daro_GetSpoutReceiverMetadata(int receiverId, DaroFrameMetadata* metadata)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_SPOUT_RECEIVER_METADATA);
+    capture.Int(receiverId);
+    if (!metadata) return false;
+    // The reader is opened lazily here, on the same receiver map Daro_BeginFrame walks
+    std::lock_guard<std::mutex> lock(g_Mutex);
+    if (!g_Initialized || !g_Renderer) return false;
+    return g_Renderer->GetSpoutReceiverMetadata(receiverId, metadata);
 }
 
 // Debug - structure info
 DARO_API int __stdcall Daro_GetStructSize()
 {
+    DaroCaptureCall capture(DARO_CALL_GET_STRUCT_SIZE);
     return (int)sizeof(DaroLayer);
 }
 
 DARO_API int __stdcall Daro_GetOffsetPosX()
 {
+    DaroCaptureCall capture(DARO_CALL_GET_OFFSET_POS_X);
     return (int)offsetof(DaroLayer, posX);
 }
 
 DARO_API int __stdcall Daro_GetOffsetSizeX()
 {
+    DaroCaptureCall capture(DARO_CALL_GET_OFFSET_SIZE_X);
     return (int)offsetof(DaroLayer, sizeX);
 }
 
 DARO_API int __stdcall Daro_GetOffsetOpacity()
 {
+    DaroCaptureCall capture(DARO_CALL_GET_OFFSET_OPACITY);
     return (int)offsetof(DaroLayer, opacity);
 }
 
 DARO_API int __stdcall Daro_GetOffsetTextContent()
 {
+    DaroCaptureCall capture(DARO_CALL_GET_OFFSET_TEXT_CONTENT);
     return (int)offsetof(DaroLayer, textContent);
 }
 
 // Debug - bounding boxes
 DARO_API void __stdcall Daro_SetShowBounds(bool show)
 {
+    DaroCaptureCall capture(DARO_CALL_SET_SHOW_BOUNDS);
+    capture.Bool(show);
     if (g_Initialized && g_Renderer)
         g_Renderer->SetShowBounds(show);
 }
 
+// Layer cost attribution
+DARO_API void __stdcall Daro_SetLayerCostEnabled(bool enabled)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_LAYER_COST_ENABLED);
+    capture.Bool(enabled);
+    if (g_Initialized && g_Renderer)
+        g_Renderer->SetLayerCostEnabled(enabled);
+}
+
+DARO_API int __stdcall Daro_GetLayerCosts(DaroLayerCost* buffer, int maxCount)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_LAYER_COSTS);
+    capture.Int(maxCount);
+    if (!g_Initialized || !g_Renderer) return 0;
+    return g_Renderer->GetLayerCosts(buffer, maxCount);
+}
+
+DARO_API bool __stdcall Daro_GetLayerCost(int layerId, DaroLayerCost* cost)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_LAYER_COST);
+    capture.Int(layerId);
+    if (!g_Initialized || !g_Renderer) return false;
+    return g_Renderer->GetLayerCost(layerId, cost);
+}
+
+// Memory accounting (any thread, valid before Daro_Initialize and after Daro_Shutdown)
+DARO_API bool __stdcall Daro_GetMemoryStats(int category, DaroMemoryStats* stats)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_MEMORY_STATS);
+    capture.Int(category);
+    return DaroMemoryAccountant::Instance().GetStats(category, stats);
+}
+
+DARO_API int __stdcall Daro_GetMemoryAssets(int category, DaroMemoryAsset* buffer, int maxCount)
+{
+    DaroCaptureCall capture(DARO_CALL_GET_MEMORY_ASSETS);
+    capture.Int(category).Int(maxCount);
+    return DaroMemoryAccountant::Instance().GetAssets(category, buffer, maxCount);
+}
+
+DARO_API void __stdcall Daro_SetMemoryBudget(int category, long long bytes)
+{
+    DaroCaptureCall capture(DARO_CALL_SET_MEMORY_BUDGET);
+    capture.Int(category).Int(bytes);
+    DaroMemoryAccountant::Instance().SetBudget(category, bytes);
+}
+
+DARO_API bool __stdcall Daro_IsMemoryOverBudget(int category)
+{
+    DaroCaptureCall capture(DARO_CALL_IS_MEMORY_OVER_BUDGET);
+    capture.Int(category);
+    return DaroMemoryAccountant::Instance().IsOverBudget(category);
+}
+
+DARO_API void __stdcall Daro_ResetMemoryPeaks()
+{
+    DaroCaptureCall capture(DARO_CALL_RESET_MEMORY_PEAKS);
+    DaroMemoryAccountant::Instance().ResetPeaks();
+}
+
 // Device status
 DARO_API bool __stdcall Daro_IsDeviceLost()
 {
+    DaroCaptureCall capture(DARO_CALL_IS_DEVICE_LOST);
     if (!g_Initialized || !g_Renderer) return false;
     return g_Renderer->IsDeviceLost();
 }
@@ -364,12 +2136,15 @@ DARO_API bool __stdcall Daro_IsDeviceLost()
 // Edge antialiasing
 DARO_API void __stdcall Daro_SetEdgeSmoothing(float width)
 {
+    DaroCaptureCall capture(DARO_CALL_SET_EDGE_SMOOTHING);
+    capture.Float(width);
     if (g_Initialized && g_Renderer)
         g_Renderer->SetEdgeSmoothing(width);
 }
 
 DARO_API float __stdcall Daro_GetEdgeSmoothing()
 {
+    DaroCaptureCall capture(DARO_CALL_GET_EDGE_SMOOTHING);
     if (!g_Initialized || !g_Renderer) return 0.0f;
     return g_Renderer->GetEdgeSmoothing();
 }
@@ -377,80 +2152,360 @@ DARO_API float __stdcall Daro_GetEdgeSmoothing()
 // Video playback
 DARO_API int __stdcall Daro_LoadVideo(const char* filePath)
 {
+    DaroCaptureCall capture(DARO_CALL_LOAD_VIDEO);
+    capture.Str(filePath);
     if (!g_Initialized || !g_Renderer)
     {
         VideoLog("[DaroVideo] Daro_LoadVideo: engine not initialized\n");
-        return -1;
+        return capture.Result(-1);
     }
     int id = g_Renderer->LoadVideo(filePath);
     char dbg[256];
     sprintf_s(dbg, "[DaroVideo] Daro_LoadVideo: returned id=%d\n", id);
     VideoLog(dbg);
-    return id;
+    if (id >= 0 && filePath)
+    {
+        std::lock_guard<std::mutex> lock(g_CaptureAssetsMutex);
+        g_CaptureVideos[id].path = filePath;
+    }
+    return capture.Result(id);
 }
 
 DARO_API void __stdcall Daro_UnloadVideo(int videoId)
 {
+    DaroCaptureCall capture(DARO_CALL_UNLOAD_VIDEO);
+    capture.Int(videoId);
     if (g_Initialized && g_Renderer)
         g_Renderer->UnloadVideo(videoId);
+    std::lock_guard<std::mutex> lock(g_CaptureAssetsMutex);
+    g_CaptureVideos.erase(videoId);
 }
 
 DARO_API void __stdcall Daro_PlayVideo(int videoId)
 {
+    DaroCaptureCall capture(DARO_CALL_PLAY_VIDEO);
+    capture.Int(videoId);
     if (g_Initialized && g_Renderer)
         g_Renderer->PlayVideo(videoId);
 }
 
 DARO_API void __stdcall Daro_PauseVideo(int videoId)
 {
+    DaroCaptureCall capture(DARO_CALL_PAUSE_VIDEO);
+    capture.Int(videoId);
     if (g_Initialized && g_Renderer)
         g_Renderer->PauseVideo(videoId);
 }
 
 DARO_API void __stdcall Daro_StopVideo(int videoId)
 {
+    DaroCaptureCall capture(DARO_CALL_STOP_VIDEO);
+    capture.Int(videoId);
     if (g_Initialized && g_Renderer)
         g_Renderer->StopVideo(videoId);
 }
 
 DARO_API void __stdcall Daro_SeekVideo(int videoId, int frame)
 {
+    DaroCaptureCall capture(DARO_CALL_SEEK_VIDEO);
+    capture.Int(videoId).Int(frame);
     if (g_Initialized && g_Renderer)
         g_Renderer->SeekVideo(videoId, frame);
 }
 
 DARO_API void __stdcall Daro_SeekVideoTime(int videoId, double seconds)
 {
+    DaroCaptureCall capture(DARO_CALL_SEEK_VIDEO_TIME);
+    capture.Int(videoId).Double(seconds);
     if (g_Initialized && g_Renderer)
         g_Renderer->SeekVideoTime(videoId, seconds);
 }
 
 DARO_API bool __stdcall Daro_IsVideoPlaying(int videoId)
 {
+    DaroCaptureCall capture(DARO_CALL_IS_VIDEO_PLAYING);
+    capture.Int(videoId);
     if (!g_Initialized || !g_Renderer) return false;
     return g_Renderer->IsVideoPlaying(videoId);
 }
 
 DARO_API int __stdcall Daro_GetVideoFrame(int videoId)
 {
+    DaroCaptureCall capture(DARO_CALL_GET_VIDEO_FRAME);
+    capture.Int(videoId);
     if (!g_Initialized || !g_Renderer) return 0;
     return g_Renderer->GetVideoFrame(videoId);
 }
 
 DARO_API int __stdcall Daro_GetVideoTotalFrames(int videoId)
 {
+    DaroCaptureCall capture(DARO_CALL_GET_VIDEO_TOTAL_FRAMES);
+    capture.Int(videoId);
     if (!g_Initialized || !g_Renderer) return 0;
     return g_Renderer->GetVideoTotalFrames(videoId);
 }
 
 DARO_API void __stdcall Daro_SetVideoLoop(int videoId, bool loop)
 {
+    DaroCaptureCall capture(DARO_CALL_SET_VIDEO_LOOP);
+    capture.Int(videoId).Bool(loop);
     if (g_Initialized && g_Renderer)
         g_Renderer->SetVideoLoop(videoId, loop);
+    std::lock_guard<std::mutex> lock(g_CaptureAssetsMutex);
+    auto it = g_CaptureVideos.find(videoId);
+    if (it != g_CaptureVideos.end()) it->second.loop = loop;
 }
 
 DARO_API void __stdcall Daro_SetVideoAlpha(int videoId, bool alpha)
 {
+    DaroCaptureCall capture(DARO_CALL_SET_VIDEO_ALPHA);
+    capture.Int(videoId).Bool(alpha);
     if (g_Initialized && g_Renderer)
         g_Renderer->SetVideoAlpha(videoId, alpha);
+    std::lock_guard<std::mutex> lock(g_CaptureAssetsMutex);
+    auto it = g_CaptureVideos.find(videoId);
+    if (it != g_CaptureVideos.end()) it->second.alpha = alpha;
+}
+
+// Binary command buffers (see CommandBuffer.h)
+static bool IsSubmitLoad(int op) { return op == DARO_OP_LOAD_TEXTURE || op == DARO_OP_LOAD_VIDEO; }
+static bool IsSubmitUnload(int op) { return op == DARO_OP_UNLOAD_TEXTURE || op == DARO_OP_UNLOAD_VIDEO; }
+static bool IsSubmitLayerOp(int op)
+{
+    return op == DARO_OP_SET_LAYER_COUNT || op == DARO_OP_UPDATE_LAYER || op == DARO_OP_CLEAR_LAYERS;
+}
+static bool IsSubmitTimelineOp(int op)
+{
+    return op == DARO_OP_PLAY || op == DARO_OP_STOP || op == DARO_OP_SEEK_TO_FRAME || op == DARO_OP_CONTINUE_TIMELINE;
+}
+
+// Slot the layer and timeline ops after a DARO_OP_EDIT_SCENE edit. A bad one leaves them without a
+// slot, so they fail rather than edit the scene on air.
+static int EditSubmitted(const DaroSubmitCommand& submitted, int* scene)
+{
+    bool valid = submitted.status == DARO_SUBMIT_OK && IsSceneSlot(submitted.id);
+    *scene = valid ? submitted.id : INT_MIN;
+    return submitted.status != DARO_SUBMIT_OK ? submitted.status : valid ? DARO_SUBMIT_OK : DARO_SUBMIT_ERROR_INVALID;
+}
+
+// Replace a reference (DARO_SUBMIT_REF) with the id its load returned. False if it names
+// a command that is not an earlier load of that kind or whose load failed.
+static bool ResolveSubmitRef(int* id, int loadOp, int index,
+    const std::vector<DaroSubmitCommand>& commands, const std::vector<int>& results)
+{
+    if (!DaroIsSubmitRef(*id)) return true;
+    int ref = DaroSubmitRefIndex(*id);
+    if (ref >= index || commands[ref].op != loadOp || results[ref] < 0) return false;
+    *id = results[ref];
+    return true;
+}
+
+// Fill the command queue entry for a submitted command, resolving its references; layer
+// and timeline ops act on scene. Returns DARO_SUBMIT_OK or the command's error; ops the queue
+// has no entry for (output metadata, loads and unloads) are DARO_SUBMIT_ERROR_NOT_QUEUEABLE.
+static int PrepareSubmitted(const std::vector<DaroSubmitCommand>& commands,
+    const std::vector<int>& results, int index, int scene, DaroCommand* command)
+{
+    const DaroSubmitCommand& submitted = commands[index];
+    if ((IsSubmitLayerOp(submitted.op) || IsSubmitTimelineOp(submitted.op)) && !IsSceneSlot(scene))
+        return DARO_SUBMIT_ERROR_INVALID;
+    command->scene = scene;
+    int id = submitted.id;
+    if (DaroSubmitOpTakesTexture(submitted.op) &&
+        !ResolveSubmitRef(&id, DARO_OP_LOAD_TEXTURE, index, commands, results)) return DARO_SUBMIT_ERROR_INVALID;
+    if (DaroSubmitOpTakesVideo(submitted.op) &&
+        !ResolveSubmitRef(&id, DARO_OP_LOAD_VIDEO, index, commands, results)) return DARO_SUBMIT_ERROR_INVALID;
+
+    command->target = id;
+    switch (submitted.op)
+    {
+    case DARO_OP_SET_LAYER_COUNT:
+        command->type = DARO_CMD_SET_LAYER_COUNT;
+        command->value = id;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_UPDATE_LAYER:
+    {
+        if (id < 0 || id >= DARO_MAX_LAYERS) return DARO_SUBMIT_ERROR_INVALID;
+        command->type = DARO_CMD_UPDATE_LAYER;
+        memcpy(&command->layer, submitted.layer, sizeof(DaroLayer));
+        int loadOp = command->layer.sourceType == DARO_SOURCE_IMAGE ? DARO_OP_LOAD_TEXTURE :
+                     command->layer.sourceType == DARO_SOURCE_VIDEO ? DARO_OP_LOAD_VIDEO : 0;
+        if (!ResolveSubmitRef(&command->layer.textureId, loadOp, index, commands, results))
+            return DARO_SUBMIT_ERROR_INVALID;
+        return DARO_SUBMIT_OK;
+    }
+    case DARO_OP_CLEAR_LAYERS:
+        command->type = DARO_CMD_CLEAR_LAYERS;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_PLAY_VIDEO:
+        command->type = DARO_CMD_PLAY_VIDEO;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_PAUSE_VIDEO:
+        command->type = DARO_CMD_PAUSE_VIDEO;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_STOP_VIDEO:
+        command->type = DARO_CMD_STOP_VIDEO;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_SEEK_VIDEO:
+        command->type = DARO_CMD_SEEK_VIDEO;
+        command->value = submitted.value;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_SEEK_VIDEO_TIME:
+        if (!(submitted.seconds >= 0.0 && submitted.seconds < 1e9)) return DARO_SUBMIT_ERROR_INVALID;
+        command->type = DARO_CMD_SEEK_VIDEO_TIME;
+        command->value = llround(submitted.seconds * 1e9);
+        return DARO_SUBMIT_OK;
+    case DARO_OP_SET_VIDEO_LOOP:
+        command->type = DARO_CMD_SET_VIDEO_LOOP;
+        command->value = submitted.value != 0;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_SET_VIDEO_ALPHA:
+        command->type = DARO_CMD_SET_VIDEO_ALPHA;
+        command->value = submitted.value != 0;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_TAKE_SCENE:
+        if (!IsSceneSlot(id)) return DARO_SUBMIT_ERROR_INVALID;
+        command->type = DARO_CMD_TAKE_SCENE;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_TRANSITION_SCENE:
+        if (!IsSceneSlot(id)) return DARO_SUBMIT_ERROR_INVALID;
+        command->type = DARO_CMD_TRANSITION_SCENE;
+        memcpy(&command->transition, submitted.transition, sizeof(DaroTransition));
+        if (!ResolveSubmitRef(&command->transition.maskTextureId, DARO_OP_LOAD_TEXTURE, index, commands, results) ||
+            !IsValidTransition(command->transition)) return DARO_SUBMIT_ERROR_INVALID;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_PLAY:
+        command->type = DARO_CMD_PLAY_TIMELINE;
+        command->target = scene;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_STOP:
+        command->type = DARO_CMD_STOP_TIMELINE;
+        command->target = scene;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_SEEK_TO_FRAME:
+        command->type = DARO_CMD_SEEK_TIMELINE;
+        command->target = scene;
+        command->value = id;
+        return DARO_SUBMIT_OK;
+    case DARO_OP_CONTINUE_TIMELINE:
+        command->type = DARO_CMD_CONTINUE_TIMELINE;
+        command->target = scene;
+        return DARO_SUBMIT_OK;
+    default:
+        return DARO_SUBMIT_ERROR_NOT_QUEUEABLE;
+    }
+}
+
+// One command of a direct submission; g_Mutex held
+static int RunSubmitted(const std::vector<DaroSubmitCommand>& commands,
+    const std::vector<int>& results, int index, int scene)
+{
+    const DaroSubmitCommand& submitted = commands[index];
+    if (submitted.op == DARO_OP_SET_OUTPUT_METADATA)
+    {
+        SetOutputMetadata(submitted.text, submitted.text2);
+        return DARO_SUBMIT_OK;
+    }
+
+    DaroCommand command{};
+    int result = PrepareSubmitted(commands, results, index, scene, &command);
+    if (result == DARO_SUBMIT_OK) ApplyCommand(command);
+    return result;
+}
+
+DARO_API int __stdcall Daro_Submit(const void* buffer, size_t bytes, int* results, int resultCount)
+{
+    DaroCaptureCall capture(DARO_CALL_SUBMIT);
+    capture.Blob(buffer, bytes);
+    static thread_local std::vector<DaroSubmitCommand> commands;
+    static thread_local std::vector<int> status;
+
+    DaroSubmitHeader header = {};
+    int64_t frame = 0;
+    bool queued = false;
+    bool accepted = g_Initialized && DaroParseCommandBuffer(buffer, bytes, &header, &commands);
+    if (accepted)
+    {
+        queued = (header.flags & DARO_SUBMIT_QUEUED) != 0;
+        // Inside a command batch the batch's End names the frame
+        if (queued && t_CommandBatchDepth == 0) accepted = ResolveCommandFrame(header.when, header.at, &frame);
+    }
+    if (!accepted)
+    {
+        for (int i = 0; results && i < resultCount; i++) results[i] = DARO_SUBMIT_ERROR_NOT_RUN;
+        capture.Blob(nullptr, 0);
+        return -1;
+    }
+
+    int count = (int)commands.size();
+    status.resize(count);
+    for (int i = 0; i < count; i++) status[i] = commands[i].status;
+
+    // Loads first and outside every lock: they read files, and later commands may use the ids
+    for (int i = 0; i < count; i++)
+    {
+        if (status[i] != DARO_SUBMIT_OK || !IsSubmitLoad(commands[i].op)) continue;
+        int id = commands[i].op == DARO_OP_LOAD_TEXTURE ? Daro_LoadTexture(commands[i].text) : Daro_LoadVideo(commands[i].text);
+        status[i] = id >= 0 ? id : DARO_SUBMIT_ERROR_FAILED;
+    }
+
+    if (!queued)
+    {
+        // Everything else in order under one lock, so the render thread sees all of it or none
+        std::lock_guard<std::mutex> lock(g_Mutex);
+        int scene = DARO_SCENE_PROGRAM;
+        for (int i = 0; i < count; i++)
+        {
+            if (commands[i].op == DARO_OP_EDIT_SCENE) status[i] = EditSubmitted(commands[i], &scene);
+            if (status[i] != DARO_SUBMIT_OK || IsSubmitLoad(commands[i].op) || IsSubmitUnload(commands[i].op) ||
+                commands[i].op == DARO_OP_EDIT_SCENE) continue;
+            status[i] = RunSubmitted(commands, status, i, scene);
+        }
+    }
+    else
+    {
+        // One chain, one queue insertion
+        DaroCommandChain chain;
+        int scene = DARO_SCENE_PROGRAM;
+        for (int i = 0; i < count; i++)
+        {
+            if (commands[i].op == DARO_OP_EDIT_SCENE) status[i] = EditSubmitted(commands[i], &scene);
+            if (status[i] != DARO_SUBMIT_OK || IsSubmitLoad(commands[i].op) || commands[i].op == DARO_OP_EDIT_SCENE) continue;
+            DaroCommand* command = DaroCommandQueue::Allocate();
+            if (!command)
+            {
+                status[i] = DARO_SUBMIT_ERROR_FAILED;
+                continue;
+            }
+            status[i] = PrepareSubmitted(commands, status, i, scene, command);
+            if (status[i] == DARO_SUBMIT_OK) chain.Append(command);
+            else delete command;
+        }
+        if (t_CommandBatchDepth > 0) t_CommandBatch.Splice(chain);
+        else g_Commands.Push(chain, frame);
+    }
+
+    // Unloads last, once nothing earlier in the buffer can still need the asset
+    for (int i = 0; !queued && i < count; i++)
+    {
+        if (status[i] != DARO_SUBMIT_OK || !IsSubmitUnload(commands[i].op)) continue;
+        int id = commands[i].id;
+        bool texture = commands[i].op == DARO_OP_UNLOAD_TEXTURE;
+        if (!ResolveSubmitRef(&id, texture ? DARO_OP_LOAD_TEXTURE : DARO_OP_LOAD_VIDEO, i, commands, status))
+        {
+            status[i] = DARO_SUBMIT_ERROR_INVALID;
+            continue;
+        }
+        if (texture) Daro_UnloadTexture(id);
+        else Daro_UnloadVideo(id);
+    }
+
+    int succeeded = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (status[i] >= 0) succeeded++;
+        if (results && i < resultCount) results[i] = status[i];
+    }
+    capture.Blob(status.data(), status.size() * sizeof(int));
+    return succeeded;
 }
@@ -7,6 +7,7 @@
 #define DARO_API __declspec(dllimport)
 #endif
 
+#include <cstddef>
 #include "SharedTypes.h"
 
 extern "C"
@@ -27,30 +28,184 @@ extern "C"
     DARO_API bool __stdcall Daro_LockFrameBuffer(void** ppData, int* pWidth, int* pHeight, int* pStride);
     DARO_API void __stdcall Daro_UnlockFrameBuffer();
     DARO_API long long __stdcall Daro_GetFrameNumber();
+    // Block until Daro_EndFrame moves the frame number past lastFrame or the timeout
+    // expires; returns the current frame number
+    DARO_API long long __stdcall Daro_WaitForFrame(long long lastFrame, int timeoutMs);
+
+    // Native render loop - a high-priority engine thread runs BeginFrame/Render/Present/EndFrame
+    // on absolute deadlines (see RenderLoop.h); hosts wait with Daro_WaitForFrame.
+    // fps <= 0 uses the output frame rate (Daro_SetFrameRate).
+    DARO_API bool __stdcall Daro_StartRenderLoop(double fps);
+    DARO_API void __stdcall Daro_StopRenderLoop();
+    DARO_API bool __stdcall Daro_IsRenderLoopRunning();
+    DARO_API bool __stdcall Daro_GetRenderLoopStats(DaroRenderLoopStats* stats);
+    // Hold off the next loop frame, so a batch of layer updates lands in a single frame.
+    // Counted: every Lock needs one Unlock, from any thread. Stopping the loop does not
+    // wait for outstanding locks.
+    DARO_API void __stdcall Daro_LockRenderLoop();
+    DARO_API void __stdcall Daro_UnlockRenderLoop();
+    // Genlock the render loop to an external reference publishing frame ticks in named
+    // shared memory (see ExternalClock.h); null or empty free-runs again. Returns false
+    // if the reference does not exist yet - it is picked up when it appears.
+    DARO_API bool __stdcall Daro_SetExternalClock(const char* name);
+    DARO_API bool __stdcall Daro_GetGenlockStats(DaroGenlockStats* stats);
+    // Local stand-in reference for testing, offsetPpm fast (or slow) against this machine
+    DARO_API bool __stdcall Daro_StartTickGenerator(const char* name, int numerator, int denominator, double offsetPpm);
+    DARO_API void __stdcall Daro_StopTickGenerator();
     
     // Layer management
     DARO_API void __stdcall Daro_SetLayerCount(int count);
     DARO_API void __stdcall Daro_UpdateLayer(int index, const DaroLayer* layer);
     DARO_API void __stdcall Daro_GetLayer(int index, DaroLayer* layer);
     DARO_API void __stdcall Daro_ClearLayers();
+
+    // Scene slots (DARO_SCENE_SLOTS, DARO_SCENE_PROGRAM for the slot on air). The layer calls
+    // above edit the program slot. Build the next scene in another slot, then take it: the
+    // next frame renders that slot, nothing is copied. Taking the preview slot makes the old
+    // program the preview. Queue DARO_CMD_TAKE_SCENE for a frame-accurate take.
+    DARO_API bool __stdcall Daro_SetSceneLayerCount(int slot, int count);
+    DARO_API bool __stdcall Daro_UpdateSceneLayer(int slot, int index, const DaroLayer* layer);
+    DARO_API bool __stdcall Daro_GetSceneLayer(int slot, int index, DaroLayer* layer);
+    DARO_API int __stdcall Daro_GetSceneLayerCount(int slot);
+    DARO_API bool __stdcall Daro_ClearScene(int slot);
+    DARO_API bool __stdcall Daro_CopyScene(int fromSlot, int toSlot);
+    DARO_API bool __stdcall Daro_TakeScene(int slot);
+    DARO_API int __stdcall Daro_GetProgramSlot();
+    DARO_API bool __stdcall Daro_SetPreviewSlot(int slot);
+    DARO_API int __stdcall Daro_GetPreviewSlot();
+
+    // Scene transitions: take slot like Daro_TakeScene, then blend the old program into it
+    // over transition->durationFrames output frames inside the engine. Frames are counted by
+    // the engine, so a transition finishes on time even if the host stalls. A take or another
+    // transition ends a running one at once; Daro_TakeScene(DARO_SCENE_PROGRAM) finishes it.
+    // Queue it for a frame-accurate start (the first blended frame is the target frame).
+    DARO_API bool __stdcall Daro_TransitionScene(int slot, const DaroTransition* transition);
+    DARO_API long long __stdcall Daro_QueueTransition(int when, long long at, int slot, const DaroTransition* transition);
+    DARO_API bool __stdcall Daro_GetTransitionState(DaroTransitionState* state);
+
+    // Frame-accurate command queue - applied at the start of the target frame (DARO_WHEN_*,
+    // at = frame number or packed timecode), all commands due in a frame together. Never
+    // blocks on the render thread. Returns the command id, -1 if rejected, 0 inside a batch.
+    DARO_API long long __stdcall Daro_QueueLayerUpdate(int when, long long at, int index, const DaroLayer* layer);
+    DARO_API long long __stdcall Daro_QueueCommand(int when, long long at, int type, int target, long long value);
+    // Commands queued on this thread until the matching End are held and land in one frame,
+    // the one End names; returns the batch's last command id
+    DARO_API void __stdcall Daro_BeginCommandBatch();
+    DARO_API long long __stdcall Daro_EndCommandBatch(int when, long long at);
+    DARO_API bool __stdcall Daro_GetCommandQueueStats(DaroCommandQueueStats* stats);
+    // Run a binary command buffer (layout in SharedTypes.h, see CommandBuffer.h) in one call:
+    // loads first, then the rest in order under one lock, or as one queue insertion with
+    // DARO_SUBMIT_QUEUED; unloads last. results receives a DARO_SUBMIT_* code or loaded id
+    // per command. Returns how many succeeded, -1 if the buffer was rejected and nothing ran.
+    DARO_API int __stdcall Daro_Submit(const void* buffer, size_t bytes, int* results, int resultCount);
     
-    // Playback control
+    // Playback control - the program slot's timeline
     DARO_API void __stdcall Daro_Play();
     DARO_API void __stdcall Daro_Stop();
     DARO_API void __stdcall Daro_SeekToFrame(int frame);
     DARO_API void __stdcall Daro_SeekToTime(float time);
     DARO_API bool __stdcall Daro_IsPlaying();
     DARO_API int __stdcall Daro_GetCurrentFrame();
+
+    // Scene timelines (see Timeline.h): keyframe tracks on a slot's layer fields, played by the
+    // engine one frame per output frame. Stop markers hold and loop markers repeat until
+    // Daro_ContinueTimeline; the frame after a continue shows the frame after the marker, or
+    // on the last frame, playback ends there.
+    // Queue DARO_CMD_CONTINUE_TIMELINE (or the other DARO_CMD_*_TIMELINE) to act on an exact
+    // frame. Daro_ClearScene clears the slot's timeline too.
+    DARO_API bool __stdcall Daro_SetTimelineTrack(int slot, int layerIndex, int field, const DaroKeyframe* keys, int count);
+    DARO_API bool __stdcall Daro_SetTimelineMarkers(int slot, const DaroTimelineMarker* markers, int count);
+    DARO_API bool __stdcall Daro_SetTimelineLength(int slot, int frames);
+    DARO_API bool __stdcall Daro_ClearTimeline(int slot);
+    DARO_API bool __stdcall Daro_PlayTimeline(int slot);
+    DARO_API bool __stdcall Daro_StopTimeline(int slot);
+    DARO_API bool __stdcall Daro_SeekTimeline(int slot, int frame);
+    DARO_API bool __stdcall Daro_ContinueTimeline(int slot);
+    DARO_API bool __stdcall Daro_GetTimelineState(int slot, DaroTimelineState* state);
+
+    // Live data binding (see DataStore.h): values under string keys that layer fields
+    // (DARO_FIELD_*, DARO_FIELD_TEXT) bind to. Any thread; writes are batched and only mark
+    // keys changed - each frame writes every changed key into its bound fields once. Numbers
+    // bound to text are formatted, numeric text bound to a number field is parsed. A bound
+    // field keeps its value when the host replaces the layer. Key -1 unbinds a field.
+    DARO_API int __stdcall Daro_GetDataKey(const char* name);
+    DARO_API int __stdcall Daro_SetDataNumbers(const int* keys, const double* values, int count);
+    DARO_API int __stdcall Daro_SetDataTexts(const int* keys, const wchar_t* const* texts, int count);
+    DARO_API bool __stdcall Daro_BindLayerField(int slot, int layerIndex, int field, int key);
+    DARO_API bool __stdcall Daro_ClearDataBindings(int slot);
+    // Shared-memory region other processes write values into (DaroDataIngestWriter); name
+    // null for DARO_DATA_INGEST_NAME, entryCount 0 for the default
+    DARO_API bool __stdcall Daro_EnableDataIngest(const char* name, int entryCount);
+    DARO_API void __stdcall Daro_DisableDataIngest();
+    DARO_API bool __stdcall Daro_GetDataStoreStats(DaroDataStoreStats* stats);
     
     // Stats
     DARO_API double __stdcall Daro_GetFPS();
     DARO_API double __stdcall Daro_GetFrameTime();
     DARO_API int __stdcall Daro_GetDroppedFrames();
+    // Frames whose render (Daro_BeginFrame to Daro_EndFrame) exceeded one frame period
+    DARO_API int __stdcall Daro_GetLateFrames();
+    // Per-stage timing of the most recent frames, oldest first (DARO_STAGE_*). Returns records copied.
+    DARO_API int __stdcall Daro_GetFrameStats(DaroFrameStats* buffer, int count);
+    // Frame-time percentiles (DARO_TIMING_* metric and window), readable from any thread
+    DARO_API bool __stdcall Daro_GetTimingSummary(int metric, int window, DaroTimingSummary* summary);
+    DARO_API void __stdcall Daro_SetTimingWindow(int milliseconds);
+    DARO_API void __stdcall Daro_ResetTimingStats();
+
+    // Timeline tracing (DARO_TRACE_FORMAT_JSON or DARO_TRACE_FORMAT_PERFETTO); any thread
+    DARO_API void __stdcall Daro_StartTrace();
+    DARO_API void __stdcall Daro_StopTrace();
+    DARO_API bool __stdcall Daro_IsTraceEnabled();
+    DARO_API bool __stdcall Daro_WriteTrace(const char* filePath, int format);
+
+    // API capture - every exported call with its arguments, for Benchmarks/Replay (see Capture.h)
+    DARO_API bool __stdcall Daro_StartCapture(const char* filePath);
+    DARO_API void __stdcall Daro_StopCapture();
+    DARO_API bool __stdcall Daro_IsCapturing();
+
+    // Engine clock - video frames, FPS and dropped frames follow it. A virtual clock only
+    // moves on Daro_AdvanceClock*, for deterministic or faster-than-real-time rendering.
+    DARO_API void __stdcall Daro_SetVirtualClock(bool enabled);
+    DARO_API bool __stdcall Daro_IsVirtualClock();
+    DARO_API void __stdcall Daro_AdvanceClock(double milliseconds);
+    // Advance by whole frame periods of the output frame rate
+    DARO_API void __stdcall Daro_AdvanceClockFrames(int frames);
+    DARO_API double __stdcall Daro_GetClockTime();   // Milliseconds on the engine clock
+
+    // Output frame rate as an exact ratio (60000/1001 for 59.94). Daro_Initialize sets it
+    // from targetFps, snapping 23.976/29.97/59.94-style values to n*1000/1001. A running
+    // native render loop switches at its next frame, which keeps its scheduled deadline.
+    DARO_API bool __stdcall Daro_SetFrameRate(int numerator, int denominator);
+    DARO_API void __stdcall Daro_GetFrameRate(int* numerator, int* denominator);
+    // SMPTE drop-frame timecode at 29.97/59.94/119.88; on by default at those rates,
+    // reset by Daro_SetFrameRate, ignored at other rates
+    DARO_API void __stdcall Daro_SetDropFrameTimecode(bool enabled);
+    DARO_API bool __stdcall Daro_IsDropFrameTimecode();
     
     // Spout Output
     DARO_API bool __stdcall Daro_EnableSpoutOutput(const char* senderName);
     DARO_API void __stdcall Daro_DisableSpoutOutput();
     DARO_API bool __stdcall Daro_IsSpoutEnabled();
+    // Output runs on its own send thread; frames older than the timeout are dropped
+    DARO_API void __stdcall Daro_SetSpoutSendTimeout(int milliseconds);
+    DARO_API bool __stdcall Daro_GetSpoutOutputStats(DaroSpoutOutputStats* stats);
+    // Template/item on air, published with every Spout frame in the metadata ring
+    DARO_API void __stdcall Daro_SetOutputMetadata(const char* templateName, const char* itemName);
+    
+    // CPU frame transport - named shared memory sender readable without D3D
+    DARO_API bool __stdcall Daro_EnableFrameTransport(const char* senderName);
+    DARO_API void __stdcall Daro_DisableFrameTransport();
+    DARO_API bool __stdcall Daro_IsFrameTransportEnabled();
+    // Preview output - the preview slot rendered after each presented frame and published
+    // through a frame transport sender at 1/divisor size (1, 2, 4 or 8)
+    DARO_API bool __stdcall Daro_EnablePreviewOutput(const char* senderName, int divisor);
+    DARO_API void __stdcall Daro_DisablePreviewOutput();
+    DARO_API bool __stdcall Daro_IsPreviewOutputEnabled();
+    
+    // Live stats block - named shared memory polled by external monitors (null name = "DaroEngineStats")
+    DARO_API bool __stdcall Daro_EnableStatsBlock(const char* name, int intervalMs);
+    DARO_API void __stdcall Daro_DisableStatsBlock();
+    DARO_API bool __stdcall Daro_IsStatsBlockEnabled();
     
     // Texture management
     DARO_API int __stdcall Daro_LoadTexture(const char* filePath);
@@ -61,6 +216,9 @@ extern "C"
     DARO_API bool __stdcall Daro_GetSpoutSenderName(int index, char* buffer, int bufferSize);
     DARO_API int __stdcall Daro_ConnectSpoutReceiver(const char* senderName);
     DARO_API void __stdcall Daro_DisconnectSpoutReceiver(int receiverId);
+    DARO_API bool __stdcall Daro_GetSpoutReceiverStats(int receiverId, DaroSpoutReceiverStats* stats);
+    // Metadata for the frame currently held by the receiver (false if the sender has none)
+    DARO_API bool __stdcall Daro_GetSpoutReceiverMetadata(int receiverId, DaroFrameMetadata* metadata);
     
     // Debug - structure info
     DARO_API int __stdcall Daro_GetStructSize();
@@ -72,6 +230,18 @@ extern "C"
     // Debug - bounding boxes
     DARO_API void __stdcall Daro_SetShowBounds(bool show);
 
+    // Per-layer render cost of the last frame (keyed by DaroLayer::id)
+    DARO_API void __stdcall Daro_SetLayerCostEnabled(bool enabled);
+    DARO_API int __stdcall Daro_GetLayerCosts(DaroLayerCost* buffer, int maxCount);
+    DARO_API bool __stdcall Daro_GetLayerCost(int layerId, DaroLayerCost* cost);
+
+    // Memory accounting by DARO_MEM_* category (DARO_MEM_ALL for totals) and asset id
+    DARO_API bool __stdcall Daro_GetMemoryStats(int category, DaroMemoryStats* stats);
+    DARO_API int __stdcall Daro_GetMemoryAssets(int category, DaroMemoryAsset* buffer, int maxCount);
+    DARO_API void __stdcall Daro_SetMemoryBudget(int category, long long bytes);
+    DARO_API bool __stdcall Daro_IsMemoryOverBudget(int category);
+    DARO_API void __stdcall Daro_ResetMemoryPeaks();
+
     // Device status
     DARO_API bool __stdcall Daro_IsDeviceLost();
 
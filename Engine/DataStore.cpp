@@ -0,0 +1,565 @@
+// Engine/DataStore.cpp
+#include "DataStore.h"
+#include "Timeline.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static size_t AlignUp64(size_t value) { return (value + 63) & ~(size_t)63; }
+
+static int PopCount(uint64_t mask)
+{
+    int count = 0;
+    for (; mask; mask &= mask - 1) count++;
+    return count;
+}
+
+// Length of a NUL terminated wide string, at most limit
+static size_t TextLength(const wchar_t* text, size_t limit)
+{
+    size_t length = 0;
+    while (length < limit && text[length]) length++;
+    return length;
+}
+
+static bool IsValidKeyName(const char* name)
+{
+    if (!name || !name[0]) return false;
+    size_t length = 0;
+    while (length < DARO_DATA_KEY_SIZE && name[length]) length++;
+    return length < DARO_DATA_KEY_SIZE;
+}
+
+// ============== Store ==============
+
+int DaroDataStore::Key(const char* name)
+{
+    if (!IsValidKeyName(name)) return -1;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Keys.find(name);
+    if (it != m_Keys.end()) return it->second;
+    if ((int)m_Names.size() >= DARO_DATA_MAX_KEYS) return -1;
+
+    int key = (int)m_Names.size();
+    m_Keys.emplace(name, key);
+    m_Names.emplace_back(name);
+    m_Values.emplace_back();
+    m_Queued.push_back(0);
+    m_ByKey.emplace_back();
+    return key;
+}
+
+int DaroDataStore::SetNumbers(const int* keys, const double* values, int count)
+{
+    if (!keys || !values || count <= 0) return 0;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    int accepted = 0;
+    for (int i = 0; i < count; i++)
+    {
+        int key = keys[i];
+        double number = values[i];
+        if (key < 0 || key >= (int)m_Values.size() || !std::isfinite(number)) continue;
+        accepted++;
+        m_Writes++;
+
+        Value& value = m_Values[key];
+        if (value.type == DARO_DATA_NUMBER && value.number == number)
+        {
+            m_Unchanged++;
+            continue;
+        }
+        value.type = DARO_DATA_NUMBER;
+        value.number = number;
+        value.text.clear();
+        MarkChanged(key);
+    }
+    return accepted;
+}
+
+int DaroDataStore::SetTexts(const int* keys, const wchar_t* const* texts, int count)
+{
+    if (!keys || !texts || count <= 0) return 0;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    int accepted = 0;
+    for (int i = 0; i < count; i++)
+    {
+        int key = keys[i];
+        const wchar_t* text = texts[i] ? texts[i] : L"";
+        if (key < 0 || key >= (int)m_Values.size()) continue;
+        accepted++;
+        m_Writes++;
+
+        // Cut to what a layer holds, so the unchanged check compares what would be shown
+        size_t length = TextLength(text, DARO_MAX_TEXT - 1);
+        Value& value = m_Values[key];
+        if (value.type == DARO_DATA_TEXT && value.text.size() == length + 1 &&
+            std::equal(text, text + length, value.text.begin()))
+        {
+            m_Unchanged++;
+            continue;
+        }
+        value.type = DARO_DATA_TEXT;
+        value.number = 0.0;
+        value.text.assign(text, text + length);
+        value.text.push_back(L'\0');
+        MarkChanged(key);
+    }
+    return accepted;
+}
+
+void DaroDataStore::MarkChanged(int key)
+{
+    if (m_Queued[key])
+    {
+        // Still waiting for a frame: this change replaces the last one
+        m_Coalesced++;
+        return;
+    }
+    m_Queued[key] = 1;
+    m_Changed.push_back(key);
+    m_HasChanges.store(true, std::memory_order_release);
+}
+
+bool DaroDataStore::Bind(int slot, int layer, int field, int key)
+{
+    if (slot < 0 || slot >= DARO_SCENE_SLOTS || layer < 0 || layer >= DARO_MAX_LAYERS) return false;
+    if ((field < 0 || field >= DARO_FIELD_COUNT) && field != DARO_FIELD_TEXT) return false;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (key < -1 || key >= (int)m_Values.size()) return false;
+
+    auto it = std::find_if(m_Bindings.begin(), m_Bindings.end(), [&](const Binding& binding)
+        { return binding.slot == slot && binding.layer == layer && binding.field == field; });
+    if (key == -1)
+    {
+        if (it == m_Bindings.end()) return true;
+        m_Bindings.erase(it);
+    }
+    else if (it != m_Bindings.end())
+    {
+        it->key = key;
+    }
+    else
+    {
+        if ((int)m_Bindings.size() >= DARO_DATA_MAX_BINDINGS) return false;
+        m_Bindings.push_back(Binding{ slot, layer, field, key });
+    }
+    RebuildIndex();
+    if (key >= 0) MarkChanged(key);
+    return true;
+}
+
+void DaroDataStore::ClearBindings(int slot)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Bindings.erase(std::remove_if(m_Bindings.begin(), m_Bindings.end(),
+        [&](const Binding& binding) { return binding.slot == slot; }), m_Bindings.end());
+    RebuildIndex();
+}
+
+void DaroDataStore::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Keys.clear();
+    m_Names.clear();
+    m_Values.clear();
+    m_Queued.clear();
+    m_Changed.clear();
+    m_Bindings.clear();
+    m_ByKey.clear();
+    m_HasChanges.store(false, std::memory_order_relaxed);
+    m_BindingCount.store(0, std::memory_order_relaxed);
+    for (auto& touched : m_Touched) touched.store(0, std::memory_order_relaxed);
+    m_Writes = m_Unchanged = m_Coalesced = 0;
+    m_Applies = m_FieldsApplied = m_LayersDirtied = 0;
+    m_LastLayersDirtied = 0;
+    m_IngestScans.store(0, std::memory_order_relaxed);
+    m_IngestTornReads.store(0, std::memory_order_relaxed);
+}
+
+void DaroDataStore::RebuildIndex()
+{
+    for (auto& indices : m_ByKey) indices.clear();
+    for (size_t i = 0; i < m_Bindings.size(); i++)
+        m_ByKey[m_Bindings[i].key].push_back((int)i);
+    m_BindingCount.store((int)m_Bindings.size(), std::memory_order_release);
+}
+
+void DaroDataStore::TouchLayer(int slot, int layer)
+{
+    // Nothing bound anywhere - the common case costs one load
+    if (m_BindingCount.load(std::memory_order_acquire) == 0) return;
+    if (slot < 0 || slot >= DARO_SCENE_SLOTS || layer < 0 || layer >= DARO_MAX_LAYERS) return;
+    m_Touched[slot].fetch_or(1ull << layer, std::memory_order_acq_rel);
+}
+
+void DaroDataStore::TouchLayers(int slot, uint64_t layerMask)
+{
+    if (m_BindingCount.load(std::memory_order_acquire) == 0) return;
+    if (slot < 0 || slot >= DARO_SCENE_SLOTS || layerMask == 0) return;
+    m_Touched[slot].fetch_or(layerMask, std::memory_order_acq_rel);
+}
+
+int DaroDataStore::Apply(DaroLayer* const* slots)
+{
+    uint64_t touched[DARO_SCENE_SLOTS];
+    bool anyTouched = false;
+    for (int slot = 0; slot < DARO_SCENE_SLOTS; slot++)
+    {
+        touched[slot] = m_Touched[slot].exchange(0, std::memory_order_acq_rel);
+        anyTouched |= touched[slot] != 0;
+    }
+    // No write since the last frame and no layer replaced: no lock taken
+    if (!anyTouched && !m_HasChanges.load(std::memory_order_acquire)) return 0;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_HasChanges.store(false, std::memory_order_relaxed);
+    m_Applying.clear();
+    m_Applying.swap(m_Changed);
+
+    uint64_t changed[DARO_SCENE_SLOTS] = {};
+    int fields = 0;
+    for (int key : m_Applying)
+    {
+        m_Queued[key] = 0;
+        for (int index : m_ByKey[key])
+        {
+            const Binding& binding = m_Bindings[index];
+            // Written below anyway
+            if (touched[binding.slot] & (1ull << binding.layer)) continue;
+            if (ApplyBinding(binding, slots, changed)) fields++;
+        }
+    }
+    if (anyTouched)
+    {
+        for (const Binding& binding : m_Bindings)
+        {
+            if (!(touched[binding.slot] & (1ull << binding.layer))) continue;
+            if (ApplyBinding(binding, slots, changed)) fields++;
+        }
+    }
+
+    int layers = 0;
+    for (uint64_t mask : changed) layers += PopCount(mask);
+    if (fields > 0)
+    {
+        m_Applies++;
+        m_FieldsApplied += fields;
+        m_LayersDirtied += layers;
+        m_LastLayersDirtied = layers;
+    }
+    return layers;
+}
+
+bool DaroDataStore::ApplyBinding(const Binding& binding, DaroLayer* const* slots, uint64_t* changed)
+{
+    const Value& value = m_Values[binding.key];
+    if (value.type == DARO_DATA_NONE || !slots[binding.slot]) return false;
+    DaroLayer* layer = &slots[binding.slot][binding.layer];
+
+    if (binding.field == DARO_FIELD_TEXT)
+    {
+        wchar_t text[DARO_MAX_TEXT];
+        size_t length;
+        if (value.type == DARO_DATA_TEXT)
+        {
+            length = value.text.size() - 1;
+            std::copy(value.text.begin(), value.text.end(), text);
+        }
+        else
+        {
+            char number[32];
+            snprintf(number, sizeof(number), "%.15g", value.number);
+            for (length = 0; number[length]; length++) text[length] = (wchar_t)number[length];
+            text[length] = L'\0';
+        }
+        if (std::equal(text, text + length + 1, layer->textContent)) return true;
+        std::copy(text, text + length + 1, layer->textContent);
+    }
+    else
+    {
+        double number = value.number;
+        if (value.type == DARO_DATA_TEXT)
+        {
+            // Numeric text ("12.5") drives a number field; anything else is skipped
+            char narrow[64];
+            size_t length = std::min(value.text.size() - 1, sizeof(narrow) - 1);
+            for (size_t i = 0; i < length; i++)
+                narrow[i] = value.text[i] < 0x80 ? (char)value.text[i] : '?';
+            narrow[length] = '\0';
+            char* end = nullptr;
+            number = strtod(narrow, &end);
+            if (end == narrow || *end != '\0' || !std::isfinite(number)) return false;
+        }
+        DaroLayer before = *layer;
+        DaroSetLayerField(layer, binding.field, (float)number);
+        if (memcmp(&before, layer, sizeof(DaroLayer)) == 0) return true;
+    }
+    changed[binding.slot] |= 1ull << binding.layer;
+    return true;
+}
+
+void DaroDataStore::GetStats(DaroDataStoreStats* stats) const
+{
+    memset(stats, 0, sizeof(*stats));
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    stats->writes = m_Writes;
+    stats->unchanged = m_Unchanged;
+    stats->coalesced = m_Coalesced;
+    stats->applies = m_Applies;
+    stats->fieldsApplied = m_FieldsApplied;
+    stats->layersDirtied = m_LayersDirtied;
+    stats->ingestScans = m_IngestScans.load(std::memory_order_relaxed);
+    stats->ingestTornReads = m_IngestTornReads.load(std::memory_order_relaxed);
+    stats->keyCount = (int)m_Names.size();
+    stats->bindingCount = (int)m_Bindings.size();
+    stats->ingestEntries = m_IngestEntries.load(std::memory_order_relaxed);
+    stats->lastLayersDirtied = m_LastLayersDirtied;
+}
+
+void DaroDataStore::AddIngestScan(bool torn)
+{
+    m_IngestScans.fetch_add(1, std::memory_order_relaxed);
+    if (torn) m_IngestTornReads.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<std::string> DaroDataStore::KeyNames() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Names;
+}
+
+std::vector<DaroDataStore::Binding> DaroDataStore::Bindings() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Bindings;
+}
+
+int DaroDataStore::GetValue(int key, double* number, std::vector<wchar_t>* text) const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (key < 0 || key >= (int)m_Values.size()) return DARO_DATA_NONE;
+    const Value& value = m_Values[key];
+    if (value.type == DARO_DATA_NUMBER && number) *number = value.number;
+    if (value.type == DARO_DATA_TEXT && text) *text = value.text;
+    return value.type;
+}
+
+// ============== Ingest (engine) ==============
+
+bool DaroDataIngest::Start(const char* name, int entryCount)
+{
+    Stop();
+    if (!name || !name[0]) return false;
+    if (entryCount <= 0) entryCount = DARO_DATA_INGEST_DEFAULT_ENTRIES;
+    if (entryCount > DARO_DATA_MAX_KEYS) entryCount = DARO_DATA_MAX_KEYS;
+
+    size_t headerSize = AlignUp64(sizeof(DaroDataIngestHeader));
+    m_Memory.SetUnlinkOnClose(true);
+    DaroShmResult result = m_Memory.Create(name, headerSize + (size_t)entryCount * sizeof(DaroDataIngestEntry));
+    if (result == DARO_SHM_FAILED) return false;
+
+    // Fresh segment, or one left by a previous engine: reset it. Producers wait for the magic.
+    auto* header = static_cast<DaroDataIngestHeader*>(m_Memory.Data());
+    header->magic.store(0, std::memory_order_relaxed);
+    header->version = DARO_DATA_INGEST_VERSION;
+    header->headerSize = (uint32_t)headerSize;
+    header->entrySize = (uint32_t)sizeof(DaroDataIngestEntry);
+    header->entryCount = (uint32_t)entryCount;
+    header->reserved = 0;
+    header->changeCount.store(0, std::memory_order_relaxed);
+    m_Entries = reinterpret_cast<DaroDataIngestEntry*>(static_cast<uint8_t*>(m_Memory.Data()) + headerSize);
+    memset(static_cast<void*>(m_Entries), 0, (size_t)entryCount * sizeof(DaroDataIngestEntry));
+    header->magic.store(DARO_DATA_INGEST_MAGIC, std::memory_order_release);
+
+    m_Header = header;
+    m_LastChangeCount = 0;
+    m_Retry = false;
+    m_Seen.assign(entryCount, 0);
+    m_KeyNames.assign(entryCount, std::string());
+    m_KeyIds.assign(entryCount, -1);
+    m_TextBuffer.reserve((size_t)entryCount * DARO_DATA_INGEST_TEXT);
+    return true;
+}
+
+void DaroDataIngest::Stop()
+{
+    if (m_Header)
+    {
+        // Producers see the magic vanish and reconnect
+        m_Header->magic.store(0, std::memory_order_release);
+        m_Header = nullptr;
+    }
+    m_Memory.Close();
+    m_Entries = nullptr;
+    m_Seen.clear();
+    m_KeyNames.clear();
+    m_KeyIds.clear();
+}
+
+void DaroDataIngest::Poll(DaroDataStore* store)
+{
+    if (!m_Header) return;
+    uint64_t changeCount = m_Header->changeCount.load(std::memory_order_acquire);
+    if (changeCount == m_LastChangeCount && !m_Retry) return;
+    m_LastChangeCount = changeCount;
+
+    m_NumberKeys.clear();
+    m_Numbers.clear();
+    m_TextKeys.clear();
+    m_TextBuffer.clear();
+    m_Texts.clear();
+
+    bool torn = false;
+    int count = (int)m_Header->entryCount;
+    for (int i = 0; i < count; i++)
+    {
+        DaroDataIngestEntry& entry = m_Entries[i];
+        uint32_t seq = entry.sequence.load(std::memory_order_acquire);
+        if (seq == m_Seen[i]) continue;
+        if (seq & 1)
+        {
+            torn = true;
+            continue;
+        }
+
+        // Copy out, then check the producer did not write meanwhile
+        int32_t type = entry.type;
+        double number = entry.number;
+        char key[DARO_DATA_KEY_SIZE];
+        uint16_t text[DARO_DATA_INGEST_TEXT];
+        memcpy(key, entry.key, sizeof(key));
+        if (type == DARO_DATA_TEXT) memcpy(text, entry.text, sizeof(text));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.sequence.load(std::memory_order_relaxed) != seq)
+        {
+            torn = true;
+            continue;
+        }
+        m_Seen[i] = seq;
+
+        key[DARO_DATA_KEY_SIZE - 1] = '\0';
+        if (m_KeyIds[i] < 0 || m_KeyNames[i] != key)
+        {
+            m_KeyNames[i] = key;
+            m_KeyIds[i] = store->Key(key);
+        }
+        int id = m_KeyIds[i];
+        if (id < 0) continue;
+
+        if (type == DARO_DATA_NUMBER)
+        {
+            m_NumberKeys.push_back(id);
+            m_Numbers.push_back(number);
+        }
+        else if (type == DARO_DATA_TEXT)
+        {
+            // UTF-16 to wchar_t unit by unit; the pointers are taken once the buffer is full
+            text[DARO_DATA_INGEST_TEXT - 1] = 0;
+            m_TextKeys.push_back(id);
+            for (int c = 0; text[c]; c++) m_TextBuffer.push_back((wchar_t)text[c]);
+            m_TextBuffer.push_back(L'\0');
+        }
+    }
+    m_Retry = torn;
+
+    if (!m_TextKeys.empty())
+    {
+        const wchar_t* text = m_TextBuffer.data();
+        for (size_t i = 0; i < m_TextKeys.size(); i++)
+        {
+            m_Texts.push_back(text);
+            while (*text) text++;
+            text++;
+        }
+        store->SetTexts(m_TextKeys.data(), m_Texts.data(), (int)m_TextKeys.size());
+    }
+    if (!m_NumberKeys.empty())
+        store->SetNumbers(m_NumberKeys.data(), m_Numbers.data(), (int)m_NumberKeys.size());
+    store->AddIngestScan(torn);
+}
+
+// ============== Ingest (producer) ==============
+
+bool DaroDataIngestWriter::Open(const char* name)
+{
+    Close();
+    if (!name || !name[0] || !m_Memory.Open(name)) return false;
+
+    auto* header = static_cast<DaroDataIngestHeader*>(m_Memory.Data());
+    if (m_Memory.Size() < sizeof(DaroDataIngestHeader) ||
+        header->magic.load(std::memory_order_acquire) != DARO_DATA_INGEST_MAGIC ||
+        header->version != DARO_DATA_INGEST_VERSION ||
+        header->entrySize != sizeof(DaroDataIngestEntry) ||
+        header->headerSize + (size_t)header->entryCount * header->entrySize > m_Memory.Size())
+    {
+        m_Memory.Close();
+        return false;
+    }
+    m_Header = header;
+    m_Entries = reinterpret_cast<DaroDataIngestEntry*>(static_cast<uint8_t*>(m_Memory.Data()) + header->headerSize);
+    return true;
+}
+
+void DaroDataIngestWriter::Close()
+{
+    m_Memory.Close();
+    m_Header = nullptr;
+    m_Entries = nullptr;
+}
+
+bool DaroDataIngestWriter::SetNumber(int entry, const char* key, double value)
+{
+    if (!std::isfinite(value)) return false;
+    DaroDataIngestEntry* target = Begin(entry, key);
+    if (!target) return false;
+    target->type = DARO_DATA_NUMBER;
+    target->number = value;
+    End(target);
+    return true;
+}
+
+bool DaroDataIngestWriter::SetText(int entry, const char* key, const uint16_t* text)
+{
+    DaroDataIngestEntry* target = Begin(entry, key);
+    if (!target) return false;
+    target->type = DARO_DATA_TEXT;
+    target->number = 0.0;
+    int length = 0;
+    if (text)
+    {
+        for (; length < DARO_DATA_INGEST_TEXT - 1 && text[length]; length++) target->text[length] = text[length];
+    }
+    target->text[length] = 0;
+    End(target);
+    return true;
+}
+
+DaroDataIngestEntry* DaroDataIngestWriter::Begin(int entry, const char* key)
+{
+    if (!m_Header || entry < 0 || entry >= (int)m_Header->entryCount || !IsValidKeyName(key)) return nullptr;
+    // The engine closed or restarted the region
+    if (m_Header->magic.load(std::memory_order_acquire) != DARO_DATA_INGEST_MAGIC) return nullptr;
+
+    DaroDataIngestEntry* target = &m_Entries[entry];
+    uint32_t seq = target->sequence.load(std::memory_order_relaxed);
+    if (seq & 1) seq++;     // Left odd by a producer that died mid-write
+    target->sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    strncpy(target->key, key, DARO_DATA_KEY_SIZE - 1);
+    target->key[DARO_DATA_KEY_SIZE - 1] = '\0';
+    return target;
+}
+
+void DaroDataIngestWriter::End(DaroDataIngestEntry* entry)
+{
+    uint32_t seq = entry->sequence.load(std::memory_order_relaxed);
+    // Skip 0 on wrap: it means never written
+    entry->sequence.store(seq + 1 == 0 ? 2 : seq + 1, std::memory_order_release);
+    m_Header->changeCount.fetch_add(1, std::memory_order_release);
+}
@@ -0,0 +1,198 @@
+// Engine/DataStore.h
+// Data binding store for live feeds (Daro_*Data*). Values live under string keys, resolved
+// once to integer ids; layer fields bind to a key. A write stores the value and queues the
+// key if it changed - it never touches a layer. Once per frame, with the layers locked,
+// Apply writes each queued key into its bound fields, so a key updated fifty times between
+// two frames costs one field write. Fields of a layer the host replaced wholesale
+// (Daro_UpdateLayer and friends) are written again in the next apply, since the host's copy
+// of a bound field is stale.
+//
+// Producers in other processes can skip the API and write into a shared-memory ingest
+// region instead (DaroDataIngest): one seqlocked entry per value, and a change counter the
+// engine checks each frame before it scans anything.
+//
+// Like StatsBlock.h, this file and DataStore.cpp/SharedMemory.cpp have no Windows or D3D
+// dependencies; DaroDataIngestWriter can be compiled directly into feed processes.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SharedMemory.h"
+#include "SharedTypes.h"
+
+class DaroDataStore
+{
+public:
+    struct Binding
+    {
+        int slot;                   // Scene slot index
+        int layer;
+        int field;                  // DARO_FIELD_*, DARO_FIELD_TEXT
+        int key;
+    };
+
+    // Any thread. Id of a key, created on first use; -1 for an empty or too long name, or
+    // when the store is full.
+    int Key(const char* name);
+
+    // Any thread. Returns how many values were accepted (valid key, finite number).
+    int SetNumbers(const int* keys, const double* values, int count);
+    int SetTexts(const int* keys, const wchar_t* const* texts, int count);
+
+    // Any thread. Bind a layer field to key, replacing the field's binding; key -1 unbinds.
+    // The key's value is written in the next apply.
+    bool Bind(int slot, int layer, int field, int key);
+    void ClearBindings(int slot);
+    // No keys, values or bindings
+    void Clear();
+
+    // Any thread, lock-free: the layer was replaced, write its bound fields again
+    void TouchLayer(int slot, int layer);
+    void TouchLayers(int slot, uint64_t layerMask);
+    void TouchSlot(int slot) { TouchLayers(slot, ~0ull); }
+
+    // Render thread, layers locked: write changed keys and touched layers' bindings into
+    // slots[DARO_SCENE_SLOTS]. Returns how many layers changed.
+    int Apply(DaroLayer* const* slots);
+
+    void GetStats(DaroDataStoreStats* stats) const;
+    void SetIngestEntries(int entries) { m_IngestEntries.store(entries, std::memory_order_relaxed); }
+    void AddIngestScan(bool torn);
+
+    // Copies for the capture preamble
+    std::vector<std::string> KeyNames() const;
+    std::vector<Binding> Bindings() const;
+    // Type (DARO_DATA_*) of a key's value; number or text (NUL terminated) filled to match
+    int GetValue(int key, double* number, std::vector<wchar_t>* text) const;
+
+private:
+    struct Value
+    {
+        int type = DARO_DATA_NONE;
+        double number = 0.0;
+        std::vector<wchar_t> text;  // NUL terminated
+    };
+
+    // m_Mutex held. ApplyBinding is false if the key has no usable value.
+    void MarkChanged(int key);
+    bool ApplyBinding(const Binding& binding, DaroLayer* const* slots, uint64_t* changed);
+    void RebuildIndex();
+
+    mutable std::mutex m_Mutex;
+    std::unordered_map<std::string, int> m_Keys;
+    std::vector<std::string> m_Names;
+    std::vector<Value> m_Values;
+    std::vector<uint8_t> m_Queued;          // By key: in m_Changed
+    std::vector<int> m_Changed;             // Keys changed since the last apply
+    std::vector<int> m_Applying;            // Swapped with m_Changed by Apply
+    std::vector<Binding> m_Bindings;
+    std::vector<std::vector<int>> m_ByKey;  // Binding indices by key
+    std::atomic<bool> m_HasChanges{ false };
+    std::atomic<int> m_BindingCount{ 0 };
+    std::atomic<uint64_t> m_Touched[DARO_SCENE_SLOTS] = {};
+
+    long long m_Writes = 0;
+    long long m_Unchanged = 0;
+    long long m_Coalesced = 0;
+    long long m_Applies = 0;
+    long long m_FieldsApplied = 0;
+    long long m_LayersDirtied = 0;
+    int m_LastLayersDirtied = 0;
+    std::atomic<long long> m_IngestScans{ 0 };
+    std::atomic<long long> m_IngestTornReads{ 0 };
+    std::atomic<int> m_IngestEntries{ 0 };
+};
+
+// ---- Ingest region layout ----
+
+#define DARO_DATA_INGEST_NAME "DaroEngineData"
+#define DARO_DATA_INGEST_MAGIC 0x41544444u      // "DDTA"
+#define DARO_DATA_INGEST_VERSION 1
+#define DARO_DATA_INGEST_TEXT 256               // UTF-16 code units per entry, including the NUL
+#define DARO_DATA_INGEST_DEFAULT_ENTRIES 1024
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Data ingest requires lock-free 32-bit atomics");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Data ingest requires lock-free 64-bit atomics");
+
+struct alignas(64) DaroDataIngestHeader
+{
+    std::atomic<uint32_t> magic;            // Written last by the engine
+    uint32_t version;
+    uint32_t headerSize;                    // Offset of entry 0 from the start of the segment
+    uint32_t entrySize;
+    uint32_t entryCount;
+    uint32_t reserved;
+    std::atomic<uint64_t> changeCount;      // Bumped after every entry write; no scan while unchanged
+};
+
+// One value. An entry has one producer; its key may change between writes.
+struct alignas(64) DaroDataIngestEntry
+{
+    std::atomic<uint32_t> sequence;         // Seqlock: odd while written, 0 = never written
+    int32_t type;                           // DARO_DATA_NUMBER or DARO_DATA_TEXT
+    double number;
+    char key[DARO_DATA_KEY_SIZE];           // NUL terminated
+    uint16_t text[DARO_DATA_INGEST_TEXT];   // UTF-16, NUL terminated
+};
+
+// Engine side: owns the segment and feeds the store from it
+class DaroDataIngest
+{
+public:
+    DaroDataIngest() {}
+    ~DaroDataIngest() { Stop(); }
+
+    DaroDataIngest(const DaroDataIngest&) = delete;
+    DaroDataIngest& operator=(const DaroDataIngest&) = delete;
+
+    bool Start(const char* name, int entryCount);
+    void Stop();
+    bool IsRunning() const { return m_Header != nullptr; }
+    int GetEntryCount() const { return m_Header ? (int)m_Header->entryCount : 0; }
+
+    // Render thread, once per frame before DaroDataStore::Apply. Copies entries written
+    // since the last poll into store.
+    void Poll(DaroDataStore* store);
+
+private:
+    DaroSharedMemory m_Memory;
+    DaroDataIngestHeader* m_Header = nullptr;
+    DaroDataIngestEntry* m_Entries = nullptr;
+    uint64_t m_LastChangeCount = 0;
+    bool m_Retry = false;                   // An entry was mid-write: scan again next frame
+    std::vector<uint32_t> m_Seen;           // Sequence last read, by entry
+    std::vector<std::string> m_KeyNames;    // Key last resolved, by entry
+    std::vector<int> m_KeyIds;
+
+    // Scratch, so a poll does not allocate
+    std::vector<int> m_NumberKeys;
+    std::vector<double> m_Numbers;
+    std::vector<int> m_TextKeys;
+    std::vector<wchar_t> m_TextBuffer;
+    std::vector<const wchar_t*> m_Texts;
+};
+
+// Producer side, for feed processes
+class DaroDataIngestWriter
+{
+public:
+    bool Open(const char* name);
+    void Close();
+    bool IsOpen() const { return m_Header != nullptr; }
+    int GetEntryCount() const { return m_Header ? (int)m_Header->entryCount : 0; }
+
+    bool SetNumber(int entry, const char* key, double value);
+    bool SetText(int entry, const char* key, const uint16_t* text);     // UTF-16, NUL terminated
+
+private:
+    DaroDataIngestEntry* Begin(int entry, const char* key);
+    void End(DaroDataIngestEntry* entry);
+
+    DaroSharedMemory m_Memory;
+    DaroDataIngestHeader* m_Header = nullptr;
+    DaroDataIngestEntry* m_Entries = nullptr;
+};
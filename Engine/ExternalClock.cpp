@@ -0,0 +1,152 @@
+// Engine/ExternalClock.cpp
+#include "ExternalClock.h"
+#include <chrono>
+
+// Maximum seqlock retries before a read gives up for this call
+static const int MAX_READ_RETRIES = 8;
+
+static int64_t NowNs()
+{
+    return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ============== Reader ==============
+
+bool DaroTickReader::Open(const char* name)
+{
+    Close();
+    if (!name || !name[0]) return false;
+    if (!m_Memory.Open(name)) return false;
+
+    auto* block = static_cast<const DaroTickBlock*>(m_Memory.Data());
+    if (m_Memory.Size() < sizeof(DaroTickBlock) ||
+        block->magic.load(std::memory_order_acquire) != DARO_TICK_MAGIC ||
+        block->version != DARO_TICK_VERSION)
+    {
+        m_Memory.Close();
+        return false;
+    }
+    m_Block = block;
+    return true;
+}
+
+void DaroTickReader::Close()
+{
+    m_Memory.Close();
+    m_Block = nullptr;
+}
+
+bool DaroTickReader::IsLive() const
+{
+    return m_Block && m_Block->magic.load(std::memory_order_acquire) == DARO_TICK_MAGIC;
+}
+
+bool DaroTickReader::Read(uint64_t* count, int64_t* tickNs) const
+{
+    if (!m_Block || !count || !tickNs) return false;
+    if (m_Block->magic.load(std::memory_order_acquire) != DARO_TICK_MAGIC) return false;
+
+    for (int attempt = 0; attempt < MAX_READ_RETRIES; attempt++)
+    {
+        uint32_t seqBefore = m_Block->sequence.load(std::memory_order_acquire);
+        if (seqBefore & 1)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        uint64_t c = m_Block->tickCount.load(std::memory_order_relaxed);
+        int64_t ns = m_Block->tickNs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_Block->sequence.load(std::memory_order_relaxed) != seqBefore) continue;
+        if (c == 0) return false;   // No tick yet
+        *count = c;
+        *tickNs = ns;
+        return true;
+    }
+    return false;
+}
+
+// ============== Stand-in generator ==============
+
+bool DaroTickGenerator::Start(const char* name, DaroRational rate, double offsetPpm)
+{
+    Stop();
+    if (!name || !name[0] || !DaroRationalIsValid(rate)) return false;
+    if (!(offsetPpm > -1000.0 && offsetPpm < 1000.0)) return false;
+
+    m_Memory.SetUnlinkOnClose(true);
+    DaroShmResult result = m_Memory.Create(name, sizeof(DaroTickBlock));
+    if (result == DARO_SHM_FAILED) return false;
+
+    auto* block = static_cast<DaroTickBlock*>(m_Memory.Data());
+    if (result == DARO_SHM_OPENED &&
+        block->magic.load(std::memory_order_acquire) == DARO_TICK_MAGIC &&
+        NowNs() - block->tickNs.load(std::memory_order_relaxed) < DARO_TICK_STALE_NS)
+    {
+        // Another reference is ticking under this name - do not write over it
+        m_Memory.Close();
+        return false;
+    }
+
+    block->magic.store(0, std::memory_order_relaxed);
+    block->version = DARO_TICK_VERSION;
+    block->rateNum = rate.num;
+    block->rateDen = rate.den;
+    block->sequence.store(0, std::memory_order_relaxed);
+    block->tickCount.store(0, std::memory_order_relaxed);
+    block->tickNs.store(0, std::memory_order_relaxed);
+    block->magic.store(DARO_TICK_MAGIC, std::memory_order_release);
+
+    m_Block = block;
+    m_Rate = rate;
+    // A reference running fast by offsetPpm has proportionally shorter periods
+    m_Scale = 1.0 / (1.0 + offsetPpm * 1e-6);
+    m_StopRequested = false;
+    m_Thread = std::thread(&DaroTickGenerator::ThreadProc, this);
+    return true;
+}
+
+void DaroTickGenerator::Stop()
+{
+    if (m_Thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_StopRequested = true;
+        }
+        m_Wake.notify_one();
+        m_Thread.join();
+    }
+    if (m_Block)
+    {
+        // Readers see the magic vanish and report the reference lost
+        m_Block->magic.store(0, std::memory_order_release);
+        m_Block = nullptr;
+    }
+    m_Memory.Close();
+}
+
+void DaroTickGenerator::ThreadProc()
+{
+    const int64_t originNs = NowNs();
+    uint64_t tick = 0;
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (!m_StopRequested)
+    {
+        // Absolute tick times, so wake-up latency never accumulates into the grid
+        int64_t tickNs = originNs + (int64_t)((double)DaroFrameToNs((int64_t)tick, m_Rate) * m_Scale);
+        auto due = std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(tickNs)));
+        if (m_Wake.wait_until(lock, due, [this] { return m_StopRequested; })) break;
+
+        tick++;
+        uint32_t seq = m_Block->sequence.load(std::memory_order_relaxed);
+        m_Block->sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_Block->tickCount.store(tick, std::memory_order_relaxed);
+        m_Block->tickNs.store(tickNs, std::memory_order_relaxed);
+        m_Block->sequence.store(seq + 2, std::memory_order_release);
+    }
+}
@@ -0,0 +1,103 @@
+// Engine/ExternalClock.h
+// External frame reference for genlocking the native render loop (Daro_SetExternalClock).
+// A reference writes frame ticks into a small named shared-memory block: a counter and
+// the steady-clock time of the latest tick. The render loop reads the block once per
+// frame, measures the phase of its own deadline against the nearest tick and steers its
+// deadline grid toward it (RenderLoop.cpp), instead of following its own timer alone.
+//
+// Anything that can see house reference (a reference card driver, an LTC or PTP daemon,
+// a bridge from a socket or timer descriptor) feeds the engine by writing this block
+// from its own process. DaroTickGenerator is a local stand-in reference for testing,
+// with an adjustable frequency offset to exercise drift correction.
+//
+// Like StatsBlock.h, this file and ExternalClock.cpp have no Windows or D3D dependencies
+// and can be compiled directly into external tools.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "SharedMemory.h"
+#include "TimeBase.h"
+
+#define DARO_TICK_BLOCK_NAME "DaroHouseReference"
+#define DARO_TICK_MAGIC 0x4B434954u         // "TICK"
+#define DARO_TICK_VERSION 1
+#define DARO_TICK_STALE_NS 1000000000ll    // A writer whose last tick is older than this is gone
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Tick block requires lock-free 64-bit atomics");
+
+// ---- Shared memory layout ----
+// Writers publish a tick by bumping sequence to odd, storing tickCount and tickNs, then
+// bumping sequence to even. tickNs is on the steady clock (DaroTransportNowNs); a writer
+// that learns of ticks late should stamp the time the tick happened, not when it noticed.
+struct alignas(64) DaroTickBlock
+{
+    std::atomic<uint32_t> magic;            // Written last by the writer
+    uint32_t version;
+    int64_t rateNum;                        // Nominal reference rate, 0 if unknown
+    int64_t rateDen;
+    std::atomic<uint32_t> sequence;         // Seqlock: odd while a tick is being written
+    uint32_t reserved;
+    std::atomic<uint64_t> tickCount;        // Ticks since the writer started
+    std::atomic<int64_t> tickNs;            // Steady clock of tick number tickCount
+};
+
+class DaroTickReader
+{
+public:
+    DaroTickReader() = default;
+    ~DaroTickReader() { Close(); }
+
+    DaroTickReader(const DaroTickReader&) = delete;
+    DaroTickReader& operator=(const DaroTickReader&) = delete;
+
+    bool Open(const char* name);
+    void Close();
+    bool IsOpen() const { return m_Block != nullptr; }
+
+    // Latest tick. False if the writer is gone, has not ticked yet or was writing on
+    // every retry.
+    bool Read(uint64_t* count, int64_t* tickNs) const;
+    // False once the writer stopped (it clears the magic); a new one may use a new block
+    bool IsLive() const;
+
+private:
+    DaroSharedMemory m_Memory;
+    const DaroTickBlock* m_Block = nullptr;
+};
+
+// Stand-in reference: ticks at an exact rational rate, optionally off by a fixed
+// number of parts per million like a real reference drifting against the local clock.
+// Tick times are the ideal grid, as if stamped by reference hardware; the thread only
+// needs to publish each one well within a frame.
+class DaroTickGenerator
+{
+public:
+    DaroTickGenerator() = default;
+    ~DaroTickGenerator() { Stop(); }
+
+    DaroTickGenerator(const DaroTickGenerator&) = delete;
+    DaroTickGenerator& operator=(const DaroTickGenerator&) = delete;
+
+    // Fails if the rate is not valid or a live writer already ticks under the name
+    bool Start(const char* name, DaroRational rate, double offsetPpm);
+    void Stop();
+    bool IsRunning() const { return m_Block != nullptr; }
+
+private:
+    void ThreadProc();
+
+    DaroSharedMemory m_Memory;
+    DaroTickBlock* m_Block = nullptr;
+    DaroRational m_Rate = { 0, 1 };
+    double m_Scale = 1.0;                   // Tick times relative to the nominal grid
+
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_Wake;
+    bool m_StopRequested = false;
+};
@@ -3,7 +3,12 @@
 // When HAS_FFMPEG=1 (headers found), provides full FFmpeg decoding.
 // When HAS_FFMPEG=0 (no headers), provides stubs that always fail gracefully.
 #include "FFmpegDecoder.h"
-#include "VideoPlayer.h"  // For VideoLog
+#include "Trace.h"
+#include <cstdio>
+
+// Defined in VideoPlayer.cpp. Declared here rather than including VideoPlayer.h so the
+// decoder builds without D3D/Media Foundation headers (Benchmarks/MicroBench).
+void VideoLog(const char* msg);
 
 #if HAS_FFMPEG
 
@@ -18,10 +23,12 @@ extern "C" {
 }
 
 // Link FFmpeg import libraries
+#ifdef _MSC_VER
 #pragma comment(lib, "avformat.lib")
 #pragma comment(lib, "avcodec.lib")
 #pragma comment(lib, "avutil.lib")
 #pragma comment(lib, "swscale.lib")
+#endif
 
 FFmpegDecoder::FFmpegDecoder() {}
 
@@ -48,7 +55,7 @@ bool FFmpegDecoder::Open(const char* filePath)
     {
         char errbuf[128];
         av_strerror(ret, errbuf, sizeof(errbuf));
-        sprintf_s(dbg, "[DaroVideo] FFmpeg: avformat_open_input failed: %s\n", errbuf);
+        snprintf(dbg, sizeof(dbg), "[DaroVideo] FFmpeg: avformat_open_input failed: %s\n", errbuf);
         VideoLog(dbg);
         return false;
     }
@@ -80,20 +87,21 @@ bool FFmpegDecoder::Open(const char* filePath)
 
     if (m_Width <= 0 || m_Height <= 0 || m_Width > 8192 || m_Height > 8192)
     {
-        sprintf_s(dbg, "[DaroVideo] FFmpeg: Invalid dimensions %dx%d\n", m_Width, m_Height);
+        snprintf(dbg, sizeof(dbg), "[DaroVideo] FFmpeg: Invalid dimensions %dx%d\n", m_Width, m_Height);
         VideoLog(dbg);
         Close();
         return false;
     }
 
-    // Frame rate
+    // Frame rate, kept as the exact ratio (30000/1001, not 29.97)
     AVRational fr = stream->r_frame_rate;
     if (fr.num > 0 && fr.den > 0)
-        m_FrameRate = (double)fr.num / (double)fr.den;
+        m_Rate = DaroMakeRational(fr.num, fr.den);
     else if (stream->avg_frame_rate.num > 0 && stream->avg_frame_rate.den > 0)
-        m_FrameRate = (double)stream->avg_frame_rate.num / (double)stream->avg_frame_rate.den;
-    else
-        m_FrameRate = 25.0;
+        m_Rate = DaroMakeRational(stream->avg_frame_rate.num, stream->avg_frame_rate.den);
+    if (!DaroRationalIsValid(m_Rate))
+        m_Rate = DaroRational{ 25, 1 };
+    m_FrameRate = DaroRationalToDouble(m_Rate);
 
     // Duration
     if (m_FmtCtx->duration > 0)
@@ -107,9 +115,9 @@ bool FFmpegDecoder::Open(const char* filePath)
     else if (m_Duration > 0 && m_FrameRate > 0)
         m_TotalFrames = (int)(m_Duration * m_FrameRate);
 
-    sprintf_s(dbg, "[DaroVideo] FFmpeg: %dx%d @ %.2f fps, %.2f sec, %d frames, codec=%s\n",
-              m_Width, m_Height, m_FrameRate, m_Duration, m_TotalFrames,
-              codec ? codec->name : "unknown");
+    snprintf(dbg, sizeof(dbg), "[DaroVideo] FFmpeg: %dx%d @ %.2f fps, %.2f sec, %d frames, codec=%s\n",
+             m_Width, m_Height, m_FrameRate, m_Duration, m_TotalFrames,
+             codec ? codec->name : "unknown");
     VideoLog(dbg);
 
     // Open codec context
@@ -134,7 +142,7 @@ bool FFmpegDecoder::Open(const char* filePath)
     {
         char errbuf[128];
         av_strerror(ret, errbuf, sizeof(errbuf));
-        sprintf_s(dbg, "[DaroVideo] FFmpeg: avcodec_open2 failed: %s\n", errbuf);
+        snprintf(dbg, sizeof(dbg), "[DaroVideo] FFmpeg: avcodec_open2 failed: %s\n", errbuf);
         VideoLog(dbg);
         Close();
         return false;
@@ -144,10 +152,10 @@ bool FFmpegDecoder::Open(const char* filePath)
     {
         const AVPixFmtDescriptor* fmtDesc = av_pix_fmt_desc_get(m_CodecCtx->pix_fmt);
         m_HasAlpha = fmtDesc && (fmtDesc->flags & AV_PIX_FMT_FLAG_ALPHA);
-        sprintf_s(dbg, "[DaroVideo] FFmpeg: pix_fmt=%d (%s), hasAlpha=%d\n",
-                  (int)m_CodecCtx->pix_fmt,
-                  fmtDesc ? fmtDesc->name : "unknown",
-                  m_HasAlpha);
+        snprintf(dbg, sizeof(dbg), "[DaroVideo] FFmpeg: pix_fmt=%d (%s), hasAlpha=%d\n",
+                 (int)m_CodecCtx->pix_fmt,
+                 fmtDesc ? fmtDesc->name : "unknown",
+                 m_HasAlpha);
         VideoLog(dbg);
     }
 
@@ -214,6 +222,7 @@ void FFmpegDecoder::Close()
     m_Height = 0;
     m_Duration = 0.0;
     m_FrameRate = 0.0;
+    m_Rate = DaroRational{ 0, 1 };
     m_TotalFrames = 0;
     m_HasAlpha = false;
     m_EndOfStream = false;
@@ -223,6 +232,7 @@ void FFmpegDecoder::Close()
 bool FFmpegDecoder::DecodeNextFrame()
 {
     if (!m_Opened || m_EndOfStream) return false;
+    DARO_TRACE_SCOPE("FFmpeg decode");
 
     while (true)
     {
@@ -265,6 +275,7 @@ bool FFmpegDecoder::DecodeNextFrame()
 
         // Convert decoded frame to BGRA for D3D11 (DXGI_FORMAT_B8G8R8A8_UNORM)
         // sws_scale handles all formats including planar alpha (YUVA*) at any bit depth
+        DARO_TRACE_SCOPE("FFmpeg convert");
         sws_scale(m_SwsCtx,
                    m_Frame->data, m_Frame->linesize,
                    0, m_Height,
@@ -289,15 +300,19 @@ int FFmpegDecoder::GetFrameStride() const
 bool FFmpegDecoder::SeekToFrame(int frame)
 {
     if (!m_Opened) return false;
-    double time = (m_FrameRate > 0) ? (double)frame / m_FrameRate : 0.0;
-    return SeekToTime(time);
+    // Exact frame start, so long files do not land a frame early
+    return SeekToTimestamp(DaroFrameToNs(frame, m_Rate) / (DARO_NS_PER_SECOND / AV_TIME_BASE));
 }
 
 bool FFmpegDecoder::SeekToTime(double seconds)
 {
     if (!m_Opened) return false;
+    return SeekToTimestamp((int64_t)(seconds * AV_TIME_BASE));
+}
 
-    int64_t ts = (int64_t)(seconds * AV_TIME_BASE);
+bool FFmpegDecoder::SeekToTimestamp(int64_t ts)
+{
+    DARO_TRACE_SCOPE("FFmpeg seek");
     int ret = av_seek_frame(m_FmtCtx, -1, ts, AVSEEK_FLAG_BACKWARD);
     if (ret < 0) return false;
 
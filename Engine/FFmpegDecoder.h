@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstdint>
+#include "TimeBase.h"
 
 // Auto-detect FFmpeg availability at compile time
 #if __has_include(<libavformat/avformat.h>)
@@ -53,6 +54,7 @@ public:
     int GetHeight() const { return m_Height; }
     double GetDuration() const { return m_Duration; }
     double GetFrameRate() const { return m_FrameRate; }
+    DaroRational GetFrameRateRational() const { return m_Rate; }
     int GetTotalFrames() const { return m_TotalFrames; }
     bool HasAlpha() const { return m_HasAlpha; }
     bool IsEndOfStream() const { return m_EndOfStream; }
@@ -66,12 +68,16 @@ private:
     AVFrame* m_FrameBGRA = nullptr;
     AVPacket* m_Packet = nullptr;
     int m_VideoStreamIdx = -1;
+
+    // Seek to a timestamp in AV_TIME_BASE units (microseconds)
+    bool SeekToTimestamp(int64_t ts);
 #endif
     uint8_t* m_OutputBuffer = nullptr;
     int m_Width = 0;
     int m_Height = 0;
     double m_Duration = 0.0;
     double m_FrameRate = 0.0;
+    DaroRational m_Rate = { 0, 1 };
     int m_TotalFrames = 0;
     bool m_HasAlpha = false;
     bool m_EndOfStream = false;
@@ -1,5 +1,8 @@
 // Engine/FrameBuffer.cpp
 #include "FrameBuffer.h"
+#include "FrameStats.h"
+#include "MemoryStats.h"
+#include "PixelConvert.h"
 #include <chrono>
 #include <sddl.h>
 
@@ -77,6 +80,7 @@ bool DaroFrameBuffer::Initialize(int width, int height)
     m_pHeader->locked = 0;
     m_IsLocked = false;
 
+    DaroMemoryAccountant::Instance().Set(DARO_MEM_FRAME_BUFFER, 0, (long long)m_BufferSize, 0);
     return true;
 }
 
@@ -103,12 +107,14 @@ void DaroFrameBuffer::Shutdown()
 
     m_pHeader = nullptr;
     m_pPixels = nullptr;
+    DaroMemoryAccountant::Instance().Remove(DARO_MEM_FRAME_BUFFER, 0);
 }
 
 void DaroFrameBuffer::Write(const void* pData, int srcStride, long long frameNumber)
 {
     if (!m_pPixels || !pData) return;
 
+    DaroScopedStage lockWait(DARO_STAGE_FRAMEBUFFER_WAIT);
     std::unique_lock<std::mutex> lock(m_Mutex);
 
     // Wait for unlock with timeout (max 10ms to avoid blocking render)
@@ -121,27 +127,14 @@ void DaroFrameBuffer::Write(const void* pData, int srcStride, long long frameNum
         if (m_IsLocked)
             return;
     }
+    lockWait.Stop();
 
-    // Copy data - optimized: if strides match, use single memcpy
-    const BYTE* src = (const BYTE*)pData;
-    BYTE* dst = m_pPixels;
+    DaroScopedStage write(DARO_STAGE_FRAMEBUFFER_WRITE);
 
-    if (srcStride == m_Stride)
-    {
-        // Strides match - single copy for entire buffer
-        memcpy(dst, src, (size_t)m_Stride * m_Height);
-    }
-    else
-    {
-        // Strides differ - row by row copy (use smaller stride to prevent overread)
-        int copyStride = (srcStride < m_Stride) ? srcStride : m_Stride;
-        for (int y = 0; y < m_Height; y++)
-        {
-            memcpy(dst, src, copyStride);
-            src += srcStride;
-            dst += m_Stride;
-        }
-    }
+    // Single memcpy when strides match, otherwise row by row at the smaller stride
+    // to prevent overread
+    int copyStride = (srcStride < m_Stride) ? srcStride : m_Stride;
+    DaroCopyRows(pData, srcStride, m_pPixels, m_Stride, copyStride, m_Height);
 
     m_pHeader->frameNumber = frameNumber;
 }
@@ -0,0 +1,156 @@
+// Engine/FrameMetadata.cpp
+#include "FrameMetadata.h"
+#include "FrameTransport.h"     // DaroTransportNowNs
+#include <cstring>
+#include <string>
+
+static const int MAX_READ_RETRIES = 4;
+
+static std::string MakeSegmentName(const char* senderName)
+{
+    return std::string(senderName) + DARO_METADATA_SUFFIX;
+}
+
+// ============== Writer ==============
+
+DaroMetadataWriter::DaroMetadataWriter() {}
+
+DaroMetadataWriter::~DaroMetadataWriter()
+{
+    Release();
+}
+
+bool DaroMetadataWriter::Create(const char* senderName)
+{
+    Release();
+    if (!senderName || !senderName[0]) return false;
+
+    m_Memory.SetUnlinkOnClose(true);
+    if (m_Memory.Create(MakeSegmentName(senderName).c_str(), sizeof(DaroMetadataHeader)) == DARO_SHM_FAILED)
+        return false;
+
+    // Reset a segment left behind by a previous sender with the same name
+    auto* header = static_cast<DaroMetadataHeader*>(m_Memory.Data());
+    header->magic.store(0, std::memory_order_relaxed);
+    header->version = DARO_METADATA_VERSION;
+    header->recordCount = DARO_METADATA_RECORDS;
+    header->recordSize = (uint32_t)sizeof(DaroMetadataRecord);
+    header->sessionId = DaroTransportNowNs();
+    header->latestFrame.store(-1, std::memory_order_relaxed);
+    for (auto& record : header->records)
+    {
+        record.sequence.store(0, std::memory_order_relaxed);
+        record.data.spoutFrame = -1;
+    }
+    header->magic.store(DARO_METADATA_MAGIC, std::memory_order_release);
+
+    m_Header = header;
+    return true;
+}
+
+void DaroMetadataWriter::Release()
+{
+    if (m_Header)
+    {
+        m_Header->magic.store(0, std::memory_order_release);
+        m_Header = nullptr;
+    }
+    m_Memory.Close();
+}
+
+void DaroMetadataWriter::Write(const DaroFrameMetadata& metadata)
+{
+    if (!m_Header || metadata.spoutFrame < 0) return;
+
+    DaroMetadataRecord& record = m_Header->records[metadata.spoutFrame & (DARO_METADATA_RECORDS - 1)];
+
+    uint32_t seq = record.sequence.load(std::memory_order_relaxed);
+    record.sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy(&record.data, &metadata, sizeof(DaroFrameMetadata));
+    record.data.templateName[DARO_METADATA_NAME - 1] = '\0';
+    record.data.itemName[DARO_METADATA_NAME - 1] = '\0';
+
+    record.sequence.store(seq + 2, std::memory_order_release);
+    m_Header->latestFrame.store(metadata.spoutFrame, std::memory_order_release);
+}
+
+// ============== Reader ==============
+
+DaroMetadataReader::DaroMetadataReader() {}
+
+DaroMetadataReader::~DaroMetadataReader()
+{
+    Close();
+}
+
+bool DaroMetadataReader::Open(const char* senderName)
+{
+    Close();
+    if (!senderName || !senderName[0]) return false;
+    if (!m_Memory.Open(MakeSegmentName(senderName).c_str())) return false;
+
+    auto* header = static_cast<const DaroMetadataHeader*>(m_Memory.Data());
+    if (m_Memory.Size() < sizeof(DaroMetadataHeader) ||
+        header->magic.load(std::memory_order_acquire) != DARO_METADATA_MAGIC ||
+        header->version != DARO_METADATA_VERSION ||
+        header->recordCount != DARO_METADATA_RECORDS ||
+        header->recordSize != sizeof(DaroMetadataRecord))
+    {
+        m_Memory.Close();
+        return false;
+    }
+
+    m_Header = header;
+    m_SessionId = header->sessionId;
+    return true;
+}
+
+void DaroMetadataReader::Close()
+{
+    m_Memory.Close();
+    m_Header = nullptr;
+    m_SessionId = 0;
+}
+
+bool DaroMetadataReader::Read(long long spoutFrame, DaroFrameMetadata* metadata)
+{
+    if (!m_Header || !metadata || spoutFrame < 0) return false;
+    if (IsSenderLost()) return false;
+
+    const DaroMetadataRecord& record = m_Header->records[spoutFrame & (DARO_METADATA_RECORDS - 1)];
+    for (int attempt = 0; attempt < MAX_READ_RETRIES; attempt++)
+    {
+        uint32_t seqBefore = record.sequence.load(std::memory_order_acquire);
+        if (seqBefore & 1) continue;
+
+        DaroFrameMetadata local;
+        memcpy(&local, &record.data, sizeof(local));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (record.sequence.load(std::memory_order_relaxed) != seqBefore) continue;
+
+        // Slot holds a different frame: not written yet, or already overwritten
+        if (local.spoutFrame != spoutFrame) return false;
+
+        *metadata = local;
+        return true;
+    }
+    return false;
+}
+
+bool DaroMetadataReader::ReadLatest(DaroFrameMetadata* metadata)
+{
+    if (!m_Header) return false;
+    int64_t latest = m_Header->latestFrame.load(std::memory_order_acquire);
+    if (latest < 0) return false;
+    return Read(latest, metadata);
+}
+
+bool DaroMetadataReader::IsSenderLost() const
+{
+    if (!m_Header) return true;
+    return m_Header->magic.load(std::memory_order_acquire) != DARO_METADATA_MAGIC ||
+           m_Header->sessionId != m_SessionId;
+}
@@ -0,0 +1,86 @@
+// Engine/FrameMetadata.h
+// Per-frame metadata side channel carried next to a Spout sender.
+// spoutDX memory buffers are whole-buffer copies under a mutex, so they cannot tell a
+// receiver which frame a given texture belongs to. This ring holds fixed-size records
+// indexed by the Spout sender frame count: the sender writes a record after every
+// SendTexture, and a receiver looks up the record for the frame it just received
+// (spoutDX::GetSenderFrame). Records are seqlocked, so the sender never blocks.
+//
+// Like FrameTransport.h, no Windows or D3D dependencies.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "SharedMemory.h"
+#include "SharedTypes.h"
+
+#define DARO_METADATA_SUFFIX "_DaroMeta"       // Segment name = Spout sender name + suffix
+#define DARO_METADATA_RECORDS 64                // Power of two - ~1 s of history at 60 fps
+#define DARO_METADATA_MAGIC 0x4154454Du         // "META"
+#define DARO_METADATA_VERSION 1
+
+static_assert((DARO_METADATA_RECORDS & (DARO_METADATA_RECORDS - 1)) == 0, "DARO_METADATA_RECORDS must be a power of two");
+
+// ---- Shared memory layout ----
+
+struct alignas(64) DaroMetadataRecord
+{
+    std::atomic<uint32_t> sequence;         // Seqlock: odd while the sender is writing
+    uint32_t reserved;
+    DaroFrameMetadata data;
+};
+
+struct alignas(64) DaroMetadataHeader
+{
+    std::atomic<uint32_t> magic;            // Written last by the sender
+    uint32_t version;
+    uint32_t recordCount;
+    uint32_t recordSize;
+    uint64_t sessionId;                     // Changes when the sender is recreated
+    std::atomic<int64_t> latestFrame;       // Spout frame of the newest record (-1 = none)
+    DaroMetadataRecord records[DARO_METADATA_RECORDS];
+};
+
+class DaroMetadataWriter
+{
+public:
+    DaroMetadataWriter();
+    ~DaroMetadataWriter();
+
+    bool Create(const char* senderName);
+    void Release();
+    bool IsCreated() const { return m_Header != nullptr; }
+
+    // Store the record for metadata.spoutFrame, overwriting the oldest slot
+    void Write(const DaroFrameMetadata& metadata);
+
+private:
+    DaroSharedMemory m_Memory;
+    DaroMetadataHeader* m_Header = nullptr;
+};
+
+class DaroMetadataReader
+{
+public:
+    DaroMetadataReader();
+    ~DaroMetadataReader();
+
+    bool Open(const char* senderName);
+    void Close();
+    bool IsOpen() const { return m_Header != nullptr; }
+
+    // Copy the record for an exact Spout frame. Returns false if the sender has not
+    // written it yet, it has already been overwritten, or every read attempt was torn.
+    bool Read(long long spoutFrame, DaroFrameMetadata* metadata);
+
+    // Copy the newest record
+    bool ReadLatest(DaroFrameMetadata* metadata);
+
+    // True if the sender released the ring or was recreated since Open
+    bool IsSenderLost() const;
+
+private:
+    DaroSharedMemory m_Memory;
+    const DaroMetadataHeader* m_Header = nullptr;
+    uint64_t m_SessionId = 0;
+};
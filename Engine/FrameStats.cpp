@@ -0,0 +1,105 @@
+// Engine/FrameStats.cpp
+#include "FrameStats.h"
+#include <cstring>
+#include <Windows.h>
+
+DaroFrameProfiler& DaroFrameProfiler::Instance()
+{
+    static DaroFrameProfiler instance;
+    return instance;
+}
+
+DaroFrameProfiler::DaroFrameProfiler()
+{
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    m_MsPerTick = 1000.0 / (double)freq.QuadPart;
+    m_FrameStart = Now();
+}
+
+long long DaroFrameProfiler::Now()
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return now.QuadPart;
+}
+
+const char* DaroFrameProfiler::StageName(int stage)
+{
+    // Trace event names, indexed by DARO_STAGE_*
+    static const char* const names[DARO_STAGE_COUNT] =
+    {
+        "Begin lock wait", "Spout receive", "Video decode", "Render lock wait",
+        "Layer copy", "Draw", "Text", "GPU wait", "Readback",
+        "Frame buffer wait", "Frame buffer write", "Transport",
+        "Present lock wait", "Present", "Preview",
+    };
+    return (stage >= 0 && stage < DARO_STAGE_COUNT && names[stage]) ? names[stage] : "Stage";
+}
+
+void DaroFrameProfiler::BeginFrame()
+{
+    m_FrameStart.store(Now(), std::memory_order_relaxed);
+}
+
+void DaroFrameProfiler::AddStage(int stage, long long ticks)
+{
+    if (stage < 0 || stage >= DARO_STAGE_COUNT) return;
+    m_StageTicks[stage] += ticks;
+}
+
+double DaroFrameProfiler::EndFrame(long long frameNumber, double frameIntervalMs)
+{
+    unsigned long long index = m_Written.load(std::memory_order_relaxed);
+    Slot& slot = m_Slots[index % DARO_FRAME_STATS_HISTORY];
+
+    unsigned int seq = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.record.frameNumber = frameNumber;
+    slot.record.frameIntervalMs = frameIntervalMs;
+    slot.record.busyMs = TicksToMs(Now() - m_FrameStart.load(std::memory_order_relaxed));
+    for (int i = 0; i < DARO_STAGE_COUNT; i++)
+    {
+        slot.record.stageMs[i] = TicksToMs(m_StageTicks[i]);
+        m_StageTicks[i] = 0;
+    }
+
+    slot.sequence.store(seq + 2, std::memory_order_release);
+    m_Written.store(index + 1, std::memory_order_release);
+
+    // The first EndFrame has no previous frame to measure an interval against
+    if (index > 0)
+        m_Timing[DARO_TIMING_FRAME_INTERVAL].Record((uint64_t)(frameIntervalMs * 1000.0));
+    m_Timing[DARO_TIMING_RENDER].Record((uint64_t)(slot.record.busyMs * 1000.0));
+    return slot.record.busyMs;
+}
+
+int DaroFrameProfiler::GetFrameStats(DaroFrameStats* buffer, int count) const
+{
+    if (!buffer || count <= 0) return 0;
+
+    unsigned long long written = m_Written.load(std::memory_order_acquire);
+    unsigned long long available = written < DARO_FRAME_STATS_HISTORY ? written : DARO_FRAME_STATS_HISTORY;
+    if ((unsigned long long)count > available) count = (int)available;
+
+    // Oldest first; a slot overwritten while copying is dropped from the result
+    int copied = 0;
+    for (unsigned long long i = written - count; i < written; i++)
+    {
+        const Slot& slot = m_Slots[i % DARO_FRAME_STATS_HISTORY];
+        unsigned int seqBefore = slot.sequence.load(std::memory_order_acquire);
+        if (seqBefore & 1) continue;
+
+        DaroFrameStats record;
+        memcpy(&record, &slot.record, sizeof(record));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != seqBefore) continue;
+        if (m_Written.load(std::memory_order_acquire) - i > DARO_FRAME_STATS_HISTORY) continue;    // Lapped
+
+        buffer[copied++] = record;
+    }
+    return copied;
+}
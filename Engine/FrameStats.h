@@ -0,0 +1,97 @@
+// Engine/FrameStats.h
+// Per-stage frame timing.
+// Stages are timed with QueryPerformanceCounter by scoped timers on the render thread
+// and accumulated into the current frame's record. Daro_EndFrame commits the record to
+// a fixed ring that any thread can read without blocking the render thread (each slot
+// is guarded by a seqlock; there is a single writer).
+//
+// Stages are exclusive: a timer nested inside another (text inside draw) has its time
+// removed from the enclosing stage, so the stages of a frame add up to at most busyMs.
+#pragma once
+
+#include <atomic>
+#include "Histogram.h"
+#include "SharedTypes.h"
+#include "Trace.h"
+
+#define DARO_FRAME_STATS_HISTORY 256    // Records kept (~5 s at 50 fps)
+
+class DaroFrameProfiler
+{
+public:
+    static DaroFrameProfiler& Instance();
+
+    // Render thread only: the native render loop's thread while it runs (hosts hold it off
+    // between frames with Daro_LockRenderLoop, never run frames of their own), otherwise the
+    // host's frame calls, serialized by the C# _engineLock
+    void BeginFrame();
+    void AddStage(int stage, long long ticks);
+    int EnterStage(int stage) { int parent = m_ActiveStage; m_ActiveStage = stage; return parent; }
+    void LeaveStage(int parent) { m_ActiveStage = parent; }
+    // Returns the frame's busy time in ms
+    double EndFrame(long long frameNumber, double frameIntervalMs);
+
+    // Copy up to count of the most recent records, oldest first. Any thread.
+    int GetFrameStats(DaroFrameStats* buffer, int count) const;
+
+    // Distributions (DARO_TIMING_*). Interval and render are recorded by EndFrame,
+    // output latency by the Spout send thread.
+    DaroWindowedHistogram* GetTiming(int metric)
+    {
+        return (metric >= 0 && metric < DARO_TIMING_METRIC_COUNT) ? &m_Timing[metric] : nullptr;
+    }
+    long long GetFrameStart() const { return m_FrameStart.load(std::memory_order_relaxed); }
+
+    static long long Now();
+    static const char* StageName(int stage);
+    double TicksToMs(long long ticks) const { return (double)ticks * m_MsPerTick; }
+
+private:
+    DaroFrameProfiler();
+
+    struct Slot
+    {
+        std::atomic<unsigned int> sequence{ 0 };   // Odd while being written
+        DaroFrameStats record;
+    };
+
+    double m_MsPerTick = 0.0;
+    std::atomic<long long> m_FrameStart{ 0 };
+    int m_ActiveStage = -1;
+    long long m_StageTicks[DARO_STAGE_COUNT] = {};
+
+    Slot m_Slots[DARO_FRAME_STATS_HISTORY];
+    std::atomic<unsigned long long> m_Written{ 0 };
+
+    DaroWindowedHistogram m_Timing[DARO_TIMING_METRIC_COUNT];
+};
+
+// Times the enclosing scope (or until Stop) and adds it to a stage.
+// Also recorded as a trace event while tracing is on.
+class DaroScopedStage
+{
+public:
+    explicit DaroScopedStage(int stage)
+        : m_Stage(stage), m_Parent(DaroFrameProfiler::Instance().EnterStage(stage)), m_Start(DaroFrameProfiler::Now()) {}
+    ~DaroScopedStage() { Stop(); }
+
+    void Stop()
+    {
+        if (m_Stage < 0) return;
+        long long elapsed = DaroFrameProfiler::Now() - m_Start;
+        DaroFrameProfiler& profiler = DaroFrameProfiler::Instance();
+        profiler.AddStage(m_Stage, elapsed);
+        if (m_Parent >= 0) profiler.AddStage(m_Parent, -elapsed);
+        profiler.LeaveStage(m_Parent);
+        if (DaroTrace::IsEnabled()) DaroTrace::Record(DaroFrameProfiler::StageName(m_Stage), m_Start, m_Start + elapsed);
+        m_Stage = -1;
+    }
+
+    DaroScopedStage(const DaroScopedStage&) = delete;
+    DaroScopedStage& operator=(const DaroScopedStage&) = delete;
+
+private:
+    int m_Stage;
+    int m_Parent;
+    long long m_Start;
+};
@@ -0,0 +1,440 @@
+// Engine/FrameTransport.cpp
+#include "FrameTransport.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+static uint32_t CurrentProcessId() { return (uint32_t)GetCurrentProcessId(); }
+
+static bool IsProcessAlive(uint32_t processId)
+{
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processId);
+    if (!process) return GetLastError() == ERROR_ACCESS_DENIED;     // Exists, owned by someone else
+    DWORD exitCode = 0;
+    bool alive = GetExitCodeProcess(process, &exitCode) && exitCode == STILL_ACTIVE;
+    CloseHandle(process);
+    return alive;
+}
+#else
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+static uint32_t CurrentProcessId() { return (uint32_t)getpid(); }
+
+static bool IsProcessAlive(uint32_t processId)
+{
+    return kill((pid_t)processId, 0) == 0 || errno == EPERM;
+}
+#endif
+
+// Maximum seqlock retries before a receive gives up for this call
+static const int MAX_READ_RETRIES = 4;
+
+// ReceiveFrame without a format: deliver in whatever format the sender publishes
+static const uint32_t SENDER_FORMAT = 0xFFFFFFFFu;
+
+uint64_t DaroTransportNowNs()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// The heartbeat only advances when a frame is published, so a sender that is idle (paused
+// output, waiting for a scene) is still live as long as its process exists. Only a sender
+// whose heartbeat is stale and whose process is gone is treated as crashed.
+static bool IsEntryLive(const DaroTransportRegistryEntry& entry, uint64_t now)
+{
+    if (entry.state.load(std::memory_order_acquire) != 2) return false;
+    uint64_t heartbeat = entry.heartbeatNs.load(std::memory_order_relaxed);
+    if (now - heartbeat < (uint64_t)DARO_TRANSPORT_STALE_MS * 1000000ull) return true;
+    return IsProcessAlive(entry.processId);
+}
+
+// ============== Registry ==============
+
+bool DaroTransportRegistryView::Open()
+{
+    if (m_Registry) return true;
+
+    DaroShmResult result = m_Memory.Create(DARO_TRANSPORT_REGISTRY_NAME, sizeof(DaroTransportRegistry));
+    if (result == DARO_SHM_FAILED) return false;
+
+    auto* registry = static_cast<DaroTransportRegistry*>(m_Memory.Data());
+    if (result == DARO_SHM_CREATED)
+    {
+        // Fresh segment is zero-filled; publish the header last
+        registry->version = DARO_TRANSPORT_VERSION;
+        registry->magic.store(DARO_TRANSPORT_MAGIC, std::memory_order_release);
+    }
+    else
+    {
+        // Creator may still be initializing - give it a moment
+        for (int i = 0; i < 100 && registry->magic.load(std::memory_order_acquire) != DARO_TRANSPORT_MAGIC; i++)
+            std::this_thread::yield();
+        if (registry->magic.load(std::memory_order_acquire) != DARO_TRANSPORT_MAGIC ||
+            registry->version != DARO_TRANSPORT_VERSION)
+        {
+            m_Memory.Close();
+            return false;
+        }
+    }
+
+    m_Registry = registry;
+    return true;
+}
+
+std::vector<std::string> DaroTransportRegistryView::GetSenderNames()
+{
+    std::vector<std::string> names;
+    if (!Open()) return names;
+
+    uint64_t now = DaroTransportNowNs();
+    for (auto& entry : m_Registry->entries)
+    {
+        if (IsEntryLive(entry, now))
+            names.emplace_back(entry.name, strnlen(entry.name, DARO_TRANSPORT_MAX_NAME));
+    }
+    return names;
+}
+
+bool DaroTransportRegistryView::FindSender(const char* name, DaroTransportFrameInfo* info)
+{
+    if (!name || !Open()) return false;
+
+    uint64_t now = DaroTransportNowNs();
+    for (auto& entry : m_Registry->entries)
+    {
+        if (!IsEntryLive(entry, now)) continue;
+        if (strncmp(entry.name, name, DARO_TRANSPORT_MAX_NAME) != 0) continue;
+
+        if (info)
+        {
+            memset(info, 0, sizeof(*info));
+            info->width = entry.width;
+            info->height = entry.height;
+            info->stride = entry.width * 4;
+            info->format = entry.format;
+        }
+        return true;
+    }
+    return false;
+}
+
+int DaroTransportRegistryView::Register(const char* name, uint32_t width, uint32_t height, uint32_t format)
+{
+    if (!name || !name[0] || strlen(name) >= DARO_TRANSPORT_MAX_NAME || !Open()) return -1;
+
+    uint64_t now = DaroTransportNowNs();
+
+    // A live sender already owns this name; a stale one (crashed process) is reclaimed
+    for (int i = 0; i < DARO_TRANSPORT_MAX_SENDERS; i++)
+    {
+        auto& entry = m_Registry->entries[i];
+        if (entry.state.load(std::memory_order_acquire) != 2) continue;
+        if (strncmp(entry.name, name, DARO_TRANSPORT_MAX_NAME) != 0) continue;
+        if (IsEntryLive(entry, now)) return -1;
+
+        uint32_t expected = 2;
+        entry.state.compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+    }
+
+    for (int i = 0; i < DARO_TRANSPORT_MAX_SENDERS; i++)
+    {
+        auto& entry = m_Registry->entries[i];
+        uint32_t expected = 0;
+        if (!entry.state.compare_exchange_strong(expected, 1, std::memory_order_acq_rel))
+        {
+            // Also reclaim slots left behind by crashed senders
+            if (expected != 2 || IsEntryLive(entry, now)) continue;
+            if (!entry.state.compare_exchange_strong(expected, 1, std::memory_order_acq_rel)) continue;
+        }
+
+        memset(entry.name, 0, sizeof(entry.name));
+        memcpy(entry.name, name, strlen(name));     // Length checked above, terminator from memset
+        entry.processId = CurrentProcessId();
+        entry.width = width;
+        entry.height = height;
+        entry.format = format;
+        entry.heartbeatNs.store(now, std::memory_order_relaxed);
+        entry.state.store(2, std::memory_order_release);
+        m_Registry->generation.fetch_add(1, std::memory_order_relaxed);
+        return i;
+    }
+    return -1;  // Registry full
+}
+
+void DaroTransportRegistryView::Release(int entryIndex)
+{
+    if (!m_Registry || entryIndex < 0 || entryIndex >= DARO_TRANSPORT_MAX_SENDERS) return;
+    m_Registry->entries[entryIndex].state.store(0, std::memory_order_release);
+    m_Registry->generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DaroTransportRegistryView::Heartbeat(int entryIndex)
+{
+    if (!m_Registry || entryIndex < 0 || entryIndex >= DARO_TRANSPORT_MAX_SENDERS) return;
+    m_Registry->entries[entryIndex].heartbeatNs.store(DaroTransportNowNs(), std::memory_order_relaxed);
+}
+
+// ============== Sender ==============
+
+static size_t AlignUp64(size_t value) { return (value + 63) & ~(size_t)63; }
+
+DaroFrameSender::DaroFrameSender() {}
+
+DaroFrameSender::~DaroFrameSender()
+{
+    Release();
+}
+
+bool DaroFrameSender::Create(const char* name, uint32_t width, uint32_t height, uint32_t format)
+{
+    Release();
+    if (!name || !name[0] || width == 0 || height == 0 || width > 16384 || height > 16384) return false;
+    if (DaroPixelBytes(format) != 4) return false;
+
+    int index = m_Registry.Register(name, width, height, format);
+    if (index < 0) return false;
+
+    size_t slotBytes = AlignUp64((size_t)width * height * 4);
+    size_t totalSize = AlignUp64(sizeof(DaroTransportHeader)) + slotBytes * DARO_TRANSPORT_SLOTS;
+
+    std::string memName = std::string(DARO_TRANSPORT_SENDER_PREFIX) + name;
+    m_Memory.SetUnlinkOnClose(true);
+    DaroShmResult result = m_Memory.Create(memName.c_str(), totalSize);
+    if (result == DARO_SHM_FAILED)
+    {
+        m_Registry.Release(index);
+        return false;
+    }
+
+    // Reusing a segment left by a previous sender with the same name: reset it.
+    // Receivers detect the change through sessionId.
+    auto* header = static_cast<DaroTransportHeader*>(m_Memory.Data());
+    header->magic.store(0, std::memory_order_relaxed);
+    header->version = DARO_TRANSPORT_VERSION;
+    header->slotCount = DARO_TRANSPORT_SLOTS;
+    header->slotBytes = slotBytes;
+    header->sessionId = DaroTransportNowNs() ^ ((uint64_t)CurrentProcessId() << 32);
+    header->publishCount.store(0, std::memory_order_relaxed);
+    for (auto& slot : header->slots)
+    {
+        slot.sequence.store(0, std::memory_order_relaxed);
+        slot.bytes = 0;
+    }
+    header->magic.store(DARO_TRANSPORT_MAGIC, std::memory_order_release);
+
+    m_Header = header;
+    m_Pixels = static_cast<uint8_t*>(m_Memory.Data()) + AlignUp64(sizeof(DaroTransportHeader));
+    m_RegistryIndex = index;
+    m_Name = name;
+    m_Width = width;
+    m_Height = height;
+    m_Format = format;
+    return true;
+}
+
+void DaroFrameSender::Release()
+{
+    if (m_RegistryIndex >= 0)
+    {
+        m_Registry.Release(m_RegistryIndex);
+        m_RegistryIndex = -1;
+    }
+    if (m_Header)
+    {
+        // Receivers see the magic vanish and reconnect
+        m_Header->magic.store(0, std::memory_order_release);
+        m_Header = nullptr;
+    }
+    m_Memory.Close();
+    m_Pixels = nullptr;
+    m_Name.clear();
+}
+
+bool DaroFrameSender::Publish(const void* pixels, uint32_t srcStride, uint64_t frameNumber, uint32_t timecode,
+                              uint32_t srcFormat)
+{
+    if (!m_Header || !pixels) return false;
+
+    uint32_t rowBytes = m_Width * 4;
+    if (srcStride < rowBytes) return false;
+
+    uint64_t count = m_Header->publishCount.load(std::memory_order_relaxed);
+    uint32_t slotIndex = (uint32_t)(count % DARO_TRANSPORT_SLOTS);
+    DaroTransportSlot& slot = m_Header->slots[slotIndex];
+    uint8_t* dst = m_Pixels + (size_t)slotIndex * m_Header->slotBytes;
+
+    // Seqlock write: odd sequence marks the slot as being written
+    uint32_t seq = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    DaroConvertDesc convert = {};
+    convert.width = m_Width;
+    convert.height = m_Height;
+    convert.srcFormat = srcFormat;
+    convert.srcStride = srcStride;
+    convert.dstFormat = m_Format;
+    convert.dstStride = rowBytes;
+    DaroConvertPixels(pixels, dst, convert);
+
+    slot.width = m_Width;
+    slot.height = m_Height;
+    slot.stride = rowBytes;
+    slot.format = m_Format;
+    slot.timecode = timecode;
+    slot.frameNumber = frameNumber;
+    slot.timestampNs = DaroTransportNowNs();
+    slot.bytes = (uint64_t)rowBytes * m_Height;
+
+    slot.sequence.store(seq + 2, std::memory_order_release);
+    m_Header->publishCount.store(count + 1, std::memory_order_release);
+
+    m_Registry.Heartbeat(m_RegistryIndex);
+    return true;
+}
+
+uint64_t DaroFrameSender::GetPublishedCount() const
+{
+    return m_Header ? m_Header->publishCount.load(std::memory_order_relaxed) : 0;
+}
+
+// ============== Receiver ==============
+
+DaroFrameReceiver::DaroFrameReceiver() {}
+
+DaroFrameReceiver::~DaroFrameReceiver()
+{
+    Disconnect();
+}
+
+bool DaroFrameReceiver::Connect(const char* name)
+{
+    Disconnect();
+    if (!name || !name[0]) return false;
+
+    std::string memName = std::string(DARO_TRANSPORT_SENDER_PREFIX) + name;
+    if (!m_Memory.Open(memName.c_str())) return false;
+
+    auto* header = static_cast<const DaroTransportHeader*>(m_Memory.Data());
+    if (m_Memory.Size() < sizeof(DaroTransportHeader) ||
+        header->magic.load(std::memory_order_acquire) != DARO_TRANSPORT_MAGIC ||
+        header->version != DARO_TRANSPORT_VERSION ||
+        header->slotCount != DARO_TRANSPORT_SLOTS ||
+        m_Memory.Size() < AlignUp64(sizeof(DaroTransportHeader)) + header->slotBytes * DARO_TRANSPORT_SLOTS)
+    {
+        m_Memory.Close();
+        return false;
+    }
+
+    m_Header = header;
+    m_Pixels = static_cast<const uint8_t*>(m_Memory.Data()) + AlignUp64(sizeof(DaroTransportHeader));
+    m_Name = name;
+    m_SessionId = header->sessionId;
+    m_SlotBytes = header->slotBytes;
+    m_LastPublishCount = 0;
+    return true;
+}
+
+void DaroFrameReceiver::Disconnect()
+{
+    m_Memory.Close();
+    m_Registry.Close();
+    m_Header = nullptr;
+    m_Pixels = nullptr;
+    m_Name.clear();
+    m_SessionId = 0;
+    m_SlotBytes = 0;
+    m_LastPublishCount = 0;
+}
+
+size_t DaroFrameReceiver::GetFrameBytes() const
+{
+    return m_Header ? (size_t)m_SlotBytes : 0;
+}
+
+bool DaroFrameReceiver::ReceiveFrame(void* dst, size_t dstSize, DaroTransportFrameInfo* info)
+{
+    return ReceiveFrame(dst, dstSize, info, SENDER_FORMAT, false, 0);
+}
+
+bool DaroFrameReceiver::ReceiveFrame(void* dst, size_t dstSize, DaroTransportFrameInfo* info,
+                                     uint32_t dstFormat, bool flipVertical, uint32_t dstStride)
+{
+    if (!m_Header || !dst) return false;
+    if (m_Header->magic.load(std::memory_order_acquire) != DARO_TRANSPORT_MAGIC) return false;
+    if (m_Header->sessionId != m_SessionId) return false;     // Recreated - reconnect first
+
+    for (int attempt = 0; attempt < MAX_READ_RETRIES; attempt++)
+    {
+        uint64_t count = m_Header->publishCount.load(std::memory_order_acquire);
+        if (count == 0 || count == m_LastPublishCount) return false;
+
+        uint32_t slotIndex = (uint32_t)((count - 1) % DARO_TRANSPORT_SLOTS);
+        const DaroTransportSlot& slot = m_Header->slots[slotIndex];
+
+        uint32_t seqBefore = slot.sequence.load(std::memory_order_acquire);
+        if (seqBefore & 1)
+        {
+            m_TornReads++;
+            continue;
+        }
+
+        uint64_t bytes = slot.bytes;
+        if (bytes > m_SlotBytes) return false;
+
+        DaroTransportFrameInfo local = {};
+        local.width = slot.width;
+        local.height = slot.height;
+        local.stride = slot.stride;
+        local.format = slot.format;
+        local.timecode = slot.timecode;
+        local.frameNumber = slot.frameNumber;
+        local.timestampNs = slot.timestampNs;
+        const uint8_t* src = m_Pixels + (size_t)slotIndex * m_SlotBytes;
+
+        // Pitch/flip/swizzle straight from the slot in one pass - no intermediate copy.
+        // Delivering in the sender's format unflipped is a single memcpy.
+        DaroConvertDesc convert = {};
+        convert.width = local.width;
+        convert.height = local.height;
+        convert.srcFormat = local.format;
+        convert.srcStride = local.stride;
+        convert.dstFormat = (dstFormat == SENDER_FORMAT) ? local.format : dstFormat;
+        convert.dstStride = dstStride;
+        convert.flipVertical = flipVertical;
+        if ((uint64_t)local.stride * local.height > bytes) return false;
+        if (DaroConvertDstSize(convert) > dstSize) return false;
+        if (!DaroConvertPixels(src, dst, convert)) return false;
+
+        local.format = convert.dstFormat;
+        local.stride = dstStride ? dstStride : local.width * DaroPixelBytes(convert.dstFormat);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != seqBefore)
+        {
+            // Sender lapped the ring while we were copying - try the newest slot again
+            m_TornReads++;
+            continue;
+        }
+
+        if (m_LastPublishCount > 0 && count > m_LastPublishCount + 1)
+            m_DroppedFrames += count - m_LastPublishCount - 1;
+        m_LastPublishCount = count;
+
+        if (info) *info = local;
+        return true;
+    }
+    return false;
+}
+
+bool DaroFrameReceiver::IsSenderLost()
+{
+    if (!m_Header) return true;
+    if (m_Header->magic.load(std::memory_order_acquire) != DARO_TRANSPORT_MAGIC) return true;
+    if (m_Header->sessionId != m_SessionId) return true;
+    return !m_Registry.FindSender(m_Name.c_str());
+}
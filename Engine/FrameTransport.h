@@ -0,0 +1,195 @@
+// Engine/FrameTransport.h
+// Portable CPU frame transport over named shared memory.
+// Follows Spout's model - named senders, a discovery registry and receivers that
+// attach by name - but carries CPU pixel data so tools without D3D (Linux ingest, QC)
+// can receive engine output. Frames are published into a small ring of slots, each
+// guarded by a seqlock, so the sender never waits for a receiver.
+//
+// This file and FrameTransport.cpp/SharedMemory.cpp have no Windows or D3D dependencies
+// and can be compiled directly into external tools.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "PixelConvert.h"
+#include "SharedMemory.h"
+
+#define DARO_TRANSPORT_REGISTRY_NAME "DaroFrameSenders"
+#define DARO_TRANSPORT_SENDER_PREFIX "DaroFrame_"
+#define DARO_TRANSPORT_MAX_SENDERS 16
+#define DARO_TRANSPORT_MAX_NAME 64
+#define DARO_TRANSPORT_SLOTS 3
+#define DARO_TRANSPORT_MAGIC 0x4D524644u    // "DFRM"
+#define DARO_TRANSPORT_VERSION 1
+
+// A sender whose heartbeat is older than this is treated as gone once its process has exited
+#define DARO_TRANSPORT_STALE_MS 2000
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Transport requires lock-free 32-bit atomics");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Transport requires lock-free 64-bit atomics");
+
+// Frame description returned to receivers
+struct DaroTransportFrameInfo
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;            // Bytes per row in the transport (always width * 4)
+    uint32_t format;            // DARO_PIXEL_* (transport slots are always BGRA8 or RGBA8)
+    uint32_t timecode;          // SMPTE hh:mm:ss:ff packed as 0xHHMMSSFF (DaroFrameToTimecode)
+    uint64_t frameNumber;       // Engine frame number
+    uint64_t timestampNs;       // Sender steady clock at publish
+};
+
+// ---- Shared memory layout (fixed-width types only, identical on 32/64-bit) ----
+
+struct DaroTransportRegistryEntry
+{
+    std::atomic<uint32_t> state;            // 0 = free, 1 = claiming, 2 = active
+    uint32_t processId;
+    std::atomic<uint64_t> heartbeatNs;      // Sender steady clock, updated every publish
+                                            // (processId decides once it goes stale)
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;
+    uint32_t reserved;
+    char name[DARO_TRANSPORT_MAX_NAME];
+};
+
+struct DaroTransportRegistry
+{
+    std::atomic<uint32_t> magic;            // Written last by the creator
+    uint32_t version;
+    std::atomic<uint32_t> generation;       // Bumped on every register/release
+    uint32_t reserved;
+    DaroTransportRegistryEntry entries[DARO_TRANSPORT_MAX_SENDERS];
+};
+
+struct alignas(64) DaroTransportSlot
+{
+    std::atomic<uint32_t> sequence;         // Seqlock: odd while the sender is writing
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+    uint32_t format;
+    uint32_t timecode;
+    uint64_t frameNumber;
+    uint64_t timestampNs;
+    uint64_t bytes;
+};
+
+struct alignas(64) DaroTransportHeader
+{
+    std::atomic<uint32_t> magic;            // Written last by the sender
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t reserved;
+    uint64_t slotBytes;                     // Pixel capacity of each slot
+    uint64_t sessionId;                     // Changes when the sender is recreated
+    std::atomic<uint64_t> publishCount;     // Frames published; latest slot = (count - 1) % slotCount
+    DaroTransportSlot slots[DARO_TRANSPORT_SLOTS];
+};
+
+// Monotonic clock shared by senders and receivers (steady_clock is system-wide on
+// both Windows and Linux, so timestamps are comparable across processes)
+uint64_t DaroTransportNowNs();
+
+// Sender discovery, modeled on spoutSenderNames
+class DaroTransportRegistryView
+{
+public:
+    bool Open();
+    void Close() { m_Memory.Close(); m_Registry = nullptr; }
+
+    // Names of live senders (stale heartbeats of exited processes are skipped)
+    std::vector<std::string> GetSenderNames();
+    bool FindSender(const char* name, DaroTransportFrameInfo* info = nullptr);
+
+    // Used by DaroFrameSender
+    int Register(const char* name, uint32_t width, uint32_t height, uint32_t format);
+    void Release(int entryIndex);
+    void Heartbeat(int entryIndex);
+
+private:
+    DaroSharedMemory m_Memory;
+    DaroTransportRegistry* m_Registry = nullptr;
+};
+
+class DaroFrameSender
+{
+public:
+    DaroFrameSender();
+    ~DaroFrameSender();
+
+    // Create the named sender; fails if a live sender already uses the name
+    bool Create(const char* name, uint32_t width, uint32_t height, uint32_t format = DARO_PIXEL_BGRA8);
+    void Release();
+    bool IsCreated() const { return m_Header != nullptr; }
+    const std::string& GetName() const { return m_Name; }
+    size_t GetMemorySize() const { return m_Memory.Size(); }
+
+    // Publish a frame. srcStride may include row padding (e.g. a mapped staging texture);
+    // rows are packed to width * 4 and swizzled to the sender format in the same pass.
+    // Never blocks on receivers.
+    bool Publish(const void* pixels, uint32_t srcStride, uint64_t frameNumber, uint32_t timecode,
+                 uint32_t srcFormat = DARO_PIXEL_BGRA8);
+
+    uint64_t GetPublishedCount() const;
+
+private:
+    DaroSharedMemory m_Memory;
+    DaroTransportRegistryView m_Registry;
+    DaroTransportHeader* m_Header = nullptr;
+    uint8_t* m_Pixels = nullptr;
+    int m_RegistryIndex = -1;
+    std::string m_Name;
+    uint32_t m_Width = 0;
+    uint32_t m_Height = 0;
+    uint32_t m_Format = DARO_PIXEL_BGRA8;
+};
+
+class DaroFrameReceiver
+{
+public:
+    DaroFrameReceiver();
+    ~DaroFrameReceiver();
+
+    // Attach to a sender by name
+    bool Connect(const char* name);
+    void Disconnect();
+    bool IsConnected() const { return m_Header != nullptr; }
+
+    // Size of buffer needed for ReceiveFrame (0 if not connected)
+    size_t GetFrameBytes() const;
+
+    // Copy the latest frame if one has been published since the last call.
+    // Returns false if there is no new frame, the buffer is too small or the
+    // frame was overwritten while copying on every retry.
+    bool ReceiveFrame(void* dst, size_t dstSize, DaroTransportFrameInfo* info);
+
+    // Same, but convert straight out of the shared slot into dstFormat (any DARO_PIXEL_*),
+    // optionally flipped and with a destination row pitch (0 = packed). info describes
+    // the converted frame. Use DaroConvertDstSize to size the buffer.
+    bool ReceiveFrame(void* dst, size_t dstSize, DaroTransportFrameInfo* info,
+                      uint32_t dstFormat, bool flipVertical, uint32_t dstStride = 0);
+
+    // True if the sender has been recreated, released, or its process is gone
+    bool IsSenderLost();
+
+    uint64_t GetDroppedFrames() const { return m_DroppedFrames; }
+    uint64_t GetTornReads() const { return m_TornReads; }
+
+private:
+    DaroSharedMemory m_Memory;
+    DaroTransportRegistryView m_Registry;
+    const DaroTransportHeader* m_Header = nullptr;
+    const uint8_t* m_Pixels = nullptr;
+    std::string m_Name;
+    uint64_t m_SessionId = 0;
+    uint64_t m_SlotBytes = 0;       // From Connect: a recreated sender may grow the segment past our view
+    uint64_t m_LastPublishCount = 0;
+    uint64_t m_DroppedFrames = 0;   // Frames published but never received (receiver too slow)
+    uint64_t m_TornReads = 0;       // Seqlock retries
+};
@@ -0,0 +1,174 @@
+// Engine/Histogram.cpp
+#include "Histogram.h"
+#include <chrono>
+
+static const int MAX_SUMMARY_RETRIES = 4;
+static const uint64_t MAX_VALUE_US = ((uint64_t)2 * DARO_HIST_SUB_BUCKETS << DARO_HIST_MAX_SHIFT) - 1;
+
+static uint64_t NowNs()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static int HighestBit(uint64_t value)
+{
+    int bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+}
+
+// ============== DaroHistogram ==============
+
+int DaroHistogram::BucketIndex(uint64_t valueUs)
+{
+    if (valueUs > MAX_VALUE_US) valueUs = MAX_VALUE_US;
+    if (valueUs < 2 * DARO_HIST_SUB_BUCKETS) return (int)valueUs;
+
+    // Shift so the value lands in [64, 128): 64 linear steps per power of two
+    int shift = HighestBit(valueUs) - 6;
+    int sub = (int)(valueUs >> shift) - DARO_HIST_SUB_BUCKETS;
+    return 2 * DARO_HIST_SUB_BUCKETS + (shift - 1) * DARO_HIST_SUB_BUCKETS + sub;
+}
+
+uint64_t DaroHistogram::BucketValue(int index)
+{
+    if (index < 2 * DARO_HIST_SUB_BUCKETS) return (uint64_t)index;
+
+    int k = index - 2 * DARO_HIST_SUB_BUCKETS;
+    int shift = k / DARO_HIST_SUB_BUCKETS + 1;
+    uint64_t sub = (uint64_t)(k % DARO_HIST_SUB_BUCKETS + DARO_HIST_SUB_BUCKETS);
+    uint64_t lower = sub << shift;
+    uint64_t upper = ((sub + 1) << shift) - 1;
+    return (lower + upper) / 2;
+}
+
+void DaroHistogram::Record(uint64_t valueUs)
+{
+    m_Counts[BucketIndex(valueUs)].fetch_add(1, std::memory_order_relaxed);
+    m_SumUs.fetch_add(valueUs, std::memory_order_relaxed);
+    if (valueUs > m_MaxUs.load(std::memory_order_relaxed))
+        m_MaxUs.store(valueUs, std::memory_order_relaxed);
+    m_Total.fetch_add(1, std::memory_order_release);
+}
+
+void DaroHistogram::Clear()
+{
+    for (auto& count : m_Counts)
+        count.store(0, std::memory_order_relaxed);
+    m_SumUs.store(0, std::memory_order_relaxed);
+    m_MaxUs.store(0, std::memory_order_relaxed);
+    m_Total.store(0, std::memory_order_release);
+}
+
+void DaroHistogram::Summarize(DaroTimingSummary* summary) const
+{
+    *summary = {};
+
+    // Take the count from the buckets themselves so percentiles stay consistent
+    // with the distribution even if the writer is mid-update
+    uint64_t total = 0;
+    for (auto& count : m_Counts)
+        total += count.load(std::memory_order_relaxed);
+    if (total == 0) return;
+
+    const double percentiles[] = { 0.50, 0.95, 0.99, 0.999 };
+    double* outputs[] = { &summary->p50Ms, &summary->p95Ms, &summary->p99Ms, &summary->p999Ms };
+    const int percentileCount = 4;
+
+    uint64_t maxUs = m_MaxUs.load(std::memory_order_relaxed);
+    uint64_t cumulative = 0;
+    int next = 0;
+    for (int i = 0; i < DARO_HIST_BUCKETS && next < percentileCount; i++)
+    {
+        cumulative += m_Counts[i].load(std::memory_order_relaxed);
+        while (next < percentileCount && (double)cumulative >= percentiles[next] * (double)total)
+        {
+            uint64_t value = BucketValue(i);
+            if (maxUs > 0 && value > maxUs) value = maxUs;
+            *outputs[next] = (double)value / 1000.0;
+            next++;
+        }
+    }
+
+    summary->count = (long long)total;
+    summary->meanMs = (double)m_SumUs.load(std::memory_order_relaxed) / (double)total / 1000.0;
+    summary->maxMs = (double)maxUs / 1000.0;
+}
+
+// ============== DaroWindowedHistogram ==============
+
+DaroWindowedHistogram::DaroWindowedHistogram()
+{
+    m_WindowNs.store((uint64_t)DARO_TIMING_DEFAULT_WINDOW_MS * 1000000ull);
+}
+
+void DaroWindowedHistogram::Record(uint64_t valueUs)
+{
+    uint64_t now = NowNs();
+
+    if (m_ResetRequested.exchange(false, std::memory_order_acq_rel))
+    {
+        m_Generation.fetch_add(1, std::memory_order_acq_rel);
+        m_SinceReset.Clear();
+        for (auto& window : m_Windows) window.Clear();
+        m_WindowStartNs = now;
+        m_Generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    if (m_WindowStartNs == 0)
+    {
+        m_WindowStartNs = now;
+    }
+    else if (now - m_WindowStartNs >= m_WindowNs.load(std::memory_order_relaxed))
+    {
+        // active -> completed, spare (cleared) -> active
+        int active = m_Active.load(std::memory_order_relaxed);
+        int completed = m_Completed.load(std::memory_order_relaxed);
+        int spare = 3 - active - completed;
+
+        m_Generation.fetch_add(1, std::memory_order_acq_rel);
+        m_Windows[spare].Clear();
+        m_Completed.store(active, std::memory_order_relaxed);
+        m_Active.store(spare, std::memory_order_relaxed);
+        m_Generation.fetch_add(1, std::memory_order_acq_rel);
+        m_WindowStartNs = now;
+    }
+
+    m_SinceReset.Record(valueUs);
+    m_Windows[m_Active.load(std::memory_order_relaxed)].Record(valueUs);
+}
+
+void DaroWindowedHistogram::SetWindow(uint32_t milliseconds)
+{
+    if (milliseconds == 0) milliseconds = DARO_TIMING_DEFAULT_WINDOW_MS;
+    m_WindowNs.store((uint64_t)milliseconds * 1000000ull, std::memory_order_relaxed);
+}
+
+void DaroWindowedHistogram::RequestReset()
+{
+    m_ResetRequested.store(true, std::memory_order_release);
+}
+
+bool DaroWindowedHistogram::Summarize(int window, DaroTimingSummary* summary) const
+{
+    if (!summary) return false;
+    if (window != DARO_TIMING_SINCE_RESET && window != DARO_TIMING_LAST_WINDOW) return false;
+
+    for (int attempt = 0; attempt < MAX_SUMMARY_RETRIES; attempt++)
+    {
+        uint32_t genBefore = m_Generation.load(std::memory_order_acquire);
+        if (genBefore & 1) continue;
+
+        if (window == DARO_TIMING_SINCE_RESET)
+            m_SinceReset.Summarize(summary);
+        else
+            m_Windows[m_Completed.load(std::memory_order_relaxed)].Summarize(summary);
+
+        // The bucket loads above must complete before the generation is checked again
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_Generation.load(std::memory_order_relaxed) == genBefore)
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,67 @@
+// Engine/Histogram.h
+// HDR-histogram style latency accumulators.
+// Values are recorded in microseconds into log-linear buckets: exact below 128 us,
+// then 64 linear sub-buckets per power of two (~1.6% worst-case error) up to ~67 s.
+// Recording is a couple of relaxed atomic adds from a single writer thread; readers
+// compute percentiles from the bucket counts without taking any lock.
+//
+// No Windows or D3D dependencies.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "SharedTypes.h"
+
+#define DARO_HIST_SUB_BUCKETS 64
+#define DARO_HIST_MAX_SHIFT 19                                             // 64 << 20 us = ~67 s
+#define DARO_HIST_BUCKETS (2 * DARO_HIST_SUB_BUCKETS + DARO_HIST_MAX_SHIFT * DARO_HIST_SUB_BUCKETS)
+
+class DaroHistogram
+{
+public:
+    DaroHistogram() { Clear(); }
+
+    // Writer thread only
+    void Record(uint64_t valueUs);
+    void Clear();
+
+    // Any thread. Counts recorded concurrently may or may not be included.
+    void Summarize(DaroTimingSummary* summary) const;
+
+private:
+    static int BucketIndex(uint64_t valueUs);
+    static uint64_t BucketValue(int index);     // Midpoint of the bucket range
+
+    std::atomic<uint32_t> m_Counts[DARO_HIST_BUCKETS];
+    std::atomic<uint64_t> m_Total;
+    std::atomic<uint64_t> m_SumUs;
+    std::atomic<uint64_t> m_MaxUs;
+};
+
+// A histogram since the last reset plus fixed-length windows. Windows rotate on the
+// writer thread when a value arrives after the window elapsed; readers see the last
+// completed window. Three buffers rotate so the one being cleared is never the one
+// readers are summarizing; a generation counter catches readers that straddle a rotation.
+class DaroWindowedHistogram
+{
+public:
+    DaroWindowedHistogram();
+
+    // Writer thread only
+    void Record(uint64_t valueUs);
+
+    // Any thread
+    void SetWindow(uint32_t milliseconds);
+    void RequestReset();        // Applied by the writer on its next Record
+    bool Summarize(int window, DaroTimingSummary* summary) const;
+
+private:
+    DaroHistogram m_SinceReset;
+    DaroHistogram m_Windows[3];
+    std::atomic<int> m_Active{ 0 };
+    std::atomic<int> m_Completed{ 1 };
+    std::atomic<uint32_t> m_Generation{ 0 };    // Odd while rotating or resetting
+    std::atomic<bool> m_ResetRequested{ false };
+    std::atomic<uint64_t> m_WindowNs;
+    uint64_t m_WindowStartNs = 0;
+};
@@ -0,0 +1,25 @@
+// Engine/LayerMasks.cpp
+#include "LayerMasks.h"
+
+void DaroBuildMaskMap(const DaroLayer* layers, int layerCount, DaroMaskMap& layerToMasks)
+{
+    // Clear the lists but keep the keys and their capacity
+    for (auto& pair : layerToMasks)
+    {
+        pair.second.clear();
+    }
+
+    for (int i = 0; i < layerCount; i++)
+    {
+        if (layers[i].layerType == DARO_TYPE_MASK && layers[i].maskedLayerCount > 0)
+        {
+            int safeCount = (layers[i].maskedLayerCount < DARO_MAX_LAYERS) ? layers[i].maskedLayerCount : DARO_MAX_LAYERS;
+            for (int j = 0; j < safeCount; j++)
+            {
+                int maskedId = layers[i].maskedLayerIds[j];
+                if (maskedId >= 0)
+                    layerToMasks[maskedId].push_back(i);
+            }
+        }
+    }
+}
@@ -0,0 +1,15 @@
+// Engine/LayerMasks.h
+// Per-frame mask lookup: masked layer id -> indices of the mask layers that apply to it.
+// Built from the layer snapshot taken in Daro_Render and consumed by RenderWithMasks.
+// The map is rebuilt in place, so once every id has been seen a frame does not allocate.
+//
+// No Windows or D3D dependencies.
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "SharedTypes.h"
+
+typedef std::unordered_map<int, std::vector<int>> DaroMaskMap;
+
+void DaroBuildMaskMap(const DaroLayer* layers, int layerCount, DaroMaskMap& layerToMasks);
@@ -0,0 +1,41 @@
+// Engine/LayerTransform.h
+// World-view-projection matrix for a layer quad, shared by UpdateConstantBuffer and the
+// microbenchmarks. Header-only so DirectXMath keeps it inline in the draw loop.
+//
+// Depends on DirectXMath only (no D3D device), which also builds on Linux.
+#pragma once
+
+#include <DirectXMath.h>
+#include "SharedTypes.h"
+
+// Scale from center, rotate around the anchor, translate to the layer position (posX/posY
+// are the center in pixels, y down) and project into a viewWidth x viewHeight viewport.
+inline DirectX::XMMATRIX DaroLayerTransform(const DaroLayer* layer, float viewWidth, float viewHeight)
+{
+    using namespace DirectX;
+
+    // Anchor offset for rotation: anchor is 0-1, where 0.5 is center
+    float anchorOffsetX = (layer->anchorX - 0.5f) * layer->sizeX;
+    float anchorOffsetY = (layer->anchorY - 0.5f) * layer->sizeY;
+
+    // Scale from center (position adjustment happens in Designer when size changes)
+    XMMATRIX scale = XMMatrixScaling(layer->sizeX, layer->sizeY, 1.0f);
+
+    // Rotation around anchor point
+    XMMATRIX toAnchor = XMMatrixTranslation(-anchorOffsetX, anchorOffsetY, 0.0f);
+    XMMATRIX rotZ = XMMatrixRotationZ(XMConvertToRadians(layer->rotZ));
+    XMMATRIX rotY = XMMatrixRotationY(XMConvertToRadians(layer->rotY));
+    XMMATRIX rotX = XMMatrixRotationX(XMConvertToRadians(layer->rotX));
+    XMMATRIX fromAnchor = XMMatrixTranslation(anchorOffsetX, -anchorOffsetY, 0.0f);
+
+    // Translate to world position
+    XMMATRIX translation = XMMatrixTranslation(
+        layer->posX - viewWidth * 0.5f,
+        -(layer->posY - viewHeight * 0.5f),
+        0.0f
+    );
+    XMMATRIX projection = XMMatrixOrthographicLH(viewWidth, viewHeight, 0.0f, 1.0f);
+
+    // Transform: scale from center, then rotate around anchor, then translate
+    return scale * toAnchor * rotZ * rotY * rotX * fromAnchor * translation * projection;
+}
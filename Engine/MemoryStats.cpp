@@ -0,0 +1,170 @@
+// Engine/MemoryStats.cpp
+#include "MemoryStats.h"
+#include <climits>
+#include <cstdio>
+#include <Windows.h>
+
+static const char* CategoryName(int category)
+{
+    static const char* const names[DARO_MEM_CATEGORY_COUNT] =
+    {
+        "textures", "video", "Spout input", "Spout output",
+        "render targets", "frame buffer", "frame transport",
+    };
+    return (category >= 0 && category < DARO_MEM_CATEGORY_COUNT) ? names[category] : "total";
+}
+
+DaroMemoryAccountant& DaroMemoryAccountant::Instance()
+{
+    static DaroMemoryAccountant instance;
+    return instance;
+}
+
+DaroMemoryAccountant::Totals* DaroMemoryAccountant::GetTotals(int category)
+{
+    if (category == DARO_MEM_ALL) return &m_Total;
+    if (category < 0 || category >= DARO_MEM_CATEGORY_COUNT) return nullptr;
+    return &m_Categories[category];
+}
+
+void DaroMemoryAccountant::Set(int category, int assetId, long long cpuBytes, long long gpuBytes)
+{
+    if (category < 0 || category >= DARO_MEM_CATEGORY_COUNT) return;
+    if (cpuBytes < 0) cpuBytes = 0;
+    if (gpuBytes < 0) gpuBytes = 0;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Assets.find({ category, assetId });
+    if (it == m_Assets.end())
+    {
+        m_Assets[{ category, assetId }] = { cpuBytes, gpuBytes };
+        Apply(category, cpuBytes, gpuBytes, 1);
+    }
+    else
+    {
+        Apply(category, cpuBytes - it->second.cpuBytes, gpuBytes - it->second.gpuBytes, 0);
+        it->second = { cpuBytes, gpuBytes };
+    }
+}
+
+void DaroMemoryAccountant::Remove(int category, int assetId)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Assets.find({ category, assetId });
+    if (it == m_Assets.end()) return;
+    Apply(category, -it->second.cpuBytes, -it->second.gpuBytes, -1);
+    m_Assets.erase(it);
+}
+
+void DaroMemoryAccountant::RemoveCategory(int category)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Assets.lower_bound({ category, INT_MIN });
+    while (it != m_Assets.end() && it->first.first == category)
+    {
+        Apply(category, -it->second.cpuBytes, -it->second.gpuBytes, -1);
+        it = m_Assets.erase(it);
+    }
+}
+
+void DaroMemoryAccountant::Apply(int category, long long cpuDelta, long long gpuDelta, int assetDelta)
+{
+    // Caller holds m_Mutex
+    Totals* totals[] = { &m_Categories[category], &m_Total };
+    int ids[] = { category, DARO_MEM_ALL };
+    for (int i = 0; i < 2; i++)
+    {
+        totals[i]->assetCount += assetDelta;
+        totals[i]->cpuBytes += cpuDelta;
+        totals[i]->gpuBytes += gpuDelta;
+        UpdatePeaksAndBudget(*totals[i], ids[i]);
+    }
+}
+
+void DaroMemoryAccountant::UpdatePeaksAndBudget(Totals& totals, int category)
+{
+    long long bytes = totals.cpuBytes + totals.gpuBytes;
+    if (totals.cpuBytes > totals.peakCpuBytes) totals.peakCpuBytes = totals.cpuBytes;
+    if (totals.gpuBytes > totals.peakGpuBytes) totals.peakGpuBytes = totals.gpuBytes;
+    if (bytes > totals.peakBytes) totals.peakBytes = bytes;
+
+    bool over = totals.budgetBytes > 0 && bytes > totals.budgetBytes;
+    if (over && !totals.overBudget)
+    {
+        // Warn on the transition only, not on every allocation while over
+        totals.budgetWarnings++;
+        char msg[160];
+        sprintf_s(msg, "[DaroEngine] Memory budget exceeded: %s %lld MB of %lld MB\n",
+            CategoryName(category), bytes >> 20, totals.budgetBytes >> 20);
+        OutputDebugStringA(msg);
+    }
+    totals.overBudget = over;
+}
+
+void DaroMemoryAccountant::SetBudget(int category, long long bytes)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Totals* totals = GetTotals(category);
+    if (!totals) return;
+    totals->budgetBytes = bytes > 0 ? bytes : 0;
+    UpdatePeaksAndBudget(*totals, category);
+}
+
+bool DaroMemoryAccountant::IsOverBudget(int category)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Totals* totals = GetTotals(category);
+    return totals && totals->overBudget;
+}
+
+void DaroMemoryAccountant::ResetPeaks()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (int i = -1; i < DARO_MEM_CATEGORY_COUNT; i++)
+    {
+        Totals* totals = GetTotals(i);
+        totals->peakCpuBytes = totals->cpuBytes;
+        totals->peakGpuBytes = totals->gpuBytes;
+        totals->peakBytes = totals->cpuBytes + totals->gpuBytes;
+        totals->budgetWarnings = 0;
+    }
+}
+
+bool DaroMemoryAccountant::GetStats(int category, DaroMemoryStats* stats)
+{
+    if (!stats) return false;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Totals* totals = GetTotals(category);
+    if (!totals) return false;
+
+    stats->category = category;
+    stats->assetCount = totals->assetCount;
+    stats->cpuBytes = totals->cpuBytes;
+    stats->gpuBytes = totals->gpuBytes;
+    stats->peakCpuBytes = totals->peakCpuBytes;
+    stats->peakGpuBytes = totals->peakGpuBytes;
+    stats->peakBytes = totals->peakBytes;
+    stats->budgetBytes = totals->budgetBytes;
+    stats->overBudget = totals->overBudget ? 1 : 0;
+    stats->budgetWarnings = totals->budgetWarnings;
+    return true;
+}
+
+int DaroMemoryAccountant::GetAssets(int category, DaroMemoryAsset* buffer, int maxCount)
+{
+    if (!buffer || maxCount <= 0) return 0;
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    int count = 0;
+    for (const auto& pair : m_Assets)
+    {
+        if (category != DARO_MEM_ALL && pair.first.first != category) continue;
+        if (count >= maxCount) break;
+        DaroMemoryAsset& asset = buffer[count++];
+        asset.category = pair.first.first;
+        asset.assetId = pair.first.second;
+        asset.cpuBytes = pair.second.cpuBytes;
+        asset.gpuBytes = pair.second.gpuBytes;
+    }
+    return count;
+}
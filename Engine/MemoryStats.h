@@ -0,0 +1,70 @@
+// Engine/MemoryStats.h
+// Central accounting of memory held by the engine.
+// Subsystems report the CPU and GPU bytes of each asset they allocate (a texture id,
+// video id, receiver id, or a fixed id for singletons) and remove it when freed.
+// Byte counts are what the engine asked for - driver padding, decoder internals and
+// D2D/DWrite glyph caches are not visible through the public APIs and are not included.
+//
+// Budgets are per category or total (CPU + GPU). Crossing one logs a warning once and
+// sets an over-budget flag that eviction policies can poll; peaks are kept for soak runs.
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include "SharedTypes.h"
+
+class DaroMemoryAccountant
+{
+public:
+    static DaroMemoryAccountant& Instance();
+
+    // Replace the byte counts of an asset (adds it if new)
+    void Set(int category, int assetId, long long cpuBytes, long long gpuBytes);
+    void Remove(int category, int assetId);
+    void RemoveCategory(int category);
+
+    // category may be DARO_MEM_ALL. 0 disables the budget.
+    void SetBudget(int category, long long bytes);
+    bool IsOverBudget(int category);
+    void ResetPeaks();
+
+    bool GetStats(int category, DaroMemoryStats* stats);
+    int GetAssets(int category, DaroMemoryAsset* buffer, int maxCount);
+
+private:
+    DaroMemoryAccountant() = default;
+
+    struct Totals
+    {
+        int assetCount = 0;
+        long long cpuBytes = 0;
+        long long gpuBytes = 0;
+        long long peakCpuBytes = 0;
+        long long peakGpuBytes = 0;
+        long long peakBytes = 0;
+        long long budgetBytes = 0;
+        int budgetWarnings = 0;
+        bool overBudget = false;
+    };
+
+    struct Asset
+    {
+        long long cpuBytes;
+        long long gpuBytes;
+    };
+
+    Totals* GetTotals(int category);
+    void Apply(int category, long long cpuDelta, long long gpuDelta, int assetDelta);
+    void UpdatePeaksAndBudget(Totals& totals, int category);
+
+    std::mutex m_Mutex;
+    std::map<std::pair<int, int>, Asset> m_Assets;     // (category, assetId)
+    Totals m_Categories[DARO_MEM_CATEGORY_COUNT];
+    Totals m_Total;
+};
+
+inline long long DaroTextureBytes(int width, int height, int bytesPerPixel = 4)
+{
+    return (width > 0 && height > 0) ? (long long)width * height * bytesPerPixel : 0;
+}
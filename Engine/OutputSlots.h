@@ -0,0 +1,51 @@
+// Engine/OutputSlots.h
+// Dropped-frame detection on a fixed output grid. Slots of one frame period are laid on
+// a grid anchored at the first completed frame; every slot that ends without a frame
+// having been completed in it is a dropped frame. Unlike comparing single intervals,
+// jitter that stays within the slots is not counted, and a late frame followed by a
+// quick one still shows the slot that was missed. Slot boundaries are exact for
+// rational rates (TimeBase.h), so the grid does not drift over hours.
+//
+// The first completion is placed in the middle of slot 0, not on its start: completions
+// scatter around the period on both sides, and one that lands early would otherwise
+// fall into the previous slot and count the slot after it as dropped.
+//
+// Header-only like TimeBase.h. No Windows or D3D dependencies.
+#pragma once
+
+#include <cstdint>
+#include "TimeBase.h"
+
+class DaroOutputSlots
+{
+public:
+    // Record a completed frame at nowNs; returns the slots missed since the previous one
+    int64_t Complete(int64_t nowNs, DaroRational rate)
+    {
+        if (rate.num != m_Rate.num || rate.den != m_Rate.den)
+        {
+            m_Rate = rate;
+            m_LastSlot = -1;        // New rate: new grid
+        }
+        if (m_LastSlot < 0)
+        {
+            m_OriginNs = nowNs - DaroFrameToNs(1, rate) / 2;
+            m_LastSlot = 0;
+            return 0;
+        }
+
+        int64_t slot = DaroNsToFrame(nowNs - m_OriginNs, rate);
+        if (slot <= m_LastSlot) return 0;     // Another frame in the same slot
+        int64_t missed = slot - m_LastSlot - 1;
+        m_LastSlot = slot;
+        return missed;
+    }
+
+    // Lay a new grid at the next completion
+    void Reset() { m_LastSlot = -1; }
+
+private:
+    DaroRational m_Rate = { 0, 1 };
+    int64_t m_OriginNs = 0;         // Start of slot 0
+    int64_t m_LastSlot = -1;        // Slot of the last completed frame, -1 = no grid yet
+};
@@ -0,0 +1,172 @@
+// Engine/PixelConvert.cpp
+#include "PixelConvert.h"
+#include <cstring>
+
+// Row kernels. Kept as plain loops over 32-bit words so the compiler can vectorize
+// them on any target (SSE/AVX on x64, NEON on ARM).
+typedef void (*RowKernel)(const uint8_t* src, uint8_t* dst, uint32_t width);
+
+static void RowCopy4(const uint8_t* src, uint8_t* dst, uint32_t width)
+{
+    memcpy(dst, src, (size_t)width * 4);
+}
+
+// BGRA <-> RGBA: swap bytes 0 and 2 of every pixel
+static void RowSwap4(const uint8_t* src, uint8_t* dst, uint32_t width)
+{
+    for (uint32_t x = 0; x < width; x++)
+    {
+        uint32_t p;
+        memcpy(&p, src + x * 4, 4);
+        p = (p & 0xFF00FF00u) | ((p >> 16) & 0x000000FFu) | ((p & 0x000000FFu) << 16);
+        memcpy(dst + x * 4, &p, 4);
+    }
+}
+
+// 4 -> 4 bytes, alpha (byte 3) forced to 0xFF
+static void RowCopyOpaque4(const uint8_t* src, uint8_t* dst, uint32_t width)
+{
+    for (uint32_t x = 0; x < width; x++)
+    {
+        uint32_t p;
+        memcpy(&p, src + x * 4, 4);
+        p |= 0xFF000000u;
+        memcpy(dst + x * 4, &p, 4);
+    }
+}
+
+// 4 -> 3 bytes, same channel order (drop alpha)
+static void RowDropAlpha(const uint8_t* src, uint8_t* dst, uint32_t width)
+{
+    for (uint32_t x = 0; x < width; x++)
+    {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        src += 4;
+        dst += 3;
+    }
+}
+
+// 4 -> 3 bytes, swapped channel order (drop alpha, swap R/B)
+static void RowDropAlphaSwap(const uint8_t* src, uint8_t* dst, uint32_t width)
+{
+    for (uint32_t x = 0; x < width; x++)
+    {
+        dst[0] = src[2];
+        dst[1] = src[1];
+        dst[2] = src[0];
+        src += 4;
+        dst += 3;
+    }
+}
+
+uint32_t DaroPixelBytes(uint32_t format)
+{
+    switch (format)
+    {
+    case DARO_PIXEL_BGRA8:
+    case DARO_PIXEL_RGBA8: return 4;
+    case DARO_PIXEL_BGR8:
+    case DARO_PIXEL_RGB8:  return 3;
+    default:               return 0;
+    }
+}
+
+// Blue first (BGRA/BGR) or red first (RGBA/RGB)
+static bool IsBlueFirst(uint32_t format)
+{
+    return format == DARO_PIXEL_BGRA8 || format == DARO_PIXEL_BGR8;
+}
+
+static RowKernel SelectKernel(uint32_t srcFormat, uint32_t dstFormat)
+{
+    if (DaroPixelBytes(srcFormat) != 4) return nullptr;
+
+    bool swap = IsBlueFirst(srcFormat) != IsBlueFirst(dstFormat);
+    switch (DaroPixelBytes(dstFormat))
+    {
+    case 4: return swap ? RowSwap4 : RowCopy4;
+    case 3: return swap ? RowDropAlphaSwap : RowDropAlpha;
+    default: return nullptr;
+    }
+}
+
+size_t DaroConvertDstSize(const DaroConvertDesc& desc)
+{
+    uint32_t rowBytes = desc.width * DaroPixelBytes(desc.dstFormat);
+    uint32_t stride = desc.dstStride ? desc.dstStride : rowBytes;
+    if (desc.height == 0) return 0;
+    return (size_t)stride * (desc.height - 1) + rowBytes;
+}
+
+bool DaroConvertPixels(const void* src, void* dst, const DaroConvertDesc& desc)
+{
+    if (!src || !dst || desc.width == 0 || desc.height == 0) return false;
+
+    RowKernel kernel = SelectKernel(desc.srcFormat, desc.dstFormat);
+    if (!kernel) return false;
+
+    uint32_t srcRowBytes = desc.width * 4;
+    uint32_t dstRowBytes = desc.width * DaroPixelBytes(desc.dstFormat);
+    uint32_t dstStride = desc.dstStride ? desc.dstStride : dstRowBytes;
+    if (desc.srcStride < srcRowBytes || dstStride < dstRowBytes) return false;
+
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    uint8_t* d = static_cast<uint8_t*>(dst);
+
+    // Straight copy of contiguous rows - one memcpy for the whole image
+    if (kernel == RowCopy4 && !desc.flipVertical &&
+        desc.srcStride == srcRowBytes && dstStride == dstRowBytes)
+    {
+        memcpy(d, s, (size_t)srcRowBytes * desc.height);
+        return true;
+    }
+
+    ptrdiff_t dstStep = (ptrdiff_t)dstStride;
+    if (desc.flipVertical)
+    {
+        d += (size_t)dstStride * (desc.height - 1);
+        dstStep = -dstStep;
+    }
+
+    for (uint32_t y = 0; y < desc.height; y++)
+    {
+        kernel(s, d, desc.width);
+        s += desc.srcStride;
+        d += dstStep;
+    }
+    return true;
+}
+
+void DaroCopyRows(const void* src, size_t srcStride, void* dst, size_t dstStride,
+                  size_t rowBytes, uint32_t rows, bool forceOpaque)
+{
+    if (!src || !dst || rowBytes == 0 || rows == 0) return;
+
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    uint8_t* d = static_cast<uint8_t*>(dst);
+
+    if (!forceOpaque && srcStride == rowBytes && dstStride == rowBytes)
+    {
+        memcpy(d, s, rowBytes * rows);
+        return;
+    }
+
+    uint32_t pixels = (uint32_t)(rowBytes / 4);
+    size_t tailBytes = rowBytes - (size_t)pixels * 4;
+    for (uint32_t y = 0; y < rows; y++)
+    {
+        if (forceOpaque)
+        {
+            RowCopyOpaque4(s, d, pixels);
+            if (tailBytes) memcpy(d + (size_t)pixels * 4, s + (size_t)pixels * 4, tailBytes);
+        }
+        else
+        {
+            memcpy(d, s, rowBytes);
+        }
+        s += srcStride;
+        d += dstStride;
+    }
+}
@@ -0,0 +1,45 @@
+// Engine/PixelConvert.h
+// Single-pass CPU pixel conversion for the shared-memory paths.
+// Pitch removal, vertical flip and channel swizzle are done in one streaming pass
+// from the source pointer (typically a mapped staging texture or a transport slot)
+// into the destination, instead of a copy followed by separate spoutCopy passes.
+// The row kernel is selected once per call from the format descriptor.
+//
+// No Windows or D3D dependencies.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Pixel layouts (byte order in memory)
+#define DARO_PIXEL_BGRA8 0
+#define DARO_PIXEL_RGBA8 1
+#define DARO_PIXEL_BGR8  2
+#define DARO_PIXEL_RGB8  3
+
+struct DaroConvertDesc
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t srcFormat;     // DARO_PIXEL_BGRA8 or DARO_PIXEL_RGBA8
+    uint32_t srcStride;     // Bytes per source row (may include padding)
+    uint32_t dstFormat;     // Any DARO_PIXEL_*
+    uint32_t dstStride;     // Bytes per destination row, 0 = tightly packed
+    bool flipVertical;      // Write source row 0 to the last destination row
+};
+
+// Bytes per pixel for a layout (0 if unknown)
+uint32_t DaroPixelBytes(uint32_t format);
+
+// Destination buffer size required for desc
+size_t DaroConvertDstSize(const DaroConvertDesc& desc);
+
+// Convert in one pass. Returns false for unsupported formats or strides too small
+// for the width. Source and destination must not overlap.
+bool DaroConvertPixels(const void* src, void* dst, const DaroConvertDesc& desc);
+
+// Copy rowBytes from each of rows rows between buffers with their own strides
+// (a single memcpy when both are contiguous). With forceOpaque the alpha byte of every
+// 4-byte pixel is set to 0xFF in the same pass, for video formats without alpha.
+void DaroCopyRows(const void* src, size_t srcStride, void* dst, size_t dstStride,
+                  size_t rowBytes, uint32_t rows, bool forceOpaque = false);
@@ -0,0 +1,473 @@
+// Engine/RenderLoop.cpp
+#include "RenderLoop.h"
+#include "Clock.h"
+#include <chrono>
+#include <cmath>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <objbase.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+// Busy-wait margin when only a regular (timer-resolution) waitable timer is available
+#define DARO_RENDER_LOOP_COARSE_SPIN_NS 2000000
+
+// Genlock loop gains: proportional on the phase error, integral into the per-frame trim.
+// Critically damped enough to pull in without ringing through the slew limit.
+#define DARO_GENLOCK_KP 0.125
+#define DARO_GENLOCK_KI (1.0 / 64.0)
+
+static int64_t SteadyNow()
+{
+    return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+DaroRenderLoop::~DaroRenderLoop()
+{
+    Stop();
+}
+
+bool DaroRenderLoop::Start(DaroRational rate, FrameFunc frame)
+{
+    std::lock_guard<std::mutex> lock(m_StartMutex);
+    if (!DaroRationalIsValid(rate) || !frame) return false;
+    if (m_Thread.joinable())
+    {
+        if (m_Running.load(std::memory_order_acquire)) return false;
+        m_Thread.join();    // Ended on its own (frame returned false)
+    }
+
+#ifdef _WIN32
+    if (!m_Timer)
+    {
+        m_SpinNs = DARO_RENDER_LOOP_SPIN_NS;
+        m_Timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (!m_Timer)
+        {
+            // Before Windows 10 1803: regular timer, longer spin
+            m_SpinNs = DARO_RENDER_LOOP_COARSE_SPIN_NS;
+            m_Timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+        }
+    }
+    if (!m_StopEvent)
+        m_StopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (m_StopEvent) ResetEvent(m_StopEvent);
+#endif
+
+    {
+        // The loop thread reopens the reference and starts the genlock over
+        std::lock_guard<std::mutex> externalLock(m_ExternalMutex);
+        m_ReaderGeneration = UINT64_MAX;
+    }
+    m_Rate = rate;
+    {
+        std::lock_guard<std::mutex> rateLock(m_RateMutex);
+        m_RateChanged = false;
+    }
+    m_Fps.store(DaroRationalToDouble(rate), std::memory_order_relaxed);
+    m_Frame = std::move(frame);
+    m_WakeLate.Clear();
+    m_Frames.store(0, std::memory_order_relaxed);
+    m_MissedDeadlines.store(0, std::memory_order_relaxed);
+    m_LastFrameNs.store(0, std::memory_order_relaxed);
+    m_MaxFrameNs.store(0, std::memory_order_relaxed);
+    m_StopRequested.store(false, std::memory_order_relaxed);
+    m_Running.store(true, std::memory_order_release);
+    m_Thread = std::thread(&DaroRenderLoop::ThreadProc, this);
+    return true;
+}
+
+void DaroRenderLoop::Stop()
+{
+    std::lock_guard<std::mutex> lock(m_StartMutex);
+    m_StopRequested.store(true, std::memory_order_release);
+#ifdef _WIN32
+    if (m_StopEvent) SetEvent(m_StopEvent);
+#endif
+    {
+        // Overrides any hold the loop is waiting on
+        std::lock_guard<std::mutex> holdLock(m_HoldMutex);
+    }
+    m_HoldChanged.notify_all();
+    if (m_Thread.joinable())
+        m_Thread.join();
+    m_Frame = nullptr;
+
+#ifdef _WIN32
+    if (m_Timer)
+    {
+        CloseHandle(m_Timer);
+        m_Timer = nullptr;
+    }
+    if (m_StopEvent)
+    {
+        CloseHandle(m_StopEvent);
+        m_StopEvent = nullptr;
+    }
+#endif
+}
+
+bool DaroRenderLoop::SetRate(DaroRational rate)
+{
+    if (!DaroRationalIsValid(rate)) return false;
+    std::lock_guard<std::mutex> lock(m_RateMutex);
+    m_PendingRate = rate;
+    m_RateChanged = true;
+    return true;
+}
+
+void DaroRenderLoop::Hold()
+{
+    std::unique_lock<std::mutex> lock(m_HoldMutex);
+    m_Holds++;
+    m_HoldChanged.wait(lock, [this] { return !m_InFrame; });
+}
+
+void DaroRenderLoop::Release()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_HoldMutex);
+        if (m_Holds > 0) m_Holds--;
+    }
+    m_HoldChanged.notify_all();
+}
+
+bool DaroRenderLoop::WaitUntil(int64_t deadlineNs)
+{
+    for (;;)
+    {
+        if (m_StopRequested.load(std::memory_order_acquire)) return false;
+
+        int64_t now = SteadyNow();
+        int64_t remaining = deadlineNs - now;
+        if (remaining <= 0) return true;
+        if (remaining <= m_SpinNs)
+        {
+            while (SteadyNow() < deadlineNs)
+            {
+#ifdef _WIN32
+                YieldProcessor();
+#else
+                std::this_thread::yield();
+#endif
+            }
+            return true;
+        }
+
+        // Wake m_SpinNs early and spin the rest; long waits go in slices
+        int64_t sleepNs = remaining - m_SpinNs;
+        if (sleepNs > DARO_RENDER_LOOP_SLICE_NS) sleepNs = DARO_RENDER_LOOP_SLICE_NS;
+#ifdef _WIN32
+        LARGE_INTEGER due;
+        due.QuadPart = -(sleepNs / 100);    // Relative, in 100 ns units
+        if (m_Timer && m_StopEvent && SetWaitableTimer(m_Timer, &due, 0, nullptr, nullptr, FALSE))
+        {
+            HANDLE handles[2] = { m_StopEvent, m_Timer };
+            WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+        }
+        else
+        {
+            Sleep((DWORD)(sleepNs / 1000000));
+        }
+#else
+        // steady_clock is CLOCK_MONOTONIC, so the deadline can be passed as an absolute time
+        int64_t wakeNs = now + sleepNs;
+        timespec wake;
+        wake.tv_sec = (time_t)(wakeNs / 1000000000);
+        wake.tv_nsec = (long)(wakeNs % 1000000000);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr);   // EINTR: loop again
+#endif
+    }
+}
+
+void DaroRenderLoop::ThreadProc()
+{
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+    // Media Foundation video updates run inside the frame
+    HRESULT hrCom = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#else
+    // Real-time scheduling needs CAP_SYS_NICE; the loop runs at normal priority without it
+    sched_param param = {};
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+#endif
+
+    DaroRational rate = m_Rate;
+    DaroClock& clock = DaroClock::Instance();
+    int64_t originNs = 0;           // Deadline of slot 0 on the steady clock
+    int64_t shiftNs = 0;            // Genlock corrections to the grid
+    long long slot = 0;
+    bool anchored = false;
+
+    while (!m_StopRequested.load(std::memory_order_acquire))
+    {
+        {
+            std::lock_guard<std::mutex> rateLock(m_RateMutex);
+            if (m_RateChanged)
+            {
+                m_RateChanged = false;
+                if (anchored)
+                {
+                    // Rebase at the deadline the next frame already had
+                    originNs += shiftNs + DaroFrameToNs(slot, rate);
+                    shiftNs = 0;
+                    slot = 0;
+                }
+                rate = m_PendingRate;
+                m_Fps.store(DaroRationalToDouble(rate), std::memory_order_relaxed);
+                // The genlock trim is per period: start it over at the new rate
+                std::lock_guard<std::mutex> externalLock(m_ExternalMutex);
+                m_ReaderGeneration = UINT64_MAX;
+            }
+        }
+
+        bool virtualClock = clock.IsVirtual();
+        m_Virtual.store(virtualClock, std::memory_order_relaxed);
+        if (virtualClock)
+        {
+            anchored = false;       // Lay a new deadline grid when real time resumes
+        }
+        else
+        {
+            if (!anchored)
+            {
+                originNs = SteadyNow();
+                shiftNs = 0;
+                slot = 0;
+                anchored = true;
+            }
+            int64_t deadlineNs = originNs + shiftNs + DaroFrameToNs(slot, rate);
+            if (!WaitUntil(deadlineNs)) break;
+            int64_t lateNs = SteadyNow() - deadlineNs;
+            m_WakeLate.Record(lateNs > 0 ? (uint64_t)(lateNs / 1000) : 0);
+            shiftNs += Genlock(deadlineNs, rate);
+        }
+
+        {
+            std::unique_lock<std::mutex> holdLock(m_HoldMutex);
+            m_HoldChanged.wait(holdLock, [this] {
+                return m_Holds == 0 || m_StopRequested.load(std::memory_order_acquire);
+            });
+            if (m_StopRequested.load(std::memory_order_acquire)) break;
+            m_InFrame = true;
+        }
+
+        int64_t startNs = SteadyNow();
+        bool keepRunning = m_Frame();
+        int64_t endNs = SteadyNow();
+        {
+            std::lock_guard<std::mutex> holdLock(m_HoldMutex);
+            m_InFrame = false;
+        }
+        m_HoldChanged.notify_all();
+
+        int64_t frameNs = endNs - startNs;
+        m_LastFrameNs.store(frameNs, std::memory_order_relaxed);
+        if (frameNs > m_MaxFrameNs.load(std::memory_order_relaxed))
+            m_MaxFrameNs.store(frameNs, std::memory_order_relaxed);
+        m_Frames.fetch_add(1, std::memory_order_relaxed);
+        if (!keepRunning) break;
+
+        if (virtualClock)
+        {
+            clock.AdvanceFraction(DARO_NS_PER_SECOND * rate.den, rate.num);
+            std::this_thread::yield();  // Let host threads in between frames
+            continue;
+        }
+
+        // A frame that ends past the next deadline starts the next one right away; once
+        // a whole period behind, skip to the deadline that passed most recently
+        slot++;
+        long long current = DaroNsToFrame(endNs - originNs - shiftNs, rate);
+        if (current > slot)
+        {
+            m_MissedDeadlines.fetch_add(current - slot, std::memory_order_relaxed);
+            slot = current;
+        }
+    }
+
+#ifdef _WIN32
+    if (hrCom == S_OK) CoUninitialize();
+#endif
+    m_Running.store(false, std::memory_order_release);
+}
+
+void DaroRenderLoop::GetStats(DaroRenderLoopStats* stats) const
+{
+    if (!stats) return;
+    DaroTimingSummary wake;
+    m_WakeLate.Summarize(&wake);
+
+    stats->running = IsRunning() ? 1 : 0;
+    stats->virtualClock = m_Virtual.load(std::memory_order_relaxed) ? 1 : 0;
+    stats->fps = m_Fps.load(std::memory_order_relaxed);
+    stats->frames = m_Frames.load(std::memory_order_relaxed);
+    stats->missedDeadlines = m_MissedDeadlines.load(std::memory_order_relaxed);
+    stats->wakeLateMeanMs = wake.meanMs;
+    stats->wakeLateP99Ms = wake.p99Ms;
+    stats->wakeLateMaxMs = wake.maxMs;
+    stats->lastFrameMs = (double)m_LastFrameNs.load(std::memory_order_relaxed) / 1e6;
+    stats->maxFrameMs = (double)m_MaxFrameNs.load(std::memory_order_relaxed) / 1e6;
+}
+
+bool DaroRenderLoop::SetExternalClock(const char* name)
+{
+    std::string value = name ? name : "";
+    {
+        std::lock_guard<std::mutex> lock(m_ExternalMutex);
+        m_ExternalName = value;
+        m_ExternalGeneration++;
+    }
+    SetGenlockState(value.empty() ? DARO_GENLOCK_FREE_RUN : DARO_GENLOCK_NO_REFERENCE);
+    if (value.empty()) return true;
+
+    DaroTickReader probe;
+    return probe.Open(value.c_str());
+}
+
+void DaroRenderLoop::SetGenlockState(int state)
+{
+    m_GenlockState.store(state, std::memory_order_relaxed);
+}
+
+int64_t DaroRenderLoop::Genlock(int64_t deadlineNs, DaroRational rate)
+{
+    std::string name;
+    bool changed = false;
+    {
+        std::lock_guard<std::mutex> lock(m_ExternalMutex);
+        if (m_ReaderGeneration != m_ExternalGeneration)
+        {
+            m_ReaderGeneration = m_ExternalGeneration;
+            changed = true;
+        }
+        name = m_ExternalName;
+    }
+    if (changed)
+    {
+        m_TickReader.Close();
+        m_ReopenNs = 0;
+        m_Acquired = false;
+        m_TrimNs = 0.0;
+        m_CorrectionCarryNs = 0.0;
+        m_PhaseError.Clear();
+        m_Ticks.store(0, std::memory_order_relaxed);
+        m_Relocks.store(0, std::memory_order_relaxed);
+        m_ReferenceLost.store(0, std::memory_order_relaxed);
+        m_ReferenceFps.store(0.0, std::memory_order_relaxed);
+        m_CorrectionPpm.store(0.0, std::memory_order_relaxed);
+        m_LastPhaseErrorNs.store(0, std::memory_order_relaxed);
+    }
+    if (name.empty())
+    {
+        SetGenlockState(DARO_GENLOCK_FREE_RUN);
+        return 0;
+    }
+    if (!m_TickReader.IsOpen() && deadlineNs >= m_ReopenNs)
+    {
+        m_ReopenNs = deadlineNs + DARO_GENLOCK_REOPEN_NS;
+        m_TickReader.Open(name.c_str());
+    }
+
+    const double periodNs = (double)DARO_NS_PER_SECOND * (double)rate.den / (double)rate.num;
+    const double maxSlewNs = periodNs * DARO_GENLOCK_MAX_SLEW;
+    uint64_t count = 0;
+    int64_t tickNs = 0;
+    bool read = m_TickReader.IsOpen() && m_TickReader.Read(&count, &tickNs);
+    bool live = read && (double)(deadlineNs - tickNs) < periodNs * DARO_GENLOCK_LOST_PERIODS;
+
+    double correctionNs;
+    if (!live)
+    {
+        // Hold the last rate
+        if (m_Acquired)
+        {
+            m_Acquired = false;
+            m_ReferenceLost.fetch_add(1, std::memory_order_relaxed);
+        }
+        // A writer that stopped or went stale may come back in a new block under the same
+        // name, so let go of this one and look for it again. One that has not ticked yet
+        // (it was started just before the loop) is kept.
+        if (m_TickReader.IsOpen() &&
+            (!m_TickReader.IsLive() || (read && deadlineNs - tickNs > DARO_TICK_STALE_NS)))
+        {
+            m_TickReader.Close();
+            m_ReopenNs = deadlineNs + DARO_GENLOCK_REOPEN_NS;
+        }
+        SetGenlockState(DARO_GENLOCK_NO_REFERENCE);
+        correctionNs = -m_TrimNs;
+    }
+    else
+    {
+        m_Ticks.store((long long)count, std::memory_order_relaxed);
+
+        // Phase against the reference tick nearest to the deadline, in (-period/2, period/2]
+        double offsetNs = (double)(deadlineNs - tickNs);
+        double errorNs = offsetNs - std::floor(offsetNs / periodNs + 0.5) * periodNs;
+        m_LastPhaseErrorNs.store((int64_t)errorNs, std::memory_order_relaxed);
+
+        if (!m_Acquired || std::fabs(errorNs) > periodNs / 4.0)
+        {
+            // Acquisition or a phase jump in the reference: re-anchor at once. The trim
+            // is kept; it still describes the frequency offset.
+            m_Acquired = true;
+            m_Relocks.fetch_add(1, std::memory_order_relaxed);
+            m_RefCount0 = count;
+            m_RefNs0 = tickNs;
+            SetGenlockState(DARO_GENLOCK_ACQUIRING);
+            correctionNs = -errorNs;
+        }
+        else
+        {
+            m_PhaseError.Record((uint64_t)(std::fabs(errorNs) / 1000.0));
+            // Integrate only while the output is not slew-limited, so a long pull-in
+            // does not wind the trim up and overshoot
+            double output = errorNs * DARO_GENLOCK_KP + m_TrimNs;
+            if (std::fabs(output) < maxSlewNs)
+                m_TrimNs += errorNs * DARO_GENLOCK_KI;
+            if (output > maxSlewNs) output = maxSlewNs;
+            if (output < -maxSlewNs) output = -maxSlewNs;
+            SetGenlockState(std::fabs(errorNs) < DARO_GENLOCK_LOCKED_NS ? DARO_GENLOCK_LOCKED : DARO_GENLOCK_ACQUIRING);
+            correctionNs = -output;
+        }
+
+        if (count > m_RefCount0 && tickNs > m_RefNs0)
+        {
+            m_ReferenceFps.store((double)(count - m_RefCount0) * 1e9 / (double)(tickNs - m_RefNs0),
+                                 std::memory_order_relaxed);
+        }
+    }
+    m_CorrectionPpm.store(m_TrimNs / periodNs * 1e6, std::memory_order_relaxed);
+
+    double total = correctionNs + m_CorrectionCarryNs;
+    int64_t whole = (int64_t)total;
+    m_CorrectionCarryNs = total - (double)whole;
+    return whole;
+}
+
+void DaroRenderLoop::GetGenlockStats(DaroGenlockStats* stats) const
+{
+    if (!stats) return;
+    DaroTimingSummary phase;
+    m_PhaseError.Summarize(&phase);
+
+    stats->state = m_GenlockState.load(std::memory_order_relaxed);
+    stats->ticks = m_Ticks.load(std::memory_order_relaxed);
+    stats->relocks = m_Relocks.load(std::memory_order_relaxed);
+    stats->referenceLost = m_ReferenceLost.load(std::memory_order_relaxed);
+    stats->referenceFps = m_ReferenceFps.load(std::memory_order_relaxed);
+    stats->correctionPpm = m_CorrectionPpm.load(std::memory_order_relaxed);
+    stats->phaseErrorMs = (double)m_LastPhaseErrorNs.load(std::memory_order_relaxed) / 1e6;
+    stats->phaseErrorMeanMs = phase.meanMs;
+    stats->phaseErrorP99Ms = phase.p99Ms;
+    stats->phaseErrorMaxMs = phase.maxMs;
+}
@@ -0,0 +1,143 @@
+// Engine/RenderLoop.h
+// Native render loop (Daro_StartRenderLoop). A high-priority thread runs one frame per
+// period on a grid of absolute deadlines (exact for rational rates, TimeBase.h), so a
+// slow frame or a late wake-up does not shift every frame after it the way "sleep for
+// the period" pacing does. Waits use a
+// high-resolution waitable timer on Windows and clock_nanosleep(TIMER_ABSTIME) elsewhere,
+// then spin for the last stretch. A frame that finishes a full period late skips the
+// deadlines it missed instead of rendering a burst to catch up.
+//
+// With an external clock (ExternalClock.h) the deadline grid is genlocked: each frame the
+// deadline is compared with the nearest reference tick and the grid is steered toward it
+// by a proportional-integral loop, a few microseconds per frame, so frame pacing stays
+// smooth while following the reference's drift. Phase jumps of more than a quarter period
+// re-anchor the grid at once; if the reference stops, the loop holds its last rate.
+// The reference must tick at the loop rate or an integer fraction of it.
+//
+// Hosts can hold the loop off between frames (Hold/Release) to land a batch of updates
+// in one frame. Holds are counted, so any thread may release them, and Stop does not
+// wait for them.
+//
+// While the engine clock is virtual (Clock.h) the loop does not wait: every frame
+// advances the clock by one period, so rendering runs as fast as frames complete.
+//
+// No D3D dependencies; the engine supplies the frame.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "ExternalClock.h"
+#include "Histogram.h"
+#include "SharedTypes.h"
+#include "TimeBase.h"
+
+#define DARO_RENDER_LOOP_SPIN_NS    500000      // Busy-wait this close to a deadline
+#define DARO_RENDER_LOOP_SLICE_NS   50000000    // Longest single wait, so Stop stays responsive
+
+#define DARO_GENLOCK_LOCKED_NS      100000      // Phase error counted as locked
+#define DARO_GENLOCK_LOST_PERIODS   4           // No tick for this long: reference lost
+#define DARO_GENLOCK_MAX_SLEW       0.001       // Largest correction per frame, as a fraction of the period
+#define DARO_GENLOCK_REOPEN_NS      1000000000  // Retry a missing reference block this often
+
+class DaroRenderLoop
+{
+public:
+    // One frame on the loop thread; return false to end the loop (e.g. device lost)
+    using FrameFunc = std::function<bool()>;
+
+    DaroRenderLoop() = default;
+    ~DaroRenderLoop();
+
+    DaroRenderLoop(const DaroRenderLoop&) = delete;
+    DaroRenderLoop& operator=(const DaroRenderLoop&) = delete;
+
+    // Fails if the loop is already running or the rate is not valid
+    bool Start(DaroRational rate, FrameFunc frame);
+    // Waits for the current frame to finish. Not from the frame function.
+    void Stop();
+    bool IsRunning() const { return m_Running.load(std::memory_order_acquire); }
+
+    // Change the rate of a running loop. The next frame keeps its deadline on the old
+    // grid; the grid is laid again from there at the new period. Any thread.
+    bool SetRate(DaroRational rate);
+
+    // Keep the loop from starting another frame until the matching Release. Waits for a
+    // frame in progress to finish. Any thread but the frame function's; a hold taken
+    // while the loop is stopped applies once it runs.
+    void Hold();
+    void Release();
+
+    // Any thread
+    void GetStats(DaroRenderLoopStats* stats) const;
+
+    // Genlock to the tick block of that name; null or empty returns to free-running.
+    // Applies to a running loop from its next frame. A block that does not exist yet is
+    // looked for again every second; returns whether it could be opened now.
+    bool SetExternalClock(const char* name);
+    void GetGenlockStats(DaroGenlockStats* stats) const;
+
+private:
+    void ThreadProc();
+    // Sleep until deadlineNs on the steady clock; false if Stop was requested first
+    bool WaitUntil(int64_t deadlineNs);
+    // Measure the phase of a frame deadline against the reference and return the shift
+    // for the deadlines after it. Loop thread only.
+    int64_t Genlock(int64_t deadlineNs, DaroRational rate);
+    void SetGenlockState(int state);
+
+    std::thread m_Thread;
+    std::mutex m_StartMutex;                    // Serializes Start and Stop
+    std::atomic<bool> m_Running{ false };       // Cleared by the thread when it ends
+    std::atomic<bool> m_StopRequested{ false };
+    FrameFunc m_Frame;
+    DaroRational m_Rate = { 0, 1 };             // Set before the thread starts
+    std::mutex m_RateMutex;                     // Guards the two below
+    DaroRational m_PendingRate = { 0, 1 };      // SetRate, taken by the loop thread
+    bool m_RateChanged = false;
+    std::atomic<double> m_Fps{ 0.0 };           // For stats
+    std::mutex m_HoldMutex;                     // Guards the two below
+    std::condition_variable m_HoldChanged;      // Hold count, frame end or stop
+    int m_Holds = 0;
+    bool m_InFrame = false;
+    int64_t m_SpinNs = DARO_RENDER_LOOP_SPIN_NS;
+#ifdef _WIN32
+    void* m_Timer = nullptr;                    // Waitable timer HANDLE
+    void* m_StopEvent = nullptr;                // Wakes a timer wait on Stop
+#endif
+
+    // Stats: written by the loop thread only
+    DaroHistogram m_WakeLate;                   // Microseconds after the deadline
+    std::atomic<long long> m_Frames{ 0 };
+    std::atomic<long long> m_MissedDeadlines{ 0 };
+    std::atomic<int64_t> m_LastFrameNs{ 0 };
+    std::atomic<int64_t> m_MaxFrameNs{ 0 };
+    std::atomic<bool> m_Virtual{ false };
+
+    // External clock: the name is set from any thread, everything else belongs to the loop thread
+    mutable std::mutex m_ExternalMutex;
+    std::string m_ExternalName;
+    uint64_t m_ExternalGeneration = 0;          // Bumped by SetExternalClock
+    uint64_t m_ReaderGeneration = 0;            // Generation m_TickReader was opened for
+    DaroTickReader m_TickReader;
+    int64_t m_ReopenNs = 0;                     // Next attempt to open a missing block
+    bool m_Acquired = false;                    // Grid anchored to the reference
+    double m_TrimNs = 0.0;                      // Integral term: per-frame period correction
+    double m_CorrectionCarryNs = 0.0;           // Sub-nanosecond part of the corrections
+    uint64_t m_RefCount0 = 0;                   // First tick since the last relock, for referenceFps
+    int64_t m_RefNs0 = 0;
+
+    // Genlock stats
+    DaroHistogram m_PhaseError;                 // Absolute, microseconds
+    std::atomic<int> m_GenlockState{ DARO_GENLOCK_FREE_RUN };
+    std::atomic<long long> m_Ticks{ 0 };
+    std::atomic<long long> m_Relocks{ 0 };
+    std::atomic<long long> m_ReferenceLost{ 0 };
+    std::atomic<double> m_ReferenceFps{ 0.0 };
+    std::atomic<double> m_CorrectionPpm{ 0.0 };
+    std::atomic<int64_t> m_LastPhaseErrorNs{ 0 };
+};
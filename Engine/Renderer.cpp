@@ -1,8 +1,18 @@
 // Engine/Renderer.cpp
 #include "Renderer.h"
+#include "FrameStats.h"
+#include "LayerTransform.h"
+#include "MemoryStats.h"
+#include "Trace.h"
+#include <d3d11_4.h>     // ID3D11Multithread
 #include <algorithm>
 #include <Windows.h>
 
+// Scene transition compositor, compiled at build time by FxCompile (Shaders\*.hlsl,
+// DaroEngine.vcxproj) into $(IntDir)
+#include "TransitionVS.h"     // g_TransitionVS
+#include "TransitionPS.h"     // g_TransitionPS
+
 #pragma comment(lib, "windowscodecs.lib")
 #pragma comment(lib, "d2d1.lib")
 #pragma comment(lib, "dwrite.lib")
@@ -67,6 +77,22 @@ float4 PS(PS_INPUT input) : SV_Target
 }
 )";
 
+// Asset ids within DARO_MEM_RENDER_TARGETS
+enum { MEM_ASSET_RENDER_TARGET = 0, MEM_ASSET_DEPTH_STENCIL = 1, MEM_ASSET_STAGING = 2, MEM_ASSET_PREVIEW = 3,
+       MEM_ASSET_TRANSITION = 4 };
+
+// Bytes per pixel of the formats Spout senders use
+static int BytesPerPixel(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_R32G32B32A32_FLOAT: return 16;
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        case DXGI_FORMAT_R16G16B16A16_UNORM: return 8;
+        default: return 4;
+    }
+}
+
 DaroRenderer::DaroRenderer() {}
 DaroRenderer::~DaroRenderer() { Shutdown(); }
 
@@ -86,6 +112,13 @@ int DaroRenderer::Initialize(int width, int height)
     if (!InitWIC()) return DARO_ERROR_CREATE_DEVICE;
     if (!InitDirect2D()) return DARO_ERROR_CREATE_DEVICE;
 
+    // Render target and D24S8 depth-stencil on the GPU, readback staging in system memory
+    // (the MSAA target aliases the render target)
+    DaroMemoryAccountant& memory = DaroMemoryAccountant::Instance();
+    memory.Set(DARO_MEM_RENDER_TARGETS, MEM_ASSET_RENDER_TARGET, 0, DaroTextureBytes(m_Width, m_Height));
+    memory.Set(DARO_MEM_RENDER_TARGETS, MEM_ASSET_DEPTH_STENCIL, 0, DaroTextureBytes(m_Width, m_Height) * m_MSAASampleCount);
+    memory.Set(DARO_MEM_RENDER_TARGETS, MEM_ASSET_STAGING, DaroTextureBytes(m_Width, m_Height), 0);
+
     // Initialize Spout sender with device
     m_SpoutSender.OpenDirectX11(m_Device.Get());
 
@@ -103,6 +136,8 @@ int DaroRenderer::Initialize(int width, int height)
 void DaroRenderer::Shutdown()
 {
     DisableSpout();
+    DisablePreview();
+    ReleaseTransitionTargets();
 
     // Shutdown video manager
     VideoManager::Instance().Shutdown();
@@ -114,6 +149,7 @@ void DaroRenderer::Shutdown()
         pair.second.receiver.CloseDirectX11();
     }
     m_SpoutReceivers.clear();
+    DaroMemoryAccountant::Instance().RemoveCategory(DARO_MEM_SPOUT_INPUT);
 
     m_SpoutSender.CloseDirectX11();
 
@@ -129,6 +165,8 @@ void DaroRenderer::Shutdown()
     m_D2DFactory.Reset();
 
     m_Textures.clear();
+    DaroMemoryAccountant::Instance().RemoveCategory(DARO_MEM_TEXTURES);
+    DaroMemoryAccountant::Instance().RemoveCategory(DARO_MEM_RENDER_TARGETS);
     m_WICFactory.Reset();
     m_Sampler.Reset();
     m_SamplerHighQuality.Reset();
@@ -174,8 +212,10 @@ bool DaroRenderer::InitDirect2D()
 #ifdef _DEBUG
     options.debugLevel = D2D1_DEBUG_LEVEL_INFORMATION;
 #endif
+    // Multi-threaded: the Spout send thread copies through the immediate context D2D draws
+    // into, and serializes against D2D with the factory's ID2D1Multithread lock
     HRESULT hr = D2D1CreateFactory(
-        D2D1_FACTORY_TYPE_SINGLE_THREADED,
+        D2D1_FACTORY_TYPE_MULTI_THREADED,
         __uuidof(ID2D1Factory1),
         &options,
         reinterpret_cast<void**>(m_D2DFactory.GetAddressOf())
@@ -285,6 +325,11 @@ bool DaroRenderer::CreateDevice()
         if (FAILED(hr)) return false;
         OutputDebugStringA("[DaroEngine] WARNING: Running on WARP software renderer - reduced performance\n");
     }
+
+    // The Spout output thread shares the immediate context with the render thread
+    ComPtr<ID3D11Multithread> multithread;
+    if (SUCCEEDED(m_Context.As(&multithread)))
+        multithread->SetMultithreadProtected(TRUE);
     
     return true;
 }
@@ -375,6 +420,15 @@ bool DaroRenderer::CreateShaders()
     cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
     
     if (FAILED(m_Device->CreateBuffer(&cbDesc, nullptr, &m_ConstantBuffer))) return false;
+
+    // Transition compositor (precompiled)
+    if (FAILED(m_Device->CreateVertexShader(g_TransitionVS, sizeof(g_TransitionVS),
+        nullptr, &m_TransitionVS))) return false;
+    if (FAILED(m_Device->CreatePixelShader(g_TransitionPS, sizeof(g_TransitionPS),
+        nullptr, &m_TransitionPS))) return false;
+
+    cbDesc.ByteWidth = sizeof(CBTransition);
+    if (FAILED(m_Device->CreateBuffer(&cbDesc, nullptr, &m_TransitionCB))) return false;
     
     D3D11_BLEND_DESC blendDesc = {};
     blendDesc.RenderTarget[0].BlendEnable = TRUE;
@@ -599,38 +653,54 @@ bool DaroRenderer::CheckDeviceLost()
     return m_DeviceLost;
 }
 
-void DaroRenderer::BeginFrame()
+void DaroRenderer::BeginFrame(const DaroLayer* layers, int layerCount,
+                              const DaroLayer* otherLayers, int otherCount)
 {
     // Check for GPU device lost at start of each frame
     if (CheckDeviceLost()) return;
 
+    BindFrameState();
+    m_TransitionFromValid = false;
+
+    // Update Spout receivers referenced by the current layers
+    {
+        DaroScopedStage stage(DARO_STAGE_SPOUT_RECEIVE);
+        UpdateSpoutReceivers(layers, layerCount, otherLayers, otherCount);
+    }
+
+    // Update video frames
+    {
+        DaroScopedStage stage(DARO_STAGE_VIDEO_DECODE);
+        UpdateVideos();
+    }
+}
+
+void DaroRenderer::BindFrameState()
+{
     // Reset state cache at start of frame
     ResetStateCache();
 
     // Use single render target with depth-stencil
     m_Context->OMSetRenderTargets(1, m_RTV.GetAddressOf(), m_DepthStencilView.Get());
+    m_CostCounters.stateChanges++;
 
     // Cache blend and depth-stencil state
     if (m_CachedState.blendState != m_BlendState.Get())
     {
         m_Context->OMSetBlendState(m_BlendState.Get(), nullptr, 0xFFFFFFFF);
+        m_CostCounters.stateChanges++;
         m_CachedState.blendState = m_BlendState.Get();
     }
     if (m_CachedState.depthStencilState != m_DSState_Disabled.Get())
     {
         m_Context->OMSetDepthStencilState(m_DSState_Disabled.Get(), 0);
+        m_CostCounters.stateChanges++;
         m_CachedState.depthStencilState = m_DSState_Disabled.Get();
         m_CachedState.depthStencilRef = 0;
     }
 
     // Bind common state once per frame
     BindCommonState();
-
-    // Update Spout receivers
-    UpdateSpoutReceivers();
-
-    // Update video frames
-    UpdateVideos();
 }
 
 void DaroRenderer::Clear(float r, float g, float b, float a)
@@ -696,6 +766,7 @@ void DaroRenderer::RenderRectangle(const DaroLayer* layer)
         }
     }
 
+    m_CostCounters.paths |= DARO_COST_PATH_QUAD;
     UpdateConstantBuffer(layer, hasTexture);
 
     // Use cached state - only set SRV if changed
@@ -704,25 +775,31 @@ void DaroRenderer::RenderRectangle(const DaroLayer* layer)
         if (srv)
         {
             m_Context->PSSetShaderResources(0, 1, &srv);
+            m_CostCounters.stateChanges++;
         }
         else
         {
             ID3D11ShaderResourceView* nullSRV = nullptr;
             m_Context->PSSetShaderResources(0, 1, &nullSRV);
+            m_CostCounters.stateChanges++;
         }
         m_CachedState.srv = srv;
     }
 
     m_Context->DrawIndexed(6, 0, 0);
+    m_CostCounters.drawCalls++;
 }
 
 void DaroRenderer::RenderCircle(const DaroLayer* layer)
 {
     if (!m_D2DRenderTarget) return;
+    m_CostCounters.paths |= DARO_COST_PATH_D2D_CIRCLE;
 
     // Unbind depth-stencil for D2D interop (D2D and depth-stencil don't mix)
     m_Context->OMSetRenderTargets(1, m_RTV.GetAddressOf(), nullptr);
+    m_CostCounters.stateChanges++;
     m_Context->Flush();
+    m_CostCounters.flushes++;
 
     // Use cached brush - create only if needed, update color if changed
     D2D1_COLOR_F color = D2D1::ColorF(
@@ -761,6 +838,7 @@ void DaroRenderer::RenderCircle(const DaroLayer* layer)
     m_D2DRenderTarget->FillEllipse(ellipse, m_CachedShapeBrush.Get());
 
     HRESULT hrEnd = m_D2DRenderTarget->EndDraw();
+    m_CostCounters.drawCalls++;
     if (hrEnd == D2DERR_RECREATE_TARGET)
     {
         OutputDebugStringA("[DaroRenderer] D2D device lost in RenderCircle, recreating target\n");
@@ -773,19 +851,26 @@ void DaroRenderer::RenderCircle(const DaroLayer* layer)
 
     // Flush D2D content to shared surface
     m_Context->Flush();
+    m_CostCounters.flushes++;
 
     // Restore render target with depth-stencil
     m_Context->OMSetRenderTargets(1, m_RTV.GetAddressOf(), m_DepthStencilView.Get());
+    m_CostCounters.stateChanges++;
 }
 
 void DaroRenderer::RenderText(const DaroLayer* layer, const DaroLayer* mask)
 {
+    DaroScopedStage stage(DARO_STAGE_TEXT);
+
     if (!m_D2DRenderTarget || !m_DWriteFactory || !m_D2DFactory) return;
     if (!layer->textContent[0]) return; // No text to render
+    m_CostCounters.paths |= mask ? (DARO_COST_PATH_D2D_TEXT | DARO_COST_PATH_GEOMETRY_MASK) : DARO_COST_PATH_D2D_TEXT;
 
     // Unbind depth-stencil for D2D interop
     m_Context->OMSetRenderTargets(1, m_RTV.GetAddressOf(), nullptr);
+    m_CostCounters.stateChanges++;
     m_Context->Flush();
+    m_CostCounters.flushes++;
 
     float fontSize = layer->fontSize > 0 ? layer->fontSize : 48.0f;
     bool fontBold = layer->fontBold != 0;
@@ -1094,6 +1179,7 @@ void DaroRenderer::RenderText(const DaroLayer* layer, const DaroLayer* mask)
     }
 
     HRESULT hrEnd = m_D2DRenderTarget->EndDraw();
+    m_CostCounters.drawCalls++;
     if (hrEnd == D2DERR_RECREATE_TARGET)
     {
         OutputDebugStringA("[DaroRenderer] D2D device lost in RenderText, recreating target\n");
@@ -1106,18 +1192,23 @@ void DaroRenderer::RenderText(const DaroLayer* layer, const DaroLayer* mask)
 
     // Flush D2D content to shared surface
     m_Context->Flush();
+    m_CostCounters.flushes++;
 
     // Restore render target with depth-stencil
     m_Context->OMSetRenderTargets(1, m_RTV.GetAddressOf(), m_DepthStencilView.Get());
+    m_CostCounters.stateChanges++;
 }
 
 void DaroRenderer::RenderBoundingBox(const DaroLayer* layer)
 {
     if (!m_D2DRenderTarget || !m_D2DFactory) return;
+    m_CostCounters.paths |= DARO_COST_PATH_BOUNDS;
 
     // Unbind depth-stencil for D2D interop
     m_Context->OMSetRenderTargets(1, m_RTV.GetAddressOf(), nullptr);
+    m_CostCounters.stateChanges++;
     m_Context->Flush();
+    m_CostCounters.flushes++;
 
     // Create wireframe brush (green color)
     ComPtr<ID2D1SolidColorBrush> brush;
@@ -1158,6 +1249,7 @@ void DaroRenderer::RenderBoundingBox(const DaroLayer* layer)
     }
 
     HRESULT hrEnd = m_D2DRenderTarget->EndDraw();
+    m_CostCounters.drawCalls++;
     if (hrEnd == D2DERR_RECREATE_TARGET)
     {
         OutputDebugStringA("[DaroRenderer] D2D device lost in RenderBoundingBox, recreating target\n");
@@ -1170,23 +1262,28 @@ void DaroRenderer::RenderBoundingBox(const DaroLayer* layer)
 
     // Flush D2D content
     m_Context->Flush();
+    m_CostCounters.flushes++;
 
     // Restore render target with depth-stencil
     m_Context->OMSetRenderTargets(1, m_RTV.GetAddressOf(), m_DepthStencilView.Get());
+    m_CostCounters.stateChanges++;
 }
 
 void DaroRenderer::RenderMaskToStencil(const DaroLayer* mask)
 {
+    m_CostCounters.paths |= DARO_COST_PATH_STENCIL_MASK;
     // Set stencil write state (write 1 to stencil, don't write color) - with caching
     if (m_CachedState.depthStencilState != m_DSState_WriteMask.Get() || m_CachedState.depthStencilRef != 1)
     {
         m_Context->OMSetDepthStencilState(m_DSState_WriteMask.Get(), 1);
+        m_CostCounters.stateChanges++;
         m_CachedState.depthStencilState = m_DSState_WriteMask.Get();
         m_CachedState.depthStencilRef = 1;
     }
     if (m_CachedState.blendState != m_BlendState_NoColorWrite.Get())
     {
         m_Context->OMSetBlendState(m_BlendState_NoColorWrite.Get(), nullptr, 0xFFFFFFFF);
+        m_CostCounters.stateChanges++;
         m_CachedState.blendState = m_BlendState_NoColorWrite.Get();
     }
 
@@ -1204,26 +1301,55 @@ void DaroRenderer::RenderMaskToStencil(const DaroLayer* mask)
     if (m_CachedState.blendState != m_BlendState.Get())
     {
         m_Context->OMSetBlendState(m_BlendState.Get(), nullptr, 0xFFFFFFFF);
+        m_CostCounters.stateChanges++;
         m_CachedState.blendState = m_BlendState.Get();
     }
 }
 
 void DaroRenderer::RenderWithMasks(const DaroLayer* layers, int layerCount,
-                                   const std::unordered_map<int, std::vector<int>>& layerToMasks)
+                                   const std::unordered_map<int, std::vector<int>>& layerToMasks,
+                                   bool attributeCosts)
 {
+    DARO_TRACE_SCOPE("RenderWithMasks");
     // Set default state (no stencil) - with caching
     if (m_CachedState.depthStencilState != m_DSState_Disabled.Get())
     {
         m_Context->OMSetDepthStencilState(m_DSState_Disabled.Get(), 0);
+        m_CostCounters.stateChanges++;
         m_CachedState.depthStencilState = m_DSState_Disabled.Get();
         m_CachedState.depthStencilRef = 0;
     }
 
+    // Everything between construction and the end of a loop iteration is charged to
+    // the layer, including the stencil pass of the mask it is clipped by
+    struct LayerCostScope
+    {
+        DaroRenderer* renderer;
+        LayerCostScope(DaroRenderer* r, const DaroLayer* layer) : renderer(r) { if (renderer) renderer->BeginLayerCost(layer); }
+        ~LayerCostScope() { if (renderer) renderer->EndLayerCost(); }
+    };
+    // Sampled once: Daro_SetLayerCostEnabled may flip it while this frame renders
+    bool costEnabled = attributeCosts && m_LayerCostEnabled.load();
+    m_CostCounters = CostCounters();
+    bool costGpu = false;
+    if (costEnabled)
+    {
+        m_LayerCosts.clear();
+        costGpu = CreateCostQueries();
+        if (costGpu) m_Context->Begin(m_CostDisjointQuery.Get());
+    }
+
     for (int i = 0; i < layerCount; i++)
     {
         const DaroLayer* layer = &layers[i];
         if (!layer->active) continue;
 
+        // Skip group layers - they don't render visually
+        if (layer->layerType == DARO_TYPE_GROUP)
+            continue;
+
+        LayerCostScope cost(costEnabled ? this : nullptr, layer);
+
         // Render mask layers visually when active (for preview)
         if (layer->layerType == DARO_TYPE_MASK)
         {
@@ -1233,10 +1359,6 @@ void DaroRenderer::RenderWithMasks(const DaroLayer* layers, int layerCount,
             continue;
         }
 
-        // Skip group layers - they don't render visually
-        if (layer->layerType == DARO_TYPE_GROUP)
-            continue;
-
         // Check if this layer is masked
         auto it = layerToMasks.find(layer->id);
         if (it != layerToMasks.end() && !it->second.empty())
@@ -1265,6 +1387,7 @@ void DaroRenderer::RenderWithMasks(const DaroLayer* layers, int layerCount,
                 if (m_CachedState.depthStencilState != targetState || m_CachedState.depthStencilRef != 1)
                 {
                     m_Context->OMSetDepthStencilState(targetState, 1);
+                    m_CostCounters.stateChanges++;
                     m_CachedState.depthStencilState = targetState;
                     m_CachedState.depthStencilRef = 1;
                 }
@@ -1275,6 +1398,7 @@ void DaroRenderer::RenderWithMasks(const DaroLayer* layers, int layerCount,
                 if (m_CachedState.depthStencilState != m_DSState_Disabled.Get())
                 {
                     m_Context->OMSetDepthStencilState(m_DSState_Disabled.Get(), 0);
+                    m_CostCounters.stateChanges++;
                     m_CachedState.depthStencilState = m_DSState_Disabled.Get();
                     m_CachedState.depthStencilRef = 0;
                 }
@@ -1291,41 +1415,147 @@ void DaroRenderer::RenderWithMasks(const DaroLayer* layers, int layerCount,
             RenderBoundingBox(layer);
     }
 
+    if (costGpu) m_Context->End(m_CostDisjointQuery.Get());
+
     // Flush D2D/D3D content - required for surface synchronization
     m_Context->Flush();
+    m_CostCounters.flushes++;
     WaitForGPU();
+
+    if (costEnabled) ResolveLayerCosts();
+}
+
+// ============== Layer Cost Attribution ==============
+
+void DaroRenderer::SetLayerCostEnabled(bool enabled)
+{
+    m_LayerCostEnabled.store(enabled);
+    if (!enabled)
+    {
+        std::lock_guard<std::mutex> lock(m_LayerCostMutex);
+        m_LastLayerCosts.clear();
+    }
+}
+
+bool DaroRenderer::CreateCostQueries()
+{
+    if (m_CostDisjointQuery) return true;
+    if (m_CostQueriesFailed || !m_Device) return false;
+
+    D3D11_QUERY_DESC desc = {};
+    desc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+    if (FAILED(m_Device->CreateQuery(&desc, &m_CostDisjointQuery)))
+    {
+        m_CostQueriesFailed = true;
+        OutputDebugStringA("[DaroRenderer] Timestamp queries unavailable - layer GPU cost disabled\n");
+        return false;
+    }
+
+    desc.Query = D3D11_QUERY_TIMESTAMP;
+    m_CostTimestamps.resize(DARO_MAX_LAYERS * 2);
+    for (auto& query : m_CostTimestamps)
+    {
+        if (FAILED(m_Device->CreateQuery(&desc, &query)))
+        {
+            m_CostDisjointQuery.Reset();
+            m_CostTimestamps.clear();
+            m_CostQueriesFailed = true;
+            OutputDebugStringA("[DaroRenderer] Timestamp queries unavailable - layer GPU cost disabled\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+void DaroRenderer::BeginLayerCost(const DaroLayer* layer)
+{
+    size_t index = m_LayerCosts.size();
+    DaroLayerCost cost = {};
+    cost.layerId = layer->id;
+    cost.layerType = layer->layerType;
+    cost.gpuMs = -1.0;
+    m_LayerCosts.push_back(cost);
+
+    m_CostCounters.paths = 0;
+    m_LayerCostStart = m_CostCounters;
+    if (m_CostDisjointQuery && index < DARO_MAX_LAYERS)
+        m_Context->End(m_CostTimestamps[index * 2].Get());
+    m_LayerCostStartTicks = DaroFrameProfiler::Now();
+}
+
+void DaroRenderer::EndLayerCost()
+{
+    size_t index = m_LayerCosts.size() - 1;
+    DaroLayerCost& cost = m_LayerCosts[index];
+    cost.cpuMs = DaroFrameProfiler::Instance().TicksToMs(DaroFrameProfiler::Now() - m_LayerCostStartTicks);
+    if (m_CostDisjointQuery && index < DARO_MAX_LAYERS)
+        m_Context->End(m_CostTimestamps[index * 2 + 1].Get());
+
+    cost.paths = m_CostCounters.paths;
+    cost.stateChanges = (int)(m_CostCounters.stateChanges - m_LayerCostStart.stateChanges);
+    cost.flushes = (int)(m_CostCounters.flushes - m_LayerCostStart.flushes);
+    cost.drawCalls = (int)(m_CostCounters.drawCalls - m_LayerCostStart.drawCalls);
+}
+
+void DaroRenderer::ResolveLayerCosts()
+{
+    // RenderWithMasks has just waited for the GPU, so the queries are complete and
+    // reading them here does not stall. If the driver disagrees, gpuMs stays -1.
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint = {};
+    if (m_CostDisjointQuery &&
+        m_Context->GetData(m_CostDisjointQuery.Get(), &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK &&
+        !disjoint.Disjoint && disjoint.Frequency > 0)
+    {
+        size_t count = (std::min)(m_LayerCosts.size(), (size_t)DARO_MAX_LAYERS);
+        for (size_t i = 0; i < count; i++)
+        {
+            UINT64 begin = 0, end = 0;
+            if (m_Context->GetData(m_CostTimestamps[i * 2].Get(), &begin, sizeof(begin), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK &&
+                m_Context->GetData(m_CostTimestamps[i * 2 + 1].Get(), &end, sizeof(end), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK &&
+                end >= begin)
+            {
+                m_LayerCosts[i].gpuMs = (double)(end - begin) * 1000.0 / (double)disjoint.Frequency;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_LayerCostMutex);
+    m_LastLayerCosts.swap(m_LayerCosts);
+}
+
+int DaroRenderer::GetLayerCosts(DaroLayerCost* buffer, int maxCount)
+{
+    if (!buffer || maxCount <= 0) return 0;
+    std::lock_guard<std::mutex> lock(m_LayerCostMutex);
+    int count = (std::min)(maxCount, (int)m_LastLayerCosts.size());
+    for (int i = 0; i < count; i++)
+        buffer[i] = m_LastLayerCosts[i];
+    return count;
+}
+
+bool DaroRenderer::GetLayerCost(int layerId, DaroLayerCost* cost)
+{
+    if (!cost) return false;
+    std::lock_guard<std::mutex> lock(m_LayerCostMutex);
+    for (const DaroLayerCost& entry : m_LastLayerCosts)
+    {
+        if (entry.layerId == layerId)
+        {
+            *cost = entry;
+            return true;
+        }
+    }
+    return false;
 }
 
 void DaroRenderer::UpdateConstantBuffer(const DaroLayer* layer, bool hasTexture)
 {
-    // Anchor offset for rotation: anchor is 0-1, where 0.5 is center
-    float anchorOffsetX = (layer->anchorX - 0.5f) * layer->sizeX;
-    float anchorOffsetY = (layer->anchorY - 0.5f) * layer->sizeY;
-
-    // Scale from center (position adjustment happens in Designer when size changes)
-    XMMATRIX scale = XMMatrixScaling(layer->sizeX, layer->sizeY, 1.0f);
-
-    // Rotation around anchor point
-    XMMATRIX toAnchor = XMMatrixTranslation(-anchorOffsetX, anchorOffsetY, 0.0f);
-    XMMATRIX rotZ = XMMatrixRotationZ(XMConvertToRadians(layer->rotZ));
-    XMMATRIX rotY = XMMatrixRotationY(XMConvertToRadians(layer->rotY));
-    XMMATRIX rotX = XMMatrixRotationX(XMConvertToRadians(layer->rotX));
-    XMMATRIX fromAnchor = XMMatrixTranslation(anchorOffsetX, -anchorOffsetY, 0.0f);
-
-    // Translate to world position
-    XMMATRIX translation = XMMatrixTranslation(
-        layer->posX - m_Width * 0.5f,
-        -(layer->posY - m_Height * 0.5f),
-        0.0f
-    );
-    XMMATRIX projection = XMMatrixOrthographicLH((float)m_Width, (float)m_Height, 0.0f, 1.0f);
+    XMMATRIX wvp = DaroLayerTransform(layer, (float)m_Width, (float)m_Height);
 
-    // Transform: scale from center, then rotate around anchor, then translate
-    XMMATRIX wvp = scale * toAnchor * rotZ * rotY * rotX * fromAnchor * translation * projection;
-    
     D3D11_MAPPED_SUBRESOURCE mapped;
     if (SUCCEEDED(m_Context->Map(m_ConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
     {
+        m_CostCounters.stateChanges++;
         CBLayer* cb = (CBLayer*)mapped.pData;
         XMStoreFloat4x4(&cb->transform, XMMatrixTranspose(wvp));
         cb->color = XMFLOAT4(layer->colorR * layer->opacity, layer->colorG * layer->opacity,
@@ -1355,9 +1585,207 @@ bool DaroRenderer::MapStaging(void** ppData, int* pRowPitch)
 
 void DaroRenderer::UnmapStaging() { m_Context->Unmap(m_StagingTexture.Get(), 0); }
 
+// ============== Preview Output ==============
+
+bool DaroRenderer::EnablePreview(int divisor)
+{
+    if (!m_Device) return false;
+    if (divisor < 1 || divisor > DARO_PREVIEW_MAX_DIVISOR || (divisor & (divisor - 1)) != 0) return false;
+    DisablePreview();
+
+    int level = 0;
+    while ((1 << level) < divisor) level++;
+    int width = (m_Width >> level) > 0 ? (m_Width >> level) : 1;
+    int height = (m_Height >> level) > 0 ? (m_Height >> level) : 1;
+
+    // Divisor 1 reads the render target directly; otherwise GenerateMips box-filters it
+    // down level by level and the staging copy takes the level at preview size
+    long long gpuBytes = 0;
+    if (level > 0)
+    {
+        D3D11_TEXTURE2D_DESC desc = {};
+        desc.Width = m_Width;
+        desc.Height = m_Height;
+        desc.MipLevels = level + 1;
+        desc.ArraySize = 1;
+        desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+        desc.SampleDesc.Count = 1;
+        desc.Usage = D3D11_USAGE_DEFAULT;
+        desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+        desc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
+        if (FAILED(m_Device->CreateTexture2D(&desc, nullptr, &m_PreviewMips)) ||
+            FAILED(m_Device->CreateShaderResourceView(m_PreviewMips.Get(), nullptr, &m_PreviewMipsSRV)))
+        {
+            DisablePreview();
+            return false;
+        }
+        for (int i = 0; i <= level; i++)
+            gpuBytes += DaroTextureBytes((m_Width >> i) > 0 ? (m_Width >> i) : 1, (m_Height >> i) > 0 ? (m_Height >> i) : 1);
+    }
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = width;
+    desc.Height = height;
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_STAGING;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    if (FAILED(m_Device->CreateTexture2D(&desc, nullptr, &m_PreviewStaging)))
+    {
+        DisablePreview();
+        return false;
+    }
+
+    m_PreviewLevel = level;
+    m_PreviewWidth = width;
+    m_PreviewHeight = height;
+    DaroMemoryAccountant::Instance().Set(DARO_MEM_RENDER_TARGETS, MEM_ASSET_PREVIEW, DaroTextureBytes(width, height), gpuBytes);
+    return true;
+}
+
+void DaroRenderer::DisablePreview()
+{
+    m_PreviewStaging.Reset();
+    m_PreviewMipsSRV.Reset();
+    m_PreviewMips.Reset();
+    m_PreviewLevel = 0;
+    m_PreviewWidth = 0;
+    m_PreviewHeight = 0;
+    DaroMemoryAccountant::Instance().Remove(DARO_MEM_RENDER_TARGETS, MEM_ASSET_PREVIEW);
+}
+
+void DaroRenderer::RenderPreview(const DaroLayer* layers, int layerCount,
+                                 const std::unordered_map<int, std::vector<int>>& layerToMasks)
+{
+    RenderWithMasks(layers, layerCount, layerToMasks, false);
+
+    if (!m_PreviewStaging) return;
+    if (m_PreviewMips)
+    {
+        m_Context->CopySubresourceRegion(m_PreviewMips.Get(), 0, 0, 0, 0, m_RenderTarget.Get(), 0, nullptr);
+        m_Context->GenerateMips(m_PreviewMipsSRV.Get());
+        m_Context->CopySubresourceRegion(m_PreviewStaging.Get(), 0, 0, 0, 0, m_PreviewMips.Get(), m_PreviewLevel, nullptr);
+    }
+    else
+    {
+        m_Context->CopyResource(m_PreviewStaging.Get(), m_RenderTarget.Get());
+    }
+}
+
+bool DaroRenderer::MapPreview(void** ppData, int* pRowPitch)
+{
+    if (!ppData || !pRowPitch || !m_Context || !m_PreviewStaging) return false;
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(m_Context->Map(m_PreviewStaging.Get(), 0, D3D11_MAP_READ, 0, &mapped))) return false;
+    *ppData = mapped.pData;
+    *pRowPitch = mapped.RowPitch;
+    return true;
+}
+
+void DaroRenderer::UnmapPreview() { m_Context->Unmap(m_PreviewStaging.Get(), 0); }
+
+// ============== Scene Transitions ==============
+
+bool DaroRenderer::CreateTransitionTargets()
+{
+    if (m_TransitionFrom) return true;
+    if (!m_Device) return false;
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = m_Width;
+    desc.Height = m_Height;
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    if (FAILED(m_Device->CreateTexture2D(&desc, nullptr, &m_TransitionFrom)) ||
+        FAILED(m_Device->CreateShaderResourceView(m_TransitionFrom.Get(), nullptr, &m_TransitionFromSRV)) ||
+        FAILED(m_Device->CreateTexture2D(&desc, nullptr, &m_TransitionTo)) ||
+        FAILED(m_Device->CreateShaderResourceView(m_TransitionTo.Get(), nullptr, &m_TransitionToSRV)))
+    {
+        OutputDebugStringA("[DaroRenderer] Failed to create transition targets, transitions cut\n");
+        ReleaseTransitionTargets();
+        return false;
+    }
+    DaroMemoryAccountant::Instance().Set(DARO_MEM_RENDER_TARGETS, MEM_ASSET_TRANSITION, 0, DaroTextureBytes(m_Width, m_Height) * 2);
+    return true;
+}
+
+void DaroRenderer::ReleaseTransitionTargets()
+{
+    m_TransitionFromSRV.Reset();
+    m_TransitionFrom.Reset();
+    m_TransitionToSRV.Reset();
+    m_TransitionTo.Reset();
+    m_TransitionFromValid = false;
+    DaroMemoryAccountant::Instance().Remove(DARO_MEM_RENDER_TARGETS, MEM_ASSET_TRANSITION);
+}
+
+void DaroRenderer::RenderTransitionSource(const DaroLayer* layers, int layerCount,
+                                          const std::unordered_map<int, std::vector<int>>& layerToMasks)
+{
+    if (!CreateTransitionTargets()) return;
+
+    RenderWithMasks(layers, layerCount, layerToMasks, false);
+
+    m_Context->CopyResource(m_TransitionFrom.Get(), m_RenderTarget.Get());
+    m_TransitionFromValid = true;
+}
+
+void DaroRenderer::CompositeTransition(const DaroTransition& transition, float progress)
+{
+    // Without the outgoing scene the incoming one stays as rendered: a cut
+    if (!m_TransitionFromValid) return;
+    m_TransitionFromValid = false;
+    m_Context->CopyResource(m_TransitionTo.Get(), m_RenderTarget.Get());
+
+    ID3D11ShaderResourceView* mask = nullptr;
+    if (transition.type == DARO_TRANSITION_WIPE && transition.maskTextureId > 0)
+        mask = GetTextureSRV(transition.maskTextureId);
+
+    static const XMFLOAT2 directions[DARO_DIRECTION_COUNT] = {
+        { -1.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, -1.0f }, { 0.0f, 1.0f } };
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(m_Context->Map(m_TransitionCB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) return;
+    CBTransition* cb = (CBTransition*)mapped.pData;
+    cb->progress = progress;
+    cb->mode = (float)transition.type;
+    cb->softness = transition.softness;
+    cb->hasMask = mask ? 1.0f : 0.0f;
+    cb->direction = directions[transition.direction >= 0 && transition.direction < DARO_DIRECTION_COUNT ? transition.direction : 0];
+    cb->padding = XMFLOAT2(0.0f, 0.0f);
+    m_Context->Unmap(m_TransitionCB.Get(), 0);
+
+    // Overwrite the render target: no blending, no stencil, no vertex buffer
+    m_Context->OMSetRenderTargets(1, m_RTV.GetAddressOf(), nullptr);
+    m_Context->OMSetBlendState(nullptr, nullptr, 0xFFFFFFFF);
+    m_Context->IASetInputLayout(nullptr);
+    m_Context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    m_Context->VSSetShader(m_TransitionVS.Get(), nullptr, 0);
+    m_Context->PSSetShader(m_TransitionPS.Get(), nullptr, 0);
+    m_Context->PSSetConstantBuffers(0, 1, m_TransitionCB.GetAddressOf());
+    m_Context->PSSetSamplers(0, 1, m_Sampler.GetAddressOf());
+    ID3D11ShaderResourceView* srvs[3] = { m_TransitionFromSRV.Get(), m_TransitionToSRV.Get(), mask };
+    m_Context->PSSetShaderResources(0, 3, srvs);
+    m_CostCounters.stateChanges += 9;
+
+    m_Context->Draw(3, 0);
+    m_CostCounters.drawCalls++;
+
+    // Back to the layer pipeline for anything drawn after (the preview output)
+    ID3D11ShaderResourceView* nullSRVs[3] = {};
+    m_Context->PSSetShaderResources(0, 3, nullSRVs);
+    BindFrameState();
+}
+
 void DaroRenderer::WaitForGPU()
 {
     if (!m_SyncQuery) return;
+    DaroScopedStage stage(DARO_STAGE_GPU_WAIT);
 
     // Issue an event query and wait for GPU to complete
     m_Context->End(m_SyncQuery.Get());
@@ -1410,7 +1838,11 @@ bool DaroRenderer::EnableSpout(const char* name)
         return false;
     }
 
-    m_SpoutSender.SetSenderName(name);
+    ComPtr<ID2D1Multithread> d2dLock;
+    if (!m_D2DFactory || FAILED(m_D2DFactory.As(&d2dLock))) return false;
+
+    if (!m_SpoutOutput.Start(m_Device.Get(), m_Context.Get(), d2dLock.Get(), name, m_Width, m_Height, DXGI_FORMAT_B8G8R8A8_UNORM))
+        return false;
     m_SpoutEnabled = true;
     return true;
 }
@@ -1418,20 +1850,21 @@ bool DaroRenderer::EnableSpout(const char* name)
 void DaroRenderer::DisableSpout()
 {
     if (!m_SpoutEnabled) return;
-    m_SpoutSender.ReleaseSender();
+    m_SpoutOutput.Stop();
     m_SpoutEnabled = false;
 }
 
-void DaroRenderer::SendSpout()
+void DaroRenderer::SendSpout(const DaroFrameMetadata* metadata)
 {
     if (!m_SpoutEnabled || !m_RenderTarget) return;
-    m_SpoutSender.SendTexture(m_RenderTarget.Get());
+    m_SpoutOutput.Enqueue(m_RenderTarget.Get(), metadata);
 }
 
 // ============== Texture Loading ==============
 
 int DaroRenderer::LoadTexture(const char* filePath)
 {
+    DARO_TRACE_SCOPE("Texture load");
     if (!m_WICFactory || !m_Device) return -1;
     if (!filePath || filePath[0] == '\0') return -1;
 
@@ -1539,6 +1972,7 @@ int DaroRenderer::LoadTexture(const char* filePath)
     int id = m_NextTextureId++;
     if (id <= 0) m_NextTextureId = id = 1; // Wraparound protection
     m_Textures[id] = std::move(info);
+    DaroMemoryAccountant::Instance().Set(DARO_MEM_TEXTURES, id, 0, DaroTextureBytes(width, height));
     
     return id;
 }
@@ -1546,6 +1980,7 @@ int DaroRenderer::LoadTexture(const char* filePath)
 void DaroRenderer::UnloadTexture(int textureId)
 {
     m_Textures.erase(textureId);
+    DaroMemoryAccountant::Instance().Remove(DARO_MEM_TEXTURES, textureId);
 }
 
 ID3D11ShaderResourceView* DaroRenderer::GetTextureSRV(int textureId)
@@ -1612,75 +2047,104 @@ void DaroRenderer::DisconnectSpoutReceiver(int receiverId)
         it->second.receiver.ReleaseReceiver();
         it->second.receiver.CloseDirectX11();
         m_SpoutReceivers.erase(it);
+        DaroMemoryAccountant::Instance().Remove(DARO_MEM_SPOUT_INPUT, receiverId);
+    }
+}
+
+// Returns true if any active layer samples from the given Spout receiver
+static bool IsSpoutReceiverReferenced(const DaroLayer* layers, int layerCount, int receiverId)
+{
+    if (!layers) return false;
+    for (int i = 0; i < layerCount; i++)
+    {
+        if (layers[i].active && layers[i].sourceType == DARO_SOURCE_SPOUT &&
+            layers[i].spoutReceiverId == receiverId)
+            return true;
     }
+    return false;
 }
 
-void DaroRenderer::UpdateSpoutReceivers()
+void DaroRenderer::UpdateSpoutReceivers(const DaroLayer* layers, int layerCount,
+                                        const DaroLayer* otherLayers, int otherCount)
 {
     for (auto& pair : m_SpoutReceivers)
     {
         auto& info = pair.second;
-        
-        if (info.receiver.ReceiveTexture())
+
+        // Receivers that no active layer samples from are not polled at all -
+        // the layer texture keeps its last frame until the receiver is used again
+        if (!IsSpoutReceiverReferenced(layers, layerCount, pair.first) &&
+            !IsSpoutReceiverReferenced(otherLayers, otherCount, pair.first))
         {
-            // Get new texture if size changed or first connect
-            if (!info.connected || info.receiver.IsUpdated())
-            {
-                info.width = info.receiver.GetSenderWidth();
-                info.height = info.receiver.GetSenderHeight();
-
-                info.texture.Reset();
-                info.srv.Reset();
-                info.connected = false;
-
-                // Validate dimensions before creating texture
-                if (info.width == 0 || info.height == 0)
-                    continue;
-
-                // Create texture to copy into
-                D3D11_TEXTURE2D_DESC texDesc = {};
-                texDesc.Width = info.width;
-                texDesc.Height = info.height;
-                texDesc.MipLevels = 1;
-                texDesc.ArraySize = 1;
-                texDesc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
-                texDesc.SampleDesc.Count = 1;
-                texDesc.Usage = D3D11_USAGE_DEFAULT;
-                texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-                if (SUCCEEDED(m_Device->CreateTexture2D(&texDesc, nullptr, &info.texture)))
-                {
-                    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-                    srvDesc.Format = texDesc.Format;
-                    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-                    srvDesc.Texture2D.MipLevels = 1;
-
-                    if (FAILED(m_Device->CreateShaderResourceView(info.texture.Get(), &srvDesc, &info.srv)))
-                    {
-                        info.texture.Reset();
-                    }
-                }
+            info.skippedFrames++;
+            continue;
+        }
 
-                // Only mark connected if both texture and SRV were created
-                info.connected = (info.texture && info.srv);
-            }
-            
-            // Copy received texture (validate dimensions match to prevent D3D error)
-            if (info.texture)
+        // Receive directly into the layer texture. spoutDX only copies when the
+        // sender frame counter has advanced, so a 25 fps or paused sender does not
+        // cost a full-frame CopyResource on every render frame.
+        bool received = info.receiver.ReceiveTexture(info.texture.GetAddressOf());
+        bool updated = info.receiver.IsUpdated();
+
+        // Create the layer texture on first connect or when the sender changed size/format
+        if (updated || (!info.texture && info.receiver.IsConnected()))
+        {
+            info.width = info.receiver.GetSenderWidth();
+            info.height = info.receiver.GetSenderHeight();
+
+            info.texture.Reset();
+            info.srv.Reset();
+            info.connected = false;
+
+            // Validate dimensions before creating texture
+            if (info.width == 0 || info.height == 0)
+                continue;
+
+            // Match the sender format so the shared texture can be copied directly
+            DXGI_FORMAT format = info.receiver.GetSenderFormat();
+            if (format == DXGI_FORMAT_UNKNOWN)
+                format = DXGI_FORMAT_B8G8R8A8_UNORM;
+
+            D3D11_TEXTURE2D_DESC texDesc = {};
+            texDesc.Width = info.width;
+            texDesc.Height = info.height;
+            texDesc.MipLevels = 1;
+            texDesc.ArraySize = 1;
+            texDesc.Format = format;
+            texDesc.SampleDesc.Count = 1;
+            texDesc.Usage = D3D11_USAGE_DEFAULT;
+            texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+            if (SUCCEEDED(m_Device->CreateTexture2D(&texDesc, nullptr, &info.texture)))
             {
-                ID3D11Texture2D* srcTex = info.receiver.GetSenderTexture();
-                if (srcTex)
+                D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+                srvDesc.Format = texDesc.Format;
+                srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+                srvDesc.Texture2D.MipLevels = 1;
+
+                if (FAILED(m_Device->CreateShaderResourceView(info.texture.Get(), &srvDesc, &info.srv)))
                 {
-                    D3D11_TEXTURE2D_DESC srcDesc, dstDesc;
-                    srcTex->GetDesc(&srcDesc);
-                    info.texture->GetDesc(&dstDesc);
-                    if (srcDesc.Width == dstDesc.Width && srcDesc.Height == dstDesc.Height)
-                    {
-                        m_Context->CopyResource(info.texture.Get(), srcTex);
-                    }
+                    info.texture.Reset();
                 }
             }
+
+            // Only mark connected if both texture and SRV were created
+            info.connected = (info.texture && info.srv);
+            DaroMemoryAccountant::Instance().Set(DARO_MEM_SPOUT_INPUT, pair.first, 0,
+                info.connected ? DaroTextureBytes(info.width, info.height, BytesPerPixel(format)) : 0);
+
+            // First frame is copied on the next ReceiveTexture call
+            continue;
         }
+
+        // No sender, or the connected sender closed
+        if (!received) continue;
+
+        // Frame counter tells whether ReceiveTexture copied a new sender frame
+        if (info.receiver.IsFrameNew())
+            info.newFrames++;
+        else
+            info.repeatedFrames++;
     }
 }
 
@@ -1692,6 +2156,40 @@ ID3D11ShaderResourceView* DaroRenderer::GetSpoutReceiverSRV(int receiverId)
     return nullptr;
 }
 
+bool DaroRenderer::GetSpoutReceiverStats(int receiverId, DaroSpoutReceiverStats* stats)
+{
+    if (!stats) return false;
+    auto it = m_SpoutReceivers.find(receiverId);
+    if (it == m_SpoutReceivers.end()) return false;
+
+    auto& info = it->second;
+    stats->connected = info.connected ? 1 : 0;
+    stats->width = (int)info.width;
+    stats->height = (int)info.height;
+    stats->senderFrame = (int)info.receiver.GetSenderFrame();
+    stats->senderFps = info.receiver.GetSenderFps();
+    stats->newFrames = info.newFrames;
+    stats->repeatedFrames = info.repeatedFrames;
+    stats->skippedFrames = info.skippedFrames;
+    return true;
+}
+
+bool DaroRenderer::GetSpoutReceiverMetadata(int receiverId, DaroFrameMetadata* metadata)
+{
+    if (!metadata) return false;
+    auto it = m_SpoutReceivers.find(receiverId);
+    if (it == m_SpoutReceivers.end() || !it->second.connected) return false;
+
+    auto& info = it->second;
+    if (!info.metadata)
+        info.metadata = std::make_unique<DaroMetadataReader>();
+    if (info.metadata->IsSenderLost() && !info.metadata->Open(info.senderName.c_str()))
+        return false;
+
+    // Record for the frame currently in the layer texture
+    return info.metadata->Read(info.receiver.GetSenderFrame(), metadata);
+}
+
 // ============================================================================
 // Video Playback
 // ============================================================================
@@ -9,13 +9,18 @@
 #include <d2d1_1.h>
 #include <dwrite.h>
 #include <dwrite_1.h>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include "SharedTypes.h"
 #include "DaroEngine.h"
 #include "Spout/SpoutDX.h"
+#include "FrameMetadata.h"
+#include "SpoutOutput.h"
 #include "VideoPlayer.h"
 
 using Microsoft::WRL::ComPtr;
@@ -39,6 +44,14 @@ struct SpoutReceiverInfo
     unsigned int width;
     unsigned int height;
     bool connected;
+
+    // Frame statistics (see DaroSpoutReceiverStats)
+    long long newFrames = 0;        // Sender frame copied into the layer texture
+    long long repeatedFrames = 0;   // Sender had not produced a new frame, copy skipped
+    long long skippedFrames = 0;    // Not referenced by any active layer, receive skipped
+
+    // Sender metadata ring, opened on first lookup (the sender may enable it later)
+    std::unique_ptr<DaroMetadataReader> metadata;
 };
 
 class DaroRenderer
@@ -50,13 +63,18 @@ public:
     int Initialize(int width, int height);
     void Shutdown();
     
-    void BeginFrame();
+    // otherLayers: the outgoing scene of a transition, whose Spout inputs stay live too
+    void BeginFrame(const DaroLayer* layers, int layerCount,
+                    const DaroLayer* otherLayers = nullptr, int otherCount = 0);
     void Clear(float r, float g, float b, float a);
     bool IsDeviceLost() const { return m_DeviceLost; }
     bool CheckDeviceLost();
     void RenderLayer(const DaroLayer* layer);
+    // attributeCosts = false renders without touching the layer cost results (preview,
+    // transition sources)
     void RenderWithMasks(const DaroLayer* layers, int layerCount,
-                         const std::unordered_map<int, std::vector<int>>& layerToMasks);
+                         const std::unordered_map<int, std::vector<int>>& layerToMasks,
+                         bool attributeCosts = true);
     void RenderBoundingBox(const DaroLayer* layer);
     void SetShowBounds(bool show) { m_ShowBounds = show; }
     bool GetShowBounds() const { return m_ShowBounds; }
@@ -64,16 +82,46 @@ public:
     // Edge antialiasing (shader-based smooth edges for D3D11 quads)
     void SetEdgeSmoothing(float width) { m_EdgeSmoothWidth = width; }
     float GetEdgeSmoothing() const { return m_EdgeSmoothWidth; }
+
+    // Per-layer cost attribution in RenderWithMasks (off by default). Results are
+    // for the last rendered frame, in draw order.
+    void SetLayerCostEnabled(bool enabled);
+    bool IsLayerCostEnabled() const { return m_LayerCostEnabled.load(); }
+    int GetLayerCosts(DaroLayerCost* buffer, int maxCount);
+    bool GetLayerCost(int layerId, DaroLayerCost* cost);
     
     void CopyToStaging();
     bool MapStaging(void** ppData, int* pRowPitch);
     void UnmapStaging();
+
+    // Preview output: a second render per frame read back at 1/divisor size (a power of
+    // two up to DARO_PREVIEW_MAX_DIVISOR), downscaled on the GPU through a mip chain
+    bool EnablePreview(int divisor);
+    void DisablePreview();
+    int GetPreviewWidth() const { return m_PreviewWidth; }
+    int GetPreviewHeight() const { return m_PreviewHeight; }
+    // RenderWithMasks without replacing the program frame's layer costs, then the downscale
+    void RenderPreview(const DaroLayer* layers, int layerCount,
+                       const std::unordered_map<int, std::vector<int>>& layerToMasks);
+    bool MapPreview(void** ppData, int* pRowPitch);
+    void UnmapPreview();
+
+    // Scene transitions: the outgoing scene is rendered first (without layer costs) and kept
+    // offscreen; after the incoming scene is rendered, CompositeTransition blends the two
+    // back into the render target at progress 0..1
+    void RenderTransitionSource(const DaroLayer* layers, int layerCount,
+                                const std::unordered_map<int, std::vector<int>>& layerToMasks);
+    void CompositeTransition(const DaroTransition& transition, float progress);
     
     // Spout Output
     bool EnableSpout(const char* name);
     void DisableSpout();
     bool IsSpoutEnabled() const { return m_SpoutEnabled; }
-    void SendSpout();
+    // Hands the frame to the output stage; metadata may be null, spoutFrame and
+    // timestampNs are filled in by the send thread
+    void SendSpout(const DaroFrameMetadata* metadata = nullptr);
+    void SetSpoutSendTimeout(int milliseconds) { m_SpoutOutput.SetTimeout(milliseconds); }
+    void GetSpoutOutputStats(DaroSpoutOutputStats* stats) const { m_SpoutOutput.GetStats(stats); }
     
     // Texture loading
     int LoadTexture(const char* filePath);
@@ -85,8 +133,11 @@ public:
     bool GetSpoutSenderName(int index, char* buffer, int bufferSize);
     int ConnectSpoutReceiver(const char* senderName);
     void DisconnectSpoutReceiver(int receiverId);
-    void UpdateSpoutReceivers();
+    void UpdateSpoutReceivers(const DaroLayer* layers, int layerCount,
+                              const DaroLayer* otherLayers = nullptr, int otherCount = 0);
     ID3D11ShaderResourceView* GetSpoutReceiverSRV(int receiverId);
+    bool GetSpoutReceiverStats(int receiverId, DaroSpoutReceiverStats* stats);
+    bool GetSpoutReceiverMetadata(int receiverId, DaroFrameMetadata* metadata);
 
     // Video playback
     int LoadVideo(const char* filePath);
@@ -110,6 +161,9 @@ private:
     bool CreateMSAARenderTarget();
     void ResolveMSAA();
     bool CreateShaders();
+    bool CreateTransitionTargets();
+    void ReleaseTransitionTargets();
+    void BindFrameState();  // Render target, blend, depth-stencil and common state
     bool CreateGeometry();
     bool CreateStagingTexture();
     bool InitWIC();
@@ -125,6 +179,12 @@ private:
     bool CreateDepthStencil();
     bool CreateDepthStencilStates();
     void RenderMaskToStencil(const DaroLayer* mask);
+
+    // Layer cost attribution
+    bool CreateCostQueries();
+    void BeginLayerCost(const DaroLayer* layer);
+    void EndLayerCost();
+    void ResolveLayerCosts();
     
 private:
     int m_Width = 1920;
@@ -142,6 +202,24 @@ private:
     ComPtr<ID3D11RenderTargetView> m_RTV;
     ComPtr<ID3D11Texture2D> m_StagingTexture;
 
+    // Preview output (EnablePreview)
+    ComPtr<ID3D11Texture2D> m_PreviewMips;          // Render target size, mips down to the preview size
+    ComPtr<ID3D11ShaderResourceView> m_PreviewMipsSRV;
+    ComPtr<ID3D11Texture2D> m_PreviewStaging;
+    int m_PreviewLevel = 0;                         // Mip level read back
+    int m_PreviewWidth = 0;
+    int m_PreviewHeight = 0;
+
+    // Scene transitions (RenderTransitionSource): copies of the two scenes, created on first use
+    ComPtr<ID3D11Texture2D> m_TransitionFrom;
+    ComPtr<ID3D11ShaderResourceView> m_TransitionFromSRV;
+    ComPtr<ID3D11Texture2D> m_TransitionTo;
+    ComPtr<ID3D11ShaderResourceView> m_TransitionToSRV;
+    ComPtr<ID3D11VertexShader> m_TransitionVS;
+    ComPtr<ID3D11PixelShader> m_TransitionPS;
+    ComPtr<ID3D11Buffer> m_TransitionCB;
+    bool m_TransitionFromValid = false;             // Outgoing scene stored this frame
+
     int m_MSAASampleCount = 4;  // 4x MSAA
     
     ComPtr<ID3D11VertexShader> m_VertexShader;
@@ -177,8 +255,9 @@ private:
     int m_NextTextureId = 1;
     
     // Spout Output
-    spoutDX m_SpoutSender;
+    spoutDX m_SpoutSender;              // Sender enumeration only - sending happens in m_SpoutOutput
     bool m_SpoutEnabled = false;
+    DaroSpoutOutput m_SpoutOutput;      // Send thread + double-buffered copy target
     
     // Spout Input
     std::map<int, SpoutReceiverInfo> m_SpoutReceivers;
@@ -214,6 +293,30 @@ private:
         bool geometryBound = false;
     };
     CachedState m_CachedState;
+
+    // Running totals sampled around each layer for DaroLayerCost (always counted -
+    // a few integer increments are cheaper than checking whether anyone is looking).
+    // Reset at the start of every RenderWithMasks, and 64-bit so a frame never wraps.
+    struct CostCounters
+    {
+        uint64_t stateChanges = 0;
+        uint64_t flushes = 0;
+        uint64_t drawCalls = 0;
+        int paths = 0;                  // DARO_COST_PATH_* flags, cleared per layer
+    };
+    CostCounters m_CostCounters;
+    std::atomic<bool> m_LayerCostEnabled{ false };  // Set from API threads, sampled once per frame
+    CostCounters m_LayerCostStart;
+    long long m_LayerCostStartTicks = 0;
+    std::vector<DaroLayerCost> m_LayerCosts;        // Frame being rendered
+    std::vector<DaroLayerCost> m_LastLayerCosts;    // Last completed frame
+    std::mutex m_LayerCostMutex;                    // Guards m_LastLayerCosts
+
+    // GPU timestamps: one begin/end pair per layer inside a disjoint query
+    ComPtr<ID3D11Query> m_CostDisjointQuery;
+    std::vector<ComPtr<ID3D11Query>> m_CostTimestamps;
+    bool m_CostQueriesFailed = false;
+
     void ResetStateCache();
     void BindCommonState();  // Bind VS, PS, IL, sampler once per frame
 
@@ -247,4 +350,14 @@ private:
         float edgeSmoothWidth;
         float padding;
     };
+
+    struct CBTransition
+    {
+        float progress;
+        float mode;                 // DARO_TRANSITION_*
+        float softness;
+        float hasMask;
+        XMFLOAT2 direction;         // Unit step in texture coordinates
+        XMFLOAT2 padding;
+    };
 };
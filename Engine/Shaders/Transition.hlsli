@@ -0,0 +1,23 @@
+// Engine/Shaders/Transition.hlsli
+// Scene transition compositor (Renderer.cpp): constants and resources shared by
+// TransitionVS.hlsl and TransitionPS.hlsl. CBTransition mirrors the C++ struct.
+cbuffer CBTransition : register(b0)
+{
+    float progress;
+    float mode;
+    float softness;
+    float hasMask;
+    float2 direction;
+    float2 padding;
+};
+
+Texture2D fromTex : register(t0);
+Texture2D toTex : register(t1);
+Texture2D maskTex : register(t2);
+SamplerState samp : register(s0);
+
+struct PS_INPUT
+{
+    float4 pos : SV_POSITION;
+    float2 uv : TEXCOORD;
+};
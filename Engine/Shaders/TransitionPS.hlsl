@@ -0,0 +1,30 @@
+// Engine/Shaders/TransitionPS.hlsl
+// Blends the outgoing (t0) and incoming (t1) scenes. Both are premultiplied, so a plain
+// lerp is a correct dissolve.
+#include "Transition.hlsli"
+
+float4 PS(PS_INPUT input) : SV_Target
+{
+    // Mix
+    if (mode < 1.5f)
+        return lerp(fromTex.Sample(samp, input.uv), toTex.Sample(samp, input.uv), progress);
+
+    // Push: both scenes move by progress along direction, the incoming one a screen behind.
+    // Both are sampled before the per-pixel select so no Sample sits in divergent flow
+    // control (its derivatives would be undefined along the seam).
+    if (mode < 2.5f)
+    {
+        float2 fromUV = input.uv - direction * progress;
+        float4 from = fromTex.Sample(samp, fromUV);
+        float4 to = toTex.Sample(samp, fromUV + direction);
+        return all(fromUV >= 0.0f) && all(fromUV <= 1.0f) ? from : to;
+    }
+
+    // Wipe: a pixel switches once progress passes its threshold, blended across softness
+    float threshold = hasMask > 0.5f
+        ? dot(maskTex.Sample(samp, input.uv).rgb, float3(0.2126f, 0.7152f, 0.0722f))
+        : dot(input.uv - 0.5f, direction) + 0.5f;
+    float edge = progress * (1.0f + softness);
+    float amount = softness > 0.0f ? saturate((edge - threshold) / softness) : (edge > threshold ? 1.0f : 0.0f);
+    return lerp(fromTex.Sample(samp, input.uv), toTex.Sample(samp, input.uv), amount);
+}
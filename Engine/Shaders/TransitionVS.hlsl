@@ -0,0 +1,11 @@
+// Engine/Shaders/TransitionVS.hlsl
+// One full-screen triangle from SV_VertexID, no vertex buffer
+#include "Transition.hlsli"
+
+PS_INPUT VS(uint id : SV_VertexID)
+{
+    PS_INPUT output;
+    output.uv = float2((id << 1) & 2, id & 2);
+    output.pos = float4(output.uv * float2(2.0f, -2.0f) + float2(-1.0f, 1.0f), 0.0f, 1.0f);
+    return output;
+}
@@ -0,0 +1,258 @@
+// Engine/SharedMemory.cpp
+#include "SharedMemory.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <sddl.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+// POSIX shared memory names must start with a single '/' and contain no other '/'
+static std::string MakePosixName(const char* name)
+{
+    std::string result = "/";
+    for (const char* p = name; *p; p++)
+        result += (*p == '/' || *p == '\\') ? '_' : *p;
+    return result;
+}
+#endif
+
+DaroSharedMemory::DaroSharedMemory() {}
+
+DaroSharedMemory::~DaroSharedMemory()
+{
+    Close();
+}
+
+#ifdef _WIN32
+
+static std::wstring MakeWideName(const char* name)
+{
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, name, -1, nullptr, 0);
+    if (wlen <= 0) return std::wstring();
+    std::wstring wname(wlen, 0);
+    MultiByteToWideChar(CP_UTF8, 0, name, -1, &wname[0], wlen);
+    wname.resize(wlen - 1);
+    return wname;
+}
+
+DaroShmResult DaroSharedMemory::Create(const char* name, size_t size)
+{
+    Close();
+    if (!name || !name[0] || size == 0) return DARO_SHM_FAILED;
+
+    std::wstring wname = MakeWideName(name);
+    if (wname.empty()) return DARO_SHM_FAILED;
+
+    // Same access policy as DaroFrameBuffer: only the creating user
+    SECURITY_ATTRIBUTES sa = {};
+    sa.nLength = sizeof(sa);
+    sa.bInheritHandle = FALSE;
+    if (!ConvertStringSecurityDescriptorToSecurityDescriptorW(
+            L"D:(A;;GA;;;CO)", SDDL_REVISION_1, &sa.lpSecurityDescriptor, nullptr))
+    {
+        sa.lpSecurityDescriptor = nullptr;
+    }
+
+    HANDLE hMap = CreateFileMappingW(
+        INVALID_HANDLE_VALUE,
+        sa.lpSecurityDescriptor ? &sa : nullptr,
+        PAGE_READWRITE,
+        (DWORD)((unsigned long long)size >> 32),
+        (DWORD)(size & 0xFFFFFFFF),
+        wname.c_str());
+    bool existed = (GetLastError() == ERROR_ALREADY_EXISTS);
+
+    if (sa.lpSecurityDescriptor)
+        LocalFree(sa.lpSecurityDescriptor);
+
+    if (!hMap) return DARO_SHM_FAILED;
+
+    void* pView = MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (!pView)
+    {
+        CloseHandle(hMap);
+        return DARO_SHM_FAILED;
+    }
+
+    // An existing mapping keeps its original size - make sure it is large enough
+    MEMORY_BASIC_INFORMATION mbi = {};
+    if (!VirtualQuery(pView, &mbi, sizeof(mbi)) || mbi.RegionSize < size)
+    {
+        UnmapViewOfFile(pView);
+        CloseHandle(hMap);
+        return DARO_SHM_FAILED;
+    }
+
+    m_hMap = hMap;
+    m_pData = pView;
+    m_Size = size;
+    m_Name = name;
+    m_Created = !existed;
+    return existed ? DARO_SHM_OPENED : DARO_SHM_CREATED;
+}
+
+bool DaroSharedMemory::Open(const char* name)
+{
+    Close();
+    if (!name || !name[0]) return false;
+
+    std::wstring wname = MakeWideName(name);
+    if (wname.empty()) return false;
+
+    HANDLE hMap = OpenFileMappingW(FILE_MAP_ALL_ACCESS, FALSE, wname.c_str());
+    if (!hMap) return false;
+
+    void* pView = MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (!pView)
+    {
+        CloseHandle(hMap);
+        return false;
+    }
+
+    MEMORY_BASIC_INFORMATION mbi = {};
+    VirtualQuery(pView, &mbi, sizeof(mbi));
+
+    m_hMap = hMap;
+    m_pData = pView;
+    m_Size = mbi.RegionSize;
+    m_Name = name;
+    m_Created = false;
+    return true;
+}
+
+void DaroSharedMemory::Close()
+{
+    // File mappings are reference counted by the kernel - nothing to unlink
+    if (m_pData)
+    {
+        UnmapViewOfFile(m_pData);
+        m_pData = nullptr;
+    }
+    if (m_hMap)
+    {
+        CloseHandle((HANDLE)m_hMap);
+        m_hMap = nullptr;
+    }
+    m_Size = 0;
+    m_Name.clear();
+    m_Created = false;
+}
+
+#else // POSIX
+
+DaroShmResult DaroSharedMemory::Create(const char* name, size_t size)
+{
+    Close();
+    if (!name || !name[0] || size == 0) return DARO_SHM_FAILED;
+
+    std::string posixName = MakePosixName(name);
+    bool created = true;
+    int fd = shm_open(posixName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+    {
+        created = false;
+        fd = shm_open(posixName.c_str(), O_RDWR, 0600);
+        if (fd < 0) return DARO_SHM_FAILED;
+    }
+
+    struct stat st = {};
+    if (created)
+    {
+        if (ftruncate(fd, (off_t)size) != 0)
+        {
+            close(fd);
+            shm_unlink(posixName.c_str());
+            return DARO_SHM_FAILED;
+        }
+    }
+    else if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return DARO_SHM_FAILED;
+    }
+    else if ((size_t)st.st_size < size)
+    {
+        // Left behind by a crashed sender with a smaller format. Grow it in place - views
+        // other processes still hold stay valid, and they detect the reset via the header.
+        if (ftruncate(fd, (off_t)size) != 0)
+        {
+            close(fd);
+            return DARO_SHM_FAILED;
+        }
+    }
+
+    void* pView = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pView == MAP_FAILED)
+    {
+        close(fd);
+        if (created) shm_unlink(posixName.c_str());
+        return DARO_SHM_FAILED;
+    }
+
+    m_Fd = fd;
+    m_pData = pView;
+    m_Size = size;
+    m_Name = name;
+    m_Created = created;
+    return created ? DARO_SHM_CREATED : DARO_SHM_OPENED;
+}
+
+bool DaroSharedMemory::Open(const char* name)
+{
+    Close();
+    if (!name || !name[0]) return false;
+
+    std::string posixName = MakePosixName(name);
+    int fd = shm_open(posixName.c_str(), O_RDWR, 0600);
+    if (fd < 0) return false;
+
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* pView = mmap(nullptr, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pView == MAP_FAILED)
+    {
+        close(fd);
+        return false;
+    }
+
+    m_Fd = fd;
+    m_pData = pView;
+    m_Size = (size_t)st.st_size;
+    m_Name = name;
+    m_Created = false;
+    return true;
+}
+
+void DaroSharedMemory::Close()
+{
+    if (m_pData)
+    {
+        munmap(m_pData, m_Size);
+        m_pData = nullptr;
+    }
+    if (m_Fd >= 0)
+    {
+        close(m_Fd);
+        m_Fd = -1;
+    }
+    // Mapped views in other processes stay valid after unlink
+    if (m_Created && m_UnlinkOnClose && !m_Name.empty())
+        shm_unlink(MakePosixName(m_Name.c_str()).c_str());
+
+    m_Size = 0;
+    m_Name.clear();
+    m_Created = false;
+}
+
+#endif // _WIN32
@@ -0,0 +1,58 @@
+// Engine/SharedMemory.h
+// Portable named shared memory segment.
+// Windows uses a pagefile-backed file mapping (like SpoutSharedMemory and DaroFrameBuffer),
+// POSIX uses shm_open + mmap. Unlike SpoutSharedMemory there is no map mutex - everything
+// placed in these segments synchronizes through lock-free atomics instead.
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+enum DaroShmResult
+{
+    DARO_SHM_FAILED = 0,
+    DARO_SHM_CREATED,   // New segment created by this call
+    DARO_SHM_OPENED,    // Segment already existed and was attached to
+};
+
+class DaroSharedMemory
+{
+public:
+    DaroSharedMemory();
+    ~DaroSharedMemory();
+
+    DaroSharedMemory(const DaroSharedMemory&) = delete;
+    DaroSharedMemory& operator=(const DaroSharedMemory&) = delete;
+
+    // Create a new segment, or attach to an existing one. On POSIX an existing segment
+    // smaller than size is grown; a Windows mapping cannot grow, so there it is a failure
+    // (it only outlives its creator while another process still has it mapped).
+    DaroShmResult Create(const char* name, size_t size);
+
+    // Open an existing segment; the size is taken from the segment itself
+    bool Open(const char* name);
+
+    // Unmap and close. A segment created by this object is also unlinked on POSIX
+    // when unlinkOnClose is set, so stale names do not outlive the sender.
+    void Close();
+
+    void* Data() const { return m_pData; }
+    size_t Size() const { return m_Size; }
+    const std::string& Name() const { return m_Name; }
+    bool IsOpen() const { return m_pData != nullptr; }
+
+    void SetUnlinkOnClose(bool unlink) { m_UnlinkOnClose = unlink; }
+
+private:
+    void* m_pData = nullptr;
+    size_t m_Size = 0;
+    std::string m_Name;
+    bool m_Created = false;
+    bool m_UnlinkOnClose = false;
+
+#ifdef _WIN32
+    void* m_hMap = nullptr;     // HANDLE
+#else
+    int m_Fd = -1;
+#endif
+};
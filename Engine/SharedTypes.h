@@ -81,3 +81,481 @@ struct DaroLayer
 #ifdef _WIN32
 static_assert(sizeof(DaroLayer) == 2832, "DaroLayer size mismatch! Check struct alignment with C# DaroLayerNative.");
 #endif
+
+// Spout receiver statistics - must match C# DaroSpoutReceiverStats
+#pragma pack(push, 1)
+struct DaroSpoutReceiverStats
+{
+    int connected;
+    int width;
+    int height;
+    int senderFrame;            // Last frame number reported by the sender (0 if not counted)
+    double senderFps;
+    long long newFrames;        // Sender frames copied into the layer texture
+    long long repeatedFrames;   // Render frames where the sender frame was unchanged (copy skipped)
+    long long skippedFrames;    // Render frames where no active layer referenced the receiver
+};
+#pragma pack(pop)
+
+// Per-frame output metadata carried next to the Spout sender - must match C# DaroFrameMetadata
+#define DARO_METADATA_NAME 64
+
+// Set in a packed timecode counted in SMPTE drop-frame numbering (hh:mm:ss;ff)
+#define DARO_TIMECODE_DROP_FRAME 0x80000000u
+
+#pragma pack(push, 1)
+struct DaroFrameMetadata
+{
+    long long spoutFrame;                   // Spout sender frame count this record belongs to
+    long long engineFrame;                  // Engine frame number
+    long long timestampNs;                  // Sender steady clock at send
+    int timecode;                           // SMPTE hh:mm:ss:ff packed as 0xHHMMSSFF, plus DARO_TIMECODE_DROP_FRAME
+    char templateName[DARO_METADATA_NAME];  // Template on air (UTF-8)
+    char itemName[DARO_METADATA_NAME];      // Playlist item on air (UTF-8)
+};
+#pragma pack(pop)
+
+// Asynchronous Spout output statistics - must match C# DaroSpoutOutputStats
+#pragma pack(push, 1)
+struct DaroSpoutOutputStats
+{
+    int running;
+    int timeoutMs;                  // Frames older than this are dropped before sending
+    long long sentFrames;           // Frames copied to the Spout shared texture
+    long long overwrittenFrames;    // Replaced by a newer frame before the send thread got to them
+    long long staleFrames;          // Dropped for exceeding timeoutMs
+    long long accessTimeouts;       // Send skipped because a receiver held the shared texture
+    double lastSendMs;              // Duration of the last SendTexture on the send thread
+    double maxSendMs;
+};
+#pragma pack(pop)
+
+// Per-stage frame timing - must match C# DaroFrameStats
+#define DARO_STAGE_BEGIN_LOCK_WAIT      0   // Daro_BeginFrame waiting for g_Mutex
+#define DARO_STAGE_SPOUT_RECEIVE        1   // Spout input textures
+#define DARO_STAGE_VIDEO_DECODE         2   // Video frame updates
+#define DARO_STAGE_RENDER_LOCK_WAIT     3   // Daro_Render waiting for g_Mutex
+#define DARO_STAGE_LAYER_COPY           4   // Layer snapshot and mask lookup
+#define DARO_STAGE_DRAW                 5   // Clear + RenderWithMasks draw submission (excluding text)
+#define DARO_STAGE_TEXT                 6   // Direct2D/DirectWrite text
+#define DARO_STAGE_GPU_WAIT             7   // WaitForGPU after drawing
+#define DARO_STAGE_READBACK             8   // CopyToStaging + Map
+#define DARO_STAGE_FRAMEBUFFER_WAIT     9   // DaroFrameBuffer waiting for a reader to unlock
+#define DARO_STAGE_FRAMEBUFFER_WRITE    10  // DaroFrameBuffer copy
+#define DARO_STAGE_TRANSPORT            11  // CPU frame transport publish
+#define DARO_STAGE_PRESENT_LOCK_WAIT    12  // Daro_Present waiting for g_Mutex
+#define DARO_STAGE_PRESENT              13  // Spout output enqueue
+#define DARO_STAGE_PREVIEW              14  // Preview slot render and readback (text and GPU wait excluded)
+#define DARO_STAGE_COUNT                16  // Room for new stages without changing the record size
+
+#pragma pack(push, 1)
+struct DaroFrameStats
+{
+    long long frameNumber;
+    double frameIntervalMs;                 // Daro_EndFrame to Daro_EndFrame
+    double busyMs;                          // Daro_BeginFrame to Daro_EndFrame
+    double stageMs[DARO_STAGE_COUNT];       // Time per DARO_STAGE_*, accumulated over the frame
+};
+#pragma pack(pop)
+
+// Frame-time distributions (Daro_GetTimingSummary)
+#define DARO_TIMING_FRAME_INTERVAL      0   // Daro_EndFrame to Daro_EndFrame
+#define DARO_TIMING_RENDER              1   // Daro_BeginFrame to Daro_EndFrame
+#define DARO_TIMING_OUTPUT_LATENCY      2   // Daro_BeginFrame to Spout send complete
+#define DARO_TIMING_METRIC_COUNT        3
+
+#define DARO_TIMING_SINCE_RESET         0   // Everything since the last Daro_ResetTimingStats
+#define DARO_TIMING_LAST_WINDOW         1   // Last completed window (Daro_SetTimingWindow)
+
+#define DARO_TIMING_DEFAULT_WINDOW_MS   10000
+
+// Must match C# DaroTimingSummary
+#pragma pack(push, 1)
+struct DaroTimingSummary
+{
+    long long count;
+    double meanMs;
+    double p50Ms;
+    double p95Ms;
+    double p99Ms;
+    double p999Ms;
+    double maxMs;
+};
+#pragma pack(pop)
+
+// Render paths a layer went through (DaroLayerCost::paths flags)
+#define DARO_COST_PATH_QUAD             0x01    // D3D11 textured/colored quad
+#define DARO_COST_PATH_D2D_TEXT         0x02    // Direct2D/DirectWrite text
+#define DARO_COST_PATH_D2D_CIRCLE       0x04    // Direct2D ellipse
+#define DARO_COST_PATH_STENCIL_MASK     0x08    // Mask written to the stencil buffer
+#define DARO_COST_PATH_GEOMETRY_MASK    0x10    // Text clipped by a D2D mask geometry
+#define DARO_COST_PATH_BOUNDS           0x20    // Bounding box overlay
+
+// Must match C# DaroLayerCost
+#pragma pack(push, 1)
+struct DaroLayerCost
+{
+    int layerId;
+    int layerType;
+    int paths;                              // DARO_COST_PATH_* flags
+    int stateChanges;                       // D3D11 state sets and constant buffer updates
+    int flushes;                            // ID3D11DeviceContext::Flush calls
+    int drawCalls;                          // D3D11 draws plus D2D EndDraw batches
+    double cpuMs;                           // Submission time on the render thread
+    double gpuMs;                           // Timestamp query delta, -1 if unavailable
+};
+#pragma pack(pop)
+
+// Memory accounting categories (Daro_GetMemoryStats)
+#define DARO_MEM_ALL                    -1  // Totals across categories
+#define DARO_MEM_TEXTURES               0   // Image textures, keyed by texture id
+#define DARO_MEM_VIDEO                  1   // Video textures and decoder frame buffers, keyed by video id
+#define DARO_MEM_SPOUT_INPUT            2   // Spout receiver textures, keyed by receiver id
+#define DARO_MEM_SPOUT_OUTPUT           3   // Spout output stage buffers
+#define DARO_MEM_RENDER_TARGETS         4   // Render target, depth-stencil and readback staging
+#define DARO_MEM_FRAME_BUFFER           5   // Shared-memory frame buffer
+#define DARO_MEM_FRAME_TRANSPORT        6   // CPU frame transport segment
+#define DARO_MEM_CATEGORY_COUNT         7
+
+// Must match C# DaroMemoryStats
+#pragma pack(push, 1)
+struct DaroMemoryStats
+{
+    int category;                           // DARO_MEM_* or DARO_MEM_ALL
+    int assetCount;
+    long long cpuBytes;
+    long long gpuBytes;
+    long long peakCpuBytes;
+    long long peakGpuBytes;
+    long long peakBytes;                    // Peak of cpuBytes + gpuBytes
+    long long budgetBytes;                  // 0 = no budget
+    int overBudget;                         // cpuBytes + gpuBytes > budgetBytes
+    int budgetWarnings;                     // Times the budget was crossed since the last peak reset
+};
+
+// Must match C# DaroMemoryAsset
+struct DaroMemoryAsset
+{
+    int category;
+    int assetId;
+    long long cpuBytes;
+    long long gpuBytes;
+};
+#pragma pack(pop)
+
+// Trace file formats (Daro_WriteTrace)
+#define DARO_TRACE_FORMAT_JSON          0   // Chrome trace event JSON
+#define DARO_TRACE_FORMAT_PERFETTO      1   // Perfetto protobuf trace
+
+// Native render loop statistics (Daro_GetRenderLoopStats) - must match C# DaroRenderLoopStats
+#pragma pack(push, 1)
+struct DaroRenderLoopStats
+{
+    int running;
+    int virtualClock;               // Last frame advanced the virtual clock instead of waiting
+    double fps;
+    long long frames;               // Frames rendered since Daro_StartRenderLoop
+    long long missedDeadlines;      // Deadlines skipped because a frame ran a full period late
+    double wakeLateMeanMs;          // Wake-up after the frame deadline (real clock only)
+    double wakeLateP99Ms;
+    double wakeLateMaxMs;
+    double lastFrameMs;             // Begin to end of the last frame on the loop thread
+    double maxFrameMs;
+};
+#pragma pack(pop)
+
+// Genlock state of the native render loop (DaroGenlockStats::state)
+#define DARO_GENLOCK_FREE_RUN       0   // No external clock set
+#define DARO_GENLOCK_NO_REFERENCE   1   // Set, but the block is missing or ticks stopped: holding the last rate
+#define DARO_GENLOCK_ACQUIRING      2   // Pulling in after a phase jump
+#define DARO_GENLOCK_LOCKED         3   // Phase error within DARO_GENLOCK_LOCKED_NS
+
+// Genlock statistics (Daro_GetGenlockStats) - must match C# DaroGenlockStats
+#pragma pack(push, 1)
+struct DaroGenlockStats
+{
+    int state;                      // DARO_GENLOCK_*
+    long long ticks;                // Reference tick counter last read
+    long long relocks;              // Hard phase jumps (acquisition, reference phase change)
+    long long referenceLost;        // Times the reference stopped ticking
+    double referenceFps;            // Measured from tick times since the last relock
+    double correctionPpm;           // Rate trim applied to the loop; positive runs faster than nominal
+    double phaseErrorMs;            // Last frame deadline minus the nearest reference tick
+    double phaseErrorMeanMs;        // Absolute phase error since the external clock was set
+    double phaseErrorP99Ms;
+    double phaseErrorMaxMs;
+};
+#pragma pack(pop)
+
+// Scene slots (Daro_*Scene*). The program slot is on air; hosts build the next scene in
+// another slot and take it, which only changes which slot the next frame reads.
+#define DARO_SCENE_SLOTS        4
+#define DARO_SCENE_PROGRAM      -1  // Slot argument naming whichever slot is on air
+#define DARO_PREVIEW_MAX_DIVISOR 8  // Preview output size divisor: 1, 2, 4 or 8
+
+// Scene transitions (Daro_TransitionScene). A transition takes a slot like Daro_TakeScene
+// and blends the old program into it over durationFrames output frames. Progress follows
+// the engine frame counter, so a transition runs to its end without the host.
+#define DARO_TRANSITION_CUT     0
+#define DARO_TRANSITION_MIX     1   // Cross-dissolve
+#define DARO_TRANSITION_PUSH    2   // The incoming scene pushes the outgoing one out
+#define DARO_TRANSITION_WIPE    3   // Straight edge, or in the order of a mask texture's luminance
+#define DARO_TRANSITION_COUNT   4
+
+#define DARO_EASE_LINEAR        0
+#define DARO_EASE_IN            1   // Cubic
+#define DARO_EASE_OUT           2
+#define DARO_EASE_IN_OUT        3
+#define DARO_EASE_COUNT         4
+
+// Direction the incoming scene moves (push) or the wipe edge travels
+#define DARO_DIRECTION_LEFT     0
+#define DARO_DIRECTION_RIGHT    1
+#define DARO_DIRECTION_UP       2
+#define DARO_DIRECTION_DOWN     3
+#define DARO_DIRECTION_COUNT    4
+
+#pragma pack(push, 1)
+// Scene transition (Daro_TransitionScene) - must match C# DaroTransition
+struct DaroTransition
+{
+    int type;                       // DARO_TRANSITION_*
+    int durationFrames;             // Output frames; the last shows only the incoming scene. 0 or 1 cuts.
+    int easing;                     // DARO_EASE_*
+    int direction;                  // DARO_DIRECTION_* (push and edge wipe)
+    int maskTextureId;              // Wipe: dark pixels of this texture switch first; 0 = edge wipe
+    float softness;                 // Wipe edge width as a fraction of the wipe, 0..1 (0 = hard)
+};
+
+// Transition state (Daro_GetTransitionState) - must match C# DaroTransitionState
+struct DaroTransitionState
+{
+    int active;                     // 1 while frames are blended
+    int fromSlot;                   // Outgoing scene
+    int toSlot;                     // Incoming scene, already the program slot
+    int type;                       // DARO_TRANSITION_*
+    int frame;                      // Transition frame of the current engine frame, 1..durationFrames
+    int durationFrames;
+    float progress;                 // Eased, 0..1
+    long long startFrame;           // Engine frame showing transition frame 1
+    long long completed;            // Transitions run to their end since Daro_Initialize
+    long long interrupted;          // Ended early by a take or another transition
+};
+#pragma pack(pop)
+
+// Scene timelines (Daro_*Timeline). Every scene slot has a timeline of keyframe tracks on
+// its layers' fields. While it plays the engine steps it once per output frame and sets the
+// tracked fields itself, so an in - hold/loop - out graphic needs no host calls between
+// takes. Markers hold the playhead (stop), repeat a region (loop) or move it (jump);
+// Daro_ContinueTimeline releases a stop or loop so the next frame shows the one after it.
+#define DARO_TIMELINE_MAX_MARKERS   64
+#define DARO_TIMELINE_MAX_TRACKS    1024
+#define DARO_TIMELINE_MAX_KEYFRAMES 65536   // Per track
+#define DARO_TIMELINE_DEFAULT_LENGTH 250
+
+#define DARO_MARKER_STOP        0   // Hold on this frame until continued
+#define DARO_MARKER_LOOP        1   // After this frame go back to target, the loop start, until continued
+#define DARO_MARKER_JUMP        2   // After this frame go to target
+#define DARO_MARKER_COUNT       3
+
+// Animatable layer fields. Clamped like the Designer's animation: opacity and colour
+// 0..1, font size >= 1, line height >= 0.1; DARO_FIELD_VISIBLE sets active above 0.5.
+#define DARO_FIELD_POS_X        0
+#define DARO_FIELD_POS_Y        1
+#define DARO_FIELD_SIZE_X       2
+#define DARO_FIELD_SIZE_Y       3
+#define DARO_FIELD_ROT_X        4
+#define DARO_FIELD_ROT_Y        5
+#define DARO_FIELD_ROT_Z        6
+#define DARO_FIELD_OPACITY      7
+#define DARO_FIELD_COLOR_R      8
+#define DARO_FIELD_COLOR_G      9
+#define DARO_FIELD_COLOR_B      10
+#define DARO_FIELD_VISIBLE      11
+#define DARO_FIELD_FONT_SIZE    12
+#define DARO_FIELD_LINE_HEIGHT  13
+#define DARO_FIELD_LETTER_SPACING 14
+#define DARO_FIELD_TEX_X        15
+#define DARO_FIELD_TEX_Y        16
+#define DARO_FIELD_TEX_W        17
+#define DARO_FIELD_TEX_H        18
+#define DARO_FIELD_TEX_ROT      19
+#define DARO_FIELD_COUNT        20
+
+#pragma pack(push, 1)
+// Keyframe of a timeline track - must match C# DaroKeyframe. Eases as the Designer's
+// keyframes: easeOut accelerates away from this keyframe, the next one's easeIn decelerates
+// into it, both 0 is linear.
+struct DaroKeyframe
+{
+    int frame;
+    float value;
+    float easeIn;                   // 0..1
+    float easeOut;                  // 0..1
+};
+
+// Timeline marker - must match C# DaroTimelineMarker
+struct DaroTimelineMarker
+{
+    int frame;                      // One marker per frame
+    int type;                       // DARO_MARKER_*
+    int target;                     // Loop start or jump destination; unused by stop
+};
+
+// Timeline state (Daro_GetTimelineState) - must match C# DaroTimelineState
+struct DaroTimelineState
+{
+    int playing;
+    int frame;                      // Frame the next output frame shows
+    int lastFrame;                  // Frame the last output frame showed, -1 if none yet
+    int length;                     // Frames; the playhead stops on the last one
+    int held;                       // 1 while playing and held by a stop marker
+    int looping;                    // 1 while playing inside a loop region
+    int continuePending;            // A continue will pass the next stop or loop
+    int trackCount;
+    int markerCount;
+    long long loops;                // Times a loop marker sent the playhead back
+};
+#pragma pack(pop)
+
+// Data binding store (Daro_*Data*). Live values by key - scores, counts, ticker text -
+// that layer fields bind to. Writes only mark keys changed; Daro_BeginFrame writes each
+// changed key into its bound fields once, however often it changed since the last frame.
+#define DARO_DATA_MAX_KEYS      4096
+#define DARO_DATA_KEY_SIZE      64      // Key names, including the NUL
+#define DARO_DATA_MAX_BINDINGS  4096
+#define DARO_FIELD_TEXT         32      // Binding target: the layer's text (not animatable)
+
+#define DARO_DATA_NONE          0       // Key without a value yet
+#define DARO_DATA_NUMBER        1
+#define DARO_DATA_TEXT          2
+
+#pragma pack(push, 1)
+// Data store statistics (Daro_GetDataStoreStats) - must match C# DaroDataStoreStats
+struct DaroDataStoreStats
+{
+    long long writes;               // Values written, by the API and the ingest region
+    long long unchanged;            // Writes of the value the key already had (dropped)
+    long long coalesced;            // Changes overwritten before a frame applied them
+    long long applies;              // Frames that wrote bound fields
+    long long fieldsApplied;        // Bound field writes
+    long long layersDirtied;        // Layers changed by applies
+    long long ingestScans;          // Ingest region scans (only after a producer wrote)
+    long long ingestTornReads;      // Entries caught mid-write, read again next frame
+    int keyCount;
+    int bindingCount;
+    int ingestEntries;              // 0 while no ingest region is open
+    int lastLayersDirtied;          // Layers changed by the last apply
+};
+#pragma pack(pop)
+
+// Frame-accurate command queue (Daro_Queue*): when a command is applied
+#define DARO_WHEN_IMMEDIATE     0   // Start of the next frame that begins
+#define DARO_WHEN_NEXT_FRAME    1   // Frame the next Daro_BeginFrame starts, never the one being rendered
+#define DARO_WHEN_FRAME         2   // Absolute frame number (Daro_GetFrameNumber)
+#define DARO_WHEN_TIMECODE      3   // Packed output timecode 0xHHMMSSFF, nearest occurrence
+
+// Queued command types (Daro_QueueCommand; layer updates use Daro_QueueLayerUpdate)
+#define DARO_CMD_UPDATE_LAYER   0   // target = layer index
+#define DARO_CMD_SET_LAYER_COUNT 1  // value = count
+#define DARO_CMD_CLEAR_LAYERS   2
+#define DARO_CMD_PLAY_VIDEO     3   // target = video id
+#define DARO_CMD_PAUSE_VIDEO    4
+#define DARO_CMD_STOP_VIDEO     5
+#define DARO_CMD_SEEK_VIDEO     6   // target = video id, value = frame
+#define DARO_CMD_SEEK_VIDEO_TIME 7  // target = video id, value = nanoseconds
+#define DARO_CMD_SET_VIDEO_LOOP 8   // target = video id, value = 0 or 1
+#define DARO_CMD_SET_VIDEO_ALPHA 9  // target = video id, value = 0 or 1
+#define DARO_CMD_TAKE_SCENE     10  // target = scene slot (Daro_TakeScene)
+#define DARO_CMD_TRANSITION_SCENE 11 // target = scene slot (Daro_QueueTransition)
+#define DARO_CMD_PLAY_TIMELINE  12  // target = scene slot
+#define DARO_CMD_STOP_TIMELINE  13  // target = scene slot
+#define DARO_CMD_SEEK_TIMELINE  14  // target = scene slot, value = frame
+#define DARO_CMD_CONTINUE_TIMELINE 15 // target = scene slot
+#define DARO_CMD_COUNT          16
+
+// Command queue statistics (Daro_GetCommandQueueStats) - must match C# DaroCommandQueueStats
+#pragma pack(push, 1)
+struct DaroCommandQueueStats
+{
+    long long queued;               // Commands accepted since Daro_Initialize
+    long long applied;
+    long long pending;              // Waiting for their frame
+    long long late;                 // Applied after their target frame
+    long long maxLateFrames;        // Largest miss
+    long long lastLateId;           // Id of the most recent late command, 0 if none
+    long long lastLateFrame;        // Frame it was applied in
+    long long lastAppliedId;
+};
+#pragma pack(pop)
+
+// Binary command buffer (Daro_Submit): a DaroSubmitHeader followed by commandCount
+// records, each a DaroSubmitRecord and its payload. Little endian, no padding.
+#define DARO_SUBMIT_MAGIC       0x444D4344u     // "DCMD"
+#define DARO_SUBMIT_VERSION     1
+#define DARO_SUBMIT_MAX_COMMANDS 65536
+
+// Header flags
+#define DARO_SUBMIT_QUEUED      1   // Queue the commands for header.when/at (DARO_WHEN_*) instead of running them now
+
+// Record ops and their payloads (i32 = int, f64 = double, str = UTF-8 NUL terminated).
+// A payload may be longer than listed (fields appended by later versions); unknown ops
+// are skipped.
+#define DARO_OP_SET_LAYER_COUNT     1   // i32 count
+#define DARO_OP_UPDATE_LAYER        2   // i32 index, DaroLayer
+#define DARO_OP_CLEAR_LAYERS        3
+#define DARO_OP_LOAD_TEXTURE        4   // str path; result = texture id
+#define DARO_OP_UNLOAD_TEXTURE      5   // i32 texture id
+#define DARO_OP_LOAD_VIDEO          6   // str path; result = video id
+#define DARO_OP_UNLOAD_VIDEO        7   // i32 video id
+#define DARO_OP_PLAY_VIDEO          8   // i32 video id
+#define DARO_OP_PAUSE_VIDEO         9   // i32 video id
+#define DARO_OP_STOP_VIDEO          10  // i32 video id
+#define DARO_OP_SEEK_VIDEO          11  // i32 video id, i32 frame
+#define DARO_OP_SEEK_VIDEO_TIME     12  // i32 video id, f64 seconds
+#define DARO_OP_SET_VIDEO_LOOP      13  // i32 video id, i32 loop
+#define DARO_OP_SET_VIDEO_ALPHA     14  // i32 video id, i32 alpha
+#define DARO_OP_SET_OUTPUT_METADATA 15  // str template name, str item name
+#define DARO_OP_PLAY                16  // Timeline of the edited slot
+#define DARO_OP_STOP                17
+#define DARO_OP_SEEK_TO_FRAME       18  // i32 frame
+#define DARO_OP_EDIT_SCENE          19  // i32 scene slot; the layer and timeline ops after it edit that slot
+#define DARO_OP_TAKE_SCENE          20  // i32 scene slot
+#define DARO_OP_TRANSITION_SCENE    21  // i32 scene slot, DaroTransition
+#define DARO_OP_CONTINUE_TIMELINE   22
+
+// A texture or video id operand (and DaroLayer::textureId of DARO_OP_UPDATE_LAYER and the
+// mask of DARO_OP_TRANSITION_SCENE) may name the id returned by an earlier load in the
+// same buffer instead
+#define DARO_SUBMIT_REF_BASE    (-0x7FFFFFFF - 1)
+#define DARO_SUBMIT_REF(index)  (DARO_SUBMIT_REF_BASE + (index))
+
+// Per-command results: >= 0 on success (the id for loads), else one of these
+#define DARO_SUBMIT_OK                  0
+#define DARO_SUBMIT_ERROR_NOT_RUN       -1  // The buffer was rejected as a whole
+#define DARO_SUBMIT_ERROR_UNKNOWN_OP    -2
+#define DARO_SUBMIT_ERROR_MALFORMED     -3  // Payload too short or string not terminated
+#define DARO_SUBMIT_ERROR_INVALID       -4  // Argument out of range or unresolved reference
+#define DARO_SUBMIT_ERROR_FAILED        -5  // Load failed or engine not initialized
+#define DARO_SUBMIT_ERROR_NOT_QUEUEABLE -6  // Op cannot run from the command queue
+
+#pragma pack(push, 1)
+struct DaroSubmitHeader
+{
+    unsigned int magic;             // DARO_SUBMIT_MAGIC
+    unsigned short version;         // DARO_SUBMIT_VERSION
+    unsigned short headerSize;      // Records start here
+    unsigned int commandCount;
+    unsigned int flags;             // DARO_SUBMIT_*
+    int when;                       // DARO_WHEN_*, with DARO_SUBMIT_QUEUED
+    int reserved;
+    long long at;
+};
+
+struct DaroSubmitRecord
+{
+    unsigned short op;              // DARO_OP_*
+    unsigned short reserved;
+    unsigned int size;              // Including this record header
+};
+#pragma pack(pop)
@@ -0,0 +1,250 @@
+// Engine/SpoutOutput.cpp
+#include "SpoutOutput.h"
+#include "FrameTransport.h"     // DaroTransportNowNs
+#include "FrameStats.h"
+#include "MemoryStats.h"
+#include "Trace.h"
+#include <Windows.h>
+
+static long long QueryTicks()
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return now.QuadPart;
+}
+
+// Same steps as spoutDX::SendTexture; only the context calls are locked
+bool DaroSpoutSender::SendTextureLocked(ID3D11Texture2D* texture, ID2D1Multithread* d2dLock)
+{
+    if (!texture || !OpenDirectX11()) return false;
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    texture->GetDesc(&desc);
+    if (desc.Width == 0 || desc.Height == 0) return false;
+
+    // May recreate the shared texture, which flushes the context
+    d2dLock->Enter();
+    bool ready = CheckSender(desc.Width, desc.Height, (DWORD)desc.Format);
+    d2dLock->Leave();
+    if (!ready) return false;
+
+    // Waits (up to 67 ms) while a receiver holds the texture - without the D2D lock
+    if (frame.CheckTextureAccess(m_pSharedTexture))
+    {
+        d2dLock->Enter();
+        m_pImmediateContext->CopyResource(m_pSharedTexture, texture);
+        m_pImmediateContext->Flush();
+        d2dLock->Leave();
+        frame.SetNewFrame();
+        frame.AllowTextureAccess(m_pSharedTexture);
+    }
+    return true;
+}
+
+DaroSpoutOutput::DaroSpoutOutput() {}
+
+DaroSpoutOutput::~DaroSpoutOutput()
+{
+    Stop();
+}
+
+bool DaroSpoutOutput::Start(ID3D11Device* device, ID3D11DeviceContext* context, ID2D1Multithread* d2dLock,
+                            const char* senderName, int width, int height, DXGI_FORMAT format)
+{
+    Stop();
+    if (!device || !context || !d2dLock || !senderName || senderName[0] == '\0') return false;
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = width;
+    desc.Height = height;
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = format;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    for (auto& buffer : m_Buffers)
+    {
+        buffer.texture.Reset();
+        if (FAILED(device->CreateTexture2D(&desc, nullptr, &buffer.texture)))
+        {
+            OutputDebugStringA("[DaroEngine] Spout output: failed to create output buffer\n");
+            for (auto& b : m_Buffers) b.texture.Reset();
+            return false;
+        }
+    }
+
+    m_Sender.OpenDirectX11(device);
+    m_Sender.SetSenderName(senderName);
+
+    // Metadata is optional - output still works if the ring cannot be created
+    if (!m_Metadata.Create(senderName))
+        OutputDebugStringA("[DaroEngine] Spout metadata ring could not be created\n");
+
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    m_PerfFreq = freq.QuadPart;
+
+    m_Context = context;
+    m_D2DLock = d2dLock;
+    m_StopRequested = false;
+    m_Pending = -1;
+    m_Sending = -1;
+    m_SentFrames = 0;
+    m_OverwrittenFrames = 0;
+    m_StaleFrames = 0;
+    m_AccessTimeouts = 0;
+    m_LastSendMs = 0.0;
+    m_MaxSendMs = 0.0;
+
+    // Output buffers match the renderer's 4-byte render target format
+    DaroMemoryAccountant::Instance().Set(DARO_MEM_SPOUT_OUTPUT, 0, 0,
+        DaroTextureBytes(width, height) * DARO_SPOUT_OUTPUT_BUFFERS);
+
+    m_Thread = std::thread(&DaroSpoutOutput::SendThreadProc, this);
+    m_Running.store(true, std::memory_order_release);
+    return true;
+}
+
+void DaroSpoutOutput::Stop()
+{
+    m_Running.store(false, std::memory_order_release);
+    if (m_Thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_StopRequested = true;
+        }
+        m_Cond.notify_all();
+        // Bounded by the spoutDX access wait (67 ms)
+        m_Thread.join();
+    }
+
+    m_Metadata.Release();
+    // Releasing the shared texture flushes the context; Stop may run off the render thread
+    if (m_D2DLock) m_D2DLock->Enter();
+    m_Sender.ReleaseSender();
+    m_Sender.CloseDirectX11();
+    if (m_D2DLock) m_D2DLock->Leave();
+    for (auto& buffer : m_Buffers) buffer.texture.Reset();
+    m_Context = nullptr;
+    m_D2DLock.Reset();
+    DaroMemoryAccountant::Instance().Remove(DARO_MEM_SPOUT_OUTPUT, 0);
+}
+
+void DaroSpoutOutput::Enqueue(ID3D11Texture2D* source, const DaroFrameMetadata* metadata)
+{
+    if (!source || !IsRunning()) return;
+
+    int target;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        // Never touch the buffer being sent. With two buffers the other one is either
+        // free or holds an unsent frame - which this frame replaces.
+        target = (m_Sending == 0) ? 1 : (m_Sending == 1 ? 0 : (m_Pending >= 0 ? m_Pending : 0));
+        if (m_Pending == target)
+        {
+            m_Pending = -1;
+            m_OverwrittenFrames++;
+        }
+    }
+
+    // GPU copy only - queued on the immediate context ahead of the send thread's
+    // CopyResource, so no CPU wait is needed here
+    m_Context->CopyResource(m_Buffers[target].texture.Get(), source);
+
+    OutputBuffer& buffer = m_Buffers[target];
+    buffer.hasMetadata = (metadata != nullptr);
+    if (metadata) buffer.metadata = *metadata;
+    buffer.enqueueTicks = QueryTicks();
+    buffer.frameStartTicks = DaroFrameProfiler::Instance().GetFrameStart();
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Pending = target;
+    }
+    m_Cond.notify_one();
+}
+
+void DaroSpoutOutput::SendThreadProc()
+{
+    DaroTrace::SetThreadName("Spout send");
+    for (;;)
+    {
+        int index;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Cond.wait(lock, [this] { return m_StopRequested || m_Pending >= 0; });
+            if (m_StopRequested) return;
+            index = m_Pending;
+            m_Pending = -1;
+            m_Sending = index;
+        }
+
+        OutputBuffer& buffer = m_Buffers[index];
+        long long start = QueryTicks();
+        double ageMs = (double)(start - buffer.enqueueTicks) * 1000.0 / (double)m_PerfFreq;
+
+        if (ageMs > (double)m_TimeoutMs.load())
+        {
+            // Stuck behind a previous send for too long - showing it now would only add latency
+            m_StaleFrames++;
+        }
+        else
+        {
+            long frameBefore = m_Sender.GetFrame();
+            {
+                DARO_TRACE_SCOPE("Spout send");
+                m_Sender.SendTextureLocked(buffer.texture.Get(), m_D2DLock.Get());
+            }
+            long frameAfter = m_Sender.GetFrame();
+
+            double sendMs = (double)(QueryTicks() - start) * 1000.0 / (double)m_PerfFreq;
+            m_LastSendMs = sendMs;
+            if (sendMs > m_MaxSendMs.load()) m_MaxSendMs = sendMs;
+
+            // spoutDX skips the copy without reporting it when the access mutex times
+            // out - the frame counter not advancing is the only sign
+            if (m_Sender.IsFrameCountEnabled() && frameAfter == frameBefore)
+            {
+                m_AccessTimeouts++;
+            }
+            else
+            {
+                m_SentFrames++;
+
+                // This thread is the only writer of the output latency histogram
+                long long latencyTicks = QueryTicks() - buffer.frameStartTicks;
+                if (buffer.frameStartTicks > 0 && latencyTicks > 0)
+                    DaroFrameProfiler::Instance().GetTiming(DARO_TIMING_OUTPUT_LATENCY)->Record(
+                        (uint64_t)(latencyTicks * 1000000 / m_PerfFreq));
+
+                if (buffer.hasMetadata && m_Metadata.IsCreated())
+                {
+                    DaroFrameMetadata record = buffer.metadata;
+                    record.spoutFrame = frameAfter;
+                    record.timestampNs = (long long)DaroTransportNowNs();
+                    m_Metadata.Write(record);
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Sending = -1;
+    }
+}
+
+void DaroSpoutOutput::GetStats(DaroSpoutOutputStats* stats) const
+{
+    if (!stats) return;
+    // Called from the stats publisher thread: atomics only
+    stats->running = IsRunning() ? 1 : 0;
+    stats->timeoutMs = m_TimeoutMs.load();
+    stats->sentFrames = m_SentFrames.load();
+    stats->overwrittenFrames = m_OverwrittenFrames.load();
+    stats->staleFrames = m_StaleFrames.load();
+    stats->accessTimeouts = m_AccessTimeouts.load();
+    stats->lastSendMs = m_LastSendMs.load();
+    stats->maxSendMs = m_MaxSendMs.load();
+}
@@ -0,0 +1,97 @@
+// Engine/SpoutOutput.h
+// Asynchronous Spout output stage.
+// spoutDX::SendTexture waits on the sender's access mutex (up to 67 ms) whenever a
+// receiver such as OBS is holding the shared texture. Running that on the render
+// thread stalls the whole engine, so output goes through this stage instead:
+// the render thread copies the finished frame into one of two output textures and
+// returns; a dedicated thread does the Spout send. If the stage falls behind, the
+// newest frame wins and the overwritten one is counted as dropped.
+#pragma once
+
+#include <d3d11.h>
+#include <d2d1_1.h>
+#include <wrl/client.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "SharedTypes.h"
+#include "FrameMetadata.h"
+#include "Spout/SpoutDX.h"
+
+using Microsoft::WRL::ComPtr;
+
+#define DARO_SPOUT_OUTPUT_BUFFERS 2
+#define DARO_SPOUT_DEFAULT_TIMEOUT_MS 100
+
+// spoutDX::SendTexture with the immediate-context work under the Direct2D multithread
+// lock. D2D draws through the same context on the render thread, so the send thread must
+// hold ID2D1Multithread while it copies; it takes it only after the Spout access mutex,
+// so a receiver holding the shared texture never blocks D2D drawing.
+class DaroSpoutSender : public spoutDX
+{
+public:
+    bool SendTextureLocked(ID3D11Texture2D* texture, ID2D1Multithread* d2dLock);
+};
+
+class DaroSpoutOutput
+{
+public:
+    DaroSpoutOutput();
+    ~DaroSpoutOutput();
+
+    // Device must have multithread protection enabled and d2dLock must come from a
+    // D2D1_FACTORY_TYPE_MULTI_THREADED factory - the send thread shares the immediate
+    // context with the render thread's D3D and D2D work
+    bool Start(ID3D11Device* device, ID3D11DeviceContext* context, ID2D1Multithread* d2dLock,
+               const char* senderName, int width, int height, DXGI_FORMAT format);
+    void Stop();
+    bool IsRunning() const { return m_Running.load(std::memory_order_acquire); }
+
+    // Render thread: copy source into a free output buffer and hand it to the send
+    // thread. Never waits on Spout. metadata may be null.
+    void Enqueue(ID3D11Texture2D* source, const DaroFrameMetadata* metadata);
+
+    // Frames older than this when the send thread picks them up are dropped
+    void SetTimeout(int milliseconds) { m_TimeoutMs = milliseconds > 0 ? milliseconds : DARO_SPOUT_DEFAULT_TIMEOUT_MS; }
+
+    void GetStats(DaroSpoutOutputStats* stats) const;
+
+private:
+    void SendThreadProc();
+
+    struct OutputBuffer
+    {
+        ComPtr<ID3D11Texture2D> texture;
+        DaroFrameMetadata metadata = {};
+        bool hasMetadata = false;
+        long long enqueueTicks = 0;     // QPC at Enqueue
+        long long frameStartTicks = 0;  // QPC at Daro_BeginFrame, for output latency
+    };
+
+    ID3D11DeviceContext* m_Context = nullptr;
+    ComPtr<ID2D1Multithread> m_D2DLock;
+    DaroSpoutSender m_Sender;
+    DaroMetadataWriter m_Metadata;
+    OutputBuffer m_Buffers[DARO_SPOUT_OUTPUT_BUFFERS];
+
+    std::thread m_Thread;
+    std::atomic<bool> m_Running{ false };   // m_Thread itself is only touched by Start/Stop
+    std::mutex m_Mutex;
+    std::condition_variable m_Cond;
+    bool m_StopRequested = false;
+    int m_Pending = -1;                 // Buffer waiting to be sent
+    int m_Sending = -1;                 // Buffer the send thread is reading
+    std::atomic<int> m_TimeoutMs{ DARO_SPOUT_DEFAULT_TIMEOUT_MS };
+
+    long long m_PerfFreq = 0;
+
+    // Stats (see DaroSpoutOutputStats)
+    std::atomic<long long> m_SentFrames{ 0 };
+    std::atomic<long long> m_OverwrittenFrames{ 0 };
+    std::atomic<long long> m_StaleFrames{ 0 };
+    std::atomic<long long> m_AccessTimeouts{ 0 };
+    std::atomic<double> m_LastSendMs{ 0.0 };
+    std::atomic<double> m_MaxSendMs{ 0.0 };
+};
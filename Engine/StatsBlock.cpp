@@ -0,0 +1,225 @@
+// Engine/StatsBlock.cpp
+#include "StatsBlock.h"
+#include <chrono>
+#include <cstring>
+
+#ifdef _WIN32
+#include <Windows.h>
+static uint32_t CurrentProcessId() { return (uint32_t)GetCurrentProcessId(); }
+#else
+#include <unistd.h>
+static uint32_t CurrentProcessId() { return (uint32_t)getpid(); }
+#endif
+
+// Maximum seqlock retries before a read gives up for this call
+static const int MAX_READ_RETRIES = 8;
+
+static size_t AlignUp64(size_t value) { return (value + 63) & ~(size_t)63; }
+
+static uint64_t NowNs()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool IsHeartbeatLive(const DaroStatsHeader* header, uint64_t now)
+{
+    if (header->magic.load(std::memory_order_acquire) != DARO_STATS_MAGIC) return false;
+    uint64_t heartbeat = header->heartbeatNs.load(std::memory_order_relaxed);
+    return now - heartbeat < (uint64_t)DARO_STATS_STALE_MS * 1000000ull;
+}
+
+// ============== Publisher ==============
+
+DaroStatsPublisher::DaroStatsPublisher() {}
+
+DaroStatsPublisher::~DaroStatsPublisher()
+{
+    Stop();
+}
+
+bool DaroStatsPublisher::Start(const char* name, uint32_t intervalMs, GatherFn gather)
+{
+    Stop();
+    if (!name || !name[0] || !gather) return false;
+
+    size_t headerSize = AlignUp64(sizeof(DaroStatsHeader));
+    m_Memory.SetUnlinkOnClose(true);
+    DaroShmResult result = m_Memory.Create(name, headerSize + sizeof(DaroStatsSnapshot));
+    if (result == DARO_SHM_FAILED) return false;
+
+    auto* header = static_cast<DaroStatsHeader*>(m_Memory.Data());
+    if (result == DARO_SHM_OPENED && IsHeartbeatLive(header, NowNs()))
+    {
+        // Another engine is publishing under this name - do not write over it
+        m_Memory.Close();
+        return false;
+    }
+
+    // Fresh segment, or one left by a previous publisher: reset it.
+    // Readers detect the change through sessionId.
+    header->magic.store(0, std::memory_order_relaxed);
+    header->version = DARO_STATS_VERSION;
+    header->headerSize = (uint32_t)headerSize;
+    header->snapshotSize = (uint32_t)sizeof(DaroStatsSnapshot);
+    header->sessionId = NowNs() ^ ((uint64_t)CurrentProcessId() << 32);
+    header->processId = CurrentProcessId();
+    // The heartbeat rides on every publish, so the interval must stay well inside the stale limit
+    if (intervalMs == 0) intervalMs = DARO_STATS_DEFAULT_INTERVAL_MS;
+    if (intervalMs > DARO_STATS_STALE_MS / 2) intervalMs = DARO_STATS_STALE_MS / 2;
+    header->intervalMs = intervalMs;
+    header->sequence.store(0, std::memory_order_relaxed);
+    header->heartbeatNs.store(NowNs(), std::memory_order_relaxed);
+    m_Snapshot = static_cast<uint8_t*>(m_Memory.Data()) + headerSize;
+    memset(m_Snapshot, 0, sizeof(DaroStatsSnapshot));
+    header->magic.store(DARO_STATS_MAGIC, std::memory_order_release);
+
+    m_Header = header;
+    m_Gather = std::move(gather);
+    m_Name = name;
+    m_IntervalMs = header->intervalMs;
+    m_StopRequested = false;
+    m_Thread = std::thread(&DaroStatsPublisher::ThreadProc, this);
+    return true;
+}
+
+void DaroStatsPublisher::Stop()
+{
+    if (m_Thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_StopRequested = true;
+        }
+        m_Wake.notify_one();
+        m_Thread.join();
+    }
+    if (m_Header)
+    {
+        // Readers see the magic vanish and reconnect
+        m_Header->magic.store(0, std::memory_order_release);
+        m_Header = nullptr;
+    }
+    m_Memory.Close();
+    m_Snapshot = nullptr;
+    m_Gather = nullptr;
+    m_Name.clear();
+}
+
+void DaroStatsPublisher::ThreadProc()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (!m_StopRequested)
+    {
+        lock.unlock();
+        Publish();
+        lock.lock();
+        m_Wake.wait_for(lock, std::chrono::milliseconds(m_IntervalMs), [this] { return m_StopRequested; });
+    }
+}
+
+void DaroStatsPublisher::Publish()
+{
+    // Gather into private memory first so the seqlock is held for a memcpy only
+    memset(&m_Scratch, 0, sizeof(m_Scratch));
+    m_Gather(&m_Scratch);
+
+    uint64_t now = NowNs();
+    uint32_t seq = m_Header->sequence.load(std::memory_order_relaxed);
+    m_Scratch.publishCount = (uint64_t)(seq / 2) + 1;
+    m_Scratch.timestampNs = now;
+
+    m_Header->sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(m_Snapshot, &m_Scratch, sizeof(m_Scratch));
+    m_Header->sequence.store(seq + 2, std::memory_order_release);
+
+    m_Header->heartbeatNs.store(now, std::memory_order_relaxed);
+}
+
+// ============== Reader ==============
+
+DaroStatsReader::DaroStatsReader() {}
+
+DaroStatsReader::~DaroStatsReader()
+{
+    Close();
+}
+
+bool DaroStatsReader::Open(const char* name)
+{
+    Close();
+    if (!name || !name[0]) return false;
+    if (!m_Memory.Open(name)) return false;
+
+    auto* header = static_cast<const DaroStatsHeader*>(m_Memory.Data());
+    if (m_Memory.Size() < sizeof(DaroStatsHeader) ||
+        header->magic.load(std::memory_order_acquire) != DARO_STATS_MAGIC ||
+        header->version != DARO_STATS_VERSION ||
+        header->headerSize < sizeof(DaroStatsHeader) ||
+        m_Memory.Size() < (size_t)header->headerSize + header->snapshotSize)
+    {
+        m_Memory.Close();
+        return false;
+    }
+
+    m_Header = header;
+    m_Snapshot = static_cast<const uint8_t*>(m_Memory.Data()) + header->headerSize;
+    m_SessionId = header->sessionId;
+    return true;
+}
+
+void DaroStatsReader::Close()
+{
+    m_Memory.Close();
+    m_Header = nullptr;
+    m_Snapshot = nullptr;
+    m_SessionId = 0;
+}
+
+bool DaroStatsReader::Read(DaroStatsSnapshot* snapshot)
+{
+    if (!m_Header || !snapshot) return false;
+    if (m_Header->magic.load(std::memory_order_acquire) != DARO_STATS_MAGIC) return false;
+    if (m_Header->sessionId != m_SessionId) return false;
+
+    // A newer publisher may have appended fields we do not know about, an older one
+    // may lack some of ours
+    size_t bytes = m_Header->snapshotSize;
+    if (bytes > sizeof(DaroStatsSnapshot)) bytes = sizeof(DaroStatsSnapshot);
+
+    for (int attempt = 0; attempt < MAX_READ_RETRIES; attempt++)
+    {
+        uint32_t seqBefore = m_Header->sequence.load(std::memory_order_acquire);
+        if (seqBefore == 0) return false;   // Nothing published yet
+        if (seqBefore & 1)
+        {
+            m_TornReads++;
+            std::this_thread::yield();
+            continue;
+        }
+
+        DaroStatsSnapshot local;
+        memcpy(&local, m_Snapshot, bytes);
+        if (bytes < sizeof(local))
+            memset(reinterpret_cast<uint8_t*>(&local) + bytes, 0, sizeof(local) - bytes);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_Header->sequence.load(std::memory_order_relaxed) != seqBefore)
+        {
+            m_TornReads++;
+            continue;
+        }
+
+        *snapshot = local;
+        return true;
+    }
+    return false;
+}
+
+bool DaroStatsReader::IsPublisherLost() const
+{
+    if (!m_Header) return true;
+    if (m_Header->sessionId != m_SessionId) return true;
+    return !IsHeartbeatLive(m_Header, NowNs());
+}
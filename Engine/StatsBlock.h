@@ -0,0 +1,160 @@
+// Engine/StatsBlock.h
+// Live engine statistics published into named shared memory for external monitors.
+// A publisher thread gathers a snapshot at a fixed interval (off the render thread -
+// everything it reads is atomic or behind locks the render thread rarely takes) and
+// writes it into the segment under a seqlock. Readers in other processes poll at any
+// rate and never block the publisher.
+//
+// Like FrameTransport.h, this file and StatsBlock.cpp/SharedMemory.cpp have no Windows
+// or D3D dependencies and can be compiled directly into external tools.
+//
+// Layout compatibility: fields are only ever appended to DaroStatsSnapshot. Readers copy
+// min(snapshotSize, sizeof(DaroStatsSnapshot)), so an older reader keeps working against
+// a newer engine. DARO_STATS_VERSION changes only when existing fields move.
+// GraphicsMiddleware/Services/EngineStatsService.cs decodes the snapshot by byte offset.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "SharedMemory.h"
+#include "SharedTypes.h"
+
+#define DARO_STATS_BLOCK_NAME "DaroEngineStats"
+#define DARO_STATS_MAGIC 0x54534644u        // "DFST"
+#define DARO_STATS_VERSION 1
+#define DARO_STATS_MAX_VIDEOS 32
+#define DARO_STATS_DEFAULT_INTERVAL_MS 100    // At most DARO_STATS_STALE_MS / 2
+
+// A publisher whose heartbeat is older than this is treated as gone
+#define DARO_STATS_STALE_MS 2000
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Stats block requires lock-free 32-bit atomics");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Stats block requires lock-free 64-bit atomics");
+
+// ---- Shared memory layout (packed, fixed-size fields, identical on 32/64-bit) ----
+
+#pragma pack(push, 1)
+struct DaroStatsVideo
+{
+    int32_t videoId;
+    int32_t playing;
+    int32_t width;
+    int32_t height;
+    int32_t currentFrame;
+    int32_t totalFrames;
+    int32_t decodedLastUpdate;      // Frames decoded by the last update; above 1 means playback is catching up
+    int32_t usingFFmpeg;
+    double frameRate;
+};
+
+struct DaroStatsSnapshot
+{
+    // Headline counters first, so simple readers can map just this prefix
+    uint64_t publishCount;          // Snapshots published this session
+    uint64_t timestampNs;           // Publisher steady clock (same clock as DaroTransportNowNs)
+    int64_t frameNumber;
+    int64_t droppedFrames;          // Missed output deadlines (Daro_GetDroppedFrames)
+    int64_t lateFrames;             // Frames whose render took longer than one frame period
+    double targetFps;
+    double fps;
+    double frameTimeMs;
+    DaroFrameMetadata onAir;        // Template and playlist item on air
+
+    DaroFrameStats lastFrame;       // Most recently completed frame
+    DaroTimingSummary timing[DARO_TIMING_METRIC_COUNT][2];     // [DARO_TIMING_*][DARO_TIMING_SINCE_RESET / LAST_WINDOW]
+    DaroMemoryStats memoryTotal;
+    DaroMemoryStats memory[DARO_MEM_CATEGORY_COUNT];
+    DaroSpoutOutputStats spoutOutput;
+
+    int32_t videoCount;
+    DaroStatsVideo videos[DARO_STATS_MAX_VIDEOS];
+};
+#pragma pack(pop)
+
+struct alignas(64) DaroStatsHeader
+{
+    std::atomic<uint32_t> magic;            // Written last by the publisher
+    uint32_t version;
+    uint32_t headerSize;                    // Offset of the snapshot from the start of the segment
+    uint32_t snapshotSize;                  // sizeof(DaroStatsSnapshot) of the publisher
+    uint64_t sessionId;                     // Changes when the publisher is recreated
+    uint32_t processId;
+    uint32_t intervalMs;
+    std::atomic<uint32_t> sequence;         // Seqlock: odd while the publisher is writing
+    uint32_t reserved;
+    std::atomic<uint64_t> heartbeatNs;      // Publisher steady clock, updated every publish
+};
+
+class DaroStatsPublisher
+{
+public:
+    // Fills a zeroed snapshot; called on the publisher thread
+    using GatherFn = std::function<void(DaroStatsSnapshot*)>;
+
+    DaroStatsPublisher();
+    ~DaroStatsPublisher();
+
+    DaroStatsPublisher(const DaroStatsPublisher&) = delete;
+    DaroStatsPublisher& operator=(const DaroStatsPublisher&) = delete;
+
+    // Create the segment and start publishing. Fails if another live process
+    // already publishes under the name.
+    bool Start(const char* name, uint32_t intervalMs, GatherFn gather);
+    void Stop();
+    bool IsRunning() const { return m_Header != nullptr; }
+    const std::string& GetName() const { return m_Name; }
+    size_t GetMemorySize() const { return m_Memory.Size(); }
+
+private:
+    void ThreadProc();
+    void Publish();
+
+    DaroSharedMemory m_Memory;
+    DaroStatsHeader* m_Header = nullptr;
+    uint8_t* m_Snapshot = nullptr;
+    DaroStatsSnapshot m_Scratch = {};
+    GatherFn m_Gather;
+    std::string m_Name;
+    uint32_t m_IntervalMs = DARO_STATS_DEFAULT_INTERVAL_MS;
+
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_Wake;
+    bool m_StopRequested = false;
+};
+
+class DaroStatsReader
+{
+public:
+    DaroStatsReader();
+    ~DaroStatsReader();
+
+    // Attach to a publisher by segment name
+    bool Open(const char* name = DARO_STATS_BLOCK_NAME);
+    void Close();
+    bool IsOpen() const { return m_Header != nullptr; }
+
+    // Copy the latest consistent snapshot. Fields beyond the publisher's snapshotSize
+    // are zeroed. Returns false if the publisher is gone or was writing on every retry.
+    bool Read(DaroStatsSnapshot* snapshot);
+
+    // True if the publisher was recreated, stopped or its heartbeat went stale;
+    // Close and Open again to follow a restarted engine
+    bool IsPublisherLost() const;
+
+    uint32_t GetIntervalMs() const { return m_Header ? m_Header->intervalMs : 0; }
+    uint32_t GetProcessId() const { return m_Header ? m_Header->processId : 0; }
+    uint64_t GetTornReads() const { return m_TornReads; }
+
+private:
+    DaroSharedMemory m_Memory;
+    const DaroStatsHeader* m_Header = nullptr;
+    const uint8_t* m_Snapshot = nullptr;
+    uint64_t m_SessionId = 0;
+    uint64_t m_TornReads = 0;       // Seqlock retries
+};
@@ -0,0 +1,176 @@
+// Engine/TimeBase.h
+// Rational frame rates and exact frame/time conversions. Broadcast rates are ratios
+// (59.94 is 60000/1001): a double period, or "frame / fps" truncated to an integer, puts
+// frames and timecode a frame off after a few hours. Conversions here are integer
+// arithmetic on nanoseconds and exact for any frame count the engine can reach;
+// DaroFrameToTimecode adds SMPTE drop-frame numbering for the 29.97 family.
+//
+// Header-only like LayerTransform.h. No Windows or D3D dependencies.
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include "SharedTypes.h"       // DARO_TIMECODE_DROP_FRAME
+
+#define DARO_NS_PER_SECOND      1000000000ll
+
+// Rates whose num * den exceeds this are approximated so the conversions below cannot
+// overflow 64 bits (covers every broadcast rate with room to spare)
+#define DARO_RATE_MAX_PRODUCT   9000000000ll
+
+struct DaroRational
+{
+    int64_t num;                // Frames...
+    int64_t den;                // ...per this many seconds
+};
+
+inline bool DaroRationalIsValid(DaroRational rate)
+{
+    return rate.num > 0 && rate.den > 0 && rate.num <= DARO_RATE_MAX_PRODUCT / rate.den;
+}
+
+inline double DaroRationalToDouble(DaroRational rate)
+{
+    return rate.den > 0 ? (double)rate.num / (double)rate.den : 0.0;
+}
+
+// Frame rate from a double. Values within 0.0005 of an NTSC-family rate (23.976, 29.97,
+// 47.952, 59.94, 119.88) become n*1000/1001; others are taken to 1/1000 fps.
+// Returns {0, 1} for rates that are not positive.
+inline DaroRational DaroRationalFromFps(double fps)
+{
+    if (!(fps > 0.0) || fps > 1000000.0) return { 0, 1 };
+
+    static const int64_t ntsc[] = { 24, 30, 48, 60, 120 };
+    for (int64_t nominal : ntsc)
+    {
+        if (std::fabs(fps - (double)nominal * 1000.0 / 1001.0) < 0.0005)
+            return { nominal * 1000, 1001 };
+    }
+
+    int64_t whole = (int64_t)std::llround(fps);
+    if (whole > 0 && std::fabs(fps - (double)whole) < 1e-6)
+        return { whole, 1 };
+
+    int64_t num = (int64_t)std::llround(fps * 1000.0), den = 1000;
+    int64_t a = num, b = den;
+    while (b) { int64_t t = a % b; a = b; b = t; }
+    return { num / a, den / a };
+}
+
+// Reduced num/den, or the DaroRationalFromFps approximation when it is out of range
+inline DaroRational DaroMakeRational(int64_t num, int64_t den)
+{
+    if (num <= 0 || den <= 0) return { 0, 1 };
+    int64_t a = num, b = den;
+    while (b) { int64_t t = a % b; a = b; b = t; }
+    DaroRational rate = { num / a, den / a };
+    return DaroRationalIsValid(rate) ? rate : DaroRationalFromFps((double)num / (double)den);
+}
+
+// Start of a frame in nanoseconds (rounded down)
+inline int64_t DaroFrameToNs(int64_t frame, DaroRational rate)
+{
+    if (!DaroRationalIsValid(rate)) return 0;
+    if (frame < 0) return -DaroFrameToNs(-frame, rate);
+    int64_t whole = frame / rate.num, rest = frame % rate.num;
+    return whole * rate.den * DARO_NS_PER_SECOND + rest * rate.den * DARO_NS_PER_SECOND / rate.num;
+}
+
+// Frame shown at a time: the last frame that starts at or before it
+inline int64_t DaroNsToFrame(int64_t ns, DaroRational rate)
+{
+    if (!DaroRationalIsValid(rate)) return 0;
+    if (ns < 0) return -DaroNsToFrame(-ns - 1, rate) - 1;
+    int64_t span = rate.den * DARO_NS_PER_SECOND;     // Nanoseconds per rate.num frames
+    int64_t whole = ns / span, rest = ns % span;
+    int64_t frame = whole * rate.num + rest * rate.num / span;
+    // Frame starts are rounded down to whole nanoseconds: a time at the rounded start
+    // belongs to that frame
+    if (DaroFrameToNs(frame + 1, rate) <= ns) frame++;
+    return frame;
+}
+
+// Frame whose start is nearest to a time, for timestamps that are rounded (e.g. 100 ns
+// Media Foundation sample times)
+inline int64_t DaroNsToNearestFrame(int64_t ns, DaroRational rate)
+{
+    return DaroNsToFrame(ns + DaroFrameToNs(1, rate) / 2, rate);
+}
+
+// Frame shown at a time in seconds. Times up to toleranceNs before a frame start count
+// as that frame, for callers whose seconds went through float or double arithmetic.
+inline int64_t DaroSecondsToFrame(double seconds, DaroRational rate, int64_t toleranceNs)
+{
+    if (!(seconds > 0.0)) return 0;
+    return DaroNsToFrame((int64_t)std::llround(seconds * 1e9) + toleranceNs, rate);
+}
+
+// True for 30000/1001, 60000/1001 and 120000/1001, which have SMPTE drop-frame timecode
+inline bool DaroIsDropFrameRate(DaroRational rate)
+{
+    return rate.den == 1001 && rate.num % 30000 == 0;
+}
+
+// SMPTE timecode packed as 0xHHMMSSFF, counting frames at the nominal (rounded) rate.
+// With dropFrame at a drop-frame rate, frame numbers 0 and 1 (0-3 at 59.94) are skipped
+// at the start of every minute except each tenth, which keeps timecode close to real time,
+// and DARO_TIMECODE_DROP_FRAME is set. Hours wrap at 24. Drop-frame numbering itself
+// falls behind real time by 86 ms a day (SMPTE 12M); frame numbers and times do not.
+inline uint32_t DaroFrameToTimecode(uint64_t frame, DaroRational rate, bool dropFrame)
+{
+    if (!DaroRationalIsValid(rate)) return 0;
+    uint64_t nominal = (uint64_t)((rate.num + rate.den / 2) / rate.den);
+    if (nominal == 0) return 0;
+
+    uint32_t flags = 0;
+    if (dropFrame && DaroIsDropFrameRate(rate))
+    {
+        uint64_t drop = nominal / 15;                           // 2 at 29.97, 4 at 59.94
+        uint64_t perTenMinutes = nominal * 600 - drop * 9;
+        uint64_t perMinute = nominal * 60 - drop;
+        uint64_t tens = frame / perTenMinutes, rest = frame % perTenMinutes;
+        frame += drop * 9 * tens;
+        if (rest > drop) frame += drop * ((rest - drop) / perMinute);
+        flags = DARO_TIMECODE_DROP_FRAME;
+    }
+
+    uint64_t ff = frame % nominal;
+    uint64_t totalSeconds = frame / nominal;
+    uint64_t ss = totalSeconds % 60;
+    uint64_t mm = (totalSeconds / 60) % 60;
+    uint64_t hh = (totalSeconds / 3600) % 24;
+    return flags | (uint32_t)((hh << 24) | (mm << 16) | (ss << 8) | ff);
+}
+
+// Frames in one 24-hour timecode day, after which DaroFrameToTimecode wraps
+inline int64_t DaroTimecodeDayFrames(DaroRational rate, bool dropFrame)
+{
+    if (!DaroRationalIsValid(rate)) return 0;
+    int64_t nominal = (rate.num + rate.den / 2) / rate.den;
+    if (dropFrame && DaroIsDropFrameRate(rate))
+        return (nominal * 600 - nominal / 15 * 9) * 144;        // 144 ten-minute blocks
+    return nominal * 86400;
+}
+
+// Frame of the day a packed timecode labels (the inverse of DaroFrameToTimecode), or -1
+// if a field is out of range or names a frame number drop-frame skips. The
+// DARO_TIMECODE_DROP_FRAME bit is ignored: dropFrame decides the numbering.
+inline int64_t DaroTimecodeToFrame(uint32_t timecode, DaroRational rate, bool dropFrame)
+{
+    if (!DaroRationalIsValid(rate)) return -1;
+    int64_t nominal = (rate.num + rate.den / 2) / rate.den;
+    int64_t hh = (timecode >> 24) & 0x3F, mm = (timecode >> 16) & 0xFF;
+    int64_t ss = (timecode >> 8) & 0xFF, ff = timecode & 0xFF;
+    if (hh >= 24 || mm >= 60 || ss >= 60 || ff >= nominal) return -1;
+
+    int64_t minutes = hh * 60 + mm;
+    int64_t frame = (minutes * 60 + ss) * nominal + ff;
+    if (dropFrame && DaroIsDropFrameRate(rate))
+    {
+        int64_t drop = nominal / 15;
+        if (ss == 0 && ff < drop && mm % 10 != 0) return -1;
+        frame -= drop * (minutes - minutes / 10);
+    }
+    return frame;
+}
@@ -0,0 +1,283 @@
+// Engine/Timeline.cpp
+#include "Timeline.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Same curve as the Designer's PropertyTrackModel.ApplyEasing, so a track plays natively
+// exactly as it previews
+static float ApplyEasing(float t, float easeOut, float easeIn)
+{
+    if (easeOut == 0 && easeIn == 0) return t;
+
+    float accel = easeOut;
+    float decel = easeIn;
+    float result;
+    if (accel > 0 && decel > 0)
+    {
+        // S-curve with the inflection point where the two weights meet
+        float blend = std::min(std::max(accel / (accel + decel), 0.01f), 0.99f);
+        float adjusted;
+        if (t < blend)
+        {
+            float normalized = t / blend;
+            adjusted = 0.5f * normalized * normalized;
+        }
+        else
+        {
+            float normalized = (1 - t) / (1 - blend);
+            adjusted = 1 - 0.5f * normalized * normalized;
+        }
+        float strength = std::min((accel + decel) / 2, 1.0f);
+        result = t * (1 - strength) + adjusted * strength;
+    }
+    else if (accel > 0)
+    {
+        result = t * t * accel + t * (1 - accel);
+    }
+    else
+    {
+        float inv = 1 - t;
+        result = 1 - (inv * inv * decel + inv * (1 - decel));
+    }
+    return std::min(std::max(result, 0.0f), 1.0f);
+}
+
+float DaroEvaluateKeyframes(const DaroKeyframe* keys, int count, int frame)
+{
+    if (count <= 0) return 0.0f;
+    if (count == 1 || frame <= keys[0].frame) return keys[0].value;
+    if (frame >= keys[count - 1].frame) return keys[count - 1].value;
+
+    // Last keyframe at or before frame
+    int left = 0;
+    int right = count - 1;
+    while (left < right - 1)
+    {
+        int mid = (left + right) / 2;
+        if (keys[mid].frame <= frame) left = mid;
+        else right = mid;
+    }
+    const DaroKeyframe& prev = keys[left];
+    const DaroKeyframe& next = keys[right];
+    int delta = next.frame - prev.frame;
+    if (delta == 0) return next.value;
+
+    float t = ApplyEasing((float)(frame - prev.frame) / delta, prev.easeOut, next.easeIn);
+    return prev.value + (next.value - prev.value) * t;
+}
+
+static float Clamp01(float value) { return std::min(std::max(value, 0.0f), 1.0f); }
+
+void DaroSetLayerField(DaroLayer* layer, int field, float value)
+{
+    switch (field)
+    {
+    case DARO_FIELD_POS_X: layer->posX = value; break;
+    case DARO_FIELD_POS_Y: layer->posY = value; break;
+    case DARO_FIELD_SIZE_X: layer->sizeX = value; break;
+    case DARO_FIELD_SIZE_Y: layer->sizeY = value; break;
+    case DARO_FIELD_ROT_X: layer->rotX = value; break;
+    case DARO_FIELD_ROT_Y: layer->rotY = value; break;
+    case DARO_FIELD_ROT_Z: layer->rotZ = value; break;
+    case DARO_FIELD_OPACITY: layer->opacity = Clamp01(value); break;
+    case DARO_FIELD_COLOR_R: layer->colorR = Clamp01(value); break;
+    case DARO_FIELD_COLOR_G: layer->colorG = Clamp01(value); break;
+    case DARO_FIELD_COLOR_B: layer->colorB = Clamp01(value); break;
+    case DARO_FIELD_VISIBLE: layer->active = value > 0.5f ? 1 : 0; break;
+    case DARO_FIELD_FONT_SIZE: layer->fontSize = std::max(value, 1.0f); break;
+    case DARO_FIELD_LINE_HEIGHT: layer->lineHeight = std::max(value, 0.1f); break;
+    case DARO_FIELD_LETTER_SPACING: layer->letterSpacing = value; break;
+    case DARO_FIELD_TEX_X: layer->texX = value; break;
+    case DARO_FIELD_TEX_Y: layer->texY = value; break;
+    case DARO_FIELD_TEX_W: layer->texW = value; break;
+    case DARO_FIELD_TEX_H: layer->texH = value; break;
+    case DARO_FIELD_TEX_ROT: layer->texRot = value; break;
+    }
+}
+
+void DaroTimeline::Clear()
+{
+    m_Tracks.clear();
+    m_Markers.clear();
+    m_Length = DARO_TIMELINE_DEFAULT_LENGTH;
+    m_Frame = 0;
+    m_LastFrame = -1;
+    m_Playing = false;
+    m_Continue = false;
+    m_Loops = 0;
+}
+
+bool DaroTimeline::SetLength(int frames)
+{
+    if (frames <= 0) return false;
+    m_Length = frames;
+    m_Frame = Clamp(m_Frame);
+    return true;
+}
+
+bool DaroTimeline::SetTrack(int layer, int field, const DaroKeyframe* keys, int count)
+{
+    if (layer < 0 || layer >= DARO_MAX_LAYERS || field < 0 || field >= DARO_FIELD_COUNT) return false;
+    if (count < 0 || count > DARO_TIMELINE_MAX_KEYFRAMES || (count > 0 && !keys)) return false;
+    for (int i = 0; i < count; i++)
+    {
+        const DaroKeyframe& key = keys[i];
+        if (key.frame < 0 || (i > 0 && key.frame < keys[i - 1].frame) || !std::isfinite(key.value) ||
+            !(key.easeIn >= 0.0f && key.easeIn <= 1.0f) || !(key.easeOut >= 0.0f && key.easeOut <= 1.0f))
+            return false;
+    }
+
+    auto it = std::find_if(m_Tracks.begin(), m_Tracks.end(),
+        [&](const Track& track) { return track.layer == layer && track.field == field; });
+    if (count == 0)
+    {
+        if (it != m_Tracks.end()) m_Tracks.erase(it);
+        return true;
+    }
+    if (it == m_Tracks.end())
+    {
+        if (m_Tracks.size() >= DARO_TIMELINE_MAX_TRACKS) return false;
+        it = m_Tracks.insert(m_Tracks.end(), Track{ layer, field, {} });
+    }
+    it->keys.assign(keys, keys + count);
+    return true;
+}
+
+bool DaroTimeline::SetMarkers(const DaroTimelineMarker* markers, int count)
+{
+    if (count < 0 || count > DARO_TIMELINE_MAX_MARKERS || (count > 0 && !markers)) return false;
+    std::vector<DaroTimelineMarker> sorted(markers, markers + count);
+    std::sort(sorted.begin(), sorted.end(),
+        [](const DaroTimelineMarker& a, const DaroTimelineMarker& b) { return a.frame < b.frame; });
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        const DaroTimelineMarker& marker = sorted[i];
+        if (marker.frame < 0 || marker.frame >= m_Length || marker.type < 0 || marker.type >= DARO_MARKER_COUNT) return false;
+        if (i > 0 && marker.frame == sorted[i - 1].frame) return false;
+        if (marker.type != DARO_MARKER_STOP && (marker.target < 0 || marker.target >= m_Length)) return false;
+        if (marker.type == DARO_MARKER_LOOP && marker.target > marker.frame) return false;
+    }
+    m_Markers.swap(sorted);
+    m_Continue = false;
+    return true;
+}
+
+void DaroTimeline::Seek(int frame)
+{
+    m_Frame = Clamp(frame);
+    m_Continue = false;
+}
+
+void DaroTimeline::Continue()
+{
+    int after = -1;
+    const DaroTimelineMarker* marker = MarkerAt(m_Frame);
+    if (marker && marker->type == DARO_MARKER_STOP)
+        after = m_Frame + 1;
+    else if (const DaroTimelineMarker* loop = LoopAround(m_Frame))
+        after = loop->frame + 1;
+    if (after < 0)
+    {
+        m_Continue = true;
+        return;
+    }
+    m_Continue = false;
+    // A stop or loop on the last frame: the timeline ends there, as it would without one
+    if (after >= m_Length)
+    {
+        m_Frame = m_Length - 1;
+        m_Playing = false;
+        return;
+    }
+    m_Frame = after;
+}
+
+int DaroTimeline::Tick(DaroLayer* layers, int layerCapacity)
+{
+    int frame = m_Frame;
+    for (const Track& track : m_Tracks)
+    {
+        if (track.layer >= layerCapacity) continue;
+        DaroSetLayerField(&layers[track.layer], track.field,
+            DaroEvaluateKeyframes(track.keys.data(), (int)track.keys.size(), frame));
+    }
+    m_LastFrame = frame;
+    if (m_Playing) m_Frame = Next(frame);
+    return frame;
+}
+
+// Frame shown after frame; stops the timeline on its last frame
+int DaroTimeline::Next(int frame)
+{
+    if (const DaroTimelineMarker* marker = MarkerAt(frame))
+    {
+        switch (marker->type)
+        {
+        case DARO_MARKER_STOP:
+            if (!m_Continue) return frame;
+            m_Continue = false;
+            break;
+        case DARO_MARKER_LOOP:
+            if (!m_Continue)
+            {
+                m_Loops++;
+                return Clamp(marker->target);
+            }
+            m_Continue = false;
+            break;
+        case DARO_MARKER_JUMP:
+            return Clamp(marker->target);
+        }
+    }
+    if (frame + 1 >= m_Length)
+    {
+        m_Playing = false;
+        return m_Length - 1;
+    }
+    return frame + 1;
+}
+
+const DaroTimelineMarker* DaroTimeline::MarkerAt(int frame) const
+{
+    auto it = std::lower_bound(m_Markers.begin(), m_Markers.end(), frame,
+        [](const DaroTimelineMarker& marker, int value) { return marker.frame < value; });
+    return it != m_Markers.end() && it->frame == frame ? &*it : nullptr;
+}
+
+// Loop marker whose region (target to its frame) holds frame, the innermost if nested
+const DaroTimelineMarker* DaroTimeline::LoopAround(int frame) const
+{
+    for (const DaroTimelineMarker& marker : m_Markers)
+    {
+        if (marker.type == DARO_MARKER_LOOP && marker.target <= frame && frame <= marker.frame)
+            return &marker;
+    }
+    return nullptr;
+}
+
+uint64_t DaroTimeline::TrackedLayers() const
+{
+    uint64_t mask = 0;
+    for (const Track& track : m_Tracks)
+    {
+        if (track.layer < 64) mask |= 1ull << track.layer;
+    }
+    return mask;
+}
+
+void DaroTimeline::GetState(DaroTimelineState* state) const
+{
+    memset(state, 0, sizeof(*state));
+    const DaroTimelineMarker* marker = MarkerAt(m_Frame);
+    state->playing = m_Playing ? 1 : 0;
+    state->frame = m_Frame;
+    state->lastFrame = m_LastFrame;
+    state->length = m_Length;
+    state->held = m_Playing && !m_Continue && marker && marker->type == DARO_MARKER_STOP ? 1 : 0;
+    state->looping = m_Playing && LoopAround(m_Frame) ? 1 : 0;
+    state->continuePending = m_Continue ? 1 : 0;
+    state->trackCount = (int)m_Tracks.size();
+    state->markerCount = (int)m_Markers.size();
+    state->loops = m_Loops;
+}
@@ -0,0 +1,79 @@
+// Engine/Timeline.h
+// Scene timelines (Daro_*Timeline). A timeline holds keyframe tracks, each animating one
+// field of one layer, and markers. Daro_BeginFrame ticks the timeline of every scene slot:
+// the tracked fields are set for the frame shown, then a playing timeline steps to the
+// frame the next output frame shows. Markers and continue act on that step, so a continue
+// applied before a frame begins (between frames, or queued for it) is seen in that frame
+// and a loop goes back to its start without a repeated or skipped frame.
+//
+// No Windows or D3D dependencies; the engine serializes access (g_Mutex).
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "SharedTypes.h"
+
+// Value of a track at frame; before the first and after the last keyframe, their values
+float DaroEvaluateKeyframes(const DaroKeyframe* keys, int count, int frame);
+
+// Set an animatable field (DARO_FIELD_*) of a layer, clamped like the Designer's animation
+void DaroSetLayerField(DaroLayer* layer, int field, float value);
+
+class DaroTimeline
+{
+public:
+    struct Track
+    {
+        int layer;
+        int field;                  // DARO_FIELD_*
+        std::vector<DaroKeyframe> keys;
+    };
+
+    // No tracks or markers, stopped on frame 0, default length
+    void Clear();
+
+    // False if out of range; the playhead is clamped to the new length
+    bool SetLength(int frames);
+    // Replace the track of a layer field; keys sorted by frame. count 0 removes the track.
+    bool SetTrack(int layer, int field, const DaroKeyframe* keys, int count);
+    // Replace all markers. False (and nothing changed) for two on one frame, a target
+    // outside the timeline or a loop whose start is after its end.
+    bool SetMarkers(const DaroTimelineMarker* markers, int count);
+
+    void Play() { m_Playing = true; }
+    void Stop() { m_Playing = false; }
+    void Seek(int frame);           // Clamped to the timeline
+    // On a stop, or inside a loop region: the next frame shows the frame after that marker
+    // (one on the last frame ends playback there). Anywhere else the next stop or loop the
+    // playhead reaches is passed once.
+    void Continue();
+
+    // Once per output frame: set the tracked fields of layers[0..layerCapacity) for the
+    // frame shown, then step if playing. Returns the frame shown.
+    int Tick(DaroLayer* layers, int layerCapacity);
+
+    void GetState(DaroTimelineState* state) const;
+    bool IsPlaying() const { return m_Playing; }
+    int Frame() const { return m_Frame; }
+    int Length() const { return m_Length; }
+    bool IsContinuePending() const { return m_Continue; }
+    const std::vector<Track>& Tracks() const { return m_Tracks; }
+    // Bit per layer (below 64) a track animates
+    uint64_t TrackedLayers() const;
+    const std::vector<DaroTimelineMarker>& Markers() const { return m_Markers; }
+
+private:
+    const DaroTimelineMarker* MarkerAt(int frame) const;
+    const DaroTimelineMarker* LoopAround(int frame) const;
+    int Next(int frame);
+    int Clamp(int frame) const { return frame < 0 ? 0 : frame >= m_Length ? m_Length - 1 : frame; }
+
+    std::vector<Track> m_Tracks;
+    std::vector<DaroTimelineMarker> m_Markers;      // Sorted by frame
+    int m_Length = DARO_TIMELINE_DEFAULT_LENGTH;
+    int m_Frame = 0;                // Shown by the next tick
+    int m_LastFrame = -1;
+    bool m_Playing = false;
+    bool m_Continue = false;        // Pass the next stop or loop
+    long long m_Loops = 0;
+};
@@ -0,0 +1,278 @@
+// Engine/Trace.cpp
+#include "Trace.h"
+#include "TraceProtobuf.h"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <Windows.h>
+
+namespace
+{
+    struct TraceEvent
+    {
+        const char* name;
+        long long start;
+        long long end;
+    };
+
+    struct ThreadBuffer
+    {
+        unsigned long threadId = 0;
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<unsigned int> session{ 0 };         // Session the events belong to (owner resets on change)
+        std::atomic<unsigned long long> written{ 0 };
+        std::atomic<bool> retired{ false };             // Owner thread has exited
+        TraceEvent events[DARO_TRACE_EVENTS_PER_THREAD];
+    };
+
+    // Marks the buffer retired when its thread exits; Start frees retired buffers
+    struct ThreadBufferOwner
+    {
+        ThreadBuffer* buffer = nullptr;
+        ~ThreadBufferOwner() { if (buffer) buffer->retired.store(true, std::memory_order_release); }
+    };
+
+    struct ThreadEvents
+    {
+        unsigned long threadId;
+        const char* name;
+        std::vector<TraceEvent> events;
+    };
+
+    std::mutex s_BuffersMutex;
+    std::vector<ThreadBuffer*> s_Buffers;
+    std::atomic<unsigned int> s_Session{ 0 };
+    long long s_SessionStart = 0;
+
+    thread_local ThreadBufferOwner t_Owner;
+    thread_local const char* t_ThreadName = nullptr;
+
+    double TicksPerSecond()
+    {
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+        return (double)freq.QuadPart;
+    }
+
+    // Copy the current session's events; caller holds s_BuffersMutex
+    std::vector<ThreadEvents> Snapshot()
+    {
+        std::vector<ThreadEvents> threads;
+        unsigned int session = s_Session.load(std::memory_order_acquire);
+
+        for (ThreadBuffer* buffer : s_Buffers)
+        {
+            if (buffer->session.load(std::memory_order_acquire) != session) continue;
+
+            unsigned long long written = buffer->written.load(std::memory_order_acquire);
+            unsigned long long first = written > DARO_TRACE_EVENTS_PER_THREAD ? written - DARO_TRACE_EVENTS_PER_THREAD : 0;
+
+            ThreadEvents thread = { buffer->threadId, buffer->name.load(std::memory_order_relaxed), {} };
+            thread.events.reserve((size_t)(written - first));
+            for (unsigned long long i = first; i < written; i++)
+                thread.events.push_back(buffer->events[i % DARO_TRACE_EVENTS_PER_THREAD]);
+
+            // The owner keeps recording while we copy: drop the events it may have
+            // overwritten, including the slot it could be writing right now
+            std::atomic_thread_fence(std::memory_order_acquire);
+            unsigned long long after = buffer->written.load(std::memory_order_acquire);
+            if (buffer->session.load(std::memory_order_acquire) != session) continue;
+            unsigned long long firstValid = after + 1 > DARO_TRACE_EVENTS_PER_THREAD ? after + 1 - DARO_TRACE_EVENTS_PER_THREAD : 0;
+            if (firstValid > first)
+            {
+                size_t lapped = (size_t)std::min<unsigned long long>(firstValid - first, thread.events.size());
+                thread.events.erase(thread.events.begin(), thread.events.begin() + lapped);
+            }
+
+            if (!thread.events.empty()) threads.push_back(std::move(thread));
+        }
+        return threads;
+    }
+
+    void AppendJsonString(std::string& out, const char* text)
+    {
+        out += '"';
+        for (const char* p = text; *p; p++)
+        {
+            if (*p == '"' || *p == '\\') out += '\\';
+            if ((unsigned char)*p >= 0x20) out += *p;
+        }
+        out += '"';
+    }
+
+    std::string BuildJson(const std::vector<ThreadEvents>& threads, unsigned long pid)
+    {
+        double usPerTick = 1000000.0 / TicksPerSecond();
+        char line[256];
+        std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        sprintf_s(line, "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%lu,\"tid\":0,\"args\":{\"name\":\"DaroEngine\"}}", pid);
+        out += line;
+
+        for (const ThreadEvents& thread : threads)
+        {
+            if (thread.name)
+            {
+                sprintf_s(line, ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%lu,\"tid\":%lu,\"args\":{\"name\":", pid, thread.threadId);
+                out += line;
+                AppendJsonString(out, thread.name);
+                out += "}}";
+            }
+
+            for (const TraceEvent& e : thread.events)
+            {
+                out += ",\n{\"ph\":\"X\",\"cat\":\"daro\",\"name\":";
+                AppendJsonString(out, e.name);
+                sprintf_s(line, ",\"pid\":%lu,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}", pid, thread.threadId,
+                          (double)(e.start - s_SessionStart) * usPerTick, (double)(e.end - e.start) * usPerTick);
+                out += line;
+            }
+        }
+
+        out += "\n]}\n";
+        return out;
+    }
+
+    std::string BuildPerfetto(std::vector<ThreadEvents>& threads, unsigned long pid)
+    {
+        double nsPerTick = 1000000000.0 / TicksPerSecond();
+        auto toNs = [nsPerTick](long long ticks) { return (unsigned long long)((double)ticks * nsPerTick); };
+        std::string out;
+
+        unsigned long long processUuid = (unsigned long long)pid << 32;
+        DaroPerfettoProcessTrack(out, processUuid, pid, "DaroEngine");
+
+        for (ThreadEvents& thread : threads)
+        {
+            unsigned long long threadUuid = processUuid | thread.threadId;
+
+            DaroPerfettoThreadTrack(out, threadUuid, processUuid, pid, thread.threadId, thread.name);
+
+            // Events are recorded when they end, so inner scopes come first. Order by
+            // start (outer first on ties) and emit begin/end pairs with a stack.
+            std::sort(thread.events.begin(), thread.events.end(), [](const TraceEvent& a, const TraceEvent& b)
+            {
+                return a.start != b.start ? a.start < b.start : a.end > b.end;
+            });
+
+            std::vector<long long> open;
+            for (const TraceEvent& e : thread.events)
+            {
+                while (!open.empty() && open.back() <= e.start)
+                {
+                    DaroPerfettoSlice(out, toNs(open.back()), threadUuid, DARO_PERFETTO_SLICE_END, nullptr);
+                    open.pop_back();
+                }
+                DaroPerfettoSlice(out, toNs(e.start), threadUuid, DARO_PERFETTO_SLICE_BEGIN, e.name);
+                // Clamp to the enclosing slice so slices stay properly nested
+                open.push_back(open.empty() ? e.end : std::min(e.end, open.back()));
+            }
+            while (!open.empty())
+            {
+                DaroPerfettoSlice(out, toNs(open.back()), threadUuid, DARO_PERFETTO_SLICE_END, nullptr);
+                open.pop_back();
+            }
+        }
+        return out;
+    }
+}
+
+long long DaroTrace::Now()
+{
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return now.QuadPart;
+}
+
+void DaroTrace::Start()
+{
+    std::lock_guard<std::mutex> lock(s_BuffersMutex);
+
+    // Threads that exited can no longer write: free their buffers
+    auto retired = std::remove_if(s_Buffers.begin(), s_Buffers.end(), [](ThreadBuffer* buffer)
+    {
+        if (!buffer->retired.load(std::memory_order_acquire)) return false;
+        delete buffer;
+        return true;
+    });
+    s_Buffers.erase(retired, s_Buffers.end());
+
+    // Each thread clears its own ring when it sees the new session
+    s_SessionStart = Now();
+    s_Session.fetch_add(1, std::memory_order_release);
+    s_Enabled.store(true, std::memory_order_release);
+    OutputDebugStringA("[DaroEngine] Trace started\n");
+}
+
+void DaroTrace::Stop()
+{
+    s_Enabled.store(false, std::memory_order_release);
+}
+
+void DaroTrace::Record(const char* name, long long startTicks, long long endTicks)
+{
+    ThreadBuffer* buffer = t_Owner.buffer;
+    if (!buffer)
+    {
+        buffer = new (std::nothrow) ThreadBuffer();
+        if (!buffer) return;
+        buffer->threadId = GetCurrentThreadId();
+        buffer->name.store(t_ThreadName, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(s_BuffersMutex);
+            s_Buffers.push_back(buffer);
+        }
+        t_Owner.buffer = buffer;
+    }
+
+    unsigned int session = s_Session.load(std::memory_order_acquire);
+    if (buffer->session.load(std::memory_order_relaxed) != session)
+    {
+        buffer->written.store(0, std::memory_order_relaxed);
+        buffer->session.store(session, std::memory_order_release);
+    }
+
+    unsigned long long index = buffer->written.load(std::memory_order_relaxed);
+    TraceEvent& e = buffer->events[index % DARO_TRACE_EVENTS_PER_THREAD];
+    e.name = name;
+    e.start = startTicks;
+    e.end = endTicks;
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void DaroTrace::SetThreadName(const char* name)
+{
+    t_ThreadName = name;
+    if (t_Owner.buffer) t_Owner.buffer->name.store(name, std::memory_order_relaxed);
+}
+
+bool DaroTrace::Write(const char* path, int format)
+{
+    if (!path || path[0] == '\0') return false;
+    if (format != DARO_TRACE_FORMAT_JSON && format != DARO_TRACE_FORMAT_PERFETTO) return false;
+
+    std::string data;
+    {
+        std::lock_guard<std::mutex> lock(s_BuffersMutex);
+        std::vector<ThreadEvents> threads = Snapshot();
+        unsigned long pid = GetCurrentProcessId();
+        data = (format == DARO_TRACE_FORMAT_JSON) ? BuildJson(threads, pid) : BuildPerfetto(threads, pid);
+    }
+
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+    if (wlen <= 0) return false;
+    std::wstring wpath(wlen, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, &wpath[0], wlen);
+
+    FILE* file = nullptr;
+    if (_wfopen_s(&file, wpath.c_str(), L"wb") != 0 || !file)
+    {
+        OutputDebugStringA("[DaroEngine] Trace: could not open output file\n");
+        return false;
+    }
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    fclose(file);
+    return ok;
+}
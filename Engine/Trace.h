@@ -0,0 +1,66 @@
+// Engine/Trace.h
+// Opt-in timeline tracing for investigating stutter across threads.
+// Scopes record complete events (name, start, end) into a ring owned by the calling
+// thread, so recording takes no lock and each ring has a single writer. A scope reads
+// the enabled flag once, when it opens: when tracing is off that is one relaxed load and
+// a branch, and the close is one more branch on the latched name. Traces are written as
+// Chrome trace JSON (chrome://tracing, ui.perfetto.dev) or as a Perfetto protobuf trace
+// (TraceProtobuf.h).
+//
+// Only the name pointer is stored: names must be string literals.
+#pragma once
+
+#include <atomic>
+#include "SharedTypes.h"       // DARO_TRACE_FORMAT_*
+
+#define DARO_TRACE_EVENTS_PER_THREAD    65536   // Oldest events are overwritten (~1.5 MB per thread)
+
+class DaroTrace
+{
+public:
+    static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+
+    // Start clears events from any previous session
+    static void Start();
+    static void Stop();
+    static bool Write(const char* path, int format);
+
+    // Calling thread; ticks are QueryPerformanceCounter values
+    static void Record(const char* name, long long startTicks, long long endTicks);
+    static void SetThreadName(const char* name);
+    static long long Now();
+
+private:
+    static inline std::atomic<bool> s_Enabled{ false };
+};
+
+class DaroTraceScope
+{
+public:
+    // Null m_Name latches "off": a scope open when tracing stops still records, one
+    // opened before it starts does not
+    explicit DaroTraceScope(const char* name)
+    {
+        if (DaroTrace::IsEnabled())
+        {
+            m_Name = name;
+            m_Start = DaroTrace::Now();
+        }
+    }
+    ~DaroTraceScope()
+    {
+        if (m_Name) DaroTrace::Record(m_Name, m_Start, DaroTrace::Now());
+    }
+
+    DaroTraceScope(const DaroTraceScope&) = delete;
+    DaroTraceScope& operator=(const DaroTraceScope&) = delete;
+
+private:
+    const char* m_Name = nullptr;
+    long long m_Start = 0;
+};
+
+#define DARO_TRACE_CONCAT_INNER(a, b) a##b
+#define DARO_TRACE_CONCAT(a, b) DARO_TRACE_CONCAT_INNER(a, b)
+#define DARO_TRACE_SCOPE(name) DaroTraceScope DARO_TRACE_CONCAT(daroTraceScope, __LINE__)(name)
+#define DARO_TRACE_THREAD_NAME(name) do { if (DaroTrace::IsEnabled()) DaroTrace::SetThreadName(name); } while (0)
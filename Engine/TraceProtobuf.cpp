@@ -0,0 +1,96 @@
+// Engine/TraceProtobuf.cpp
+#include "TraceProtobuf.h"
+
+namespace
+{
+    void PutVarint(std::string& out, unsigned long long value)
+    {
+        while (value >= 0x80)
+        {
+            out += (char)((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += (char)value;
+    }
+
+    void PutVarintField(std::string& out, int field, unsigned long long value)
+    {
+        PutVarint(out, ((unsigned long long)field << 3) | 0);
+        PutVarint(out, value);
+    }
+
+    void PutBytesField(std::string& out, int field, const std::string& bytes)
+    {
+        PutVarint(out, ((unsigned long long)field << 3) | 2);
+        PutVarint(out, bytes.size());
+        out += bytes;
+    }
+
+    // Field numbers from perfetto/protos/perfetto/trace/trace_packet.proto and track_event/*.proto
+    enum
+    {
+        TRACE_PACKET = 1,
+        PACKET_TIMESTAMP = 8,
+        PACKET_SEQUENCE_ID = 10,
+        PACKET_TRACK_EVENT = 11,
+        PACKET_SEQUENCE_FLAGS = 13,
+        PACKET_TRACK_DESCRIPTOR = 60,
+        TRACK_UUID = 1, TRACK_PARENT_UUID = 5, TRACK_PROCESS = 3, TRACK_THREAD = 4,
+        PROCESS_PID = 1, PROCESS_NAME = 6,
+        THREAD_PID = 1, THREAD_TID = 2, THREAD_NAME = 5,
+        EVENT_TYPE = 9, EVENT_TRACK_UUID = 11, EVENT_NAME = 23,
+        SEQ_INCREMENTAL_STATE_CLEARED = 1,
+    };
+
+    void PutPacket(std::string& out, const std::string& packet)
+    {
+        PutBytesField(out, TRACE_PACKET, packet);
+    }
+}
+
+void DaroPerfettoProcessTrack(std::string& out, unsigned long long uuid, unsigned long pid, const char* name)
+{
+    std::string process;
+    PutVarintField(process, PROCESS_PID, pid);
+    PutBytesField(process, PROCESS_NAME, name);
+    std::string track;
+    PutVarintField(track, TRACK_UUID, uuid);
+    PutBytesField(track, TRACK_PROCESS, process);
+    std::string packet;
+    PutVarintField(packet, PACKET_SEQUENCE_ID, DARO_PERFETTO_SEQUENCE_ID);
+    PutVarintField(packet, PACKET_SEQUENCE_FLAGS, SEQ_INCREMENTAL_STATE_CLEARED);
+    PutBytesField(packet, PACKET_TRACK_DESCRIPTOR, track);
+    PutPacket(out, packet);
+}
+
+void DaroPerfettoThreadTrack(std::string& out, unsigned long long uuid, unsigned long long processUuid,
+                             unsigned long pid, unsigned long tid, const char* name)
+{
+    std::string descriptor;
+    PutVarintField(descriptor, THREAD_PID, pid);
+    PutVarintField(descriptor, THREAD_TID, tid);
+    if (name) PutBytesField(descriptor, THREAD_NAME, name);
+    std::string track;
+    PutVarintField(track, TRACK_UUID, uuid);
+    PutVarintField(track, TRACK_PARENT_UUID, processUuid);
+    PutBytesField(track, TRACK_THREAD, descriptor);
+    std::string packet;
+    PutVarintField(packet, PACKET_SEQUENCE_ID, DARO_PERFETTO_SEQUENCE_ID);
+    PutBytesField(packet, PACKET_TRACK_DESCRIPTOR, track);
+    PutPacket(out, packet);
+}
+
+void DaroPerfettoSlice(std::string& out, unsigned long long timestampNs, unsigned long long trackUuid,
+                       int type, const char* name)
+{
+    std::string event;
+    PutVarintField(event, EVENT_TYPE, (unsigned long long)type);
+    PutVarintField(event, EVENT_TRACK_UUID, trackUuid);
+    if (name) PutBytesField(event, EVENT_NAME, name);
+
+    std::string packet;
+    PutVarintField(packet, PACKET_TIMESTAMP, timestampNs);
+    PutVarintField(packet, PACKET_SEQUENCE_ID, DARO_PERFETTO_SEQUENCE_ID);
+    PutBytesField(packet, PACKET_TRACK_EVENT, event);
+    PutPacket(out, packet);
+}
@@ -0,0 +1,22 @@
+// Engine/TraceProtobuf.h
+// Minimal protobuf encoding of perfetto.protos.Trace, as DaroTrace::Write emits it: a
+// track descriptor for the process and for each thread, then begin/end slice track events.
+// Each call appends one TracePacket to out.
+//
+// No Windows dependencies, so the encoding is unit tested off Windows.
+#pragma once
+
+#include <string>
+
+#define DARO_PERFETTO_SLICE_BEGIN   1   // TrackEvent.Type
+#define DARO_PERFETTO_SLICE_END     2
+#define DARO_PERFETTO_SEQUENCE_ID   1   // trusted_packet_sequence_id of every packet
+
+// First packet: clears the sequence's incremental state
+void DaroPerfettoProcessTrack(std::string& out, unsigned long long uuid, unsigned long pid, const char* name);
+// name may be null
+void DaroPerfettoThreadTrack(std::string& out, unsigned long long uuid, unsigned long long processUuid,
+                             unsigned long pid, unsigned long tid, const char* name);
+// type DARO_PERFETTO_SLICE_*; name is null for an end
+void DaroPerfettoSlice(std::string& out, unsigned long long timestampNs, unsigned long long trackUuid,
+                       int type, const char* name);
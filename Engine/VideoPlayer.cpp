@@ -1,5 +1,9 @@
 // Engine/VideoPlayer.cpp
 #include "VideoPlayer.h"
+#include "Clock.h"
+#include "Trace.h"
+#include "MemoryStats.h"
+#include "PixelConvert.h"
 #include <Windows.h>
 #include <map>
 #include <memory>
@@ -46,8 +50,7 @@ void VideoLog(const char* msg)
 
 VideoPlayer::VideoPlayer()
 {
-    QueryPerformanceFrequency(&m_Frequency);
-    QueryPerformanceCounter(&m_LastFrameTime);
+    m_LastFrameNs = DaroClock::Instance().Now();
 }
 
 VideoPlayer::~VideoPlayer()
@@ -86,6 +89,7 @@ static const int MAX_VIDEO_DIMENSION = 8192;
 
 bool VideoPlayer::LoadVideo(const char* filePath)
 {
+    DARO_TRACE_SCOPE("Video load");
     std::lock_guard<std::mutex> lock(m_Mutex);
 
     if (!m_Device || !filePath)
@@ -270,15 +274,12 @@ bool VideoPlayer::LoadVideoMF(const wchar_t* wpath)
     UINT32 numerator = 0, denominator = 1;
     hr = MFGetAttributeRatio(actualType.Get(), MF_MT_FRAME_RATE, &numerator, &denominator);
     if (SUCCEEDED(hr) && denominator > 0 && numerator > 0)
-    {
-        m_FrameRate = static_cast<double>(numerator) / static_cast<double>(denominator);
-        m_FrameDuration = 1.0 / m_FrameRate;
-    }
+        m_Rate = DaroMakeRational(numerator, denominator);
     else
-    {
-        m_FrameRate = 25.0;  // Default
-        m_FrameDuration = 0.04;
-    }
+        m_Rate = DaroRational{ 0, 1 };
+    if (!DaroRationalIsValid(m_Rate))
+        m_Rate = DaroRational{ 25, 1 };  // Default
+    m_FrameRate = DaroRationalToDouble(m_Rate);
 
     // Get duration
     PROPVARIANT var;
@@ -288,8 +289,8 @@ bool VideoPlayer::LoadVideoMF(const wchar_t* wpath)
     {
         // Duration in 100-nanosecond units
         m_Duration = static_cast<double>(var.uhVal.QuadPart) / 10000000.0;
-        double totalFramesD = m_Duration * m_FrameRate;
-        m_TotalFrames = (totalFramesD > INT_MAX) ? INT_MAX : static_cast<int>(totalFramesD);
+        int64_t totalFrames = DaroNsToFrame(static_cast<int64_t>(var.uhVal.QuadPart) * 100, m_Rate);
+        m_TotalFrames = (totalFrames > INT_MAX) ? INT_MAX : static_cast<int>(totalFrames);
     }
     PropVariantClear(&var);
 
@@ -313,8 +314,9 @@ bool VideoPlayer::LoadVideoMF(const wchar_t* wpath)
     m_CurrentFrame = 0;
     m_CurrentTime = 0.0;
     m_EndOfStream = false;
-    m_AccumulatedTime = 0.0;
-    QueryPerformanceCounter(&m_LastFrameTime);
+    m_PlayNs = 0;
+    m_FramesAdvanced = 0;
+    m_LastFrameNs = DaroClock::Instance().Now();
 
     // Decode first frame immediately so video is visible even before Play()
     bool firstFrame = DecodeNextFrame();
@@ -348,9 +350,11 @@ bool VideoPlayer::LoadVideoFFmpeg(const char* filePath)
     m_Width = m_FFmpegDecoder->GetWidth();
     m_Height = m_FFmpegDecoder->GetHeight();
     m_Duration = m_FFmpegDecoder->GetDuration();
-    m_FrameRate = m_FFmpegDecoder->GetFrameRate();
+    m_Rate = m_FFmpegDecoder->GetFrameRateRational();
+    if (!DaroRationalIsValid(m_Rate))
+        m_Rate = DaroRational{ 25, 1 };
+    m_FrameRate = DaroRationalToDouble(m_Rate);
     m_TotalFrames = m_FFmpegDecoder->GetTotalFrames();
-    m_FrameDuration = (m_FrameRate > 0) ? 1.0 / m_FrameRate : 0.04;
 
     char dbg[512];
     sprintf_s(dbg, "[DaroVideo] FFmpeg: %dx%d @ %.1f fps, duration=%.1fs, totalFrames=%d, hasAlpha=%d\n",
@@ -372,8 +376,9 @@ bool VideoPlayer::LoadVideoFFmpeg(const char* filePath)
     m_CurrentFrame = 0;
     m_CurrentTime = 0.0;
     m_EndOfStream = false;
-    m_AccumulatedTime = 0.0;
-    QueryPerformanceCounter(&m_LastFrameTime);
+    m_PlayNs = 0;
+    m_FramesAdvanced = 0;
+    m_LastFrameNs = DaroClock::Instance().Now();
 
     // Decode first frame
     if (m_FFmpegDecoder->DecodeNextFrame())
@@ -451,8 +456,9 @@ void VideoPlayer::Play()
     std::lock_guard<std::mutex> lock(m_Mutex);
     if (!m_Loaded) return;
     m_Playing = true;
-    m_AccumulatedTime = 0.0;
-    QueryPerformanceCounter(&m_LastFrameTime);
+    m_PlayNs = 0;
+    m_FramesAdvanced = 0;
+    m_LastFrameNs = DaroClock::Instance().Now();
 }
 
 void VideoPlayer::Pause()
@@ -511,9 +517,11 @@ void VideoPlayer::SeekToFrameInternal(int frame)
 {
     // Must be called with m_Mutex already held
     if (!m_Loaded) return;
+    DARO_TRACE_SCOPE("Video seek");
 
     frame = (std::max)(0, (std::min)(frame, m_TotalFrames > 0 ? m_TotalFrames - 1 : 0));
-    double targetTime = (m_FrameRate > 0) ? frame / m_FrameRate : 0.0;
+    int64_t targetNs = DaroFrameToNs(frame, m_Rate);
+    double targetTime = static_cast<double>(targetNs) / 1e9;
 
     if (m_UsingFFmpeg)
     {
@@ -535,7 +543,7 @@ void VideoPlayer::SeekToFrameInternal(int frame)
     PROPVARIANT var;
     PropVariantInit(&var);
     var.vt = VT_I8;
-    var.hVal.QuadPart = static_cast<LONGLONG>(targetTime * 10000000.0);  // 100-ns units
+    var.hVal.QuadPart = static_cast<LONGLONG>(targetNs / 100);  // 100-ns units
 
     HRESULT hr = m_Reader->SetCurrentPosition(GUID_NULL, var);
     PropVariantClear(&var);
@@ -553,28 +561,30 @@ void VideoPlayer::SeekToFrameInternal(int frame)
 
 void VideoPlayer::SeekToTime(double seconds)
 {
-    if (m_FrameRate > 0)
+    if (DaroRationalIsValid(m_Rate))
     {
-        SeekToFrame(static_cast<int>(seconds * m_FrameRate));
+        // Seconds from the host usually went through a double: allow 1 us before a frame start
+        int64_t frame = DaroSecondsToFrame(seconds, m_Rate, 1000);
+        SeekToFrame(frame > INT_MAX ? INT_MAX : static_cast<int>(frame));
     }
 }
 
 bool VideoPlayer::UpdateFrame()
 {
+    DARO_TRACE_SCOPE("Video update");
     std::lock_guard<std::mutex> lock(m_Mutex);
 
+    m_DecodedLastUpdate = 0;
     if (!m_Loaded || !m_Playing) return false;
 
     // Calculate elapsed time
-    LARGE_INTEGER now;
-    QueryPerformanceCounter(&now);
-    double elapsed = static_cast<double>(now.QuadPart - m_LastFrameTime.QuadPart) / m_Frequency.QuadPart;
-    m_LastFrameTime = now;
-
-    m_AccumulatedTime += elapsed;
+    int64_t now = DaroClock::Instance().Now();
+    m_PlayNs += now - m_LastFrameNs;
+    m_LastFrameNs = now;
 
     // Check if we need to advance to next frame
-    if (m_AccumulatedTime < m_FrameDuration)
+    int64_t due = DaroNsToFrame(m_PlayNs, m_Rate) - m_FramesAdvanced;
+    if (due <= 0)
     {
         return false;  // Not time for next frame yet
     }
@@ -584,16 +594,18 @@ bool VideoPlayer::UpdateFrame()
     if (m_UsingFFmpeg && m_FFmpegDecoder)
     {
         // FFmpeg decode path
-        while (m_AccumulatedTime >= m_FrameDuration && !m_EndOfStream)
+        while (due > 0 && !m_EndOfStream)
         {
-            m_AccumulatedTime -= m_FrameDuration;
+            due--;
+            m_FramesAdvanced++;
 
             if (m_FFmpegDecoder->DecodeNextFrame())
             {
                 CopyBufferToTexture(m_FFmpegDecoder->GetFrameData(), m_FFmpegDecoder->GetFrameStride());
                 m_CurrentFrame++;
-                m_CurrentTime = (m_FrameRate > 0) ? m_CurrentFrame / m_FrameRate : 0.0;
+                m_CurrentTime = static_cast<double>(DaroFrameToNs(m_CurrentFrame, m_Rate)) / 1e9;
                 decoded = true;
+                m_DecodedLastUpdate++;
             }
             else if (m_FFmpegDecoder->IsEndOfStream())
             {
@@ -615,10 +627,12 @@ bool VideoPlayer::UpdateFrame()
     else
     {
         // MF decode path
-        while (m_AccumulatedTime >= m_FrameDuration && !m_EndOfStream)
+        while (due > 0 && !m_EndOfStream)
         {
-            m_AccumulatedTime -= m_FrameDuration;
+            due--;
+            m_FramesAdvanced++;
             decoded = DecodeNextFrame();
+            if (decoded) m_DecodedLastUpdate++;
 
             if (m_EndOfStream)
             {
@@ -643,6 +657,7 @@ bool VideoPlayer::UpdateFrame()
 bool VideoPlayer::DecodeNextFrame()
 {
     if (!m_Reader) return false;
+    DARO_TRACE_SCOPE("MF decode");
 
     DWORD streamIndex = 0;
     DWORD flags = 0;
@@ -676,7 +691,8 @@ bool VideoPlayer::DecodeNextFrame()
     {
         CopyFrameToTexture(sample.Get());
         m_CurrentTime = static_cast<double>(timestamp) / 10000000.0;
-        m_CurrentFrame = static_cast<int>(m_CurrentTime * m_FrameRate);
+        // Sample times are rounded to 100 ns: take the nearest frame start
+        m_CurrentFrame = static_cast<int>(DaroNsToNearestFrame(timestamp * 100, m_Rate));
         return true;
     }
 
@@ -687,6 +703,7 @@ bool VideoPlayer::DecodeNextFrame()
 void VideoPlayer::CopyFrameToTexture(IMFSample* sample)
 {
     if (!sample || !m_Texture || !m_Context) return;
+    DARO_TRACE_SCOPE("Video upload");
 
     ComPtr<IMFMediaBuffer> buffer;
     HRESULT hr = sample->ConvertToContiguousBuffer(&buffer);
@@ -719,29 +736,13 @@ void VideoPlayer::CopyFrameToTexture(IMFSample* sample)
         UINT srcPitch = m_Width * 4;  // BGRA = 4 bytes per pixel
         if (srcPitch == 0) { m_Context->Unmap(m_Texture.Get(), 0); buffer->Unlock(); return; }
 
-        BYTE* dstRow = static_cast<BYTE*>(mapped.pData);
-        BYTE* srcRow = srcData;
-
         // Validate source buffer is large enough to prevent overflow
         DWORD requiredSize = (DWORD)m_Height * srcPitch;
         int rowsToCopy = (srcLength >= requiredSize) ? m_Height : (int)(srcLength / srcPitch);
 
-        for (int y = 0; y < rowsToCopy; y++)
-        {
-            memcpy(dstRow, srcRow, srcPitch);
-
-            // Fix alpha: force opaque if format lacks alpha (RGB32) or user doesn't want alpha
-            if (m_NeedsAlphaFix || !m_VideoAlpha)
-            {
-                for (int x = 3; x < (int)srcPitch; x += 4)
-                {
-                    dstRow[x] = 0xFF;
-                }
-            }
-
-            dstRow += mapped.RowPitch;
-            srcRow += srcPitch;
-        }
+        // Fix alpha: force opaque if format lacks alpha (RGB32) or user doesn't want alpha
+        DaroCopyRows(srcData, srcPitch, mapped.pData, mapped.RowPitch, srcPitch, rowsToCopy,
+                     m_NeedsAlphaFix || !m_VideoAlpha);
 
         m_Context->Unmap(m_Texture.Get(), 0);
         m_FrameCopied = true;  // Track that we have valid frame data
@@ -759,31 +760,15 @@ void VideoPlayer::CopyFrameToTexture(IMFSample* sample)
 void VideoPlayer::CopyBufferToTexture(const uint8_t* srcData, int srcStride)
 {
     if (!srcData || !m_Texture || !m_Context || srcStride <= 0) return;
+    DARO_TRACE_SCOPE("Video upload");
 
     D3D11_MAPPED_SUBRESOURCE mapped;
     HRESULT hr = m_Context->Map(m_Texture.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
     if (FAILED(hr)) return;
 
-    int rowBytes = m_Width * 4;
-    BYTE* dstRow = static_cast<BYTE*>(mapped.pData);
-    const BYTE* srcRow = srcData;
-
-    for (int y = 0; y < m_Height; y++)
-    {
-        memcpy(dstRow, srcRow, rowBytes);
-
-        // Fix alpha: force opaque if format lacks alpha or user doesn't want alpha
-        if (m_NeedsAlphaFix || !m_VideoAlpha)
-        {
-            for (int x = 3; x < rowBytes; x += 4)
-            {
-                dstRow[x] = 0xFF;
-            }
-        }
-
-        dstRow += mapped.RowPitch;
-        srcRow += srcStride;
-    }
+    // Fix alpha: force opaque if format lacks alpha or user doesn't want alpha
+    DaroCopyRows(srcData, srcStride, mapped.pData, mapped.RowPitch, (size_t)m_Width * 4, m_Height,
+                 m_NeedsAlphaFix || !m_VideoAlpha);
 
     m_Context->Unmap(m_Texture.Get(), 0);
     m_FrameCopied = true;
@@ -837,6 +822,11 @@ void VideoManager::Shutdown()
     {
         std::lock_guard<std::mutex> lock(m_ManagerMutex);
         m_Players.clear();
+        DaroMemoryAccountant::Instance().RemoveCategory(DARO_MEM_VIDEO);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_StateMutex);
+        m_States.clear();
     }
 
     if (m_Initialized)
@@ -887,6 +877,11 @@ int VideoManager::LoadVideo(const char* filePath)
 
     int id = m_NextVideoId++;
     if (id <= 0) m_NextVideoId = id = 1; // Wraparound protection
+
+    // Dynamic BGRA texture on the GPU; the FFmpeg path also keeps a BGRA frame on the
+    // CPU for sws_scale output. Media Foundation sample buffers are not visible here.
+    long long frameBytes = DaroTextureBytes(player->GetWidth(), player->GetHeight());
+    DaroMemoryAccountant::Instance().Set(DARO_MEM_VIDEO, id, player->IsUsingFFmpeg() ? frameBytes : 0, frameBytes);
     m_Players[id] = std::move(player);
 
     char dbg[256];
@@ -902,6 +897,7 @@ void VideoManager::UnloadVideo(int videoId)
     if (it != m_Players.end())
     {
         m_Players.erase(it);
+        DaroMemoryAccountant::Instance().Remove(DARO_MEM_VIDEO, videoId);
     }
 }
 
@@ -923,4 +919,35 @@ void VideoManager::UpdateAll()
     {
         pair.second->UpdateFrame();
     }
+
+    // Refresh the snapshot read by the stats block publisher. The players are only
+    // touched here, so the publisher never waits on a decode.
+    std::lock_guard<std::mutex> stateLock(m_StateMutex);
+    m_States.clear();
+    for (auto& pair : m_Players)
+    {
+        if ((int)m_States.size() >= DARO_STATS_MAX_VIDEOS) break;
+        const VideoPlayer& player = *pair.second;
+        DaroStatsVideo state = {};
+        state.videoId = pair.first;
+        state.playing = player.IsPlaying() ? 1 : 0;
+        state.width = player.GetWidth();
+        state.height = player.GetHeight();
+        state.currentFrame = player.GetCurrentFrame();
+        state.totalFrames = player.GetTotalFrames();
+        state.decodedLastUpdate = player.GetDecodedLastUpdate();
+        state.usingFFmpeg = player.IsUsingFFmpeg() ? 1 : 0;
+        state.frameRate = player.GetFrameRate();
+        m_States.push_back(state);
+    }
+}
+
+int VideoManager::GetVideoStates(DaroStatsVideo* buffer, int maxCount)
+{
+    if (!buffer || maxCount <= 0) return 0;
+    std::lock_guard<std::mutex> lock(m_StateMutex);
+    int count = (int)m_States.size() < maxCount ? (int)m_States.size() : maxCount;
+    for (int i = 0; i < count; i++)
+        buffer[i] = m_States[i];
+    return count;
 }
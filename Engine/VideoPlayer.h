@@ -12,7 +12,10 @@
 #include <mutex>
 #include <map>
 #include <memory>
+#include <vector>
 #include "FFmpegDecoder.h"
+#include "StatsBlock.h"
+#include "TimeBase.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -62,6 +65,7 @@ public:
     double GetFrameRate() const { return m_FrameRate; }
     int GetTotalFrames() const { return m_TotalFrames; }
     int GetCurrentFrame() const { return m_CurrentFrame; }
+    int GetDecodedLastUpdate() const { return m_DecodedLastUpdate; }   // Above 1 = catching up
     double GetCurrentTime() const { return m_CurrentTime; }
 
     // Looping
@@ -71,6 +75,7 @@ public:
     // Alpha channel control
     void SetVideoAlpha(bool alpha) { std::lock_guard<std::mutex> lock(m_Mutex); m_VideoAlpha = alpha; }
     bool GetVideoAlpha() const { return m_VideoAlpha; }
+    bool IsUsingFFmpeg() const { return m_UsingFFmpeg; }
 
 private:
     bool CreateTexture();
@@ -100,9 +105,11 @@ private:
     int m_Height = 0;
     double m_Duration = 0.0;
     double m_FrameRate = 0.0;
+    DaroRational m_Rate = { 0, 1 };   // Exact m_FrameRate: frame times and play pacing
     int m_TotalFrames = 0;
     int m_CurrentFrame = 0;
     double m_CurrentTime = 0.0;
+    int m_DecodedLastUpdate = 0;
 
     bool m_Loaded = false;
     bool m_Playing = false;
@@ -114,11 +121,12 @@ private:
     bool m_UsingFFmpeg = false;   // True when FFmpeg decoder is active instead of MF
     std::unique_ptr<FFmpegDecoder> m_FFmpegDecoder;
 
-    // Timing for frame advancement
-    LARGE_INTEGER m_LastFrameTime;
-    LARGE_INTEGER m_Frequency;
-    double m_FrameDuration = 0.0;
-    double m_AccumulatedTime = 0.0;
+    // Timing for frame advancement, on the engine clock (virtual when the host drives time).
+    // Frames are due when whole periods of m_Rate have played since Play or Load, counted
+    // exactly so playback does not drift from the clock over long runs.
+    int64_t m_LastFrameNs = 0;
+    int64_t m_PlayNs = 0;
+    int64_t m_FramesAdvanced = 0;
 
     std::mutex m_Mutex;
 };
@@ -143,6 +151,9 @@ public:
     // Update all playing videos (call each frame)
     void UpdateAll();
 
+    // Player states as of the last UpdateAll. Any thread.
+    int GetVideoStates(DaroStatsVideo* buffer, int maxCount);
+
 private:
     VideoManager() = default;
     ~VideoManager() = default;
@@ -151,6 +162,8 @@ private:
     ID3D11DeviceContext* m_Context = nullptr;
     std::map<int, std::unique_ptr<VideoPlayer>> m_Players;
     std::mutex m_ManagerMutex;
+    std::vector<DaroStatsVideo> m_States;
+    std::mutex m_StateMutex;
     int m_NextVideoId = 1;
     bool m_Initialized = false;
 };
@@ -67,6 +67,9 @@ try
     // Metrics service for performance monitoring
     builder.Services.AddSingleton<IMetricsService, MetricsService>();
 
+    // Engine stats - read from the engine's shared-memory stats block
+    builder.Services.AddSingleton<IEngineStatsService, EngineStatsService>();
+
     // Configure CORS for HTML5 plugin (configurable via appsettings.json)
     var corsOrigins = builder.Configuration.GetSection("Cors:AllowedOrigins").Get<string[]>()
         ?? new[] { "http://localhost:3000", "http://127.0.0.1:3000" };
@@ -238,6 +241,20 @@ try
     .WithTags("Monitoring")
     .Produces<MetricsSnapshot>(StatusCodes.Status200OK);
 
+    // Live engine stats (frame counters, drops, timing, memory, on-air item)
+    app.MapGet("/metrics/engine", Results<Ok<EngineStatsSnapshot>, ProblemHttpResult> (IEngineStatsService engineStats) =>
+    {
+        var snapshot = engineStats.GetSnapshot();
+        if (snapshot == null)
+            return TypedResults.Problem("No engine is publishing stats", statusCode: StatusCodes.Status503ServiceUnavailable);
+        return TypedResults.Ok(snapshot);
+    })
+    .WithName("GetEngineMetrics")
+    .WithSummary("Get live engine stats from the shared-memory stats block")
+    .WithTags("Monitoring")
+    .Produces<EngineStatsSnapshot>(StatusCodes.Status200OK)
+    .Produces(StatusCodes.Status503ServiceUnavailable);
+
     // Reset metrics endpoint (for testing)
     app.MapPost("/metrics/reset", (IMetricsService metrics) =>
     {
@@ -0,0 +1,269 @@
+using System.Diagnostics;
+using System.IO.MemoryMappedFiles;
+using System.Text;
+
+namespace GraphicsMiddleware.Services;
+
+/// <summary>
+/// Reads the live stats block the engine publishes in named shared memory
+/// (Engine/StatsBlock.h) so the middleware can report engine health without
+/// calling into the engine process. Reads never block the engine.
+/// </summary>
+public interface IEngineStatsService
+{
+    /// <summary>
+    /// Latest engine stats, or null when no engine is publishing.
+    /// </summary>
+    EngineStatsSnapshot? GetSnapshot();
+}
+
+public sealed class EngineStatsService : IEngineStatsService, IDisposable
+{
+    private const string SegmentName = "DaroEngineStats";
+    private const uint Magic = 0x54534644;          // "DFST"
+    private const uint Version = 1;
+    private const long StaleNs = 2_000_000_000;
+    private const int MaxReadRetries = 8;
+
+    // DaroStatsHeader offsets
+    private const int HeaderMagic = 0;
+    private const int HeaderVersion = 4;
+    private const int HeaderSize = 8;
+    private const int HeaderSnapshotSize = 12;
+    private const int HeaderSessionId = 16;
+    private const int HeaderProcessId = 24;
+    private const int HeaderSequence = 32;
+    private const int HeaderHeartbeat = 40;
+
+    // DaroStatsSnapshot offsets (packed, see StatsBlock.h)
+    private const int SnapPublishCount = 0;
+    private const int SnapFrameNumber = 16;
+    private const int SnapDroppedFrames = 24;
+    private const int SnapLateFrames = 32;
+    private const int SnapTargetFps = 40;
+    private const int SnapFps = 48;
+    private const int SnapFrameTimeMs = 56;
+    private const int SnapOnAirTimecode = 64 + 24;
+    private const int SnapOnAirTemplate = 64 + 28;
+    private const int SnapOnAirItem = 64 + 92;
+    private const int MetadataNameLength = 64;
+    private const int SnapTiming = 372;             // DaroTimingSummary[3][2], 56 bytes each
+    private const int TimingSize = 56;
+    private const int TimingP99 = 32;
+    private const int SnapMemoryTotal = 708;        // DaroMemoryStats
+    private const int SnapVideoCount = 1276;
+    private const int SnapVideos = 1280;            // DaroStatsVideo[32], 40 bytes each
+    private const int VideoSize = 40;
+    private const int MaxVideos = 32;
+    private const int KnownSnapshotSize = 2560;
+
+    private readonly object _lock = new();
+    private readonly ILogger<EngineStatsService> _logger;
+    private MemoryMappedFile? _file;
+    private MemoryMappedViewAccessor? _view;
+    private ulong _sessionId;
+    private byte[] _buffer = new byte[KnownSnapshotSize];
+
+    public EngineStatsService(ILogger<EngineStatsService> logger)
+    {
+        _logger = logger;
+    }
+
+    public EngineStatsSnapshot? GetSnapshot()
+    {
+        lock (_lock)
+        {
+            if (_view == null || IsPublisherLost())
+            {
+                Close();
+                if (!TryOpen())
+                    return null;
+            }
+
+            return TryRead();
+        }
+    }
+
+    private bool TryOpen()
+    {
+        try
+        {
+            // Windows: named file mapping. POSIX: shm_open segments live under /dev/shm.
+            _file = OperatingSystem.IsWindows()
+                ? MemoryMappedFile.OpenExisting(SegmentName, MemoryMappedFileRights.Read)
+                : MemoryMappedFile.CreateFromFile(
+                    new FileStream("/dev/shm/" + SegmentName, FileMode.Open, FileAccess.Read, FileShare.ReadWrite),
+                    null, 0, MemoryMappedFileAccess.Read, HandleInheritability.None, false);
+            _view = _file.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+        }
+        catch (Exception ex) when (ex is FileNotFoundException or IOException or UnauthorizedAccessException)
+        {
+            Close();
+            return false;
+        }
+
+        if (_view.Capacity < 64 ||
+            _view.ReadUInt32(HeaderMagic) != Magic ||
+            _view.ReadUInt32(HeaderVersion) != Version ||
+            _view.Capacity < _view.ReadUInt32(HeaderSize) + _view.ReadUInt32(HeaderSnapshotSize))
+        {
+            Close();
+            return false;
+        }
+
+        _sessionId = _view.ReadUInt64(HeaderSessionId);
+        _logger.LogInformation("Attached to engine stats block (engine PID {ProcessId})", _view.ReadUInt32(HeaderProcessId));
+        return true;
+    }
+
+    private bool IsPublisherLost()
+    {
+        if (_view!.ReadUInt32(HeaderMagic) != Magic) return true;
+        if (_view.ReadUInt64(HeaderSessionId) != _sessionId) return true;
+        return HeartbeatAgeNs() > StaleNs;
+    }
+
+    // Stopwatch and the engine's steady_clock use the same monotonic source on Windows and Linux
+    private long HeartbeatAgeNs()
+    {
+        long nowNs = (long)(Stopwatch.GetTimestamp() * (1_000_000_000.0 / Stopwatch.Frequency));
+        return nowNs - (long)_view!.ReadUInt64(HeaderHeartbeat);
+    }
+
+    private EngineStatsSnapshot? TryRead()
+    {
+        var view = _view!;
+        long snapshotOffset = view.ReadUInt32(HeaderSize);
+        int bytes = (int)Math.Min(view.ReadUInt32(HeaderSnapshotSize), (uint)KnownSnapshotSize);
+
+        for (int attempt = 0; attempt < MaxReadRetries; attempt++)
+        {
+            // Seqlock: odd while the engine is writing, changed if it wrote during our copy
+            uint seqBefore = view.ReadUInt32(HeaderSequence);
+            if (seqBefore == 0) return null;
+            if ((seqBefore & 1) != 0)
+            {
+                Thread.Yield();
+                continue;
+            }
+
+            Thread.MemoryBarrier();
+            Array.Clear(_buffer);
+            view.ReadArray(snapshotOffset, _buffer, 0, bytes);
+            Thread.MemoryBarrier();
+
+            if (view.ReadUInt32(HeaderSequence) == seqBefore)
+                return Decode(view.ReadUInt32(HeaderProcessId), HeartbeatAgeNs());
+        }
+        return null;
+    }
+
+    private EngineStatsSnapshot Decode(uint processId, long heartbeatAgeNs)
+    {
+        var span = _buffer.AsSpan();
+        int videoCount = Math.Clamp(BitConverter.ToInt32(span[SnapVideoCount..]), 0, MaxVideos);
+        var videos = new List<EngineVideoStats>(videoCount);
+        for (int i = 0; i < videoCount; i++)
+        {
+            var v = span.Slice(SnapVideos + i * VideoSize, VideoSize);
+            videos.Add(new EngineVideoStats
+            {
+                VideoId = BitConverter.ToInt32(v),
+                Playing = BitConverter.ToInt32(v[4..]) != 0,
+                CurrentFrame = BitConverter.ToInt32(v[16..]),
+                TotalFrames = BitConverter.ToInt32(v[20..]),
+                DecodedLastUpdate = BitConverter.ToInt32(v[24..])
+            });
+        }
+
+        int timecode = BitConverter.ToInt32(span[SnapOnAirTimecode..]);
+        return new EngineStatsSnapshot
+        {
+            ProcessId = processId,
+            HeartbeatAgeMs = heartbeatAgeNs / 1_000_000.0,
+            PublishCount = BitConverter.ToInt64(span[SnapPublishCount..]),
+            FrameNumber = BitConverter.ToInt64(span[SnapFrameNumber..]),
+            DroppedFrames = BitConverter.ToInt64(span[SnapDroppedFrames..]),
+            LateFrames = BitConverter.ToInt64(span[SnapLateFrames..]),
+            TargetFps = BitConverter.ToDouble(span[SnapTargetFps..]),
+            Fps = BitConverter.ToDouble(span[SnapFps..]),
+            FrameTimeMs = BitConverter.ToDouble(span[SnapFrameTimeMs..]),
+            FrameIntervalP99Ms = TimingP99Ms(span, 0),
+            RenderP99Ms = TimingP99Ms(span, 1),
+            OutputLatencyP99Ms = TimingP99Ms(span, 2),
+            MemoryBytes = BitConverter.ToInt64(span[(SnapMemoryTotal + 8)..]) + BitConverter.ToInt64(span[(SnapMemoryTotal + 16)..]),
+            MemoryOverBudget = BitConverter.ToInt32(span[(SnapMemoryTotal + 56)..]) != 0,
+            OnAirTemplate = ReadName(span.Slice(SnapOnAirTemplate, MetadataNameLength)),
+            OnAirItem = ReadName(span.Slice(SnapOnAirItem, MetadataNameLength)),
+            // Bit 31 (DARO_TIMECODE_DROP_FRAME) marks drop-frame numbering, written hh:mm:ss;ff
+            Timecode = $"{(timecode >> 24) & 0x3F:D2}:{(timecode >> 16) & 0xFF:D2}:{(timecode >> 8) & 0xFF:D2}{(timecode < 0 ? ';' : ':')}{timecode & 0xFF:D2}",
+            Videos = videos
+        };
+    }
+
+    // Last completed window of DARO_TIMING_* metric
+    private static double TimingP99Ms(ReadOnlySpan<byte> span, int metric)
+    {
+        return BitConverter.ToDouble(span[(SnapTiming + (metric * 2 + 1) * TimingSize + TimingP99)..]);
+    }
+
+    private static string ReadName(ReadOnlySpan<byte> bytes)
+    {
+        int length = bytes.IndexOf((byte)0);
+        return Encoding.UTF8.GetString(length >= 0 ? bytes[..length] : bytes);
+    }
+
+    private void Close()
+    {
+        _view?.Dispose();
+        _file?.Dispose();
+        _view = null;
+        _file = null;
+        _sessionId = 0;
+    }
+
+    public void Dispose()
+    {
+        lock (_lock)
+        {
+            Close();
+        }
+    }
+}
+
+/// <summary>
+/// Headline engine stats from the shared-memory stats block.
+/// </summary>
+public sealed class EngineStatsSnapshot
+{
+    public uint ProcessId { get; init; }
+    public double HeartbeatAgeMs { get; init; }
+    public long PublishCount { get; init; }
+    public long FrameNumber { get; init; }
+    public long DroppedFrames { get; init; }
+    public long LateFrames { get; init; }
+    public double TargetFps { get; init; }
+    public double Fps { get; init; }
+    public double FrameTimeMs { get; init; }
+    public double FrameIntervalP99Ms { get; init; }
+    public double RenderP99Ms { get; init; }
+    public double OutputLatencyP99Ms { get; init; }
+    public long MemoryBytes { get; init; }
+    public bool MemoryOverBudget { get; init; }
+    public string OnAirTemplate { get; init; } = "";
+    public string OnAirItem { get; init; } = "";
+    public string Timecode { get; init; } = "";
+    public List<EngineVideoStats> Videos { get; init; } = new();
+}
+
+/// <summary>
+/// Playback state of one loaded video.
+/// </summary>
+public sealed class EngineVideoStats
+{
+    public int VideoId { get; init; }
+    public bool Playing { get; init; }
+    public int CurrentFrame { get; init; }
+    public int TotalFrames { get; init; }
+    public int DecodedLastUpdate { get; init; }
+}